@@ -34,6 +34,7 @@
 
 #include "gstxcambufferpool.h"
 #include "gstxcambuffermeta.h"
+#include "copy_counter.h"
 
 #include <gst/video/gstvideopool.h>
 #include <gst/allocators/gstdmabuf.h>
@@ -47,6 +48,8 @@ XCAM_BEGIN_DECLARE
 GST_DEBUG_CATEGORY_EXTERN (gst_xcam_src_debug);
 #define GST_CAT_DEFAULT gst_xcam_src_debug
 
+static CopyCounter gst_xcam_buffer_pool_copy_counter ("gst_xcam_buffer_pool");
+
 G_DEFINE_TYPE (GstXCamBufferPool, gst_xcam_buffer_pool, GST_TYPE_BUFFER_POOL);
 #define parent_class gst_xcam_buffer_pool_parent_class
 
@@ -190,14 +193,16 @@ gst_xcam_buffer_pool_acquire_buffer (
     //((GstMeta *)(meta))->flags = (GstMetaFlags)(GST_META_FLAG_POOLED | GST_META_FLAG_LOCKED | GST_META_FLAG_READONLY);
     //GST_META_FLAG_SET (meta, (GST_META_FLAG_POOLED | GST_META_FLAG_LOCKED | GST_META_FLAG_READONLY));
 
-    if (GST_XCAM_SRC_MEM_MODE (pool->src) == V4L2_MEMORY_DMABUF) {
+    if (GST_XCAM_SRC_MEM_MODE (pool->src) == V4L2_MEMORY_DMABUF && video_buf->get_fd () >= 0) {
         out_buf = gst_buffer_new ();
         mem = gst_dmabuf_allocator_alloc (
                   pool->allocator, dup (video_buf->get_fd ()), video_buf->get_size ());
         
         XCAM_ASSERT (mem);
         gst_buffer_append_memory (out_buf, mem);
-    } else if (GST_XCAM_SRC_MEM_MODE (pool->src) == V4L2_MEMORY_MMAP) {
+        gst_xcam_buffer_pool_copy_counter.record (0);
+    } else if (GST_XCAM_SRC_MEM_MODE (pool->src) == V4L2_MEMORY_MMAP ||
+               GST_XCAM_SRC_MEM_MODE (pool->src) == V4L2_MEMORY_DMABUF) {
 #if 0
         if (frame%2 == 0)
         memset(video_buf->map (), 100, video_buf->get_size () / 2);
@@ -210,6 +215,7 @@ gst_xcam_buffer_pool_acquire_buffer (
 
         out_buf = gst_buffer_new_allocate (NULL, video_buf->get_size (), NULL);
         gst_buffer_fill (out_buf, 0, video_buf->map (), video_buf->get_size ());
+        gst_xcam_buffer_pool_copy_counter.record (video_buf->get_size ());
 /*
         mem = gst_memory_new_wrapped (
                   (GstMemoryFlags)(GST_MEMORY_FLAG_READONLY | GST_MEMORY_FLAG_NO_SHARE),
@@ -20,6 +20,7 @@
 
 #include "gstxcamfilter.h"
 #include "gstxcambuffermeta.h"
+#include "copy_counter.h"
 
 #include <gst/gstmeta.h>
 #include <gst/allocators/gstdmabuf.h>
@@ -45,6 +46,9 @@ using namespace GstXCam;
 #define DEFAULT_PROP_STITCH_FM_OCL          FALSE
 #define DEFAULT_PROP_STITCH_RES_MODE        StitchRes1080P
 
+static CopyCounter xcamfilter_sink_copy_counter ("gst_xcamfilter_sink");
+static CopyCounter xcamfilter_src_copy_counter ("gst_xcamfilter_src");
+
 XCAM_BEGIN_DECLARE
 
 enum {
@@ -778,6 +782,7 @@ copy_gstbuf_to_xcambuf (GstVideoInfo gstinfo, GstBuffer *gstbuf, SmartPtr<VideoB
 
     uint8_t *src = NULL;
     uint8_t *dest = NULL;
+    uint64_t copied = 0;
     for (uint32_t index = 0; index < xcaminfo.components; index++) {
         xcaminfo.get_planar_info (planar, index);
 
@@ -788,7 +793,9 @@ copy_gstbuf_to_xcambuf (GstVideoInfo gstinfo, GstBuffer *gstbuf, SmartPtr<VideoB
             src += GST_VIDEO_INFO_PLANE_STRIDE (&gstinfo, index);
             dest += xcaminfo.strides [index];
         }
+        copied += (uint64_t)GST_VIDEO_INFO_WIDTH (&gstinfo) * planar.height;
     }
+    xcamfilter_sink_copy_counter.record (copied);
 
     gst_buffer_unmap (gstbuf, &mapinfo);
     xcambuf->unmap ();
@@ -818,6 +825,7 @@ copy_xcambuf_to_gstbuf (GstVideoInfo gstinfo, SmartPtr<VideoBuffer> xcambuf, Gst
 
     uint8_t *src = NULL;
     uint8_t *dest = NULL;
+    uint64_t copied = 0;
     for (uint32_t index = 0; index < GST_VIDEO_INFO_N_PLANES (&gstinfo); index++) {
         xcaminfo.get_planar_info (planar, index);
 
@@ -828,7 +836,9 @@ copy_xcambuf_to_gstbuf (GstVideoInfo gstinfo, SmartPtr<VideoBuffer> xcambuf, Gst
             src += xcaminfo.strides [index];
             dest += GST_VIDEO_INFO_PLANE_STRIDE (&gstinfo, index);
         }
+        copied += (uint64_t)planar.width * planar.height;
     }
+    xcamfilter_src_copy_counter.record (copied);
 
     gst_buffer_unmap (tmpbuf, &mapinfo);
     xcambuf->unmap ();
@@ -904,6 +914,7 @@ gst_xcam_filter_before_transform (GstBaseTransform *trans, GstBuffer *buffer)
             XCAM_LOG_ERROR ("xcamfilter convert to drm bo buffer failed");
             return;
         }
+        xcamfilter_sink_copy_counter.record (0);
     } else {
         SmartPtr<DrmBoBuffer> drm_buf = buf_pool->get_buffer (buf_pool).dynamic_cast_ptr<DrmBoBuffer> ();
         if (!drm_buf.ptr ()) {
@@ -951,6 +962,7 @@ gst_xcam_filter_prepare_output_buffer (GstBaseTransform *trans, GstBuffer *input
     } else if (xcamfilter->copy_mode == COPY_MODE_DMA) {
         GstAllocator *allocator = xcamfilter->allocator;
         ret = append_xcambuf_to_gstbuf (allocator, video_buf, outbuf);
+        xcamfilter_src_copy_counter.record (0);
     }
 
     if (ret == GST_FLOW_OK) {
@@ -314,7 +314,7 @@ gst_xcam_src_class_init (GstXCamSrcClass * class_self)
 
     g_object_class_install_property (
         gobject_class, PROP_MEM_MODE,
-        g_param_spec_enum ("io-mode", "memory mode", "Memory mode",
+        g_param_spec_enum ("io-mode", "memory mode", "Memory mode, dmabuf passes capture buffers downstream by fd",
                            GST_TYPE_XCAM_SRC_MEM_MODE, DEFAULT_PROP_MEM_MODE,
                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
@@ -712,7 +712,13 @@ gst_xcam_src_start (GstBaseSrc *src)
 
     capture_device->set_sensor_id (rkisp->sensor_id);
     capture_device->set_capture_mode (rkisp->capture_mode);
-    capture_device->set_mem_type (rkisp->mem_type);
+    if (rkisp->mem_type == V4L2_MEMORY_DMABUF) {
+        // vb2 exports MMAP buffers only, each one is exported once and passed by fd
+        capture_device->set_mem_type (V4L2_MEMORY_MMAP);
+        capture_device->set_dma_export (true);
+    } else {
+        capture_device->set_mem_type (rkisp->mem_type);
+    }
     capture_device->set_buffer_count (rkisp->buf_count);
     capture_device->open ();
     device_manager->set_capture_device (capture_device);
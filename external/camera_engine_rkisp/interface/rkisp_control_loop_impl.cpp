@@ -6,12 +6,15 @@
 #include "iq/x3a_analyze_tuner.h"
 #include "x3a_analyzer_rkiq.h"
 #include "dynamic_analyzer_loader.h"
+#include "xcam_trace.h"
+#include "x3a_result_arena.h"
 
 #include "mediactl-priv.h"
 #include "mediactl.h"
 #include "v4l2subdev.h"
 
 #include <base/log.h>
+#include <signal.h>
 
 #define V4L2_CAPTURE_MODE_STILL 0x2000
 #define V4L2_CAPTURE_MODE_VIDEO 0x4000
@@ -163,6 +166,8 @@ int rkisp_cl_prepare(void* cl_ctx,
     ret = isp_dev->open ();
     if (ret == XCAM_RETURN_NO_ERROR) {
         isp_dev->subscribe_event (V4L2_EVENT_FRAME_SYNC);
+        // optional, drops the cached sensor descriptor on mode switch
+        isp_dev->subscribe_event (V4L2_EVENT_SOURCE_CHANGE);
         device_manager->set_event_subdevice(isp_dev);
     } else {
         ALOGE("failed to open isp subdev");
@@ -187,7 +192,7 @@ int rkisp_cl_prepare(void* cl_ctx,
     stats_dev->set_capture_mode (V4L2_CAPTURE_MODE_VIDEO);
     stats_dev->set_buf_type(V4L2_BUF_TYPE_META_CAPTURE);
     stats_dev->set_mem_type (V4L2_MEMORY_MMAP);
-    stats_dev->set_buffer_count (1);
+    stats_dev->set_buffer_count (ISP_STATS_BUF_COUNT);
     ret = stats_dev->open ();
     if (ret == XCAM_RETURN_NO_ERROR) {
         device_manager->set_isp_stats_device (stats_dev);
@@ -206,7 +211,7 @@ int rkisp_cl_prepare(void* cl_ctx,
     param_dev->set_capture_mode (V4L2_CAPTURE_MODE_VIDEO);
     param_dev->set_buf_type(V4L2_BUF_TYPE_META_OUTPUT);
     param_dev->set_mem_type (V4L2_MEMORY_MMAP);
-    param_dev->set_buffer_count (1);
+    param_dev->set_buffer_count (ISP_PARAMS_BUF_COUNT);
     ret = param_dev->open ();
     if (ret == XCAM_RETURN_NO_ERROR) {
         device_manager->set_isp_params_device (param_dev);
@@ -241,6 +246,31 @@ int rkisp_cl_prepare(void* cl_ctx,
 
     SmartPtr<X3aAnalyzer> aiq_analyzer =
         new X3aAnalyzerRKiq (device_manager, isp_controller, device_manager->get_iq_path());
+    const char *parallel_3a = getenv ("XCAM_3A_PARALLEL");
+    if (parallel_3a && atoi (parallel_3a) > 0)
+        aiq_analyzer->set_parallel_analyze (true);
+    // tracing is only enabled with an export path, SIGUSR2 writes the trace there
+    const char *trace_file = getenv ("XCAM_TRACE_FILE");
+    if (trace_file && !FrameTracer::is_enabled ()) {
+        FrameTracer::set_enabled (true);
+        FrameTracer::install_dump_signal (SIGUSR2, trace_file);
+    }
+    // asserts that 3a results stop allocating once the result arena is warm
+    const char *arena_check = getenv ("XCAM_3A_RESULT_ARENA_CHECK");
+    if (arena_check && atoi (arena_check) > 0)
+        X3aResultArena::instance ()->set_check_allocations (true);
+    // every analyzed frame is recorded there for offline replay, see x3a_replay.h
+    const char *record_file = getenv ("XCAM_3A_RECORD_FILE");
+    if (record_file)
+        aiq_analyzer.dynamic_cast_ptr<X3aAnalyzerRKiq> ()->set_record_path (record_file);
+    // "latest" analyzes only the newest queued stats, a number N > 1 every Nth stats
+    const char *stats_policy = getenv ("XCAM_3A_STATS_POLICY");
+    if (stats_policy) {
+        if (!strcmp (stats_policy, "latest"))
+            aiq_analyzer->set_stats_policy (XCAM_ANALYZER_STATS_LATEST);
+        else if (atoi (stats_policy) > 1)
+            aiq_analyzer->set_stats_policy (XCAM_ANALYZER_STATS_EVERY_NTH, atoi (stats_policy));
+    }
     device_manager->set_3a_analyzer (aiq_analyzer);
 
     device_manager->set_static_metadata (prepare_params->staticMeta);
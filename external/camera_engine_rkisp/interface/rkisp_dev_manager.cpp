@@ -27,11 +27,22 @@
 
 using namespace XCam;
 
+static int64_t
+request_time_now ()
+{
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return XCAM_TIMESPEC_2_USEC (now);
+}
+
 RkispDeviceManager::RkispDeviceManager(const cl_result_callback_ops_t *cb)
-    : mCallbackOps (cb)
+    : _req_head (0)
+    , _req_bound (0)
+    , _req_tail (0)
+    , _last_frame_sequence (-1)
+    , mCallbackOps (cb)
 {
     _settingsProcessor = new SettingsProcessor();
-    _settings.clear();
     _cl_state = -1;
 }
 
@@ -39,7 +50,6 @@ RkispDeviceManager::~RkispDeviceManager()
 {
     if(_settingsProcessor)
         delete _settingsProcessor;
-    _settings.clear();
 }
 
 void
@@ -86,23 +96,54 @@ RkispDeviceManager::x3a_calculation_done (XAnalyzer *analyzer, X3aResultList &re
 
     /* meta_result->dump(); */
     {
-        SmartLock lock(_settingsMutex);
-        if (!_settings.empty()) {
-            id = (*_settings.begin())->reqId;
-            _settings.erase(_settings.begin());
-        } else {
+        // every bound request completes here, the ones bound before the last
+        // belong to frames whose stats were dropped or failed in 3a
+        RequestSlot retired[RKISP_REQUEST_RING_SIZE];
+        uint32_t count = 0;
+        int64_t now = request_time_now ();
+
+        {
+            SmartLock lock(_settingsMutex);
+            while (_req_head != _req_bound) {
+                RequestSlot &slot = _requests[_req_head % RKISP_REQUEST_RING_SIZE];
+                retired[count++] = slot;
+                slot.params.release ();
+                _req_head++;
+
+                int64_t queue_usec = retired[count - 1].analyze_time - retired[count - 1].submit_time;
+                int64_t result_usec = now - retired[count - 1].analyze_time;
+                _req_stats.completed++;
+                _req_stats.queue_usec += queue_usec;
+                _req_stats.result_usec += result_usec;
+                if (queue_usec + result_usec > _req_stats.max_latency_usec)
+                    _req_stats.max_latency_usec = queue_usec + result_usec;
+            }
+            if (count > 1)
+                _req_stats.realigned += count - 1;
+        }
+
+        if (!count)
             LOGW("@%s %d: No settting when results comes!!", __FUNCTION__, __LINE__);
+
+        uint32_t callbacks = count ? count : 1;
+        for (uint32_t i = 0; i < callbacks; i++) {
+            id = count ? retired[i].params->reqId : -1;
+            LOGI("@%s %d: result %d has %d metadata entries", __FUNCTION__, __LINE__,
+                 id, meta_result->get_metadata_result()->entryCount());
+            if (count)
+                LOGD("@%s %d: request %d of frame %d, queued %" PRId64 "us, 3a %" PRId64 "us",
+                     __FUNCTION__, __LINE__, id, retired[i].frame_sequence,
+                     retired[i].analyze_time - retired[i].submit_time,
+                     now - retired[i].analyze_time);
+
+            rkisp_cl_frame_metadata_s cb_result;
+            cb_result.id = id;
+            cb_result.metas = meta_result->get_metadata_result()->getAndLock();
+            if (mCallbackOps)
+                mCallbackOps->metadata_result_callback(mCallbackOps, &cb_result);
+            meta_result->get_metadata_result()->unlock(cb_result.metas);
         }
     }
-    LOGI("@%s %d: result %d has %d metadata entries", __FUNCTION__, __LINE__,
-         id, meta_result->get_metadata_result()->entryCount());
-
-    rkisp_cl_frame_metadata_s cb_result;
-    cb_result.id = id;
-    cb_result.metas = meta_result->get_metadata_result()->getAndLock();
-    if (mCallbackOps)
-        mCallbackOps->metadata_result_callback(mCallbackOps, &cb_result);
-    meta_result->get_metadata_result()->unlock(cb_result.metas);
 
 done:
     DeviceManager::x3a_calculation_done (analyzer, results);
@@ -142,15 +183,90 @@ RkispDeviceManager::set_control_params(const int request_frame_id,
          aectl.aeTargetFpsRange[0], aectl.aeTargetFpsRange[1]);
     {
         SmartLock lock(_settingsMutex);
-        _settings.push_back(inputParams);
+        if (_req_tail - _req_head == RKISP_REQUEST_RING_SIZE) {
+            RequestSlot &oldest = _requests[_req_head % RKISP_REQUEST_RING_SIZE];
+            LOGW("@%s %d: request ring full, drop request %d", __FUNCTION__, __LINE__,
+                 oldest.params->reqId);
+            oldest.params.release ();
+            if (_req_bound == _req_head)
+                _req_bound++;
+            _req_head++;
+            _req_stats.dropped++;
+        }
+
+        MeteringRegionCacheStats metering = _settingsProcessor->getMeteringCacheStats();
+        _req_stats.metering_hits = metering.hits;
+        _req_stats.metering_misses = metering.misses;
+
+        RequestSlot &slot = _requests[_req_tail % RKISP_REQUEST_RING_SIZE];
+        slot.params = inputParams;
+        slot.frame_sequence = -1;
+        slot.submit_time = request_time_now ();
+        slot.analyze_time = slot.submit_time;
+        _req_tail++;
     }
     return ret;
 }
 
+void
+RkispDeviceManager::bind_request_unsafe (int frame_sequence, int64_t now)
+{
+    XCAM_ASSERT (_req_bound != _req_tail);
+
+    RequestSlot &slot = _requests[_req_bound % RKISP_REQUEST_RING_SIZE];
+    slot.frame_sequence = frame_sequence;
+    slot.analyze_time = now;
+    _cur_settings = slot.params;
+    _req_bound++;
+}
+
+SmartPtr<AiqInputParams>
+RkispDeviceManager::getAiqInputParams(int frame_sequence)
+{
+    SmartLock lock(_settingsMutex);
+    int64_t now = request_time_now ();
+
+    // configure pass, no stats are analyzed with the request
+    if (frame_sequence < 0) {
+        if (_req_bound != _req_tail)
+            return _requests[_req_bound % RKISP_REQUEST_RING_SIZE].params;
+        return _cur_settings;
+    }
+
+    /*
+     * stats of the frames between the last analyzed one and this one never
+     * reached 3a, give each of them one request so requests stay paired with
+     * their own frame; the last pending request is kept for this frame
+     */
+    if (_last_frame_sequence >= 0 && frame_sequence > _last_frame_sequence + 1) {
+        int skipped = _last_frame_sequence + 1;
+        while (skipped < frame_sequence && _req_tail - _req_bound > 1) {
+            XCAM_LOG_DEBUG ("stats of frame %d dropped, request %d realigned",
+                            skipped, _requests[_req_bound % RKISP_REQUEST_RING_SIZE].params->reqId);
+            bind_request_unsafe (skipped++, now);
+        }
+    }
+    _last_frame_sequence = frame_sequence;
+
+    if (_req_bound != _req_tail)
+        bind_request_unsafe (frame_sequence, now);
+
+    return _cur_settings;
+}
+
+RkispRequestStats
+RkispDeviceManager::get_request_stats()
+{
+    SmartLock lock(_settingsMutex);
+    return _req_stats;
+}
+
 void
 RkispDeviceManager::pause_dequeue ()
 {
-    // should stop 3a because isp video stream may have been stopped
+    // should stop 3a because isp video stream may have been stopped,
+    // returns once the analyzer released every leased stats buffer, so the
+    // stats device can be stopped and unmapped below
     if (_poll_thread.ptr())
         _poll_thread->stop();
     if (_isp_params_device.ptr() && _isp_params_device->is_activated())
@@ -171,6 +287,12 @@ RkispDeviceManager::resume_dequeue ()
     if (_isp_stats_device.ptr() && !_isp_stats_device->is_activated())
         _isp_stats_device->start();
 
+    {
+        // frame sequence restarts with the stream
+        SmartLock lock(_settingsMutex);
+        _last_frame_sequence = -1;
+    }
+
     // for IspController 
     ispPollThread->resume();
     // sensor mode may be changed, so we should re-generate the first isp
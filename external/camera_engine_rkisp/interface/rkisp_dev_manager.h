@@ -83,9 +83,33 @@ using ::android::hardware::camera::common::V1_0::helper::CameraMetadata;
 
 #define CONFIG_CAM_ENGINE_LIB_VERSION "v1.6.0"
 
+// control requests in flight, between set_control_params and the metadata callback
+#define RKISP_REQUEST_RING_SIZE 32
+
 using namespace XCam;
 class SettingsProcessor;
 
+struct RkispRequestStats {
+    uint64_t completed;
+    // overwritten in a full ring before 3a ran on them
+    uint64_t dropped;
+    // bound to a frame whose stats never arrived, completed with a later frame
+    uint64_t realigned;
+    // accumulated submit -> 3a and 3a -> metadata callback, in usec
+    int64_t  queue_usec;
+    int64_t  result_usec;
+    int64_t  max_latency_usec;
+    // metering regions reused from an identical earlier request, see SettingsProcessor
+    uint64_t metering_hits;
+    uint64_t metering_misses;
+
+    RkispRequestStats ()
+        : completed (0), dropped (0), realigned (0)
+        , queue_usec (0), result_usec (0), max_latency_usec (0)
+        , metering_hits (0), metering_misses (0)
+    {}
+};
+
 class RkispDeviceManager
     : public XCam::DeviceManager
 {
@@ -99,14 +123,13 @@ public:
     XCamReturn set_control_params(const int request_frame_id,
                                   const camera_metadata_t *metas);
 
-    XCam::SmartPtr<AiqInputParams> getAiqInputParams()
-    {
-        SmartLock lock(_settingsMutex);
-        if (!_settings.empty())
-            _cur_settings = *_settings.begin();
-
-        return _cur_settings;
-    }
+    /*
+     * binds the oldest pending request to the stats of @frame_sequence; with
+     * -1 (configure_3a) it is only looked at and stays pending for the first
+     * stats. The latest settings are reused if nothing is pending.
+     */
+    XCam::SmartPtr<AiqInputParams> getAiqInputParams(int frame_sequence = -1);
+    RkispRequestStats get_request_stats();
 
     // only called one time in the func rkisp_cl_prepare@rkisp_control_loop_impl.cpp
     void set_static_metadata(const camera_metadata_t *metas) { staticMeta = metas; };
@@ -144,9 +167,27 @@ private:
     XCam::SmartPtr<XCam::CL3aImageProcessor>   _cl_image_processor;
     XCam::SmartPtr<XCam::CLPostImageProcessor> _cl_post_image_processor;
 #endif
+    struct RequestSlot {
+        XCam::SmartPtr<AiqInputParams> params;
+        int              frame_sequence;
+        int64_t          submit_time;
+        int64_t          analyze_time;
+    };
+
+    void bind_request_unsafe (int frame_sequence, int64_t now);
+
     Mutex _settingsMutex;
-    // push_back when set_control_params, erase when calculationd done
-    std::vector<XCam::SmartPtr<AiqInputParams>>  _settings;
+    /*
+     * filled by set_control_params, bound to a frame by getAiqInputParams and
+     * retired when its results are done, all in submission order:
+     * [_req_head, _req_bound) bound, [_req_bound, _req_tail) pending
+     */
+    RequestSlot                     _requests[RKISP_REQUEST_RING_SIZE];
+    uint32_t                        _req_head;
+    uint32_t                        _req_bound;
+    uint32_t                        _req_tail;
+    int                             _last_frame_sequence;
+    RkispRequestStats               _req_stats;
     XCam::SmartPtr<AiqInputParams>  _cur_settings;
     SettingsProcessor*            _settingsProcessor;
     static CameraMetadata staticMeta;
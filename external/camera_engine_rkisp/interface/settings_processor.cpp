@@ -24,6 +24,9 @@
 
 SettingsProcessor::SettingsProcessor()
 {
+    for (int i = 0; i < METERING_REGION_TAGS; i++)
+        for (int j = 0; j < METERING_REGION_CACHE_WAYS; j++)
+            mMeteringCache[i][j].valid = false;
 }
 
 SettingsProcessor::~SettingsProcessor()
@@ -129,6 +132,89 @@ void SettingsProcessor::convertCoordinates(CameraWindow *region,
     }
 }
 
+/**
+ * Resolves a metering region for the request, see parseMeteringRegion and
+ * convertCoordinates.
+ *
+ * Repeated requests carry the same regions nearly every frame, so the
+ * result is memoized on the crop region, the metering region, the sensor
+ * output size and the pixel array size, which is all it depends on.
+ *
+ * \param[in] settings request settings to parse
+ * \param[in] tagId one of the 3 metadata tags for the metering regions
+ * \param[out] meteringWindow region in request coordinates
+ * \param[out] sensorWindow region in sensor output coordinates
+ */
+void SettingsProcessor::resolveMeteringRegion(const CameraMetadata *settings, int tagId,
+                                   int sensorOutputWidth, int sensorOutputHeight,
+                                   CameraWindow *meteringWindow, CameraWindow *sensorWindow)
+{
+    int tagIndex;
+    switch (tagId) {
+    case ANDROID_CONTROL_AE_REGIONS:
+        tagIndex = 0;
+        break;
+    case ANDROID_CONTROL_AWB_REGIONS:
+        tagIndex = 1;
+        break;
+    case ANDROID_CONTROL_AF_REGIONS:
+        tagIndex = 2;
+        break;
+    default:
+        parseMeteringRegion(settings, tagId, meteringWindow);
+        *sensorWindow = *meteringWindow;
+        convertCoordinates(sensorWindow, sensorOutputWidth, sensorOutputHeight);
+        return;
+    }
+
+    MeteringRegionKey key;
+    CLEAR(key);
+    key.tagId = tagId;
+    camera_metadata_ro_entry_t entry = settings->find(ANDROID_SCALER_CROP_REGION);
+    key.cropCount = entry.count;
+    for (size_t i = 0; i < entry.count && i < 4; i++)
+        key.crop[i] = entry.data.i32[i];
+    entry = settings->find(tagId);
+    key.regionCount = entry.count;
+    for (size_t i = 0; i < entry.count && i < 5; i++)
+        key.region[i] = entry.data.i32[i];
+    key.sensorOutput[0] = sensorOutputWidth;
+    key.sensorOutput[1] = sensorOutputHeight;
+    CameraMetadata& staticMeta = RkispDeviceManager::get_static_metadata();
+    camera_metadata_entry_t rw_entry = staticMeta.find(ANDROID_SENSOR_INFO_PIXEL_ARRAY_SIZE);
+    if (rw_entry.count == 2) {
+        key.pixelArray[0] = rw_entry.data.i32[0];
+        key.pixelArray[1] = rw_entry.data.i32[1];
+    }
+
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    const uint8_t *bytes = (const uint8_t *)&key;
+    for (size_t i = 0; i < sizeof(key); i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+
+    MeteringRegionEntry &cached = mMeteringCache[tagIndex][hash % METERING_REGION_CACHE_WAYS];
+    if (cached.valid && cached.hash == hash && !memcmp(&cached.key, &key, sizeof(key))) {
+        mMeteringCacheStats.hits++;
+        *meteringWindow = cached.window;
+        *sensorWindow = cached.sensorWindow;
+        return;
+    }
+
+    mMeteringCacheStats.misses++;
+    parseMeteringRegion(settings, tagId, meteringWindow);
+    *sensorWindow = *meteringWindow;
+    convertCoordinates(sensorWindow, sensorOutputWidth, sensorOutputHeight);
+
+    cached.valid = true;
+    cached.hash = hash;
+    cached.key = key;
+    cached.window = *meteringWindow;
+    cached.sensorWindow = *sensorWindow;
+}
+
 /**
  * \brief Converts AE related metadata into AeInputParams
  *
@@ -208,11 +294,12 @@ SettingsProcessor::fillAeInputParams(const CameraMetadata *settings,
         }
     }
 
-    CameraWindow aeRegion;
-    parseMeteringRegion(settings, ANDROID_CONTROL_AE_REGIONS, &aeRegion);
-    memcpy(aiqInputParams->aeInputParams.aeRegion, aeRegion.meteringRectangle(),
+    CameraWindow aeRequestRegion, aeRegion;
+    resolveMeteringRegion(settings, ANDROID_CONTROL_AE_REGIONS,
+                          aiqInputParams->sensorOutputWidth, aiqInputParams->sensorOutputHeight,
+                          &aeRequestRegion, &aeRegion);
+    memcpy(aiqInputParams->aeInputParams.aeRegion, aeRequestRegion.meteringRectangle(),
            sizeof(aiqInputParams->aeInputParams.aeRegion));
-    convertCoordinates(&aeRegion, aiqInputParams->sensorOutputWidth, aiqInputParams->sensorOutputHeight);
 
     if (aeRegion.isValid()) {
         aeParams->window.x_start = aeRegion.left();
@@ -433,11 +520,12 @@ SettingsProcessor::fillAwbInputParams(const CameraMetadata *settings,
      */
 
     //# METADATA_Control control.awbRegion done
-    CameraWindow awbRegion;
-    parseMeteringRegion(settings, ANDROID_CONTROL_AWB_REGIONS, &awbRegion);
-    memcpy(aiqInputParams->awbInputParams.awbRegion, awbRegion.meteringRectangle(),
+    CameraWindow awbRequestRegion, awbRegion;
+    resolveMeteringRegion(settings, ANDROID_CONTROL_AWB_REGIONS,
+                          aiqInputParams->sensorOutputWidth, aiqInputParams->sensorOutputHeight,
+                          &awbRequestRegion, &awbRegion);
+    memcpy(aiqInputParams->awbInputParams.awbRegion, awbRequestRegion.meteringRectangle(),
            sizeof(aiqInputParams->awbInputParams.awbRegion));
-    convertCoordinates(&awbRegion, aiqInputParams->sensorOutputWidth, aiqInputParams->sensorOutputHeight);
     if (awbRegion.isValid()) {
         awbCfg->window.x_start = awbRegion.left();
         awbCfg->window.y_start = awbRegion.top();
@@ -651,11 +739,12 @@ SettingsProcessor::fillAfInputParams(const CameraMetadata *settings,
      * we only support one for the time being
      */
     //# METADATA_Control control.afRegions done
-    CameraWindow afRegion;
-    parseMeteringRegion(settings, ANDROID_CONTROL_AF_REGIONS, &afRegion);
-    memcpy(aiqInputParams->afInputParams.afRegion, afRegion.meteringRectangle(),
+    CameraWindow afRequestRegion, afRegion;
+    resolveMeteringRegion(settings, ANDROID_CONTROL_AF_REGIONS,
+                          aiqInputParams->sensorOutputWidth, aiqInputParams->sensorOutputHeight,
+                          &afRequestRegion, &afRegion);
+    memcpy(aiqInputParams->afInputParams.afRegion, afRequestRegion.meteringRectangle(),
            sizeof(aiqInputParams->afInputParams.afRegion));
-    convertCoordinates(&afRegion, aiqInputParams->sensorOutputWidth, aiqInputParams->sensorOutputHeight);
     if (afRegion.isValid()) {
         afCfg.focus_rect[0].left_hoff = afRegion.left();
         afCfg.focus_rect[0].top_voff = afRegion.top();
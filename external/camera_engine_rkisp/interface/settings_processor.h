@@ -34,6 +34,20 @@ using ::android::hardware::camera::common::V1_0::helper::CameraMetadata;
 using namespace android;
 using namespace XCam;
 
+/* AE, AWB and AF metering regions */
+#define METERING_REGION_TAGS 3
+/* regions memoized per tag, picked by the region hash */
+#define METERING_REGION_CACHE_WAYS 2
+
+struct MeteringRegionCacheStats {
+    uint64_t hits;
+    uint64_t misses;
+
+    MeteringRegionCacheStats ()
+        : hits (0), misses (0)
+    {}
+};
+
 class SettingsProcessor
 {
 public:
@@ -45,7 +59,28 @@ public:
     XCamReturn processRequestSettings(const CameraMetadata &settings,
                                     AiqInputParams &aiqparams);
 
+    MeteringRegionCacheStats getMeteringCacheStats() const { return mMeteringCacheStats; }
+
 private:
+    /* every request value a metering region depends on */
+    struct MeteringRegionKey {
+        int32_t tagId;
+        int32_t cropCount;
+        int32_t crop[4];
+        int32_t regionCount;
+        int32_t region[5];
+        int32_t sensorOutput[2];
+        int32_t pixelArray[2];
+    };
+
+    struct MeteringRegionEntry {
+        bool valid;
+        uint32_t hash;
+        MeteringRegionKey key;
+        CameraWindow window;
+        CameraWindow sensorWindow;
+    };
+
 
     XCamReturn processAwbSettings(const CameraMetadata &settings,
                                 AiqInputParams &aiqparams);
@@ -63,8 +98,17 @@ private:
                              int tagId, CameraWindow *meteringWindow);
     void convertCoordinates(CameraWindow *region,
                            int sensorOutputWidth, int sensorOutputHeight);
+    /*
+     * parseMeteringRegion then convertCoordinates, memoized on the request
+     * values they read, @meteringWindow is in request coordinates and
+     * @sensorWindow in sensor output coordinates
+     */
+    void resolveMeteringRegion(const CameraMetadata *settings, int tagId,
+                               int sensorOutputWidth, int sensorOutputHeight,
+                               CameraWindow *meteringWindow, CameraWindow *sensorWindow);
 private:
-
+    MeteringRegionEntry mMeteringCache[METERING_REGION_TAGS][METERING_REGION_CACHE_WAYS];
+    MeteringRegionCacheStats mMeteringCacheStats;
 };
 
 #endif //__SETTINGS_PROCESSOR_H
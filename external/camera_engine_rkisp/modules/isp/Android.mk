@@ -15,6 +15,8 @@ LOCAL_SRC_FILES +=\
 	sensor_descriptor.cpp \
 	x3a_analyzer_rkiq.cpp \
 	x3a_isp_config.cpp \
+	x3a_meta_result.cpp \
+	x3a_replay.cpp \
 	x3a_statistics_queue.cpp \
 	ae_state_machine.cpp \
 	awb_state_machine.cpp \
@@ -85,7 +85,7 @@ RkAEStateMachine::processState(const uint8_t &controlMode,
  */
 XCamReturn
 RkAEStateMachine::processResult(const rk_aiq_ae_results &aeResults,
-                                   CameraMetadata &result,
+                                   XmetaResult &result,
                                    uint32_t reqId)
 {
     XCamReturn ret;
@@ -114,7 +114,7 @@ RkAEModeBase::RkAEModeBase():
 }
 
 void
-RkAEModeBase::updateResult(CameraMetadata &results)
+RkAEModeBase::updateResult(XmetaResult &results)
 {
 
     LOGD("%s: current AE state is: %s", __FUNCTION__,
@@ -176,7 +176,7 @@ RkAEModeOff::processState(const uint8_t &controlMode,
 
 XCamReturn
 RkAEModeOff::processResult(const rk_aiq_ae_results &aeResults,
-                              CameraMetadata &result,
+                              XmetaResult &result,
                               uint32_t reqId)
 {
     /* UNUSED(aeResults); */
@@ -250,7 +250,7 @@ RkAEModeAuto::processState(const uint8_t &controlMode,
 
 XCamReturn
 RkAEModeAuto::processResult(const rk_aiq_ae_results &aeResults,
-                               CameraMetadata &result,
+                               XmetaResult &result,
                                uint32_t reqId)
 {
     switch (mCurrentAeState) {
@@ -18,12 +18,7 @@
 #define _AE_STATE_MACHINE_H_
 
 #include <xcam_std.h>
-#ifdef ANDROID_VERSION_ABOVE_8_X
-#include <CameraMetadata.h>
-using ::android::hardware::camera::common::V1_0::helper::CameraMetadata;
-#else
-#include <camera/CameraMetadata.h>
-#endif
+#include "x3a_meta_result.h"
 #include "rkaiq.h"
 #include "rk_aiq_types.h"
 #include <base/log.h>
@@ -49,13 +44,13 @@ public:
 
 
     virtual XCamReturn processResult(const rk_aiq_ae_results &aeResults,
-                                   CameraMetadata &results,
+                                   XmetaResult &results,
                                    uint32_t reqId) = 0;
 
     void resetState(void);
     uint8_t getState() const { return mCurrentAeState; }
 protected:
-    void updateResult(CameraMetadata &results);
+    void updateResult(XmetaResult &results);
 protected:
     AeControls  mLastAeControls;
     uint8_t     mLastControlMode;
@@ -79,7 +74,7 @@ public:
     virtual XCamReturn processState(const uint8_t &controlMode,
                                   const AeControls &aeControls);
     virtual XCamReturn processResult(const rk_aiq_ae_results & aeResults,
-                                  CameraMetadata& result,
+                                  XmetaResult &result,
                                   uint32_t reqId);
 };
 
@@ -94,7 +89,7 @@ public:
     virtual XCamReturn processState(const uint8_t &controlMode,
                                   const AeControls &aeControls);
     virtual XCamReturn processResult(const rk_aiq_ae_results & aeResults,
-                                  CameraMetadata& result,
+                                  XmetaResult &result,
                                   uint32_t reqId);
 };
 
@@ -116,7 +111,7 @@ public:
                                   const AeControls &aeControls);
 
     virtual XCamReturn processResult(const rk_aiq_ae_results &aeResults,
-                                   CameraMetadata &results,
+                                   XmetaResult &results,
                                    uint32_t reqId);
 
     uint8_t getState() const { return mCurrentAeMode->getState(); }
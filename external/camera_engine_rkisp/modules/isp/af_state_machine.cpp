@@ -118,7 +118,7 @@ RkAFStateMachine::processTriggers(const uint8_t &afTrigger,
 XCamReturn
 RkAFStateMachine::processResult(rk_aiq_af_results &afResults,
                                    XCamAfParam &afInputParams,
-                                   CameraMetadata &result)
+                                   XmetaResult &result)
 {
     if (CC_UNLIKELY(mCurrentAfMode == nullptr)) {
         LOGE("Invalid AF mode - this could not happen - BUG!");
@@ -139,7 +139,7 @@ RkAFStateMachine::processResult(rk_aiq_af_results &afResults,
 XCamReturn
 RkAFStateMachine::updateDefaults(const rk_aiq_af_results& afResults,
                                     const XCamAfParam &afInputParams,
-                                    CameraMetadata& result,
+                                    XmetaResult &result,
                                     bool fixedFocus) const
 {
     mCurrentAfMode->updateResult(result);
@@ -157,7 +157,7 @@ RkAFStateMachine::updateDefaults(const rk_aiq_af_results& afResults,
 void
 RkAFStateMachine::focusDistanceResult(const rk_aiq_af_results &afResults,
                                          const XCamAfParam &afInputParams,
-                                         CameraMetadata &result) const
+                                         XmetaResult &result) const
 {
     // "APPROXIMATE and CALIBRATED devices report the focus metadata
     // in units of diopters (1/meter)", so 0.0f represents focusing at infinity."
@@ -239,7 +239,7 @@ RkAfModeBase::processTriggers(const uint8_t &afTrigger,
 }
 
 void
-RkAfModeBase::updateResult(CameraMetadata& results)
+RkAfModeBase::updateResult(XmetaResult &results)
 {
 
     //# METADATA_Dynamic control.afMode done
@@ -317,7 +317,7 @@ RkAFModeOff::processTriggers(const uint8_t &afTrigger,
 
 XCamReturn
 RkAFModeOff::processResult(rk_aiq_af_results& afResults,
-                              CameraMetadata& result)
+                              XmetaResult &result)
 {
     /**
      * IN MANUAL and EDOF AF state never changes
@@ -406,7 +406,7 @@ RkAFModeAuto::processTriggers(const uint8_t &afTrigger,
 
 XCamReturn
 RkAFModeAuto::processResult(rk_aiq_af_results& afResult,
-                               CameraMetadata& result)
+                               XmetaResult &result)
 {
     mLensState = ANDROID_LENS_STATE_STATIONARY;
 
@@ -521,7 +521,7 @@ RkAFModeContinuousPicture::processTriggers(const uint8_t &afTrigger,
 
 XCamReturn
 RkAFModeContinuousPicture::processResult(rk_aiq_af_results& afResult,
-                                           CameraMetadata& result)
+                                           XmetaResult &result)
 {
     mLensState = ANDROID_LENS_STATE_STATIONARY;
 
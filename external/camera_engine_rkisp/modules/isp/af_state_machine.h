@@ -17,12 +17,7 @@
 #define _AF_STATE_MACHINE_H_
 
 #include <xcam_std.h>
-#ifdef ANDROID_VERSION_ABOVE_8_X
-#include <CameraMetadata.h>
-using ::android::hardware::camera::common::V1_0::helper::CameraMetadata;
-#else
-#include <camera/CameraMetadata.h>
-#endif
+#include "x3a_meta_result.h"
 #include "rkaiq.h"
 #include "rk_aiq_types.h"
 #include <base/log.h>
@@ -55,11 +50,11 @@ public:
                                      int preCaptureId,
                                      XCamAfParam& afInputParams);
     virtual XCamReturn processResult(rk_aiq_af_results& afResults,
-                                   CameraMetadata& result) = 0;
+                                   XmetaResult &result) = 0;
     void resetState(void);
     void resetTrigger(usecs_t triggerTime);
     int getState() { return mCurrentAfState; }
-    void updateResult(CameraMetadata& results);
+    void updateResult(XmetaResult &results);
 protected:
     void checkIfFocusTimeout();
 protected:
@@ -83,7 +78,7 @@ public:
                                      int preCaptureId,
                                      XCamAfParam& afInputParams);
     virtual XCamReturn processResult(rk_aiq_af_results& afResults,
-                                  CameraMetadata& result);
+                                  XmetaResult &result);
 };
 
 /**
@@ -99,7 +94,7 @@ public:
                                      int preCaptureId,
                                      XCamAfParam& afInputParams);
     virtual XCamReturn processResult(rk_aiq_af_results& afResults,
-                                  CameraMetadata& result);
+                                  XmetaResult &result);
 };
 
 /**
@@ -115,7 +110,7 @@ public:
                                      int preCaptureId,
                                      XCamAfParam& afInputParams);
     virtual XCamReturn processResult(rk_aiq_af_results& afResults,
-                                  CameraMetadata& result);
+                                  XmetaResult &result);
 };
 
 /**
@@ -139,11 +134,11 @@ public:
 
     virtual XCamReturn processResult(rk_aiq_af_results &afResults,
                                    XCamAfParam &afInputParams,
-                                   CameraMetadata& result);
+                                   XmetaResult &result);
 
     virtual XCamReturn updateDefaults(const rk_aiq_af_results &afResults,
                                     const XCamAfParam &afInputParams,
-                                    CameraMetadata &result,
+                                    XmetaResult &result,
                                     bool fixedFocus = false) const;
 
 private:
@@ -153,7 +148,7 @@ private:
 
     void focusDistanceResult(const rk_aiq_af_results &afResults,
                              const XCamAfParam &afInputParams,
-                             CameraMetadata &result) const;
+                             XmetaResult &result) const;
 
 private: /* members*/
     int mCameraId;
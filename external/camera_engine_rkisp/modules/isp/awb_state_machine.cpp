@@ -75,7 +75,7 @@ RkAWBStateMachine::processState(const uint8_t &controlMode,
 
 XCamReturn
 RkAWBStateMachine::processResult(const rk_aiq_awb_results &awbResults,
-                                    CameraMetadata &result)
+                                    XmetaResult &result)
 {
     XCamReturn ret;
 
@@ -99,7 +99,7 @@ RkAWBModeBase::RkAWBModeBase():
 }
 
 void
-RkAWBModeBase::updateResult(CameraMetadata& results)
+RkAWBModeBase::updateResult(XmetaResult &results)
 {
 
     LOGI("%s: current AWB state is: %s", __FUNCTION__,
@@ -150,7 +150,7 @@ RkAWBModeOff::processState(const uint8_t &controlMode,
 
 XCamReturn
 RkAWBModeOff::processResult(const rk_aiq_awb_results& awbResults,
-                               CameraMetadata& result)
+                               XmetaResult &result)
 {
     /* UNUSED(awbResults); */
 
@@ -205,7 +205,7 @@ RkAWBModeAuto::processState(const uint8_t &controlMode,
 
 XCamReturn
 RkAWBModeAuto::processResult(const rk_aiq_awb_results &awbResults,
-                                CameraMetadata& result)
+                                XmetaResult &result)
 {
     switch (mCurrentAwbState) {
         case ANDROID_CONTROL_AWB_STATE_LOCKED:
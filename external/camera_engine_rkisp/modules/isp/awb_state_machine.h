@@ -18,12 +18,7 @@
 #define _AWB_STATE_MACHINE_H_
 
 #include <xcam_std.h>
-#ifdef ANDROID_VERSION_ABOVE_8_X
-#include <CameraMetadata.h>
-using ::android::hardware::camera::common::V1_0::helper::CameraMetadata;
-#else
-#include <camera/CameraMetadata.h>
-#endif
+#include "x3a_meta_result.h"
 #include "rkaiq.h"
 #include "rk_aiq_types.h"
 #include <base/log.h>
@@ -49,12 +44,12 @@ public:
 
 
     virtual XCamReturn processResult(const rk_aiq_awb_results &awbResults,
-                                   CameraMetadata &results) = 0;
+                                   XmetaResult &results) = 0;
 
     void resetState(void);
     uint8_t getState() const { return mCurrentAwbState; }
 protected:
-    void updateResult(CameraMetadata& results);
+    void updateResult(XmetaResult &results);
 protected:
     AwbControls  mLastAwbControls;
     uint8_t     mLastControlMode;
@@ -72,7 +67,7 @@ public:
     virtual XCamReturn processState(const uint8_t &controlMode,
                                   const AwbControls &awbControls);
     virtual XCamReturn processResult(const rk_aiq_awb_results &awbResults,
-                                  CameraMetadata& result);
+                                  XmetaResult &result);
 };
 
 /**
@@ -86,7 +81,7 @@ public:
     virtual XCamReturn processState(const uint8_t &controlMode,
                                   const AwbControls &awbControls);
     virtual XCamReturn processResult(const rk_aiq_awb_results &awbResults,
-                                  CameraMetadata& result);
+                                  XmetaResult &result);
 };
 
 /**
@@ -107,7 +102,7 @@ public:
                                   const AwbControls &awbControls);
 
     virtual XCamReturn processResult(const rk_aiq_awb_results &awbResults,
-                                   CameraMetadata &results);
+                                   XmetaResult &results);
 
     uint8_t getState() const { return mCurrentAwbMode->getState(); }
 private:
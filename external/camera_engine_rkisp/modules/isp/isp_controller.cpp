@@ -22,12 +22,17 @@
 #include "v4l2_device.h"
 #include "x3a_statistics_queue.h"
 #include "x3a_isp_config.h"
+#include "copy_counter.h"
+#include "xcam_trace.h"
 
 #include <linux/rkisp.h>
 #include <rkiq_params.h>
+#include <poll.h>
 
 namespace XCam {
 
+static CopyCounter isp_stats_copy_counter ("isp_stats");
+
 IspController::IspController ():
     _is_exit(false),
     _device(NULL),
@@ -38,28 +43,119 @@ IspController::IspController ():
     _isp_ioctl(NULL),
     _frame_sequence(0),
     _frame_sof_time(0),
-    _ae_stats_delay(-1)
+    _ae_stats_delay(-1),
+    _params_reset(true),
+    _params_buf_count(0),
+    _params_pending_cfg(0),
+    _params_pending_en(0),
+    _sensor_desc_valid(false)
 {
     xcam_mem_clear(_last_aiq_results);
     xcam_mem_clear(_full_active_isp_params);
+    xcam_mem_clear(_sensor_desc);
+    _stats_leases = new X3aIspStatsLeases ();
+    xcam_mem_clear(_params_state);
+    xcam_mem_clear(_params_target_sequence);
     _max_delay = EXPOSURE_GAIN_DELAY > EXPOSURE_TIME_DELAY ?
                     EXPOSURE_GAIN_DELAY : EXPOSURE_TIME_DELAY;
 
-    _exposure_queue = 
-        (struct rkisp_exposure *)xcam_malloc0(sizeof(struct rkisp_exposure) * _max_delay);
-
     XCAM_LOG_DEBUG ("IspController construction");
 }
 
 IspController::~IspController ()
 {
     XCAM_LOG_DEBUG ("~IspController destruction");
-    free(_exposure_queue);
+}
+
+IspExposureSchedule::IspExposureSchedule ()
+    : _written (0)
+{
+    for (uint32_t i = 0; i < ISP_EXPOSURE_SCHEDULE_SIZE; ++i) {
+        _slots[i].seq.store (0, std::memory_order_relaxed);
+        xcam_mem_clear (_slots[i].entry);
+    }
+}
+
+void
+IspExposureSchedule::push (const IspExposureEntry &entry)
+{
+    uint32_t index = _written.load (std::memory_order_relaxed);
+    Slot &slot = _slots[index % ISP_EXPOSURE_SCHEDULE_SIZE];
+
+    slot.seq.store (0, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+    slot.entry = entry;
+    slot.seq.store (index + 1, std::memory_order_release);
+    _written.store (index + 1, std::memory_order_release);
+}
+
+bool
+IspExposureSchedule::read_slot (uint32_t index, IspExposureEntry &entry) const
+{
+    const Slot &slot = _slots[index % ISP_EXPOSURE_SCHEDULE_SIZE];
+    uint32_t seq = slot.seq.load (std::memory_order_acquire);
+    if (seq != index + 1)
+        return false;
+
+    entry = slot.entry;
+    std::atomic_thread_fence (std::memory_order_acquire);
+    return slot.seq.load (std::memory_order_relaxed) == seq;
+}
+
+bool
+IspExposureSchedule::get_latest (IspExposureEntry &entry) const
+{
+    uint32_t written = _written.load (std::memory_order_acquire);
+    return written && read_slot (written - 1, entry);
+}
+
+bool
+IspExposureSchedule::get_for_stats (int stats_frame, IspExposureEntry &entry) const
+{
+    uint32_t written = _written.load (std::memory_order_acquire);
+    uint32_t first = written > ISP_EXPOSURE_SCHEDULE_SIZE ? written - ISP_EXPOSURE_SCHEDULE_SIZE : 0;
+    bool found = false;
+
+    for (uint32_t i = written; i > first; --i) {
+        IspExposureEntry slot_entry;
+        if (!read_slot (i - 1, slot_entry))
+            continue;
+        entry = slot_entry;
+        found = true;
+        if (slot_entry.stats_frame <= stats_frame)
+            return true;
+    }
+    // stats older than every kept exposure, or frame ids restarted with the stream
+    return found;
 }
 
 void IspController::exit(bool pause) {
     XCAM_LOG_DEBUG("ISP controller has exit %d", pause);
     _is_exit = pause;
+
+    // params device was restarted, the kernel owns none of the buffers
+    if (!pause) {
+        SmartLock locker (_params_mutex);
+        _params_reset = true;
+    }
+
+#if RKISP
+    // sensor mode may be switched while paused, query it again before streaming
+    if (!pause && _sensor_subdev.ptr ()) {
+        rk_aiq_exposure_sensor_descriptor sensor_desc;
+        invalidate_sensor_descriptor ();
+        if (get_sensor_descriptor (&sensor_desc) != XCAM_RETURN_NO_ERROR)
+            XCAM_LOG_WARNING ("query sensor descriptor failed, retry on first use");
+    }
+#endif
+}
+
+void
+IspController::wait_stats_leases ()
+{
+    // nothing dequeues stats any more, the analyzer returns what it still holds
+    _stats_leases->wait_idle (-1);
+    _stats_leases->invalidate ();
 }
 
 void
@@ -76,6 +172,7 @@ IspController::set_video_device(SmartPtr<V4l2Device> &dev) {
 void
 IspController::set_sensor_subdev (SmartPtr<V4l2SubDevice> &subdev) {
     _sensor_subdev = subdev;
+    invalidate_sensor_descriptor ();
 };
 
 void
@@ -97,31 +194,30 @@ IspController::set_isp_params_device(SmartPtr<V4l2Device> &dev) {
 XCamReturn
 IspController::handle_sof(int64_t time, int frameid)
 {
+    FrameTracer::instant (XCAM_TRACE_SOF, frameid);
     SmartLock locker (_mutex);
-    _frame_sequence_cond.signal();
 
     _frame_sof_time = time;
     _frame_sequence = frameid;
 
-    char log_str[1024];
-    int num = 0;
-    for(int i=0; i<EXPOSURE_TIME_DELAY; i++) {
-        num += sprintf(log_str + num, "        |||queue(%d) (%d-%d) expsync\n",
-                    i,
-                    _exposure_queue[i].coarse_integration_time,
-                    _exposure_queue[i].analog_gain);
+    {
+        SmartLock params_locker (_params_mutex);
+        reclaim_params_buffers_unsafe ();
     }
 
-    XCAM_LOG_DEBUG("--SOF[%d]------------------expsync-statsync\n%s", frameid, log_str);
-
-    struct rkisp_exposure exposure;
+    // the newest exposure is (re)written at every SOF, nothing is written before 3a pushed one
+    IspExposureEntry entry;
+    if (!_exposure_schedule.get_latest (entry)) {
+        XCAM_LOG_DEBUG("--SOF[%d] no exposure scheduled - expsync", frameid);
+        return XCAM_RETURN_NO_ERROR;
+    }
 
-    //exposure.coarse_integration_time = _exposure_queue[EXPOSURE_TIME_DELAY - 1].coarse_integration_time;
-    //exposure.analog_gain = _exposure_queue[EXPOSURE_GAIN_DELAY - 1].analog_gain;
-    //exposure.digital_gain = _exposure_queue[EXPOSURE_GAIN_DELAY - 1].digital_gain;
-    //exposure.frame_line_length = _exposure_queue[EXPOSURE_GAIN_DELAY - 1].frame_line_length;
-    exposure = _exposure_queue[EXPOSURE_GAIN_DELAY - 1];
-    set_3a_exposure(exposure);
+    XCAM_LOG_DEBUG("--SOF[%d] apply (%d-%d) target:%d apply:%d stats:%d - expsync",
+        frameid,
+        entry.exposure.coarse_integration_time,
+        entry.exposure.analog_gain,
+        entry.target_frame, entry.apply_frame, entry.stats_frame);
+    set_3a_exposure(entry.exposure);
 
     return XCAM_RETURN_NO_ERROR;
 }
@@ -244,7 +340,7 @@ IspController::get_sensor_fps(float& fps)
 }
 
 XCamReturn
-IspController::get_sensor_descriptor (rk_aiq_exposure_sensor_descriptor *sensor_desc)
+IspController::query_sensor_descriptor (rk_aiq_exposure_sensor_descriptor *sensor_desc)
 {
     memset(sensor_desc, 0, sizeof(rk_aiq_exposure_sensor_descriptor));
 
@@ -268,10 +364,40 @@ IspController::get_sensor_descriptor (rk_aiq_exposure_sensor_descriptor *sensor_
 
     return XCAM_RETURN_NO_ERROR;
 }
+
+XCamReturn
+IspController::get_sensor_descriptor (rk_aiq_exposure_sensor_descriptor *sensor_desc)
+{
+    SmartLock locker (_sensor_desc_mutex);
+
+    if (!_sensor_desc_valid) {
+        XCamReturn ret = query_sensor_descriptor (&_sensor_desc);
+        if (ret != XCAM_RETURN_NO_ERROR) {
+            memset(sensor_desc, 0, sizeof(rk_aiq_exposure_sensor_descriptor));
+            return ret;
+        }
+        _sensor_desc_valid = true;
+        XCAM_LOG_DEBUG ("sensor descriptor refreshed, %dx%d, ppl:%d, lpf:%d, pclk:%.2fMHz",
+                        _sensor_desc.sensor_output_width, _sensor_desc.sensor_output_height,
+                        _sensor_desc.pixel_periods_per_line, _sensor_desc.line_periods_per_field,
+                        _sensor_desc.pixel_clock_freq_mhz);
+    }
+    *sensor_desc = _sensor_desc;
+
+    return XCAM_RETURN_NO_ERROR;
+}
 #endif
 
+void
+IspController::invalidate_sensor_descriptor ()
+{
+    SmartLock locker (_sensor_desc_mutex);
+    _sensor_desc_valid = false;
+}
+
 XCamReturn
-IspController::get_sensor_mode_data (struct isp_supplemental_sensor_mode_data &sensor_mode_data)
+IspController::get_sensor_mode_data (struct isp_supplemental_sensor_mode_data &sensor_mode_data,
+                                     int stats_frame)
 {
     if (_is_exit)
         return XCAM_RETURN_BYPASS;
@@ -320,16 +446,20 @@ IspController::get_sensor_mode_data (struct isp_supplemental_sensor_mode_data &s
 
         sensor_mode_data.exposure_valid_frame[0]            =
             EXPOSURE_TIME_DELAY;
-        {
-            SmartLock locker (_mutex);
-            sensor_mode_data.exp_time                           =
-                _exposure_queue[0].coarse_integration_time;
-            sensor_mode_data.gain                               =
-                _exposure_queue[0].analog_gain;
-        }
-        XCAM_LOG_DEBUG("|||sensormode (%d-%d) expsync\n",
+        IspExposureEntry entry;
+        xcam_mem_clear (entry);
+        if (stats_frame < 0)
+            stats_frame = _frame_sequence;
+        _exposure_schedule.get_for_stats (stats_frame, entry);
+        sensor_mode_data.exp_time                           =
+            entry.exposure.coarse_integration_time;
+        sensor_mode_data.gain                               =
+            entry.exposure.analog_gain;
+        XCAM_LOG_DEBUG("|||sensormode stats[%d] (%d-%d) from exposure of frame %d expsync\n",
+            stats_frame,
             sensor_mode_data.exp_time,
-            sensor_mode_data.gain);
+            sensor_mode_data.gain,
+            entry.target_frame);
 
     }
 #endif
@@ -376,6 +506,7 @@ IspController::get_3a_statistics (SmartPtr<X3aIspStatistics> &stats)
     if (_isp_stats_device.ptr()) {
         SmartPtr<V4l2Buffer> v4l2buf;
         struct cifisp_stat_buffer* isp_stats = NULL;
+        TraceScope trace (XCAM_TRACE_STATS_DEQUEUE, -1);
 
         isp_stats =  (struct cifisp_stat_buffer*)stats->get_isp_stats ();
         ret = _isp_stats_device->dequeue_buffer (v4l2buf);
@@ -386,28 +517,40 @@ IspController::get_3a_statistics (SmartPtr<X3aIspStatistics> &stats)
         XCAM_ASSERT (v4l2buf.ptr());
 
         int cur_frame_id = v4l2buf->get_buf().sequence;
+        // lets the analyzer stamp its trace points with the frame id
+        stats->set_sequence (cur_frame_id);
+        trace.set_frame_id (cur_frame_id);
         int64_t cur_time = v4l2buf->get_buf().timestamp.tv_sec * 1000 * 1000 * 1000 +
                             v4l2buf->get_buf().timestamp.tv_usec * 1000;
 
         //translate stats to struct cifisp_stat_buffer
         struct cifisp_stat_buffer *aiq_stats = (struct cifisp_stat_buffer*)v4l2buf->map();
 
-        /* isp_stats->params.ae = aiq_stats->params.ae; */
-        /* isp_stats->params.hist= aiq_stats->params.hist; */
-        /* isp_stats->params.awb = aiq_stats->params.awb; */
-        /* isp_stats->params.af = aiq_stats->params.af; */
-        /* compatible with no emd info, so we could use new camera engine with
-         * old rkisp driver that has no emd field in stats
-         */
-        if (isp_stats->meas_type & CIFISP_STAT_EMB_DATA)
-            *isp_stats = *aiq_stats;
-        else
-            memcpy(isp_stats, aiq_stats,
-                   sizeof(*isp_stats) - sizeof(struct cifisp_embedded_data));
-        ret = _isp_stats_device->queue_buffer (v4l2buf);
-        if (ret != XCAM_RETURN_NO_ERROR) {
-            XCAM_LOG_WARNING ("queue stats buffer failed");
-            return ret;
+        if (v4l2buf->get_buf().length >= sizeof(struct cifisp_stat_buffer)) {
+            // analyzed in place, queued back when the stats are released
+            stats->lease (v4l2buf, _isp_stats_device, _stats_leases);
+            isp_stats = aiq_stats;
+        } else {
+            /* isp_stats->params.ae = aiq_stats->params.ae; */
+            /* isp_stats->params.hist= aiq_stats->params.hist; */
+            /* isp_stats->params.awb = aiq_stats->params.awb; */
+            /* isp_stats->params.af = aiq_stats->params.af; */
+            /* compatible with no emd info, so we could use new camera engine with
+             * old rkisp driver that has no emd field in stats
+             */
+            if (isp_stats->meas_type & CIFISP_STAT_EMB_DATA) {
+                *isp_stats = *aiq_stats;
+                isp_stats_copy_counter.record (sizeof(*isp_stats));
+            } else {
+                memcpy(isp_stats, aiq_stats,
+                       sizeof(*isp_stats) - sizeof(struct cifisp_embedded_data));
+                isp_stats_copy_counter.record (sizeof(*isp_stats) - sizeof(struct cifisp_embedded_data));
+            }
+            ret = _isp_stats_device->queue_buffer (v4l2buf);
+            if (ret != XCAM_RETURN_NO_ERROR) {
+                XCAM_LOG_WARNING ("queue stats buffer failed");
+                return ret;
+            }
         }
 
         XCAM_LOG_DEBUG("|||get_3a_statistics[%d-%d] MEAS AE: %d MEAS AWB[%d] [%d-%d-%d] expsync, meastype 0x%x",
@@ -489,18 +632,10 @@ IspController::get_3a_statistics (SmartPtr<X3aIspStatistics> &stats)
             _frame_sof_time, cur_time,
             cur_time - _frame_sof_time);
 
-resync:
         if (_frame_sequence < cur_frame_id) {
-            // impossible case
-            XCAM_LOG_DEBUG("[%d-%d] wait for next SOF signal[exit: %d] - statsync",
-                _frame_sequence, cur_frame_id, _is_exit);
-            if (!_is_exit) {
-                SmartLock locker (_mutex);
-                _frame_sequence_cond.timedwait(_mutex, 3000); //3ms
-                goto resync;
-            } else {
-                return XCAM_RETURN_BYPASS;
-            }
+            // the poll thread holds the stats back until the SOF is handled
+            XCAM_LOG_DEBUG("[%d-%d] SOF behind stats - statsync",
+                _frame_sequence, cur_frame_id);
         } else if (_frame_sequence > cur_frame_id) {
             if ( cur_time - _frame_sof_time < 10 * 1000 * 1000) {
                 XCAM_LOG_DEBUG("measurement late %lld for frame %d - statsync",
@@ -519,6 +654,31 @@ resync:
     return ret;
 }
 
+XCamReturn
+IspController::drop_3a_statistics ()
+{
+#if RKISP
+    if (_isp_stats_device.ptr()) {
+        SmartPtr<V4l2Buffer> v4l2buf;
+        XCamReturn ret = _isp_stats_device->dequeue_buffer (v4l2buf);
+        if (ret != XCAM_RETURN_NO_ERROR) {
+            XCAM_LOG_WARNING ("dequeue stats buffer failed");
+            return ret;
+        }
+        XCAM_LOG_WARNING ("drop stats of frame %d", v4l2buf->get_buf().sequence);
+        return _isp_stats_device->queue_buffer (v4l2buf);
+    }
+#endif
+    return XCAM_RETURN_NO_ERROR;
+}
+
+bool
+IspController::sof_arrived (int frameid)
+{
+    SmartLock locker (_mutex);
+    return _frame_sequence >= frameid;
+}
+
 XCamReturn
 IspController::get_frame_softime (int64_t &sof_tim)
 {
@@ -543,14 +703,35 @@ IspController::get_vcm_time (struct rk_cam_vcm_tim *vcm_tim)
     return XCAM_RETURN_NO_ERROR;
 }
 
+/*
+ * module_cfg_update/module_en_update of @full_params collect every module
+ * configured so far, @cfg_changed/@en_changed get the modules whose config
+ * or enable bit really differs from what was sent before.
+ */
+#define XCAM_ISP_MODULE_CFG_UPDATE(cfg)                                         \
+    do {                                                                        \
+        if (!(full_params->module_cfg_update & (1 << i)) ||                     \
+                memcmp (&full_params->cfg, &update_params->cfg,                 \
+                        sizeof (full_params->cfg))) {                           \
+            full_params->cfg = update_params->cfg;                              \
+            *cfg_changed |= 1 << i;                                             \
+        }                                                                       \
+    } while (0)
+
 void
 IspController::gen_full_isp_params(const struct rkisp1_isp_params_cfg *update_params,
-                                   struct rkisp1_isp_params_cfg *full_params)
+                                   struct rkisp1_isp_params_cfg *full_params,
+                                   unsigned int *cfg_changed,
+                                   unsigned int *en_changed)
 {
     XCAM_ASSERT (update_params);
     XCAM_ASSERT (full_params);
+    XCAM_ASSERT (cfg_changed && en_changed);
     int i = 0;
 
+    *cfg_changed = 0;
+    *en_changed = 0;
+
 	unsigned int module_en_update;
 	unsigned int module_ens;
 	unsigned int module_cfg_update;
@@ -559,6 +740,9 @@ IspController::gen_full_isp_params(const struct rkisp1_isp_params_cfg *update_pa
 	struct cifisp_isp_other_cfg others;
     for (; i <= CIFISP_DPF_STRENGTH_ID; i++)
         if (update_params->module_en_update & (1 << i)) {
+            if (!(full_params->module_en_update & (1 << i)) ||
+                    ((full_params->module_ens ^ update_params->module_ens) & (1 << i)))
+                *en_changed |= 1 << i;
             full_params->module_en_update |= 1 << i;
             // clear old bit value
             full_params->module_ens &= ~(1 << i);
@@ -568,64 +752,66 @@ IspController::gen_full_isp_params(const struct rkisp1_isp_params_cfg *update_pa
 
     for (i = 0; i <= CIFISP_DPF_STRENGTH_ID; i++) {
         if (update_params->module_cfg_update & (1 << i)) {
-            full_params->module_cfg_update |= 1 << i;
             switch (i) {
             case CIFISP_DPCC_ID:
-                full_params->others.dpcc_config = update_params->others.dpcc_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.dpcc_config);
                 break;
             case CIFISP_BLS_ID:
-                full_params->others.bls_config = update_params->others.bls_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.bls_config);
                 break;
             case CIFISP_SDG_ID:
-                full_params->others.sdg_config = update_params->others.sdg_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.sdg_config);
                 break;
             case CIFISP_HST_ID:
-                full_params->meas.hst_config = update_params->meas.hst_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (meas.hst_config);
                 break;
             case CIFISP_LSC_ID:
-                full_params->others.lsc_config = update_params->others.lsc_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.lsc_config);
                 break;
             case CIFISP_AWB_GAIN_ID:
-                full_params->others.awb_gain_config = update_params->others.awb_gain_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.awb_gain_config);
                 break;
             case CIFISP_FLT_ID:
-                full_params->others.flt_config = update_params->others.flt_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.flt_config);
                 break;
             case CIFISP_BDM_ID:
-                full_params->others.bdm_config = update_params->others.bdm_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.bdm_config);
                 break;
             case CIFISP_CTK_ID:
-                full_params->others.ctk_config = update_params->others.ctk_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.ctk_config);
                 break;
             case CIFISP_GOC_ID:
-                full_params->others.goc_config = update_params->others.goc_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.goc_config);
                 break;
             case CIFISP_CPROC_ID:
-                full_params->others.cproc_config = update_params->others.cproc_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.cproc_config);
                 break;
             case CIFISP_AFC_ID:
-                full_params->meas.afc_config = update_params->meas.afc_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (meas.afc_config);
                 break;
             case CIFISP_AWB_ID:
-                full_params->meas.awb_meas_config = update_params->meas.awb_meas_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (meas.awb_meas_config);
                 break;
             case CIFISP_IE_ID:
-                full_params->others.ie_config = update_params->others.ie_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.ie_config);
                 break;
             case CIFISP_AEC_ID:
-                full_params->meas.aec_config = update_params->meas.aec_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (meas.aec_config);
                 break;
             case CIFISP_WDR_ID:
+                if (!(full_params->module_cfg_update & (1 << i)))
+                    *cfg_changed |= 1 << i;
                 break;
             case CIFISP_DPF_ID:
-                full_params->others.dpf_config = update_params->others.dpf_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.dpf_config);
                 break;
             case CIFISP_DPF_STRENGTH_ID:
-                full_params->others.dpf_strength_config = update_params->others.dpf_strength_config;
+                XCAM_ISP_MODULE_CFG_UPDATE (others.dpf_strength_config);
                 break;
             default:
                 break;
             }
+            full_params->module_cfg_update |= 1 << i;
         }
     }
 }
@@ -639,6 +825,7 @@ IspController::set_3a_config (X3aIspConfig *config)
         XCAM_LOG_DEBUG ("set 3a config bypass since ia engine has stop");
         return XCAM_RETURN_BYPASS;
     }
+    TraceScope trace (XCAM_TRACE_SET_3A_CONFIG, _frame_sequence);
     struct rkisp_parameters &isp_config = config->get_isp_configs ();
     struct rkisp_parameters *isp_cfg = &isp_config;
 
@@ -647,11 +834,7 @@ IspController::set_3a_config (X3aIspConfig *config)
 #if RKISP
     if (_isp_params_device.ptr()) {
         struct rkisp1_isp_params_cfg* isp_params;
-        struct v4l2_buffer v4l2buf = _isp_params_device->get_buffer_by_index(0);
         struct rkisp1_isp_params_cfg update_params;
-        int sequence = v4l2buf.sequence;
-        if (0)
-            printf("params buf.sequence: %d\n", sequence);
         memset(&update_params, 0, sizeof(struct rkisp1_isp_params_cfg));
         ret = rkisp1_convert_results(&update_params,isp_cfg, _last_aiq_results);
         if (ret != XCAM_RETURN_NO_ERROR) {
@@ -664,42 +847,46 @@ IspController::set_3a_config (X3aIspConfig *config)
              update_params.module_en_update |= CIFISP_MODULE_BDM;
              update_params.module_cfg_update &= ~CIFISP_MODULE_BDM;
         }
-        gen_full_isp_params(&update_params, &_full_active_isp_params);
+        unsigned int cfg_changed, en_changed;
+        gen_full_isp_params(&update_params, &_full_active_isp_params,
+                            &cfg_changed, &en_changed);
+        _params_pending_cfg |= cfg_changed;
+        _params_pending_en |= en_changed;
+        {
+            SmartLock locker (_params_mutex);
+            _params_stats.modules_skipped +=
+                __builtin_popcount (update_params.module_cfg_update & ~cfg_changed);
+        }
+
+        int index = acquire_params_buffer ();
+        if (index < 0) {
+            // the full params are kept, the next free buffer carries this update
+            XCAM_LOG_DEBUG ("all isp params buffers are in flight, defer params of frame %d",
+                            _frame_sequence);
+            return XCAM_RETURN_NO_ERROR;
+        }
+
+        struct v4l2_buffer v4l2buf = _isp_params_device->get_buffer_by_index(index);
         isp_params = (struct rkisp1_isp_params_cfg*)v4l2buf.m.userptr;
         *isp_params = _full_active_isp_params;
+        // only the modules changed since the last queued buffer are applied by the kernel
+        isp_params->module_cfg_update = _params_pending_cfg;
+        isp_params->module_en_update = _params_pending_en;
         dump_isp_config(isp_params, isp_cfg);
 
         ret = rkisp1_check_params(isp_params, _isp_ver);
         if (ret != XCAM_RETURN_NO_ERROR) {
             LOGE("rkisp1_check_params error\n");
+            release_params_buffer (index);
             return XCAM_RETURN_ERROR_PARAM;
         }
 
-        /* apply isp_params */
-        xcam_mem_clear(v4l2buf);
-        v4l2buf.type = V4L2_BUF_TYPE_META_OUTPUT;
-        v4l2buf.memory = V4L2_MEMORY_MMAP;
-
-        /* params should use one buffers */
-        v4l2buf.index = 0;
-        if (_isp_params_device->io_control(VIDIOC_QBUF, &v4l2buf) != 0) {
-            printf("RKISP1: failed to ioctl VIDIOC_QBUF for %d %s.\n",
-                   errno, strerror(errno));
+        /* apply isp_params, reclaimed on a later SOF */
+        ret = queue_params_buffer (index, isp_params);
+        if (ret != XCAM_RETURN_NO_ERROR)
             return ret;
-        }
-
-        XCAM_LOG_DEBUG ("device(%s) dequeue buffer, check exit status again[exit: %d]",
-            XCAM_STR (_isp_params_device->get_device_name()), _is_exit);
-        if (_is_exit)
-            return XCAM_RETURN_BYPASS;
-
-        /* wait params done, this may block the thread */
-        if (_isp_params_device->io_control(VIDIOC_DQBUF, &v4l2buf) != 0) {
-            printf("RKISP1: failed to ioctl VIDIOC_DQBUF for %d %s.\n",
-                   errno, strerror(errno));
-            return ret;
-        }
-
+        _params_pending_cfg = 0;
+        _params_pending_en = 0;
     }
 #endif
 
@@ -858,22 +1045,141 @@ IspController::set_3a_config (X3aIspConfig *config)
     return XCAM_RETURN_NO_ERROR;
 }
 
+int
+IspController::acquire_params_buffer ()
+{
+    SmartLock locker (_params_mutex);
+
+    if (_params_reset) {
+        _params_buf_count = _isp_params_device->get_buffer_count ();
+        if (_params_buf_count > ISP_PARAMS_MAX_BUF_COUNT)
+            _params_buf_count = ISP_PARAMS_MAX_BUF_COUNT;
+        xcam_mem_clear (_params_state);
+        _params_stats.in_flight = 0;
+        _params_reset = false;
+        // the device lost its state, resend every module configured so far
+        _params_pending_cfg = _full_active_isp_params.module_cfg_update;
+        _params_pending_en = _full_active_isp_params.module_en_update;
+    }
+
+    reclaim_params_buffers_unsafe ();
+
+    for (uint32_t i = 0; i < _params_buf_count; i++) {
+        if (_params_state[i] == ParamsBufFree) {
+            _params_state[i] = ParamsBufFilling;
+            return i;
+        }
+    }
+
+    _params_stats.deferred++;
+    return -1;
+}
+
+void
+IspController::release_params_buffer (int index)
+{
+    SmartLock locker (_params_mutex);
+    XCAM_ASSERT (_params_state[index] == ParamsBufFilling);
+    _params_state[index] = ParamsBufFree;
+}
+
+XCamReturn
+IspController::queue_params_buffer (int index, const struct rkisp1_isp_params_cfg *isp_params)
+{
+    struct v4l2_buffer v4l2buf;
+    SmartLock locker (_params_mutex);
+
+    xcam_mem_clear(v4l2buf);
+    v4l2buf.type = V4L2_BUF_TYPE_META_OUTPUT;
+    v4l2buf.memory = V4L2_MEMORY_MMAP;
+    v4l2buf.index = index;
+    if (_isp_params_device->io_control(VIDIOC_QBUF, &v4l2buf) != 0) {
+        XCAM_LOG_ERROR ("device(%s) queue params buf(%d) failed, %s",
+                        XCAM_STR (_isp_params_device->get_device_name()),
+                        index, strerror (errno));
+        _params_state[index] = ParamsBufFree;
+        return XCAM_RETURN_ERROR_IOCTL;
+    }
+
+    _params_state[index] = ParamsBufQueued;
+    _params_target_sequence[index] = _frame_sequence + 1;
+    _params_stats.queued++;
+    _params_stats.last_cfg_update = isp_params->module_cfg_update;
+    _params_stats.last_en_update = isp_params->module_en_update;
+    _params_stats.modules_updated += __builtin_popcount (isp_params->module_cfg_update);
+    XCAM_LOG_DEBUG ("params buf(%d) for frame %d, cfg update 0x%x, en update 0x%x",
+                    index, _params_target_sequence[index],
+                    isp_params->module_cfg_update, isp_params->module_en_update);
+    if (++_params_stats.in_flight > _params_stats.max_in_flight)
+        _params_stats.max_in_flight = _params_stats.in_flight;
+
+    return XCAM_RETURN_NO_ERROR;
+}
+
+void
+IspController::reclaim_params_buffers_unsafe ()
+{
+    if (!_isp_params_device.ptr () || !_isp_params_device->is_activated ())
+        return;
+
+    // done buffers of an output queue are reported by POLLOUT, never block here
+    while (_params_stats.in_flight) {
+        struct pollfd poll_fd;
+        struct v4l2_buffer v4l2buf;
+
+        xcam_mem_clear (poll_fd);
+        poll_fd.fd = _isp_params_device->get_fd ();
+        poll_fd.events = POLLOUT;
+        if (poll (&poll_fd, 1, 0) <= 0 || !(poll_fd.revents & POLLOUT))
+            break;
+
+        xcam_mem_clear (v4l2buf);
+        v4l2buf.type = V4L2_BUF_TYPE_META_OUTPUT;
+        v4l2buf.memory = V4L2_MEMORY_MMAP;
+        if (_isp_params_device->io_control (VIDIOC_DQBUF, &v4l2buf) != 0) {
+            XCAM_LOG_WARNING ("device(%s) dequeue params buf failed, %s",
+                              XCAM_STR (_isp_params_device->get_device_name()),
+                              strerror (errno));
+            break;
+        }
+        if (v4l2buf.index >= _params_buf_count ||
+                _params_state[v4l2buf.index] != ParamsBufQueued) {
+            XCAM_LOG_WARNING ("dequeued unexpected params buf(%d)", v4l2buf.index);
+            continue;
+        }
+
+        XCAM_LOG_DEBUG ("params buf(%d) for frame %d done at frame %d",
+                        v4l2buf.index, _params_target_sequence[v4l2buf.index],
+                        _frame_sequence);
+        _params_state[v4l2buf.index] = ParamsBufFree;
+        _params_stats.in_flight--;
+        _params_stats.reclaimed++;
+    }
+}
+
+IspParamsStats
+IspController::get_params_stats ()
+{
+    SmartLock locker (_params_mutex);
+    return _params_stats;
+}
+
 void
 IspController::exposure_delay(struct rkisp_exposure isp_exposure)
 {
-    int i = 0;
+    IspExposureEntry entry;
+
+    entry.exposure = isp_exposure;
+    entry.target_frame = _frame_sequence;
+    entry.apply_frame = entry.target_frame + 1;
+    entry.stats_frame = entry.target_frame + _max_delay;
+    _exposure_schedule.push (entry);
+    XCAM_LOG_DEBUG("|||exp schedule (%d-%d) target:%d apply:%d stats:%d\n",
+        isp_exposure.coarse_integration_time,
+        isp_exposure.analog_gain,
+        entry.target_frame, entry.apply_frame, entry.stats_frame);
 
     SmartLock locker (_mutex);
-    for (i = 0; i < _max_delay - 1; ++i) {
-        _exposure_queue[i] = _exposure_queue[i + 1];
-    }
-    _exposure_queue[_max_delay - 1] = isp_exposure;
-    for(int i=0; i<3; i++) {
-        XCAM_LOG_DEBUG("|||exp queue(%d) (%d-%d)\n",
-            i,
-            _exposure_queue[i].coarse_integration_time,
-            _exposure_queue[i].analog_gain);
-    }
     /* if missing the sof, update immediately */
     if (_ae_stats_delay != -1) {
         _ae_stats_delay = -1;
@@ -914,6 +1220,7 @@ IspController::set_3a_exposure (struct rkisp_exposure isp_exposure)
 {
     if (_is_exit)
         return XCAM_RETURN_BYPASS;
+    TraceScope trace (XCAM_TRACE_SET_3A_EXPOSURE, _frame_sequence);
 
     LOGD("----------------------------------------------");
     if (!isp_exposure.IsHdrExp)
@@ -26,19 +26,101 @@
 #include <rk_aiq.h>
 #include <v4l2-subdev.h>
 
+/*
+ * params buffers queued ahead on the meta output device, they are reclaimed
+ * on SOF so set_3a_config never waits for the kernel
+ */
+#define ISP_PARAMS_BUF_COUNT     4
+#define ISP_PARAMS_MAX_BUF_COUNT 8
+
+/*
+ * stats buffers are leased to the analyzer and read in place, keep enough
+ * for the driver to fill while the analyzer holds some
+ */
+#define ISP_STATS_BUF_COUNT      4
+
+// exposures kept by the schedule, must cover the sensor delay plus stats in flight
+#define ISP_EXPOSURE_SCHEDULE_SIZE 8
+
 namespace XCam {
 
+struct IspExposureEntry {
+    struct rkisp_exposure exposure;
+    // frame in progress when 3a pushed the exposure
+    int                   target_frame;
+    // SOF at which it is written to the sensor
+    int                   apply_frame;
+    // first frame exposed with it, its stats are the ones the exposure produced
+    int                   stats_frame;
+};
+
+/*
+ * Frame indexed exposure schedule. Only the 3a results thread pushes, the
+ * SOF and stats paths look entries up without a lock: every slot carries a
+ * sequence which is cleared while the slot is written, a reader discards a
+ * slot whose sequence changed while it was copied. A reader never retries,
+ * so SOF apply is wait-free.
+ */
+class IspExposureSchedule {
+public:
+    IspExposureSchedule ();
+
+    void push (const IspExposureEntry &entry);
+    bool get_latest (IspExposureEntry &entry) const;
+    // the newest entry whose stats_frame <= @stats_frame, or the oldest one kept
+    bool get_for_stats (int stats_frame, IspExposureEntry &entry) const;
+
+private:
+    bool read_slot (uint32_t index, IspExposureEntry &entry) const;
+
+    XCAM_DEAD_COPY (IspExposureSchedule);
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq;
+        IspExposureEntry      entry;
+    };
+    Slot                      _slots[ISP_EXPOSURE_SCHEDULE_SIZE];
+    std::atomic<uint32_t>     _written;
+};
+
+struct IspParamsStats {
+    uint64_t queued;
+    uint64_t reclaimed;
+    // configs merged into the next buffer because all buffers were in flight
+    uint64_t deferred;
+    uint32_t in_flight;
+    uint32_t max_in_flight;
+    // modules written to the kernel, and flagged by 3a but left out as unchanged
+    uint64_t modules_updated;
+    uint64_t modules_skipped;
+    // cfg/en masks carried by the last queued buffer
+    uint32_t last_cfg_update;
+    uint32_t last_en_update;
+
+    IspParamsStats ()
+        : queued (0), reclaimed (0), deferred (0)
+        , in_flight (0), max_in_flight (0)
+        , modules_updated (0), modules_skipped (0)
+        , last_cfg_update (0), last_en_update (0)
+    {}
+};
+
 class V4l2Device;
 class V4l2SubDevice;
 class X3aIspStatistics;
+class X3aIspStatsLeases;
 class X3aIspConfig;
 
 class IspController {
 public:
     explicit IspController ();
-    ~IspController ();
+    virtual ~IspController ();
 
     void exit(bool pause);
+    // blocks until every leased stats buffer is returned, call after the poll
+    // thread stopped and before the stats device is stopped
+    void wait_stats_leases ();
     void set_isp_device(SmartPtr<V4l2Device> &dev);
     void set_video_device(SmartPtr<V4l2Device> &dev);
 
@@ -50,19 +132,30 @@ public:
     int  get_isp_ver() { return _isp_ver; }
 
     XCamReturn handle_sof(int64_t time, int frameid);
+    // whether the SOF of @frameid has been handled
+    bool sof_arrived (int frameid);
 
     int get_pixel(rk_aiq_exposure_sensor_descriptor* sensor_desc);
     int get_blank(rk_aiq_exposure_sensor_descriptor* sensor_desc);
     int get_exposure_range(rk_aiq_exposure_sensor_descriptor* sensor_desc);
     int get_format(rk_aiq_exposure_sensor_descriptor* sensor_desc);
+    // cached, the subdev is only queried again after invalidate_sensor_descriptor
     XCamReturn get_sensor_descriptor (rk_aiq_exposure_sensor_descriptor *sensor_desc);
-    XCamReturn get_sensor_mode_data (struct isp_supplemental_sensor_mode_data &sensor_mode_data);
+    // sensor mode, format or blanking changed
+    void invalidate_sensor_descriptor ();
+    // exp_time and gain are the exposure which produced the stats of @stats_frame, -1 for the current frame
+    // overridden by the replay backend, see x3a_replay.h
+    virtual XCamReturn get_sensor_mode_data (struct isp_supplemental_sensor_mode_data &sensor_mode_data,
+            int stats_frame = -1);
     XCamReturn get_isp_parameter (struct rkisp_parm &parameters);
-    XCamReturn get_frame_softime (int64_t &sof_tim);
-    XCamReturn get_vcm_time (struct rk_cam_vcm_tim *vcm_tim);
+    virtual XCamReturn get_frame_softime (int64_t &sof_tim);
+    virtual XCamReturn get_vcm_time (struct rk_cam_vcm_tim *vcm_tim);
 
     XCamReturn get_3a_statistics (SmartPtr<X3aIspStatistics> &stats);
+    // dequeue and requeue the ready stats buffer, when there is nowhere to put it
+    XCamReturn drop_3a_statistics ();
     XCamReturn set_3a_config (X3aIspConfig *config);
+    IspParamsStats get_params_stats ();
 
     void push_3a_exposure (X3aIspExposureResult *res);
     void push_3a_exposure (struct rkisp_exposure isp_exposure);
@@ -76,13 +169,22 @@ public:
     void dump_isp_config(struct rkisp1_isp_params_cfg* isp_params,
                                 struct rkisp_parameters *isp_cfg);
 #endif
+    // merges @update_params into @full_params, see tests/isp_params_delta
+    static void gen_full_isp_params(const struct rkisp1_isp_params_cfg *update_params,
+                                    struct rkisp1_isp_params_cfg *full_params,
+                                    unsigned int *cfg_changed,
+                                    unsigned int *en_changed);
 
 private:
 
     XCAM_DEAD_COPY (IspController);
     int get_sensor_fps(float& fps);
-    void gen_full_isp_params(const struct rkisp1_isp_params_cfg *update_params,
-                             struct rkisp1_isp_params_cfg *full_params);
+    XCamReturn query_sensor_descriptor (rk_aiq_exposure_sensor_descriptor *sensor_desc);
+
+    int acquire_params_buffer ();
+    void release_params_buffer (int index);
+    XCamReturn queue_params_buffer (int index, const struct rkisp1_isp_params_cfg *isp_params);
+    void reclaim_params_buffers_unsafe ();
 
 private:
     volatile bool            _is_exit;
@@ -96,10 +198,14 @@ private:
     /* rkisp1 */
     SmartPtr<V4l2SubDevice>  _sensor_subdev;
     SmartPtr<V4l2Device>     _isp_stats_device;
+    SmartPtr<X3aIspStatsLeases> _stats_leases;
     SmartPtr<V4l2Device>     _isp_params_device;
 
     SmartPtr<V4l2SubDevice>  _vcm_device;
     bool                     _is_bw_sensor;
+    Mutex                    _sensor_desc_mutex;
+    bool                     _sensor_desc_valid;
+    rk_aiq_exposure_sensor_descriptor _sensor_desc;
     /* frame sync */
 #define EXPOSURE_GAIN_DELAY 3
 #define EXPOSURE_TIME_DELAY 3
@@ -108,14 +214,29 @@ private:
     int                      _frame_sequence;
     int                      _max_delay;
     /* exposure syncronization */
-    struct rkisp_exposure *_exposure_queue;
+    IspExposureSchedule      _exposure_schedule;
     uint32_t                 _ae_stats_delay;
 
     Mutex             _mutex;
-    XCam::Cond        _frame_sequence_cond;
 
     struct rkisp1_isp_params_cfg _full_active_isp_params;
     int               _isp_ver;
+
+    /* params ring */
+    enum ParamsBufState {
+        ParamsBufFree = 0,
+        ParamsBufFilling,
+        ParamsBufQueued,
+    };
+    Mutex             _params_mutex;
+    bool              _params_reset;
+    uint32_t          _params_buf_count;
+    ParamsBufState    _params_state[ISP_PARAMS_MAX_BUF_COUNT];
+    int               _params_target_sequence[ISP_PARAMS_MAX_BUF_COUNT];
+    IspParamsStats    _params_stats;
+    // changed modules not yet queued to the kernel, resent in full after reset
+    unsigned int      _params_pending_cfg;
+    unsigned int      _params_pending_en;
 };
 
 };
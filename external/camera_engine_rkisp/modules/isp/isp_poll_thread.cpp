@@ -72,6 +72,8 @@ IspPollThread::start ()
 XCamReturn
 IspPollThread::stop ()
 {
+    XCamReturn ret = XCAM_RETURN_NO_ERROR;
+
     XCAM_LOG_DEBUG ("IspPollThread stop");
     if (_isp_controller.ptr()) {
         _isp_controller->exit(true);
@@ -81,7 +83,13 @@ IspPollThread::stop ()
     if (_3a_stats_pool.ptr ())
         _3a_stats_pool->stop ();
 #endif
-    return PollThread::stop ();
+    ret = PollThread::stop ();
+
+    // the reactor is joined, the stats device may be stopped once this returns
+    if (_isp_controller.ptr())
+        _isp_controller->wait_stats_leases ();
+
+    return ret;
 }
 
 XCamReturn
@@ -93,6 +101,16 @@ IspPollThread::notify_sof (int64_t time, int frameid)
     return XCAM_RETURN_NO_ERROR;
 }
 
+bool
+IspPollThread::stats_sof_arrived (const SmartPtr<X3aStats> &stats)
+{
+#if RKISP
+    return _isp_controller->sof_arrived ((int)stats->get_sequence ());
+#else
+    return PollThread::stats_sof_arrived (stats);
+#endif
+}
+
 XCamReturn
 IspPollThread::init_3a_stats_pool ()
 {
@@ -125,12 +143,15 @@ XCamReturn
 IspPollThread::capture_3a_stats (SmartPtr<X3aStats> &stats)
 {
     XCamReturn ret = XCAM_RETURN_NO_ERROR;
+    // runs on the reactor, never wait for the analyzer to release a buffer
     SmartPtr<X3aIspStatistics> new_stats =
-        _3a_stats_pool->get_buffer (_3a_stats_pool).dynamic_cast_ptr<X3aIspStatistics> ();
+        _3a_stats_pool->try_get_buffer (_3a_stats_pool).dynamic_cast_ptr<X3aIspStatistics> ();
 
     if (!new_stats.ptr()) {
-        XCAM_LOG_WARNING ("request stats buffer failed.");
-        return XCAM_RETURN_ERROR_MEM;
+        XCAM_LOG_WARNING ("no free stats buffer, analyzer is behind");
+        // still drain the stats fd, it stays readable otherwise
+        _isp_controller->drop_3a_statistics ();
+        return XCAM_RETURN_ERROR_TIMEOUT;
     }
 
     ret = _isp_controller->get_3a_statistics (new_stats);
@@ -139,10 +160,6 @@ IspPollThread::capture_3a_stats (SmartPtr<X3aStats> &stats)
         return ret;
     }
 
-    if (!new_stats->fill_standard_stats ()) {
-        XCAM_LOG_WARNING ("isp 3a stats failed to fill standard stats but continued");
-    }
-
     stats = new_stats;
     return ret;
 }
@@ -159,6 +176,10 @@ IspPollThread::handle_events (struct v4l2_event &event)
     case V4L2_EVENT_FRAME_SYNC:
         ret = handle_frame_sync_event (event);
         break;
+    case V4L2_EVENT_SOURCE_CHANGE:
+        XCAM_LOG_INFO ("source changed, invalidate sensor descriptor");
+        _isp_controller->invalidate_sensor_descriptor ();
+        break;
     default:
         ret = XCAM_RETURN_ERROR_UNKNOWN;
         break;
@@ -47,6 +47,7 @@ private:
     virtual XCamReturn init_3a_stats_pool ();
     virtual XCamReturn capture_3a_stats (SmartPtr<X3aStats> &stats);
     virtual XCamReturn notify_sof (int64_t time, int frameid);
+    virtual bool stats_sof_arrived (const SmartPtr<X3aStats> &stats);
 
 private:
     XCAM_DEAD_COPY (IspPollThread);
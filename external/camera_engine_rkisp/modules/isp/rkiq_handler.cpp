@@ -22,6 +22,7 @@
 #include "rkiq_handler.h"
 #include "rk_params_translate.h"
 #include "x3a_isp_config.h"
+#include "x3a_result_arena.h"
 
 #include <string.h>
 #include <math.h>
@@ -84,6 +85,21 @@ _coarse_line_to_time (const ia_aiq_exposure_sensor_descriptor *desc, uint32_t co
     return coarse_line * desc->pixel_periods_per_line / desc->pixel_clock_freq_mhz;
 }
 
+// the single metadata result of the frame in @output, created by the first writer
+static XmetaResult *
+get_meta_result (X3aResultList &output)
+{
+    for (X3aResultList::iterator iter = output.begin (); iter != output.end (); ++iter) {
+        if ((*iter)->get_type () == XCAM_3A_METADATA_RESULT_TYPE)
+            return (*iter).dynamic_cast_ptr<XmetaResult> ().ptr ();
+    }
+
+    SmartPtr<XmetaResult> res = X3aResultArena::instance ()->create<XmetaResult> (
+        XCAM_3A_METADATA_RESULT_TYPE, XCAM_IMAGE_PROCESS_ONCE, XCAM_IMAGE_PROCESS_ONCE);
+    output.push_back (res);
+    return res.ptr ();
+}
+
 AiqAeHandler::AiqAeResult::AiqAeResult()
 {
     xcam_mem_clear (ae_result);
@@ -121,6 +137,7 @@ AiqAeHandler::AiqAeHandler (X3aAnalyzerRKiq *analyzer, SmartPtr<RKiqCompositor>
     xcam_mem_clear (_sensor_descriptor);
     xcam_mem_clear (_manual_limits);
     xcam_mem_clear (_input);
+    xcam_mem_clear (_result);
     mAeState = new RkAEStateMachine();
 }
 
@@ -182,7 +199,8 @@ bool AiqAeHandler::ensure_ae_ev_shift ()
 SmartPtr<X3aResult>
 AiqAeHandler::pop_result ()
 {
-    X3aIspExposureResult *result = new X3aIspExposureResult(XCAM_IMAGE_PROCESS_ONCE);
+    X3aIspExposureResult *result = X3aResultArena::instance ()->create<X3aIspExposureResult> (
+        X3aIspConfig::IspExposureParameters, XCAM_IMAGE_PROCESS_ONCE, XCAM_IMAGE_PROCESS_ONCE);
     struct rkisp_exposure sensor;
     XCam3aResultExposure exposure;
 
@@ -223,22 +241,7 @@ AiqAeHandler::processAeMetaResults(AecResult_t aec_results, X3aResultList &outpu
     XCamReturn ret = XCAM_RETURN_NO_ERROR;
     camera_metadata_entry entry;
     SmartPtr<AiqInputParams> inputParams = _aiq_compositor->getAiqInputParams();
-    SmartPtr<XmetaResult> res;
-    for (X3aResultList::iterator iter = output.begin ();
-            iter != output.end ();)
-    {
-        if ((*iter)->get_type() == XCAM_3A_METADATA_RESULT_TYPE) {
-            res = (*iter).dynamic_cast_ptr<XmetaResult> ();
-            break ;
-        }
-        ++iter;
-        if (iter == output.end()) {
-            res = new XmetaResult(XCAM_IMAGE_PROCESS_ONCE);
-            output.push_back(res);
-        }
-    }
-
-    CameraMetadata* metadata = res->get_metadata_result();
+    XmetaResult* metadata = get_meta_result (output);
 
     XCamAeParam &aeParams = inputParams->aeInputParams.aeParams;
     uint8_t sceneFlickerMode = ANDROID_STATISTICS_SCENE_FLICKER_NONE;
@@ -360,25 +363,10 @@ AiqAwbHandler::processAwbMetaResults(CamIA10_AWB_Result_t awb_results, X3aResult
 {
     XCamReturn ret = XCAM_RETURN_NO_ERROR;
     SmartPtr<AiqInputParams> inputParams = _aiq_compositor->getAiqInputParams();
-    SmartPtr<XmetaResult> res;
     camera_metadata_entry entry;
     LOGI("@%s %d: enter", __FUNCTION__, __LINE__);
 
-    for (X3aResultList::iterator iter = output.begin ();
-            iter != output.end ();)
-    {
-        if ((*iter)->get_type() == XCAM_3A_METADATA_RESULT_TYPE) {
-            res = (*iter).dynamic_cast_ptr<XmetaResult> ();
-            break ;
-        }
-        ++iter;
-        if (iter == output.end()) {
-            res = new XmetaResult(XCAM_IMAGE_PROCESS_ONCE);
-            output.push_back(res);
-        }
-    }
-
-    CameraMetadata* metadata = res->get_metadata_result();
+    XmetaResult* metadata = get_meta_result (output);
     struct CamIA10_SensorModeData &sensor_desc = _aiq_compositor->get_sensor_mode_data();
     ParamsTranslate::convert_from_rkisp_awb_result(&_rkaiq_result, &awb_results, &sensor_desc);
 
@@ -433,25 +421,10 @@ AiqAfHandler::processAfMetaResults(XCam3aResultFocus af_results, X3aResultList &
 {
     XCamReturn ret = XCAM_RETURN_NO_ERROR;
     SmartPtr<AiqInputParams> inputParams = _aiq_compositor->getAiqInputParams();
-    SmartPtr<XmetaResult> res;
     camera_metadata_entry entry;
     LOGI("@%s %d: enter", __FUNCTION__, __LINE__);
 
-    for (X3aResultList::iterator iter = output.begin ();
-            iter != output.end ();)
-    {
-        if ((*iter)->get_type() == XCAM_3A_METADATA_RESULT_TYPE) {
-            res = (*iter).dynamic_cast_ptr<XmetaResult> ();
-            break ;
-        }
-        ++iter;
-        if (iter == output.end()) {
-            res = new XmetaResult(XCAM_IMAGE_PROCESS_ONCE);
-            output.push_back(res);
-        }
-    }
-
-    CameraMetadata* metadata = res->get_metadata_result();
+    XmetaResult* metadata = get_meta_result (output);
     struct CamIA10_SensorModeData &sensor_desc = _aiq_compositor->get_sensor_mode_data();
     ParamsTranslate::convert_from_rkisp_af_result(&_rkaiq_result, &af_results, &sensor_desc);
 
@@ -487,7 +460,7 @@ XCamReturn AiqCommonHandler::initTonemaps()
 }
 
 XCamReturn
-AiqCommonHandler::fillTonemapCurve(CamerIcIspGocConfig_t goc, AiqInputParams* inputParams, CameraMetadata* metadata)
+AiqCommonHandler::fillTonemapCurve(CamerIcIspGocConfig_t goc, AiqInputParams* inputParams, XmetaResult* metadata)
 {
     int multiplier = 1;
     CameraMetadata* staticMeta  = inputParams->staticMeta;
@@ -563,25 +536,10 @@ AiqCommonHandler::processToneMapsMetaResults(CamerIcIspGocConfig_t goc, X3aResul
 {
     XCamReturn ret = XCAM_RETURN_NO_ERROR;
     SmartPtr<AiqInputParams> inputParams = _aiq_compositor->getAiqInputParams();
-    SmartPtr<XmetaResult> res;
     camera_metadata_entry entry;
     LOGI("@%s %d: enter", __FUNCTION__, __LINE__);
 
-    for (X3aResultList::iterator iter = output.begin ();
-            iter != output.end ();)
-    {
-        if ((*iter)->get_type() == XCAM_3A_METADATA_RESULT_TYPE) {
-            res = (*iter).dynamic_cast_ptr<XmetaResult> ();
-            break ;
-        }
-        ++iter;
-        if (iter == output.end()) {
-            res = new XmetaResult(XCAM_IMAGE_PROCESS_ONCE);
-            output.push_back(res);
-        }
-    }
-
-    CameraMetadata* metadata = res->get_metadata_result();
+    XmetaResult* metadata = get_meta_result (output);
     ret = fillTonemapCurve(goc, inputParams.ptr(), metadata);
 
     return ret;
@@ -1070,6 +1028,7 @@ AiqAwbHandler::get_current_estimate_cct ()
 AiqAfHandler::AiqAfHandler (SmartPtr<RKiqCompositor> &aiq_compositor)
     : _aiq_compositor (aiq_compositor)
 {
+    xcam_mem_clear (_af_result);
     mAfState = new RkAFStateMachine();
 }
 
@@ -1090,12 +1049,14 @@ AiqAfHandler::analyze (X3aResultList &output, bool first)
 
     _aiq_compositor->_isp10_engine->runAf(&param, &isp_result, first);
 
-    if (inputParams.ptr())
-        processAfMetaResults(isp_result, output);
+    // the metadata is written by the compositor at integrate, AF may run
+    // in parallel and its @output has no metadata result then
+    _af_result = isp_result;
     XCAM_LOG_INFO ("AiqAfHandler, position: %d",
         isp_result.next_lens_position);
 
-    X3aIspFocusResult *result = new X3aIspFocusResult(XCAM_IMAGE_PROCESS_ONCE);
+    X3aIspFocusResult *result = X3aResultArena::instance ()->create<X3aIspFocusResult> (
+        X3aIspConfig::IspFocusParameters, XCAM_IMAGE_PROCESS_ONCE, XCAM_IMAGE_PROCESS_ONCE);
     struct rkisp_focus focus;
     focus.next_lens_position = isp_result.next_lens_position;
     result->set_isp_config (focus);
@@ -1156,7 +1117,6 @@ RKiqCompositor::RKiqCompositor ()
     , _isp10_engine(NULL)
 {
     xcam_mem_clear (_frame_params);
-    xcam_mem_clear (_isp_stats);
     xcam_mem_clear (_ia_stat);
     xcam_mem_clear (_ia_dcfg);
     xcam_mem_clear (_ia_results);
@@ -1295,9 +1255,9 @@ RKiqCompositor::set_3a_stats (SmartPtr<X3aIspStatistics> &stats)
         return false;
     }
 
-    _isp_stats = *(struct cifisp_stat_buffer*)stats->get_isp_stats();
+    const struct cifisp_stat_buffer *isp_stats = stats->get_isp_stats_view ();
     frame_ts = _ia_stat.sof_tim / 1000;
-    XCAM_LOG_DEBUG ("set_3a_stats meas type: %d", _isp_stats.meas_type);
+    XCAM_LOG_DEBUG ("set_3a_stats meas type: %d", isp_stats->meas_type);
 
     vcm_ts = (int64_t)_ia_stat.vcm_tim.vcm_end_t.tv_sec * 1000 * 1000 +
              (int64_t)_ia_stat.vcm_tim.vcm_end_t.tv_usec;
@@ -1313,8 +1273,7 @@ RKiqCompositor::set_3a_stats (SmartPtr<X3aIspStatistics> &stats)
         _ia_stat.af.cameric.MoveStatus, vcm_ts / 1000, cur_exptime / 1000, frame_ts / 1000);
 
     /* TODO: remove this when isp driver fix the awb meas type unreported bug */
-    _isp_stats.meas_type |= CIFISP_STAT_AWB;
-    _isp10_engine->convertIspStats(&_isp_stats, &_ia_stat);
+    _isp10_engine->convertIspStats(isp_stats, isp_stats->meas_type | CIFISP_STAT_AWB, &_ia_stat);
     _isp10_engine->setStatistics(&_ia_stat);
     return true;
 }
@@ -1376,6 +1335,13 @@ XCamReturn RKiqCompositor::integrate (X3aResultList &results)
         _awb_handler->processAwbMetaResults(_ia_results.awb, results);
         _common_handler->processToneMapsMetaResults(_ia_results.goc, results);
     }
+    if (_af_handler && _inputParams.ptr())
+        _af_handler->processAfMetaResults(_af_handler->get_af_result (), results);
+
+    for (X3aResultList::iterator iter = results.begin (); iter != results.end (); ++iter) {
+        if ((*iter)->get_type () == XCAM_3A_METADATA_RESULT_TYPE)
+            (*iter).dynamic_cast_ptr<XmetaResult> ()->finish ();
+    }
 
     _isp10_engine->convertIAResults(&_isp_cfg, &_ia_results);
 
@@ -1419,7 +1385,8 @@ RKiqCompositor::generate_3a_configs (struct rkisp_parameters *parameters)
     SmartPtr<X3aResult> ret;
 
     X3aAtomIspParametersResult *x3a_result =
-        new X3aAtomIspParametersResult (XCAM_IMAGE_PROCESS_ONCE);
+        X3aResultArena::instance ()->create<X3aAtomIspParametersResult> (
+            X3aIspConfig::IspAllParameters, XCAM_IMAGE_PROCESS_ONCE, XCAM_IMAGE_PROCESS_ONCE);
     x3a_result->set_isp_config (*parameters);
     ret = x3a_result;
 
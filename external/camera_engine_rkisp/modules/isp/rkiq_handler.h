@@ -236,11 +236,16 @@ public:
 
     XCamReturn processAfMetaResults(XCam3aResultFocus af_results, X3aResultList &output);
     virtual XCamReturn analyze (X3aResultList &output, bool first = false);
+    // result of the last analyze
+    const XCam3aResultFocus &get_af_result () const {
+        return _af_result;
+    }
 
 private:
     XCAM_DEAD_COPY (AiqAfHandler);
 
 protected:
+    XCam3aResultFocus                 _af_result;
     rk_aiq_af_results                 _rkaiq_result;
     SmartPtr<RkAFStateMachine>      mAfState;
     SmartPtr<RKiqCompositor>        _aiq_compositor;
@@ -265,7 +270,7 @@ public:
 
 private:
     XCamReturn initTonemaps();
-    XCamReturn fillTonemapCurve(CamerIcIspGocConfig_t goc, AiqInputParams* inputParams, CameraMetadata* metadata);
+    XCamReturn fillTonemapCurve(CamerIcIspGocConfig_t goc, AiqInputParams* inputParams, XmetaResult* metadata);
     XCAM_DEAD_COPY (AiqCommonHandler);
     // for tonemaps result
     uint32_t mMaxCurvePoints; /*!< Cache for max curve points for tonemap */
@@ -370,7 +375,6 @@ private:
     ia_aiq_frame_use           _frame_use;
     ia_aiq_frame_params        _frame_params;
 
-    struct cifisp_stat_buffer _isp_stats;
     struct CamIA10_Stats _ia_stat = {0};
     struct CamIA10_DyCfg _ia_dcfg;
     struct CamIA10_Results _ia_results = {0};
@@ -38,6 +38,8 @@ X3aAnalyzerRKiq::X3aAnalyzerRKiq (RkispDeviceManager* device_manager, SmartPtr<I
     , _isp_ctrl_dev (NULL)
     , _sensor_data_ready (false)
     , _cpf_path (NULL)
+    , _sensor_entity_name (NULL)
+    , _record_path (NULL)
 {
     if (cpf_path)
         _cpf_path = strndup (cpf_path, XCAM_MAX_STR_SIZE);
@@ -51,9 +53,12 @@ X3aAnalyzerRKiq::X3aAnalyzerRKiq (RkispDeviceManager* device_manager, SmartPtr<I
 
 X3aAnalyzerRKiq::X3aAnalyzerRKiq (struct isp_supplemental_sensor_mode_data &sensor_data, const char *cpf_path)
     : X3aAnalyzer ("X3aAnalyzerRKiq")
+    , _device_manager (NULL)
     , _sensor_mode_data (sensor_data)
     , _sensor_data_ready (true)
     , _cpf_path (NULL)
+    , _sensor_entity_name (NULL)
+    , _record_path (NULL)
 {
     if (cpf_path)
         _cpf_path = strndup (cpf_path, XCAM_MAX_STR_SIZE);
@@ -68,6 +73,10 @@ X3aAnalyzerRKiq::~X3aAnalyzerRKiq()
 {
     if (_cpf_path)
         xcam_free (_cpf_path);
+    if (_sensor_entity_name)
+        xcam_free (_sensor_entity_name);
+    if (_record_path)
+        xcam_free (_record_path);
 
     if (_isp_ctrl_dev) {
         delete _isp_ctrl_dev;
@@ -76,6 +85,22 @@ X3aAnalyzerRKiq::~X3aAnalyzerRKiq()
     XCAM_LOG_DEBUG ("~X3aAnalyzerRKiq destructed");
 }
 
+void
+X3aAnalyzerRKiq::set_sensor_entity_name (const char *name)
+{
+    if (_sensor_entity_name)
+        xcam_free (_sensor_entity_name);
+    _sensor_entity_name = name ? strndup (name, XCAM_MAX_STR_SIZE) : NULL;
+}
+
+void
+X3aAnalyzerRKiq::set_record_path (const char *path)
+{
+    if (_record_path)
+        xcam_free (_record_path);
+    _record_path = path ? strndup (path, XCAM_MAX_STR_SIZE) : NULL;
+}
+
 SmartPtr<AeHandler>
 X3aAnalyzerRKiq::create_ae_handler ()
 {
@@ -143,10 +168,30 @@ X3aAnalyzerRKiq::internal_init (uint32_t width, uint32_t height, double framerat
         _isp_ctrl_dev->setISPDeviceFd(_isp_stats_device->get_fd());
     }
 
-    _isp_ctrl_dev->init(_cpf_path, _device_manager->get_sensor_entity_name(),
-                        _device_manager->get_isp_ver(),
+    const char *sensor_entity_name =
+        _device_manager ? _device_manager->get_sensor_entity_name () : _sensor_entity_name;
+    int isp_ver = _device_manager ? _device_manager->get_isp_ver () : _isp->get_isp_ver ();
+    _isp_ctrl_dev->init(_cpf_path, sensor_entity_name,
+                        isp_ver,
                         /*_device->get_fd()*/0);
 
+    if (_record_path) {
+        X3aRecordHeader header;
+        xcam_mem_clear (header);
+        header.magic = X3A_RECORD_MAGIC;
+        header.version = X3A_RECORD_VERSION;
+        header.frame_size = sizeof (X3aRecordFrame);
+        header.stats_size = sizeof (struct cifisp_stat_buffer);
+        header.width = width;
+        header.height = height;
+        header.framerate = framerate;
+        header.isp_ver = isp_ver;
+        if (sensor_entity_name)
+            strncpy (header.sensor_entity_name, sensor_entity_name, X3A_RECORD_NAME_SIZE - 1);
+        if (_recorder.open (_record_path, header) != XCAM_RETURN_NO_ERROR)
+            XCAM_LOG_WARNING ("3a recording disabled");
+    }
+
     _rkiq_compositor->set_size (width, height);
     _rkiq_compositor->set_framerate (framerate);
     _rkiq_compositor->init_dynamic_config();
@@ -169,6 +214,7 @@ X3aAnalyzerRKiq::internal_deinit ()
         delete _isp_ctrl_dev;
         _isp_ctrl_dev = NULL;
     }
+    _recorder.close ();
     return XCAM_RETURN_NO_ERROR;
 }
 
@@ -277,19 +323,33 @@ X3aAnalyzerRKiq::pre_3a_analyze (SmartPtr<X3aStats> &stats)
     xcam_mem_clear (sensor_mode_data);
     XCAM_ASSERT (_isp.ptr());
 
-    ret = _isp->get_sensor_mode_data (sensor_mode_data);
+    // the exposure which produced these stats, not the latest one written
+    ret = _isp->get_sensor_mode_data (sensor_mode_data, (int)stats->get_sequence ());
     XCAM_FAIL_RETURN (WARNING, ret == XCAM_RETURN_NO_ERROR, ret, "get sensor mode data failed");
     _sensor_mode_data = sensor_mode_data;
 
     //ensure that the inputParams is the same one in the awb and ae anzlyer
     //function
-    _rkiq_compositor->setAiqInputParams(this->getAiqInputParams());
+    struct cifisp_stat_buffer *isp_stats =
+        (struct cifisp_stat_buffer*)xcam_isp_stats->get_isp_stats ();
+    SmartPtr<AiqInputParams> input_params = this->getAiqInputParams(isp_stats->frame_id);
+    _rkiq_compositor->setAiqInputParams(input_params);
 
     ret = _isp->get_frame_softime (sof_tim);
     XCAM_FAIL_RETURN (WARNING, ret == XCAM_RETURN_NO_ERROR, ret, "get sof time failed");
     ret = _isp->get_vcm_time (&vcm_tim);
     XCAM_FAIL_RETURN (WARNING, ret == XCAM_RETURN_NO_ERROR, ret, "get vcm time failed");
 
+    if (_recorder.is_opened ()) {
+        X3aRecordFrame frame;
+        xcam_mem_clear (frame);
+        frame.stats_frame = stats->get_sequence ();
+        frame.sof_time = sof_tim;
+        frame.sensor_mode_data = _sensor_mode_data;
+        frame.vcm_tim = vcm_tim;
+        _recorder.write_frame (frame, input_params.ptr (), isp_stats);
+    }
+
     if (!_rkiq_compositor->set_sensor_mode_data (&_sensor_mode_data)) {
         XCAM_LOG_WARNING ("AIQ configure 3a failed");
         return XCAM_RETURN_ERROR_AIQ;
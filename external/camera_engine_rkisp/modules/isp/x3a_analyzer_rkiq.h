@@ -27,6 +27,7 @@
 #include <dynamic_algorithms_libs_loader.h>
 #include "isp10_engine.h"
 #include "interface/rkisp_dev_manager.h"
+#include "x3a_replay.h"
 
 namespace XCam {
 
@@ -41,7 +42,16 @@ public:
     explicit X3aAnalyzerRKiq (SmartPtr<IspController> &isp, const char *cpf_path);
     explicit X3aAnalyzerRKiq (struct isp_supplemental_sensor_mode_data &sensor_data, const char *cpf_path);
     RkispDeviceManager* getDeviceManager() { return _device_manager; };
-    SmartPtr<AiqInputParams> getAiqInputParams () { XCAM_ASSERT (_device_manager); return _device_manager->getAiqInputParams(); }
+    SmartPtr<AiqInputParams> getAiqInputParams (int frame_sequence = -1) {
+        if (!_device_manager)
+            return _aiq_input_params;
+        return _device_manager->getAiqInputParams(frame_sequence);
+    }
+    // stand-ins for the device manager when there is none, e.g. in replay
+    void setAiqInputParams (const SmartPtr<AiqInputParams> &params) { _aiq_input_params = params; }
+    void set_sensor_entity_name (const char *name);
+    // record every analyzed frame to @path from the next init on, see x3a_replay.h
+    void set_record_path (const char *path);
     struct isp_supplemental_sensor_mode_data* getSensorModeData () { return &_sensor_mode_data; }
     ~X3aAnalyzerRKiq ();
 
@@ -71,6 +81,10 @@ private:
     struct isp_supplemental_sensor_mode_data   _sensor_mode_data;
     bool                              _sensor_data_ready;
     char                             *_cpf_path;
+    SmartPtr<AiqInputParams>          _aiq_input_params;
+    char                             *_sensor_entity_name;
+    char                             *_record_path;
+    X3aRecorder                       _recorder;
 };
 
 };
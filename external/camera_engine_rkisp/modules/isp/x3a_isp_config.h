@@ -122,6 +122,12 @@ public:
         return _isp_config;
     }
 
+protected:
+    virtual void reset (XCamImageProcessType process_type) {
+        X3aStandardResultT<StandardResult>::reset (process_type);
+        xcam_mem_clear (_isp_config);
+    }
+
 private:
     IspConfig _isp_config;
 };
@@ -155,6 +161,12 @@ public:
             _content.copy (config);
         }
 
+protected:
+        virtual void reset (XCamImageProcessType process_type) {
+            X3aStandardResultT<X3aIspConfig::X3aIspResultDummy>::reset (process_type);
+            _content.clear ();
+        }
+
 private:
         AtomIspConfigContent      _content;
     };
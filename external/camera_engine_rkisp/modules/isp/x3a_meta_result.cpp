@@ -0,0 +1,253 @@
+/*
+ * x3a_meta_result.cpp - 3A metadata result
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "x3a_meta_result.h"
+#include <stdlib.h>
+
+// (in, out) pairs of CAMERIC_ISP_GAMMA_CURVE_SIZE points
+#define XMETA_TONEMAP_CURVE_COUNT 68
+
+namespace XCam {
+
+static const struct {
+    uint32_t tag;
+    uint32_t max_count;
+} xmeta_template_tags[] = {
+    // AiqAeHandler and RkAEModeBase
+    {ANDROID_STATISTICS_SCENE_FLICKER, 1},
+    {ANDROID_CONTROL_AE_MODE, 1},
+    {ANDROID_CONTROL_AE_LOCK, 1},
+    {ANDROID_CONTROL_AE_PRECAPTURE_TRIGGER, 1},
+    {ANDROID_CONTROL_AE_ANTIBANDING_MODE, 1},
+    {ANDROID_CONTROL_AE_TARGET_FPS_RANGE, 2},
+    {ANDROID_CONTROL_AE_STATE, 1},
+    {ANDROID_CONTROL_AE_REGIONS, 5},
+    {ANDROID_CONTROL_AE_EXPOSURE_COMPENSATION, 1},
+    {ANDROID_SENSOR_FRAME_DURATION, 1},
+    {ANDROID_SENSOR_EXPOSURE_TIME, 1},
+    {ANDROID_SENSOR_SENSITIVITY, 1},
+    {ANDROID_SENSOR_TEST_PATTERN_MODE, 1},
+    {ANDROID_SENSOR_INFO_EXPOSURE_TIME_RANGE, 2},
+    {ANDROID_SENSOR_INFO_SENSITIVITY_RANGE, 2},
+    // AiqAwbHandler and RkAWBModeBase
+    {ANDROID_CONTROL_AWB_MODE, 1},
+    {ANDROID_CONTROL_AWB_LOCK, 1},
+    {ANDROID_CONTROL_AWB_STATE, 1},
+    {ANDROID_CONTROL_AWB_REGIONS, 5},
+    {ANDROID_COLOR_CORRECTION_MODE, 1},
+    {ANDROID_COLOR_CORRECTION_ABERRATION_MODE, 1},
+    {ANDROID_COLOR_CORRECTION_GAINS, 4},
+    {ANDROID_COLOR_CORRECTION_TRANSFORM, 9},
+    // AiqAfHandler and RkAfModeBase
+    {ANDROID_CONTROL_AF_MODE, 1},
+    {ANDROID_CONTROL_AF_TRIGGER, 1},
+    {ANDROID_CONTROL_AF_STATE, 1},
+    {ANDROID_CONTROL_AF_REGIONS, 5},
+    {ANDROID_LENS_FOCUS_DISTANCE, 1},
+    {ANDROID_LENS_STATE, 1},
+    // AiqCommonHandler
+    {ANDROID_TONEMAP_MODE, 1},
+    {ANDROID_TONEMAP_CURVE_RED, XMETA_TONEMAP_CURVE_COUNT},
+    {ANDROID_TONEMAP_CURVE_GREEN, XMETA_TONEMAP_CURVE_COUNT},
+    {ANDROID_TONEMAP_CURVE_BLUE, XMETA_TONEMAP_CURVE_COUNT},
+};
+
+XmetaTemplate *
+XmetaTemplate::instance ()
+{
+    // never freed, results are recycled by the arena at any time
+    static XmetaTemplate *meta_template = new XmetaTemplate;
+    return meta_template;
+}
+
+XmetaTemplate::XmetaTemplate ()
+    : _buffer (NULL)
+    , _size (0)
+    , _tag_count (0)
+{
+    const uint32_t tag_count = sizeof (xmeta_template_tags) / sizeof (xmeta_template_tags[0]);
+    XCAM_ASSERT (tag_count <= XMETA_TEMPLATE_MAX_TAGS);
+    size_t data_size = XMETA_TEMPLATE_SPARE_DATA;
+    size_t max_payload = 0;
+    uint8_t *empty = NULL;
+
+    for (uint32_t i = 0; i < tag_count; ++i) {
+        int type = get_camera_metadata_tag_type (xmeta_template_tags[i].tag);
+        XCAM_ASSERT (type >= 0);
+        data_size += calculate_camera_metadata_entry_data_size (type, xmeta_template_tags[i].max_count);
+        max_payload = XCAM_MAX (max_payload, xmeta_template_tags[i].max_count * camera_metadata_type_size[type]);
+    }
+
+    _buffer = allocate_camera_metadata (tag_count + XMETA_TEMPLATE_SPARE_ENTRIES, data_size);
+    empty = (uint8_t *)calloc (1, max_payload);
+    if (!_buffer || !empty) {
+        XCAM_LOG_ERROR ("allocate result metadata template failed");
+        if (_buffer)
+            free_camera_metadata (_buffer);
+        _buffer = NULL;
+        free (empty);
+        return;
+    }
+
+    // every entry already holds its largest count, a write of that count is a plain copy
+    for (uint32_t i = 0; i < tag_count; ++i) {
+        if (add_camera_metadata_entry (_buffer, xmeta_template_tags[i].tag, empty,
+                                       xmeta_template_tags[i].max_count) != 0) {
+            XCAM_LOG_ERROR ("add tag(0x%x) to result metadata template failed", xmeta_template_tags[i].tag);
+            free_camera_metadata (_buffer);
+            _buffer = NULL;
+            free (empty);
+            return;
+        }
+    }
+    free (empty);
+    sort_camera_metadata (_buffer);
+
+    for (uint32_t i = 0; i < tag_count; ++i) {
+        camera_metadata_entry_t entry;
+        get_camera_metadata_entry (_buffer, i, &entry);
+        _tags[i] = entry.tag;
+    }
+    _tag_count = tag_count;
+    _size = get_camera_metadata_size (_buffer);
+}
+
+int32_t
+XmetaTemplate::find_index (uint32_t tag) const
+{
+    int32_t low = 0;
+    int32_t high = (int32_t)_tag_count - 1;
+
+    while (low <= high) {
+        int32_t mid = (low + high) / 2;
+        if (_tags[mid] == tag)
+            return mid;
+        if (_tags[mid] < tag)
+            low = mid + 1;
+        else
+            high = mid - 1;
+    }
+    return -1;
+}
+
+camera_metadata_t *
+XmetaTemplate::place (void *buffer) const
+{
+    XCAM_ASSERT (_buffer && buffer);
+    // a camera_metadata_t only holds offsets, a plain copy is a valid buffer
+    memcpy (buffer, _buffer, _size);
+    return (camera_metadata_t *)buffer;
+}
+
+void
+XmetaResult::place_template ()
+{
+    XmetaTemplate *meta_template = XmetaTemplate::instance ();
+    size_t size = meta_template->get_size ();
+    camera_metadata_t *buffer = _metadata->release ();
+    camera_metadata_t *placed = NULL;
+
+    _written = 0;
+
+    if (!size) {
+        // no template, emptied in place as before
+        if (buffer)
+            placed = place_camera_metadata (
+                         buffer, get_camera_metadata_size (buffer),
+                         get_camera_metadata_entry_capacity (buffer),
+                         get_camera_metadata_data_capacity (buffer));
+        if (!placed) {
+            if (buffer)
+                free_camera_metadata (buffer);
+            placed = allocate_camera_metadata (DEFAULT_ENTRY_CAP, DEFAULT_DATA_CAP);
+        }
+        _metadata->acquire (placed);
+        return;
+    }
+
+    // grown by a CameraMetadata update beyond the template last frame
+    if (buffer && get_camera_metadata_size (buffer) != size) {
+        free_camera_metadata (buffer);
+        buffer = NULL;
+    }
+    if (!buffer)
+        buffer = (camera_metadata_t *)malloc (size);
+    XCAM_ASSERT (buffer);
+
+    _metadata->acquire (meta_template->place (buffer));
+}
+
+bool
+XmetaResult::write_entry (uint32_t tag, uint8_t type, const void *data, size_t count)
+{
+    int32_t index = XmetaTemplate::instance ()->find_index (tag);
+    if (index < 0)
+        return false;
+
+    // the buffer is only ours to write while CameraMetadata is not resizing it
+    camera_metadata_t *buffer = (camera_metadata_t *)_metadata->getAndLock ();
+    camera_metadata_entry_t entry;
+    bool written = false;
+
+    if (get_camera_metadata_entry (buffer, index, &entry) == 0 &&
+            entry.tag == tag && entry.type == type) {
+        if (entry.count == count) {
+            // the layout stays, skip the update and its validation of the whole buffer
+            memcpy (entry.data.u8, data, count * camera_metadata_type_size[type]);
+            written = true;
+        } else {
+            written = update_camera_metadata_entry (buffer, index, data, count, NULL) == 0;
+        }
+    }
+    _metadata->unlock (buffer);
+
+    if (written)
+        _written |= (uint64_t)1 << index;
+    return written;
+}
+
+XCamReturn
+XmetaResult::mark_written (uint32_t tag, status_t status)
+{
+    if (status != 0)
+        return XCAM_RETURN_ERROR_PARAM;
+
+    int32_t index = XmetaTemplate::instance ()->find_index (tag);
+    if (index >= 0)
+        _written |= (uint64_t)1 << index;
+    return XCAM_RETURN_NO_ERROR;
+}
+
+void
+XmetaResult::finish ()
+{
+    if (!XmetaTemplate::instance ()->get_size ())
+        return;
+
+    camera_metadata_t *buffer = (camera_metadata_t *)_metadata->getAndLock ();
+    // template entries come first, tags added through CameraMetadata follow them.
+    // backwards, a delete only moves the entries after it
+    for (int32_t i = XmetaTemplate::instance ()->get_tag_count (); i > 0; --i) {
+        if (!(_written & ((uint64_t)1 << (i - 1))))
+            delete_camera_metadata_entry (buffer, i - 1);
+    }
+    _metadata->unlock (buffer);
+}
+
+};
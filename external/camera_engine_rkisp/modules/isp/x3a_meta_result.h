@@ -43,26 +43,68 @@ namespace XCam {
 #define DEFAULT_ENTRY_CAP 64 
 #define DEFAULT_DATA_CAP 1024
 
+// spare room of the result template for tags written outside of it
+#define XMETA_TEMPLATE_SPARE_ENTRIES 16
+#define XMETA_TEMPLATE_SPARE_DATA 256
+// one bit each in XmetaResult::_written
+#define XMETA_TEMPLATE_MAX_TAGS 64
+
 using namespace android;
+
+/*
+ * Result metadata layout shared by all XmetaResult buffers: every tag the
+ * 3a handlers and state machines report per frame is inserted once with
+ * room for its largest count and the entries are sorted. A result starts
+ * each frame as a copy of it, so writing a tag with that count copies the
+ * data into its entry by index, without a lookup, a buffer walk or a
+ * reallocation.
+ */
+class XmetaTemplate
+{
+public:
+    static XmetaTemplate *instance ();
+
+    // size of a result buffer, 0 if the template could not be built
+    size_t get_size () const {
+        return _size;
+    }
+    // the template entries are the first ones of a result
+    uint32_t get_tag_count () const {
+        return _tag_count;
+    }
+    // entry index of @tag in a result copied from the template, -1 if not part of it
+    int32_t find_index (uint32_t tag) const;
+    // @buffer holds get_size () bytes
+    camera_metadata_t *place (void *buffer) const;
+
+private:
+    explicit XmetaTemplate ();
+    XCAM_DEAD_COPY (XmetaTemplate);
+
+private:
+    camera_metadata_t *_buffer;
+    size_t             _size;
+    // tags in entry order
+    uint32_t           _tags[XMETA_TEMPLATE_MAX_TAGS];
+    uint32_t           _tag_count;
+};
+
 class XmetaResult : public X3aResult
 {
 public:
     XmetaResult (
                  XCamImageProcessType process_type = XCAM_IMAGE_PROCESS_ALWAYS)
         : X3aResult (XCAM_3A_METADATA_RESULT_TYPE, process_type)
-          , _meta (NULL)
           , _metadata (NULL)
+          , _written (0)
     {
-        _meta = allocate_camera_metadata(DEFAULT_ENTRY_CAP, DEFAULT_DATA_CAP);
-        XCAM_ASSERT (_meta);
-        _metadata = new CameraMetadata(_meta);
+        _metadata = new CameraMetadata ();
+        place_template ();
         set_ptr ((void*) _metadata);
     }
 
     virtual ~XmetaResult () {
-        /* free_camera_metadata(_meta); */
         delete _metadata;
-        _meta = NULL;
         _metadata = NULL;
     }
     void dump() {
@@ -86,9 +128,57 @@ public:
         return _metadata;
     }
 
+    /*
+     * Same as CameraMetadata::update, template tags are overwritten in place,
+     * other tags or counts beyond the template go through CameraMetadata.
+     */
+    XCamReturn update (uint32_t tag, const uint8_t *data, size_t count) {
+        if (write_entry (tag, TYPE_BYTE, data, count))
+            return XCAM_RETURN_NO_ERROR;
+        return mark_written (tag, _metadata->update (tag, data, count));
+    }
+    XCamReturn update (uint32_t tag, const int32_t *data, size_t count) {
+        if (write_entry (tag, TYPE_INT32, data, count))
+            return XCAM_RETURN_NO_ERROR;
+        return mark_written (tag, _metadata->update (tag, data, count));
+    }
+    XCamReturn update (uint32_t tag, const float *data, size_t count) {
+        if (write_entry (tag, TYPE_FLOAT, data, count))
+            return XCAM_RETURN_NO_ERROR;
+        return mark_written (tag, _metadata->update (tag, data, count));
+    }
+    XCamReturn update (uint32_t tag, const int64_t *data, size_t count) {
+        if (write_entry (tag, TYPE_INT64, data, count))
+            return XCAM_RETURN_NO_ERROR;
+        return mark_written (tag, _metadata->update (tag, data, count));
+    }
+    XCamReturn update (uint32_t tag, const camera_metadata_rational_t *data, size_t count) {
+        if (write_entry (tag, TYPE_RATIONAL, data, count))
+            return XCAM_RETURN_NO_ERROR;
+        return mark_written (tag, _metadata->update (tag, data, count));
+    }
+
+    // drops the template entries not written this frame, called once all handlers are done
+    void finish ();
+
+protected:
+    virtual void reset (XCamImageProcessType process_type) {
+        X3aResult::reset (process_type);
+        place_template ();
+    }
+
+private:
+    // starts the buffer over from the template, in place if it still has the template size
+    void place_template ();
+    // false if @tag has to go through CameraMetadata
+    bool write_entry (uint32_t tag, uint8_t type, const void *data, size_t count);
+    // keeps a template tag written through CameraMetadata from being dropped by finish ()
+    XCamReturn mark_written (uint32_t tag, status_t status);
+
 private:
     CameraMetadata *_metadata;
-    camera_metadata_t *_meta;
+    // bit per template entry written this frame
+    uint64_t        _written;
 };
 };
 
@@ -0,0 +1,597 @@
+/*
+ * x3a_replay.cpp - record and replay of the 3a loop
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "x3a_replay.h"
+#include "x3a_analyzer_rkiq.h"
+#include "x3a_statistics_queue.h"
+#include "x3a_isp_config.h"
+#include <system/camera_metadata.h>
+#include <time.h>
+#include <unistd.h>
+
+// how long a realtime replay waits for the analyzer thread to finish the last stats
+#define X3A_REPLAY_DRAIN_TIMEOUT (5 * 1000000LL)
+
+namespace XCam {
+
+/*
+ * Stands in for the sensor and ISP devices, answers with what was
+ * recorded for the frame being replayed. In a realtime replay the analyzer
+ * thread lags behind the frames set, the sensor mode data is looked up by
+ * the stats frame and the SOF and VCM times follow the last lookup.
+ */
+class X3aReplayIspController
+    : public IspController
+{
+public:
+    explicit X3aReplayIspController ()
+        : _latest (0)
+        , _current (0)
+    {
+        xcam_mem_clear (_frames);
+    }
+    void set_frame (const X3aRecordFrame &frame) {
+        SmartLock locker (_mutex);
+        _latest = (_latest + 1) % X3A_REPLAY_FRAME_HISTORY;
+        _frames[_latest] = frame;
+        _current = _latest;
+    }
+
+    virtual XCamReturn get_sensor_mode_data (
+        struct isp_supplemental_sensor_mode_data &sensor_mode_data, int stats_frame) {
+        SmartLock locker (_mutex);
+        _current = _latest;
+        for (uint32_t i = 0; stats_frame >= 0 && i < X3A_REPLAY_FRAME_HISTORY; i++) {
+            uint32_t index = (_latest + X3A_REPLAY_FRAME_HISTORY - i) % X3A_REPLAY_FRAME_HISTORY;
+            if (_frames[index].stats_frame == (uint32_t)stats_frame) {
+                _current = index;
+                break;
+            }
+        }
+        sensor_mode_data = _frames[_current].sensor_mode_data;
+        return XCAM_RETURN_NO_ERROR;
+    }
+    virtual XCamReturn get_frame_softime (int64_t &sof_tim) {
+        SmartLock locker (_mutex);
+        sof_tim = _frames[_current].sof_time;
+        return XCAM_RETURN_NO_ERROR;
+    }
+    virtual XCamReturn get_vcm_time (struct rk_cam_vcm_tim *vcm_tim) {
+        SmartLock locker (_mutex);
+        *vcm_tim = _frames[_current].vcm_tim;
+        return XCAM_RETURN_NO_ERROR;
+    }
+
+private:
+    XCAM_DEAD_COPY (X3aReplayIspController);
+
+private:
+    Mutex              _mutex;
+    X3aRecordFrame     _frames[X3A_REPLAY_FRAME_HISTORY];
+    uint32_t           _latest;
+    uint32_t           _current;
+};
+
+static int64_t
+replay_time_now ()
+{
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000LL + now.tv_nsec / 1000;
+}
+
+static void
+replay_sleep_until (int64_t usec)
+{
+    struct timespec due;
+    due.tv_sec = usec / 1000000LL;
+    due.tv_nsec = (usec % 1000000LL) * 1000;
+    while (clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &due, NULL) == EINTR);
+}
+
+X3aRecorder::X3aRecorder ()
+    : _fp (NULL)
+    , _path (NULL)
+    , _frames (0)
+    , _static_meta (NULL)
+    , _static_meta_size (0)
+    , _settings (NULL)
+    , _settings_size (0)
+{
+}
+
+X3aRecorder::~X3aRecorder ()
+{
+    close ();
+}
+
+XCamReturn
+X3aRecorder::open (const char *path, const X3aRecordHeader &header)
+{
+    XCAM_FAIL_RETURN (
+        ERROR, path, XCAM_RETURN_ERROR_PARAM,
+        "3a recorder open failed, path is NULL");
+    XCAM_FAIL_RETURN (
+        ERROR, !_fp, XCAM_RETURN_ERROR_PARAM,
+        "3a recorder open %s failed, %s is still recorded", path, XCAM_STR (_path));
+
+    _fp = fopen (path, "wb");
+    XCAM_FAIL_RETURN (
+        ERROR, _fp, XCAM_RETURN_ERROR_FILE,
+        "3a recorder open %s error:%s", path, strerror (errno));
+
+    if (fwrite (&header, sizeof (header), 1, _fp) != 1) {
+        XCAM_LOG_ERROR ("3a recorder write header to %s failed", path);
+        fclose (_fp);
+        _fp = NULL;
+        return XCAM_RETURN_ERROR_FILE;
+    }
+
+    _path = strndup (path, XCAM_MAX_STR_SIZE);
+    _frames = 0;
+    XCAM_LOG_INFO ("3a recorder records to %s", path);
+    return XCAM_RETURN_NO_ERROR;
+}
+
+void
+X3aRecorder::close ()
+{
+    if (_fp) {
+        fclose (_fp);
+        _fp = NULL;
+        XCAM_LOG_INFO ("3a recorder closed %s, %d frames recorded", XCAM_STR (_path), _frames);
+    }
+    if (_path) {
+        xcam_free (_path);
+        _path = NULL;
+    }
+    if (_static_meta) {
+        xcam_free (_static_meta);
+        _static_meta = NULL;
+    }
+    if (_settings) {
+        xcam_free (_settings);
+        _settings = NULL;
+    }
+    _static_meta_size = 0;
+    _settings_size = 0;
+}
+
+uint32_t
+X3aRecorder::cache_metadata (const CameraMetadata *meta, uint8_t *&last, uint32_t &last_size)
+{
+    uint32_t size = 0;
+    if (!meta || meta->isEmpty ())
+        return 0;
+
+    const camera_metadata_t *buffer = meta->getAndLock ();
+    uint32_t buffer_size = (uint32_t)get_camera_metadata_size (buffer);
+
+    if (buffer_size != last_size || memcmp (buffer, last, buffer_size)) {
+        uint8_t *copy = (uint8_t *)xcam_malloc (buffer_size);
+        if (copy) {
+            memcpy (copy, buffer, buffer_size);
+            if (last)
+                xcam_free (last);
+            last = copy;
+            last_size = buffer_size;
+            size = buffer_size;
+        } else {
+            XCAM_LOG_WARNING ("3a recorder alloc metadata(size:%d) failed, previous one is kept", buffer_size);
+        }
+    }
+    meta->unlock (buffer);
+    return size;
+}
+
+XCamReturn
+X3aRecorder::write_frame (
+    X3aRecordFrame &frame, const AiqInputParams *params, const struct cifisp_stat_buffer *stats)
+{
+    XCAM_ASSERT (stats);
+    if (!_fp)
+        return XCAM_RETURN_BYPASS;
+
+    frame.input_valid = params ? 1 : 0;
+    xcam_mem_clear (frame.input);
+    frame.static_meta_size = 0;
+    frame.settings_size = 0;
+    if (params) {
+        frame.input.req_id = params->reqId;
+        frame.input.ae_params = params->aeInputParams.aeParams;
+        memcpy (frame.input.ae_region, params->aeInputParams.aeRegion, sizeof (frame.input.ae_region));
+        frame.input.awb_params = params->awbInputParams.awbParams;
+        memcpy (frame.input.awb_region, params->awbInputParams.awbRegion, sizeof (frame.input.awb_region));
+        frame.input.af_params = params->afInputParams.afParams;
+        memcpy (frame.input.af_region, params->afInputParams.afRegion, sizeof (frame.input.af_region));
+        frame.input.aaa_controls = params->aaaControls;
+        frame.input.sensor_output_width = params->sensorOutputWidth;
+        frame.input.sensor_output_height = params->sensorOutputHeight;
+
+        frame.static_meta_size = cache_metadata (params->staticMeta, _static_meta, _static_meta_size);
+        frame.settings_size = cache_metadata (&params->settings, _settings, _settings_size);
+    }
+
+    bool ok = fwrite (&frame, sizeof (frame), 1, _fp) == 1 &&
+              (!frame.static_meta_size || fwrite (_static_meta, frame.static_meta_size, 1, _fp) == 1) &&
+              (!frame.settings_size || fwrite (_settings, frame.settings_size, 1, _fp) == 1) &&
+              fwrite (stats, sizeof (*stats), 1, _fp) == 1;
+    if (!ok) {
+        XCAM_LOG_ERROR ("3a recorder write frame(%d) to %s failed, recording stopped",
+                        frame.stats_frame, XCAM_STR (_path));
+        close ();
+        return XCAM_RETURN_ERROR_FILE;
+    }
+
+    ++_frames;
+    return XCAM_RETURN_NO_ERROR;
+}
+
+X3aReplayer::X3aReplayer (const char *iq_path)
+    : _iq_path (NULL)
+    , _parallel (false)
+    , _realtime (false)
+    , _policy (XCAM_ANALYZER_STATS_ALL)
+    , _interval (1)
+    , _output (NULL)
+    , _stats_frame (0)
+    , _start_usec (0)
+    , _pushed_count (0)
+{
+    if (iq_path)
+        _iq_path = strndup (iq_path, XCAM_MAX_STR_SIZE);
+}
+
+X3aReplayer::~X3aReplayer ()
+{
+    if (_output)
+        fclose (_output);
+    if (_iq_path)
+        xcam_free (_iq_path);
+}
+
+bool
+X3aReplayer::read_metadata (FILE *fp, uint32_t size, CameraMetadata &meta)
+{
+    if (!size)
+        return true;
+
+    camera_metadata_t *buffer = (camera_metadata_t *)xcam_malloc (size);
+    XCAM_FAIL_RETURN (
+        ERROR, buffer, false,
+        "3a replay alloc metadata(size:%d) failed", size);
+
+    size_t expected_size = size;
+    if (fread (buffer, size, 1, fp) != 1 ||
+            validate_camera_metadata_structure (buffer, &expected_size) != 0) {
+        XCAM_LOG_ERROR ("3a replay read metadata(size:%d) failed", size);
+        xcam_free (buffer);
+        return false;
+    }
+    // copied, the blob is not kept
+    meta = buffer;
+    xcam_free (buffer);
+    return true;
+}
+
+XCamReturn
+X3aReplayer::read_frame (
+    FILE *fp, X3aRecordFrame &frame, SmartPtr<AiqInputParams> &params,
+    struct cifisp_stat_buffer &stats)
+{
+    if (fread (&frame, sizeof (frame), 1, fp) != 1)
+        return feof (fp) ? XCAM_RETURN_BYPASS : XCAM_RETURN_ERROR_FILE;
+
+    XCAM_FAIL_RETURN (
+        ERROR,
+        read_metadata (fp, frame.static_meta_size, _static_meta) &&
+        read_metadata (fp, frame.settings_size, _settings) &&
+        fread (&stats, sizeof (stats), 1, fp) == 1,
+        XCAM_RETURN_ERROR_FILE,
+        "3a replay read frame(%d) failed, recording truncated", frame.stats_frame);
+
+    params.release ();
+    if (!frame.input_valid)
+        return XCAM_RETURN_NO_ERROR;
+
+    params = new AiqInputParams ();
+    params->reqId = frame.input.req_id;
+    params->aeInputParams.aeParams = frame.input.ae_params;
+    memcpy (params->aeInputParams.aeRegion, frame.input.ae_region, sizeof (frame.input.ae_region));
+    params->awbInputParams.awbParams = frame.input.awb_params;
+    memcpy (params->awbInputParams.awbRegion, frame.input.awb_region, sizeof (frame.input.awb_region));
+    params->afInputParams.afParams = frame.input.af_params;
+    memcpy (params->afInputParams.afRegion, frame.input.af_region, sizeof (frame.input.af_region));
+    params->aaaControls = frame.input.aaa_controls;
+    params->sensorOutputWidth = frame.input.sensor_output_width;
+    params->sensorOutputHeight = frame.input.sensor_output_height;
+    params->settings = _settings;
+    params->staticMeta = &_static_meta;
+    return XCAM_RETURN_NO_ERROR;
+}
+
+void
+X3aReplayer::write_result (
+    uint32_t type, uint32_t stats_frame, int64_t done_usec, const void *data, uint32_t size)
+{
+    if (!_output)
+        return;
+
+    X3aReplayResult result;
+    xcam_mem_clear (result);
+    result.type = type;
+    result.stats_frame = stats_frame;
+    result.size = size;
+    result.done_usec = done_usec;
+    if (fwrite (&result, sizeof (result), 1, _output) != 1 ||
+            fwrite (data, size, 1, _output) != 1) {
+        XCAM_LOG_ERROR ("3a replay write result of frame(%d) failed, output stopped", stats_frame);
+        fclose (_output);
+        _output = NULL;
+    }
+}
+
+void
+X3aReplayer::add_pushed (uint32_t stats_frame, int64_t sof_time, int64_t push_usec)
+{
+    SmartLock locker (_pushed_mutex);
+    PushedFrame &pushed = _pushed[_pushed_count++ % X3A_REPLAY_FRAME_HISTORY];
+    pushed.stats_frame = stats_frame;
+    pushed.sof_time = sof_time;
+    pushed.push_usec = push_usec;
+}
+
+bool
+X3aReplayer::find_pushed (int64_t sof_time, uint32_t &stats_frame, int64_t &push_usec)
+{
+    SmartLock locker (_pushed_mutex);
+    uint32_t count = XCAM_MIN (_pushed_count, (uint32_t)X3A_REPLAY_FRAME_HISTORY);
+
+    for (uint32_t i = 1; i <= count; i++) {
+        const PushedFrame &pushed = _pushed[(_pushed_count - i) % X3A_REPLAY_FRAME_HISTORY];
+        if (pushed.sof_time == sof_time) {
+            stats_frame = pushed.stats_frame;
+            push_usec = pushed.push_usec;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+X3aReplayer::x3a_calculation_done (XAnalyzer *analyzer, X3aResultList &results)
+{
+    XCAM_UNUSED (analyzer);
+    int64_t now = replay_time_now ();
+    uint32_t stats_frame = _stats_frame;
+    int64_t push_usec = 0;
+
+    // the results carry the timestamp of their stats, which is the SOF time
+    if (!results.empty () && find_pushed (results.front ()->get_timestamp (), stats_frame, push_usec)) {
+        int64_t age = now - push_usec;
+        ++_report.aged_frames;
+        _report.total_age_usec += age;
+        if (age > _report.max_age_usec)
+            _report.max_age_usec = age;
+    }
+
+    for (X3aResultList::iterator iter = results.begin (); iter != results.end (); ++iter) {
+        SmartPtr<X3aResult> &result = *iter;
+
+        if (result->get_type () == X3aIspConfig::IspAllParameters) {
+            SmartPtr<X3aAtomIspParametersResult> params =
+                result.dynamic_cast_ptr<X3aAtomIspParametersResult> ();
+            XCAM_ASSERT (params.ptr ());
+            write_result (X3aIspConfig::IspAllParameters, stats_frame, now - _start_usec,
+                          &params->get_isp_config (), sizeof (struct rkisp_parameters));
+            ++_report.params_results;
+        } else if (result->get_type () == X3aIspConfig::IspExposureParameters) {
+            SmartPtr<X3aIspExposureResult> exposure =
+                result.dynamic_cast_ptr<X3aIspExposureResult> ();
+            XCAM_ASSERT (exposure.ptr ());
+            write_result (X3aIspConfig::IspExposureParameters, stats_frame, now - _start_usec,
+                          &exposure->get_isp_config (), sizeof (struct rkisp_exposure));
+            ++_report.exposure_results;
+        }
+    }
+}
+
+void
+X3aReplayer::x3a_calculation_failed (XAnalyzer *analyzer, int64_t timestamp, const char *msg)
+{
+    XCAM_UNUSED (analyzer);
+    XCAM_UNUSED (timestamp);
+    XCAM_LOG_WARNING ("3a replay frame(%d) failed: %s", _stats_frame, XCAM_STR (msg));
+    ++_report.failed;
+}
+
+XCamReturn
+X3aReplayer::run (const char *record_path, const char *output_path, uint32_t max_frames)
+{
+    XCamReturn ret = XCAM_RETURN_NO_ERROR;
+    X3aRecordHeader header;
+    X3aRecordFrame frame;
+    SmartPtr<AiqInputParams> params;
+
+    XCAM_FAIL_RETURN (
+        ERROR, record_path, XCAM_RETURN_ERROR_PARAM,
+        "3a replay failed, record path is NULL");
+
+    FILE *fp = fopen (record_path, "rb");
+    XCAM_FAIL_RETURN (
+        ERROR, fp, XCAM_RETURN_ERROR_FILE,
+        "3a replay open %s error:%s", record_path, strerror (errno));
+
+    if (fread (&header, sizeof (header), 1, fp) != 1 ||
+            header.magic != X3A_RECORD_MAGIC || header.version != X3A_RECORD_VERSION ||
+            header.frame_size != sizeof (X3aRecordFrame) ||
+            header.stats_size != sizeof (struct cifisp_stat_buffer)) {
+        XCAM_LOG_ERROR ("3a replay %s is not a recording of this build", record_path);
+        fclose (fp);
+        return XCAM_RETURN_ERROR_PARAM;
+    }
+    header.sensor_entity_name[X3A_RECORD_NAME_SIZE - 1] = '\0';
+
+    uint32_t stats_buffers = _realtime ? X3A_REPLAY_REALTIME_STATS_BUFFERS : 2;
+    SmartPtr<X3aStatisticsQueue> stats_pool = new X3aStatisticsQueue;
+    if (!stats_pool->reserve (stats_buffers)) {
+        XCAM_LOG_ERROR ("3a replay reserve stats buffers failed");
+        fclose (fp);
+        return XCAM_RETURN_ERROR_MEM;
+    }
+
+    // the analyzer init already asks for the sensor mode data of the first frame
+    struct cifisp_stat_buffer isp_stats;
+    ret = read_frame (fp, frame, params, isp_stats);
+    if (ret != XCAM_RETURN_NO_ERROR) {
+        XCAM_LOG_ERROR ("3a replay %s has no frame", record_path);
+        fclose (fp);
+        return XCAM_RETURN_ERROR_FILE;
+    }
+
+    if (output_path) {
+        X3aReplayOutputHeader output_header;
+        output_header.magic = X3A_REPLAY_MAGIC;
+        output_header.version = X3A_REPLAY_VERSION;
+        output_header.params_size = sizeof (struct rkisp_parameters);
+        output_header.exposure_size = sizeof (struct rkisp_exposure);
+
+        _output = fopen (output_path, "wb");
+        if (!_output || fwrite (&output_header, sizeof (output_header), 1, _output) != 1) {
+            XCAM_LOG_ERROR ("3a replay open output %s error:%s", output_path, strerror (errno));
+            if (_output)
+                fclose (_output);
+            _output = NULL;
+            fclose (fp);
+            return XCAM_RETURN_ERROR_FILE;
+        }
+    }
+
+    SmartPtr<X3aReplayIspController> replay_isp = new X3aReplayIspController ();
+    replay_isp->set_isp_ver (header.isp_ver);
+    replay_isp->set_frame (frame);
+    SmartPtr<IspController> isp = replay_isp;
+
+    SmartPtr<X3aAnalyzerRKiq> analyzer = new X3aAnalyzerRKiq (isp, _iq_path);
+    analyzer->set_sensor_entity_name (header.sensor_entity_name);
+    analyzer->setAiqInputParams (params);
+    analyzer->set_parallel_analyze (_parallel);
+    analyzer->set_results_callback (this);
+    analyzer->set_sync_mode (!_realtime);
+    analyzer->set_stats_policy (_policy, _interval);
+
+    _report = X3aReplayReport ();
+    _stats_frame = frame.stats_frame;
+    _pushed_count = 0;
+    _start_usec = replay_time_now ();
+
+    if (analyzer->prepare_handlers () != XCAM_RETURN_NO_ERROR ||
+            analyzer->init (header.width, header.height, header.framerate) != XCAM_RETURN_NO_ERROR ||
+            analyzer->start () != XCAM_RETURN_NO_ERROR) {
+        XCAM_LOG_ERROR ("3a replay start analyzer failed");
+        analyzer->deinit ();
+        fclose (fp);
+        if (_output) {
+            fclose (_output);
+            _output = NULL;
+        }
+        return XCAM_RETURN_ERROR_AIQ;
+    }
+
+    _start_usec = replay_time_now ();
+    int64_t first_sof_time = frame.sof_time;
+    while (true) {
+        SmartPtr<X3aIspStatistics> stats;
+        if (_realtime) {
+            replay_sleep_until (_start_usec + (frame.sof_time - first_sof_time) / 1000);
+            stats = stats_pool->try_get_buffer (stats_pool).dynamic_cast_ptr<X3aIspStatistics> ();
+        } else {
+            stats = stats_pool->get_buffer (stats_pool).dynamic_cast_ptr<X3aIspStatistics> ();
+            XCAM_ASSERT (stats.ptr ());
+            replay_isp->set_frame (frame);
+            analyzer->setAiqInputParams (params);
+        }
+
+        if (stats.ptr ()) {
+            memcpy (stats->get_isp_stats (), &isp_stats, sizeof (isp_stats));
+            stats->set_sequence (frame.stats_frame);
+            stats->set_timestamp (frame.sof_time);
+            if (_realtime)
+                replay_isp->set_frame (frame);
+            _stats_frame = frame.stats_frame;
+
+            int64_t begin = replay_time_now ();
+            add_pushed (frame.stats_frame, frame.sof_time, begin);
+            SmartPtr<X3aStats> x3a_stats = stats;
+            stats.release ();
+            analyzer->push_3a_stats (x3a_stats);
+            int64_t usec = replay_time_now () - begin;
+
+            if (!_realtime) {
+                _report.total_usec += usec;
+                if (usec > _report.max_usec)
+                    _report.max_usec = usec;
+            }
+        } else {
+            ++_report.stats_dropped;
+        }
+
+        ++_report.frames;
+        if (max_frames && _report.frames >= max_frames)
+            break;
+
+        ret = read_frame (fp, frame, params, isp_stats);
+        if (ret != XCAM_RETURN_NO_ERROR)
+            break;
+    }
+
+    if (_realtime) {
+        // the analyzer thread is done once all stats buffers are back
+        int64_t due = replay_time_now () + X3A_REPLAY_DRAIN_TIMEOUT;
+        while (stats_pool->get_free_buffer_size () < stats_buffers && replay_time_now () < due)
+            usleep (1000);
+        _report.analyzer = analyzer->get_stats_counters ();
+    }
+    for (int i = XCAM_3A_HANDLER_AE; i < XCAM_3A_HANDLER_COUNT; ++i)
+        analyzer->get_handler_latency ((X3aHandlerType)i, _report.handlers[i]);
+
+    analyzer->stop ();
+    analyzer->deinit ();
+    fclose (fp);
+    if (_output) {
+        fclose (_output);
+        _output = NULL;
+    }
+
+    if (_realtime)
+        XCAM_LOG_INFO ("3a replay %s: %d frames, %d failed, %d dropped, results after %" PRId64 "us avg %" PRId64 "us max",
+                       record_path, _report.frames, _report.failed, _report.stats_dropped,
+                       _report.aged_frames ? _report.total_age_usec / _report.aged_frames : 0,
+                       _report.max_age_usec);
+    else
+        XCAM_LOG_INFO ("3a replay %s: %d frames, %d failed, %.1f fps, max %" PRId64 "us",
+                       record_path, _report.frames, _report.failed,
+                       _report.total_usec ? _report.frames * 1000000.0 / _report.total_usec : 0.0,
+                       _report.max_usec);
+
+    return (ret == XCAM_RETURN_BYPASS || ret == XCAM_RETURN_NO_ERROR) ?
+           XCAM_RETURN_NO_ERROR : ret;
+}
+
+};
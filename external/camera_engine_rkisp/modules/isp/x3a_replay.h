@@ -0,0 +1,241 @@
+/*
+ * x3a_replay.h - record and replay of the 3a loop
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_3A_REPLAY_H
+#define XCAM_3A_REPLAY_H
+
+#include <xcam_std.h>
+#include <linux/rkisp.h>
+#include "x3a_analyzer.h"
+#include "isp_controller.h"
+#include "rkaiq.h"
+
+#define X3A_RECORD_MAGIC        0x52413358  /* "X3AR" */
+#define X3A_REPLAY_MAGIC        0x4f413358  /* "X3AO" */
+#define X3A_RECORD_VERSION      1
+#define X3A_REPLAY_VERSION      2
+#define X3A_RECORD_NAME_SIZE    64
+// as many as IspPollThread reserves
+#define X3A_REPLAY_REALTIME_STATS_BUFFERS   6
+// recent frames the replay looks up the results and sensor data of
+#define X3A_REPLAY_FRAME_HISTORY            16
+
+namespace XCam {
+
+/*
+ * Recording layout, all in host byte order:
+ *   X3aRecordHeader
+ *   per frame: X3aRecordFrame, static metadata blob, settings blob,
+ *              struct cifisp_stat_buffer
+ * The metadata blobs are camera_metadata_t copies, only written when they
+ * changed since the previous frame, their size is 0 otherwise.
+ * The struct sizes are stored so a recording of another build is rejected
+ * instead of misread.
+ */
+struct X3aRecordHeader {
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    frame_size;
+    uint32_t    stats_size;
+    uint32_t    width;
+    uint32_t    height;
+    double      framerate;
+    int32_t     isp_ver;
+    char        sensor_entity_name[X3A_RECORD_NAME_SIZE];
+};
+
+// POD part of AiqInputParams
+struct X3aRecordInput {
+    uint32_t        req_id;
+    XCamAeParam     ae_params;
+    int32_t         ae_region[5];
+    XCamAwbParam    awb_params;
+    int32_t         awb_region[5];
+    XCamAfParam     af_params;
+    int32_t         af_region[5];
+    AAAControls     aaa_controls;
+    int32_t         sensor_output_width;
+    int32_t         sensor_output_height;
+};
+
+struct X3aRecordFrame {
+    uint32_t        stats_frame;
+    int64_t         sof_time;
+    struct isp_supplemental_sensor_mode_data sensor_mode_data;
+    struct rk_cam_vcm_tim vcm_tim;
+    // 0 if no input params were set for this frame
+    uint32_t        input_valid;
+    X3aRecordInput  input;
+    uint32_t        static_meta_size;
+    uint32_t        settings_size;
+};
+
+/*
+ * Replay output, X3aReplayOutputHeader then per result an X3aReplayResult
+ * followed by @size bytes of struct rkisp_parameters or struct rkisp_exposure.
+ */
+struct X3aReplayOutputHeader {
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    params_size;
+    uint32_t    exposure_size;
+};
+
+struct X3aReplayResult {
+    uint32_t    type;
+    uint32_t    stats_frame;
+    uint32_t    size;
+    // when the result was done, from the start of the replay
+    int64_t     done_usec;
+};
+
+class X3aRecorder {
+public:
+    explicit X3aRecorder ();
+    ~X3aRecorder ();
+
+    XCamReturn open (const char *path, const X3aRecordHeader &header);
+    void close ();
+    bool is_opened () const {
+        return _fp != NULL;
+    }
+    uint32_t get_frames () const {
+        return _frames;
+    }
+
+    // input fields and blob sizes of @frame are filled from @params, NULL if there were none
+    XCamReturn write_frame (
+        X3aRecordFrame &frame, const AiqInputParams *params, const struct cifisp_stat_buffer *stats);
+
+private:
+    // size of @meta to write, 0 if it did not change since the last frame
+    uint32_t cache_metadata (const CameraMetadata *meta, uint8_t *&last, uint32_t &last_size);
+    XCAM_DEAD_COPY (X3aRecorder);
+
+private:
+    FILE                  *_fp;
+    char                  *_path;
+    uint32_t               _frames;
+    uint8_t               *_static_meta;
+    uint32_t               _static_meta_size;
+    uint8_t               *_settings;
+    uint32_t               _settings_size;
+};
+
+struct X3aReplayReport {
+    uint32_t               frames;
+    uint32_t               failed;
+    uint32_t               params_results;
+    uint32_t               exposure_results;
+    // time spent in the analyzer, file IO excluded, sync replay only
+    int64_t                total_usec;
+    int64_t                max_usec;
+    X3aLatencyHistogram    handlers[XCAM_3A_HANDLER_COUNT];
+    // from the arrival of the stats to their results
+    uint32_t               aged_frames;
+    int64_t                total_age_usec;
+    int64_t                max_age_usec;
+    // realtime replay only, frames arriving while every stats buffer is in use
+    uint32_t               stats_dropped;
+    XAnalyzerStatsCounters analyzer;
+
+    X3aReplayReport ()
+        : frames (0), failed (0)
+        , params_results (0), exposure_results (0)
+        , total_usec (0), max_usec (0)
+        , aged_frames (0), total_age_usec (0), max_age_usec (0)
+        , stats_dropped (0)
+    {}
+};
+
+/*
+ * Feeds a recording through X3aAnalyzerRKiq in sync mode, the sensor mode
+ * data, SOF and VCM times come from a fake IspController, so no sensor or
+ * ISP device is needed. The ISP parameters and exposures produced for each
+ * frame are written to the output file when one is given.
+ *
+ * A realtime replay instead pushes the stats at their recorded SOF times to
+ * the analyzer thread, which analyzes them with the given stats policy. Like
+ * IspPollThread, a frame arriving while all stats buffers are in use is
+ * dropped. Only the input params of the first frame are applied.
+ */
+class X3aReplayer
+    : public AnalyzerCallback
+{
+public:
+    explicit X3aReplayer (const char *iq_path);
+    virtual ~X3aReplayer ();
+
+    void set_parallel_analyze (bool enable) {
+        _parallel = enable;
+    }
+    void set_realtime (
+        bool enable, XAnalyzerStatsPolicy policy = XCAM_ANALYZER_STATS_ALL, uint32_t interval = 1) {
+        _realtime = enable;
+        _policy = policy;
+        _interval = interval;
+    }
+    // @max_frames 0 replays the whole recording
+    XCamReturn run (const char *record_path, const char *output_path, uint32_t max_frames = 0);
+    const X3aReplayReport &get_report () const {
+        return _report;
+    }
+
+    // derived from AnalyzerCallback
+    virtual void x3a_calculation_done (XAnalyzer *analyzer, X3aResultList &results);
+    virtual void x3a_calculation_failed (XAnalyzer *analyzer, int64_t timestamp, const char *msg);
+
+private:
+    XCamReturn read_frame (
+        FILE *fp, X3aRecordFrame &frame, SmartPtr<AiqInputParams> &params,
+        struct cifisp_stat_buffer &stats);
+    bool read_metadata (FILE *fp, uint32_t size, CameraMetadata &meta);
+    void write_result (
+        uint32_t type, uint32_t stats_frame, int64_t done_usec, const void *data, uint32_t size);
+    void add_pushed (uint32_t stats_frame, int64_t sof_time, int64_t push_usec);
+    // false if the frame of @sof_time is no longer known, e.g. results of configure_3a
+    bool find_pushed (int64_t sof_time, uint32_t &stats_frame, int64_t &push_usec);
+    XCAM_DEAD_COPY (X3aReplayer);
+
+private:
+    struct PushedFrame {
+        uint32_t stats_frame;
+        int64_t  sof_time;
+        int64_t  push_usec;
+    };
+
+    char                  *_iq_path;
+    bool                   _parallel;
+    bool                   _realtime;
+    XAnalyzerStatsPolicy   _policy;
+    uint32_t               _interval;
+    FILE                  *_output;
+    uint32_t               _stats_frame;
+    int64_t                _start_usec;
+    Mutex                  _pushed_mutex;
+    PushedFrame            _pushed[X3A_REPLAY_FRAME_HISTORY];
+    uint32_t               _pushed_count;
+    CameraMetadata         _static_meta;
+    CameraMetadata         _settings;
+    X3aReplayReport        _report;
+};
+
+};
+
+#endif //XCAM_3A_REPLAY_H
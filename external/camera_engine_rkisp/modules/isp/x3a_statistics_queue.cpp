@@ -25,66 +25,161 @@
 
 namespace XCam {
 
+X3aIspStatsLeases::X3aIspStatsLeases ()
+    : _count (0)
+    , _generation (0)
+{
+}
+
+uint32_t
+X3aIspStatsLeases::acquire ()
+{
+    SmartLock locker (_mutex);
+    ++_count;
+    return _generation;
+}
+
+void
+X3aIspStatsLeases::release (
+    const SmartPtr<V4l2Device> &device, SmartPtr<V4l2Buffer> &buf, uint32_t generation)
+{
+    SmartLock locker (_mutex);
+    XCAM_ASSERT (_count > 0);
+
+    if (generation == _generation && device->is_activated ())
+        device->queue_buffer (buf);
+    if (--_count == 0)
+        _idle_cond.broadcast ();
+}
+
+bool
+X3aIspStatsLeases::wait_idle (int64_t timeout_us)
+{
+    SmartLock locker (_mutex);
+    while (_count > 0) {
+        if (timeout_us < 0)
+            _idle_cond.wait (_mutex);
+        else if (_idle_cond.timedwait (_mutex, timeout_us) == ETIMEDOUT)
+            break;
+    }
+    XCAM_FAIL_RETURN (
+        WARNING, _count == 0, false,
+        "%d stats buffers are still leased", _count);
+    return true;
+}
+
+void
+X3aIspStatsLeases::invalidate ()
+{
+    SmartLock locker (_mutex);
+    ++_generation;
+}
+
 X3aIspStatsData::X3aIspStatsData (struct cifisp_stat_buffer *isp_data, XCam3AStats *data)
     : X3aStatsData (data)
     , _isp_data (isp_data)
+    , _lease_stats (NULL)
+    , _lease_generation (0)
+    , _standard_filled (false)
 {
     XCAM_ASSERT (_isp_data);
 }
 
 X3aIspStatsData::~X3aIspStatsData ()
 {
+    release_lease ();
     if (_isp_data) {
         xcam_free (_isp_data);
     }
 }
 
+void
+X3aIspStatsData::lease (
+    const SmartPtr<V4l2Buffer> &buf, const SmartPtr<V4l2Device> &device,
+    const SmartPtr<X3aIspStatsLeases> &leases)
+{
+    XCAM_ASSERT (buf.ptr () && device.ptr () && leases.ptr ());
+    release_lease ();
+
+    _lease_buf = buf;
+    _lease_device = device;
+    _leases = leases;
+    _lease_generation = _leases->acquire ();
+    _lease_stats = (struct cifisp_stat_buffer *)buf->map ();
+}
+
+void
+X3aIspStatsData::release_lease ()
+{
+    // the next user brings new stats
+    _standard_filled = false;
+    if (!_lease_buf.ptr ())
+        return;
+
+    _lease_stats = NULL;
+    _leases->release (_lease_device, _lease_buf, _lease_generation);
+    _lease_buf.release ();
+    _lease_device.release ();
+    _leases.release ();
+}
+
+XCam3AStats *
+X3aIspStatsData::get_stats ()
+{
+    // only analyzers working on the standard stats pay for the conversion
+    if (!_standard_filled)
+        fill_standard_stats ();
+    return X3aStatsData::get_stats ();
+}
+
 bool
 X3aIspStatsData::fill_standard_stats ()
 {
-    XCam3AStats *standard_stats = get_stats ();
+    XCam3AStats *standard_stats = X3aStatsData::get_stats ();
+    const struct cifisp_stat_buffer *isp_data =
+        (const struct cifisp_stat_buffer *)get_isp_stats ();
 
-    XCAM_ASSERT (_isp_data);
+    XCAM_ASSERT (isp_data);
     XCAM_ASSERT (standard_stats);
     XCAM_FAIL_RETURN (
         WARNING,
-        _isp_data && standard_stats,
+        isp_data && standard_stats,
         false,
         "X3aIspStatsData fill standard stats failed with null data allocated");
 /*
-    _isp_data->params.ae.exp_mean;
-    _isp_data->params.ae.bls_val;
+    isp_data->params.ae.exp_mean;
+    isp_data->params.ae.bls_val;
 
-    _isp_data->params.awb.awb_mean;
-    _isp_data->params.af.window;
+    isp_data->params.awb.awb_mean;
+    isp_data->params.af.window;
 */
 
     XCamGridStat *standard_data = standard_stats->stats;
 
     for (uint32_t i = 0; i < CIFISP_AE_MEAN_MAX; ++i)
-            standard_data[i].avg_y =_isp_data->params.ae.exp_mean[i];
+            standard_data[i].avg_y =isp_data->params.ae.exp_mean[i];
 #if RKISP
-    standard_data[0].mean_cr_or_r= _isp_data->params.awb.awb_mean[0].mean_cr_or_r;
-    standard_data[0].mean_y_or_g= _isp_data->params.awb.awb_mean[0].mean_y_or_g;
-    standard_data[0].mean_cb_or_b = _isp_data->params.awb.awb_mean[0].mean_cb_or_b;
+    standard_data[0].mean_cr_or_r= isp_data->params.awb.awb_mean[0].mean_cr_or_r;
+    standard_data[0].mean_y_or_g= isp_data->params.awb.awb_mean[0].mean_y_or_g;
+    standard_data[0].mean_cb_or_b = isp_data->params.awb.awb_mean[0].mean_cb_or_b;
 #else
-    if(_isp_data->params.awb.awb_mean[0].mean_y != 0) {
-        standard_data[0].mean_y_or_g = _isp_data->params.awb.awb_mean[0].mean_y;
-        standard_data[0].mean_cb_or_b = _isp_data->params.awb.awb_mean[0].mean_cb;
-        standard_data[0].mean_cr_or_r = _isp_data->params.awb.awb_mean[0].mean_cr;
+    if(isp_data->params.awb.awb_mean[0].mean_y != 0) {
+        standard_data[0].mean_y_or_g = isp_data->params.awb.awb_mean[0].mean_y;
+        standard_data[0].mean_cb_or_b = isp_data->params.awb.awb_mean[0].mean_cb;
+        standard_data[0].mean_cr_or_r = isp_data->params.awb.awb_mean[0].mean_cr;
     } else {
-        standard_data[0].mean_cr_or_r= _isp_data->params.awb.awb_mean[0].mean_r;
-        standard_data[0].mean_y_or_g= _isp_data->params.awb.awb_mean[0].mean_g;
-        standard_data[0].mean_cb_or_b = _isp_data->params.awb.awb_mean[0].mean_b;
+        standard_data[0].mean_cr_or_r= isp_data->params.awb.awb_mean[0].mean_r;
+        standard_data[0].mean_y_or_g= isp_data->params.awb.awb_mean[0].mean_g;
+        standard_data[0].mean_cb_or_b = isp_data->params.awb.awb_mean[0].mean_b;
     }
 #endif
-    standard_data[0].valid_wb_count = _isp_data->params.awb.awb_mean[0].cnt;
+    standard_data[0].valid_wb_count = isp_data->params.awb.awb_mean[0].cnt;
 
     uint32_t hist_bins = CIFISP_HIST_BIN_N_MAX;
     uint32_t *hist_y = standard_stats->hist_y;
 
     for (uint32_t i = 0; i < hist_bins; i++) {
-        hist_y[i] = _isp_data->params.hist.hist_bins[i];
+        hist_y[i] = isp_data->params.hist.hist_bins[i];
     }
 #if 1
     XCAM_LOG_INFO("> AE Measurement:\n");
@@ -92,15 +187,15 @@ X3aIspStatsData::fill_standard_stats ()
     for (int i = 0; i < 81; i += 9)
         XCAM_LOG_INFO("> Exposure means %d-%d: %d, %d, %d, %d, %d, %d, %d, %d, %d\n",
                             i, i+8,
-                            _isp_data->params.ae.exp_mean[i],
-                            _isp_data->params.ae.exp_mean[i + 1],
-                            _isp_data->params.ae.exp_mean[i + 2],
-                            _isp_data->params.ae.exp_mean[i + 3],
-                            _isp_data->params.ae.exp_mean[i + 4],
-                            _isp_data->params.ae.exp_mean[i + 5],
-                            _isp_data->params.ae.exp_mean[i + 6],
-                            _isp_data->params.ae.exp_mean[i + 7],
-                            _isp_data->params.ae.exp_mean[i + 8]);
+                            isp_data->params.ae.exp_mean[i],
+                            isp_data->params.ae.exp_mean[i + 1],
+                            isp_data->params.ae.exp_mean[i + 2],
+                            isp_data->params.ae.exp_mean[i + 3],
+                            isp_data->params.ae.exp_mean[i + 4],
+                            isp_data->params.ae.exp_mean[i + 5],
+                            isp_data->params.ae.exp_mean[i + 6],
+                            isp_data->params.ae.exp_mean[i + 7],
+                            isp_data->params.ae.exp_mean[i + 8]);
 
     XCAM_LOG_INFO("> AWB mean lumin-ycbcr-rgb=[%d-%d-%d]",
         standard_data[0].mean_cr_or_r,
@@ -108,14 +203,15 @@ X3aIspStatsData::fill_standard_stats ()
         standard_data[0].mean_cr_or_r);
 
     XCAM_LOG_INFO("> AF stats win0[%d-%d], win1[%d-%d], win2[%d-%d]",
-        _isp_data->params.af.window[0].lum,
-        _isp_data->params.af.window[0].sum,
-        _isp_data->params.af.window[1].lum,
-        _isp_data->params.af.window[1].sum,
-        _isp_data->params.af.window[2].lum,
-        _isp_data->params.af.window[2].sum);
+        isp_data->params.af.window[0].lum,
+        isp_data->params.af.window[0].sum,
+        isp_data->params.af.window[1].lum,
+        isp_data->params.af.window[1].sum,
+        isp_data->params.af.window[2].lum,
+        isp_data->params.af.window[2].sum);
 #endif
 
+    _standard_filled = true;
     return true;
 }
 
@@ -126,6 +222,28 @@ X3aIspStatistics::X3aIspStatistics (const SmartPtr<X3aIspStatsData> &stats_data)
 
 X3aIspStatistics::~X3aIspStatistics ()
 {
+    SmartPtr<X3aIspStatsData> stats = get_buffer_data ().dynamic_cast_ptr<X3aIspStatsData> ();
+    if (stats.ptr ())
+        stats->release_lease ();
+}
+
+void
+X3aIspStatistics::lease (
+    const SmartPtr<V4l2Buffer> &buf, const SmartPtr<V4l2Device> &device,
+    const SmartPtr<X3aIspStatsLeases> &leases)
+{
+    SmartPtr<X3aIspStatsData> stats = get_buffer_data ().dynamic_cast_ptr<X3aIspStatsData> ();
+    XCAM_ASSERT (stats.ptr ());
+    stats->lease (buf, device, leases);
+}
+
+bool
+X3aIspStatistics::recycle ()
+{
+    SmartPtr<X3aIspStatsData> stats = get_buffer_data ().dynamic_cast_ptr<X3aIspStatsData> ();
+    if (stats.ptr ())
+        stats->release_lease ();
+    return X3aStats::recycle ();
 }
 
 void *
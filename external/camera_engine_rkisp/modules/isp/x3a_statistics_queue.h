@@ -24,6 +24,8 @@
 #include <xcam_std.h>
 #include <xcam_mutex.h>
 #include <x3a_stats_pool.h>
+#include <v4l2_device.h>
+#include <v4l2_buffer_proxy.h>
 #include <linux/rkisp.h>
 #include <rk-isp-config.h>
 
@@ -31,6 +33,34 @@ namespace XCam {
 
 class X3aStatisticsQueue;
 
+/*
+ * Stats buffers of the device currently leased to the analyzer. The device
+ * must not be stopped (buffers unmapped) before they are all returned, and
+ * buffers of an older stream are not queued back.
+ */
+class X3aIspStatsLeases
+    : public RefObj
+{
+public:
+    explicit X3aIspStatsLeases ();
+
+    uint32_t acquire ();
+    void release (const SmartPtr<V4l2Device> &device, SmartPtr<V4l2Buffer> &buf, uint32_t generation);
+    // wait at most @timeout_us for all leases to be returned, < 0 waits until they are
+    bool wait_idle (int64_t timeout_us);
+    // leases returned from now on belong to a stopped stream
+    void invalidate ();
+
+private:
+    XCAM_DEAD_COPY (X3aIspStatsLeases);
+
+private:
+    Mutex                     _mutex;
+    XCam::Cond                _idle_cond;
+    uint32_t                  _count;
+    uint32_t                  _generation;
+};
+
 class X3aIspStatsData
     : public X3aStatsData
 {
@@ -38,15 +68,22 @@ public:
     explicit X3aIspStatsData (struct cifisp_stat_buffer *isp_data, XCam3AStats *data);
     ~X3aIspStatsData ();
     void *get_isp_stats () {
-        return _isp_data;
+        return _lease_stats ? _lease_stats : _isp_data;
     }
 
     virtual uint8_t *map () {
-        return (uint8_t*)(void*)(_isp_data);
+        return (uint8_t*)get_isp_stats ();
     }
     virtual bool unmap () {
         return true;
     }
+    virtual XCam3AStats *get_stats ();
+
+    // read the stats in place from a dequeued stats buffer until release_lease
+    void lease (
+        const SmartPtr<V4l2Buffer> &buf, const SmartPtr<V4l2Device> &device,
+        const SmartPtr<X3aIspStatsLeases> &leases);
+    void release_lease ();
 
     bool fill_standard_stats ();
 
@@ -55,6 +92,12 @@ private:
 
 private:
     struct cifisp_stat_buffer *_isp_data;
+    struct cifisp_stat_buffer *_lease_stats;
+    SmartPtr<V4l2Buffer>       _lease_buf;
+    SmartPtr<V4l2Device>       _lease_device;
+    SmartPtr<X3aIspStatsLeases> _leases;
+    uint32_t                   _lease_generation;
+    bool                       _standard_filled;
 };
 
 class X3aIspStatistics
@@ -67,9 +110,19 @@ protected:
 public:
     virtual ~X3aIspStatistics ();
     void *get_isp_stats ();
+    // read-only view, in place while the stats buffer is leased
+    const struct cifisp_stat_buffer *get_isp_stats_view () {
+        return (const struct cifisp_stat_buffer *)get_isp_stats ();
+    }
+    void lease (
+        const SmartPtr<V4l2Buffer> &buf, const SmartPtr<V4l2Device> &device,
+        const SmartPtr<X3aIspStatsLeases> &leases);
 
     bool fill_standard_stats ();
 
+    // derived from RefObj, the lease is dropped before the proxy is reused
+    virtual bool recycle ();
+
 private:
     XCAM_DEAD_COPY (X3aIspStatistics);
 };
@@ -0,0 +1,335 @@
+/*
+ * soft_executor.cpp - process-wide work-stealing executor for soft workers
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "soft_executor.h"
+#include "xcam_thread.h"
+#include <unistd.h>
+
+// chunks per thread a job is split into when the grain is not set
+#define XCAM_SOFT_EXECUTOR_CHUNKS_PER_THREAD 4
+
+namespace XCam {
+
+uint32_t SoftExecutor::_default_threads = 0;
+SmartPtr<SoftExecutor> SoftExecutor::_instance;
+Mutex SoftExecutor::_instance_mutex;
+
+// executor and deque index of the calling thread, jobs submitted from
+// inside a job go to the own deque of the executor thread
+static thread_local SoftExecutor *current_executor = NULL;
+static thread_local uint32_t current_index = 0;
+
+class ExecutorThread
+    : public Thread
+{
+public:
+    ExecutorThread (SoftExecutor *executor, uint32_t index, const char *name)
+        : Thread (name)
+        , _executor (executor)
+        , _index (index)
+    {}
+
+protected:
+    virtual bool started () {
+        current_executor = _executor;
+        current_index = _index;
+        return true;
+    }
+    virtual bool loop () {
+        return _executor->run_once (_index);
+    }
+
+private:
+    SoftExecutor      *_executor;
+    uint32_t           _index;
+};
+
+SmartPtr<SoftExecutor>
+SoftExecutor::instance ()
+{
+    SmartLock locker (_instance_mutex);
+    if (_instance.ptr ())
+        return _instance;
+
+    SmartPtr<SoftExecutor> executor = new SoftExecutor (_default_threads);
+    XCAM_FAIL_RETURN (
+        ERROR, xcam_ret_is_ok (executor->start ()), NULL,
+        "soft executor start failed");
+    _instance = executor;
+    return _instance;
+}
+
+bool
+SoftExecutor::set_default_threads (uint32_t num)
+{
+    SmartLock locker (_instance_mutex);
+    XCAM_FAIL_RETURN (
+        ERROR, !_instance.ptr (), false,
+        "soft executor set default threads failed, executor is already running with %d threads",
+        _instance->get_threads ());
+    _default_threads = num;
+    return true;
+}
+
+SoftExecutor::SoftExecutor (uint32_t threads)
+    : _thread_count (threads)
+    , _deques (NULL)
+    , _threads (NULL)
+    , _next_deque (0)
+    , _pending (0)
+    , _sleepers (0)
+    , _running (false)
+{
+    if (!_thread_count) {
+        long cores = sysconf (_SC_NPROCESSORS_ONLN);
+        _thread_count = cores > 0 ? (uint32_t)cores : 1;
+    }
+    if (_thread_count > XCAM_SOFT_EXECUTOR_MAX_THREADS)
+        _thread_count = XCAM_SOFT_EXECUTOR_MAX_THREADS;
+
+    _deques = new Deque[_thread_count];
+    _threads = new ExecutorThread*[_thread_count];
+    for (uint32_t i = 0; i < _thread_count; ++i) {
+        char name[XCAM_MAX_STR_SIZE];
+        snprintf (name, sizeof (name), "soft-exec-%d", i);
+        _threads[i] = new ExecutorThread (this, i, name);
+    }
+}
+
+SoftExecutor::~SoftExecutor ()
+{
+    stop ();
+    for (uint32_t i = 0; i < _thread_count; ++i)
+        delete _threads[i];
+    delete [] _threads;
+    delete [] _deques;
+}
+
+XCamReturn
+SoftExecutor::start ()
+{
+    _running.store (true);
+    for (uint32_t i = 0; i < _thread_count; ++i) {
+        if (!_threads[i]->start ()) {
+            XCAM_LOG_ERROR ("soft executor start thread(%d) failed", i);
+            stop ();
+            return XCAM_RETURN_ERROR_THREAD;
+        }
+    }
+    return XCAM_RETURN_NO_ERROR;
+}
+
+XCamReturn
+SoftExecutor::stop ()
+{
+    {
+        SmartLock locker (_mutex);
+        _running.store (false);
+        _pending_cond.broadcast ();
+    }
+    for (uint32_t i = 0; i < _thread_count; ++i) {
+        _threads[i]->emit_stop ();
+    }
+    for (uint32_t i = 0; i < _thread_count; ++i) {
+        if (current_executor == this && current_index == i)
+            continue;
+        _threads[i]->stop ();
+    }
+
+    drop_pending ();
+    return XCAM_RETURN_NO_ERROR;
+}
+
+// ranges nobody will run any more, their jobs still finish exactly once
+void
+SoftExecutor::drop_pending ()
+{
+    for (uint32_t i = 0; i < _thread_count; ++i) {
+        Range range;
+        while (pop_bottom (i, range)) {
+            Job *job = range.job.ptr ();
+            int32_t expected = XCAM_RETURN_NO_ERROR;
+            job->_error.compare_exchange_strong (expected, XCAM_RETURN_ERROR_THREAD);
+            finish_items (job, range.end - range.begin);
+        }
+    }
+}
+
+XCamReturn
+SoftExecutor::submit (const SmartPtr<Job> &job)
+{
+    XCAM_ASSERT (job.ptr ());
+    XCAM_FAIL_RETURN (
+        ERROR, _running.load (), XCAM_RETURN_ERROR_THREAD,
+        "soft executor submit failed, executor stopped");
+
+    uint32_t count = job->get_count ();
+    if (!count) {
+        job->done (XCAM_RETURN_NO_ERROR);
+        return XCAM_RETURN_NO_ERROR;
+    }
+    if (!job->_grain) {
+        job->_grain = count / (_thread_count * XCAM_SOFT_EXECUTOR_CHUNKS_PER_THREAD);
+        if (!job->_grain)
+            job->_grain = 1;
+    }
+
+    uint32_t first = (current_executor == this) ?
+                     current_index : _next_deque.fetch_add (1) % _thread_count;
+    for (uint32_t i = 0; i < _thread_count; ++i) {
+        if (push_bottom ((first + i) % _thread_count, job, 0, count)) {
+            notify_pushed ();
+            // stop () may have drained the deques before the push
+            if (!_running.load ())
+                drop_pending ();
+            return XCAM_RETURN_NO_ERROR;
+        }
+    }
+
+    XCAM_LOG_WARNING ("soft executor deques are full, run job(items:%d) on caller", count);
+    run_items (job.ptr (), 0, count);
+    return XCAM_RETURN_NO_ERROR;
+}
+
+bool
+SoftExecutor::push_bottom (uint32_t index, const SmartPtr<Job> &job, uint32_t begin, uint32_t end)
+{
+    Deque &deque = _deques[index];
+    SmartLock locker (deque.mutex);
+    if (deque.bottom - deque.top >= XCAM_SOFT_EXECUTOR_DEQUE_SIZE)
+        return false;
+
+    Range &range = deque.ranges[deque.bottom % XCAM_SOFT_EXECUTOR_DEQUE_SIZE];
+    range.job = job;
+    range.begin = begin;
+    range.end = end;
+    ++deque.bottom;
+    _pending.fetch_add (1);
+    return true;
+}
+
+bool
+SoftExecutor::pop_bottom (uint32_t index, Range &range)
+{
+    Deque &deque = _deques[index];
+    SmartLock locker (deque.mutex);
+    if (deque.bottom == deque.top)
+        return false;
+
+    --deque.bottom;
+    Range &slot = deque.ranges[deque.bottom % XCAM_SOFT_EXECUTOR_DEQUE_SIZE];
+    range = slot;
+    slot.job.release ();
+    _pending.fetch_sub (1);
+    return true;
+}
+
+bool
+SoftExecutor::steal_top (uint32_t index, Range &range)
+{
+    for (uint32_t i = 1; i < _thread_count; ++i) {
+        Deque &deque = _deques[(index + i) % _thread_count];
+        SmartLock locker (deque.mutex);
+        if (deque.bottom == deque.top)
+            continue;
+
+        Range &slot = deque.ranges[deque.top % XCAM_SOFT_EXECUTOR_DEQUE_SIZE];
+        range = slot;
+        slot.job.release ();
+        ++deque.top;
+        _pending.fetch_sub (1);
+        return true;
+    }
+    return false;
+}
+
+void
+SoftExecutor::notify_pushed ()
+{
+    // pairs with the fence in run_once, either the sleeper sees the range or we see the sleeper
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    if (_sleepers.load (std::memory_order_relaxed)) {
+        SmartLock locker (_mutex);
+        _pending_cond.signal ();
+    }
+}
+
+bool
+SoftExecutor::run_once (uint32_t index)
+{
+    Range range;
+    if (pop_bottom (index, range) || steal_top (index, range)) {
+        execute (index, range);
+        return true;
+    }
+
+    SmartLock locker (_mutex);
+    _sleepers.fetch_add (1);
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    while (_running.load () && !_pending.load ())
+        _pending_cond.wait (_mutex);
+    _sleepers.fetch_sub (1);
+    return _running.load ();
+}
+
+void
+SoftExecutor::execute (uint32_t index, Range &range)
+{
+    Job *job = range.job.ptr ();
+    bool pushed = false;
+
+    while (range.end - range.begin > job->_grain) {
+        uint32_t middle = range.begin + (range.end - range.begin) / 2;
+        if (!push_bottom (index, range.job, middle, range.end))
+            break;
+        range.end = middle;
+        pushed = true;
+    }
+    if (pushed)
+        notify_pushed ();
+
+    run_items (job, range.begin, range.end);
+}
+
+void
+SoftExecutor::run_items (Job *job, uint32_t begin, uint32_t end)
+{
+    for (uint32_t i = begin; i < end; ++i) {
+        // skip the rest once any item failed
+        if (job->_error.load (std::memory_order_relaxed) != XCAM_RETURN_NO_ERROR)
+            break;
+
+        XCamReturn ret = job->run (i);
+        if (!xcam_ret_is_ok (ret)) {
+            int32_t expected = XCAM_RETURN_NO_ERROR;
+            job->_error.compare_exchange_strong (expected, ret);
+        }
+    }
+
+    finish_items (job, end - begin);
+}
+
+void
+SoftExecutor::finish_items (Job *job, uint32_t items)
+{
+    if (job->_remain.fetch_sub (items) == items)
+        job->done ((XCamReturn)job->_error.load ());
+}
+
+};
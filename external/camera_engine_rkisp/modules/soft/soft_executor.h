@@ -0,0 +1,142 @@
+/*
+ * soft_executor.h - process-wide work-stealing executor for soft workers
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_SOFT_EXECUTOR_H
+#define XCAM_SOFT_EXECUTOR_H
+
+#include <xcam_std.h>
+#include <xcam_mutex.h>
+
+#define XCAM_SOFT_EXECUTOR_MAX_THREADS 64
+#define XCAM_SOFT_EXECUTOR_DEQUE_SIZE  256
+
+namespace XCam {
+
+class ExecutorThread;
+
+/*
+ * One executor thread per online core, each owning a deque of item ranges.
+ * A thread pops ranges from the bottom of its own deque; a range larger than
+ * the job grain is split in half and the upper half pushed back, so idle
+ * threads can steal the biggest pending ranges from the top of other deques.
+ * A job costs one allocation, no matter how many items it has.
+ */
+class SoftExecutor
+    : public RefObj
+{
+    friend class ExecutorThread;
+
+public:
+    class Job
+        : public RefObj
+    {
+        friend class SoftExecutor;
+    public:
+        // @grain, max items run in one chunk, 0 to let the executor decide
+        explicit Job (uint32_t count, uint32_t grain = 0)
+            : _count (count)
+            , _grain (grain)
+            , _remain (count)
+            , _error (XCAM_RETURN_NO_ERROR)
+        {}
+        virtual ~Job () {}
+        uint32_t get_count () const {
+            return _count;
+        }
+
+        virtual XCamReturn run (uint32_t item) = 0;
+        // called once, by the thread finishing the last item; items dropped by
+        // stop () are never run and make it XCAM_RETURN_ERROR_THREAD
+        virtual void done (XCamReturn err) = 0;
+
+    private:
+        XCAM_DEAD_COPY (Job);
+
+    private:
+        uint32_t                 _count;
+        uint32_t                 _grain;
+        std::atomic<uint32_t>    _remain;
+        std::atomic<int32_t>     _error;
+    };
+
+public:
+    // shared by all soft workers, started on first use
+    static SmartPtr<SoftExecutor> instance ();
+    // only effective before instance() is first called, 0 means one thread per online core
+    static bool set_default_threads (uint32_t num);
+
+    explicit SoftExecutor (uint32_t threads = 0);
+    virtual ~SoftExecutor ();
+
+    XCamReturn start ();
+    XCamReturn stop ();
+    uint32_t get_threads () const {
+        return _thread_count;
+    }
+
+    XCamReturn submit (const SmartPtr<Job> &job);
+
+private:
+    struct Range {
+        SmartPtr<Job>     job;
+        uint32_t          begin;
+        uint32_t          end;
+    };
+
+    struct Deque {
+        Mutex             mutex;
+        uint32_t          top;
+        uint32_t          bottom;
+        Range             ranges[XCAM_SOFT_EXECUTOR_DEQUE_SIZE];
+
+        Deque () : top (0), bottom (0) {}
+    };
+
+    bool push_bottom (uint32_t index, const SmartPtr<Job> &job, uint32_t begin, uint32_t end);
+    bool pop_bottom (uint32_t index, Range &range);
+    bool steal_top (uint32_t index, Range &range);
+    void notify_pushed ();
+
+    bool run_once (uint32_t index);
+    void execute (uint32_t index, Range &range);
+    void run_items (Job *job, uint32_t begin, uint32_t end);
+    void finish_items (Job *job, uint32_t items);
+    void drop_pending ();
+
+    XCAM_DEAD_COPY (SoftExecutor);
+
+private:
+    uint32_t                  _thread_count;
+    Deque                    *_deques;
+    ExecutorThread          **_threads;
+    std::atomic<uint32_t>     _next_deque;
+    std::atomic<uint32_t>     _pending;
+    std::atomic<uint32_t>     _sleepers;
+    std::atomic<bool>         _running;
+    Mutex                     _mutex;
+    XCam::Cond                _pending_cond;
+
+    static uint32_t           _default_threads;
+    static SmartPtr<SoftExecutor> _instance;
+    static Mutex              _instance_mutex;
+};
+
+};
+
+#endif //XCAM_SOFT_EXECUTOR_H
@@ -19,90 +19,56 @@
  */
 
 #include "soft_worker.h"
-#include "thread_pool.h"
+#include "soft_executor.h"
 #include "xcam_mutex.h"
 
 namespace XCam {
 
-class ItemSynch {
-private:
-    mutable std::atomic<uint32_t>  _remain_items;
-    Mutex                          _mutex;
-    XCamReturn                     _error;
-
-public:
-    ItemSynch (uint32_t items)
-        : _remain_items(items), _error (XCAM_RETURN_NO_ERROR)
-    {}
-    void update_error (XCamReturn err) {
-        SmartLock locker(_mutex);
-        _error = err;
-    }
-    XCamReturn get_error () {
-        SmartLock locker(_mutex);
-        return _error;
-    }
-    uint32_t dec() {
-        return --_remain_items;
-    }
-
-private:
-    XCAM_DEAD_COPY (ItemSynch);
-};
-
-class WorkItem
-    : public ThreadPool::UserData
+class WorkJob
+    : public SoftExecutor::Job
 {
 public:
-    WorkItem (
+    WorkJob (
         const SmartPtr<SoftWorker> &worker,
         const SmartPtr<Worker::Arguments> &args,
-        const WorkSize &item,
-        SmartPtr<ItemSynch> &sync)
-        : _worker (worker)
+        const WorkSize &items)
+        : SoftExecutor::Job (items.value[0] * items.value[1] * items.value[2])
+        , _worker (worker)
         , _args (args)
-        , _item (item)
-        , _sync (sync)
+        , _items (items)
     {
     }
-    virtual XCamReturn run ();
+    virtual XCamReturn run (uint32_t item);
     virtual void done (XCamReturn err);
 
-
 private:
     SmartPtr<SoftWorker>         _worker;
     SmartPtr<Worker::Arguments>  _args;
-    WorkSize                     _item;
-    SmartPtr<ItemSynch>          _sync;
+    WorkSize                     _items;
 };
 
 XCamReturn
-WorkItem::run ()
+WorkJob::run (uint32_t item)
 {
-    XCamReturn ret = _sync->get_error();
-    if (!xcam_ret_is_ok (ret))
-        return ret;
-
-    ret = _worker->work_impl (_args, _item);
-    if (!xcam_ret_is_ok (ret))
-        _sync->update_error (ret);
+    uint32_t plane = _items.value[0] * _items.value[1];
+    WorkSize pos (
+        item % _items.value[0],
+        item % plane / _items.value[0],
+        item / plane);
 
-    return ret;
+    return _worker->work_impl (_args, pos);
 }
 
 void
-WorkItem::done (XCamReturn err)
+WorkJob::done (XCamReturn err)
 {
-    if (_sync->dec () == 0) {
-        XCamReturn ret = _sync->get_error ();
-        if (xcam_ret_is_ok (ret))
-            ret = err;
-        _worker->all_items_done (_args, ret);
-    }
+    _worker->all_items_done (_args, err);
+    _worker->job_finished ();
 }
 
 SoftWorker::SoftWorker (const char *name, const SmartPtr<Callback> &cb)
     : Worker (name, cb)
+    , _running_jobs (0)
     , _global (1, 1, 1)
     , _local (1, 1, 1)
     , _work_unit (1, 1, 1)
@@ -127,12 +93,12 @@ SoftWorker::set_work_uint (uint32_t x, uint32_t y, uint32_t z)
 }
 
 bool
-SoftWorker::set_threads (const SmartPtr<ThreadPool> &threads)
+SoftWorker::set_executor (const SmartPtr<SoftExecutor> &executor)
 {
     XCAM_FAIL_RETURN (
-        ERROR, !_threads.ptr (), false,
-        "SoftWorker(%s) set threads failed, it's already set before.", XCAM_STR (get_name ()));
-    _threads = threads;
+        ERROR, !_executor.ptr (), false,
+        "SoftWorker(%s) set executor failed, it's already set before.", XCAM_STR (get_name ()));
+    _executor = executor;
     return true;
 }
 
@@ -163,7 +129,10 @@ SoftWorker::set_local_size (const WorkSize &size)
 XCamReturn
 SoftWorker::stop ()
 {
-    _threads->stop ();
+    // the executor is shared, only wait for the jobs of this worker
+    SmartLock locker (_jobs_mutex);
+    while (_running_jobs)
+        _jobs_cond.wait (_jobs_mutex);
     return XCAM_RETURN_NO_ERROR;
 }
 
@@ -193,37 +162,26 @@ SoftWorker::work (const SmartPtr<Worker::Arguments> &args)
         return ret;
     }
 
-    if (!_threads.ptr ()) {
-        char thr_name [XCAM_MAX_STR_SIZE];
-        snprintf (thr_name, XCAM_MAX_STR_SIZE, "%s-thrs", XCAM_STR(get_name ()));
-
-        SmartPtr<ThreadPool> threads = new ThreadPool (thr_name);
-        XCAM_ASSERT (threads.ptr ());
-        _threads = threads;
-        _threads->set_threads (max_items, max_items + 1); //extra thread to process all_items_done
-        ret = _threads->start ();
+    if (!_executor.ptr ()) {
+        _executor = SoftExecutor::instance ();
         XCAM_FAIL_RETURN (
-            ERROR, xcam_ret_is_ok (ret), ret,
-            "SoftWorker(%s) work failed when starting threads", XCAM_STR(get_name()));
+            ERROR, _executor.ptr (), XCAM_RETURN_ERROR_THREAD,
+            "SoftWorker(%s) work failed, no executor", XCAM_STR(get_name()));
     }
 
-    SmartPtr<ItemSynch> sync = new ItemSynch (max_items);
-    for (uint32_t z = 0; z < items.value[2]; ++z)
-        for (uint32_t y = 0; y < items.value[1]; ++y)
-            for (uint32_t x = 0; x < items.value[0]; ++x)
-            {
-                SmartPtr<WorkItem> item = new WorkItem (this, args, WorkSize(x, y, z), sync);
-                ret = _threads->queue (item);
-                if (!xcam_ret_is_ok (ret)) {
-                    //consider half queued but half failed
-                    sync->update_error (ret);
-                    //status_check (args, ret); // need it here?
-                    XCAM_LOG_ERROR (
-                        "SoftWorker(%s) queue work item(x:%d y: %d z:%d) failed",
-                        XCAM_STR(get_name()), x, y, z);
-                    return ret;
-                }
-            }
+    {
+        SmartLock locker (_jobs_mutex);
+        ++_running_jobs;
+    }
+    SmartPtr<WorkJob> job = new WorkJob (this, args, items);
+    ret = _executor->submit (job);
+    if (!xcam_ret_is_ok (ret)) {
+        job_finished ();
+        XCAM_LOG_ERROR (
+            "SoftWorker(%s) submit work job(items:%d) failed",
+            XCAM_STR(get_name()), max_items);
+        return ret;
+    }
 
     return XCAM_RETURN_NO_ERROR;
 }
@@ -234,6 +192,15 @@ SoftWorker::all_items_done (const SmartPtr<Arguments> &args, XCamReturn error)
     status_check (args, error);
 }
 
+void
+SoftWorker::job_finished ()
+{
+    SmartLock locker (_jobs_mutex);
+    XCAM_ASSERT (_running_jobs);
+    if (--_running_jobs == 0)
+        _jobs_cond.broadcast ();
+}
+
 WorkRange
 SoftWorker::get_range (const WorkSize &item)
 {
@@ -23,12 +23,13 @@
 
 #include <xcam_std.h>
 #include <worker.h>
+#include <xcam_mutex.h>
 
 #define SOFT_MAX_DIM 3
 
 namespace XCam {
 
-class ThreadPool;
+class SoftExecutor;
 
 struct WorkRange {
     uint32_t pos[SOFT_MAX_DIM];
@@ -53,7 +54,7 @@ struct WorkSize {
 class SoftWorker
     : public Worker
 {
-    friend class WorkItem;
+    friend class WorkJob;
 
 public:
     explicit SoftWorker (const char *name, const SmartPtr<Callback> &cb = NULL);
@@ -64,7 +65,8 @@ public:
         return _work_unit;
     }
 
-    bool set_threads (const SmartPtr<ThreadPool> &threads);
+    // workers share SoftExecutor::instance () unless another executor is set
+    bool set_executor (const SmartPtr<SoftExecutor> &executor);
     bool set_global_size (const WorkSize &size);
     const WorkSize &get_global_size () const {
         return _global;
@@ -86,11 +88,15 @@ private:
 
     XCamReturn work_impl (const SmartPtr<Arguments> &args, const WorkSize &item);
     void all_items_done (const SmartPtr<Arguments> &args, XCamReturn error);
+    void job_finished ();
 
     XCAM_DEAD_COPY (SoftWorker);
 
 private:
-    SmartPtr<ThreadPool>    _threads;
+    SmartPtr<SoftExecutor>  _executor;
+    uint32_t                _running_jobs;
+    Mutex                   _jobs_mutex;
+    XCam::Cond              _jobs_cond;
     WorkSize                _global;
     WorkSize                _local;
     WorkSize                _work_unit;
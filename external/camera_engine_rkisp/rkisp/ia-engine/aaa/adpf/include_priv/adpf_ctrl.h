@@ -58,6 +58,41 @@ typedef enum AdpfState_e {
 
 
 
+#define ADPF_LUT_SIZE           256         /**< gain samples per light mode */
+#define ADPF_LUT_GAIN_MAX       64.0f       /**< upper end of the sampled gain axis */
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   Gain dependent ADPF outputs at one sample of the gain axis.
+ */
+/*****************************************************************************/
+typedef struct AdpfLutEntry_s {
+  CamerIcDpfInvStrength_t         DynInvStrength;
+  uint8_t                         demosaic_th;
+  uint16_t                        Dsp3DnrNode;        /**< node of the 3DNR setting curves */
+  CamerIcIspFltDeNoiseLevel_t     denoise_level;
+  CamerIcIspFltSharpeningLevel_t  sharp_level;
+} AdpfLutEntry_t;
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   ADPF outputs of one light mode sampled over the sensor gain
+ *          from 1.0 to fGainMax.
+ */
+/*****************************************************************************/
+typedef struct AdpfLut_s {
+  bool_t                          valid;              /**< else the curves are evaluated */
+  float                           fGainMax;           /**< gain of the last sample */
+  float                           fScale;             /**< samples per gain unit */
+  AdpfLutEntry_t                  Entries[ADPF_LUT_SIZE];
+} AdpfLut_t;
+
+
+
 /*****************************************************************************/
 /**
  * @brief   Context of the ADPF module.
@@ -102,6 +137,9 @@ typedef struct AdpfContext_s {
 
   enum LIGHT_MODE LightMode;
 
+  AdpfLut_t Lut[LIGHT_MODE_MAX];
+  int32_t Dsp3DnrNode;                                /**< node of Dsp3DnrResult, -1 if unknown */
+
 } AdpfContext_t;
 
 
@@ -18,9 +18,9 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
-//#include <ebase/utl_fixfloat.h>
 #include <ebase/types.h>
 #include <ebase/builtins.h>
+#include <ebase/utl_fixfloat.h>
 
 #include <common/return_codes.h>
 #include <common/misc.h>
@@ -37,65 +37,9 @@
 #define DSP_3DNR_MIN_LEVEL      (1)
 #define DSP_3DNR_MAX_LEVEL      (32)
 
+/* blend the strength between the two gain samples around the sensor gain */
+#define ADPF_LUT_BLEND_STRENGTH (1)
 
-#define UTL_FIX_MASK_U0800       0x0ff
-#define UTL_FIX_MAX_U0800        255.499f //exactly this would be < 256 - 0.5
-#define UTL_FIX_MIN_U0800          0.0f
-
-
-static uint32_t UtlFloatToFix_U0800(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_U0800);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_U0800);
-
-  // precision is 1, thus no multiplication is required
-
-  // round
-  // no handling of negative values required
-  ulFix = (uint32_t)(fFloat + 0.5f);
-
-  //no masking of upper bits required
-
-  return ulFix;
-}
-
-#define UTL_FIX_PRECISION_U0408  256.0f
-#define UTL_FIX_MASK_U0408       0xfff
-#define UTL_FIX_MAX_U0408          15.998f //exactly this would be < 16 - 0.5/256
-#define UTL_FIX_MIN_U0408          0.0f
-
-static uint32_t UtlFloatToFix_U0408(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_U0408);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_U0408);
-
-  fFloat *= UTL_FIX_PRECISION_U0408;
-
-  // round
-  // no handling of negative values required
-  ulFix = (uint32_t)(fFloat + 0.5f);
-
-  //no masking of upper bits required
-
-  return ulFix;
-}
-
-static float UtlFixToFloat_U0408(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x0fff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_U0408) == 0);
-
-  // precision is not cut away here, so no rounding is necessary
-  // no handling of negative values required
-  fFloat = (float)ulFix;
-
-  fFloat /= UTL_FIX_PRECISION_U0408;
-
-  return fFloat;
-}
 
 /*****************************************************************************/
 /**
@@ -401,7 +345,8 @@ static RESULT AdpfCalculateSpatialWeights
   (void) pAdpfCtx;
 
   double dSigmaSqr = 0.0f;
-  float fExpResult = 0.0f;
+  float fExpResult[CAMERIC_DPF_MAX_SPATIAL_COEFFS];
+  uint32_t ulWeight[CAMERIC_DPF_MAX_SPATIAL_COEFFS];
   uint32_t i       = 0UL;
 
   uint32_t sqr1    = 0UL;
@@ -418,23 +363,29 @@ static RESULT AdpfCalculateSpatialWeights
   // spatial weights for green channel
   dSigmaSqr = (double)(sqr1);
   for (i = 0UL; i < CAMERIC_DPF_MAX_SPATIAL_COEFFS; i++) {
-    fExpResult = (float)(16.0f * exp(-1.0f * (double)fSpatialRadiusSqrG[i] / (2.0f * dSigmaSqr)));
-    if (fExpResult > 16.0f) {
+    fExpResult[i] = (float)(16.0f * exp(-1.0f * (double)fSpatialRadiusSqrG[i] / (2.0f * dSigmaSqr)));
+    if (fExpResult[i] > 16.0f) {
       // clip to max value
-      fExpResult = 16.0f;
+      fExpResult[i] = 16.0f;
     }
-    pSpatialG->WeightCoeff[i] = (uint8_t)UtlFloatToFix_U0800(fExpResult);
+  }
+  UtlFloatToFixArray(UTL_FIX_U0800, fExpResult, ulWeight, CAMERIC_DPF_MAX_SPATIAL_COEFFS);
+  for (i = 0UL; i < CAMERIC_DPF_MAX_SPATIAL_COEFFS; i++) {
+    pSpatialG->WeightCoeff[i] = (uint8_t)ulWeight[i];
   }
 
   // spatial weights for red/blue channel
   dSigmaSqr = (double)(sqr2);
   for (i = 0UL; i < CAMERIC_DPF_MAX_SPATIAL_COEFFS; i++) {
-    fExpResult = (float)(16.0f * exp(-1.0f * (double)fSpatialRadiusSqrRB[i] / (2.0f * dSigmaSqr)));
-    if (fExpResult > 16.0f) {
+    fExpResult[i] = (float)(16.0f * exp(-1.0f * (double)fSpatialRadiusSqrRB[i] / (2.0f * dSigmaSqr)));
+    if (fExpResult[i] > 16.0f) {
       // clip to max value
-      fExpResult = 16.0f;
+      fExpResult[i] = 16.0f;
     }
-    pSpatialRB->WeightCoeff[i] = (uint8_t)UtlFloatToFix_U0800(fExpResult);
+  }
+  UtlFloatToFixArray(UTL_FIX_U0800, fExpResult, ulWeight, CAMERIC_DPF_MAX_SPATIAL_COEFFS);
+  for (i = 0UL; i < CAMERIC_DPF_MAX_SPATIAL_COEFFS; i++) {
+    pSpatialRB->WeightCoeff[i] = (uint8_t)ulWeight[i];
   }
 
   LOGV( "%s: (exit)\n", __func__);
@@ -444,6 +395,61 @@ static RESULT AdpfCalculateSpatialWeights
 
 
 
+/*****************************************************************************/
+/**
+ * @brief   This local function finds the curve node nearest to the sensor
+ *          gain, the gain is clamped to the range of the curve.
+ *
+ * @param   pSensorGain     sensor gains of the curve nodes
+ * @param   ArraySize       number of curve nodes
+ * @param   fSensorGain     current sensor gain
+ *
+ * @return                  index of the nearest node
+ *
+ *****************************************************************************/
+static uint16_t AdpfFindCurveNode
+(
+    const float*            pSensorGain,
+    const uint16_t          ArraySize,
+    const float             fSensorGain
+) {
+  uint16_t n    = 0U;
+  uint16_t nMax = 0U;
+  float Dgain = fSensorGain;
+  nMax = (ArraySize - 1U);
+  /* lower range check */
+  if (Dgain < pSensorGain[0]) {
+    Dgain = pSensorGain[0];
+  }
+
+  /* upper range check */
+  if (Dgain > pSensorGain[nMax]) {
+    Dgain = pSensorGain[nMax];
+  }
+
+  /* find x area */
+  n = 0;
+  while ((n <= nMax) && (Dgain >=  pSensorGain[n])) {
+    ++n;
+  }
+  --n;
+
+  /**
+   * If n was larger than nMax, which means fSensorGain lies exactly on the
+  * last interval border, we count fSensorGain to the last interval and
+   * have to decrease n one more time */
+  if (n == nMax) {
+    --n;
+  }
+  float sub1 = ABS(pSensorGain[n] - Dgain);
+  float sub2 = ABS(pSensorGain[n + 1] - Dgain);
+  n = sub1 < sub2 ? n : n + 1;
+
+  return (n);
+}
+
+
+
 /*****************************************************************************/
 /**
  * @brief   This local function calculates the strength value.
@@ -539,9 +545,6 @@ static RESULT AdpfCalculateDenoiseLevel
     CamerIcIspFltDeNoiseLevel_t* deNoiseLevel
 ) {
   (void) pAdpfCtx;
-  uint16_t n    = 0U;
-  uint16_t nMax = 0U;
-  float Dgain = fSensorGain;//Denoise level gain
   // initial check
   if (pDenoiseLevelCurve == NULL) {
     ALOGE("%s: pDenoiseLevelCurve == NULL \n", __func__);
@@ -553,37 +556,10 @@ static RESULT AdpfCalculateDenoiseLevel
     ALOGE("%s: 222(enter)\n", __func__);
     return (RET_INVALID_PARM);
   }
-  
-  LOGV( "%s:(enter) fSensorGain(%f) size(%d)\n", __func__, fSensorGain, pDenoiseLevelCurve->ArraySize);
 
-  nMax = (pDenoiseLevelCurve->ArraySize - 1U);
-  /* lower range check */
-  if (Dgain < pDenoiseLevelCurve->pSensorGain[0]) {
-    Dgain = pDenoiseLevelCurve->pSensorGain[0];
-  }
-
-  /* upper range check */
-  if (Dgain > pDenoiseLevelCurve->pSensorGain[nMax]) {
-    Dgain = pDenoiseLevelCurve->pSensorGain[nMax];
-  }
-
-  /* find x area */
-  n = 0;
-  while ((n <= nMax) && (Dgain >=  pDenoiseLevelCurve->pSensorGain[n])) {
-    ++n;
-  }
-  --n;
+  LOGV( "%s:(enter) fSensorGain(%f) size(%d)\n", __func__, fSensorGain, pDenoiseLevelCurve->ArraySize);
 
-  /**
-   * If n was larger than nMax, which means fSensorGain lies exactly on the
-  * last interval border, we count fSensorGain to the last interval and
-   * have to decrease n one more time */
-  if (n == nMax) {
-    --n;
-  }
-  float sub1 = ABS(pDenoiseLevelCurve->pSensorGain[n] - Dgain);
-  float sub2 = ABS(pDenoiseLevelCurve->pSensorGain[n + 1] - Dgain);
-  n = sub1 < sub2 ? n : n + 1;
+  uint16_t n = AdpfFindCurveNode(pDenoiseLevelCurve->pSensorGain, pDenoiseLevelCurve->ArraySize, fSensorGain);
 
   *deNoiseLevel = pDenoiseLevelCurve->pDlevel[n];
   if (*deNoiseLevel >  CAMERIC_ISP_FLT_DENOISE_LEVEL_MAX)
@@ -593,7 +569,7 @@ static RESULT AdpfCalculateDenoiseLevel
     *deNoiseLevel = CAMERIC_ISP_FLT_DENOISE_LEVEL_INVALID + 1;
 
   *deNoiseLevel = *deNoiseLevel - 1;
-  LOGV( "%s: gain=%f,dLelvel=%d\n", __func__, Dgain, *deNoiseLevel);
+  LOGV( "%s: gain=%f,dLelvel=%d\n", __func__, fSensorGain, *deNoiseLevel);
   LOGV( "%s: (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -634,37 +610,7 @@ static RESULT AdpfCalculateSharpeningLevel
     ALOGE("%s: fSensorGain  < 1.0f  \n", __func__);
     return (RET_INVALID_PARM);
   }
-  uint16_t n    = 0U;
-  uint16_t nMax = 0U;
-  float Dgain = fSensorGain;//sharping level gain
-  nMax = (pSharpeningLevelCurve->ArraySize - 1U);
-  /* lower range check */
-  if (Dgain < pSharpeningLevelCurve->pSensorGain[0]) {
-    Dgain = pSharpeningLevelCurve->pSensorGain[0];
-  }
-
-  /* upper range check */
-  if (Dgain > pSharpeningLevelCurve->pSensorGain[nMax]) {
-    Dgain = pSharpeningLevelCurve->pSensorGain[nMax];
-  }
-
-  /* find x area */
-  n = 0;
-  while ((n <= nMax) && (Dgain >=  pSharpeningLevelCurve->pSensorGain[n])) {
-    ++n;
-  }
-  --n;
-
-  /**
-   * If n was larger than nMax, which means fSensorGain lies exactly on the
-  * last interval border, we count fSensorGain to the last interval and
-   * have to decrease n one more time */
-  if (n == nMax) {
-    --n;
-  }
-  float sub1 = ABS(pSharpeningLevelCurve->pSensorGain[n] - Dgain);
-  float sub2 = ABS(pSharpeningLevelCurve->pSensorGain[n + 1] - Dgain);
-  n = sub1 < sub2 ? n : n + 1;
+  uint16_t n = AdpfFindCurveNode(pSharpeningLevelCurve->pSensorGain, pSharpeningLevelCurve->ArraySize, fSensorGain);
 
   *sharpeningLevel  = pSharpeningLevelCurve->pSlevel[n];
   if (*sharpeningLevel >  CAMERIC_ISP_FLT_SHARPENING_LEVEL_MAX)
@@ -674,7 +620,7 @@ static RESULT AdpfCalculateSharpeningLevel
     *sharpeningLevel = CAMERIC_ISP_FLT_SHARPENING_LEVEL_INVALID + 1;
 
   *sharpeningLevel = *sharpeningLevel - 1;
-  LOGV( "%s: gain=%f,sLelvel=%d\n", __func__, Dgain, *sharpeningLevel);
+  LOGV( "%s: gain=%f,sLelvel=%d\n", __func__, fSensorGain, *sharpeningLevel);
   LOGV( "%s: (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -701,52 +647,22 @@ static RESULT AdpfCalculateDemosaicThLevel
     ALOGE("%s: fSensorGain  < 1.0f  \n", __func__);
     return (RET_INVALID_PARM);
   }
-  uint16_t n    = 0U;
-  uint16_t nMax = 0U;
-  float Dgain = fSensorGain;//sharping level gain
-  nMax = (pDemosaicThCurve->ArraySize - 1U);
-  /* lower range check */
-  if (Dgain < pDemosaicThCurve->pSensorGain[0]) {
-    Dgain = pDemosaicThCurve->pSensorGain[0];
-  }
-
-  /* upper range check */
-  if (Dgain > pDemosaicThCurve->pSensorGain[nMax]) {
-    Dgain = pDemosaicThCurve->pSensorGain[nMax];
-  }
-
-  /* find x area */
-  n = 0;
-  while ((n <= nMax) && (Dgain >=  pDemosaicThCurve->pSensorGain[n])) {
-    ++n;
-  }
-  --n;
-
-  /**
-   * If n was larger than nMax, which means fSensorGain lies exactly on the
-  * last interval border, we count fSensorGain to the last interval and
-   * have to decrease n one more time */
-  if (n == nMax) {
-    --n;
-  }
-  float sub1 = ABS(pDemosaicThCurve->pSensorGain[n] - Dgain);
-  float sub2 = ABS(pDemosaicThCurve->pSensorGain[n + 1] - Dgain);
-  n = sub1 < sub2 ? n : n + 1;
+  uint16_t n = AdpfFindCurveNode(pDemosaicThCurve->pSensorGain, pDemosaicThCurve->ArraySize, fSensorGain);
 
   *demosaic_th_level  = pDemosaicThCurve->pThlevel[n];
 
-  LOGV( "%s: gain=%f,demosaic_th=%d\n", __func__, Dgain, *demosaic_th_level);
+  LOGV( "%s: gain=%f,demosaic_th=%d\n", __func__, fSensorGain, *demosaic_th_level);
   LOGV( "%s: (exit)\n", __func__);
 
   return (RET_SUCCESS);
 }
 
 
-static RESULT AdpfCalculate3DNRResult(
+static RESULT AdpfCalculate3DNRNode(
     AdpfContext_t*           pAdpfCtx,
     const float             fSensorGain,
     CamDsp3DNRSettingProfile_t* pCamDsp3DNRSettingProfile,
-    Dsp3DnrResult_t*     pDsp3DNRResult
+    uint16_t*               pNode
 ) {
   (void) pAdpfCtx;
   CamDsp3DNRLumaSetting_t *pLumaSetting = &pCamDsp3DNRSettingProfile->sLumaSetting;
@@ -779,38 +695,28 @@ static RESULT AdpfCalculate3DNRResult(
 	}
   }
   
-  uint16_t n    = 0U;
-  uint16_t nMax = 0U;
-  float Dgain = fSensorGain;
-  nMax = (pCamDsp3DNRSettingProfile->ArraySize - 1U);
-  /* lower range check */
-  if (Dgain < pCamDsp3DNRSettingProfile->pgain_Level[0]) {
-    Dgain = pCamDsp3DNRSettingProfile->pgain_Level[0];
-  }
+  *pNode = AdpfFindCurveNode(pCamDsp3DNRSettingProfile->pgain_Level, (uint16_t)pCamDsp3DNRSettingProfile->ArraySize, fSensorGain);
 
-  /* upper range check */
-  if (Dgain > pCamDsp3DNRSettingProfile->pgain_Level[nMax]) {
-    Dgain = pCamDsp3DNRSettingProfile->pgain_Level[nMax];
-  }
+  LOGV( "%s: (exit)\n", __func__);
 
-  /* find x area */
-  n = 0;
-  while ((n <= nMax) && (Dgain >=  pCamDsp3DNRSettingProfile->pgain_Level[n])) {
-    ++n;
-  }
-  --n;
+  return (RET_SUCCESS);
+}
 
-  /**
-   * If n was larger than nMax, which means fSensorGain lies exactly on the
-  * last interval border, we count fSensorGain to the last interval and
-   * have to decrease n one more time */
-  if (n == nMax) {
-    --n;
-  }
 
-  float sub1 = ABS(pCamDsp3DNRSettingProfile->pgain_Level[n] - Dgain);
-  float sub2 = ABS(pCamDsp3DNRSettingProfile->pgain_Level[n + 1] - Dgain);
-  n = sub1 < sub2 ? n : n + 1;
+/*****************************************************************************/
+/**
+ * @brief   This local function fills the 3DNR result from one node of the
+ *          3DNR setting curves.
+ *
+ *****************************************************************************/
+static void AdpfFill3DNRResult(
+    CamDsp3DNRSettingProfile_t* pCamDsp3DNRSettingProfile,
+    const uint16_t          n,
+    Dsp3DnrResult_t*     pDsp3DNRResult
+) {
+  CamDsp3DNRLumaSetting_t *pLumaSetting = &pCamDsp3DNRSettingProfile->sLumaSetting;
+  CamDsp3DNRChrmSetting_t *pChrmSetting = &pCamDsp3DNRSettingProfile->sChrmSetting;
+  CamDsp3DNRShpSetting_t *pSharpSetting = &pCamDsp3DNRSettingProfile->sSharpSetting;
 
   pDsp3DNRResult->noise_coef_num = pCamDsp3DNRSettingProfile->pnoise_coef_numerator[n];
   pDsp3DNRResult->noise_coef_den= pCamDsp3DNRSettingProfile->pnoise_coef_denominator[n];
@@ -886,18 +792,180 @@ static RESULT AdpfCalculate3DNRResult(
   						  | ((pSharpSetting->psrc_shp_weight[22][n]&0x3f)<<12) | ((pSharpSetting->psrc_shp_weight[23][n]&0x3f)<<6)
   						  | ((pSharpSetting->psrc_shp_weight[24][n]&0x3f));
 
-  LOGV( "%s: oyyf gain=%f, n=%d, luma_sp:%d luma_te:%d chrm_sp:%d chrm_te:%d shp:%d noise:num(%d) den(%d)\n", 
-  		__func__, Dgain, n,
+  LOGV( "%s: oyyf n=%d, luma_sp:%d luma_te:%d chrm_sp:%d chrm_te:%d shp:%d noise:num(%d) den(%d)\n", 
+  		__func__, n,
         pDsp3DNRResult->luma_sp_nr_level, pDsp3DNRResult->luma_te_nr_level, 
         pDsp3DNRResult->chrm_sp_nr_level, pDsp3DNRResult->chrm_te_nr_level, pDsp3DNRResult->shp_level,
         pDsp3DNRResult->noise_coef_num, pDsp3DNRResult->noise_coef_den);
-	 
-  LOGV( "%s: (exit)\n", __func__);
+}
+
+
+static RESULT AdpfCalculate3DNRResult(
+    AdpfContext_t*           pAdpfCtx,
+    const float             fSensorGain,
+    CamDsp3DNRSettingProfile_t* pCamDsp3DNRSettingProfile,
+    Dsp3DnrResult_t*     pDsp3DNRResult
+) {
+  RESULT result;
+  uint16_t n;
+
+  result = AdpfCalculate3DNRNode(pAdpfCtx, fSensorGain, pCamDsp3DNRSettingProfile, &n);
+  RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+
+  AdpfFill3DNRResult(pCamDsp3DNRSettingProfile, n, pDsp3DNRResult);
 
   return (RET_SUCCESS);
 }
 
 
+/*****************************************************************************/
+/**
+ * @brief   This local function samples the gain dependent outputs of one
+ *          light mode over the sensor gain, AdpfRun then looks them up
+ *          instead of evaluating the calibration curves.
+ *
+ * @param   pAdpfCtx        adpf context
+ * @param   mode            strength control mode
+ * @param   LightMode       light mode to sample
+ * @param   pLut            resulted table
+
+ * @return                  Return the result of the function call.
+ * @retval  RET_SUCCESS     function succeed
+ * @retval  RET_NOTSUPP     a curve can not be sampled, the light mode runs
+ *                          on the curves
+ *
+ *****************************************************************************/
+static RESULT AdpfBuildLut
+(
+    AdpfContext_t*           pAdpfCtx,
+    const AdpfMode_t         mode,
+    const enum LIGHT_MODE    LightMode,
+    AdpfLut_t*               pLut
+) {
+  CamFilterProfile_t* pFilterProfile = &pAdpfCtx->FilterProfile[LightMode];
+  CamDsp3DNRSettingProfile_t* pDsp3DNRSettingProfile = &pAdpfCtx->Dsp3DNRSettingProfile[LightMode];
+  bool_t useStrength = (pAdpfCtx->ADPFEnable && (mode == ADPF_MODE_CONTROL_BY_GAIN)) ? BOOL_TRUE : BOOL_FALSE;
+  bool_t useFilter = (pFilterProfile->FilterEnable >= 1.0) ? BOOL_TRUE : BOOL_FALSE;
+  bool_t use3Dnr = (pAdpfCtx->Dsp3DnrResult.Enable == 1) ? BOOL_TRUE : BOOL_FALSE;
+  float fGainMax = 1.0f;
+  RESULT result;
+  uint16_t n;
+
+  LOGV( "%s: (enter)\n", __func__);
+
+  pLut->valid = BOOL_FALSE;
+
+  // the axis ends where every sampled output is constant
+  if (useStrength == BOOL_TRUE) {
+    if (pAdpfCtx->fGradient < 0.0f) {
+      return (RET_NOTSUPP);
+    }
+    if ((pAdpfCtx->fGradient > 0.0f) && (pAdpfCtx->fMin > pAdpfCtx->fOffset)) {
+      fGainMax = MAX(fGainMax, (pAdpfCtx->fMin - pAdpfCtx->fOffset) * (pAdpfCtx->fMin - pAdpfCtx->fOffset)
+                     / pAdpfCtx->fGradient);
+    }
+  }
+
+  if (useFilter == BOOL_TRUE) {
+    if ((pFilterProfile->DenoiseLevelCurve.ArraySize < 2U)
+        || (pFilterProfile->SharpeningLevelCurve.ArraySize < 2U)
+        || (pFilterProfile->DemosaicThCurve.ArraySize < 2U)) {
+      return (RET_NOTSUPP);
+    }
+    fGainMax = MAX(fGainMax, pFilterProfile->DenoiseLevelCurve.pSensorGain[pFilterProfile->DenoiseLevelCurve.ArraySize - 1U]);
+    fGainMax = MAX(fGainMax, pFilterProfile->SharpeningLevelCurve.pSensorGain[pFilterProfile->SharpeningLevelCurve.ArraySize - 1U]);
+    fGainMax = MAX(fGainMax, pFilterProfile->DemosaicThCurve.pSensorGain[pFilterProfile->DemosaicThCurve.ArraySize - 1U]);
+  }
+
+  if (use3Dnr == BOOL_TRUE) {
+    if ((pDsp3DNRSettingProfile->ArraySize < 2)
+        || (AdpfCalculate3DNRNode(pAdpfCtx, 1.0f, pDsp3DNRSettingProfile, &n) != RET_SUCCESS)) {
+      return (RET_NOTSUPP);
+    }
+    fGainMax = MAX(fGainMax, pDsp3DNRSettingProfile->pgain_Level[pDsp3DNRSettingProfile->ArraySize - 1]);
+  }
+
+  // a gain past the axis is evaluated on the curves
+  fGainMax = MIN(fGainMax, ADPF_LUT_GAIN_MAX);
+  fGainMax = MAX(fGainMax, 2.0f);
+
+  pLut->fGainMax = fGainMax;
+  pLut->fScale = (float)(ADPF_LUT_SIZE - 1) / (fGainMax - 1.0f);
+
+  for (int32_t i = 0; i < ADPF_LUT_SIZE; i++) {
+    AdpfLutEntry_t* pEntry = &pLut->Entries[i];
+    float fGain = 1.0f + (float)i / pLut->fScale;
+
+    MEMSET(pEntry, 0, sizeof(*pEntry));
+
+    if (useStrength == BOOL_TRUE) {
+      result = AdpfCalculateStrength(pAdpfCtx, fGain, pAdpfCtx->fGradient, pAdpfCtx->fOffset,
+                                     pAdpfCtx->fMin, pAdpfCtx->fDiv, &pEntry->DynInvStrength);
+      RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+    }
+
+    if (useFilter == BOOL_TRUE) {
+      result = AdpfCalculateDenoiseLevel(pAdpfCtx, fGain, &pFilterProfile->DenoiseLevelCurve, &pEntry->denoise_level);
+      RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+      result = AdpfCalculateSharpeningLevel(pAdpfCtx, fGain, &pFilterProfile->SharpeningLevelCurve, &pEntry->sharp_level);
+      RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+      result = AdpfCalculateDemosaicThLevel(pAdpfCtx, fGain, &pFilterProfile->DemosaicThCurve, &pEntry->demosaic_th);
+      RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+    }
+
+    if (use3Dnr == BOOL_TRUE) {
+      result = AdpfCalculate3DNRNode(pAdpfCtx, fGain, pDsp3DNRSettingProfile, &pEntry->Dsp3DnrNode);
+      RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+    }
+  }
+
+  pLut->valid = BOOL_TRUE;
+
+  LOGV( "%s: (exit) light mode %d up to gain %f\n", __func__, LightMode, fGainMax);
+
+  return (RET_SUCCESS);
+}
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   This local function looks up the strength at a position of the
+ *          gain axis.
+ *
+ * @param   pLut            table of the light mode
+ * @param   fPos            position on the gain axis in samples
+ * @param   pDynInvStrength resulted strength
+ *
+ *****************************************************************************/
+static void AdpfLookupStrength
+(
+    const AdpfLut_t*         pLut,
+    const float              fPos,
+    CamerIcDpfInvStrength_t* pDynInvStrength
+) {
+  uint32_t i = MIN((uint32_t)fPos, ADPF_LUT_SIZE - 1U);
+  const AdpfLutEntry_t* pLo = &pLut->Entries[i];
+
+#if ADPF_LUT_BLEND_STRENGTH
+  if (i < ADPF_LUT_SIZE - 1U) {
+    const AdpfLutEntry_t* pHi = &pLut->Entries[i + 1U];
+    float fFrac = fPos - (float)i;
+
+    pDynInvStrength->WeightR = (uint8_t)(pLo->DynInvStrength.WeightR
+                                         + (pHi->DynInvStrength.WeightR - pLo->DynInvStrength.WeightR) * fFrac + 0.5f);
+    pDynInvStrength->WeightG = (uint8_t)(pLo->DynInvStrength.WeightG
+                                         + (pHi->DynInvStrength.WeightG - pLo->DynInvStrength.WeightG) * fFrac + 0.5f);
+    pDynInvStrength->WeightB = (uint8_t)(pLo->DynInvStrength.WeightB
+                                         + (pHi->DynInvStrength.WeightB - pLo->DynInvStrength.WeightB) * fFrac + 0.5f);
+    return;
+  }
+#endif
+
+  *pDynInvStrength = pLut->Entries[MIN((uint32_t)(fPos + 0.5f), ADPF_LUT_SIZE - 1U)].DynInvStrength;
+}
+
+
 /******************************************************************************
  * AdpfApplyConfiguration()
  *****************************************************************************/
@@ -916,6 +984,9 @@ static RESULT AdpfApplyConfiguration
   // clear
   MEMSET(&DpfConfig, 0, sizeof(DpfConfig));
   MEMSET(&NfGains, 0, sizeof(NfGains));
+  for (int32_t i = 0; i < LIGHT_MODE_MAX; i++) {
+    pAdpfCtx->Lut[i].valid = BOOL_FALSE;
+  }
 
   // configuration with data from calibration database
   if (pConfig->type == ADPF_USE_CALIB_DATABASE) {
@@ -1138,6 +1209,15 @@ static RESULT AdpfApplyConfiguration
 
     pAdpfCtx->actives |= (ADPF_MASK | ADPF_STRENGTH_MASK);
   }
+
+  /* sample the gain dependent outputs, AdpfRun only looks them up */
+  pAdpfCtx->Dsp3DnrNode = -1;
+  for (int32_t i = LIGHT_MODE_DAY; i < LIGHT_MODE_MAX; i++) {
+    if (AdpfBuildLut(pAdpfCtx, pConfig->mode, (enum LIGHT_MODE)i, &pAdpfCtx->Lut[i]) != RET_SUCCESS) {
+      LOGD( "%s: light mode %d runs on the curves\n", __func__, i);
+    }
+  }
+
   /* save configuration into context */
   pAdpfCtx->Config = *pConfig;
 
@@ -1341,6 +1421,11 @@ RESULT AdpfRun
   RESULT result = RET_SUCCESS;
 
   float dgain = 0.0f; /* gain difference */
+  AdpfLut_t* pLut = NULL;
+  const AdpfLutEntry_t* pEntry = NULL;
+  float fPos = 0.0f;
+  bool_t modeChanged;
+  bool_t update;
 
   LOGV( "%s: (enter)\n", __func__);
 
@@ -1349,15 +1434,45 @@ RESULT AdpfRun
     return (RET_WRONG_HANDLE);
   }
 
+  if(LightMode <= LIGHT_MODE_MIN || LightMode >= LIGHT_MODE_MAX ){
+	ALOGW( "%s: light mode %d is wrong, so use day mode instead\n",
+         __func__, LightMode);
+	LightMode = LIGHT_MODE_DAY;
+  }
+  pAdpfCtx->pFilterProfile = &(pAdpfCtx->FilterProfile[LightMode]);
+  pAdpfCtx->pDsp3DNRSettingProfile = &(pAdpfCtx->Dsp3DNRSettingProfile[LightMode]);
+
+  /* within the sampled gains every output is a table lookup */
+  pLut = &pAdpfCtx->Lut[LightMode];
+  if ((pLut->valid == BOOL_TRUE) && (gain >= 1.0f) && (gain <= pLut->fGainMax)) {
+    fPos = (gain - 1.0f) * pLut->fScale;
+    pEntry = &pLut->Entries[MIN((int32_t)(fPos + 0.5f), ADPF_LUT_SIZE - 1)];
+  }
+
   dgain = (gain > pAdpfCtx->gain) ? (gain - pAdpfCtx->gain) : (pAdpfCtx->gain - gain);
+  modeChanged = (pAdpfCtx->LightMode != LightMode) ? BOOL_TRUE : BOOL_FALSE;
+  update = ((pEntry != NULL) || (dgain > 0.15f) || (modeChanged == BOOL_TRUE)) ? BOOL_TRUE : BOOL_FALSE;
+
   if (pAdpfCtx->ADPFEnable) {
     if (pAdpfCtx->Config.mode == ADPF_MODE_CONTROL_BY_GAIN) {
-      if (dgain > 0.15f) {
-        /* caluclate new strength */
-        result = AdpfCalculateStrength(pAdpfCtx, gain, pAdpfCtx->fGradient, pAdpfCtx->fOffset, pAdpfCtx->fMin, pAdpfCtx->fDiv, &pAdpfCtx->DynInvStrength);
-        RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+      CamerIcDpfInvStrength_t DynInvStrength;
+
+      if ((pEntry != NULL) || (dgain > 0.15f)) {
+        if (pEntry != NULL) {
+          AdpfLookupStrength(pLut, fPos, &DynInvStrength);
+        } else {
+          /* caluclate new strength */
+          result = AdpfCalculateStrength(pAdpfCtx, gain, pAdpfCtx->fGradient, pAdpfCtx->fOffset, pAdpfCtx->fMin, pAdpfCtx->fDiv, &DynInvStrength);
+          RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+        }
 
-        pAdpfCtx->actives |= (ADPF_STRENGTH_MASK);
+        /* the table path runs every frame, only a new strength is a result */
+        if ((DynInvStrength.WeightR != pAdpfCtx->DynInvStrength.WeightR)
+            || (DynInvStrength.WeightG != pAdpfCtx->DynInvStrength.WeightG)
+            || (DynInvStrength.WeightB != pAdpfCtx->DynInvStrength.WeightB)) {
+          pAdpfCtx->DynInvStrength = DynInvStrength;
+          pAdpfCtx->actives |= (ADPF_STRENGTH_MASK);
+        }
         LOGV( "%s: gain: %8.3f, %d, %d, %d", __func__,
               pAdpfCtx->gain,
               pAdpfCtx->DynInvStrength.WeightB,
@@ -1369,44 +1484,44 @@ RESULT AdpfRun
     }
   }
 
-  if(LightMode <= LIGHT_MODE_MIN || LightMode >= LIGHT_MODE_MAX ){
-	ALOGW( "%s: light mode %d is wrong, so use day mode instead\n",
-         __func__, LightMode);
-	LightMode = LIGHT_MODE_DAY;
-  }
-  pAdpfCtx->pFilterProfile = &(pAdpfCtx->FilterProfile[LightMode]);
-  pAdpfCtx->pDsp3DNRSettingProfile = &(pAdpfCtx->Dsp3DNRSettingProfile[LightMode]);
-  
   if (pAdpfCtx->pFilterProfile->FilterEnable >= 1.0) {
-  	if (dgain > 0.15f || pAdpfCtx->LightMode != LightMode){  
-      /*caluclate denoise level     */
+    if (update == BOOL_TRUE) {
       CamerIcIspFltDeNoiseLevel_t deNoiseLevel;
-      result = AdpfCalculateDenoiseLevel(pAdpfCtx, gain, &pAdpfCtx->pFilterProfile->DenoiseLevelCurve, &deNoiseLevel);
-      RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
-  
-      /*calucate sharnping level    */
       CamerIcIspFltSharpeningLevel_t sharpningLevel;
-      result = AdpfCalculateSharpeningLevel(pAdpfCtx, gain, &pAdpfCtx->pFilterProfile->SharpeningLevelCurve, &sharpningLevel);
-      RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+      uint8_t demosaic_th;
 
-	  uint8_t demosaic_th;
-	  result = AdpfCalculateDemosaicThLevel(pAdpfCtx, gain, &pAdpfCtx->pFilterProfile->DemosaicThCurve, &demosaic_th);
-      RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
-  
-      
-      pAdpfCtx->actives |= ADPF_DENOISE_SHARP_LEVEL_MASK;
-      pAdpfCtx->denoise_level = deNoiseLevel;
-      pAdpfCtx->sharp_level = sharpningLevel;
-	  pAdpfCtx->FltEnable = BOOL_TRUE;
-     
+      if (pEntry != NULL) {
+        deNoiseLevel = pEntry->denoise_level;
+        sharpningLevel = pEntry->sharp_level;
+        demosaic_th = pEntry->demosaic_th;
+      } else {
+        /*caluclate denoise level     */
+        result = AdpfCalculateDenoiseLevel(pAdpfCtx, gain, &pAdpfCtx->pFilterProfile->DenoiseLevelCurve, &deNoiseLevel);
+        RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+
+        /*calucate sharnping level    */
+        result = AdpfCalculateSharpeningLevel(pAdpfCtx, gain, &pAdpfCtx->pFilterProfile->SharpeningLevelCurve, &sharpningLevel);
+        RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+
+        result = AdpfCalculateDemosaicThLevel(pAdpfCtx, gain, &pAdpfCtx->pFilterProfile->DemosaicThCurve, &demosaic_th);
+        RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+      }
+
+      if ((pAdpfCtx->denoise_level != deNoiseLevel) || (pAdpfCtx->sharp_level != sharpningLevel)
+          || (pAdpfCtx->FltEnable != BOOL_TRUE)) {
+        pAdpfCtx->actives |= ADPF_DENOISE_SHARP_LEVEL_MASK;
+        pAdpfCtx->denoise_level = deNoiseLevel;
+        pAdpfCtx->sharp_level = sharpningLevel;
+        pAdpfCtx->FltEnable = BOOL_TRUE;
+      }
 
 	  if(pAdpfCtx->demosaic_th != demosaic_th){
 		pAdpfCtx->actives |= ADPF_DEMOSAIC_TH_MASK;
 		pAdpfCtx->demosaic_th = demosaic_th;
 	  }
-	}  
+	}
   }else{
-  	if (dgain > 0.15f || pAdpfCtx->LightMode != LightMode){
+  	if ((update == BOOL_TRUE) && (pAdpfCtx->FltEnable != BOOL_FALSE)){
     	pAdpfCtx->actives |= ADPF_DENOISE_SHARP_LEVEL_MASK;
 		pAdpfCtx->FltEnable = BOOL_FALSE;
   	}
@@ -1414,9 +1529,17 @@ RESULT AdpfRun
 
 
   if (pAdpfCtx->Dsp3DnrResult.Enable == 1) {
-  	if (dgain > 0.15f || pAdpfCtx->LightMode != LightMode){
+    if (pEntry != NULL) {
+      /* the result only changes with the curve node */
+      if ((pEntry->Dsp3DnrNode != pAdpfCtx->Dsp3DnrNode) || (modeChanged == BOOL_TRUE)) {
+        AdpfFill3DNRResult(pAdpfCtx->pDsp3DNRSettingProfile, pEntry->Dsp3DnrNode, &pAdpfCtx->Dsp3DnrResult);
+        pAdpfCtx->Dsp3DnrNode = pEntry->Dsp3DnrNode;
+        pAdpfCtx->actives |= ADPF_DSP_3DNR_MASK;
+      }
+    } else if (update == BOOL_TRUE) {
 	    result = AdpfCalculate3DNRResult(pAdpfCtx, gain, pAdpfCtx->pDsp3DNRSettingProfile, &pAdpfCtx->Dsp3DnrResult);
 	    RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
+	    pAdpfCtx->Dsp3DnrNode = -1;
 	    pAdpfCtx->actives |= ADPF_DSP_3DNR_MASK;
 	}
   }else{
@@ -1429,7 +1552,7 @@ RESULT AdpfRun
 	pAdpfCtx->actives |= ADPF_DSP_3DNR_MASK;
   }
 
-  if (dgain > 0.15f || pAdpfCtx->LightMode != LightMode){
+  if (update == BOOL_TRUE){
   	pAdpfCtx->gain = gain;
 	pAdpfCtx->LightMode = LightMode;
   }
@@ -8,6 +8,8 @@ include $(CLEAR_VARS)
 LOCAL_SRC_FILES:=\
 	source/cam_calibdb.c\
 	source/cam_calibdb_api.c\
+	source/cam_calibdb_arena.c\
+	source/cam_calibdb_index.c\
 
 
 LOCAL_C_INCLUDES += \
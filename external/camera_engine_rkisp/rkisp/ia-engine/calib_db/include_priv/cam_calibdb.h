@@ -71,6 +71,8 @@ typedef struct CamCalibDbContext_s {
   List                        iesharpen_profile;/**< list of supported IE-SHARPEN profiles */
 
   CamCalibSystemData_t        system;
+
+  struct CamCalibDbIndex_s*   pIndex;         /**< lookup index, NULL while the lists change */
 } CamCalibDbContext_t;
 
 
@@ -0,0 +1,120 @@
+/******************************************************************************
+ *
+ * Copyright 2019, Fuzhou Rockchip Electronics Co.Ltd . All rights reserved.
+ * No part of this work may be reproduced, modified, distributed, transmitted,
+ * transcribed, or translated into any language or computer format, in any form
+ * or by any means without written permission of:
+ * Fuzhou Rockchip Electronics Co.Ltd .
+ *
+ *
+ *****************************************************************************/
+/**
+ * @file cam_calibdb_index.h
+ *
+ * @brief
+ *   Internal lookup index of the CamCalibDb lists.
+ *
+ *****************************************************************************/
+/**
+ * @defgroup cam_calibdb_index CamCalibDb index
+ * @{
+ *
+ * CamCalibDbBuildIndex flattens every list of a loaded database into an
+ * array and hashes the names and resolutions the getters search by. A
+ * getter then finds an item with one hash probe instead of a list walk.
+ * Lists are only indexed while the database is not changed, any Add, Del
+ * or Replace drops the index and the getters walk the lists again.
+ */
+#ifndef __CAM_CALIBDB_INDEX_H__
+#define __CAM_CALIBDB_INDEX_H__
+
+#include <stddef.h>
+
+#include <ebase/types.h>
+#include <common/list.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#define CAM_CALIBDB_INDEX_KEYS  2
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   Hash table of the items of one list by one key field.
+ *
+ *****************************************************************************/
+typedef struct CamCalibDbKeyIndex_s {
+  size_t    offset;         /**< of the key in the item */
+  size_t    size;           /**< of the key in the item */
+  int       isName;         /**< compared like strncmp, like memcmp otherwise */
+  uint32_t  mask;           /**< number of slots - 1 */
+  int*      pSlots;         /**< item index + 1, 0 for a free slot */
+} CamCalibDbKeyIndex_t;
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   Flattened list.
+ *
+ *****************************************************************************/
+typedef struct CamCalibDbListIndex_s {
+  const List*           pList;      /**< indexed list, NULL for a free slot */
+  int                   noItems;
+  void**                ppItems;    /**< items in list order */
+  int                   noKeys;
+  CamCalibDbKeyIndex_t  keys[CAM_CALIBDB_INDEX_KEYS];
+} CamCalibDbListIndex_t;
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   Index of all lists of a CamCalibDb instance.
+ *
+ *****************************************************************************/
+typedef struct CamCalibDbIndex_s {
+  uint32_t                mask;     /**< number of slots - 1 */
+  CamCalibDbListIndex_t*  pLists;   /**< hashed by the address of the list */
+} CamCalibDbIndex_t;
+
+
+
+struct CamCalibDbContext_s;
+
+/*****************************************************************************/
+/**
+ * @brief   Index lookups, each falls back to walking the list when the
+ *          list is not indexed.
+ *
+ *****************************************************************************/
+RESULT CamCalibDbIndexCreate(struct CamCalibDbContext_s* pCamCalibDbCtx);
+void CamCalibDbIndexRelease(struct CamCalibDbContext_s* pCamCalibDbCtx);
+
+int CamCalibDbIndexNoItems(struct CamCalibDbContext_s* pCamCalibDbCtx, List* l);
+List* CamCalibDbIndexGetItem(struct CamCalibDbContext_s* pCamCalibDbCtx, List* l, const int idx);
+List* CamCalibDbIndexSearch(struct CamCalibDbContext_s* pCamCalibDbCtx, List* l,
+                            size_t offset, size_t size, int isName, const void* key);
+
+/* first item of @l whose char array @field matches @name like strncmp */
+#define CAM_CALIBDB_INDEX_SEARCH_NAME(ctx, l, type, field, name) \
+  CamCalibDbIndexSearch((ctx), (l), offsetof(type, field), sizeof(((type*)0)->field), 1, (name))
+
+/* first item of @l whose fields @first up to @last equal the bytes at @key */
+#define CAM_CALIBDB_INDEX_SEARCH_KEY(ctx, l, type, first, last, key) \
+  CamCalibDbIndexSearch((ctx), (l), offsetof(type, first), \
+                        offsetof(type, last) + sizeof(((type*)0)->last) - offsetof(type, first), 0, (key))
+
+
+#ifdef __cplusplus
+}
+#endif
+
+/* @} cam_calibdb_index */
+
+#endif /* __CAM_CALIBDB_INDEX_H__ */
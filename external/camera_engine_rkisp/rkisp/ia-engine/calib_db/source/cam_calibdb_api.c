@@ -22,6 +22,8 @@
 
 #include "cam_calibdb_api.h"
 #include "cam_calibdb.h"
+#include "cam_calibdb_index.h"
+#include <cam_calibdb/cam_calibdb_arena.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -85,18 +87,6 @@ static int SearchResolutionByName(List* l, void* key) {
 
 
 
-/******************************************************************************
- * SearchResolutionByWidthHeight
- *****************************************************************************/
-static int SearchResolutionByWidthHeight(List* l, void* key) {
-  CamResolution_t* search = (CamResolution_t*)key;
-  CamResolution_t* res = (CamResolution_t*)l;
-
-  return (((search->width == res->width) && (search->height == res->height)) ? 1 : 0);
-}
-
-
-
 /******************************************************************************
  * SearchForEqualAwbGlobal
  *****************************************************************************/
@@ -145,27 +135,6 @@ static int SearchAwb_V10_GlobalByName(List* l, void* key) {
 
 
 
-/******************************************************************************
- * SearchAwb_V11_GlobalByResolution
- *****************************************************************************/
-static int SearchAwb_V11_GlobalByResolution(List* l, void* key) {
-  CamCalibAwb_V11_Global_t* awb = (CamCalibAwb_V11_Global_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(awb->resolution, k, sizeof(awb->resolution))) ? 1 : 0);
-}
-/******************************************************************************
- * SearchAwb_V10_GlobalByResolution
- *****************************************************************************/
-static int SearchAwb_V10_GlobalByResolution(List* l, void* key) {
-  CamCalibAwb_V10_Global_t* awb = (CamCalibAwb_V10_Global_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(awb->resolution, k, sizeof(awb->resolution))) ? 1 : 0);
-}
-
-
-
 /******************************************************************************
  * SearchForEqualEcmProfile
  *****************************************************************************/
@@ -178,18 +147,6 @@ static int SearchForEqualEcmProfile(List* l, void* key) {
 
 
 
-/******************************************************************************
- * SearchEcmProfileByName
- *****************************************************************************/
-static int SearchEcmProfileByName(List* l, void* key) {
-  CamEcmProfile_t* ecm = (CamEcmProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(ecm->name, k, sizeof(ecm->name))) ? 1 : 0);
-}
-
-
-
 /******************************************************************************
  * SearchForEqualEcmScheme
  *****************************************************************************/
@@ -202,18 +159,6 @@ static int SearchForEqualEcmScheme(List* l, void* key) {
 
 
 
-/******************************************************************************
- * SearchEcmSchemeByName
- *****************************************************************************/
-static int SearchEcmSchemeByName(List* l, void* key) {
-  CamEcmScheme_t* ecm = (CamEcmScheme_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(ecm->name, k, sizeof(ecm->name))) ? 1 : 0);
-}
-
-
-
 /******************************************************************************
  * SearchForEqualIllumination
  *****************************************************************************/
@@ -238,27 +183,6 @@ static int SearchForEqualAwb_V10_Illumination(List* l, void* key) {
 
 
 
-/******************************************************************************
- * SearchAwb_V11_IlluminationByName
- *****************************************************************************/
-static int SearchAwb_V11_IlluminationByName(List* l, void* key) {
-  CamAwb_V11_IlluProfile_t* illu = (CamAwb_V11_IlluProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(illu->name, k, sizeof(illu->name))) ? 1 : 0);
-}
-/******************************************************************************
- * SearchAwb_V10_IlluminationByName
- *****************************************************************************/
-static int SearchAwb_V10_IlluminationByName(List* l, void* key) {
-  CamAwb_V10_IlluProfile_t* illu = (CamAwb_V10_IlluProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(illu->name, k, sizeof(illu->name))) ? 1 : 0);
-}
-
-
-
 /******************************************************************************
  * SearchForEqualLscProfile
  *****************************************************************************/
@@ -294,17 +218,6 @@ static int SearchForEqualCcProfile(List* l, void* key) {
 
 
 
-/******************************************************************************
- * SearchCcProfileByName
- *****************************************************************************/
-static int SearchCcProfileByName(List* l, void* key) {
-  CamCcProfile_t* cc = (CamCcProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(cc->name, k, sizeof(cc->name))) ? 1 : 0);
-}
-
-
 /******************************************************************************
  * SearchForEqualBlsProfile
  *****************************************************************************/
@@ -317,30 +230,6 @@ static int SearchForEqualBlsProfile(List* l, void* key) {
 
 
 
-/******************************************************************************
- * SearchBlsProfileByName
- *****************************************************************************/
-static int SearchBlsProfileByName(List* l, void* key) {
-  CamBlsProfile_t* bls = (CamBlsProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(bls->name, k, sizeof(bls->name))) ? 1 : 0);
-}
-
-
-
-/******************************************************************************
- * SearchBlsProfileByResolution
- *****************************************************************************/
-static int SearchBlsProfileByResolution(List* l, void* key) {
-  CamBlsProfile_t* bls = (CamBlsProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(bls->resolution, k, sizeof(bls->resolution))) ? 1 : 0);
-}
-
-
-
 /******************************************************************************
  * SearchForEqualCacProfile
  *****************************************************************************/
@@ -353,30 +242,6 @@ static int SearchForEqualCacProfile(List* l, void* key) {
 
 
 
-/******************************************************************************
- * SearchCacProfileByName
- *****************************************************************************/
-static int SearchCacProfileByName(List* l, void* key) {
-  CamCacProfile_t* cac = (CamCacProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(cac->name, k, sizeof(cac->name))) ? 1 : 0);
-}
-
-
-
-/******************************************************************************
- * SearchCacProfileByResolution
- *****************************************************************************/
-static int SearchCacProfileByResolution(List* l, void* key) {
-  CamCacProfile_t* cac = (CamCacProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(cac->resolution, k, sizeof(cac->resolution))) ? 1 : 0);
-}
-
-
-
 /******************************************************************************
  * SearchForEqualDpfProfile
  *****************************************************************************/
@@ -400,28 +265,6 @@ static int SearchForEqualDpccProfile(List* l, void* key) {
 
 
 
-/******************************************************************************
- * SearchDpfProfileByName
- *****************************************************************************/
-static int SearchDpfProfileByName(List* l, void* key) {
-  CamDpfProfile_t* dpf = (CamDpfProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(dpf->name, k, sizeof(dpf->name))) ? 1 : 0);
-}
-
-
-
-/******************************************************************************
- * SearchDpfProfileByResolution
- *****************************************************************************/
-static int SearchDpfProfileByResolution(List* l, void* key) {
-  CamDpfProfile_t* dpf = (CamDpfProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(dpf->resolution, k, sizeof(dpf->resolution))) ? 1 : 0);
-}
-
 static int SearchForEqualNewDsp3DNRSetting(List* l, void* key) {
   CamNewDsp3DNRProfile_t* ecm = (CamNewDsp3DNRProfile_t*)l;
   CamNewDsp3DNRProfile_t* k   = (CamNewDsp3DNRProfile_t*)key;
@@ -429,12 +272,6 @@ static int SearchForEqualNewDsp3DNRSetting(List* l, void* key) {
   return ((!strncmp(ecm->name, k->name, sizeof(k->name))) ? 1 : 0);
 }
 
-static int SearchNewDsp3DNRSettingByName(List* l, void* key) {
-  CamNewDsp3DNRProfile_t* dsp3DNR = (CamNewDsp3DNRProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(dsp3DNR->name, k, sizeof(dsp3DNR->name))) ? 1 : 0);
-}
 /******************************************************************************
  * SearchForEqualEcmScheme
  *****************************************************************************/
@@ -445,13 +282,6 @@ static int SearchForEqualDsp3DNRSetting(List* l, void* key) {
   return ((!strncmp(ecm->name, k->name, sizeof(k->name))) ? 1 : 0);
 }
 
-static int SearchDsp3DNRSettingByName(List* l, void* key) {
-  CamDsp3DNRSettingProfile_t* dsp3DNR = (CamDsp3DNRSettingProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(dsp3DNR->name, k, sizeof(dsp3DNR->name))) ? 1 : 0);
-}
-
 static int SearchForEqualFilterProfile(List* l, void* key) {
   CamFilterProfile_t* ecm = (CamFilterProfile_t*)l;
   CamFilterProfile_t* k   = (CamFilterProfile_t*)key;
@@ -459,12 +289,6 @@ static int SearchForEqualFilterProfile(List* l, void* key) {
   return ((!strncmp(ecm->name, k->name, sizeof(k->name))) ? 1 : 0);
 }
 
-static int SearchFilterProfileByName(List* l, void* key) {
-  CamFilterProfile_t* filter = (CamFilterProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(filter->name, k, sizeof(filter->name))) ? 1 : 0);
-}
 static int SearchForEqualDySetpointProfile(List* l, void* key) {
   CamCalibAecDynamicSetpoint_t* pDySetpoint = (CamCalibAecDynamicSetpoint_t*)l;
   CamCalibAecDynamicSetpoint_t* k   = (CamCalibAecDynamicSetpoint_t*)key;
@@ -472,13 +296,6 @@ static int SearchForEqualDySetpointProfile(List* l, void* key) {
   return ((!strncmp(pDySetpoint->name, k->name, sizeof(k->name))) ? 1 : 0);
 }
 
-static int SearchDySetpointProfileByName(List* l, void* key) {
-  CamCalibAecDynamicSetpoint_t* pDySetpoint = (CamCalibAecDynamicSetpoint_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(pDySetpoint->name, k, sizeof(pDySetpoint->name))) ? 1 : 0);
-}
-
 static int SearchForEqualExpSeparateProfile(List* l, void* key) {
   CamCalibAecExpSeparate_t* pExpSeparate = (CamCalibAecExpSeparate_t*)l;
   CamCalibAecExpSeparate_t* k   = (CamCalibAecExpSeparate_t*)key;
@@ -486,37 +303,6 @@ static int SearchForEqualExpSeparateProfile(List* l, void* key) {
   return ((!strncmp(pExpSeparate->name, k->name, sizeof(k->name))) ? 1 : 0);
 }
 
-static int SearchExpSeparateProfileByName(List* l, void* key) {
-  CamCalibAecExpSeparate_t* pExpSeparate = (CamCalibAecExpSeparate_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(pExpSeparate->name, k, sizeof(pExpSeparate->name))) ? 1 : 0);
-}
-
-
-
-/******************************************************************************
- * SearchDpccProfileByName
- *****************************************************************************/
-static int SearchDpccProfileByName(List* l, void* key) {
-  CamDpccProfile_t* dpcc = (CamDpccProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(dpcc->name, k, sizeof(dpcc->name))) ? 1 : 0);
-}
-
-
-
-/******************************************************************************
- * SearchDpccProfileByResolution
- *****************************************************************************/
-static int SearchDpccProfileByResolution(List* l, void* key) {
-  CamDpccProfile_t* dpcc = (CamDpccProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(dpcc->resolution, k, sizeof(dpcc->resolution))) ? 1 : 0);
-}
-
 static int SearchForEqualGocProfile(List* l, void* key) {
   CamCalibGocProfile_t* dpcc = (CamCalibGocProfile_t*)l;
   CamCalibGocProfile_t* k = (CamCalibGocProfile_t*)key;
@@ -524,13 +310,6 @@ static int SearchForEqualGocProfile(List* l, void* key) {
   return ((!strncmp(dpcc->name, k->name, sizeof(k->name))) ? 1 : 0);
 }
 
-static int SearchGocProfileByName(List* l, void* key) {
-  CamCalibGocProfile_t* dpf = (CamCalibGocProfile_t*)l;
-  char* k = (char*)key;
-
-  return ((!strncmp(dpf->name, k, sizeof(dpf->name))) ? 1 : 0);
-}
-
 static void ReplaceLscProfile(List* l, void* content) {
   CamLscProfile_t* oldpfl = (CamLscProfile_t*)l;
   CamLscProfile_t* newpfl = (CamLscProfile_t*)content;
@@ -555,26 +334,6 @@ static int SearchForEqualIesharpenProfile( List *l, void *key )
 
     return ( (!strncmp(dpf->name, k->name, sizeof(k->name))) ? 1 : 0 );
 }
-/******************************************************************************
- * SearchIesharpenProfileByName
- *****************************************************************************/
-static int SearchIesharpenProfileByName( List *l, void *key )
-{
-    CamIesharpenProfile_t *iesharpen = (CamIesharpenProfile_t *)l;
-    char *k = (char *)key;
-
-    return ( (!strncmp(iesharpen->name, k, sizeof(iesharpen->name))) ? 1 : 0 );
-}
-/******************************************************************************
- * SearchIesharpenProfileByResolution
- *****************************************************************************/
-static int SearchIesharpenProfileByResolution( List *l, void *key )
-{
-    CamIesharpenProfile_t *iesharpen = (CamIesharpenProfile_t*)l;
-    char *k = (char *)key;
-
-    return ( (!strncmp(iesharpen->resolution, k, sizeof(iesharpen->resolution))) ? 1 : 0 );
-}
 /******************************************************************************
  * ClearFrameRateList
  *****************************************************************************/
@@ -586,7 +345,7 @@ static void ClearFrameRateList(List* l) {
       /* nothing to free */
 
       /* 2.) free item */
-      free(pFrameRate);
+      CamCalibDbFree(pFrameRate);
 
       /* 3.) get next item */
       pFrameRate = (CamFrameRate_t*)ListRemoveHead(l);
@@ -608,7 +367,7 @@ static void ClearResolutionList(List* l) {
       ClearFrameRateList(&pResolution->framerates);
 
       /* 2.) free item */
-      free(pResolution);
+      CamCalibDbFree(pResolution);
 
       /* 3.) get next item */
       pResolution = (CamResolution_t*)ListRemoveHead(l);
@@ -628,36 +387,36 @@ static void ClearAwb_V10_GlobalList(List* l) {
     CamCalibAwb_V10_Global_t* pAwbGlobal = (CamCalibAwb_V10_Global_t*)ListRemoveHead(l);
     while (pAwbGlobal) {
       /* 1.) free sub structures of AWB globals */
-      free(pAwbGlobal->AwbClipParam.pRg1);
-      free(pAwbGlobal->AwbClipParam.pMaxDist1);
-      free(pAwbGlobal->AwbClipParam.pRg2);
-      free(pAwbGlobal->AwbClipParam.pMaxDist2);
-
-      free(pAwbGlobal->AwbGlobalFadeParm.pGlobalFade1);
-      free(pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance1);
-      free(pAwbGlobal->AwbGlobalFadeParm.pGlobalFade2);
-      free(pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2);
-
-      free(pAwbGlobal->AwbFade2Parm.pFade);
-      free(pAwbGlobal->AwbFade2Parm.pCbMinRegionMax);
-      free(pAwbGlobal->AwbFade2Parm.pCrMinRegionMax);
-      free(pAwbGlobal->AwbFade2Parm.pMaxCSumRegionMax);
-      free(pAwbGlobal->AwbFade2Parm.pCbMinRegionMin);
-      free(pAwbGlobal->AwbFade2Parm.pCrMinRegionMin);
-      free(pAwbGlobal->AwbFade2Parm.pMaxCSumRegionMin);
-
-      free(pAwbGlobal->AwbFade2Parm.pMinCRegionMax);
-      free(pAwbGlobal->AwbFade2Parm.pMinCRegionMin);
-      free(pAwbGlobal->AwbFade2Parm.pMaxYRegionMax);
-      free(pAwbGlobal->AwbFade2Parm.pMaxYRegionMin);
-      free(pAwbGlobal->AwbFade2Parm.pMinYMaxGRegionMax);
-      free(pAwbGlobal->AwbFade2Parm.pMinYMaxGRegionMin);
-      free(pAwbGlobal->AwbFade2Parm.pRefCb);
-      free(pAwbGlobal->AwbFade2Parm.pRefCr);
+      CamCalibDbFree(pAwbGlobal->AwbClipParam.pRg1);
+      CamCalibDbFree(pAwbGlobal->AwbClipParam.pMaxDist1);
+      CamCalibDbFree(pAwbGlobal->AwbClipParam.pRg2);
+      CamCalibDbFree(pAwbGlobal->AwbClipParam.pMaxDist2);
+
+      CamCalibDbFree(pAwbGlobal->AwbGlobalFadeParm.pGlobalFade1);
+      CamCalibDbFree(pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance1);
+      CamCalibDbFree(pAwbGlobal->AwbGlobalFadeParm.pGlobalFade2);
+      CamCalibDbFree(pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2);
+
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pFade);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pCbMinRegionMax);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pCrMinRegionMax);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMaxCSumRegionMax);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pCbMinRegionMin);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pCrMinRegionMin);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMaxCSumRegionMin);
+
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMinCRegionMax);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMinCRegionMin);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMaxYRegionMax);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMaxYRegionMin);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMinYMaxGRegionMax);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMinYMaxGRegionMin);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pRefCb);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pRefCr);
 
 
       /* 2.) free AWB globals */
-      free(pAwbGlobal);
+      CamCalibDbFree(pAwbGlobal);
 
       /* 3.) get next illumination */
       pAwbGlobal = (CamCalibAwb_V10_Global_t*)ListRemoveHead(l);
@@ -677,31 +436,31 @@ static void ClearAwb_V11_GlobalList(List* l) {
     CamCalibAwb_V11_Global_t* pAwbGlobal = (CamCalibAwb_V11_Global_t*)ListRemoveHead(l);
     while (pAwbGlobal) {
       /* 1.) free sub structures of AWB globals */
-      free(pAwbGlobal->AwbClipParam.pRg1);
-      free(pAwbGlobal->AwbClipParam.pMaxDist1);
-      free(pAwbGlobal->AwbClipParam.pRg2);
-      free(pAwbGlobal->AwbClipParam.pMaxDist2);
-
-      free(pAwbGlobal->AwbGlobalFadeParm.pGlobalFade1);
-      free(pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance1);
-      free(pAwbGlobal->AwbGlobalFadeParm.pGlobalFade2);
-      free(pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2);
-
-      free(pAwbGlobal->AwbFade2Parm.pFade);
-      free(pAwbGlobal->AwbFade2Parm.pMaxCSum_br);
-      free(pAwbGlobal->AwbFade2Parm.pMaxCSum_sr);
-      free(pAwbGlobal->AwbFade2Parm.pMinC_br);
-      free(pAwbGlobal->AwbFade2Parm.pMaxY_br);
-      free(pAwbGlobal->AwbFade2Parm.pMinY_br);
-      free(pAwbGlobal->AwbFade2Parm.pMinC_sr);
-      free(pAwbGlobal->AwbFade2Parm.pMaxY_sr);
-      free(pAwbGlobal->AwbFade2Parm.pMinY_sr);
-      free(pAwbGlobal->AwbFade2Parm.pRefCb);
-      free(pAwbGlobal->AwbFade2Parm.pRefCr);
+      CamCalibDbFree(pAwbGlobal->AwbClipParam.pRg1);
+      CamCalibDbFree(pAwbGlobal->AwbClipParam.pMaxDist1);
+      CamCalibDbFree(pAwbGlobal->AwbClipParam.pRg2);
+      CamCalibDbFree(pAwbGlobal->AwbClipParam.pMaxDist2);
+
+      CamCalibDbFree(pAwbGlobal->AwbGlobalFadeParm.pGlobalFade1);
+      CamCalibDbFree(pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance1);
+      CamCalibDbFree(pAwbGlobal->AwbGlobalFadeParm.pGlobalFade2);
+      CamCalibDbFree(pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2);
+
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pFade);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMaxCSum_br);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMaxCSum_sr);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMinC_br);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMaxY_br);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMinY_br);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMinC_sr);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMaxY_sr);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pMinY_sr);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pRefCb);
+      CamCalibDbFree(pAwbGlobal->AwbFade2Parm.pRefCr);
 
 
       /* 2.) free AWB globals */
-      free(pAwbGlobal);
+      CamCalibDbFree(pAwbGlobal);
 
       /* 3.) get next illumination */
       pAwbGlobal = (CamCalibAwb_V11_Global_t*)ListRemoveHead(l);
@@ -724,7 +483,7 @@ static void ClearEcmSchemeList(List* l) {
       /* nothing to free */
 
       /* 2.) free item */
-      free(pEcmScheme);
+      CamCalibDbFree(pEcmScheme);
 
       /* 3.) get next item */
       pEcmScheme = (CamEcmScheme_t*)ListRemoveHead(l);
@@ -747,7 +506,7 @@ static void ClearEcmProfileList(List* l) {
       ClearEcmSchemeList(&pEcmProfile->ecm_scheme);
 
       /* 2.) free item */
-      free(pEcmProfile);
+      CamCalibDbFree(pEcmProfile);
 
       /* 3.) get next item */
       pEcmProfile = (CamEcmProfile_t*)ListRemoveHead(l);
@@ -767,14 +526,14 @@ static void ClearAwb_V11_IlluminationList(List* l) {
     CamAwb_V11_IlluProfile_t* pIllumination = (CamAwb_V11_IlluProfile_t*)ListRemoveHead(l);
     while (pIllumination) {
       /* 1.) free sub structures of illumination */
-      free(pIllumination->SaturationCurve.pSensorGain);
-      free(pIllumination->SaturationCurve.pSaturation);
+      CamCalibDbFree(pIllumination->SaturationCurve.pSensorGain);
+      CamCalibDbFree(pIllumination->SaturationCurve.pSaturation);
 
-      free(pIllumination->VignettingCurve.pSensorGain);
-      free(pIllumination->VignettingCurve.pVignetting);
+      CamCalibDbFree(pIllumination->VignettingCurve.pSensorGain);
+      CamCalibDbFree(pIllumination->VignettingCurve.pVignetting);
 
       /* 2.) free illumination */
-      free(pIllumination);
+      CamCalibDbFree(pIllumination);
 
       /* 3.) get next illumination */
       pIllumination = (CamAwb_V11_IlluProfile_t*)ListRemoveHead(l);
@@ -792,14 +551,14 @@ static void ClearAwb_V10_IlluminationList(List* l) {
     CamAwb_V10_IlluProfile_t* pIllumination = (CamAwb_V10_IlluProfile_t*)ListRemoveHead(l);
     while (pIllumination) {
       /* 1.) free sub structures of illumination */
-      free(pIllumination->SaturationCurve.pSensorGain);
-      free(pIllumination->SaturationCurve.pSaturation);
+      CamCalibDbFree(pIllumination->SaturationCurve.pSensorGain);
+      CamCalibDbFree(pIllumination->SaturationCurve.pSaturation);
 
-      free(pIllumination->VignettingCurve.pSensorGain);
-      free(pIllumination->VignettingCurve.pVignetting);
+      CamCalibDbFree(pIllumination->VignettingCurve.pSensorGain);
+      CamCalibDbFree(pIllumination->VignettingCurve.pVignetting);
 
       /* 2.) free illumination */
-      free(pIllumination);
+      CamCalibDbFree(pIllumination);
 
       /* 3.) get next illumination */
       pIllumination = (CamAwb_V10_IlluProfile_t*)ListRemoveHead(l);
@@ -818,7 +577,7 @@ static void ClearLscProfileList(List* l) {
   if (!ListEmpty(l)) {
     CamLscProfile_t* pLscProfile = (CamLscProfile_t*)ListRemoveHead(l);
     while (pLscProfile) {
-      free(pLscProfile);
+      CamCalibDbFree(pLscProfile);
       pLscProfile = (CamLscProfile_t*)ListRemoveHead(l);
     }
   }
@@ -835,7 +594,7 @@ static void ClearCcProfileList(List* l) {
   if (!ListEmpty(l)) {
     CamCcProfile_t* pCcProfile = (CamCcProfile_t*)ListRemoveHead(l);
     while (pCcProfile) {
-      free(pCcProfile);
+      CamCalibDbFree(pCcProfile);
       pCcProfile = (CamCcProfile_t*)ListRemoveHead(l);
     }
   }
@@ -852,7 +611,7 @@ static void ClearBlsProfileList(List* l) {
   if (!ListEmpty(l)) {
     CamBlsProfile_t* pBlsProfile = (CamBlsProfile_t*)ListRemoveHead(l);
     while (pBlsProfile) {
-      free(pBlsProfile);
+      CamCalibDbFree(pBlsProfile);
       pBlsProfile = (CamBlsProfile_t*)ListRemoveHead(l);
     }
   }
@@ -870,7 +629,7 @@ static void ClearCacProfileList(List* l) {
   if (!ListEmpty(l)) {
     CamCacProfile_t* pCacProfile = (CamCacProfile_t*)ListRemoveHead(l);
     while (pCacProfile) {
-      free(pCacProfile);
+      CamCalibDbFree(pCacProfile);
       pCacProfile = (CamCacProfile_t*)ListRemoveHead(l);
     }
   }
@@ -886,23 +645,23 @@ static void ClearNewDsp3DNRList(List* l) {
     CamNewDsp3DNRProfile_t * pNewDsp3DNR = (CamNewDsp3DNRProfile_t*)ListRemoveHead(l);
     while (pNewDsp3DNR) {
 	  if(pNewDsp3DNR->pgain_Level){
-		free(pNewDsp3DNR->pgain_Level);
+		CamCalibDbFree(pNewDsp3DNR->pgain_Level);
   	  }
 
 	  if(pNewDsp3DNR->ynr.pynr_time_weight_level){
-		free(pNewDsp3DNR->ynr.pynr_time_weight_level);
+		CamCalibDbFree(pNewDsp3DNR->ynr.pynr_time_weight_level);
 	  }
 
 	  if(pNewDsp3DNR->ynr.pynr_spat_weight_level){
-		free(pNewDsp3DNR->ynr.pynr_spat_weight_level);
+		CamCalibDbFree(pNewDsp3DNR->ynr.pynr_spat_weight_level);
 	  }
 
 	  if(pNewDsp3DNR->uvnr.puvnr_weight_level){
-		free(pNewDsp3DNR->uvnr.puvnr_weight_level);
+		CamCalibDbFree(pNewDsp3DNR->uvnr.puvnr_weight_level);
 	  }
 
 	  if(pNewDsp3DNR->sharp.psharp_weight_level){
-		free(pNewDsp3DNR->sharp.psharp_weight_level);
+		CamCalibDbFree(pNewDsp3DNR->sharp.psharp_weight_level);
 	  }
 
 	  /* 3.) get next item */
@@ -926,74 +685,74 @@ static void ClearDsp3DNRList(List* l) {
 
       /* 2.) free item */
 	  if(pDsp3DNR->pgain_Level){
-		free(pDsp3DNR->pgain_Level);
+		CamCalibDbFree(pDsp3DNR->pgain_Level);
   	  }
 	  if(pDsp3DNR->pnoise_coef_denominator){
-		free(pDsp3DNR->pnoise_coef_denominator);
+		CamCalibDbFree(pDsp3DNR->pnoise_coef_denominator);
   	  }
 	  if(pDsp3DNR->pnoise_coef_numerator){
-		free(pDsp3DNR->pnoise_coef_numerator);
+		CamCalibDbFree(pDsp3DNR->pnoise_coef_numerator);
   	  }
 	  if(pDsp3DNR->sDefaultLevelSetting.pchrm_sp_nr_level){
-		free(pDsp3DNR->sDefaultLevelSetting.pchrm_sp_nr_level);
+		CamCalibDbFree(pDsp3DNR->sDefaultLevelSetting.pchrm_sp_nr_level);
   	  }
 	  if(pDsp3DNR->sDefaultLevelSetting.pchrm_te_nr_level){
-		free(pDsp3DNR->sDefaultLevelSetting.pchrm_te_nr_level);
+		CamCalibDbFree(pDsp3DNR->sDefaultLevelSetting.pchrm_te_nr_level);
   	  }
 	  if(pDsp3DNR->sDefaultLevelSetting.pluma_sp_nr_level){
-		free(pDsp3DNR->sDefaultLevelSetting.pluma_sp_nr_level);
+		CamCalibDbFree(pDsp3DNR->sDefaultLevelSetting.pluma_sp_nr_level);
   	  }
 	  if(pDsp3DNR->sDefaultLevelSetting.pluma_te_nr_level){
-		free(pDsp3DNR->sDefaultLevelSetting.pluma_te_nr_level);
+		CamCalibDbFree(pDsp3DNR->sDefaultLevelSetting.pluma_te_nr_level);
   	  }
 	  if(pDsp3DNR->sDefaultLevelSetting.pshp_level){
-		free(pDsp3DNR->sDefaultLevelSetting.pshp_level);
+		CamCalibDbFree(pDsp3DNR->sDefaultLevelSetting.pshp_level);
   	  }
 	  
 	  if(pDsp3DNR->sLumaSetting.pluma_sp_rad){
-		free(pDsp3DNR->sLumaSetting.pluma_sp_rad);
+		CamCalibDbFree(pDsp3DNR->sLumaSetting.pluma_sp_rad);
   	  }
 	  if(pDsp3DNR->sLumaSetting.pluma_te_max_bi_num){
-		free(pDsp3DNR->sLumaSetting.pluma_te_max_bi_num);
+		CamCalibDbFree(pDsp3DNR->sLumaSetting.pluma_te_max_bi_num);
   	  }
 	  
 
 	  if(pDsp3DNR->sChrmSetting.pchrm_sp_rad){
-		free(pDsp3DNR->sChrmSetting.pchrm_sp_rad);
+		CamCalibDbFree(pDsp3DNR->sChrmSetting.pchrm_sp_rad);
   	  }
 	  if(pDsp3DNR->sChrmSetting.pchrm_te_max_bi_num){
-		free(pDsp3DNR->sChrmSetting.pchrm_te_max_bi_num);
+		CamCalibDbFree(pDsp3DNR->sChrmSetting.pchrm_te_max_bi_num);
   	  }
 	 
   
 	  if(pDsp3DNR->sSharpSetting.psrc_shp_c){
-		free(pDsp3DNR->sSharpSetting.psrc_shp_c);
+		CamCalibDbFree(pDsp3DNR->sSharpSetting.psrc_shp_c);
   	  }
 	  if(pDsp3DNR->sSharpSetting.psrc_shp_div){
-		free(pDsp3DNR->sSharpSetting.psrc_shp_div);
+		CamCalibDbFree(pDsp3DNR->sSharpSetting.psrc_shp_div);
   	  }
 	  if(pDsp3DNR->sSharpSetting.psrc_shp_l){
-		free(pDsp3DNR->sSharpSetting.psrc_shp_l);
+		CamCalibDbFree(pDsp3DNR->sSharpSetting.psrc_shp_l);
   	  }
 	  if(pDsp3DNR->sSharpSetting.psrc_shp_thr){
-		free(pDsp3DNR->sSharpSetting.psrc_shp_thr);
+		CamCalibDbFree(pDsp3DNR->sSharpSetting.psrc_shp_thr);
   	  }
 	
 
 	  for(int i=0; i<CAM_CALIBDB_3DNR_WEIGHT_NUM; i++){
 		if(pDsp3DNR->sLumaSetting.pluma_weight[i]){
-			free(pDsp3DNR->sLumaSetting.pluma_weight[i]);
+			CamCalibDbFree(pDsp3DNR->sLumaSetting.pluma_weight[i]);
 		}
 
 		if(pDsp3DNR->sChrmSetting.pchrm_weight[i]){
-		  	free(pDsp3DNR->sChrmSetting.pchrm_weight[i]);
+		  	CamCalibDbFree(pDsp3DNR->sChrmSetting.pchrm_weight[i]);
   	    }
 		
 		if(pDsp3DNR->sSharpSetting.psrc_shp_weight[i]){
-		   free(pDsp3DNR->sSharpSetting.psrc_shp_weight[i]);
+		   CamCalibDbFree(pDsp3DNR->sSharpSetting.psrc_shp_weight[i]);
 		}
 	  }
-      free(pDsp3DNR);
+      CamCalibDbFree(pDsp3DNR);
 
       /* 3.) get next item */
       pDsp3DNR = (CamDsp3DNRSettingProfile_t*)ListRemoveHead(l);
@@ -1008,67 +767,67 @@ static void ClearDsp3DNRList(List* l) {
  *****************************************************************************/
 static void ClearDemosicLP(CamDemosaicLpProfile_t *pDemosaicLp) {
 	if(pDemosaicLp->diff_divided0){
-		free(pDemosaicLp->diff_divided0);
+		CamCalibDbFree(pDemosaicLp->diff_divided0);
 	}
 	if(pDemosaicLp->diff_divided1){
-		free(pDemosaicLp->diff_divided1);
+		CamCalibDbFree(pDemosaicLp->diff_divided1);
 	}
 	if(pDemosaicLp->diff_divided2){
-		free(pDemosaicLp->diff_divided2);
+		CamCalibDbFree(pDemosaicLp->diff_divided2);
 	}
 	if(pDemosaicLp->diff_divided3){
-		free(pDemosaicLp->diff_divided3);
+		CamCalibDbFree(pDemosaicLp->diff_divided3);
 	}
 	if(pDemosaicLp->diff_divided4){
-		free(pDemosaicLp->diff_divided4);
+		CamCalibDbFree(pDemosaicLp->diff_divided4);
 	}
 	
 	if(pDemosaicLp->thCSC_divided0){
-		free(pDemosaicLp->thCSC_divided0);
+		CamCalibDbFree(pDemosaicLp->thCSC_divided0);
 	}
 	if(pDemosaicLp->thCSC_divided1){
-		free(pDemosaicLp->thCSC_divided1);
+		CamCalibDbFree(pDemosaicLp->thCSC_divided1);
 	}
 	if(pDemosaicLp->thCSC_divided2){
-		free(pDemosaicLp->thCSC_divided2);
+		CamCalibDbFree(pDemosaicLp->thCSC_divided2);
 	}
 	if(pDemosaicLp->thCSC_divided3){
-		free(pDemosaicLp->thCSC_divided3);
+		CamCalibDbFree(pDemosaicLp->thCSC_divided3);
 	}
 	if(pDemosaicLp->thCSC_divided4){
-		free(pDemosaicLp->thCSC_divided4);
+		CamCalibDbFree(pDemosaicLp->thCSC_divided4);
 	}
 	
 	if(pDemosaicLp->thH_divided0){
-		free(pDemosaicLp->thH_divided0);
+		CamCalibDbFree(pDemosaicLp->thH_divided0);
 	}
 	if(pDemosaicLp->thH_divided1){
-		free(pDemosaicLp->thH_divided1);
+		CamCalibDbFree(pDemosaicLp->thH_divided1);
 	}
 	if(pDemosaicLp->thH_divided2){
-		free(pDemosaicLp->thH_divided2);
+		CamCalibDbFree(pDemosaicLp->thH_divided2);
 	}
 	if(pDemosaicLp->thH_divided3){
-		free(pDemosaicLp->thH_divided3);
+		CamCalibDbFree(pDemosaicLp->thH_divided3);
 	}
 	if(pDemosaicLp->thH_divided4){
-		free(pDemosaicLp->thH_divided4);
+		CamCalibDbFree(pDemosaicLp->thH_divided4);
 	}
 	
 	if(pDemosaicLp->varTh_divided0){
-		free(pDemosaicLp->varTh_divided0);
+		CamCalibDbFree(pDemosaicLp->varTh_divided0);
 	}
 	if(pDemosaicLp->varTh_divided1){
-		free(pDemosaicLp->varTh_divided1);
+		CamCalibDbFree(pDemosaicLp->varTh_divided1);
 	}
 	if(pDemosaicLp->varTh_divided2){
-		free(pDemosaicLp->varTh_divided2);
+		CamCalibDbFree(pDemosaicLp->varTh_divided2);
 	}
 	if(pDemosaicLp->varTh_divided3){
-		free(pDemosaicLp->varTh_divided3);
+		CamCalibDbFree(pDemosaicLp->varTh_divided3);
 	}
 	if(pDemosaicLp->varTh_divided4){
-		free(pDemosaicLp->varTh_divided4);
+		CamCalibDbFree(pDemosaicLp->varTh_divided4);
 	}
 }
 
@@ -1085,68 +844,68 @@ static void ClearFilterList(List* l) {
 
       /* 2.) free item */
 	  if(pFilter->DemosaicThCurve.pSensorGain){
-		free(pFilter->DemosaicThCurve.pSensorGain);
+		CamCalibDbFree(pFilter->DemosaicThCurve.pSensorGain);
   	  }
 	  if(pFilter->DemosaicThCurve.pThlevel){
-		free(pFilter->DemosaicThCurve.pThlevel);
+		CamCalibDbFree(pFilter->DemosaicThCurve.pThlevel);
   	  }
 	   
 	  if(pFilter->DenoiseLevelCurve.pSensorGain){
-		free(pFilter->DenoiseLevelCurve.pSensorGain);
+		CamCalibDbFree(pFilter->DenoiseLevelCurve.pSensorGain);
   	  }
 	  if(pFilter->DenoiseLevelCurve.pDlevel){
-		free(pFilter->DenoiseLevelCurve.pDlevel);
+		CamCalibDbFree(pFilter->DenoiseLevelCurve.pDlevel);
   	  }
 
 	  if(pFilter->SharpeningLevelCurve.pSensorGain){
-		free(pFilter->SharpeningLevelCurve.pSensorGain);
+		CamCalibDbFree(pFilter->SharpeningLevelCurve.pSensorGain);
   	  }
 	  if(pFilter->SharpeningLevelCurve.pSlevel){
-		free(pFilter->SharpeningLevelCurve.pSlevel);
+		CamCalibDbFree(pFilter->SharpeningLevelCurve.pSlevel);
   	  }
 
 	  if(pFilter->FiltLevelRegConf.p_chr_h_mode){
-		free(pFilter->FiltLevelRegConf.p_chr_h_mode);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_chr_h_mode);
   	  }
 	  if(pFilter->FiltLevelRegConf.p_chr_v_mode){
-		free(pFilter->FiltLevelRegConf.p_chr_v_mode);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_chr_v_mode);
   	  }
 	  if(pFilter->FiltLevelRegConf.p_fac_bl0){
-		free(pFilter->FiltLevelRegConf.p_fac_bl0);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_fac_bl0);
   	  }
 	  if(pFilter->FiltLevelRegConf.p_fac_bl1){
-		free(pFilter->FiltLevelRegConf.p_fac_bl1);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_fac_bl1);
   	  }
 	  if(pFilter->FiltLevelRegConf.p_fac_mid){
-		free(pFilter->FiltLevelRegConf.p_fac_mid);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_fac_mid);
   	  }
 	  if(pFilter->FiltLevelRegConf.p_fac_sh0){
-		free(pFilter->FiltLevelRegConf.p_fac_sh0);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_fac_sh0);
   	  }
 	  if(pFilter->FiltLevelRegConf.p_fac_sh1){
-		free(pFilter->FiltLevelRegConf.p_fac_sh1);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_fac_sh1);
   	  }
 	  if(pFilter->FiltLevelRegConf.p_FiltLevel){
-		free(pFilter->FiltLevelRegConf.p_FiltLevel);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_FiltLevel);
   	  }
 	  if(pFilter->FiltLevelRegConf.p_grn_stage1){
-		free(pFilter->FiltLevelRegConf.p_grn_stage1);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_grn_stage1);
   	  }
 	  if(pFilter->FiltLevelRegConf.p_thresh_bl0){
-		free(pFilter->FiltLevelRegConf.p_thresh_bl0);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_thresh_bl0);
   	  }
 	  if(pFilter->FiltLevelRegConf.p_thresh_bl1){
-		free(pFilter->FiltLevelRegConf.p_thresh_bl1);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_thresh_bl1);
   	  }
 	  if(pFilter->FiltLevelRegConf.p_thresh_sh0){
-		free(pFilter->FiltLevelRegConf.p_thresh_sh0);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_thresh_sh0);
   	  }
 	  if(pFilter->FiltLevelRegConf.p_thresh_sh1){
-		free(pFilter->FiltLevelRegConf.p_thresh_sh1);
+		CamCalibDbFree(pFilter->FiltLevelRegConf.p_thresh_sh1);
   	  }
 
 	  ClearDemosicLP(&pFilter->DemosaicLpConf);
-      free(pFilter);
+      CamCalibDbFree(pFilter);
 		
       /* 3.) get next item */
       pFilter = (CamFilterProfile_t*)ListRemoveHead(l);
@@ -1168,7 +927,7 @@ static void ClearDpfProfileList(List* l) {
 	  ClearNewDsp3DNRList(&pDpfProfile->newDsp3DNRProfileList);
 	  ClearFilterList(&pDpfProfile->FilterList);
 	  
-      free(pDpfProfile);
+      CamCalibDbFree(pDpfProfile);
       pDpfProfile = (CamDpfProfile_t*)ListRemoveHead(l);
     }
   }
@@ -1183,7 +942,7 @@ static void ClearDpccProfileList(List* l) {
   if (!ListEmpty(l)) {
     CamDpccProfile_t* pDpccProfile = (CamDpccProfile_t*)ListRemoveHead(l);
     while (pDpccProfile) {
-      free(pDpccProfile);
+      CamCalibDbFree(pDpccProfile);
       pDpccProfile = (CamDpccProfile_t*)ListRemoveHead(l);
     }
   }
@@ -1203,70 +962,70 @@ static void ClearIesharpenProfileList(  List *l )
         while ( pIesharpenProfile )
         {
             if(pIesharpenProfile->gauss_flat_coe!=NULL){
-                free(pIesharpenProfile->gauss_flat_coe);
+                CamCalibDbFree(pIesharpenProfile->gauss_flat_coe);
             }
             if(pIesharpenProfile->gauss_noise_coe!=NULL){
-                free(pIesharpenProfile->gauss_noise_coe);
+                CamCalibDbFree(pIesharpenProfile->gauss_noise_coe);
             }
             if(pIesharpenProfile->gauss_other_coe!=NULL){
-                free(pIesharpenProfile->gauss_other_coe);
+                CamCalibDbFree(pIesharpenProfile->gauss_other_coe);
             }
             if(pIesharpenProfile->hgridconf.line1_filter_coe!=NULL){
-                free(pIesharpenProfile->hgridconf.line1_filter_coe);
+                CamCalibDbFree(pIesharpenProfile->hgridconf.line1_filter_coe);
             }
             if(pIesharpenProfile->hgridconf.line2_filter_coe != NULL){
-                free(pIesharpenProfile->hgridconf.line2_filter_coe);
+                CamCalibDbFree(pIesharpenProfile->hgridconf.line2_filter_coe);
             }
             if(pIesharpenProfile->hgridconf.line3_filter_coe!=NULL){
-                free(pIesharpenProfile->hgridconf.line3_filter_coe);
+                CamCalibDbFree(pIesharpenProfile->hgridconf.line3_filter_coe);
             }
             if(pIesharpenProfile->hgridconf.p_grad!=NULL){
-                free(pIesharpenProfile->hgridconf.p_grad);
+                CamCalibDbFree(pIesharpenProfile->hgridconf.p_grad);
             }
             if(pIesharpenProfile->hgridconf.sharp_factor!=NULL){
-                free(pIesharpenProfile->hgridconf.sharp_factor);
+                CamCalibDbFree(pIesharpenProfile->hgridconf.sharp_factor);
             }
             if(pIesharpenProfile->lgridconf.line1_filter_coe!=NULL){
-                free(pIesharpenProfile->lgridconf.line1_filter_coe);
+                CamCalibDbFree(pIesharpenProfile->lgridconf.line1_filter_coe);
             }
             if(pIesharpenProfile->lgridconf.line2_filter_coe!=NULL){
-                free(pIesharpenProfile->lgridconf.line2_filter_coe);
+                CamCalibDbFree(pIesharpenProfile->lgridconf.line2_filter_coe);
             }
             if(pIesharpenProfile->lgridconf.line3_filter_coe!=NULL){
-                free(pIesharpenProfile->lgridconf.line3_filter_coe);
+                CamCalibDbFree(pIesharpenProfile->lgridconf.line3_filter_coe);
             }
             if(pIesharpenProfile->lgridconf.p_grad!=NULL){
-                free(pIesharpenProfile->lgridconf.p_grad);
+                CamCalibDbFree(pIesharpenProfile->lgridconf.p_grad);
             }
             if(pIesharpenProfile->lgridconf.sharp_factor!=NULL){
-                free(pIesharpenProfile->lgridconf.sharp_factor);
+                CamCalibDbFree(pIesharpenProfile->lgridconf.sharp_factor);
             }
             if(pIesharpenProfile->pmaxnumber!=NULL){
-                free(pIesharpenProfile->pmaxnumber);
+                CamCalibDbFree(pIesharpenProfile->pmaxnumber);
             }
             if(pIesharpenProfile->pminnumber!=NULL){
-                free(pIesharpenProfile->pminnumber);
+                CamCalibDbFree(pIesharpenProfile->pminnumber);
             }
             if(pIesharpenProfile->P_delta1!=NULL){
-                free(pIesharpenProfile->P_delta1);
+                CamCalibDbFree(pIesharpenProfile->P_delta1);
             }
             if(pIesharpenProfile->P_delta2!=NULL){
-                free(pIesharpenProfile->P_delta2);
+                CamCalibDbFree(pIesharpenProfile->P_delta2);
             }
             if(pIesharpenProfile->uv_gauss_flat_coe!=NULL){
-                free(pIesharpenProfile->uv_gauss_flat_coe);
+                CamCalibDbFree(pIesharpenProfile->uv_gauss_flat_coe);
             }
             if(pIesharpenProfile->uv_gauss_noise_coe!=NULL){
-                free(pIesharpenProfile->uv_gauss_noise_coe);
+                CamCalibDbFree(pIesharpenProfile->uv_gauss_noise_coe);
             }
             if(pIesharpenProfile->uv_gauss_other_coe!=NULL){
-                free(pIesharpenProfile->uv_gauss_other_coe);
+                CamCalibDbFree(pIesharpenProfile->uv_gauss_other_coe);
             }
             if(pIesharpenProfile->yavg_thr!=NULL){
-                free(pIesharpenProfile->yavg_thr);
+                CamCalibDbFree(pIesharpenProfile->yavg_thr);
             }
 
-            free( pIesharpenProfile );
+            CamCalibDbFree( pIesharpenProfile );
             pIesharpenProfile = (CamIesharpenProfile_t *)ListRemoveHead( l );
         }
     }
@@ -1281,7 +1040,7 @@ static void ClearGocProfileList(List* l) {
   if (!ListEmpty(l)) {
     CamCalibGocProfile_t* pGocProfile = (CamCalibGocProfile_t*)ListRemoveHead(l);
     while (pGocProfile) {
-      free(pGocProfile);
+      CamCalibDbFree(pGocProfile);
       pGocProfile = (CamCalibGocProfile_t*)ListRemoveHead(l);
     }
   }
@@ -1727,46 +1486,47 @@ static RESULT ClearContext(CamCalibDbContext_t* pCamCalibDbCtx) {
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
   ClearResolutionList(&pCamCalibDbCtx->resolution);
   CamCalibAwbPara_t*          pAwbProfile_test=pCamCalibDbCtx->pAwbProfile;     /* AWB  profile*/
   CamAwbPara_V11_t           Para_V11_test =pAwbProfile_test->Para_V11;
   ClearAwb_V11_GlobalList(&pCamCalibDbCtx->pAwbProfile->Para_V11.awb_global);
   ClearAwb_V10_GlobalList(&pCamCalibDbCtx->pAwbProfile->Para_V10.awb_global);
   if (pCamCalibDbCtx->pAfGlobal) {
-  	free(pCamCalibDbCtx->pAfGlobal);
+  	CamCalibDbFree(pCamCalibDbCtx->pAfGlobal);
     pCamCalibDbCtx->pAfGlobal = NULL;
 	}
   if (pCamCalibDbCtx->pAecGlobal) {
   	if(pCamCalibDbCtx->pAecGlobal->GainRange.pGainRange != NULL){
-		free(pCamCalibDbCtx->pAecGlobal->GainRange.pGainRange);
+		CamCalibDbFree(pCamCalibDbCtx->pAecGlobal->GainRange.pGainRange);
 	}
 	if(pCamCalibDbCtx->pAecGlobal->GridWeights.pWeight){
-		free(pCamCalibDbCtx->pAecGlobal->GridWeights.pWeight);
+		CamCalibDbFree(pCamCalibDbCtx->pAecGlobal->GridWeights.pWeight);
 	}
 	if(pCamCalibDbCtx->pAecGlobal->NightGridWeights.pWeight){
-		free(pCamCalibDbCtx->pAecGlobal->NightGridWeights.pWeight);
+		CamCalibDbFree(pCamCalibDbCtx->pAecGlobal->NightGridWeights.pWeight);
 	}
 	ClearDySetpointList(&pCamCalibDbCtx->pAecGlobal->DySetpointList);
 	ClearExpSeparateList(&pCamCalibDbCtx->pAecGlobal->ExpSeparateList);
-    free(pCamCalibDbCtx->pAecGlobal);
+    CamCalibDbFree(pCamCalibDbCtx->pAecGlobal);
   }
   
   if (pCamCalibDbCtx->pWdrGlobal) {
     if (pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.pfMaxGain_level != NULL) {
-      free(pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.pfMaxGain_level);
+      CamCalibDbFree(pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.pfMaxGain_level);
     }
     if (pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.pfSensorGain_level != NULL) {
-      free(pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.pfSensorGain_level);
+      CamCalibDbFree(pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.pfSensorGain_level);
     }
-    free(pCamCalibDbCtx->pWdrGlobal);
+    CamCalibDbFree(pCamCalibDbCtx->pWdrGlobal);
   }
 
   if (pCamCalibDbCtx->pCprocGlobal)
-    free(pCamCalibDbCtx->pCprocGlobal);
+    CamCalibDbFree(pCamCalibDbCtx->pCprocGlobal);
   ClearEcmProfileList(& pCamCalibDbCtx->ecm_profile);
   ClearAwb_V11_IlluminationList(&pCamCalibDbCtx->pAwbProfile->Para_V11.illumination);  
   ClearAwb_V10_IlluminationList(&pCamCalibDbCtx->pAwbProfile->Para_V10.illumination);  
-  free(pCamCalibDbCtx->pAwbProfile);
+  CamCalibDbFree(pCamCalibDbCtx->pAwbProfile);
   ClearLscProfileList(&pCamCalibDbCtx->lsc_profile);
   ClearCcProfileList(&pCamCalibDbCtx->cc_profile);
   ClearBlsProfileList(&pCamCalibDbCtx->bls_profile);
@@ -1795,13 +1555,13 @@ void ClearDySetpointList(List* l) {
 	CamCalibAecDynamicSetpoint_t* pDySetpoint = (CamCalibAecDynamicSetpoint_t*)ListRemoveHead(l);
 	while (pDySetpoint) {
 	  if(pDySetpoint->pDySetpoint != NULL)
-		free(pDySetpoint->pDySetpoint);
+		CamCalibDbFree(pDySetpoint->pDySetpoint);
 
 	  if(pDySetpoint->pExpValue != NULL)
-		free(pDySetpoint->pExpValue);
+		CamCalibDbFree(pDySetpoint->pExpValue);
 
 	  /* 2.) free item */
-	  free(pDySetpoint);
+	  CamCalibDbFree(pDySetpoint);
 
 	  /* 3.) get next item */
 	  pDySetpoint = (CamCalibAecDynamicSetpoint_t*)ListRemoveHead(l);
@@ -1819,7 +1579,7 @@ void ClearExpSeparateList(List* l) {
 	while (pExpSeparate) {
 
 	  /* 2.) free item */
-	  free(pExpSeparate);
+	  CamCalibDbFree(pExpSeparate);
 
 	  /* 3.) get next item */
 	  pExpSeparate = (CamCalibAecExpSeparate_t*)ListRemoveHead(l);
@@ -1846,14 +1606,14 @@ RESULT CamCalibDbCreate
     return (RET_NULL_POINTER);
   }
   /* allocate control context */
-  pCamCalibDbCtx = malloc(sizeof(CamCalibDbContext_t));
+  pCamCalibDbCtx = CamCalibDbMalloc(sizeof(CamCalibDbContext_t));
   if (pCamCalibDbCtx == NULL) {
     ALOGE("%s (allocating control context failed)\n", __func__);
     return (RET_OUTOFMEM);
   }
   MEMSET(pCamCalibDbCtx, 0, sizeof(CamCalibDbContext_t));
   ListInit(&pCamCalibDbCtx->resolution);
-  pCamCalibDbCtx->pAwbProfile = (CamCalibAwbPara_t*)malloc(sizeof(CamCalibAwbPara_t));
+  pCamCalibDbCtx->pAwbProfile = (CamCalibAwbPara_t*)CamCalibDbMalloc(sizeof(CamCalibAwbPara_t));
   ListInit(&pCamCalibDbCtx->pAwbProfile->Para_V11.awb_global);
   ListInit(&pCamCalibDbCtx->pAwbProfile->Para_V10.awb_global);
   pCamCalibDbCtx->pAecGlobal = NULL;
@@ -1894,7 +1654,7 @@ RESULT CamCalibDbRelease
   }
 
   result = ClearContext(pCamCalibDbCtx);
-  free(pCamCalibDbCtx);
+  CamCalibDbFree(pCamCalibDbCtx);
   *handle = NULL;
 
   LOGV("%s (exit)\n", __func__);
@@ -1930,6 +1690,56 @@ RESULT CamCalibDbClear
 
 
 
+/******************************************************************************
+ * CamCalibDbBuildIndex
+ *****************************************************************************/
+RESULT CamCalibDbBuildIndex
+(
+    CamCalibDbHandle_t  handle
+) {
+  CamCalibDbContext_t* pCamCalibDbCtx = (CamCalibDbContext_t*)handle;
+
+  RESULT result = RET_SUCCESS;
+
+  LOGV("%s (enter)\n", __func__);
+
+  if (pCamCalibDbCtx == NULL) {
+    return (RET_WRONG_HANDLE);
+  }
+
+  result = CamCalibDbIndexCreate(pCamCalibDbCtx);
+
+  LOGV("%s (exit)\n", __func__);
+
+  return (result);
+}
+
+
+
+/******************************************************************************
+ * CamCalibDbReleaseIndex
+ *****************************************************************************/
+RESULT CamCalibDbReleaseIndex
+(
+    CamCalibDbHandle_t  handle
+) {
+  CamCalibDbContext_t* pCamCalibDbCtx = (CamCalibDbContext_t*)handle;
+
+  LOGV("%s (enter)\n", __func__);
+
+  if (pCamCalibDbCtx == NULL) {
+    return (RET_WRONG_HANDLE);
+  }
+
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
+  LOGV("%s (exit)\n", __func__);
+
+  return (RET_SUCCESS);
+}
+
+
+
 /******************************************************************************
  * CamCalibDbSetMetaData
  *****************************************************************************/
@@ -2065,6 +1875,8 @@ RESULT CamCalibDbAddFrameRate
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   if (NULL == pResolution) {
     return (RET_INVALID_PARM);
   }
@@ -2081,7 +1893,7 @@ RESULT CamCalibDbAddFrameRate
   }
 
   /* finally allocate, copy & add scheme */
-  pNewFrameRate = malloc(sizeof(CamFrameRate_t));
+  pNewFrameRate = CamCalibDbMalloc(sizeof(CamFrameRate_t));
   if (NULL == pNewFrameRate) {
     return (RET_OUTOFMEM);
   }
@@ -2115,6 +1927,8 @@ RESULT CamCalibDbAddResolution
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateResolution(pAddRes);
   if (result != RET_SUCCESS) {
     return (result);
@@ -2131,7 +1945,7 @@ RESULT CamCalibDbAddResolution
     return (RET_NOTAVAILABLE);
   }
 
-  pNewRes = malloc(sizeof(CamResolution_t));
+  pNewRes = CamCalibDbMalloc(sizeof(CamResolution_t));
   if (NULL == pNewRes) {
     return (RET_OUTOFMEM);
   }
@@ -2181,7 +1995,7 @@ RESULT CamCalibDbGetNoOfResolutions
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pCamCalibDbCtx->resolution);
+  *no = (uint32_t)CamCalibDbIndexNoItems(pCamCalibDbCtx, &pCamCalibDbCtx->resolution);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -2253,8 +2067,8 @@ RESULT CamCalibDbGetResolutionByWidthHeight
   SearchParam.height     = height;
 
   /* search resolution by name */
-  *pResolution = (CamResolution_t*)ListSearch(&pCamCalibDbCtx->resolution,
-                                              SearchResolutionByWidthHeight, (void*)&SearchParam);
+  *pResolution = (CamResolution_t*)CAM_CALIBDB_INDEX_SEARCH_KEY(pCamCalibDbCtx, &pCamCalibDbCtx->resolution,
+                                                            CamResolution_t, width, height, &SearchParam.width);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -2294,8 +2108,8 @@ RESULT CamCalibDbGetResolutionNameByWidthHeight
   SearchParam.height     = height;
 
   /* search resolution by name */
-  pResolution = (CamResolution_t*)ListSearch(&pCamCalibDbCtx->resolution,
-                                             SearchResolutionByWidthHeight, (void*)&SearchParam);
+  pResolution = (CamResolution_t*)CAM_CALIBDB_INDEX_SEARCH_KEY(pCamCalibDbCtx, &pCamCalibDbCtx->resolution,
+                                                            CamResolution_t, width, height, &SearchParam.width);
   if (pResolution) {
     strncpy((char*)pResolutionName, (char*)pResolution->name, sizeof(CamResolutionName_t));
   } else {
@@ -2364,6 +2178,8 @@ RESULT CamCalibDbAddAwb_V10_Global
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateAwb_V10_Data(pAddAwbGlobal);
   if (result != RET_SUCCESS) {
     return (result);
@@ -2379,7 +2195,7 @@ RESULT CamCalibDbAddAwb_V10_Global
     int32_t nArraySize1;
     int32_t nArraySize2;
 
-    pNewAwbGlobal = malloc(sizeof(CamCalibAwb_V10_Global_t));
+    pNewAwbGlobal = CamCalibDbMalloc(sizeof(CamCalibAwb_V10_Global_t));
     MEMCPY(pNewAwbGlobal, pAddAwbGlobal, sizeof(CamCalibAwb_V10_Global_t));
 
     pAwbClipParam       = &pNewAwbGlobal->AwbClipParam;
@@ -2389,60 +2205,60 @@ RESULT CamCalibDbAddAwb_V10_Global
     // pAwbClipParam
     nArraySize1 = pAddAwbGlobal->AwbClipParam.ArraySize1;
     nArraySize2 = pAddAwbGlobal->AwbClipParam.ArraySize2;
-    pAwbClipParam->pRg1 = malloc(sizeof(float) *  nArraySize1);
+    pAwbClipParam->pRg1 = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbClipParam->pRg1, pAddAwbGlobal->AwbClipParam.pRg1, sizeof(float) *  nArraySize1);
-    pAwbClipParam->pMaxDist1 = malloc(sizeof(float) *  nArraySize1);
+    pAwbClipParam->pMaxDist1 = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbClipParam->pMaxDist1, pAddAwbGlobal->AwbClipParam.pMaxDist1, sizeof(float) *  nArraySize1);
-    pAwbClipParam->pRg2 = malloc(sizeof(float) *  nArraySize2);
+    pAwbClipParam->pRg2 = CamCalibDbMalloc(sizeof(float) *  nArraySize2);
     MEMCPY(pAwbClipParam->pRg2, pAddAwbGlobal->AwbClipParam.pRg2, sizeof(float) *  nArraySize2);
-    pAwbClipParam->pMaxDist2 = malloc(sizeof(float) *  nArraySize2);
+    pAwbClipParam->pMaxDist2 = CamCalibDbMalloc(sizeof(float) *  nArraySize2);
     MEMCPY(pAwbClipParam->pMaxDist2, pAddAwbGlobal->AwbClipParam.pMaxDist2, sizeof(float) *  nArraySize2);
 
     // pAwbGlobalFadeParm
     nArraySize1 = pAddAwbGlobal->AwbGlobalFadeParm.ArraySize1;
     nArraySize2 = pAddAwbGlobal->AwbGlobalFadeParm.ArraySize2;
-    pAwbGlobalFadeParm->pGlobalFade1 = malloc(sizeof(float) *  nArraySize1);
+    pAwbGlobalFadeParm->pGlobalFade1 = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbGlobalFadeParm->pGlobalFade1, pAddAwbGlobal->AwbGlobalFadeParm.pGlobalFade1, sizeof(float) *  nArraySize1);
-    pAwbGlobalFadeParm->pGlobalGainDistance1 = malloc(sizeof(float) *  nArraySize1);
+    pAwbGlobalFadeParm->pGlobalGainDistance1 = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbGlobalFadeParm->pGlobalGainDistance1, pAddAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance1, sizeof(float) *  nArraySize1);
-    pAwbGlobalFadeParm->pGlobalFade2 = malloc(sizeof(float) *  nArraySize2);
+    pAwbGlobalFadeParm->pGlobalFade2 = CamCalibDbMalloc(sizeof(float) *  nArraySize2);
     MEMCPY(pAwbGlobalFadeParm->pGlobalFade2, pAddAwbGlobal->AwbGlobalFadeParm.pGlobalFade2, sizeof(float) *  nArraySize2);
-    pAwbGlobalFadeParm->pGlobalGainDistance2 = malloc(sizeof(float) *  nArraySize2);
+    pAwbGlobalFadeParm->pGlobalGainDistance2 = CamCalibDbMalloc(sizeof(float) *  nArraySize2);
     MEMCPY(pAwbGlobalFadeParm->pGlobalGainDistance2, pAddAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2, sizeof(float) *  nArraySize2);
 
     // pAwbFade2Parm
     nArraySize1 = pAddAwbGlobal->AwbFade2Parm.ArraySize;
     nArraySize2 = 0l;
-    pAwbFade2Parm->pFade                = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pFade                = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pFade, pAddAwbGlobal->AwbFade2Parm.pFade, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pCbMinRegionMax      = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pCbMinRegionMax      = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pCbMinRegionMax, pAddAwbGlobal->AwbFade2Parm.pCbMinRegionMax, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pCrMinRegionMax      = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pCrMinRegionMax      = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pCrMinRegionMax, pAddAwbGlobal->AwbFade2Parm.pCrMinRegionMax, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMaxCSumRegionMax    = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pMaxCSumRegionMax    = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pMaxCSumRegionMax, pAddAwbGlobal->AwbFade2Parm.pMaxCSumRegionMax, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pCbMinRegionMin      = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pCbMinRegionMin      = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pCbMinRegionMin, pAddAwbGlobal->AwbFade2Parm.pCbMinRegionMin, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pCrMinRegionMin      = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pCrMinRegionMin      = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pCrMinRegionMin, pAddAwbGlobal->AwbFade2Parm.pCrMinRegionMin, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMaxCSumRegionMin    = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pMaxCSumRegionMin    = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pMaxCSumRegionMin, pAddAwbGlobal->AwbFade2Parm.pMaxCSumRegionMin, sizeof(float) *  nArraySize1);
 
-    pAwbFade2Parm->pMinCRegionMax = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pMinCRegionMax = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pMinCRegionMax, pAddAwbGlobal->AwbFade2Parm.pMinCRegionMax, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMinCRegionMin = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pMinCRegionMin = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pMinCRegionMin, pAddAwbGlobal->AwbFade2Parm.pMinCRegionMin, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMaxYRegionMax = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pMaxYRegionMax = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pMaxYRegionMax, pAddAwbGlobal->AwbFade2Parm.pMaxYRegionMax, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMaxYRegionMin = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pMaxYRegionMin = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pMaxYRegionMin, pAddAwbGlobal->AwbFade2Parm.pMaxYRegionMin, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMinYMaxGRegionMax = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pMinYMaxGRegionMax = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pMinYMaxGRegionMax, pAddAwbGlobal->AwbFade2Parm.pMinYMaxGRegionMax, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMinYMaxGRegionMin = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pMinYMaxGRegionMin = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pMinYMaxGRegionMin, pAddAwbGlobal->AwbFade2Parm.pMinYMaxGRegionMin, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pRefCb = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pRefCb = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pRefCb, pAddAwbGlobal->AwbFade2Parm.pRefCb, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pRefCr = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pRefCr = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pRefCr, pAddAwbGlobal->AwbFade2Parm.pRefCr, sizeof(float) *  nArraySize1);
 
     ListPrepareItem(pNewAwbGlobal);
@@ -2476,6 +2292,8 @@ RESULT CamCalibDbAddAwb_VersionName
   if (NULL == pCamCalibDbCtx) {
     return (RET_WRONG_HANDLE);
   }
+
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
   
   LOGV( "valid_version :%d \n", vName);
   pCamCalibDbCtx->pAwbProfile->valid_version =	vName;
@@ -2535,6 +2353,8 @@ RESULT CamCalibDbAddAwb_V11_Global
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateAwb_V11_Data(pAddAwbGlobal);
   if (result != RET_SUCCESS) {
     return (result);
@@ -2550,7 +2370,7 @@ RESULT CamCalibDbAddAwb_V11_Global
     int32_t nArraySize1;
     int32_t nArraySize2;
 
-    pNewAwbGlobal = malloc(sizeof(CamCalibAwb_V11_Global_t));
+    pNewAwbGlobal = CamCalibDbMalloc(sizeof(CamCalibAwb_V11_Global_t));
     MEMCPY(pNewAwbGlobal, pAddAwbGlobal, sizeof(CamCalibAwb_V11_Global_t));
 
     pAwbClipParam       = &pNewAwbGlobal->AwbClipParam;
@@ -2560,51 +2380,51 @@ RESULT CamCalibDbAddAwb_V11_Global
     // pAwbClipParam
     nArraySize1 = pAddAwbGlobal->AwbClipParam.ArraySize1;
     nArraySize2 = pAddAwbGlobal->AwbClipParam.ArraySize2;
-    pAwbClipParam->pRg1 = malloc(sizeof(float) *  nArraySize1);
+    pAwbClipParam->pRg1 = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbClipParam->pRg1, pAddAwbGlobal->AwbClipParam.pRg1, sizeof(float) *  nArraySize1);
-    pAwbClipParam->pMaxDist1 = malloc(sizeof(float) *  nArraySize1);
+    pAwbClipParam->pMaxDist1 = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbClipParam->pMaxDist1, pAddAwbGlobal->AwbClipParam.pMaxDist1, sizeof(float) *  nArraySize1);
-    pAwbClipParam->pRg2 = malloc(sizeof(float) *  nArraySize2);
+    pAwbClipParam->pRg2 = CamCalibDbMalloc(sizeof(float) *  nArraySize2);
     MEMCPY(pAwbClipParam->pRg2, pAddAwbGlobal->AwbClipParam.pRg2, sizeof(float) *  nArraySize2);
-    pAwbClipParam->pMaxDist2 = malloc(sizeof(float) *  nArraySize2);
+    pAwbClipParam->pMaxDist2 = CamCalibDbMalloc(sizeof(float) *  nArraySize2);
     MEMCPY(pAwbClipParam->pMaxDist2, pAddAwbGlobal->AwbClipParam.pMaxDist2, sizeof(float) *  nArraySize2);
 
     // pAwbGlobalFadeParm
     nArraySize1 = pAddAwbGlobal->AwbGlobalFadeParm.ArraySize1;
     nArraySize2 = pAddAwbGlobal->AwbGlobalFadeParm.ArraySize2;
-    pAwbGlobalFadeParm->pGlobalFade1 = malloc(sizeof(float) *  nArraySize1);
+    pAwbGlobalFadeParm->pGlobalFade1 = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbGlobalFadeParm->pGlobalFade1, pAddAwbGlobal->AwbGlobalFadeParm.pGlobalFade1, sizeof(float) *  nArraySize1);
-    pAwbGlobalFadeParm->pGlobalGainDistance1 = malloc(sizeof(float) *  nArraySize1);
+    pAwbGlobalFadeParm->pGlobalGainDistance1 = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbGlobalFadeParm->pGlobalGainDistance1, pAddAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance1, sizeof(float) *  nArraySize1);
-    pAwbGlobalFadeParm->pGlobalFade2 = malloc(sizeof(float) *  nArraySize2);
+    pAwbGlobalFadeParm->pGlobalFade2 = CamCalibDbMalloc(sizeof(float) *  nArraySize2);
     MEMCPY(pAwbGlobalFadeParm->pGlobalFade2, pAddAwbGlobal->AwbGlobalFadeParm.pGlobalFade2, sizeof(float) *  nArraySize2);
-    pAwbGlobalFadeParm->pGlobalGainDistance2 = malloc(sizeof(float) *  nArraySize2);
+    pAwbGlobalFadeParm->pGlobalGainDistance2 = CamCalibDbMalloc(sizeof(float) *  nArraySize2);
     MEMCPY(pAwbGlobalFadeParm->pGlobalGainDistance2, pAddAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2, sizeof(float) *  nArraySize2);
 
     // pAwbFade2Parm
     nArraySize1 = pAddAwbGlobal->AwbFade2Parm.ArraySize;
     nArraySize2 = 0l;
-    pAwbFade2Parm->pFade                = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pFade                = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pFade, pAddAwbGlobal->AwbFade2Parm.pFade, sizeof(float) *  nArraySize1);
 
-    pAwbFade2Parm->pMaxCSum_br = malloc(sizeof(float) * nArraySize1);
+    pAwbFade2Parm->pMaxCSum_br = CamCalibDbMalloc(sizeof(float) * nArraySize1);
     MEMCPY(pAwbFade2Parm->pMaxCSum_br, pAddAwbGlobal->AwbFade2Parm.pMaxCSum_br, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMaxCSum_sr = malloc(sizeof(float) * nArraySize1);
+    pAwbFade2Parm->pMaxCSum_sr = CamCalibDbMalloc(sizeof(float) * nArraySize1);
     MEMCPY(pAwbFade2Parm->pMaxCSum_sr, pAddAwbGlobal->AwbFade2Parm.pMaxCSum_sr, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMinC_br    = malloc(sizeof(float) * nArraySize1);
+    pAwbFade2Parm->pMinC_br    = CamCalibDbMalloc(sizeof(float) * nArraySize1);
     MEMCPY(pAwbFade2Parm->pMinC_br, pAddAwbGlobal->AwbFade2Parm.pMinC_br, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMinC_sr    = malloc(sizeof(float) * nArraySize1);
+    pAwbFade2Parm->pMinC_sr    = CamCalibDbMalloc(sizeof(float) * nArraySize1);
     MEMCPY(pAwbFade2Parm->pMinC_sr, pAddAwbGlobal->AwbFade2Parm.pMinC_sr, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMaxY_br    = malloc(sizeof(float) * nArraySize1);
+    pAwbFade2Parm->pMaxY_br    = CamCalibDbMalloc(sizeof(float) * nArraySize1);
     MEMCPY(pAwbFade2Parm->pMaxY_br, pAddAwbGlobal->AwbFade2Parm.pMaxY_br, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMaxY_sr    = malloc(sizeof(float) * nArraySize1);
+    pAwbFade2Parm->pMaxY_sr    = CamCalibDbMalloc(sizeof(float) * nArraySize1);
     MEMCPY(pAwbFade2Parm->pMaxY_sr, pAddAwbGlobal->AwbFade2Parm.pMaxY_sr, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMinY_br    = malloc(sizeof(float) * nArraySize1);
+    pAwbFade2Parm->pMinY_br    = CamCalibDbMalloc(sizeof(float) * nArraySize1);
     MEMCPY(pAwbFade2Parm->pMinY_br, pAddAwbGlobal->AwbFade2Parm.pMinY_br, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pMinY_sr    = malloc(sizeof(float) * nArraySize1);
-    MEMCPY(pAwbFade2Parm->pMinY_sr, pAddAwbGlobal->AwbFade2Parm.pMinY_sr, sizeof(float) *  nArraySize1);pAwbFade2Parm->pRefCb = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pMinY_sr    = CamCalibDbMalloc(sizeof(float) * nArraySize1);
+    MEMCPY(pAwbFade2Parm->pMinY_sr, pAddAwbGlobal->AwbFade2Parm.pMinY_sr, sizeof(float) *  nArraySize1);pAwbFade2Parm->pRefCb = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pRefCb, pAddAwbGlobal->AwbFade2Parm.pRefCb, sizeof(float) *  nArraySize1);
-    pAwbFade2Parm->pRefCr = malloc(sizeof(float) *  nArraySize1);
+    pAwbFade2Parm->pRefCr = CamCalibDbMalloc(sizeof(float) *  nArraySize1);
     MEMCPY(pAwbFade2Parm->pRefCr, pAddAwbGlobal->AwbFade2Parm.pRefCr, sizeof(float) *  nArraySize1);
 
     ListPrepareItem(pNewAwbGlobal);
@@ -2644,7 +2464,7 @@ RESULT CamCalibDbGetAwb_V10_GlobalByResolution
   }
 
   /* search resolution by name */
-  *pAwbGlobal = (CamCalibAwb_V10_Global_t*)ListSearch(&pCamCalibDbCtx->pAwbProfile->Para_V10.awb_global, SearchAwb_V10_GlobalByResolution, (void*)ResName);
+  *pAwbGlobal = (CamCalibAwb_V10_Global_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V10.awb_global, CamCalibAwb_V10_Global_t, resolution, ResName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -2675,7 +2495,7 @@ RESULT CamCalibDbGetAwb_V11_GlobalByResolution
   }
 
   /* search resolution by name */
-  *pAwbGlobal = (CamCalibAwb_V11_Global_t*)ListSearch(&pCamCalibDbCtx->pAwbProfile->Para_V11.awb_global, SearchAwb_V11_GlobalByResolution, (void*)ResName);
+  *pAwbGlobal = (CamCalibAwb_V11_Global_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V11.awb_global, CamCalibAwb_V11_Global_t, resolution, ResName);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -2699,13 +2519,15 @@ RESULT CamCalibDbAddAfGlobal
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   /* check if data already exists */
   if (NULL != pCamCalibDbCtx->pAfGlobal) {
     return (RET_INVALID_PARM);
   }
 
   /* finally allocate, copy & add data */
-  CamCalibAfGlobal_t* pNewAfGlobal = malloc(sizeof(CamCalibAfGlobal_t));
+  CamCalibAfGlobal_t* pNewAfGlobal = CamCalibDbMalloc(sizeof(CamCalibAfGlobal_t));
   if (NULL == pNewAfGlobal) {
     return (RET_OUTOFMEM);
   }
@@ -2766,6 +2588,8 @@ RESULT CamCalibDbAddAecGlobal
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateAecGlobalData(pAddAecGlobal);
   if (result != RET_SUCCESS) {
     return (result);
@@ -2777,7 +2601,7 @@ RESULT CamCalibDbAddAecGlobal
   }
 
   /* finally allocate, copy & add data */
-  CamCalibAecGlobal_t* pNewAecGlobal = malloc(sizeof(CamCalibAecGlobal_t));
+  CamCalibAecGlobal_t* pNewAecGlobal = CamCalibDbMalloc(sizeof(CamCalibAecGlobal_t));
   if (NULL == pNewAecGlobal) {
     return (RET_OUTOFMEM);
   }
@@ -2864,6 +2688,8 @@ RESULT CamCalibDbAddEcmProfile
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateEcmProfile(pAddEcmProfile);
   if (result != RET_SUCCESS) {
     return (result);
@@ -2876,7 +2702,7 @@ RESULT CamCalibDbAddEcmProfile
   }
 
   /* finally allocate, copy & add profile */
-  pNewEcmProfile = malloc(sizeof(CamEcmProfile_t));
+  pNewEcmProfile = CamCalibDbMalloc(sizeof(CamEcmProfile_t));
   if (NULL == pNewEcmProfile) {
     return (RET_OUTOFMEM);
   }
@@ -2924,7 +2750,7 @@ RESULT CamCalibDbGetNoOfEcmProfiles
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pCamCalibDbCtx->ecm_profile);
+  *no = (uint32_t)CamCalibDbIndexNoItems(pCamCalibDbCtx, &pCamCalibDbCtx->ecm_profile);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -2991,7 +2817,7 @@ RESULT CamCalibDbGetEcmProfileByName
   }
 
   /* search profile by name */
-  *ppEcmProfile = (CamEcmProfile_t*)ListSearch(&pCamCalibDbCtx->ecm_profile, SearchEcmProfileByName, (void*)EcmProfileName);
+  *ppEcmProfile = (CamEcmProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->ecm_profile, CamEcmProfile_t, name, EcmProfileName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -3022,7 +2848,7 @@ RESULT CamCalibDbGetEcmProfileByIdx
   }
 
   /* search profile by index */
-  *ppEcmProfile = (CamEcmProfile_t*)ListGetItemByIdx(&pCamCalibDbCtx->ecm_profile, idx);
+  *ppEcmProfile = (CamEcmProfile_t*)CamCalibDbIndexGetItem(pCamCalibDbCtx, &pCamCalibDbCtx->ecm_profile, idx);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -3051,6 +2877,8 @@ RESULT CamCalibDbAddEcmScheme
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   if (NULL == pEcmProfile) {
     return (RET_INVALID_PARM);
   }
@@ -3067,7 +2895,7 @@ RESULT CamCalibDbAddEcmScheme
   }
 
   /* finally allocate, copy & add scheme */
-  pNewEcmScheme = malloc(sizeof(CamEcmScheme_t));
+  pNewEcmScheme = CamCalibDbMalloc(sizeof(CamEcmScheme_t));
   if (NULL == pNewEcmScheme) {
     return (RET_OUTOFMEM);
   }
@@ -3108,7 +2936,7 @@ RESULT CamCalibDbGetNoOfEcmSchemes
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pEcmProfile->ecm_scheme);
+  *no = (uint32_t)CamCalibDbIndexNoItems(pCamCalibDbCtx, &pEcmProfile->ecm_scheme);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -3140,7 +2968,7 @@ RESULT CamCalibDbGetEcmSchemeByName
   }
 
   /* search scheme by name */
-  *ppEcmScheme = (CamEcmScheme_t*)ListSearch(&pEcmProfile->ecm_scheme, SearchEcmSchemeByName, (void*)EcmSchemeName);
+  *ppEcmScheme = (CamEcmScheme_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pEcmProfile->ecm_scheme, CamEcmScheme_t, name, EcmSchemeName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -3176,7 +3004,7 @@ RESULT CamCalibDbGetEcmSchemeByIdx
   }
 
   /* search EC scheme by index */
-  *ppEcmScheme = (CamEcmScheme_t*)ListGetItemByIdx(&pEcmProfile->ecm_scheme, idx);
+  *ppEcmScheme = (CamEcmScheme_t*)CamCalibDbIndexGetItem(pCamCalibDbCtx, &pEcmProfile->ecm_scheme, idx);
 
   return (RET_SUCCESS);
 }
@@ -3203,6 +3031,8 @@ RESULT CamCalibDbAddDySetpoint
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   if (NULL == pAecGlobal) {
     return (RET_INVALID_PARM);
   }
@@ -3219,22 +3049,22 @@ RESULT CamCalibDbAddDySetpoint
   }
 
   /* finally allocate, copy & add scheme */
-  pNewDySetpoint = malloc(sizeof(CamCalibAecDynamicSetpoint_t));
+  pNewDySetpoint = CamCalibDbMalloc(sizeof(CamCalibAecDynamicSetpoint_t));
   if (NULL == pNewDySetpoint) {
     return (RET_OUTOFMEM);
   }
   MEMCPY(pNewDySetpoint, pAddDySetpoint, sizeof(CamCalibAecDynamicSetpoint_t));
 
   if (0 != pAddDySetpoint->array_size) {
-    pDySetpoint = malloc(pAddDySetpoint->array_size * sizeof(float));
+    pDySetpoint = CamCalibDbMalloc(pAddDySetpoint->array_size * sizeof(float));
     if (NULL == pDySetpoint) {
-      free(pNewDySetpoint);
+      CamCalibDbFree(pNewDySetpoint);
       return (RET_OUTOFMEM);
     }
-    pExpValue = malloc(pAddDySetpoint->array_size * sizeof(float));
+    pExpValue = CamCalibDbMalloc(pAddDySetpoint->array_size * sizeof(float));
     if (NULL == pExpValue) {
-      free(pNewDySetpoint);
-      free(pDySetpoint);
+      CamCalibDbFree(pNewDySetpoint);
+      CamCalibDbFree(pDySetpoint);
       return (RET_OUTOFMEM);
     }
 
@@ -3278,7 +3108,7 @@ RESULT CamCalibDbGetNoOfDySetpoint
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pAecGlobal->DySetpointList);
+  *no = (uint32_t)CamCalibDbIndexNoItems(pCamCalibDbCtx, &pAecGlobal->DySetpointList);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -3310,7 +3140,7 @@ RESULT CamCalibDbGetDySetpointByName
   }
 
   /* search scheme by name */
-  *ppDySetpoint = (CamCalibAecDynamicSetpoint_t*)ListSearch(&pAecGlobal->DySetpointList, SearchDySetpointProfileByName, (void*)DySetpointName);
+  *ppDySetpoint = (CamCalibAecDynamicSetpoint_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pAecGlobal->DySetpointList, CamCalibAecDynamicSetpoint_t, name, DySetpointName);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -3345,7 +3175,7 @@ RESULT CamCalibDbGetDySetpointByIdx
   }
 
   /* search EC scheme by index */
-  *ppDySetpoint = (CamCalibAecDynamicSetpoint_t*)ListGetItemByIdx(&pAecGlobal->DySetpointList, idx);
+  *ppDySetpoint = (CamCalibAecDynamicSetpoint_t*)CamCalibDbIndexGetItem(pCamCalibDbCtx, &pAecGlobal->DySetpointList, idx);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -3373,6 +3203,8 @@ RESULT CamCalibDbAddExpSeparate
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   if (NULL == pAecGlobal) {
     return (RET_INVALID_PARM);
   }
@@ -3389,7 +3221,7 @@ RESULT CamCalibDbAddExpSeparate
   }
 
   /* finally allocate, copy & add scheme */
-  pNewExpSeparate = malloc(sizeof(CamCalibAecExpSeparate_t));
+  pNewExpSeparate = CamCalibDbMalloc(sizeof(CamCalibAecExpSeparate_t));
   if (NULL == pNewExpSeparate) {
     return (RET_OUTOFMEM);
   }
@@ -3429,7 +3261,7 @@ RESULT CamCalibDbGetNoOfExpSeparate
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pAecGlobal->ExpSeparateList);
+  *no = (uint32_t)CamCalibDbIndexNoItems(pCamCalibDbCtx, &pAecGlobal->ExpSeparateList);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -3461,7 +3293,7 @@ RESULT CamCalibDbGetExpSeparateByName
   }
 
   /* search scheme by name */
-  *ppExpSeparate = (CamCalibAecExpSeparate_t*)ListSearch(&pAecGlobal->ExpSeparateList, SearchExpSeparateProfileByName, (void*)ExpSeparateName);
+  *ppExpSeparate = (CamCalibAecExpSeparate_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pAecGlobal->ExpSeparateList, CamCalibAecExpSeparate_t, name, ExpSeparateName);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -3496,7 +3328,7 @@ RESULT CamCalibDbGetExpSeparateByIdx
   }
 
   /* search EC scheme by index */
-  *ppExpSeparate = (CamCalibAecExpSeparate_t*)ListGetItemByIdx(&pAecGlobal->ExpSeparateList, idx);
+  *ppExpSeparate = (CamCalibAecExpSeparate_t*)CamCalibDbIndexGetItem(pCamCalibDbCtx, &pAecGlobal->ExpSeparateList, idx);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -3525,7 +3357,7 @@ RESULT CamCalibDbGetNoOfAwb_V11_Illuminations
   }
 
   /* search resolution by name */
-  *no = (uint32_t)ListNoItems(&pCamCalibDbCtx->pAwbProfile->Para_V11.illumination);
+  *no = (uint32_t)CamCalibDbIndexNoItems(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V11.illumination);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -3554,7 +3386,7 @@ RESULT CamCalibDbGetNoOfAwb_V10_Illuminations
   }
 
   /* search resolution by name */
-  *no = (uint32_t)ListNoItems(&pCamCalibDbCtx->pAwbProfile->Para_V10.illumination);
+  *no = (uint32_t)CamCalibDbIndexNoItems(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V10.illumination);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -3609,6 +3441,8 @@ RESULT CamCalibDbAddAwb_V11_Illumination
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateAwb_V11_Illumination(pAddIllu);
   if (result != RET_SUCCESS) {
     return (result);
@@ -3618,7 +3452,7 @@ RESULT CamCalibDbAddAwb_V11_Illumination
   pNewIllu = (CamAwb_V11_IlluProfile_t*)ListSearch(&pCamCalibDbCtx->pAwbProfile->Para_V11.illumination, SearchForEqualAwb_V11_Illumination, (void*)pAddIllu);
   if (NULL == pNewIllu) {
     /* allocate and copy the illumination profile */
-    pNewIllu = (CamAwb_V11_IlluProfile_t*)malloc(sizeof(CamAwb_V11_IlluProfile_t));
+    pNewIllu = (CamAwb_V11_IlluProfile_t*)CamCalibDbMalloc(sizeof(CamAwb_V11_IlluProfile_t));
     MEMCPY(pNewIllu, pAddIllu, sizeof(CamAwb_V11_IlluProfile_t));
 
     /* remove pointer from outside allocated memory,
@@ -3636,8 +3470,8 @@ RESULT CamCalibDbAddAwb_V11_Illumination
     n_items = pAddIllu->SaturationCurve.ArraySize;
     n_memsize = (n_items * sizeof(float));
     pNewIllu->SaturationCurve.ArraySize = n_items;
-    pNewIllu->SaturationCurve.pSensorGain = malloc(n_memsize);
-    pNewIllu->SaturationCurve.pSaturation = malloc(n_memsize);
+    pNewIllu->SaturationCurve.pSensorGain = CamCalibDbMalloc(n_memsize);
+    pNewIllu->SaturationCurve.pSaturation = CamCalibDbMalloc(n_memsize);
     MEMCPY(pNewIllu->SaturationCurve.pSensorGain, pAddIllu->SaturationCurve.pSensorGain, n_memsize);
     MEMCPY(pNewIllu->SaturationCurve.pSaturation, pAddIllu->SaturationCurve.pSaturation, n_memsize);
 
@@ -3645,8 +3479,8 @@ RESULT CamCalibDbAddAwb_V11_Illumination
     n_items = pAddIllu->VignettingCurve.ArraySize;
     n_memsize = (n_items * sizeof(float));
     pNewIllu->VignettingCurve.ArraySize = n_items;
-    pNewIllu->VignettingCurve.pSensorGain = malloc(n_memsize);
-    pNewIllu->VignettingCurve.pVignetting = malloc(n_memsize);
+    pNewIllu->VignettingCurve.pSensorGain = CamCalibDbMalloc(n_memsize);
+    pNewIllu->VignettingCurve.pVignetting = CamCalibDbMalloc(n_memsize);
     MEMCPY(pNewIllu->VignettingCurve.pSensorGain, pAddIllu->VignettingCurve.pSensorGain, n_memsize);
     MEMCPY(pNewIllu->VignettingCurve.pVignetting, pAddIllu->VignettingCurve.pVignetting, n_memsize);
 
@@ -3679,6 +3513,8 @@ RESULT CamCalibDbAddAwb_V10_Illumination
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateAwb_V10_Illumination(pAddIllu);
   if (result != RET_SUCCESS) {
     return (result);
@@ -3688,7 +3524,7 @@ RESULT CamCalibDbAddAwb_V10_Illumination
   pNewIllu = (CamAwb_V10_IlluProfile_t*)ListSearch(&pCamCalibDbCtx->pAwbProfile->Para_V10.illumination, SearchForEqualAwb_V10_Illumination, (void*)pAddIllu);
   if (NULL == pNewIllu) {
     /* allocate and copy the illumination profile */
-    pNewIllu = (CamAwb_V10_IlluProfile_t*)malloc(sizeof(CamAwb_V10_IlluProfile_t));
+    pNewIllu = (CamAwb_V10_IlluProfile_t*)CamCalibDbMalloc(sizeof(CamAwb_V10_IlluProfile_t));
     MEMCPY(pNewIllu, pAddIllu, sizeof(CamAwb_V10_IlluProfile_t));
 
     /* remove pointer from outside allocated memory,
@@ -3706,8 +3542,8 @@ RESULT CamCalibDbAddAwb_V10_Illumination
     n_items = pAddIllu->SaturationCurve.ArraySize;
     n_memsize = (n_items * sizeof(float));
     pNewIllu->SaturationCurve.ArraySize = n_items;
-    pNewIllu->SaturationCurve.pSensorGain = malloc(n_memsize);
-    pNewIllu->SaturationCurve.pSaturation = malloc(n_memsize);
+    pNewIllu->SaturationCurve.pSensorGain = CamCalibDbMalloc(n_memsize);
+    pNewIllu->SaturationCurve.pSaturation = CamCalibDbMalloc(n_memsize);
     MEMCPY(pNewIllu->SaturationCurve.pSensorGain, pAddIllu->SaturationCurve.pSensorGain, n_memsize);
     MEMCPY(pNewIllu->SaturationCurve.pSaturation, pAddIllu->SaturationCurve.pSaturation, n_memsize);
 
@@ -3715,8 +3551,8 @@ RESULT CamCalibDbAddAwb_V10_Illumination
     n_items = pAddIllu->VignettingCurve.ArraySize;
     n_memsize = (n_items * sizeof(float));
     pNewIllu->VignettingCurve.ArraySize = n_items;
-    pNewIllu->VignettingCurve.pSensorGain = malloc(n_memsize);
-    pNewIllu->VignettingCurve.pVignetting = malloc(n_memsize);
+    pNewIllu->VignettingCurve.pSensorGain = CamCalibDbMalloc(n_memsize);
+    pNewIllu->VignettingCurve.pVignetting = CamCalibDbMalloc(n_memsize);
     MEMCPY(pNewIllu->VignettingCurve.pSensorGain, pAddIllu->VignettingCurve.pSensorGain, n_memsize);
     MEMCPY(pNewIllu->VignettingCurve.pVignetting, pAddIllu->VignettingCurve.pVignetting, n_memsize);
 
@@ -3753,7 +3589,7 @@ RESULT CamCalibDbGetAwb_V11_IlluminationByName
   }
 
   /* search resolution by name */
-  *pIllumination = (CamAwb_V11_IlluProfile_t*)ListSearch(&pCamCalibDbCtx->pAwbProfile->Para_V11.illumination, SearchAwb_V11_IlluminationByName, (void*)name);
+  *pIllumination = (CamAwb_V11_IlluProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V11.illumination, CamAwb_V11_IlluProfile_t, name, name);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -3784,7 +3620,7 @@ RESULT CamCalibDbGetAwb_V10_IlluminationByName
   }
 
   /* search resolution by name */
-  *pIllumination = (CamAwb_V10_IlluProfile_t*)ListSearch(&pCamCalibDbCtx->pAwbProfile->Para_V10.illumination, SearchAwb_V10_IlluminationByName, (void*)name);
+  *pIllumination = (CamAwb_V10_IlluProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V10.illumination, CamAwb_V10_IlluProfile_t, name, name);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -3846,7 +3682,7 @@ RESULT CamCalibDbGetAwb_V11_IlluminationByIdx
   }
 
   /* search resolution by name */
-  *pIllumination = (CamAwb_V11_IlluProfile_t*)ListGetItemByIdx(&pCamCalibDbCtx->pAwbProfile->Para_V11.illumination, idx);
+  *pIllumination = (CamAwb_V11_IlluProfile_t*)CamCalibDbIndexGetItem(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V11.illumination, idx);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -3877,7 +3713,7 @@ RESULT CamCalibDbGetAwb_V10_IlluminationByIdx
   }
 
   /* search resolution by name */
-  *pIllumination = (CamAwb_V10_IlluProfile_t*)ListGetItemByIdx(&pCamCalibDbCtx->pAwbProfile->Para_V10.illumination, idx);
+  *pIllumination = (CamAwb_V10_IlluProfile_t*)CamCalibDbIndexGetItem(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V10.illumination, idx);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -3905,6 +3741,8 @@ RESULT CamCalibDbAddLscProfile
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateLscProfile(pAddLsc);
   if (result != RET_SUCCESS) {
     return (result);
@@ -3913,7 +3751,7 @@ RESULT CamCalibDbAddLscProfile
   /* check if resolution already exists */
   pNewLsc = (CamLscProfile_t*)ListSearch(&pCamCalibDbCtx->lsc_profile, SearchForEqualLscProfile, (void*)pAddLsc);
   if (NULL == pNewLsc) {
-    pNewLsc = malloc(sizeof(CamLscProfile_t));
+    pNewLsc = CamCalibDbMalloc(sizeof(CamLscProfile_t));
     MEMCPY(pNewLsc, pAddLsc, sizeof(CamLscProfile_t));
 
     ListPrepareItem(pNewLsc);
@@ -3951,7 +3789,7 @@ RESULT CamCalibDbGetLscProfileByName
   }
 
   /* search resolution by name */
-  *pLscProfile = (CamLscProfile_t*)ListSearch(&pCamCalibDbCtx->lsc_profile, SearchLscProfileByName, (void*)name);
+  *pLscProfile = (CamLscProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->lsc_profile, CamLscProfile_t, name, name);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -3980,7 +3818,7 @@ RESULT CamCalibDbGetLscProfileByIdx
   }
 
   /* search resolution by name */
-  *pLscProfile = (CamLscProfile_t*)ListGetItemByIdx(&pCamCalibDbCtx->lsc_profile, idx);
+  *pLscProfile = (CamLscProfile_t*)CamCalibDbIndexGetItem(pCamCalibDbCtx, &pCamCalibDbCtx->lsc_profile, idx);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -4004,6 +3842,8 @@ RESULT CamCalibDbDelLscProfileByName
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   /* search resolution by name */
   *pLscProfile = (CamLscProfile_t*)ListRemoveItem(&pCamCalibDbCtx->lsc_profile, SearchLscProfileByName, (void*)name);
 
@@ -4028,6 +3868,8 @@ RESULT CamCalibDbReplaceLscProfileAll
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   /* search resolution by name */
   ListForEach(&pCamCalibDbCtx->lsc_profile, ReplaceLscProfile, (void*)pLscProfile);
 
@@ -4055,6 +3897,8 @@ RESULT CamCalibDbAddCcProfile
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateCcProfile(pAddCc);
   if (result != RET_SUCCESS) {
     return (result);
@@ -4063,7 +3907,7 @@ RESULT CamCalibDbAddCcProfile
   /* check if resolution already exists */
   pNewCc = (CamCcProfile_t*)ListSearch(&pCamCalibDbCtx->cc_profile, SearchForEqualCcProfile, (void*)pAddCc);
   if (NULL == pNewCc) {
-    pNewCc = malloc(sizeof(CamCcProfile_t));
+    pNewCc = CamCalibDbMalloc(sizeof(CamCcProfile_t));
     MEMCPY(pNewCc, pAddCc, sizeof(CamCcProfile_t));
 
     ListPrepareItem(pNewCc);
@@ -4096,6 +3940,8 @@ RESULT CamCalibDbReplaceCcProfileByName
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateCcProfile(pAddCc);
   if (result != RET_SUCCESS) {
     return (result);
@@ -4133,6 +3979,8 @@ RESULT CamCalibDbReplaceCcProfileAll
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateCcProfile(pAddCc);
   if (result != RET_SUCCESS) {
     return (result);
@@ -4172,7 +4020,7 @@ RESULT CamCalibDbGetCcProfileByName
   }
 
   /* search resolution by name */
-  *pCcProfile = (CamCcProfile_t*)ListSearch(&pCamCalibDbCtx->cc_profile, SearchCcProfileByName, (void*)name);
+  *pCcProfile = (CamCcProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->cc_profile, CamCcProfile_t, name, name);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4200,6 +4048,8 @@ RESULT CamCalibDbAddBlsProfile
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateBlsProfile(pAddBls);
   if (result != RET_SUCCESS) {
     return (result);
@@ -4208,7 +4058,7 @@ RESULT CamCalibDbAddBlsProfile
   /* check if resolution already exists */
   pNewBls = (CamBlsProfile_t*)ListSearch(&pCamCalibDbCtx->bls_profile, SearchForEqualBlsProfile, (void*)pAddBls);
   if (NULL == pNewBls) {
-    pNewBls = (CamBlsProfile_t*)malloc(sizeof(CamBlsProfile_t));
+    pNewBls = (CamBlsProfile_t*)CamCalibDbMalloc(sizeof(CamBlsProfile_t));
     MEMCPY(pNewBls, pAddBls, sizeof(CamBlsProfile_t));
 
     ListPrepareItem(pNewBls);
@@ -4246,7 +4096,7 @@ RESULT CamCalibDbGetBlsProfileByName
   }
 
   /* search resolution by name */
-  *pBlsProfile = (CamBlsProfile_t*)ListSearch(&pCamCalibDbCtx->bls_profile, SearchBlsProfileByName, (void*)name);
+  *pBlsProfile = (CamBlsProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->bls_profile, CamBlsProfile_t, name, name);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4277,7 +4127,7 @@ RESULT CamCalibDbGetBlsProfileByResolution
   }
 
   /* search resolution by name */
-  *pBlsProfile = (CamBlsProfile_t*)ListSearch(&pCamCalibDbCtx->bls_profile, SearchBlsProfileByResolution, (void*)ResName);
+  *pBlsProfile = (CamBlsProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->bls_profile, CamBlsProfile_t, resolution, ResName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4305,6 +4155,8 @@ RESULT CamCalibDbAddCacProfile
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateCacProfile(pAddCac);
   if (result != RET_SUCCESS) {
     return (result);
@@ -4313,7 +4165,7 @@ RESULT CamCalibDbAddCacProfile
   /* check if resolution already exists */
   pNewCac = (CamCacProfile_t*)ListSearch(&pCamCalibDbCtx->cac_profile, SearchForEqualCacProfile, (void*)pAddCac);
   if (NULL == pNewCac) {
-    pNewCac = (CamCacProfile_t*)malloc(sizeof(CamCacProfile_t));
+    pNewCac = (CamCacProfile_t*)CamCalibDbMalloc(sizeof(CamCacProfile_t));
     MEMCPY(pNewCac, pAddCac, sizeof(CamCacProfile_t));
 
     ListPrepareItem(pNewCac);
@@ -4351,7 +4203,7 @@ RESULT CamCalibDbGetCacProfileByName
   }
 
   /* search resolution by name */
-  *pCacProfile = (CamCacProfile_t*)ListSearch(&pCamCalibDbCtx->cac_profile, SearchCacProfileByName, (void*)name);
+  *pCacProfile = (CamCacProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->cac_profile, CamCacProfile_t, name, name);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4382,7 +4234,7 @@ RESULT CamCalibDbGetCacProfileByResolution
   }
 
   /* search resolution by name */
-  *pCacProfile = (CamCacProfile_t*)ListSearch(&pCamCalibDbCtx->cac_profile, SearchCacProfileByResolution, (void*)ResName);
+  *pCacProfile = (CamCacProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->cac_profile, CamCacProfile_t, resolution, ResName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4407,6 +4259,8 @@ RESULT CamCalibDbReplaceDpfProfileAll
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateDpfProfile(pRepDpf);
   if (result != RET_SUCCESS) {
     return (result);
@@ -4449,6 +4303,8 @@ RESULT CamCalibDbReplaceDpfProfile
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateDpfProfile(pRepDpf);
   if (result != RET_SUCCESS) {
     return (result);
@@ -4493,6 +4349,8 @@ RESULT CamCalibDbAddDpfProfile
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateDpfProfile(pAddDpf);
   if (result != RET_SUCCESS) {
     return (result);
@@ -4501,7 +4359,7 @@ RESULT CamCalibDbAddDpfProfile
   /* check if resolution already exists */
   pNewDpf = (CamDpfProfile_t*)ListSearch(&pCamCalibDbCtx->dpf_profile, SearchForEqualDpfProfile, (void*)pAddDpf);
   if (NULL == pNewDpf) {
-    pNewDpf = (CamDpfProfile_t*)malloc(sizeof(CamDpfProfile_t));
+    pNewDpf = (CamDpfProfile_t*)CamCalibDbMalloc(sizeof(CamDpfProfile_t));
     MEMCPY(pNewDpf, pAddDpf, sizeof(CamDpfProfile_t));
 	ListInit(&pNewDpf->Dsp3DNRSettingProfileList);   // clear possibly not empty schemes list in copy
 	ListInit(&pNewDpf->newDsp3DNRProfileList);   // clear possibly not empty schemes list in copy
@@ -4575,7 +4433,7 @@ RESULT CamCalibDbGetDpfProfileByName
   }
 
   /* search resolution by name */
-  *pDpfProfile = (CamDpfProfile_t*)ListSearch(&pCamCalibDbCtx->dpf_profile, SearchDpfProfileByName, (void*)name);
+  *pDpfProfile = (CamDpfProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->dpf_profile, CamDpfProfile_t, name, name);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4606,7 +4464,7 @@ RESULT CamCalibDbGetDpfProfileByResolution
   }
 
   /* search resolution by name */
-  *pDpfProfile = (CamDpfProfile_t*)ListSearch(&pCamCalibDbCtx->dpf_profile, SearchDpfProfileByResolution, (void*)ResName);
+  *pDpfProfile = (CamDpfProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->dpf_profile, CamDpfProfile_t, resolution, ResName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4635,6 +4493,8 @@ RESULT CamCalibDbAddFilterProfile
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   if (NULL == pDpfProfile) {
     return (RET_INVALID_PARM);
   }
@@ -4651,7 +4511,7 @@ RESULT CamCalibDbAddFilterProfile
   }
 
   /* finally allocate, copy & add scheme */
-  pNewFilter = malloc(sizeof(CamFilterProfile_t));
+  pNewFilter = CamCalibDbMalloc(sizeof(CamFilterProfile_t));
   if (NULL == pNewFilter) {
     return (RET_OUTOFMEM);
   }
@@ -4690,7 +4550,7 @@ RESULT CamCalibDbGetNoOfFilterProfile
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pDpfProfile->FilterList);
+  *no = (uint32_t)CamCalibDbIndexNoItems(pCamCalibDbCtx, &pDpfProfile->FilterList);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4720,7 +4580,7 @@ RESULT CamCalibDbGetFilterProfileByName
   }
 
   /* search scheme by name */
-  *ppFilterProfile = (CamFilterProfile_t*)ListSearch(&pDpfProfile->FilterList, SearchFilterProfileByName, (void*)FilterProfileName);
+  *ppFilterProfile = (CamFilterProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pDpfProfile->FilterList, CamFilterProfile_t, name, FilterProfileName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4754,7 +4614,7 @@ RESULT CamCalibDbGetFilterProfileByIdx
   }
 
   /* search EC scheme by index */
-  *ppFilterProfile = (CamFilterProfile_t*)ListGetItemByIdx(&pDpfProfile->FilterList, idx);
+  *ppFilterProfile = (CamFilterProfile_t*)CamCalibDbIndexGetItem(pCamCalibDbCtx, &pDpfProfile->FilterList, idx);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4782,6 +4642,8 @@ RESULT CamCalibDbAddNewDsp3DNRSetting
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   if (NULL == pDpfProfile) {
     return (RET_INVALID_PARM);
   }
@@ -4798,7 +4660,7 @@ RESULT CamCalibDbAddNewDsp3DNRSetting
   }
 
   /* finally allocate, copy & add scheme */
-  pNewDsp3dnrSetting = malloc(sizeof(CamNewDsp3DNRProfile_t));
+  pNewDsp3dnrSetting = CamCalibDbMalloc(sizeof(CamNewDsp3DNRProfile_t));
   if (NULL == pNewDsp3dnrSetting) {
     return (RET_OUTOFMEM);
   }
@@ -4837,7 +4699,7 @@ RESULT CamCalibDbGetNoOfNewDsp3DNRSetting
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pDpfProfile->newDsp3DNRProfileList);
+  *no = (uint32_t)CamCalibDbIndexNoItems(pCamCalibDbCtx, &pDpfProfile->newDsp3DNRProfileList);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -4867,7 +4729,7 @@ RESULT CamCalibDbGetNewDsp3DNRSettingByName
   }
 
   /* search scheme by name */
-  *ppNewDsp3DnrSetting = (CamNewDsp3DNRProfile_t*)ListSearch(&pDpfProfile->newDsp3DNRProfileList, SearchNewDsp3DNRSettingByName, (void*)NewDsp3DNRSettingName);
+  *ppNewDsp3DnrSetting = (CamNewDsp3DNRProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pDpfProfile->newDsp3DNRProfileList, CamNewDsp3DNRProfile_t, name, NewDsp3DNRSettingName);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -4901,7 +4763,7 @@ RESULT CamCalibDbGetNewDsp3DNRByIdx
   }
 
   /* search EC scheme by index */
-  *ppNewDsp3DnrSetting = (CamNewDsp3DNRProfile_t*)ListGetItemByIdx(&pDpfProfile->newDsp3DNRProfileList, idx);
+  *ppNewDsp3DnrSetting = (CamNewDsp3DNRProfile_t*)CamCalibDbIndexGetItem(pCamCalibDbCtx, &pDpfProfile->newDsp3DNRProfileList, idx);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -4929,6 +4791,8 @@ RESULT CamCalibDbAddDsp3DNRSetting
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   if (NULL == pDpfProfile) {
     return (RET_INVALID_PARM);
   }
@@ -4945,7 +4809,7 @@ RESULT CamCalibDbAddDsp3DNRSetting
   }
 
   /* finally allocate, copy & add scheme */
-  pNewDsp3dnrSetting = malloc(sizeof(CamDsp3DNRSettingProfile_t));
+  pNewDsp3dnrSetting = CamCalibDbMalloc(sizeof(CamDsp3DNRSettingProfile_t));
   if (NULL == pNewDsp3dnrSetting) {
     return (RET_OUTOFMEM);
   }
@@ -4984,7 +4848,7 @@ RESULT CamCalibDbGetNoOfDsp3DNRSetting
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pDpfProfile->Dsp3DNRSettingProfileList);
+  *no = (uint32_t)CamCalibDbIndexNoItems(pCamCalibDbCtx, &pDpfProfile->Dsp3DNRSettingProfileList);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5016,7 +4880,7 @@ RESULT CamCalibDbGetDsp3DNRSettingByName
   }
 
   /* search scheme by name */
-  *ppDsp3DnrSetting = (CamDsp3DNRSettingProfile_t*)ListSearch(&pDpfProfile->Dsp3DNRSettingProfileList, SearchDsp3DNRSettingByName, (void*)Dsp3DNRSettingName);
+  *ppDsp3DnrSetting = (CamDsp3DNRSettingProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pDpfProfile->Dsp3DNRSettingProfileList, CamDsp3DNRSettingProfile_t, name, Dsp3DNRSettingName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5052,7 +4916,7 @@ RESULT CamCalibDbGetDsp3DNRByIdx
   }
 
   /* search EC scheme by index */
-  *ppDsp3DnrSetting = (CamDsp3DNRSettingProfile_t*)ListGetItemByIdx(&pDpfProfile->Dsp3DNRSettingProfileList, idx);
+  *ppDsp3DnrSetting = (CamDsp3DNRSettingProfile_t*)CamCalibDbIndexGetItem(pCamCalibDbCtx, &pDpfProfile->Dsp3DNRSettingProfileList, idx);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5080,6 +4944,8 @@ RESULT CamCalibDbAddDpccProfile
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateDpccProfile(pAddDpcc);
   if (result != RET_SUCCESS) {
     return (result);
@@ -5088,7 +4954,7 @@ RESULT CamCalibDbAddDpccProfile
   /* check if resolution already exists */
   pNewDpcc = (CamDpccProfile_t*)ListSearch(&pCamCalibDbCtx->dpcc_profile, SearchForEqualDpccProfile, (void*)pAddDpcc);
   if (NULL == pNewDpcc) {
-    pNewDpcc = (CamDpccProfile_t*)malloc(sizeof(CamDpccProfile_t));
+    pNewDpcc = (CamDpccProfile_t*)CamCalibDbMalloc(sizeof(CamDpccProfile_t));
     MEMCPY(pNewDpcc, pAddDpcc, sizeof(CamDpccProfile_t));
 
     ListPrepareItem(pNewDpcc);
@@ -5126,7 +4992,7 @@ RESULT CamCalibDbGetDpccfProfileByName
   }
 
   /* search resolution by name */
-  *pDpccProfile = (CamDpccProfile_t*)ListSearch(&pCamCalibDbCtx->dpcc_profile, SearchDpccProfileByName, (void*)name);
+  *pDpccProfile = (CamDpccProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->dpcc_profile, CamDpccProfile_t, name, name);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5157,7 +5023,7 @@ RESULT CamCalibDbGetDpccProfileByResolution
   }
 
   /* search resolution by name */
-  *pDpccProfile = (CamDpccProfile_t*)ListSearch(&pCamCalibDbCtx->dpcc_profile, SearchDpccProfileByResolution, (void*)ResName);
+  *pDpccProfile = (CamDpccProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->dpcc_profile, CamDpccProfile_t, resolution, ResName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5187,6 +5053,8 @@ RESULT CamCalibDbAddRKsharpenProfile
         return ( RET_WRONG_HANDLE );
     }
 
+    CamCalibDbIndexRelease(pCamCalibDbCtx);
+
     result = ValidateIesharpenProfile( pAddIesharpen );
     if ( result != RET_SUCCESS )
     {
@@ -5197,7 +5065,7 @@ RESULT CamCalibDbAddRKsharpenProfile
     pNewIesharpen = (CamIesharpenProfile_t *)ListSearch( &pCamCalibDbCtx->iesharpen_profile, SearchForEqualIesharpenProfile, (void *)pAddIesharpen );
     if ( NULL == pNewIesharpen )
     {
-        pNewIesharpen = (CamIesharpenProfile_t *)malloc( sizeof(CamIesharpenProfile_t) );
+        pNewIesharpen = (CamIesharpenProfile_t *)CamCalibDbMalloc( sizeof(CamIesharpenProfile_t) );
         MEMCPY( pNewIesharpen, pAddIesharpen, sizeof(CamIesharpenProfile_t) );
 
         ListPrepareItem( pNewIesharpen );
@@ -5240,7 +5108,7 @@ RESULT CamCalibDbGetRKsharpenProfileByName
     }
 
     /* search resolution by name */
-    *pIesharpenProfile = (CamIesharpenProfile_t *)ListSearch( &pCamCalibDbCtx->iesharpen_profile, SearchIesharpenProfileByName, (void *)name );
+    *pIesharpenProfile = (CamIesharpenProfile_t *)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->iesharpen_profile, CamIesharpenProfile_t, name, name);
 
     LOGV("%s (exit)\n", __func__);
 
@@ -5274,7 +5142,7 @@ RESULT CamCalibDbGetRKsharpenProfileByResolution
     }
 
     /* search resolution by name */
-    *pIesharpenProfile = (CamIesharpenProfile_t *)ListSearch( &pCamCalibDbCtx->iesharpen_profile, SearchIesharpenProfileByResolution, (void *)ResName );
+    *pIesharpenProfile = (CamIesharpenProfile_t *)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->iesharpen_profile, CamIesharpenProfile_t, resolution, ResName);
 
     LOGV("%s (exit)\n", __func__);
 
@@ -5356,6 +5224,8 @@ RESULT CamCalibDbAddGocProfile
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateGocProfileData(pAddGocProfile);
   if (result != RET_SUCCESS) {
     return (result);
@@ -5363,7 +5233,7 @@ RESULT CamCalibDbAddGocProfile
   
   pNewGoc = (CamCalibGocProfile_t*)ListSearch(&pCamCalibDbCtx->gocProfile, SearchForEqualGocProfile, (void*)pAddGocProfile);
   if (NULL == pNewGoc) {
-   pNewGoc = (CamCalibGocProfile_t*)malloc(sizeof(CamCalibGocProfile_t));
+   pNewGoc = (CamCalibGocProfile_t*)CamCalibDbMalloc(sizeof(CamCalibGocProfile_t));
    if(pNewGoc != NULL){
      MEMCPY(pNewGoc, pAddGocProfile, sizeof(CamCalibGocProfile_t));
      ListPrepareItem(pNewGoc);
@@ -5403,7 +5273,7 @@ RESULT CamCalibDbGetNoOfGocProfile
   }
 
   /* search resolution by name */
-  *no = (uint32_t)ListNoItems(&pCamCalibDbCtx->gocProfile);
+  *no = (uint32_t)CamCalibDbIndexNoItems(pCamCalibDbCtx, &pCamCalibDbCtx->gocProfile);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5433,7 +5303,7 @@ RESULT CamCalibDbGetGocProfileByName
    }
  
    /* search resolution by name */
-   *ppGocProfile = (CamCalibGocProfile_t*)ListSearch(&pCamCalibDbCtx->gocProfile, SearchGocProfileByName, (void*)name);
+   *ppGocProfile = (CamCalibGocProfile_t*)CAM_CALIBDB_INDEX_SEARCH_NAME(pCamCalibDbCtx, &pCamCalibDbCtx->gocProfile, CamCalibGocProfile_t, name, name);
  
    LOGV("%s (exit)\n", __func__);
  
@@ -5463,7 +5333,7 @@ RESULT CamCalibDbGetGocProfileByIdx
   }
 
   /* search resolution by name */
-  *ppGocProfile = (CamCalibGocProfile_t*)ListGetItemByIdx(&pCamCalibDbCtx->gocProfile, idx);
+  *ppGocProfile = (CamCalibGocProfile_t*)CamCalibDbIndexGetItem(pCamCalibDbCtx, &pCamCalibDbCtx->gocProfile, idx);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5502,6 +5372,8 @@ RESULT CamCalibDbAddWdrGlobal
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   result = ValidateWdrGlobalData(pAddWdrGlobal);
   if (result != RET_SUCCESS) {
     return (result);
@@ -5513,7 +5385,7 @@ RESULT CamCalibDbAddWdrGlobal
   }
 
   /* finally allocate, copy & add data */
-  CamCalibWdrGlobal_t* pNewWdrGlobal = malloc(sizeof(CamCalibWdrGlobal_t));
+  CamCalibWdrGlobal_t* pNewWdrGlobal = CamCalibDbMalloc(sizeof(CamCalibWdrGlobal_t));
   if (NULL == pNewWdrGlobal) {
     return (RET_OUTOFMEM);
   }
@@ -5573,13 +5445,15 @@ RESULT CamCalibDbAddCproc
     return (RET_WRONG_HANDLE);
   }
 
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
   /* check if data already exists */
   if (NULL != pCamCalibDbCtx->pCprocGlobal) {
     return (RET_INVALID_PARM);
   }
 
   /* finally allocate, copy & add data */
-  CamCprocProfile_t* pNewCprocGlobal = malloc(sizeof(CamCprocProfile_t));
+  CamCprocProfile_t* pNewCprocGlobal = CamCalibDbMalloc(sizeof(CamCprocProfile_t));
   if (NULL == pNewCprocGlobal) {
     return (RET_OUTOFMEM);
   }
@@ -0,0 +1,88 @@
+/******************************************************************************
+ *
+ * Copyright 2019, Fuzhou Rockchip Electronics Co.Ltd . All rights reserved.
+ * No part of this work may be reproduced, modified, distributed, transmitted,
+ * transcribed, or translated into any language or computer format, in any form
+ * or by any means without written permission of:
+ * Fuzhou Rockchip Electronics Co.Ltd .
+ *
+ *
+ *****************************************************************************/
+/**
+ * @file cam_calibdb_arena.c
+ *
+ * @brief
+ *   Implementation of the CamCalibDb arena.
+ *
+ *****************************************************************************/
+#include <stdlib.h>
+
+#include <cam_calibdb/cam_calibdb_arena.h>
+
+/******************************************************************************
+ * local variable declarations
+ *****************************************************************************/
+/* one arena per thread, databases of several cameras are built concurrently */
+static __thread CamCalibDbArena_t* pBoundArena = NULL;
+
+
+
+/******************************************************************************
+ * CamCalibDbArenaBind
+ *****************************************************************************/
+void CamCalibDbArenaBind
+(
+    CamCalibDbArena_t*  pArena
+) {
+  pBoundArena = pArena;
+}
+
+
+
+/******************************************************************************
+ * CamCalibDbMalloc
+ *****************************************************************************/
+void* CamCalibDbMalloc
+(
+    size_t  size
+) {
+  CamCalibDbArena_t* pArena = pBoundArena;
+  size_t aligned;
+
+  if (pArena == NULL) {
+    return (malloc(size));
+  }
+
+  aligned = (size + CAM_CALIBDB_ARENA_ALIGN - 1) & ~(size_t)(CAM_CALIBDB_ARENA_ALIGN - 1);
+  if ((aligned < size) || (aligned > pArena->capacity - pArena->used)) {
+    /* the database stays usable, it just can not be stored as an image */
+    pArena->overflow = 1;
+    return (malloc(size));
+  }
+
+  /* the region is zeroed and never reused, blocks start out zeroed */
+  void* p = pArena->base + pArena->used;
+  pArena->used += aligned;
+
+  return (p);
+}
+
+
+
+/******************************************************************************
+ * CamCalibDbFree
+ *****************************************************************************/
+void CamCalibDbFree
+(
+    void*  p
+) {
+  CamCalibDbArena_t* pArena = pBoundArena;
+
+  if ((pArena != NULL)
+      && ((uint8_t*)p >= pArena->base)
+      && ((uint8_t*)p < pArena->base + pArena->capacity)) {
+    return;
+  }
+
+  free(p);
+}
@@ -0,0 +1,541 @@
+/******************************************************************************
+ *
+ * Copyright 2019, Fuzhou Rockchip Electronics Co.Ltd . All rights reserved.
+ * No part of this work may be reproduced, modified, distributed, transmitted,
+ * transcribed, or translated into any language or computer format, in any form
+ * or by any means without written permission of:
+ * Fuzhou Rockchip Electronics Co.Ltd .
+ *
+ *
+ *****************************************************************************/
+/**
+ * @file cam_calibdb_index.c
+ *
+ * @brief
+ *   Implementation of the CamCalibDb index.
+ *
+ *****************************************************************************/
+#include <ebase/builtins.h>
+#include <ebase/dct_assert.h>
+#include <base/log.h>
+
+#include "cam_calibdb_api.h"
+#include "cam_calibdb.h"
+#include "cam_calibdb_index.h"
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************
+ * local type definitions
+ *****************************************************************************/
+typedef struct CamCalibDbKeyDesc_s {
+  size_t  offset;
+  size_t  size;
+  int     isName;
+} CamCalibDbKeyDesc_t;
+
+#define NAME_KEY(type, field) \
+  { offsetof(type, field), sizeof(((type*)0)->field), 1 }
+
+/* a first pass only counts the lists, the second one indexes them */
+typedef struct CamCalibDbIndexWalk_s {
+  CamCalibDbIndex_t*  pIndex;
+  int                 noLists;
+} CamCalibDbIndexWalk_t;
+
+
+
+/******************************************************************************
+ * local functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * HashKey
+ *****************************************************************************/
+static uint32_t HashKey
+(
+    const uint8_t*  key,
+    size_t          size,
+    int             isName
+) {
+  uint32_t hash = 2166136261u;
+  size_t i;
+
+  /* a name ends at its terminator, as strncmp compares it */
+  for (i = 0; (i < size) && !(isName && (key[i] == '\0')); i++) {
+    hash = (hash ^ key[i]) * 16777619u;
+  }
+
+  return (hash);
+}
+
+
+
+/******************************************************************************
+ * HashList
+ *****************************************************************************/
+static uint32_t HashList
+(
+    const List*  l
+) {
+  return ((uint32_t)(((uintptr_t)l >> 3) * 2654435761u));
+}
+
+
+
+/******************************************************************************
+ * KeyEqual
+ *****************************************************************************/
+static int KeyEqual
+(
+    const void*   item,
+    size_t        offset,
+    size_t        size,
+    int           isName,
+    const void*   key
+) {
+  const char* field = (const char*)item + offset;
+
+  return (isName ? !strncmp(field, (const char*)key, size) : !memcmp(field, key, size));
+}
+
+
+
+/******************************************************************************
+ * FindList
+ *****************************************************************************/
+static CamCalibDbListIndex_t* FindList
+(
+    const CamCalibDbIndex_t*  pIndex,
+    const List*               l
+) {
+  uint32_t slot;
+
+  if (pIndex == NULL) {
+    return (NULL);
+  }
+
+  for (slot = HashList(l) & pIndex->mask; pIndex->pLists[slot].pList != NULL;
+       slot = (slot + 1) & pIndex->mask) {
+    if (pIndex->pLists[slot].pList == l) {
+      return (&pIndex->pLists[slot]);
+    }
+  }
+
+  return (NULL);
+}
+
+
+
+/******************************************************************************
+ * TableSize
+ *****************************************************************************/
+static uint32_t TableSize
+(
+    int  entries
+) {
+  uint32_t size = 2;
+
+  /* at most half full, a miss ends at a free slot soon */
+  while (size < 2 * (uint32_t)entries) {
+    size <<= 1;
+  }
+
+  return (size);
+}
+
+
+
+/******************************************************************************
+ * IndexKey
+ *****************************************************************************/
+static RESULT IndexKey
+(
+    CamCalibDbListIndex_t*      pListIndex,
+    const CamCalibDbKeyDesc_t*  pDesc
+) {
+  CamCalibDbKeyIndex_t* pKey = &pListIndex->keys[pListIndex->noKeys];
+  uint32_t size = TableSize(pListIndex->noItems);
+  int i;
+
+  pKey->offset = pDesc->offset;
+  pKey->size = pDesc->size;
+  pKey->isName = pDesc->isName;
+  pKey->mask = size - 1;
+  pKey->pSlots = (int*)calloc(size, sizeof(int));
+  if (pKey->pSlots == NULL) {
+    return (RET_OUTOFMEM);
+  }
+  pListIndex->noKeys++;
+
+  /* in list order and without duplicates, a probe finds what ListSearch finds */
+  for (i = 0; i < pListIndex->noItems; i++) {
+    const uint8_t* key = (const uint8_t*)pListIndex->ppItems[i] + pKey->offset;
+    uint32_t slot = HashKey(key, pKey->size, pKey->isName) & pKey->mask;
+    int found = 0;
+
+    for (; pKey->pSlots[slot] != 0; slot = (slot + 1) & pKey->mask) {
+      if (KeyEqual(pListIndex->ppItems[pKey->pSlots[slot] - 1],
+                   pKey->offset, pKey->size, pKey->isName, key)) {
+        found = 1;
+        break;
+      }
+    }
+
+    if (!found) {
+      pKey->pSlots[slot] = i + 1;
+    }
+  }
+
+  return (RET_SUCCESS);
+}
+
+
+
+/******************************************************************************
+ * IndexList
+ *****************************************************************************/
+static RESULT IndexList
+(
+    CamCalibDbIndexWalk_t*      pWalk,
+    List*                       l,
+    const CamCalibDbKeyDesc_t*  pKeys,
+    int                         noKeys
+) {
+  CamCalibDbIndex_t* pIndex = pWalk->pIndex;
+  CamCalibDbListIndex_t* pListIndex;
+  uint32_t slot;
+  List* item;
+  RESULT result;
+  int i;
+
+  DCT_ASSERT(noKeys <= CAM_CALIBDB_INDEX_KEYS);
+
+  pWalk->noLists++;
+  if ((pIndex->pLists == NULL) || (FindList(pIndex, l) != NULL)) {
+    return (RET_SUCCESS);
+  }
+
+  slot = HashList(l) & pIndex->mask;
+  while (pIndex->pLists[slot].pList != NULL) {
+    slot = (slot + 1) & pIndex->mask;
+  }
+
+  pListIndex = &pIndex->pLists[slot];
+  pListIndex->pList = l;
+  pListIndex->noItems = ListNoItems(l);
+  pListIndex->ppItems = (void**)malloc((pListIndex->noItems + 1) * sizeof(void*));
+  if (pListIndex->ppItems == NULL) {
+    return (RET_OUTOFMEM);
+  }
+
+  for (i = 0, item = ListHead(l); item != NULL; i++, item = item->p_next) {
+    pListIndex->ppItems[i] = item;
+  }
+
+  for (i = 0; i < noKeys; i++) {
+    result = IndexKey(pListIndex, &pKeys[i]);
+    if (result != RET_SUCCESS) {
+      return (result);
+    }
+  }
+
+  return (RET_SUCCESS);
+}
+
+
+
+/******************************************************************************
+ * IndexWalk
+ *
+ * Visits every list of the database with the keys its getters search by.
+ *****************************************************************************/
+#define INDEX_LIST(l, keys, n)                                  \
+  do {                                                          \
+    RESULT res = IndexList(pWalk, (l), (keys), (n));            \
+    if (res != RET_SUCCESS) {                                   \
+      return (res);                                             \
+    }                                                           \
+  } while (0)
+
+static RESULT IndexWalk
+(
+    CamCalibDbContext_t*    pCamCalibDbCtx,
+    CamCalibDbIndexWalk_t*  pWalk
+) {
+  static const CamCalibDbKeyDesc_t resolutionKeys[] = {
+    { offsetof(CamResolution_t, width),
+      offsetof(CamResolution_t, height) + sizeof(((CamResolution_t*)0)->height)
+      - offsetof(CamResolution_t, width), 0 },
+  };
+  static const CamCalibDbKeyDesc_t awb11GlobalKeys[] = {
+    NAME_KEY(CamCalibAwb_V11_Global_t, resolution),
+  };
+  static const CamCalibDbKeyDesc_t awb10GlobalKeys[] = {
+    NAME_KEY(CamCalibAwb_V10_Global_t, resolution),
+  };
+  static const CamCalibDbKeyDesc_t awb11IlluKeys[] = {
+    NAME_KEY(CamAwb_V11_IlluProfile_t, name),
+  };
+  static const CamCalibDbKeyDesc_t awb10IlluKeys[] = {
+    NAME_KEY(CamAwb_V10_IlluProfile_t, name),
+  };
+  static const CamCalibDbKeyDesc_t ecmProfileKeys[] = {
+    NAME_KEY(CamEcmProfile_t, name),
+  };
+  static const CamCalibDbKeyDesc_t ecmSchemeKeys[] = {
+    NAME_KEY(CamEcmScheme_t, name),
+  };
+  static const CamCalibDbKeyDesc_t dySetpointKeys[] = {
+    NAME_KEY(CamCalibAecDynamicSetpoint_t, name),
+  };
+  static const CamCalibDbKeyDesc_t expSeparateKeys[] = {
+    NAME_KEY(CamCalibAecExpSeparate_t, name),
+  };
+  static const CamCalibDbKeyDesc_t gocKeys[] = {
+    NAME_KEY(CamCalibGocProfile_t, name),
+  };
+  static const CamCalibDbKeyDesc_t lscKeys[] = {
+    NAME_KEY(CamLscProfile_t, name),
+  };
+  static const CamCalibDbKeyDesc_t ccKeys[] = {
+    NAME_KEY(CamCcProfile_t, name),
+  };
+  static const CamCalibDbKeyDesc_t blsKeys[] = {
+    NAME_KEY(CamBlsProfile_t, name),
+    NAME_KEY(CamBlsProfile_t, resolution),
+  };
+  static const CamCalibDbKeyDesc_t cacKeys[] = {
+    NAME_KEY(CamCacProfile_t, name),
+    NAME_KEY(CamCacProfile_t, resolution),
+  };
+  static const CamCalibDbKeyDesc_t dpfKeys[] = {
+    NAME_KEY(CamDpfProfile_t, name),
+    NAME_KEY(CamDpfProfile_t, resolution),
+  };
+  static const CamCalibDbKeyDesc_t filterKeys[] = {
+    NAME_KEY(CamFilterProfile_t, name),
+  };
+  static const CamCalibDbKeyDesc_t dsp3dnrKeys[] = {
+    NAME_KEY(CamDsp3DNRSettingProfile_t, name),
+  };
+  static const CamCalibDbKeyDesc_t newDsp3dnrKeys[] = {
+    NAME_KEY(CamNewDsp3DNRProfile_t, name),
+  };
+  static const CamCalibDbKeyDesc_t dpccKeys[] = {
+    NAME_KEY(CamDpccProfile_t, name),
+    NAME_KEY(CamDpccProfile_t, resolution),
+  };
+  static const CamCalibDbKeyDesc_t iesharpenKeys[] = {
+    NAME_KEY(CamIesharpenProfile_t, name),
+    NAME_KEY(CamIesharpenProfile_t, resolution),
+  };
+  List* l;
+
+  INDEX_LIST(&pCamCalibDbCtx->resolution, resolutionKeys, 1);
+
+  if (pCamCalibDbCtx->pAwbProfile != NULL) {
+    INDEX_LIST(&pCamCalibDbCtx->pAwbProfile->Para_V11.awb_global, awb11GlobalKeys, 1);
+    INDEX_LIST(&pCamCalibDbCtx->pAwbProfile->Para_V10.awb_global, awb10GlobalKeys, 1);
+    INDEX_LIST(&pCamCalibDbCtx->pAwbProfile->Para_V11.illumination, awb11IlluKeys, 1);
+    INDEX_LIST(&pCamCalibDbCtx->pAwbProfile->Para_V10.illumination, awb10IlluKeys, 1);
+  }
+
+  INDEX_LIST(&pCamCalibDbCtx->ecm_profile, ecmProfileKeys, 1);
+  for (l = ListHead(&pCamCalibDbCtx->ecm_profile); l != NULL; l = l->p_next) {
+    INDEX_LIST(&((CamEcmProfile_t*)l)->ecm_scheme, ecmSchemeKeys, 1);
+  }
+
+  if (pCamCalibDbCtx->pAecGlobal != NULL) {
+    INDEX_LIST(&pCamCalibDbCtx->pAecGlobal->DySetpointList, dySetpointKeys, 1);
+    INDEX_LIST(&pCamCalibDbCtx->pAecGlobal->ExpSeparateList, expSeparateKeys, 1);
+  }
+
+  INDEX_LIST(&pCamCalibDbCtx->gocProfile, gocKeys, 1);
+  INDEX_LIST(&pCamCalibDbCtx->lsc_profile, lscKeys, 1);
+  INDEX_LIST(&pCamCalibDbCtx->cc_profile, ccKeys, 1);
+  INDEX_LIST(&pCamCalibDbCtx->bls_profile, blsKeys, 2);
+  INDEX_LIST(&pCamCalibDbCtx->cac_profile, cacKeys, 2);
+
+  INDEX_LIST(&pCamCalibDbCtx->dpf_profile, dpfKeys, 2);
+  for (l = ListHead(&pCamCalibDbCtx->dpf_profile); l != NULL; l = l->p_next) {
+    INDEX_LIST(&((CamDpfProfile_t*)l)->FilterList, filterKeys, 1);
+    INDEX_LIST(&((CamDpfProfile_t*)l)->Dsp3DNRSettingProfileList, dsp3dnrKeys, 1);
+    INDEX_LIST(&((CamDpfProfile_t*)l)->newDsp3DNRProfileList, newDsp3dnrKeys, 1);
+  }
+
+  INDEX_LIST(&pCamCalibDbCtx->dpcc_profile, dpccKeys, 2);
+  INDEX_LIST(&pCamCalibDbCtx->iesharpen_profile, iesharpenKeys, 2);
+
+  return (RET_SUCCESS);
+}
+
+
+
+/******************************************************************************
+ * CamCalibDbIndexCreate
+ *****************************************************************************/
+RESULT CamCalibDbIndexCreate
+(
+    CamCalibDbContext_t*  pCamCalibDbCtx
+) {
+  CamCalibDbIndexWalk_t walk;
+  CamCalibDbIndex_t* pIndex;
+  uint32_t size;
+  RESULT result;
+
+  CamCalibDbIndexRelease(pCamCalibDbCtx);
+
+  pIndex = (CamCalibDbIndex_t*)calloc(1, sizeof(CamCalibDbIndex_t));
+  if (pIndex == NULL) {
+    return (RET_OUTOFMEM);
+  }
+
+  walk.pIndex = pIndex;
+  walk.noLists = 0;
+  result = IndexWalk(pCamCalibDbCtx, &walk);
+  DCT_ASSERT(result == RET_SUCCESS);
+
+  size = TableSize(walk.noLists);
+  pIndex->mask = size - 1;
+  pIndex->pLists = (CamCalibDbListIndex_t*)calloc(size, sizeof(CamCalibDbListIndex_t));
+  if (pIndex->pLists == NULL) {
+    free(pIndex);
+    return (RET_OUTOFMEM);
+  }
+
+  /* published when complete, lookups never see a partial index */
+  walk.noLists = 0;
+  result = IndexWalk(pCamCalibDbCtx, &walk);
+  pCamCalibDbCtx->pIndex = pIndex;
+  if (result != RET_SUCCESS) {
+    CamCalibDbIndexRelease(pCamCalibDbCtx);
+  }
+
+  return (result);
+}
+
+
+
+/******************************************************************************
+ * CamCalibDbIndexRelease
+ *****************************************************************************/
+void CamCalibDbIndexRelease
+(
+    CamCalibDbContext_t*  pCamCalibDbCtx
+) {
+  CamCalibDbIndex_t* pIndex;
+  uint32_t i;
+  int k;
+
+  if ((pCamCalibDbCtx == NULL) || (pCamCalibDbCtx->pIndex == NULL)) {
+    return;
+  }
+
+  pIndex = pCamCalibDbCtx->pIndex;
+  pCamCalibDbCtx->pIndex = NULL;
+
+  for (i = 0; i <= pIndex->mask; i++) {
+    CamCalibDbListIndex_t* pListIndex = &pIndex->pLists[i];
+    for (k = 0; k < pListIndex->noKeys; k++) {
+      free(pListIndex->keys[k].pSlots);
+    }
+    free(pListIndex->ppItems);
+  }
+  free(pIndex->pLists);
+  free(pIndex);
+}
+
+
+
+/******************************************************************************
+ * CamCalibDbIndexNoItems
+ *****************************************************************************/
+int CamCalibDbIndexNoItems
+(
+    CamCalibDbContext_t*  pCamCalibDbCtx,
+    List*                 l
+) {
+  CamCalibDbListIndex_t* pListIndex = FindList(pCamCalibDbCtx->pIndex, l);
+
+  if (pListIndex == NULL) {
+    return (ListNoItems(l));
+  }
+
+  return (pListIndex->noItems);
+}
+
+
+
+/******************************************************************************
+ * CamCalibDbIndexGetItem
+ *****************************************************************************/
+List* CamCalibDbIndexGetItem
+(
+    CamCalibDbContext_t*  pCamCalibDbCtx,
+    List*                 l,
+    const int             idx
+) {
+  CamCalibDbListIndex_t* pListIndex = FindList(pCamCalibDbCtx->pIndex, l);
+
+  if (pListIndex == NULL) {
+    return (ListGetItemByIdx(l, idx));
+  }
+
+  if (idx >= pListIndex->noItems) {
+    return (NULL);
+  }
+
+  /* ListGetItemByIdx returns the head for a negative index */
+  return ((List*)pListIndex->ppItems[(idx < 0) ? 0 : idx]);
+}
+
+
+
+/******************************************************************************
+ * CamCalibDbIndexSearch
+ *****************************************************************************/
+List* CamCalibDbIndexSearch
+(
+    CamCalibDbContext_t*  pCamCalibDbCtx,
+    List*                 l,
+    size_t                offset,
+    size_t                size,
+    int                   isName,
+    const void*           key
+) {
+  CamCalibDbListIndex_t* pListIndex = FindList(pCamCalibDbCtx->pIndex, l);
+  CamCalibDbKeyIndex_t* pKey = NULL;
+  List* item;
+  uint32_t slot;
+  int k;
+
+  if (pListIndex != NULL) {
+    for (k = 0; k < pListIndex->noKeys; k++) {
+      if ((pListIndex->keys[k].offset == offset) && (pListIndex->keys[k].size == size)
+          && (pListIndex->keys[k].isName == isName)) {
+        pKey = &pListIndex->keys[k];
+        break;
+      }
+    }
+  }
+
+  if (pKey == NULL) {
+    for (item = ListHead(l); item != NULL; item = item->p_next) {
+      if (KeyEqual(item, offset, size, isName, key)) {
+        return (item);
+      }
+    }
+    return (NULL);
+  }
+
+  for (slot = HashKey((const uint8_t*)key, size, isName) & pKey->mask; pKey->pSlots[slot] != 0;
+       slot = (slot + 1) & pKey->mask) {
+    item = (List*)pListIndex->ppItems[pKey->pSlots[slot] - 1];
+    if (KeyEqual(item, offset, size, isName, key)) {
+      return (item);
+    }
+  }
+
+  return (NULL);
+}
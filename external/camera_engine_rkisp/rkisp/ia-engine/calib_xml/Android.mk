@@ -3,6 +3,7 @@ include $(CLEAR_VARS)
 
 LOCAL_SRC_FILES:=\
 				calibdb.cpp\
+				calibdb_cache.cpp\
 				xmltags.cpp\
 
 LOCAL_C_INCLUDES := \
@@ -13,6 +13,9 @@
  *
  *****************************************************************************/
 #include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <unistd.h>
 #include <ebase/builtins.h>
 #include <ebase/dct_assert.h>
 
@@ -20,12 +23,15 @@
 #include <common/cam_types.h>
 
 #include <cam_calibdb/cam_calibdb_api.h>
+#include <cam_calibdb/cam_calibdb_arena.h>
 #include <string>
 #include <iostream>
 
 #include "calib_xml/calibdb.h"
 #include "calibtags.h"
 #include "xmltags.h"
+#include "calibdb_cache.h"
+#include "calibdb_scan.h"
 
 #include   <fstream>
 
@@ -136,96 +142,7 @@ static int ParseFloatArray
     float*       values,            /**< pointer to memory */
     const int   num                 /**< number of expected float values */
 ) {
-  float* value = values;
-  char* str    = (char*)c_string;
-  int last = strlen(str);
-  /* calc. end adress of string */
-  char* str_last = str + (last - 1);
-
-  std::string s_string(str);
-  size_t find_start = s_string.find("[", 0);
-  size_t find_end = s_string.find("]", 0);
-
-  if ((find_start == std::string::npos) || (find_end == std::string::npos)) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << "start" << find_start << "end" << find_end << std::endl;
-#endif
-    return -1;
-  }
-
-  str = (char*)c_string + find_start;
-  str_last = (char*)c_string + find_end;
-
-#if 0
-  while (*str == 0x20) {
-    str++;
-  }
-
-  while (*str_last == 0x20) {
-    str_last--;
-  }
-
-  /* check for beginning/closing parenthesis */
-  if ((str[0] != '[') || (str_last[0] != ']')) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << std::endl;
-    redirectOut << "str[0]:(" << str[0] << ")" << std::endl;
-    redirectOut << "str_last[0]:(" << str_last[0] << ")" << std::endl;
-    redirectOut << "strings:(" << str << ")" << std::endl;
-#endif
-    return (-1);
-  }
-#endif
-
-  /* skipped left parenthesis */
-  str++;
-
-  /* skip spaces */
-  while (*str == 0x20 || *str == 0x09 || (*str == 0x0a) || (*str == 0x0d)) {
-    str++;
-  }
-
-  int cnt = 0;
-  int scanned;
-  float f;
-
-  /* parse the c-string */
-  while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%f", &f);
-    if (scanned != 1) {
-      redirectOut << __func__ << "f" << f << "err" << std::endl;
-      goto err1;
-    } else {
-      value[cnt] = f;
-      cnt++;
-    }
-
-    /* remove detected float */
-    while ((*str != 0x20)  && (*str != ',') && (*str != ']')) {
-      str++;
-    }
-
-    /* skip spaces and comma */
-    while ((*str == 0x20) || (*str == ',') || (*str == 0x09) || (*str == 0x0a) || (*str == 0x0d)) {
-      str++;
-    }
-  }
-
-#ifdef DEBUG_LOG
-  for (int i = 0; i < cnt; i++) {
-    redirectOut << value[i] << ", ";
-  }
-  redirectOut << std::endl;
-  redirectOut << std::endl;
-#endif
-
-  return (cnt);
-
-err1:
-  MEMSET(values, 0, (sizeof(float) * num));
-
-  return (0);
-
+  return (ParseNumberArray<float, float>(c_string, values, num, redirectOut, __func__));
 }
 
 /******************************************************************************
@@ -237,96 +154,7 @@ static int ParseUintArray
     uint32_t*      values,            /**< pointer to memory */
     const int   num                 /**< number of expected float values */
 ) {
-  uint32_t*  value  = values;
-  char* str       = (char*)c_string;
-
-  int last = strlen(str);
-  char* str_last = str + (last - 1);
-
-  std::string s_string(str);
-  size_t find_start = s_string.find("[", 0);
-  size_t find_end = s_string.find("]", 0);
-
-  if ((find_start == std::string::npos) || (find_end == std::string::npos)) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << "start" << find_start << "end" << find_end << std::endl;
-#endif
-    return -1;
-  }
-
-  str = (char*)c_string + find_start;
-  str_last = (char*)c_string + find_end;
-
-#if 0
-  while (*str == 0x20) {
-    str++;
-  }
-
-  while (*str_last == 0x20) {
-    str_last--;
-  }
-
-  /* check for beginning/closing parenthesis */
-  if ((str[0] != '[') || (str_last[0] != ']')) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << std::endl;
-    redirectOut << "str[0]:(" << str[0] << ")" << std::endl;
-    redirectOut << "str_last[0]:(" << str_last[0] << ")" << std::endl;
-    redirectOut << "strings:(" << str << ")" << std::endl;
-#endif
-    return (-1);
-  }
-#endif
-
-  /* calc. end adress of string */
-  // char *str_last = str + (last-1);
-
-  /* skipped left parenthesis */
-  str++;
-
-  /* skip spaces */
-  while (*str == 0x20 || *str == 0x09 || (*str == 0x0a) || (*str == 0x0d)) {
-    str++;
-  }
-
-  int cnt = 0;
-  int scanned;
-  uint32_t f;
-
-  /* parse the c-string */
-  while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%u", &f);
-    if (scanned != 1) {
-      redirectOut << __func__ << "f" << f << "err" << std::endl;
-      goto err1;
-    } else {
-      value[cnt] = f;
-      cnt++;
-    }
-
-    /* remove detected float */
-    while ((*str != 0x20)  && (*str != ',') && (*str != ']')) {
-      str++;
-    }
-
-    /* skip spaces and comma */
-    while ((*str == 0x20) || (*str == ',') || (*str == 0x09) || (*str == 0x0a) || (*str == 0x0d)) {
-      str++;
-    }
-  }
-
-#ifdef DEBUG_LOG
-  for (int i = 0; i < cnt; i++) {
-    redirectOut << value[i] << ", ";
-  }
-  redirectOut << std::endl;
-  redirectOut << std::endl;
-#endif
-  return (cnt);
-err1:
-  MEMSET(values, 0, (sizeof(uint32_t) * num));
-
-  return (0);
+  return (ParseNumberArray<uint32_t, uint32_t>(c_string, values, num, redirectOut, __func__));
 }
 
 /******************************************************************************
@@ -338,97 +166,7 @@ static int ParseUcharArray
     unsigned char*      values,            /**< pointer to memory */
     const int   num                 /**< number of expected float values */
 ) {
-  unsigned char*  value  = values;
-  char* str       = (char*)c_string;
-
-  int last = strlen(str);
-  char* str_last = str + (last - 1);
-
-  std::string s_string(str);
-  size_t find_start = s_string.find("[", 0);
-  size_t find_end = s_string.find("]", 0);
-
-  if ((find_start == std::string::npos) || (find_end == std::string::npos)) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << "start" << find_start << "end" << find_end << std::endl;
-#endif
-    return -1;
-  }
-
-  str = (char*)c_string + find_start;
-  str_last = (char*)c_string + find_end;
-
-#if 0
-  while (*str == 0x20) {
-    str++;
-  }
-
-  while (*str_last == 0x20) {
-    str_last--;
-  }
-
-  /* check for beginning/closing parenthesis */
-  if ((str[0] != '[') || (str_last[0] != ']')) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << std::endl;
-    redirectOut << "str[0]:(" << str[0] << ")" << std::endl;
-    redirectOut << "str_last[0]:(" << str_last[0] << ")" << std::endl;
-    redirectOut << "strings:(" << str << ")" << std::endl;
-#endif
-    return (-1);
-  }
-#endif
-
-  /* calc. end adress of string */
-  // char *str_last = str + (last-1);
-
-  /* skipped left parenthesis */
-  str++;
-
-  /* skip spaces */
-  while (*str == 0x20 || *str == 0x09 || (*str == 0x0a) || (*str == 0x0d)) {
-    str++;
-  }
-
-  int cnt = 0;
-  int scanned;
-  uint8_t f;
-
-  /* parse the c-string */
-  while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%hhu", &f);
-    if (scanned != 1) {
-      redirectOut << __func__ << "f" << f << "err" << std::endl;
-      goto err1;
-    } else {
-      value[cnt] = f;
-      cnt++;
-    }
-
-    /* remove detected float */
-    while ((*str != 0x20)  && (*str != ',') && (*str != ']')) {
-      str++;
-    }
-
-    /* skip spaces and comma */
-    while ((*str == 0x20) || (*str == ',') || (*str == 0x09) || (*str == 0x0a) || (*str == 0x0d)) {
-      str++;
-    }
-  }
-
-#ifdef DEBUG_LOG
-  for (int i = 0; i < cnt; i++) {
-    int x = value[i];
-    redirectOut << x << ", ";
-  }
-  redirectOut << std::endl;
-  redirectOut << std::endl;
-#endif
-  return (cnt);
-err1:
-  MEMSET(values, 0, (sizeof(uint8_t) * num));
-
-  return (0);
+  return (ParseNumberArray<uint8_t, uint8_t>(c_string, values, num, redirectOut, __func__));
 }
 /******************************************************************************
  * ParseUchartArray//cxf
@@ -439,97 +177,7 @@ static int ParseCharArray
     int8_t*      values,            /**< pointer to memory */
     const int   num                 /**< number of expected float values */
 ) {
-  int8_t*  value  = values;
-  char* str       = (char*)c_string;
-
-  int last = strlen(str);
-  char* str_last = str + (last - 1);
-
-  std::string s_string(str);
-  size_t find_start = s_string.find("[", 0);
-  size_t find_end = s_string.find("]", 0);
-
-  if ((find_start == std::string::npos) || (find_end == std::string::npos)) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << "start" << find_start << "end" << find_end << std::endl;
-#endif
-    return -1;
-  }
-
-  str = (char*)c_string + find_start;
-  str_last = (char*)c_string + find_end;
-
-#if 0
-  while (*str == 0x20) {
-    str++;
-  }
-
-  while (*str_last == 0x20) {
-    str_last--;
-  }
-
-  /* check for beginning/closing parenthesis */
-  if ((str[0] != '[') || (str_last[0] != ']')) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << std::endl;
-    redirectOut << "str[0]:(" << str[0] << ")" << std::endl;
-    redirectOut << "str_last[0]:(" << str_last[0] << ")" << std::endl;
-    redirectOut << "strings:(" << str << ")" << std::endl;
-#endif
-    return (-1);
-  }
-#endif
-
-  /* calc. end adress of string */
-  // char *str_last = str + (last-1);
-
-  /* skipped left parenthesis */
-  str++;
-
-  /* skip spaces */
-  while (*str == 0x20 || *str == 0x09 || (*str == 0x0a) || (*str == 0x0d)) {
-    str++;
-  }
-
-  int cnt = 0;
-  int scanned;
-  int8_t f;
-
-  /* parse the c-string */
-  while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%hhd", &f);
-    if (scanned != 1) {
-      redirectOut << __func__ << "f" << f << "err" << std::endl;
-      goto err1;
-    } else {
-      value[cnt] = f;
-      cnt++;
-    }
-
-    /* remove detected float */
-    while ((*str != 0x20)  && (*str != ',') && (*str != ']')) {
-      str++;
-    }
-
-    /* skip spaces and comma */
-    while ((*str == 0x20) || (*str == ',') || (*str == 0x09) || (*str == 0x0a) || (*str == 0x0d)) {
-      str++;
-    }
-  }
-
-#ifdef DEBUG_LOG
-  for (int i = 0; i < cnt; i++) {
-    int x = value[i];
-    redirectOut  << x << ", ";
-  }
-  redirectOut  << std::endl;
-  redirectOut  << std::endl;
-#endif
-  return (cnt);
-err1:
-  MEMSET(values, 0, (sizeof(uint8_t) * num));
-
-  return (0);
+  return (ParseNumberArray<int8_t, int8_t>(c_string, values, num, redirectOut, __func__));
 }
 
 
@@ -542,101 +190,7 @@ static int ParseUshortArray
     uint16_t*    values,            /**< pointer to memory */
     const int   num                 /**< number of expected float values */
 ) {
-  uint16_t* value = values;
-  char* str       = (char*)c_string;
-  int last = strlen(str);
-  char* str_last = str + (last - 1);
-
-  std::string s_string(str);
-  size_t find_start = s_string.find("[", 0);
-  size_t find_end = s_string.find("]", 0);
-
-  if ((find_start == std::string::npos) || (find_end == std::string::npos)) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << "start" << find_start << "end" << find_end << std::endl;
-#endif
-    return -1;
-  }
-
-  while (*str != '[') {
-    printf("'%c'=%d\n", *str, *str);
-    str++;
-  }
-  str = (char*)c_string + find_start;
-  str_last = (char*)c_string + find_end;
-
-#if 0
-  while (*str == 0x20) {
-    str++;
-  }
-
-  while (*str_last == 0x20) {
-    str_last--;
-  }
-
-  /* check for beginning/closing parenthesis */
-  if ((str[0] != '[') || (str_last[0] != ']')) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << std::endl;
-    redirectOut << "str[0]:(" << str[0] << ")" << std::endl;
-    redirectOut << "str_last[0]:(" << str_last[0] << ")" << std::endl;
-    redirectOut << "strings:(" << str << ")" << std::endl;
-#endif
-    return (-1);
-  }
-#endif
-
-  /* calc. end adress of string */
-  //char *str_last = str + (last-1);
-
-  /* skipped left parenthesis */
-  str++;
-
-  /* skip spaces */
-  while (*str == 0x20 || *str == 0x09 || (*str == 0x0a) || (*str == 0x0d)) {
-    str++;
-  }
-
-  int cnt = 0;
-  int scanned;
-  uint16_t f;
-
-  /* parse the c-string */
-  while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%hu", &f);
-    if (scanned != 1) {
-      redirectOut << __func__ << "f" << f << "err" << std::endl;
-      goto err1;
-    } else {
-      value[cnt] = f;
-      cnt++;
-    }
-
-    /* remove detected float */
-    while ((*str != 0x20)  && (*str != ',') && (*str != ']')) {
-      str++;
-    }
-
-    /* skip spaces and comma */
-    while ((*str == 0x20) || (*str == ',') || (*str == 0x09) || (*str == 0x0a) || (*str == 0x0d)) {
-      str++;
-    }
-  }
-
-#ifdef DEBUG_LOG
-  for (int i = 0; i < cnt; i++) {
-    redirectOut << value[i] << ", ";
-  }
-  redirectOut << std::endl;
-  redirectOut << std::endl;
-#endif
-  return (cnt);
-
-err1:
-  MEMSET(values, 0, (sizeof(uint16_t) * num));
-
-  return (0);
-
+  return (ParseNumberArray<uint16_t, uint16_t>(c_string, values, num, redirectOut, __func__));
 }
 
 
@@ -649,98 +203,7 @@ static int ParseShortArray
     int16_t*     values,            /**< pointer to memory */
     const int   num                 /**< number of expected float values */
 ) {
-  int16_t* value  = values;
-  char* str       = (char*)c_string;
-
-  int last = strlen(str);
-  char* str_last = str + (last - 1);
-
-  std::string s_string(str);
-  size_t find_start = s_string.find("[", 0);
-  size_t find_end = s_string.find("]", 0);
-
-  if ((find_start == std::string::npos) || (find_end == std::string::npos)) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << "start" << find_start << "end" << find_end << std::endl;
-#endif
-    return -1;
-  }
-
-  str = (char*)c_string + find_start;
-  str_last = (char*)c_string + find_end;
-
-#if 0
-  while (*str == 0x20) {
-    str++;
-  }
-
-  while (*str_last == 0x20) {
-    str_last--;
-  }
-
-  /* check for beginning/closing parenthesis */
-  if ((str[0] != '[') || (str_last[0] != ']')) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << std::endl;
-    redirectOut << "str[0]:(" << str[0] << ")" << std::endl;
-    redirectOut << "str_last[0]:(" << str_last[0] << ")" << std::endl;
-    redirectOut << "strings:(" << str << ")" << std::endl;
-#endif
-    return (-1);
-  }
-#endif
-
-  /* calc. end adress of string */
-  // char *str_last = str + (last-1);
-
-  /* skipped left parenthesis */
-  str++;
-
-  /* skip spaces */
-  while (*str == 0x20 || *str == 0x09 || (*str == 0x0a) || (*str == 0x0d)) {
-    str++;
-  }
-
-  int cnt = 0;
-  int scanned;
-  int16_t f;
-
-  /* parse the c-string */
-  while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%hd", &f);
-    if (scanned != 1) {
-      redirectOut << __func__ << "f" << f << "err" << std::endl;
-      goto err1;
-    } else {
-      value[cnt] = f;
-      cnt++;
-    }
-
-    /* remove detected float */
-    while ((*str != 0x20)  && (*str != ',') && (*str != ']')) {
-      str++;
-    }
-
-    /* skip spaces and comma */
-    while ((*str == 0x20) || (*str == ',') || (*str == 0x09) || (*str == 0x0a) || (*str == 0x0d)) {
-      str++;
-    }
-  }
-
-#ifdef DEBUG_LOG
-  for (int i = 0; i < cnt; i++) {
-    redirectOut << value[i] << ", ";
-  }
-  redirectOut << std::endl;
-  redirectOut << std::endl;
-#endif
-  return (cnt);
-
-err1:
-  MEMSET(values, 0, (sizeof(uint16_t) * num));
-
-  return (0);
-
+  return (ParseNumberArray<int16_t, int16_t>(c_string, values, num, redirectOut, __func__));
 }
 
 
@@ -753,89 +216,7 @@ static int ParseByteArray
     uint8_t*     values,            /**< pointer to memory */
     const int   num                 /**< number of expected float values */
 ) {
-  uint8_t* value  = values;
-  char* str       = (char*)c_string;
-  int last = strlen(str);
-  char* str_last = str + (last - 1);
-
-  std::string s_string(str);
-  size_t find_start = s_string.find("[", 0);
-  size_t find_end = s_string.find("]", 0);
-
-  if ((find_start == std::string::npos) || (find_end == std::string::npos)) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << "start" << find_start << "end" << find_end << std::endl;
-#endif
-    return -1;
-  }
-
-  str = (char*)c_string + find_start;
-  str_last = (char*)c_string + find_end;
-
-#if 0
-  /* check for beginning/closing parenthesis */
-  if ((str[0] != '[') || (str_last[0] != ']')) {
-#ifdef DEBUG_LOG
-    redirectOut << __func__ << std::endl;
-    redirectOut << "str[0]:(" << str[0] << ")" << std::endl;
-    redirectOut << "str_last[0]:(" << str_last[0] << ")" << std::endl;
-    redirectOut << "strings:(" << str << ")" << std::endl;
-#endif
-    return (-1);
-  }
-#endif
-
-  /* calc. end adress of string */
-  //char *str_last = str + (last-1);
-
-  /* skipped left parenthesis */
-  str++;
-
-  /* skip spaces */
-  while (*str == 0x20 || *str == 0x09 || (*str == 0x0a) || (*str == 0x0d)) {
-    str++;
-  }
-
-  int cnt = 0;
-  int scanned;
-  uint16_t f;
-
-  /* parse the c-string */
-  while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%hu", &f);
-    if (scanned != 1) {
-      redirectOut << __func__ << "f" << f << "err" << std::endl;
-      goto err1;
-    } else {
-      value[cnt] = (uint8_t)f;
-      cnt++;
-    }
-
-    /* remove detected float */
-    while ((*str != 0x20)  && (*str != ',') && (*str != ']')) {
-      str++;
-    }
-
-    /* skip spaces and comma */
-    while ((*str == 0x20) || (*str == ',') || (*str == 0x09) || (*str == 0x0a) || (*str == 0x0d)) {
-      str++;
-    }
-  }
-
-#ifdef DEBUG_LOG
-  for (int i = 0; i < cnt; i++) {
-    redirectOut << value[i] << ", ";
-  }
-  redirectOut << std::endl;
-  redirectOut << std::endl;
-#endif
-  return (cnt);
-
-err1:
-  MEMSET(values, 0, (sizeof(uint8_t) * num));
-
-  return (0);
-
+  return (ParseNumberArray<uint8_t, uint16_t>(c_string, values, num, redirectOut, __func__));
 }
 
 
@@ -995,6 +376,7 @@ CalibDb::CalibDb
 (
 ) {
   m_CalibDbHandle = NULL;
+  m_CalibDbImage = NULL;
 }
 
 
@@ -1003,7 +385,12 @@ CalibDb::CalibDb
  * CalibReader::CalibReader
  *****************************************************************************/
 CalibDb::~CalibDb() {
-  if (m_CalibDbHandle != NULL) {
+  if (m_CalibDbImage != NULL) {
+    // all blocks of the database live in the image, only the index does not
+    CamCalibDbReleaseIndex(m_CalibDbHandle);
+    delete m_CalibDbImage;
+    m_CalibDbHandle = NULL;
+  } else if (m_CalibDbHandle != NULL) {
     RESULT result = CamCalibDbRelease(&m_CalibDbHandle);
     DCT_ASSERT(result == RET_SUCCESS);
   }
@@ -1018,49 +405,23 @@ bool CalibDb::CreateCalibDb
 (
     const XMLElement*  root
 ) {
-  bool res = true;
-
-  // create calibration-database (c-code)
-  RESULT result = CamCalibDbCreate(&m_CalibDbHandle);
-  DCT_ASSERT(result == RET_SUCCESS);
-
 #ifdef DEBUG_LOG
   redirectOut << __func__ << " (enter)";
 #endif
 
-  // get and parse header section
-  const XMLElement* header = root->FirstChildElement(CALIB_HEADER_TAG);
-  if (!header) {
-    res = parseEntryHeader(header->ToElement(), NULL);
-    if (!res) {
-      return (res);
-    }
-  }
-
-
-  // get and parse sensor section
-  const XMLElement* sensor = root->FirstChildElement(CALIB_SENSOR_TAG);
-  if (!sensor) {
-    res = parseEntrySensor(sensor->ToElement(), NULL);
-    if (!res) {
-      return (res);
-    }
+  // built on the heap, a document has no file to keep an image of
+  if (!parseCalibDb(root)) {
+    return (false);
   }
 
-  // get and parse system section
-  const XMLElement* system = root->FirstChildElement(CALIB_SYSTEM_TAG);
-  if (!system) {
-    res = parseEntrySystem(system->ToElement(), NULL);
-    if (!res) {
-      return (res);
-    }
-  }
+  RESULT result = CamCalibDbBuildIndex(m_CalibDbHandle);
+  DCT_ASSERT(result == RET_SUCCESS);
 
 #ifdef DEBUG_LOG
   redirectOut << __func__ << " (exit)";
 #endif
 
-  return (true);
+  return (result == RET_SUCCESS);
 }
 
 
@@ -1075,35 +436,90 @@ bool CalibDb::CreateCalibDb
   //QString errorString;
   int errorID;
   XMLDocument doc;
+  CalibDbSource source;
 
   bool res = true;
 #ifdef DEBUG_LOG
   redirectOut << __func__ << " (enter)" << std::endl;
 #endif
 
-  RESULT result = CamCalibDbCreate(&m_CalibDbHandle);
-  DCT_ASSERT(result == RET_SUCCESS);
-  errorID = doc.LoadFile(device);
+  if (!CalibDbImage::ReadSource(device, &source)) {
+    redirectOut << "Error: Can not read " << device << std::endl;
+    return (false);
+  }
+
+  std::string imagePath = std::string(device) + CALIBDB_CACHE_SUFFIX;
+  m_CalibDbImage = new CalibDbImage();
+  if (m_CalibDbImage->Load(imagePath.c_str(), &source, &m_CalibDbHandle)) {
+    redirectOut << __func__ << " loaded image " << imagePath << std::endl;
+    CalibDbImage::ReleaseSource(&source);
+    return (CamCalibDbBuildIndex(m_CalibDbHandle) == RET_SUCCESS);
+  }
+
+  errorID = doc.Parse(source.data);
 #ifdef DEBUG_LOG
-  redirectOut << __func__ << " doc.LoadFile" << "filename" << device << "error" << errorID << std::endl;
+  redirectOut << __func__ << " doc.Parse" << "filename" << device << "error" << errorID << std::endl;
 #endif
   if (doc.Error()) {
 #if 1
     redirectOut
         << "Error: Parse error errorID " << errorID << std::endl;
 #endif
+    CalibDbImage::ReleaseSource(&source);
     return (false);
   }
   XMLElement* proot = doc.RootElement();
   std::string tagname(proot->Name());
   if (tagname != CALIB_FILESTART_TAG) {
     redirectOut << "Error: Not a calibration data file" << std::endl;
-
+    CalibDbImage::ReleaseSource(&source);
     return (false);
   }
 
+  // build into an arena, the database can then be written as an image
+  if (!m_CalibDbImage->Reserve(CALIBDB_ARENA_SIZE)) {
+    delete m_CalibDbImage;
+    m_CalibDbImage = NULL;
+  }
+
+  CamCalibDbArenaBind(m_CalibDbImage ? m_CalibDbImage->GetArena() : NULL);
+  res = parseCalibDb(proot);
+  CamCalibDbArenaBind(NULL);
+
+  if (res && m_CalibDbImage) {
+    storeCalibDbImage(proot, imagePath.c_str(), &source);
+    m_CalibDbImage->Trim();
+  }
+  CalibDbImage::ReleaseSource(&source);
+
+  // the index is heap memory and never part of an image
+  if (res) {
+    res = (CamCalibDbBuildIndex(m_CalibDbHandle) == RET_SUCCESS);
+  }
+
+#ifdef DEBUG_LOG
+  redirectOut << __func__ << " (exit)" << std::endl;
+#endif
+
+  return (res);
+}
+
+
+
+/******************************************************************************
+ * CalibDb::parseCalibDb
+ *****************************************************************************/
+bool CalibDb::parseCalibDb
+(
+    const XMLElement*  proot
+) {
+  bool res = true;
+
+  RESULT result = CamCalibDbCreate(&m_CalibDbHandle);
+  DCT_ASSERT(result == RET_SUCCESS);
+
   // parse header section
-  XMLElement* pheader = proot->FirstChildElement(CALIB_HEADER_TAG);
+  const XMLElement* pheader = proot->FirstChildElement(CALIB_HEADER_TAG);
   if (pheader) {
     res = parseEntryHeader(pheader->ToElement(), NULL);
     if (!res) {
@@ -1113,7 +529,7 @@ bool CalibDb::CreateCalibDb
   }
 
   // parse sensor section
-  XMLElement* psensor = proot->FirstChildElement(CALIB_SENSOR_TAG);
+  const XMLElement* psensor = proot->FirstChildElement(CALIB_SENSOR_TAG);
   if (psensor) {
     res = parseEntrySensor(psensor->ToElement(), NULL);
     if (!res) {
@@ -1123,7 +539,7 @@ bool CalibDb::CreateCalibDb
   }
 
   // parse system section
-  XMLElement* psystem = proot->FirstChildElement(CALIB_SYSTEM_TAG);
+  const XMLElement* psystem = proot->FirstChildElement(CALIB_SYSTEM_TAG);
   if (psystem) {
     res = parseEntrySystem(psystem->ToElement(), NULL);
     if (!res) {
@@ -1132,15 +548,49 @@ bool CalibDb::CreateCalibDb
     }
   }
 
-#ifdef DEBUG_LOG
-  redirectOut << __func__ << " (exit)" << std::endl;
-#endif
-
   return (res);
 }
 
 
 
+/******************************************************************************
+ * CalibDb::storeCalibDbImage
+ *****************************************************************************/
+void CalibDb::storeCalibDbImage
+(
+    const XMLElement*     proot,
+    const char*           path,
+    const CalibDbSource*  source
+) {
+  CamCalibDbHandle_t handle = m_CalibDbHandle;
+  CalibDbImage shadow;
+
+  // a read-only directory just leaves the next start parsing again,
+  // spare it the second build
+  std::string dir(path);
+  size_t slash = dir.rfind('/');
+  dir = (slash == std::string::npos) ? std::string(".") : dir.substr(0, slash + 1);
+  if (access(dir.c_str(), W_OK) != 0) {
+    redirectOut << "Warning: Can not write image " << path << std::endl;
+    return;
+  }
+
+  // same file into a second arena, only the pointers differ from the first
+  if (shadow.Reserve(CALIBDB_ARENA_SIZE)) {
+    CamCalibDbArenaBind(shadow.GetArena());
+    bool res = parseCalibDb(proot);
+    CamCalibDbArenaBind(NULL);
+
+    if (!res || !m_CalibDbImage->Store(path, source, handle, &shadow, m_CalibDbHandle)) {
+      redirectOut << "Warning: Can not write image " << path << std::endl;
+    }
+  }
+
+  m_CalibDbHandle = handle;
+}
+
+
+
 
 /******************************************************************************
  * CalibDb::parseEntryCell
@@ -1398,7 +848,7 @@ bool CalibDb::parseEntryResolution
   List* l = ListRemoveHead(&resolution.framerates);
   while (l) {
     List* tmp = ListRemoveHead(l);
-    free(l);
+    CamCalibDbFree(l);
     l = tmp;
   }
 
@@ -1425,7 +875,7 @@ bool CalibDb::parseEntryFramerates
 #endif
 
   CamResolution_t* pResolution = (CamResolution_t*)param;
-  CamFrameRate_t* pFrate = (CamFrameRate_t*) malloc(sizeof(CamFrameRate_t));
+  CamFrameRate_t* pFrate = (CamFrameRate_t*) CamCalibDbMalloc(sizeof(CamFrameRate_t));
   if (!pFrate) {
     return false;
   }
@@ -1612,7 +1062,7 @@ bool CalibDb::parseEntrySensor
 
     } else if (tagname == CALIB_SENSOR_CPROC_TAG) {
       CamCprocProfile_t cproc;
-      cproc.num_items = 0;
+      MEMSET(&cproc, 0, sizeof(cproc));
       if (!parseEntryCell(pchild->ToElement(), tag.Size(), &CalibDb::parseEntryCproc,  &cproc)) {
 #if 1
         redirectOut
@@ -1820,6 +1270,7 @@ bool CalibDb::parseEntryAf
 //#endif
 
   CamCalibAfGlobal_t af_data;
+  MEMSET(&af_data, 0, sizeof(af_data));
 
   const XMLNode* pchild = pelement->FirstChild();
   while (pchild) {
@@ -1924,7 +1375,7 @@ bool CalibDb::parseEntryAec
     } else if (tagname == CALIB_SENSOR_AEC_GAINRANGE_TAG
     			&& (tag.Size() > 0) ) {
       int i = tag.Size();
-	  aec_data.GainRange.pGainRange = (float *)malloc(i*sizeof(float));
+	  aec_data.GainRange.pGainRange = (float *)CamCalibDbMalloc(i*sizeof(float));
 	  if(aec_data.GainRange.pGainRange == NULL){
 		std::cout << "aec gain range malloc fail!" << std::endl;
 	  }
@@ -1939,7 +1390,7 @@ bool CalibDb::parseEntryAec
     } else if (tagname == CALIB_SENSOR_AEC_GRIDWEIGHTS_TAG) { //cxf
       uint8_t *pWeight  = NULL;
       int arraySize     = tag.Size();
-      pWeight = (uint8_t *)malloc(arraySize * sizeof(uint8_t));
+      pWeight = (uint8_t *)CamCalibDbMalloc(arraySize * sizeof(uint8_t));
 	  if(pWeight == NULL){
 		std::cout << "aec gridWeight malloc fail!" << std::endl;
 	  }
@@ -1953,7 +1404,7 @@ bool CalibDb::parseEntryAec
     } else if (tagname == CALIB_SENSOR_AEC_NIHGT_GRIDWEIGHTS_TAG) { //cxf
       uint8_t *pNightWeight  = NULL;
       int nightArraySize     = tag.Size();
-      pNightWeight = (uint8_t *)malloc(nightArraySize * sizeof(uint8_t));
+      pNightWeight = (uint8_t *)CamCalibDbMalloc(nightArraySize * sizeof(uint8_t));
 	  if(pNightWeight == NULL){
 		std::cout << "aec night gridWeight malloc fail!" << std::endl;
 	  }
@@ -2718,7 +2169,7 @@ bool CalibDb::parseEntryAecEcm
   List* l = ListRemoveHead(&EcmProfile.ecm_scheme);
   while (l) {
     List* temp = ListRemoveHead(l);
-    free(l);
+    CamCalibDbFree(l);
     l = temp;
   }
 
@@ -2745,7 +2196,7 @@ bool CalibDb::parseEntryAecEcmPriorityScheme
   redirectOut << __func__ << " (enter)" << std::endl;
 #endif
 
-  CamEcmScheme_t* pEcmScheme = (CamEcmScheme_t*) malloc(sizeof(CamEcmScheme_t));
+  CamEcmScheme_t* pEcmScheme = (CamEcmScheme_t*) CamCalibDbMalloc(sizeof(CamEcmScheme_t));
   if (!pEcmScheme) {
     return false;
   }
@@ -2788,7 +2239,7 @@ bool CalibDb::parseEntryAecEcmPriorityScheme
           << std::endl;
 #endif
 
-      free(pEcmScheme);
+      CamCalibDbFree(pEcmScheme);
       pEcmScheme = NULL;
 
       //return ( false );
@@ -2824,7 +2275,7 @@ bool CalibDb::parseAECDySetpoint
     return false;
   }
 
-  CamCalibAecDynamicSetpoint_t* pDySetpointFile = (CamCalibAecDynamicSetpoint_t*)malloc(sizeof(CamCalibAecDynamicSetpoint_t));
+  CamCalibAecDynamicSetpoint_t* pDySetpointFile = (CamCalibAecDynamicSetpoint_t*)CamCalibDbMalloc(sizeof(CamCalibAecDynamicSetpoint_t));
   if (NULL == pDySetpointFile) {
   	redirectOut << __func__ << " malloc fail (exit)" << std::endl;
     return false;
@@ -2861,7 +2312,7 @@ bool CalibDb::parseAECDySetpoint
 		 && (tag.isType(XmlTag::TAG_TYPE_DOUBLE))
 		 && (tag.Size() > 0))
 	{
-		 pDySetpointFile->pExpValue = (float*)malloc((tag.Size() * sizeof(float)));
+		 pDySetpointFile->pExpValue = (float*)CamCalibDbMalloc((tag.Size() * sizeof(float)));
 	  if(!pDySetpointFile->pExpValue){
 	      std::cout  << "malloc fail:" <<__LINE__ << std::endl;
   	  }else{
@@ -2873,7 +2324,7 @@ bool CalibDb::parseAECDySetpoint
 		 && (tag.isType(XmlTag::TAG_TYPE_DOUBLE))
 		 && (tag.Size() > 0))
 	{
-		 pDySetpointFile->pDySetpoint = (float*)malloc((tag.Size() * sizeof(float)));
+		 pDySetpointFile->pDySetpoint = (float*)CamCalibDbMalloc((tag.Size() * sizeof(float)));
 	  if(!pDySetpointFile->pDySetpoint){
 	      std::cout << "malloc fail:" <<__LINE__ << std::endl;
   	  }else{
@@ -2922,7 +2373,7 @@ bool CalibDb::parseAECExpSeparate
     return false;
   }
 
-  CamCalibAecExpSeparate_t* pExpSeparate = (CamCalibAecExpSeparate_t*)malloc(sizeof(CamCalibAecExpSeparate_t));
+  CamCalibAecExpSeparate_t* pExpSeparate = (CamCalibAecExpSeparate_t*)CamCalibDbMalloc(sizeof(CamCalibAecExpSeparate_t));
   if (NULL == pExpSeparate) {
   	redirectOut << __func__ << " malloc fail (exit)" << std::endl;
     return false;
@@ -3295,6 +2746,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
 #endif
 
   CamCalibAwb_V11_Global_t awb_data;
+  MEMSET(&awb_data, 0, sizeof(awb_data));
 
   /* CamAwbClipParm_t */
   float* pRg1         = NULL;
@@ -3389,7 +2841,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pRg1)) {
       nRg1 = tag.Size();
-      pRg1 = (float*)malloc(sizeof(float) * nRg1);
+      pRg1 = (float*)CamCalibDbMalloc(sizeof(float) * nRg1);
 
       int no = ParseFloatArray(tag.Value(), pRg1, nRg1);
       DCT_ASSERT((no == nRg1));
@@ -3398,7 +2850,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pMaxDist1)) {
       nMaxDist1 = tag.Size();
-      pMaxDist1 = (float*)malloc(sizeof(float) * nMaxDist1);
+      pMaxDist1 = (float*)CamCalibDbMalloc(sizeof(float) * nMaxDist1);
 
       int no = ParseFloatArray(tag.Value(), pMaxDist1, nMaxDist1);
       DCT_ASSERT((no == nRg1));
@@ -3407,7 +2859,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pRg2)) {
       nRg2 = tag.Size();
-      pRg2 = (float*)malloc(sizeof(float) * nRg2);
+      pRg2 = (float*)CamCalibDbMalloc(sizeof(float) * nRg2);
 
       int no = ParseFloatArray(tag.Value(), pRg2, nRg2);
       DCT_ASSERT((no == nRg2));
@@ -3416,7 +2868,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pMaxDist2)) {
       nMaxDist2 = tag.Size();
-      pMaxDist2 = (float*)malloc(sizeof(float) * nMaxDist2);
+      pMaxDist2 = (float*)CamCalibDbMalloc(sizeof(float) * nMaxDist2);
 
       int no = ParseFloatArray(tag.Value(), pMaxDist2, nMaxDist2);
       DCT_ASSERT((no == nMaxDist2));
@@ -3425,7 +2877,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pGlobalFade1)) {
       nGlobalFade1 = tag.Size();
-      pGlobalFade1 = (float*)malloc(sizeof(float) * nGlobalFade1);
+      pGlobalFade1 = (float*)CamCalibDbMalloc(sizeof(float) * nGlobalFade1);
 
       int no = ParseFloatArray(tag.Value(), pGlobalFade1, nGlobalFade1);
       DCT_ASSERT((no == nGlobalFade1));
@@ -3434,7 +2886,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pGlobalGainDistance1)) {
       nGlobalGainDistance1 = tag.Size();
-      pGlobalGainDistance1 = (float*)malloc(sizeof(float) * nGlobalGainDistance1);
+      pGlobalGainDistance1 = (float*)CamCalibDbMalloc(sizeof(float) * nGlobalGainDistance1);
 
       int no = ParseFloatArray(tag.Value(), pGlobalGainDistance1, nGlobalGainDistance1);
       DCT_ASSERT((no == nGlobalGainDistance1));
@@ -3443,7 +2895,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pGlobalFade2)) {
       nGlobalFade2 = tag.Size();
-      pGlobalFade2 = (float*)malloc(sizeof(float) * nGlobalFade2);
+      pGlobalFade2 = (float*)CamCalibDbMalloc(sizeof(float) * nGlobalFade2);
 
       int no = ParseFloatArray(tag.Value(), pGlobalFade2, nGlobalFade2);
       DCT_ASSERT((no == nGlobalFade2));
@@ -3452,7 +2904,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pGlobalGainDistance2)) {
       nGlobalGainDistance2 = tag.Size();
-      pGlobalGainDistance2 = (float*)malloc(sizeof(float) * nGlobalGainDistance2);
+      pGlobalGainDistance2 = (float*)CamCalibDbMalloc(sizeof(float) * nGlobalGainDistance2);
 
       int no = ParseFloatArray(tag.Value(), pGlobalGainDistance2, nGlobalGainDistance2);
       DCT_ASSERT((no == nGlobalGainDistance2));
@@ -3461,7 +2913,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pFade)) {
       nFade = tag.Size();
-      pFade = (float*)malloc(sizeof(float) * nFade);
+      pFade = (float*)CamCalibDbMalloc(sizeof(float) * nFade);
 
       int no = ParseFloatArray(tag.Value(), pFade, nFade);
       DCT_ASSERT((no == nFade));
@@ -3470,7 +2922,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pMaxCSum_br)) {
       nMaxCSum_br = tag.Size();
-      pMaxCSum_br = (float*)malloc(sizeof(float) * nMaxCSum_br);
+      pMaxCSum_br = (float*)CamCalibDbMalloc(sizeof(float) * nMaxCSum_br);
 
       int no = ParseFloatArray(tag.Value(), pMaxCSum_br, nMaxCSum_br);
       DCT_ASSERT((no == nMaxCSum_br));
@@ -3479,7 +2931,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pMaxCSum_sr)) {
       nMaxCSum_sr = tag.Size();
-      pMaxCSum_sr = (float*)malloc(sizeof(float) * nMaxCSum_sr);
+      pMaxCSum_sr = (float*)CamCalibDbMalloc(sizeof(float) * nMaxCSum_sr);
 
       int no = ParseFloatArray(tag.Value(), pMaxCSum_sr, nMaxCSum_sr);
       DCT_ASSERT((no == nMaxCSum_sr));
@@ -3488,7 +2940,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pMinC_br)) {
       nMinC_br = tag.Size();
-      pMinC_br = (float*)malloc(sizeof(float) * nMinC_br);
+      pMinC_br = (float*)CamCalibDbMalloc(sizeof(float) * nMinC_br);
 
       int no = ParseFloatArray(tag.Value(), pMinC_br, nMinC_br);
       DCT_ASSERT((no == nMinC_br));
@@ -3497,7 +2949,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pMaxY_br)) {
       nMaxY_br = tag.Size();
-      pMaxY_br = (float*)malloc(sizeof(float) * nMaxY_br);
+      pMaxY_br = (float*)CamCalibDbMalloc(sizeof(float) * nMaxY_br);
 
       int no = ParseFloatArray(tag.Value(), pMaxY_br, nMaxY_br);
       DCT_ASSERT((no == nMaxY_br));
@@ -3506,7 +2958,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pMinY_br)) {
       nMinY_br = tag.Size();
-      pMinY_br = (float*)malloc(sizeof(float) * nMinY_br);
+      pMinY_br = (float*)CamCalibDbMalloc(sizeof(float) * nMinY_br);
 
       int no = ParseFloatArray(tag.Value(), pMinY_br, nMinY_br);
       DCT_ASSERT((no == nMinY_br));
@@ -3515,7 +2967,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pMinC_sr)) {
       nMinC_sr = tag.Size();
-      pMinC_sr = (float*)malloc(sizeof(float) * nMinC_sr);
+      pMinC_sr = (float*)CamCalibDbMalloc(sizeof(float) * nMinC_sr);
 
       int no = ParseFloatArray(tag.Value(), pMinC_sr, nMinC_sr);
       DCT_ASSERT((no == nMinC_sr));
@@ -3524,7 +2976,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pMaxY_sr)) {
       nMaxY_sr = tag.Size();
-      pMaxY_sr = (float*)malloc(sizeof(float) * nMaxY_sr);
+      pMaxY_sr = (float*)CamCalibDbMalloc(sizeof(float) * nMaxY_sr);
 
       int no = ParseFloatArray(tag.Value(), pMaxY_sr, nMaxY_sr);
       DCT_ASSERT((no == nMaxY_sr));
@@ -3533,7 +2985,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pMinY_sr)) {
       nMinY_sr = tag.Size();
-      pMinY_sr = (float*)malloc(sizeof(float) * nMinY_sr);
+      pMinY_sr = (float*)CamCalibDbMalloc(sizeof(float) * nMinY_sr);
 
       int no = ParseFloatArray(tag.Value(), pMinY_sr, nMinY_sr);
       DCT_ASSERT((no == nMinY_sr));
@@ -3542,7 +2994,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pRefCb)) {
       nRefCb = tag.Size();
-      pRefCb = (float*)malloc(sizeof(float) * nRefCb);
+      pRefCb = (float*)CamCalibDbMalloc(sizeof(float) * nRefCb);
 
       int no = ParseFloatArray(tag.Value(), pRefCb, nRefCb);
       DCT_ASSERT((no == nRefCb));
@@ -3551,7 +3003,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
                && (tag.Size() > 0)
                && (NULL == pRefCr)) {
       nRefCr = tag.Size();
-      pRefCr = (float*)malloc(sizeof(float) * nRefCr);
+      pRefCr = (float*)CamCalibDbMalloc(sizeof(float) * nRefCr);
 
       int no = ParseFloatArray(tag.Value(), pRefCr, nRefCr);
       DCT_ASSERT((no == nRefCr));
@@ -3756,28 +3208,28 @@ bool CalibDb::parseEntryAwb_V11_Globals
   DCT_ASSERT(result == RET_SUCCESS);
 
   /* cleanup */
-  free(pRg1);
-  free(pMaxDist1);
-  free(pRg2);
-  free(pMaxDist2);
-
-  free(pGlobalFade1);
-  free(pGlobalGainDistance1);
-  free(pGlobalFade2);
-  free(pGlobalGainDistance2);
-
-  free(pFade);
-  free(pMaxCSum_br);
-  free(pMaxCSum_sr);
-  free(pMinC_br);
-  free(pMaxY_br);
-  free(pMinY_br);
-  free(pMinC_sr);
-  free(pMaxY_sr);
-  free(pMinY_sr);
-
-  free(pRefCb);
-  free(pRefCr);
+  CamCalibDbFree(pRg1);
+  CamCalibDbFree(pMaxDist1);
+  CamCalibDbFree(pRg2);
+  CamCalibDbFree(pMaxDist2);
+
+  CamCalibDbFree(pGlobalFade1);
+  CamCalibDbFree(pGlobalGainDistance1);
+  CamCalibDbFree(pGlobalFade2);
+  CamCalibDbFree(pGlobalGainDistance2);
+
+  CamCalibDbFree(pFade);
+  CamCalibDbFree(pMaxCSum_br);
+  CamCalibDbFree(pMaxCSum_sr);
+  CamCalibDbFree(pMinC_br);
+  CamCalibDbFree(pMaxY_br);
+  CamCalibDbFree(pMinY_br);
+  CamCalibDbFree(pMinC_sr);
+  CamCalibDbFree(pMaxY_sr);
+  CamCalibDbFree(pMinY_sr);
+
+  CamCalibDbFree(pRefCb);
+  CamCalibDbFree(pRefCr);
 
 #ifdef DEBUG_LOG
   redirectOut << __func__ << " (exit)" << std::endl;
@@ -3801,6 +3253,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
 #endif
 
   CamCalibAwb_V10_Global_t awb_data;
+  MEMSET(&awb_data, 0, sizeof(awb_data));
 
   /* CamAwbClipParm_t */
   float* pRg1         = NULL;
@@ -3917,7 +3370,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pRg1)) {
       nRg1 = tag.Size();
-      pRg1 = (float*)malloc(sizeof(float) * nRg1);
+      pRg1 = (float*)CamCalibDbMalloc(sizeof(float) * nRg1);
 
       int no = ParseFloatArray(tag.Value(), pRg1, nRg1);
       DCT_ASSERT((no == nRg1));
@@ -3926,7 +3379,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pMaxDist1)) {
       nMaxDist1 = tag.Size();
-      pMaxDist1 = (float*)malloc(sizeof(float) * nMaxDist1);
+      pMaxDist1 = (float*)CamCalibDbMalloc(sizeof(float) * nMaxDist1);
 
       int no = ParseFloatArray(tag.Value(), pMaxDist1, nMaxDist1);
       DCT_ASSERT((no == nRg1));
@@ -3935,7 +3388,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pRg2)) {
       nRg2 = tag.Size();
-      pRg2 = (float*)malloc(sizeof(float) * nRg2);
+      pRg2 = (float*)CamCalibDbMalloc(sizeof(float) * nRg2);
 
       int no = ParseFloatArray(tag.Value(), pRg2, nRg2);
       DCT_ASSERT((no == nRg2));
@@ -3944,7 +3397,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pMaxDist2)) {
       nMaxDist2 = tag.Size();
-      pMaxDist2 = (float*)malloc(sizeof(float) * nMaxDist2);
+      pMaxDist2 = (float*)CamCalibDbMalloc(sizeof(float) * nMaxDist2);
 
       int no = ParseFloatArray(tag.Value(), pMaxDist2, nMaxDist2);
       DCT_ASSERT((no == nMaxDist2));
@@ -3953,7 +3406,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pGlobalFade1)) {
       nGlobalFade1 = tag.Size();
-      pGlobalFade1 = (float*)malloc(sizeof(float) * nGlobalFade1);
+      pGlobalFade1 = (float*)CamCalibDbMalloc(sizeof(float) * nGlobalFade1);
 
       int no = ParseFloatArray(tag.Value(), pGlobalFade1, nGlobalFade1);
       DCT_ASSERT((no == nGlobalFade1));
@@ -3962,7 +3415,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pGlobalGainDistance1)) {
       nGlobalGainDistance1 = tag.Size();
-      pGlobalGainDistance1 = (float*)malloc(sizeof(float) * nGlobalGainDistance1);
+      pGlobalGainDistance1 = (float*)CamCalibDbMalloc(sizeof(float) * nGlobalGainDistance1);
 
       int no = ParseFloatArray(tag.Value(), pGlobalGainDistance1, nGlobalGainDistance1);
       DCT_ASSERT((no == nGlobalGainDistance1));
@@ -3971,7 +3424,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pGlobalFade2)) {
       nGlobalFade2 = tag.Size();
-      pGlobalFade2 = (float*)malloc(sizeof(float) * nGlobalFade2);
+      pGlobalFade2 = (float*)CamCalibDbMalloc(sizeof(float) * nGlobalFade2);
 
       int no = ParseFloatArray(tag.Value(), pGlobalFade2, nGlobalFade2);
       DCT_ASSERT((no == nGlobalFade2));
@@ -3980,7 +3433,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pGlobalGainDistance2)) {
       nGlobalGainDistance2 = tag.Size();
-      pGlobalGainDistance2 = (float*)malloc(sizeof(float) * nGlobalGainDistance2);
+      pGlobalGainDistance2 = (float*)CamCalibDbMalloc(sizeof(float) * nGlobalGainDistance2);
 
       int no = ParseFloatArray(tag.Value(), pGlobalGainDistance2, nGlobalGainDistance2);
       DCT_ASSERT((no == nGlobalGainDistance2));
@@ -3989,7 +3442,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pFade)) {
       nFade = tag.Size();
-      pFade = (float*)malloc(sizeof(float) * nFade);
+      pFade = (float*)CamCalibDbMalloc(sizeof(float) * nFade);
 
       int no = ParseFloatArray(tag.Value(), pFade, nFade);
       DCT_ASSERT((no == nFade));
@@ -3998,7 +3451,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pCbMinRegionMax)) {
       nCbMinRegionMax = tag.Size();
-      pCbMinRegionMax = (float*)malloc(sizeof(float) * nCbMinRegionMax);
+      pCbMinRegionMax = (float*)CamCalibDbMalloc(sizeof(float) * nCbMinRegionMax);
 
       int no = ParseFloatArray(tag.Value(), pCbMinRegionMax, nCbMinRegionMax);
       DCT_ASSERT((no == nCbMinRegionMax));
@@ -4007,7 +3460,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pCrMinRegionMax)) {
       nCrMinRegionMax = tag.Size();
-      pCrMinRegionMax = (float*)malloc(sizeof(float) * nCrMinRegionMax);
+      pCrMinRegionMax = (float*)CamCalibDbMalloc(sizeof(float) * nCrMinRegionMax);
 
       int no = ParseFloatArray(tag.Value(), pCrMinRegionMax, nCrMinRegionMax);
       DCT_ASSERT((no == nCrMinRegionMax));
@@ -4016,7 +3469,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pMaxCSumRegionMax)) {
       nMaxCSumRegionMax = tag.Size();
-      pMaxCSumRegionMax = (float*)malloc(sizeof(float) * nMaxCSumRegionMax);
+      pMaxCSumRegionMax = (float*)CamCalibDbMalloc(sizeof(float) * nMaxCSumRegionMax);
 
       int no = ParseFloatArray(tag.Value(), pMaxCSumRegionMax, nMaxCSumRegionMax);
       DCT_ASSERT((no == nMaxCSumRegionMax));
@@ -4025,7 +3478,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pCbMinRegionMin)) {
       nCbMinRegionMin = tag.Size();
-      pCbMinRegionMin = (float*)malloc(sizeof(float) * nCbMinRegionMin);
+      pCbMinRegionMin = (float*)CamCalibDbMalloc(sizeof(float) * nCbMinRegionMin);
 
       int no = ParseFloatArray(tag.Value(), pCbMinRegionMin, nCbMinRegionMin);
       DCT_ASSERT((no == nCbMinRegionMin));
@@ -4034,7 +3487,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pCrMinRegionMin)) {
       nCrMinRegionMin = tag.Size();
-      pCrMinRegionMin = (float*)malloc(sizeof(float) * nCrMinRegionMin);
+      pCrMinRegionMin = (float*)CamCalibDbMalloc(sizeof(float) * nCrMinRegionMin);
 
       int no = ParseFloatArray(tag.Value(), pCrMinRegionMin, nCrMinRegionMin);
       DCT_ASSERT((no == nCrMinRegionMin));
@@ -4043,7 +3496,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pMaxCSumRegionMin)) {
       nMaxCSumRegionMin = tag.Size();
-      pMaxCSumRegionMin = (float*)malloc(sizeof(float) * nMaxCSumRegionMin);
+      pMaxCSumRegionMin = (float*)CamCalibDbMalloc(sizeof(float) * nMaxCSumRegionMin);
 
       int no = ParseFloatArray(tag.Value(), pMaxCSumRegionMin, nMaxCSumRegionMin);
       DCT_ASSERT((no == nMaxCSumRegionMin));
@@ -4052,7 +3505,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pMinCRegionMax)) {
       nMinCRegionMax = tag.Size();
-      pMinCRegionMax = (float*)malloc(sizeof(float) * nMinCRegionMax);
+      pMinCRegionMax = (float*)CamCalibDbMalloc(sizeof(float) * nMinCRegionMax);
 
       int no = ParseFloatArray(tag.Value(), pMinCRegionMax, nMinCRegionMax);
       DCT_ASSERT((no == nMinCRegionMax));
@@ -4061,7 +3514,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pMinCRegionMin)) {
       nMinCRegionMin = tag.Size();
-      pMinCRegionMin = (float*)malloc(sizeof(float) * nMinCRegionMin);
+      pMinCRegionMin = (float*)CamCalibDbMalloc(sizeof(float) * nMinCRegionMin);
 
       int no = ParseFloatArray(tag.Value(), pMinCRegionMin, nMinCRegionMin);
       DCT_ASSERT((no == nMinCRegionMin));
@@ -4070,7 +3523,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pMaxYRegionMax)) {
       nMaxYRegionMax = tag.Size();
-      pMaxYRegionMax = (float*)malloc(sizeof(float) * nMaxYRegionMax);
+      pMaxYRegionMax = (float*)CamCalibDbMalloc(sizeof(float) * nMaxYRegionMax);
 
       int no = ParseFloatArray(tag.Value(), pMaxYRegionMax, nMaxYRegionMax);
       DCT_ASSERT((no == nMaxYRegionMax));
@@ -4079,7 +3532,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pMaxYRegionMin)) {
       nMaxYRegionMin = tag.Size();
-      pMaxYRegionMin = (float*)malloc(sizeof(float) * nMaxYRegionMin);
+      pMaxYRegionMin = (float*)CamCalibDbMalloc(sizeof(float) * nMaxYRegionMin);
 
       int no = ParseFloatArray(tag.Value(), pMaxYRegionMin, nMaxYRegionMin);
       DCT_ASSERT((no == nMaxYRegionMin));
@@ -4088,7 +3541,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pMinYMaxGRegionMax)) {
       nMinYMaxGRegionMax = tag.Size();
-      pMinYMaxGRegionMax = (float*)malloc(sizeof(float) * nMinYMaxGRegionMax);
+      pMinYMaxGRegionMax = (float*)CamCalibDbMalloc(sizeof(float) * nMinYMaxGRegionMax);
 
       int no = ParseFloatArray(tag.Value(), pMinYMaxGRegionMax, nMinYMaxGRegionMax);
       DCT_ASSERT((no == nMinYMaxGRegionMax));
@@ -4097,7 +3550,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pMinYMaxGRegionMin)) {
       nMinYMaxGRegionMin = tag.Size();
-      pMinYMaxGRegionMin = (float*)malloc(sizeof(float) * nMinYMaxGRegionMin);
+      pMinYMaxGRegionMin = (float*)CamCalibDbMalloc(sizeof(float) * nMinYMaxGRegionMin);
 
       int no = ParseFloatArray(tag.Value(), pMinYMaxGRegionMin, nMinYMaxGRegionMin);
       DCT_ASSERT((no == nMinYMaxGRegionMin));
@@ -4106,7 +3559,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pRefCb)) {
       nRefCb = tag.Size();
-      pRefCb = (float*)malloc(sizeof(float) * nRefCb);
+      pRefCb = (float*)CamCalibDbMalloc(sizeof(float) * nRefCb);
 
       int no = ParseFloatArray(tag.Value(), pRefCb, nRefCb);
       DCT_ASSERT((no == nRefCb));
@@ -4115,7 +3568,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
                && (tag.Size() > 0)
                && (NULL == pRefCr)) {
       nRefCr = tag.Size();
-      pRefCr = (float*)malloc(sizeof(float) * nRefCr);
+      pRefCr = (float*)CamCalibDbMalloc(sizeof(float) * nRefCr);
 
       int no = ParseFloatArray(tag.Value(), pRefCr, nRefCr);
       DCT_ASSERT((no == nRefCr));
@@ -4332,32 +3785,32 @@ bool CalibDb::parseEntryAwb_V10_Globals
   DCT_ASSERT(result == RET_SUCCESS);
 
   /* cleanup */
-  free(pRg1);
-  free(pMaxDist1);
-  free(pRg2);
-  free(pMaxDist2);
-
-  free(pGlobalFade1);
-  free(pGlobalGainDistance1);
-  free(pGlobalFade2);
-  free(pGlobalGainDistance2);
-
-  free(pFade);
-  free(pCbMinRegionMax);
-  free(pCrMinRegionMax);
-  free(pMaxCSumRegionMax);
-  free(pCbMinRegionMin);
-  free(pCrMinRegionMin);
-  free(pMaxCSumRegionMin);
-
-  free(pMinCRegionMax);
-  free(pMinCRegionMin);
-  free(pMaxYRegionMax);
-  free(pMaxYRegionMin);
-  free(pMinYMaxGRegionMax);
-  free(pMinYMaxGRegionMin);
-  free(pRefCb);
-  free(pRefCr);
+  CamCalibDbFree(pRg1);
+  CamCalibDbFree(pMaxDist1);
+  CamCalibDbFree(pRg2);
+  CamCalibDbFree(pMaxDist2);
+
+  CamCalibDbFree(pGlobalFade1);
+  CamCalibDbFree(pGlobalGainDistance1);
+  CamCalibDbFree(pGlobalFade2);
+  CamCalibDbFree(pGlobalGainDistance2);
+
+  CamCalibDbFree(pFade);
+  CamCalibDbFree(pCbMinRegionMax);
+  CamCalibDbFree(pCrMinRegionMax);
+  CamCalibDbFree(pMaxCSumRegionMax);
+  CamCalibDbFree(pCbMinRegionMin);
+  CamCalibDbFree(pCrMinRegionMin);
+  CamCalibDbFree(pMaxCSumRegionMin);
+
+  CamCalibDbFree(pMinCRegionMax);
+  CamCalibDbFree(pMinCRegionMin);
+  CamCalibDbFree(pMaxYRegionMax);
+  CamCalibDbFree(pMaxYRegionMin);
+  CamCalibDbFree(pMinYMaxGRegionMax);
+  CamCalibDbFree(pMinYMaxGRegionMin);
+  CamCalibDbFree(pRefCb);
+  CamCalibDbFree(pRefCr);
 
 #ifdef DEBUG_LOG
   redirectOut << __func__ << " (exit)" << std::endl;
@@ -4520,7 +3973,7 @@ bool CalibDb::parseEntryAwb_V10_Illumination
             && (tag.Size() > 0)) {
           if (!afGain) {
             n_gains = tag.Size();
-            afGain  = (float*)malloc((n_gains * sizeof(float)));
+            afGain  = (float*)CamCalibDbMalloc((n_gains * sizeof(float)));
             MEMSET(afGain, 0, (n_gains * sizeof(float)));
           }
 
@@ -4531,7 +3984,7 @@ bool CalibDb::parseEntryAwb_V10_Illumination
                    && (tag.Size() > 0)) {
           if (!afSat) {
             n_sats = tag.Size();
-            afSat = (float*)malloc((n_sats * sizeof(float)));
+            afSat = (float*)CamCalibDbMalloc((n_sats * sizeof(float)));
             MEMSET(afSat, 0, (n_sats * sizeof(float)));
           }
 
@@ -4575,7 +4028,7 @@ bool CalibDb::parseEntryAwb_V10_Illumination
             && (tag.Size() > 0)) {
           if (!afGain) {
             n_gains = tag.Size();
-            afGain  = (float*)malloc((n_gains * sizeof(float)));
+            afGain  = (float*)CamCalibDbMalloc((n_gains * sizeof(float)));
             MEMSET(afGain, 0, (n_gains * sizeof(float)));
           }
 
@@ -4586,7 +4039,7 @@ bool CalibDb::parseEntryAwb_V10_Illumination
                    && (tag.Size() > 0)) {
           if (!afVig) {
             n_vigs = tag.Size();
-            afVig = (float*)malloc((n_vigs * sizeof(float)));
+            afVig = (float*)CamCalibDbMalloc((n_vigs * sizeof(float)));
             MEMSET(afVig, 0, (n_vigs * sizeof(float)));
           }
 
@@ -4670,10 +4123,10 @@ bool CalibDb::parseEntryAwb_V10_Illumination
   DCT_ASSERT(result == RET_SUCCESS);
 
   /* cleanup */
-  free(illu.SaturationCurve.pSensorGain);
-  free(illu.SaturationCurve.pSaturation);
-  free(illu.VignettingCurve.pSensorGain);
-  free(illu.VignettingCurve.pVignetting);
+  CamCalibDbFree(illu.SaturationCurve.pSensorGain);
+  CamCalibDbFree(illu.SaturationCurve.pSaturation);
+  CamCalibDbFree(illu.VignettingCurve.pSensorGain);
+  CamCalibDbFree(illu.VignettingCurve.pVignetting);
 
 #ifdef DEBUG_LOG
   redirectOut << __func__ << " (exit)" << std::endl;
@@ -4796,7 +4249,7 @@ bool CalibDb::parseEntryAwb_V11_Illumination
             && (tag.Size() > 0)) {
           if (!afGain) {
             n_gains = tag.Size();
-            afGain  = (float*)malloc((n_gains * sizeof(float)));
+            afGain  = (float*)CamCalibDbMalloc((n_gains * sizeof(float)));
             MEMSET(afGain, 0, (n_gains * sizeof(float)));
           }
 
@@ -4807,7 +4260,7 @@ bool CalibDb::parseEntryAwb_V11_Illumination
                    && (tag.Size() > 0)) {
           if (!afSat) {
             n_sats = tag.Size();
-            afSat = (float*)malloc((n_sats * sizeof(float)));
+            afSat = (float*)CamCalibDbMalloc((n_sats * sizeof(float)));
             MEMSET(afSat, 0, (n_sats * sizeof(float)));
           }
 
@@ -4851,7 +4304,7 @@ bool CalibDb::parseEntryAwb_V11_Illumination
             && (tag.Size() > 0)) {
           if (!afGain) {
             n_gains = tag.Size();
-            afGain  = (float*)malloc((n_gains * sizeof(float)));
+            afGain  = (float*)CamCalibDbMalloc((n_gains * sizeof(float)));
             MEMSET(afGain, 0, (n_gains * sizeof(float)));
           }
 
@@ -4862,7 +4315,7 @@ bool CalibDb::parseEntryAwb_V11_Illumination
                    && (tag.Size() > 0)) {
           if (!afVig) {
             n_vigs = tag.Size();
-            afVig = (float*)malloc((n_vigs * sizeof(float)));
+            afVig = (float*)CamCalibDbMalloc((n_vigs * sizeof(float)));
             MEMSET(afVig, 0, (n_vigs * sizeof(float)));
           }
 
@@ -4946,10 +4399,10 @@ bool CalibDb::parseEntryAwb_V11_Illumination
   DCT_ASSERT(result == RET_SUCCESS);
 
   /* cleanup */
-  free(illu.SaturationCurve.pSensorGain);
-  free(illu.SaturationCurve.pSaturation);
-  free(illu.VignettingCurve.pSensorGain);
-  free(illu.VignettingCurve.pVignetting);
+  CamCalibDbFree(illu.SaturationCurve.pSensorGain);
+  CamCalibDbFree(illu.SaturationCurve.pSaturation);
+  CamCalibDbFree(illu.VignettingCurve.pSensorGain);
+  CamCalibDbFree(illu.VignettingCurve.pVignetting);
 
 #ifdef DEBUG_LOG
   redirectOut << __func__ << " (exit)" << std::endl;
@@ -5590,7 +5043,7 @@ bool CalibDb::parseEntryFilter
     return false;
   }
 
-  CamFilterProfile_t* pFilter = (CamFilterProfile_t*)malloc(sizeof(CamFilterProfile_t));
+  CamFilterProfile_t* pFilter = (CamFilterProfile_t*)CamCalibDbMalloc(sizeof(CamFilterProfile_t));
   if (NULL == pFilter) {
   	redirectOut << __func__ << " malloc fail (exit)" << std::endl;
     return false;
@@ -5644,7 +5097,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint8_t* p_FiltLevel = NULL;
 			if (!p_FiltLevel) {
-				p_FiltLevel  = (uint8_t*)malloc((tag.Size() * sizeof(uint8_t)));
+				p_FiltLevel  = (uint8_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint8_t)));
 				MEMSET(p_FiltLevel, 0, (tag.Size() * sizeof(uint8_t)));
 			}
 			int no = ParseUcharArray(tag.Value(), p_FiltLevel, tag.Size());
@@ -5664,7 +5117,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint8_t* p_grn_stage1 = NULL;
 			if (!p_grn_stage1) {
-				p_grn_stage1  = (uint8_t*)malloc((tag.Size() * sizeof(uint8_t)));
+				p_grn_stage1  = (uint8_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint8_t)));
 				MEMSET(p_grn_stage1, 0, (tag.Size() * sizeof(uint8_t)));
 			}
 			int no = ParseUcharArray(tag.Value(), p_grn_stage1, tag.Size());
@@ -5684,7 +5137,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint8_t* p_chr_h_mode = NULL;
 			if (!p_chr_h_mode) {
-				p_chr_h_mode  = (uint8_t*)malloc((tag.Size() * sizeof(uint8_t)));
+				p_chr_h_mode  = (uint8_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint8_t)));
 				MEMSET(p_chr_h_mode, 0, (tag.Size() * sizeof(uint8_t)));
 			}
 			int no = ParseUcharArray(tag.Value(), p_chr_h_mode, tag.Size());
@@ -5704,7 +5157,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint8_t* p_chr_v_mode = NULL;
 			if (!p_chr_v_mode) {
-				p_chr_v_mode  = (uint8_t*)malloc((tag.Size() * sizeof(uint8_t)));
+				p_chr_v_mode  = (uint8_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint8_t)));
 				MEMSET(p_chr_v_mode, 0, (tag.Size() * sizeof(uint8_t)));
 			}
 			int no = ParseUcharArray(tag.Value(), p_chr_v_mode, tag.Size());
@@ -5724,7 +5177,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint32_t* p_thresh_bl0 = NULL;
 			if (!p_thresh_bl0) {
-				p_thresh_bl0  = (uint32_t*)malloc((tag.Size() * sizeof(uint32_t)));
+				p_thresh_bl0  = (uint32_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint32_t)));
 				MEMSET(p_thresh_bl0, 0, (tag.Size() * sizeof(uint32_t)));
 			}
 			int no = ParseUintArray(tag.Value(), p_thresh_bl0, tag.Size());
@@ -5744,7 +5197,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint32_t* p_thresh_bl1 = NULL;
 			if (!p_thresh_bl1) {
-				p_thresh_bl1  = (uint32_t*)malloc((tag.Size() * sizeof(uint32_t)));
+				p_thresh_bl1  = (uint32_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint32_t)));
 				MEMSET(p_thresh_bl1, 0, (tag.Size() * sizeof(uint32_t)));
 			}
 			int no = ParseUintArray(tag.Value(), p_thresh_bl1, tag.Size());
@@ -5764,7 +5217,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint32_t* p_fac_bl0 = NULL;
 			if (!p_fac_bl0) {
-				p_fac_bl0  = (uint32_t*)malloc((tag.Size() * sizeof(uint32_t)));
+				p_fac_bl0  = (uint32_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint32_t)));
 				MEMSET(p_fac_bl0, 0, (tag.Size() * sizeof(uint32_t)));
 			}
 			int no = ParseUintArray(tag.Value(), p_fac_bl0, tag.Size());
@@ -5784,7 +5237,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint32_t* p_fac_bl1 = NULL;
 			if (!p_fac_bl1) {
-				p_fac_bl1  = (uint32_t*)malloc((tag.Size() * sizeof(uint32_t)));
+				p_fac_bl1  = (uint32_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint32_t)));
 				MEMSET(p_fac_bl1, 0, (tag.Size() * sizeof(uint32_t)));
 			}
 			int no = ParseUintArray(tag.Value(), p_fac_bl1, tag.Size());
@@ -5804,7 +5257,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint32_t* p_thresh_sh0 = NULL;
 			if (!p_thresh_sh0) {
-				p_thresh_sh0  = (uint32_t*)malloc((tag.Size() * sizeof(uint32_t)));
+				p_thresh_sh0  = (uint32_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint32_t)));
 				MEMSET(p_thresh_sh0, 0, (tag.Size() * sizeof(uint32_t)));
 			}
 			int no = ParseUintArray(tag.Value(), p_thresh_sh0, tag.Size());
@@ -5824,7 +5277,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint32_t* p_thresh_sh1 = NULL;
 			if (!p_thresh_sh1) {
-				p_thresh_sh1  = (uint32_t*)malloc((tag.Size() * sizeof(uint32_t)));
+				p_thresh_sh1  = (uint32_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint32_t)));
 				MEMSET(p_thresh_sh1, 0, (tag.Size() * sizeof(uint32_t)));
 			}
 			int no = ParseUintArray(tag.Value(), p_thresh_sh1, tag.Size());
@@ -5844,7 +5297,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint32_t* p_fac_sh0 = NULL;
 			if (!p_fac_sh0) {
-				p_fac_sh0  = (uint32_t*)malloc((tag.Size() * sizeof(uint32_t)));
+				p_fac_sh0  = (uint32_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint32_t)));
 				MEMSET(p_fac_sh0, 0, (tag.Size() * sizeof(uint32_t)));
 			}
 			int no = ParseUintArray(tag.Value(), p_fac_sh0, tag.Size());
@@ -5864,7 +5317,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint32_t* p_fac_sh1 = NULL;
 			if (!p_fac_sh1) {
-				p_fac_sh1  = (uint32_t*)malloc((tag.Size() * sizeof(uint32_t)));
+				p_fac_sh1  = (uint32_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint32_t)));
 				MEMSET(p_fac_sh1, 0, (tag.Size() * sizeof(uint32_t)));
 			}
 			int no = ParseUintArray(tag.Value(), p_fac_sh1, tag.Size());
@@ -5884,7 +5337,7 @@ bool CalibDb::parseEntryFilter
 		{
 			uint32_t* p_fac_mid = NULL;
 			if (!p_fac_mid) {
-				p_fac_mid  = (uint32_t*)malloc((tag.Size() * sizeof(uint32_t)));
+				p_fac_mid  = (uint32_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint32_t)));
 				MEMSET(p_fac_mid, 0, (tag.Size() * sizeof(uint32_t)));
 			}
 			int no = ParseUintArray(tag.Value(), p_fac_mid, tag.Size());
@@ -5937,7 +5390,7 @@ bool CalibDb::parseEntryFilter
     		&& (tag.Size() > 0)) {
     	  if (!afGain) {
     		n_gains = tag.Size();
-    		afGain	= (float*)malloc((n_gains * sizeof(float)));
+    		afGain	= (float*)CamCalibDbMalloc((n_gains * sizeof(float)));
     		MEMSET(afGain, 0, (n_gains * sizeof(float)));
     	  }
 
@@ -5948,7 +5401,7 @@ bool CalibDb::parseEntryFilter
     			   && (tag.Size() > 0)) {
     	  if (!afDlevel) {
     		n_Dlevels = tag.Size();
-    		afDlevel = (float*)malloc((n_Dlevels * sizeof(float)));
+    		afDlevel = (float*)CamCalibDbMalloc((n_Dlevels * sizeof(float)));
     		MEMSET(afDlevel, 0, (n_Dlevels * sizeof(float)));
     	  }
 
@@ -5968,13 +5421,13 @@ bool CalibDb::parseEntryFilter
       DCT_ASSERT((n_gains == n_Dlevels));
       pFilter->DenoiseLevelCurve.ArraySize	   = n_gains;
       pFilter->DenoiseLevelCurve.pSensorGain    = afGain;
-      pFilter->DenoiseLevelCurve.pDlevel = (CamerIcIspFltDeNoiseLevel_t*)malloc((n_Dlevels * sizeof(CamerIcIspFltDeNoiseLevel_t)));
+      pFilter->DenoiseLevelCurve.pDlevel = (CamerIcIspFltDeNoiseLevel_t*)CamCalibDbMalloc((n_Dlevels * sizeof(CamerIcIspFltDeNoiseLevel_t)));
 
       for (index = 0; index < pFilter->DenoiseLevelCurve.ArraySize; index++) {
     	pFilter->DenoiseLevelCurve.pDlevel[index] = (CamerIcIspFltDeNoiseLevel_t)((int)afDlevel[index] + 1);
       }
 
-      free(afDlevel);
+      CamCalibDbFree(afDlevel);
     }
     else if (tagname == CALIB_SENSOR_DPF_SHARPENINGLEVEL_TAG) {
       float* afGain   = NULL;
@@ -5996,7 +5449,7 @@ bool CalibDb::parseEntryFilter
     		&& (tag.Size() > 0)) {
     	  if (!afGain) {
     		n_gains = tag.Size();
-    		afGain	= (float*)malloc((n_gains * sizeof(float)));
+    		afGain	= (float*)CamCalibDbMalloc((n_gains * sizeof(float)));
     		MEMSET(afGain, 0, (n_gains * sizeof(float)));
     	  }
 
@@ -6007,7 +5460,7 @@ bool CalibDb::parseEntryFilter
     			   && (tag.Size() > 0)) {
     	  if (!afSlevel) {
     		n_Slevels = tag.Size();
-    		afSlevel = (float*)malloc((n_Slevels * sizeof(float)));
+    		afSlevel = (float*)CamCalibDbMalloc((n_Slevels * sizeof(float)));
     		MEMSET(afSlevel, 0, (n_Slevels * sizeof(float)));
     	  }
 
@@ -6028,11 +5481,11 @@ bool CalibDb::parseEntryFilter
       pFilter->SharpeningLevelCurve.ArraySize	  = n_gains;
       pFilter->SharpeningLevelCurve.pSensorGain	  = afGain;
       pFilter->SharpeningLevelCurve.pSlevel =
-	  	(CamerIcIspFltSharpeningLevel_t*)malloc((n_Slevels * sizeof(CamerIcIspFltSharpeningLevel_t)));
+	  	(CamerIcIspFltSharpeningLevel_t*)CamCalibDbMalloc((n_Slevels * sizeof(CamerIcIspFltSharpeningLevel_t)));
       for (index = 0; index < pFilter->SharpeningLevelCurve.ArraySize; index++) {
     	pFilter->SharpeningLevelCurve.pSlevel[index] = (CamerIcIspFltSharpeningLevel_t)((int)afSlevel[index] + 1);
       }
-      free(afSlevel);
+      CamCalibDbFree(afSlevel);
     }
 	else if (tagname == CALIB_SENSOR_DPF_FILT_DEMOSAIC_TH_CONF_TAG) {
       float* afGain   = NULL;
@@ -6054,7 +5507,7 @@ bool CalibDb::parseEntryFilter
     		&& (tag.Size() > 0)) {
     	  if (!afGain) {
     		n_gains = tag.Size();
-    		afGain	= (float*)malloc((n_gains * sizeof(float)));
+    		afGain	= (float*)CamCalibDbMalloc((n_gains * sizeof(float)));
     		MEMSET(afGain, 0, (n_gains * sizeof(float)));
     	  }
 
@@ -6065,7 +5518,7 @@ bool CalibDb::parseEntryFilter
     			   && (tag.Size() > 0)) {
     	  if (!afThlevel) {
     		n_Thlevels = tag.Size();
-    		afThlevel = (float*)malloc((n_Thlevels * sizeof(float)));
+    		afThlevel = (float*)CamCalibDbMalloc((n_Thlevels * sizeof(float)));
     		MEMSET(afThlevel, 0, (n_Thlevels * sizeof(float)));
     	  }
 
@@ -6085,11 +5538,11 @@ bool CalibDb::parseEntryFilter
       DCT_ASSERT((n_gains == n_Thlevels));
       pFilter->DemosaicThCurve.ArraySize	  = n_gains;
       pFilter->DemosaicThCurve.pSensorGain	  = afGain;
-      pFilter->DemosaicThCurve.pThlevel = (uint8_t*)malloc((n_Thlevels * sizeof(uint8_t)));
+      pFilter->DemosaicThCurve.pThlevel = (uint8_t*)CamCalibDbMalloc((n_Thlevels * sizeof(uint8_t)));
       for (index = 0; index < pFilter->DemosaicThCurve.ArraySize; index++) {
     	pFilter->DemosaicThCurve.pThlevel[index] = (uint8_t)((int)afThlevel[index]);
       }
-      free(afThlevel);
+      CamCalibDbFree(afThlevel);
 	}else if(tagname == CALIB_SENSOR_DPF_DEMOSAIC_LP_CONF_TAG) {
 	  if(!parseEntryDemosaicLPConfig(pchild->ToElement(), pFilter)){
 		redirectOut
@@ -6142,7 +5595,7 @@ bool CalibDb::parseEntryNew3DNR
   int nUVnrLevel = 0;
   int nSharpLevel = 0;
 
-  CamNewDsp3DNRProfile_t* pNewDsp3DNRProfile = (CamNewDsp3DNRProfile_t*)malloc(sizeof(CamNewDsp3DNRProfile_t));
+  CamNewDsp3DNRProfile_t* pNewDsp3DNRProfile = (CamNewDsp3DNRProfile_t*)CamCalibDbMalloc(sizeof(CamNewDsp3DNRProfile_t));
   if (!pNewDsp3DNRProfile) {
   	redirectOut << __func__ << " malloc fail (exit)" << std::endl;
     return false;
@@ -6177,7 +5630,7 @@ bool CalibDb::parseEntryNew3DNR
       DCT_ASSERT((no == tag.Size()));
     }else if ((tagname == CALIB_SENSOR_NEW_DSP_3DNR_SETTING_GAIN_LEVEL_TAG)
        && (tag.Size() > 0)) {
-      pNewDsp3DNRProfile->pgain_Level = (float*)malloc((tag.Size() * sizeof(float)));
+      pNewDsp3DNRProfile->pgain_Level = (float*)CamCalibDbMalloc((tag.Size() * sizeof(float)));
 	  if(!pNewDsp3DNRProfile->pgain_Level){
 	      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
   	  }else{
@@ -6209,7 +5662,7 @@ bool CalibDb::parseEntryNew3DNR
 	        }
 			else if ((subTagname == CALIB_SENSOR_NEW_DSP_3DNR_SETTING_YNR_TIME_LEVEL_TAG)
                && (subtag.Size() > 0)) {
-              pNewDsp3DNRProfile->ynr.pynr_time_weight_level = (unsigned int*)malloc((subtag.Size() * sizeof(unsigned int)));
+              pNewDsp3DNRProfile->ynr.pynr_time_weight_level = (unsigned int*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned int)));
 			  if(!pNewDsp3DNRProfile->ynr.pynr_time_weight_level){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6219,7 +5672,7 @@ bool CalibDb::parseEntryNew3DNR
 		  	  }
 	        }else if ((subTagname == CALIB_SENSOR_NEW_DSP_3DNR_SETTING_YNR_SPACE_LEVEL_TAG)
                && (subtag.Size() > 0)) {
-              pNewDsp3DNRProfile->ynr.pynr_spat_weight_level = (unsigned int*)malloc((subtag.Size() * sizeof(unsigned int)));
+              pNewDsp3DNRProfile->ynr.pynr_spat_weight_level = (unsigned int*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned int)));
 			  if(!pNewDsp3DNRProfile->ynr.pynr_spat_weight_level){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6253,7 +5706,7 @@ bool CalibDb::parseEntryNew3DNR
 	        }
 			else if ((subTagname == CALIB_SENSOR_NEW_DSP_3DNR_SETTING_UVNR_LEVEL_TAG)
                && (subtag.Size() > 0)) {
-              pNewDsp3DNRProfile->uvnr.puvnr_weight_level = (unsigned int*)malloc((subtag.Size() * sizeof(unsigned int)));
+              pNewDsp3DNRProfile->uvnr.puvnr_weight_level = (unsigned int*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned int)));
 			  if(!pNewDsp3DNRProfile->uvnr.puvnr_weight_level){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6287,7 +5740,7 @@ bool CalibDb::parseEntryNew3DNR
 	        }
 			else if ((subTagname == CALIB_SENSOR_NEW_DSP_3DNR_SETTING_SHARP_LEVEL_TAG)
                && (subtag.Size() > 0)) {
-              pNewDsp3DNRProfile->sharp.psharp_weight_level= (unsigned int*)malloc((subtag.Size() * sizeof(unsigned int)));
+              pNewDsp3DNRProfile->sharp.psharp_weight_level= (unsigned int*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned int)));
 			  if(!pNewDsp3DNRProfile->sharp.psharp_weight_level){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6372,7 +5825,7 @@ bool CalibDb::parseEntry3DNR
   MEMSET(nChrmWeight, 0x00, CAM_CALIBDB_3DNR_WEIGHT_NUM*sizeof(int));
   MEMSET(nSrcShpWeight, 0x00, CAM_CALIBDB_3DNR_WEIGHT_NUM*sizeof(int));
 
-  CamDsp3DNRSettingProfile_t* pDsp3DNRProfile = (CamDsp3DNRSettingProfile_t*)malloc(sizeof(CamDsp3DNRSettingProfile_t));
+  CamDsp3DNRSettingProfile_t* pDsp3DNRProfile = (CamDsp3DNRSettingProfile_t*)CamCalibDbMalloc(sizeof(CamDsp3DNRSettingProfile_t));
   if (!pDsp3DNRProfile) {
   	redirectOut << __func__ << " malloc fail (exit)" << std::endl;
     return false;
@@ -6403,7 +5856,7 @@ bool CalibDb::parseEntry3DNR
       DCT_ASSERT((no == tag.Size()));
     }else if ((tagname == CALIB_SENSOR_DSP_3DNR_SETTING_GAIN_LEVEL_TAG)
        && (tag.Size() > 0)) {
-      pDsp3DNRProfile->pgain_Level = (float*)malloc((tag.Size() * sizeof(float)));
+      pDsp3DNRProfile->pgain_Level = (float*)CamCalibDbMalloc((tag.Size() * sizeof(float)));
 	  if(!pDsp3DNRProfile->pgain_Level){
 	      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
   	  }else{
@@ -6413,7 +5866,7 @@ bool CalibDb::parseEntry3DNR
   	  }
     }else if ((tagname == CALIB_SENSOR_DSP_3DNR_SETTING_NOISE_COEF_NUMERATOR_TAG)
        && (tag.Size() > 0)) {
-      pDsp3DNRProfile->pnoise_coef_numerator = (uint16_t*)malloc((tag.Size() * sizeof(uint16_t)));
+      pDsp3DNRProfile->pnoise_coef_numerator = (uint16_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint16_t)));
 	  if(!pDsp3DNRProfile->pnoise_coef_numerator){
 	      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
   	  }else{
@@ -6423,7 +5876,7 @@ bool CalibDb::parseEntry3DNR
   	  }
     }else if ((tagname == CALIB_SENSOR_DSP_3DNR_SETTING_NOISE_COEF_DENOMINATOR_TAG)
        && (tag.Size() > 0)) {
-      pDsp3DNRProfile->pnoise_coef_denominator= (uint16_t*)malloc((tag.Size() * sizeof(uint16_t)));
+      pDsp3DNRProfile->pnoise_coef_denominator= (uint16_t*)CamCalibDbMalloc((tag.Size() * sizeof(uint16_t)));
 	  if(!pDsp3DNRProfile->pnoise_coef_denominator){
 	      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
   	  }else{
@@ -6447,7 +5900,7 @@ bool CalibDb::parseEntry3DNR
 	          DCT_ASSERT((no == subtag.Size()));
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_LUMA_SP_NR_LEVEL_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sDefaultLevelSetting.pluma_sp_nr_level = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sDefaultLevelSetting.pluma_sp_nr_level = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sDefaultLevelSetting.pluma_sp_nr_level){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6461,7 +5914,7 @@ bool CalibDb::parseEntry3DNR
 	          DCT_ASSERT((no == subtag.Size()));
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_LUMA_TE_NR_LEVEL_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sDefaultLevelSetting.pluma_te_nr_level = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sDefaultLevelSetting.pluma_te_nr_level = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sDefaultLevelSetting.pluma_te_nr_level){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6475,7 +5928,7 @@ bool CalibDb::parseEntry3DNR
 	          DCT_ASSERT((no == subtag.Size()));
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_CHRM_SP_NR_LEVEL_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sDefaultLevelSetting.pchrm_sp_nr_level = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sDefaultLevelSetting.pchrm_sp_nr_level = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sDefaultLevelSetting.pchrm_sp_nr_level){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6489,7 +5942,7 @@ bool CalibDb::parseEntry3DNR
 	          DCT_ASSERT((no == subtag.Size()));
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_CHRM_TE_NR_LEVEL_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sDefaultLevelSetting.pchrm_te_nr_level = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sDefaultLevelSetting.pchrm_te_nr_level = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sDefaultLevelSetting.pchrm_te_nr_level){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6503,7 +5956,7 @@ bool CalibDb::parseEntry3DNR
 	          DCT_ASSERT((no == subtag.Size()));
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_SHP_LEVEL_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sDefaultLevelSetting.pshp_level = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sDefaultLevelSetting.pshp_level = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sDefaultLevelSetting.pshp_level){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6535,7 +5988,7 @@ bool CalibDb::parseEntry3DNR
 	          DCT_ASSERT((no == subtag.Size()));
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_LUMA_SP_RAD_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sLumaSetting.pluma_sp_rad = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sLumaSetting.pluma_sp_rad = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sLumaSetting.pluma_sp_rad){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6545,7 +5998,7 @@ bool CalibDb::parseEntry3DNR
 		  	  }
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_LUMA_TE_MAX_BI_NUM_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sLumaSetting.pluma_te_max_bi_num = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sLumaSetting.pluma_te_max_bi_num = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sLumaSetting.pluma_te_max_bi_num){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6565,7 +6018,7 @@ bool CalibDb::parseEntry3DNR
 
 				if(idx >= 0 && idx < CAM_CALIBDB_3DNR_WEIGHT_NUM){
 					if(!pDsp3DNRProfile->sLumaSetting.pluma_weight[idx])
-						pDsp3DNRProfile->sLumaSetting.pluma_weight[idx]= (uint8_t*)malloc((subtag.Size() * sizeof(uint8_t)));
+						pDsp3DNRProfile->sLumaSetting.pluma_weight[idx]= (uint8_t*)CamCalibDbMalloc((subtag.Size() * sizeof(uint8_t)));
 					if(!pDsp3DNRProfile->sLumaSetting.pluma_weight[idx]){
 				      redirectOut << "malloc fail, col:"<< weight_col << " row:"
 					  	<< weight_row << " line:" <<__LINE__ << std::endl;
@@ -6602,7 +6055,7 @@ bool CalibDb::parseEntry3DNR
 	          DCT_ASSERT((no == subtag.Size()));
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_CHRM_SP_RAD_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sChrmSetting.pchrm_sp_rad = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sChrmSetting.pchrm_sp_rad = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sChrmSetting.pchrm_sp_rad){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6612,7 +6065,7 @@ bool CalibDb::parseEntry3DNR
 		  	  }
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_CHRM_TE_MAX_BI_NUM_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sChrmSetting.pchrm_te_max_bi_num = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sChrmSetting.pchrm_te_max_bi_num = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sChrmSetting.pchrm_te_max_bi_num){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6633,7 +6086,7 @@ bool CalibDb::parseEntry3DNR
 
 				if(idx >= 0 && idx < CAM_CALIBDB_3DNR_WEIGHT_NUM){
 					if(!pDsp3DNRProfile->sChrmSetting.pchrm_weight[idx])
-						pDsp3DNRProfile->sChrmSetting.pchrm_weight[idx]= (uint8_t*)malloc((subtag.Size() * sizeof(uint8_t)));
+						pDsp3DNRProfile->sChrmSetting.pchrm_weight[idx]= (uint8_t*)CamCalibDbMalloc((subtag.Size() * sizeof(uint8_t)));
 					if(!pDsp3DNRProfile->sChrmSetting.pchrm_weight[idx]){
 				      redirectOut << "malloc fail, col:"<< weight_col << " row:"
 					  	<< weight_row << " line:" <<__LINE__ << std::endl;
@@ -6669,7 +6122,7 @@ bool CalibDb::parseEntry3DNR
 	          DCT_ASSERT((no == subtag.Size()));
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_SRC_SHP_THR_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sSharpSetting.psrc_shp_thr = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sSharpSetting.psrc_shp_thr = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sSharpSetting.psrc_shp_thr){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6679,7 +6132,7 @@ bool CalibDb::parseEntry3DNR
 		  	  }
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_SRC_SHP_DIV_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sSharpSetting.psrc_shp_div = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sSharpSetting.psrc_shp_div = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sSharpSetting.psrc_shp_div){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6689,7 +6142,7 @@ bool CalibDb::parseEntry3DNR
 		  	  }
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_SRC_SHP_L_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sSharpSetting.psrc_shp_l = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sSharpSetting.psrc_shp_l = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sSharpSetting.psrc_shp_l){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6699,7 +6152,7 @@ bool CalibDb::parseEntry3DNR
 		  	  }
 	        }else if ((subTagname == CALIB_SENSOR_DSP_3DNR_SETTING_SRC_SHP_C_TAG)
                && (subtag.Size() > 0)) {
-              pDsp3DNRProfile->sSharpSetting.psrc_shp_c = (unsigned char*)malloc((subtag.Size() * sizeof(unsigned char)));
+              pDsp3DNRProfile->sSharpSetting.psrc_shp_c = (unsigned char*)CamCalibDbMalloc((subtag.Size() * sizeof(unsigned char)));
 			  if(!pDsp3DNRProfile->sSharpSetting.psrc_shp_c){
 			      redirectOut << "malloc fail:" <<__LINE__ << std::endl;
 		  	  }else{
@@ -6720,7 +6173,7 @@ bool CalibDb::parseEntry3DNR
 
 				if(idx >= 0 && idx < CAM_CALIBDB_3DNR_WEIGHT_NUM){
 					if(!pDsp3DNRProfile->sSharpSetting.psrc_shp_weight[idx])
-						pDsp3DNRProfile->sSharpSetting.psrc_shp_weight[idx]= (int8_t*)malloc((subtag.Size() * sizeof(int8_t)));
+						pDsp3DNRProfile->sSharpSetting.psrc_shp_weight[idx]= (int8_t*)CamCalibDbMalloc((subtag.Size() * sizeof(int8_t)));
 					if(!pDsp3DNRProfile->sSharpSetting.psrc_shp_weight[idx]){
 				      redirectOut << "malloc fail, col:"<< weight_col << " row:"
 					  	<< weight_row << " line:" <<__LINE__ << std::endl;
@@ -6867,7 +6320,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             uint8_t* p_lu_divided=NULL;
-            p_lu_divided = (uint8_t*)malloc(tag.Size() * sizeof(uint8_t));
+            p_lu_divided = (uint8_t*)CamCalibDbMalloc(tag.Size() * sizeof(uint8_t));
             DCT_ASSERT(p_lu_divided != NULL);
             MEMSET(p_lu_divided, 0, (tag.Size() * sizeof(uint8_t)));
 
@@ -6881,7 +6334,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* p_gainsArray=NULL;
-            p_gainsArray = (float*)malloc(tag.Size() * sizeof(float));
+            p_gainsArray = (float*)CamCalibDbMalloc(tag.Size() * sizeof(float));
             DCT_ASSERT(p_gainsArray != NULL);
             MEMSET(p_gainsArray,0,(tag.Size() * sizeof(float)));
 
@@ -6895,7 +6348,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* thH_divided0=NULL;
-            thH_divided0 = (float*)malloc(tag.Size() * sizeof(float));
+            thH_divided0 = (float*)CamCalibDbMalloc(tag.Size() * sizeof(float));
             DCT_ASSERT(thH_divided0 != NULL);
             MEMSET(thH_divided0,0,(tag.Size() * sizeof(float)));
             int no = ParseFloatArray(tag.Value(), thH_divided0, tag.Size());
@@ -6908,7 +6361,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* thH_divided1=NULL;
-            thH_divided1 = (float*)malloc(tag.Size() * sizeof(float));
+            thH_divided1 = (float*)CamCalibDbMalloc(tag.Size() * sizeof(float));
             DCT_ASSERT(thH_divided1 != NULL);
             MEMSET(thH_divided1,0,(tag.Size() * sizeof(float)));
 
@@ -6922,7 +6375,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* thH_divided2=NULL;
-            thH_divided2 = (float*)malloc(tag.Size() * sizeof(float));
+            thH_divided2 = (float*)CamCalibDbMalloc(tag.Size() * sizeof(float));
             DCT_ASSERT(thH_divided2 != NULL);
             MEMSET(thH_divided2,0,(tag.Size()*sizeof(float)));
 
@@ -6936,7 +6389,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* thH_divided3=NULL;
-            thH_divided3 = (float*)malloc(tag.Size() * sizeof(float));
+            thH_divided3 = (float*)CamCalibDbMalloc(tag.Size() * sizeof(float));
             DCT_ASSERT(thH_divided3 != NULL);
             MEMSET(thH_divided3,0,(tag.Size() * sizeof(float)));
 
@@ -6950,7 +6403,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* thH_divided4=NULL;
-            thH_divided4 = (float*)malloc(tag.Size() * sizeof(float));
+            thH_divided4 = (float*)CamCalibDbMalloc(tag.Size() * sizeof(float));
             DCT_ASSERT(thH_divided4 != NULL);
             MEMSET(thH_divided4, 0, (tag.Size()*sizeof(float)));
 
@@ -6964,7 +6417,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* thCSC_divided0=NULL;
-            thCSC_divided0 = (float*)malloc(tag.Size()*sizeof(float));
+            thCSC_divided0 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT(thCSC_divided0 != NULL);
             MEMSET(thCSC_divided0,0,(tag.Size()*sizeof(float)));
 
@@ -6978,7 +6431,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* thCSC_divided1=NULL;
-            thCSC_divided1 = (float*)malloc(tag.Size()*sizeof(float));
+            thCSC_divided1 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT(thCSC_divided1 != NULL);
             MEMSET(thCSC_divided1,0,(tag.Size()*sizeof(float)));
             int no = ParseFloatArray(tag.Value(), thCSC_divided1, tag.Size());
@@ -6991,7 +6444,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* thCSC_divided2=NULL;
-            thCSC_divided2 = (float*)malloc(tag.Size()*sizeof(float));
+            thCSC_divided2 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT(thCSC_divided2 != NULL);
             MEMSET(thCSC_divided2,0,(tag.Size()*sizeof(float)));
             int no = ParseFloatArray(tag.Value(), thCSC_divided2, tag.Size());
@@ -7004,7 +6457,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* thCSC_divided3=NULL;
-            thCSC_divided3 = (float*)malloc(tag.Size()*sizeof(float));
+            thCSC_divided3 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT(thCSC_divided3 != NULL);
             MEMSET(thCSC_divided3,0,(tag.Size()*sizeof(float)));
 
@@ -7018,7 +6471,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* thCSC_divided4=NULL;
-            thCSC_divided4 = (float*)malloc(tag.Size()*sizeof(float));
+            thCSC_divided4 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT(thCSC_divided4 != NULL);
             MEMSET(thCSC_divided4,0,(tag.Size()*sizeof(float)));
 
@@ -7032,7 +6485,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* diff_divided0=NULL;
-            diff_divided0 = (float*)malloc(tag.Size()*sizeof(float));
+            diff_divided0 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT(diff_divided0 != NULL);
             MEMSET(diff_divided0,0,(tag.Size()*sizeof(float)));
 
@@ -7046,7 +6499,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* diff_divided1=NULL;
-            diff_divided1 = (float*)malloc(tag.Size()*sizeof(float));
+            diff_divided1 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT(diff_divided1 != NULL);
             MEMSET(diff_divided1,0,(tag.Size()*sizeof(float)));
 
@@ -7060,7 +6513,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* diff_divided2=NULL;
-            diff_divided2 = (float*)malloc(tag.Size()*sizeof(float));
+            diff_divided2 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT(diff_divided2 != NULL);
             MEMSET(diff_divided2,0,(tag.Size()*sizeof(float)));
 
@@ -7074,7 +6527,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* diff_divided3=NULL;
-            diff_divided3 = (float*)malloc(tag.Size()*sizeof(float));
+            diff_divided3 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT(diff_divided3 != NULL);
             MEMSET(diff_divided3,0,(tag.Size()*sizeof(float)));
 
@@ -7089,7 +6542,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
         {
             float* diff_divided4=NULL;
 
-            diff_divided4 = (float*)malloc(tag.Size()*sizeof(float));
+            diff_divided4 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT((diff_divided4 != NULL));
             MEMSET(diff_divided4,0,(tag.Size()*sizeof(float)));
 
@@ -7103,7 +6556,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* var_divided0=NULL;
-            var_divided0 = (float*)malloc(tag.Size()*sizeof(float));
+            var_divided0 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT((var_divided0 != NULL));
             MEMSET(var_divided0,0,(tag.Size()*sizeof(float)));
 
@@ -7117,7 +6570,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* var_divided1=NULL;
-            var_divided1 = (float*)malloc(tag.Size()*sizeof(float));
+            var_divided1 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT((var_divided1 != NULL));
             MEMSET(var_divided1,0,(tag.Size()*sizeof(float)));
 
@@ -7131,7 +6584,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* var_divided2=NULL;
-            var_divided2 = (float*)malloc(tag.Size()*sizeof(float));
+            var_divided2 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT((var_divided2 != NULL));
             MEMSET(var_divided2,0,(tag.Size()*sizeof(float)));
 
@@ -7145,7 +6598,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* var_divided3=NULL;
-            var_divided3 = (float*)malloc(tag.Size()*sizeof(float));
+            var_divided3 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT((var_divided3 != NULL));
             MEMSET(var_divided3,0,(tag.Size()*sizeof(float)));
             int no = ParseFloatArray(tag.Value(), var_divided3, tag.Size());
@@ -7158,7 +6611,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
             &&(tag.Size()>0))
         {
             float* var_divided4=NULL;
-            var_divided4 = (float*)malloc(tag.Size()*sizeof(float));
+            var_divided4 = (float*)CamCalibDbMalloc(tag.Size()*sizeof(float));
             DCT_ASSERT((var_divided4 != NULL));
             MEMSET(var_divided4,0,(tag.Size()*sizeof(float)));
 
@@ -7502,21 +6955,21 @@ bool CalibDb::parseEntryDpf
   List* l = ListRemoveHead(&dpf_profile.Dsp3DNRSettingProfileList);
   while (l) {
     List* temp = ListRemoveHead(l);
-    free(l);
+    CamCalibDbFree(l);
     l = temp;
   }
 
   List* l_new3dnr = ListRemoveHead(&dpf_profile.newDsp3DNRProfileList);
   while (l_new3dnr) {
     List* temp_new3dnr = ListRemoveHead(l_new3dnr);
-    free(l_new3dnr);
+    CamCalibDbFree(l_new3dnr);
     l_new3dnr = temp_new3dnr;
   }
    // free linked ecm_schemes
   List* l_filter = ListRemoveHead(&dpf_profile.FilterList);
   while (l_filter) {
     List* temp_filter = ListRemoveHead(l_filter);
-    free(l_filter);
+    CamCalibDbFree(l_filter);
     l_filter = temp_filter;
   }
 
@@ -7734,7 +7187,7 @@ bool CalibDb::parseEntryDpccRegisters
   }
 #if 0
   if (reg_name) {
-    free(reg_name);
+    CamCalibDbFree(reg_name);
     reg_name = NULL;
   }
 #endif
@@ -7760,10 +7213,9 @@ bool CalibDb::parseEntryGoc
 #endif
 
   CamCalibGocProfile_t goc_data;
+  memset(&goc_data, 0, sizeof(goc_data));
   goc_data.def_cfg_mode = -1;
   goc_data.enable_mode = -1;
-  memset(goc_data.GammaY, 0, sizeof(goc_data.GammaY));
-  memset(goc_data.WdrOn_GammaY, 0, sizeof(goc_data.WdrOn_GammaY));
 
   const XMLNode* pchild = pelement->FirstChild();
   while (pchild) {
@@ -7989,7 +7441,7 @@ bool CalibDb::parseEntryWdr
                    && (tag.Size() > 0)) {
           if (!pf_sensor_gain_level) {
             n_sensor_gains = tag.Size();
-            pf_sensor_gain_level  = (float*)malloc((n_sensor_gains * sizeof(float)));
+            pf_sensor_gain_level  = (float*)CamCalibDbMalloc((n_sensor_gains * sizeof(float)));
             MEMSET(pf_sensor_gain_level, 0, (n_sensor_gains * sizeof(float)));
           }
 
@@ -8000,7 +7452,7 @@ bool CalibDb::parseEntryWdr
                    && (tag.Size() > 0)) {
           if (!pf_maxgain_level) {
             n_maxgain = tag.Size();
-            pf_maxgain_level = (float*)malloc((n_maxgain * sizeof(float)));
+            pf_maxgain_level = (float*)CamCalibDbMalloc((n_maxgain * sizeof(float)));
             MEMSET(pf_maxgain_level, 0, (n_maxgain * sizeof(float)));
           }
 
@@ -8120,7 +7572,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* yavg_thr=NULL;
-            yavg_thr = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            yavg_thr = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(yavg_thr != NULL);
             MEMSET(yavg_thr,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), yavg_thr, tag.Size());
@@ -8133,7 +7585,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* p_delta1=NULL;
-            p_delta1 = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            p_delta1 = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(p_delta1 != NULL);
             MEMSET(p_delta1,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), p_delta1, tag.Size());
@@ -8146,7 +7598,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* p_delta2=NULL;
-            p_delta2 = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            p_delta2 = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(p_delta2 != NULL);
             MEMSET(p_delta2,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), p_delta2, tag.Size());
@@ -8159,7 +7611,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* pmaxnumber=NULL;
-            pmaxnumber = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            pmaxnumber = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(pmaxnumber != NULL);
             MEMSET(pmaxnumber,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), pmaxnumber, tag.Size());
@@ -8172,7 +7624,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* pminnumber=NULL;
-            pminnumber = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            pminnumber = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(pminnumber != NULL);
             MEMSET(pminnumber,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), pminnumber, tag.Size());
@@ -8185,7 +7637,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* pgauss_flat_coe=NULL;
-            pgauss_flat_coe = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            pgauss_flat_coe = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(pgauss_flat_coe != NULL);
             MEMSET(pgauss_flat_coe,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), pgauss_flat_coe, tag.Size());
@@ -8198,7 +7650,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* pgauss_noise_coe=NULL;
-            pgauss_noise_coe = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            pgauss_noise_coe = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(pgauss_noise_coe != NULL);
             MEMSET(pgauss_noise_coe,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), pgauss_noise_coe, tag.Size());
@@ -8211,7 +7663,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* pgauss_other_coe=NULL;
-            pgauss_other_coe = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            pgauss_other_coe = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(pgauss_other_coe != NULL);
             MEMSET(pgauss_other_coe,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), pgauss_other_coe, tag.Size());
@@ -8224,7 +7676,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* pl_p_grad=NULL;
-            pl_p_grad = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            pl_p_grad = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(pl_p_grad != NULL);
             MEMSET(pl_p_grad,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), pl_p_grad, tag.Size());
@@ -8237,7 +7689,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* pl_sharp_factor=NULL;
-            pl_sharp_factor = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            pl_sharp_factor = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(pl_sharp_factor != NULL);
             MEMSET(pl_sharp_factor,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), pl_sharp_factor, tag.Size());
@@ -8250,7 +7702,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* pl_line1_filter_coe=NULL;
-            pl_line1_filter_coe = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            pl_line1_filter_coe = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(pl_line1_filter_coe != NULL);
             MEMSET(pl_line1_filter_coe,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), pl_line1_filter_coe, tag.Size());
@@ -8263,7 +7715,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* pl_line2_filter_coe=NULL;
-            pl_line2_filter_coe = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            pl_line2_filter_coe = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(pl_line2_filter_coe != NULL);
             MEMSET(pl_line2_filter_coe,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), pl_line2_filter_coe, tag.Size());
@@ -8276,7 +7728,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* pl_line3_filter_coe=NULL;
-            pl_line3_filter_coe = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            pl_line3_filter_coe = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(pl_line3_filter_coe != NULL);
             MEMSET(pl_line3_filter_coe,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), pl_line3_filter_coe, tag.Size());
@@ -8289,7 +7741,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* ph_p_grad=NULL;
-            ph_p_grad = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            ph_p_grad = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(ph_p_grad != NULL);
             MEMSET(ph_p_grad,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), ph_p_grad, tag.Size());
@@ -8302,7 +7754,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* ph_sharp_factor=NULL;
-            ph_sharp_factor = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            ph_sharp_factor = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(ph_sharp_factor != NULL);
             MEMSET(ph_sharp_factor,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), ph_sharp_factor, tag.Size());
@@ -8315,7 +7767,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* ph_line1_filter_coe=NULL;
-            ph_line1_filter_coe = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            ph_line1_filter_coe = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(ph_line1_filter_coe != NULL);
             MEMSET(ph_line1_filter_coe,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), ph_line1_filter_coe, tag.Size());
@@ -8328,7 +7780,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* ph_line2_filter_coe=NULL;
-            ph_line2_filter_coe = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            ph_line2_filter_coe = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(ph_line2_filter_coe != NULL);
             MEMSET(ph_line2_filter_coe,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), ph_line2_filter_coe, tag.Size());
@@ -8341,7 +7793,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* ph_line3_filter_coe=NULL;
-            ph_line3_filter_coe = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            ph_line3_filter_coe = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(ph_line3_filter_coe != NULL);
             MEMSET(ph_line3_filter_coe,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), ph_line3_filter_coe, tag.Size());
@@ -8354,7 +7806,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* puv_gauss_flat_coe=NULL;
-            puv_gauss_flat_coe = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            puv_gauss_flat_coe = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(puv_gauss_flat_coe != NULL);
             MEMSET(puv_gauss_flat_coe,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), puv_gauss_flat_coe, tag.Size());
@@ -8367,7 +7819,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* puv_gauss_noise_coe=NULL;
-            puv_gauss_noise_coe = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            puv_gauss_noise_coe = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(puv_gauss_noise_coe != NULL);
             MEMSET(puv_gauss_noise_coe,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), puv_gauss_noise_coe, tag.Size());
@@ -8380,7 +7832,7 @@ bool CalibDb::parseEntryRKsharpen
             &&(tag.Size()>0))
         {
             uint32_t* puv_gauss_other_coe=NULL;
-            puv_gauss_other_coe = (uint32_t*)malloc(tag.Size()*sizeof(uint32_t));
+            puv_gauss_other_coe = (uint32_t*)CamCalibDbMalloc(tag.Size()*sizeof(uint32_t));
             DCT_ASSERT(puv_gauss_other_coe != NULL);
             MEMSET(puv_gauss_other_coe,0,(tag.Size()*sizeof(uint32_t)));
             int no = ParseUintArray(tag.Value(), puv_gauss_other_coe, tag.Size());
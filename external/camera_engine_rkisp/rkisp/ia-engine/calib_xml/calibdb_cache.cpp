@@ -0,0 +1,394 @@
+/******************************************************************************
+ *
+ * Copyright 2019, Fuzhou Rockchip Electronics Co.Ltd. All rights reserved.
+ * No part of this work may be reproduced, modified, distributed, transmitted,
+ * transcribed, or translated into any language or computer format, in any form
+ * or by any means without written permission of:
+ * Fuzhou Rockchip Electronics Co.Ltd .
+ *
+ *
+ *****************************************************************************/
+/**
+ * @file calibdb_cache.cpp
+ *
+ *****************************************************************************/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <string>
+#include <vector>
+
+#include <ebase/builtins.h>
+#include <common/return_codes.h>
+#include <common/cam_types.h>
+
+#include "calibdb_cache.h"
+
+#define FNV64_OFFSET  0xcbf29ce484222325ULL
+#define FNV64_PRIME   0x100000001b3ULL
+
+#define ALIGN_UP(x, a) (((x) + (a) - 1) & ~((size_t)(a) - 1))
+
+/******************************************************************************
+ * Hash64
+ *
+ * FNV-1a folded over 64 bit words, this runs over the whole calibration
+ * file on every start so it must not cost more than reading it.
+ *****************************************************************************/
+static uint64_t Hash64
+(
+    const void*   data,
+    size_t        size,
+    uint64_t      hash
+) {
+  const uint8_t* p = (const uint8_t*)data;
+  size_t i = 0;
+
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, p + i, sizeof(word));
+    hash = (hash ^ word) * FNV64_PRIME;
+  }
+  for (; i < size; i++) {
+    hash = (hash ^ p[i]) * FNV64_PRIME;
+  }
+
+  return (hash);
+}
+
+
+
+/******************************************************************************
+ * LayoutHash
+ *
+ * An image is only valid for the type layout of the build it comes from.
+ *****************************************************************************/
+static uint32_t LayoutHash
+(
+) {
+  const uint64_t sizes[] = {
+    sizeof(void*),
+    sizeof(List),
+    sizeof(CamCalibDbMetaData_t),
+    sizeof(CamResolution_t),
+    sizeof(CamCalibAecGlobal_t),
+    sizeof(CamEcmProfile_t),
+    sizeof(CamCalibAwbPara_t),
+    sizeof(CamCalibAfGlobal_t),
+    sizeof(CamLscProfile_t),
+    sizeof(CamCcProfile_t),
+    sizeof(CamBlsProfile_t),
+    sizeof(CamCacProfile_t),
+    sizeof(CamDpfProfile_t),
+    sizeof(CamDpccProfile_t),
+    sizeof(CamFilterProfile_t),
+    sizeof(CamIesharpenProfile_t),
+    sizeof(CamCalibSystemData_t),
+  };
+  uint64_t hash = Hash64(sizes, sizeof(sizes), FNV64_OFFSET);
+
+  return ((uint32_t)(hash ^ (hash >> 32)));
+}
+
+
+
+/******************************************************************************
+ * CalibDbImage::CalibDbImage
+ *****************************************************************************/
+CalibDbImage::CalibDbImage
+(
+) {
+  m_Map = NULL;
+  m_MapSize = 0;
+  memset(&m_Arena, 0, sizeof(m_Arena));
+}
+
+
+
+/******************************************************************************
+ * CalibDbImage::~CalibDbImage
+ *****************************************************************************/
+CalibDbImage::~CalibDbImage() {
+  if (m_Map != NULL) {
+    munmap(m_Map, m_MapSize);
+  }
+}
+
+
+
+/******************************************************************************
+ * CalibDbImage::ReadSource
+ *****************************************************************************/
+bool CalibDbImage::ReadSource
+(
+    const char*     path,
+    CalibDbSource*  source
+) {
+  memset(source, 0, sizeof(*source));
+
+  FILE* fp = fopen(path, "rb");
+  if (fp == NULL) {
+    return (false);
+  }
+
+  bool res = false;
+  long size = 0;
+  if ((fseek(fp, 0, SEEK_END) == 0) && ((size = ftell(fp)) >= 0)
+      && (fseek(fp, 0, SEEK_SET) == 0)) {
+    source->data = (char*)malloc(size + 1);
+    if ((source->data != NULL)
+        && (fread(source->data, 1, size, fp) == (size_t)size)) {
+      source->data[size] = '\0';
+      source->size = size;
+      source->hash = Hash64(source->data, source->size, FNV64_OFFSET);
+      res = true;
+    }
+  }
+  fclose(fp);
+
+  if (!res) {
+    ReleaseSource(source);
+  }
+
+  return (res);
+}
+
+
+
+/******************************************************************************
+ * CalibDbImage::ReleaseSource
+ *****************************************************************************/
+void CalibDbImage::ReleaseSource
+(
+    CalibDbSource*  source
+) {
+  free(source->data);
+  memset(source, 0, sizeof(*source));
+}
+
+
+
+/******************************************************************************
+ * CalibDbImage::Reserve
+ *****************************************************************************/
+bool CalibDbImage::Reserve
+(
+    size_t  capacity
+) {
+  if (m_Map != NULL) {
+    return (false);
+  }
+
+  // anonymous pages are zeroed and only backed once touched
+  void* map = mmap(NULL, capacity, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (map == MAP_FAILED) {
+    return (false);
+  }
+
+  m_Map = (uint8_t*)map;
+  m_MapSize = capacity;
+  m_Arena.base = m_Map;
+  m_Arena.capacity = capacity;
+  m_Arena.used = 0;
+  m_Arena.overflow = 0;
+
+  return (true);
+}
+
+
+
+/******************************************************************************
+ * CalibDbImage::Trim
+ *****************************************************************************/
+void CalibDbImage::Trim
+(
+) {
+  if ((m_Map == NULL) || (m_Arena.base != m_Map)) {
+    return;
+  }
+
+  size_t keep = ALIGN_UP(m_Arena.used, sysconf(_SC_PAGESIZE));
+  if ((keep > 0) && (keep < m_MapSize)) {
+    munmap(m_Map + keep, m_MapSize - keep);
+    m_MapSize = keep;
+    m_Arena.capacity = keep;
+  }
+}
+
+
+
+/******************************************************************************
+ * CalibDbImage::Load
+ *****************************************************************************/
+bool CalibDbImage::Load
+(
+    const char*           path,
+    const CalibDbSource*  source,
+    CamCalibDbHandle_t*   handle
+) {
+  CalibDbCacheHeader header;
+  struct stat st;
+
+  if (m_Map != NULL) {
+    return (false);
+  }
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return (false);
+  }
+
+  if ((fstat(fd, &st) != 0)
+      || ((size_t)st.st_size < sizeof(header))
+      || (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header))
+      || (header.magic != CALIBDB_CACHE_MAGIC)
+      || (header.version != CALIBDB_CACHE_VERSION)
+      || (header.pointerSize != sizeof(void*))
+      || (header.layoutHash != LayoutHash())
+      || (header.sourceHash != source->hash)
+      || (header.sourceSize != source->size)
+      || (header.imageOffset % CAM_CALIBDB_ARENA_ALIGN != 0)
+      || (header.imageOffset < sizeof(header))
+      || (header.imageOffset > (uint64_t)st.st_size)
+      || (header.imageSize > (uint64_t)st.st_size)
+      || (header.relocCount > (uint64_t)st.st_size)
+      || (header.handleOffset >= header.imageSize)
+      || ((uint64_t)st.st_size != header.imageOffset + header.imageSize
+          + header.relocCount * sizeof(uint32_t))) {
+    close(fd);
+    return (false);
+  }
+
+  // private and writable, the relocation only touches this process' copy
+  void* map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return (false);
+  }
+
+  uint8_t* image = (uint8_t*)map + header.imageOffset;
+  const uint32_t* relocs = (const uint32_t*)(image + header.imageSize);
+  uint64_t checksum = Hash64(image, header.imageSize, FNV64_OFFSET);
+  checksum = Hash64(relocs, header.relocCount * sizeof(uint32_t), checksum);
+  if (checksum != header.checksum) {
+    munmap(map, st.st_size);
+    return (false);
+  }
+
+  for (uint64_t i = 0; i < header.relocCount; i++) {
+    uint32_t offset = relocs[i];
+    if ((offset % sizeof(uintptr_t) != 0)
+        || (offset + sizeof(uintptr_t) > header.imageSize)) {
+      munmap(map, st.st_size);
+      return (false);
+    }
+
+    uintptr_t* word = (uintptr_t*)(image + offset);
+    if (*word > header.imageSize) {
+      munmap(map, st.st_size);
+      return (false);
+    }
+    *word += (uintptr_t)image;
+  }
+
+  m_Map = (uint8_t*)map;
+  m_MapSize = st.st_size;
+  *handle = (CamCalibDbHandle_t)(image + header.handleOffset);
+
+  return (true);
+}
+
+
+
+/******************************************************************************
+ * CalibDbImage::Store
+ *****************************************************************************/
+bool CalibDbImage::Store
+(
+    const char*           path,
+    const CalibDbSource*  source,
+    CamCalibDbHandle_t    handle,
+    const CalibDbImage*   shadow,
+    CamCalibDbHandle_t    shadowHandle
+) const {
+  const CamCalibDbArena_t* live = &m_Arena;
+  const CamCalibDbArena_t* other = &shadow->m_Arena;
+
+  // a block from the heap would be a pointer the image can not resolve
+  if ((live->base == NULL) || (other->base == NULL)
+      || live->overflow || other->overflow
+      || (live->used != other->used)
+      || (live->used > UINT32_MAX)
+      || ((uint8_t*)handle - live->base != (uint8_t*)shadowHandle - other->base)) {
+    return (false);
+  }
+
+  size_t size = live->used;
+  uintptr_t delta = (uintptr_t)other->base - (uintptr_t)live->base;
+  std::vector<uint8_t> image(live->base, live->base + size);
+  std::vector<uint32_t> relocs;
+
+  // blocks are aligned, so are the pointers inside them
+  for (size_t offset = 0; offset + sizeof(uintptr_t) <= size; offset += sizeof(uintptr_t)) {
+    uintptr_t word, shadowWord;
+    memcpy(&word, live->base + offset, sizeof(word));
+    memcpy(&shadowWord, other->base + offset, sizeof(shadowWord));
+    if (word == shadowWord) {
+      continue;
+    }
+
+    // anything else that differs can not be told from a pointer the image
+    // could not resolve, e.g. a stale one in bytes the parser left
+    // uninitialized, so no image is better than a wrong one
+    uintptr_t target = word - (uintptr_t)live->base;
+    if ((shadowWord - word != delta) || (word < (uintptr_t)live->base) || (target > size)) {
+      return (false);
+    }
+
+    memcpy(&image[offset], &target, sizeof(target));
+    relocs.push_back(offset);
+  }
+
+  CalibDbCacheHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = CALIBDB_CACHE_MAGIC;
+  header.version = CALIBDB_CACHE_VERSION;
+  header.pointerSize = sizeof(void*);
+  header.layoutHash = LayoutHash();
+  header.sourceHash = source->hash;
+  header.sourceSize = source->size;
+  header.imageOffset = ALIGN_UP(sizeof(header), CAM_CALIBDB_ARENA_ALIGN);
+  header.imageSize = size;
+  header.relocCount = relocs.size();
+  header.handleOffset = (uint8_t*)handle - live->base;
+  header.checksum = Hash64(image.data(), image.size(), FNV64_OFFSET);
+  header.checksum = Hash64(relocs.data(), relocs.size() * sizeof(uint32_t), header.checksum);
+
+  // written aside and renamed, a reader never maps a partial file
+  std::string tmp = std::string(path) + ".tmp";
+  FILE* fp = fopen(tmp.c_str(), "wb");
+  if (fp == NULL) {
+    return (false);
+  }
+
+  static const uint8_t pad[CAM_CALIBDB_ARENA_ALIGN] = { 0 };
+  bool res =
+    (fwrite(&header, sizeof(header), 1, fp) == 1)
+    && (fwrite(pad, 1, header.imageOffset - sizeof(header), fp) == header.imageOffset - sizeof(header))
+    && (fwrite(image.data(), 1, image.size(), fp) == image.size())
+    && (fwrite(relocs.data(), sizeof(uint32_t), relocs.size(), fp) == relocs.size());
+  res = (fclose(fp) == 0) && res;
+
+  if (!res || (rename(tmp.c_str(), path) != 0)) {
+    unlink(tmp.c_str());
+    return (false);
+  }
+
+  return (true);
+}
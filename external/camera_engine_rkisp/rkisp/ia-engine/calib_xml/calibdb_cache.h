@@ -0,0 +1,103 @@
+/******************************************************************************
+ *
+ * Copyright 2019, Fuzhou Rockchip Electronics Co.Ltd. All rights reserved.
+ * No part of this work may be reproduced, modified, distributed, transmitted,
+ * transcribed, or translated into any language or computer format, in any form
+ * or by any means without written permission of:
+ * Fuzhou Rockchip Electronics Co.Ltd .
+ *
+ *
+ *****************************************************************************/
+/**
+ * @file calibdb_cache.h
+ *
+ * @brief
+ *   Binary image of a parsed calibration database.
+ *
+ *****************************************************************************/
+#ifndef __CALIBDB_CACHE_H__
+#define __CALIBDB_CACHE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cam_calibdb/cam_calibdb_api.h>
+#include <cam_calibdb/cam_calibdb_arena.h>
+
+/* bump on any change of the parser that changes the database content */
+#define CALIBDB_CACHE_VERSION       3
+#define CALIBDB_CACHE_MAGIC         0x42444943  /* "CIDB" */
+#define CALIBDB_CACHE_SUFFIX        ".bin"
+/* address space reserved for one database build, unused pages are returned */
+#define CALIBDB_ARENA_SIZE          (64 << 20)
+
+/******************************************************************************
+ * CalibDbSource: content of the calibration file an image is built from
+ *****************************************************************************/
+struct CalibDbSource {
+  char*     data;
+  size_t    size;
+  uint64_t  hash;
+};
+
+/******************************************************************************
+ * CalibDbCacheHeader: file layout is header, image, relocations
+ *****************************************************************************/
+struct CalibDbCacheHeader {
+  uint32_t  magic;
+  uint32_t  version;
+  uint32_t  pointerSize;
+  uint32_t  layoutHash;       // sizes of the calibration types of this build
+  uint64_t  sourceHash;       // hash of the calibration file content
+  uint64_t  sourceSize;
+  uint64_t  imageOffset;
+  uint64_t  imageSize;
+  uint64_t  relocCount;       // uint32_t image offsets of the pointers
+  uint64_t  handleOffset;
+  uint64_t  checksum;         // hash of image and relocations
+};
+
+/******************************************************************************
+ * class CalibDbImage
+ *
+ * The memory a CamCalibDb instance lives in. Either an arena the database
+ * is built into by the parser, or a cache file mapped and relocated.
+ * The image is written from two builds of the same file at different
+ * arena addresses: the words differing by the distance of the arenas are
+ * the pointers, which are stored as offsets and fixed up on load. Any
+ * other difference fails the store, the parser has to leave no byte of a
+ * block uninitialized.
+ *****************************************************************************/
+class CalibDbImage {
+ public:
+  CalibDbImage();
+  ~CalibDbImage();
+
+  static bool ReadSource(const char* path, CalibDbSource* source);
+  static void ReleaseSource(CalibDbSource* source);
+
+  // zeroed arena for one database build
+  bool Reserve(size_t capacity);
+  CamCalibDbArena_t* GetArena() {
+    return (&m_Arena);
+  }
+  // returns the pages the build did not use
+  void Trim();
+
+  // maps a cache file, fails on any mismatch with @source or this build
+  bool Load(const char* path, const CalibDbSource* source, CamCalibDbHandle_t* handle);
+
+  // writes the database @handle in this arena, @shadow is a second build
+  bool Store(const char* path, const CalibDbSource* source, CamCalibDbHandle_t handle,
+             const CalibDbImage* shadow, CamCalibDbHandle_t shadowHandle) const;
+
+ private:
+  CalibDbImage(const CalibDbImage&);
+  CalibDbImage& operator=(const CalibDbImage&);
+
+  uint8_t*            m_Map;
+  size_t              m_MapSize;
+  CamCalibDbArena_t   m_Arena;
+};
+
+#endif /* __CALIBDB_CACHE_H__ */
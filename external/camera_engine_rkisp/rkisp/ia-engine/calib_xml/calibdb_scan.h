@@ -0,0 +1,266 @@
+/******************************************************************************
+ *
+ * Copyright 2019, Fuzhou Rockchip Electronics Co.Ltd. All rights reserved.
+ * No part of this work may be reproduced, modified, distributed, transmitted,
+ * transcribed, or translated into any language or computer format, in any form
+ * or by any means without written permission of:
+ * Fuzhou Rockchip Electronics Co.Ltd .
+ *
+ *
+ *****************************************************************************/
+/**
+ * @file calibdb_scan.h
+ *
+ * @brief
+ *   Number array scanners of the calibration file parser.
+ *
+ *****************************************************************************/
+#ifndef __CALIBDB_SCAN_H__
+#define __CALIBDB_SCAN_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <float.h>
+
+#include <ostream>
+
+/******************************************************************************
+ * IsNumberEnd
+ *
+ * True if a number can not go on with @c, the fast scanners below only
+ * take a number when sscanf would stop at the same character.
+ *****************************************************************************/
+static inline bool IsNumberEnd
+(
+    const char  c
+) {
+  return (!(((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'z'))
+            || ((c >= 'A') && (c <= 'Z')) || (c == '.') || (c == '_')));
+}
+
+
+
+/******************************************************************************
+ * ScanValue
+ *
+ * One element of an array in the plain decimal forms the calibration files
+ * use, without the locale lookup and stream setup of a sscanf call. Any
+ * other form (hex, inf/nan, more digits than fit, subnormal or halfway
+ * results) is handed to sscanf, so the result is always what it returns.
+ *****************************************************************************/
+static inline bool ScanValue
+(
+    const char*  str,
+    float*       value
+) {
+  /* powers of ten exactly representable as double */
+  static const double pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  const char* p = str;
+  bool neg = false;
+  uint64_t w = 0;
+  int digits = 0;
+  int seen = 0;
+  int exp10 = 0;
+
+  if ((*p == '+') || (*p == '-')) {
+    neg = (*p == '-');
+    p++;
+  }
+  // counted from the first nonzero digit, w may wrap past 19 of them
+  for (; (*p >= '0') && (*p <= '9'); p++, seen++) {
+    w = w * 10 + (*p - '0');
+    digits += ((digits != 0) || (*p != '0'));
+  }
+  if (*p == '.') {
+    for (p++; (*p >= '0') && (*p <= '9'); p++, seen++) {
+      w = w * 10 + (*p - '0');
+      digits += ((digits != 0) || (*p != '0'));
+      exp10--;
+    }
+  }
+  if ((seen == 0) || (digits > 19)) {
+    goto slow;
+  }
+
+  if ((*p == 'e') || (*p == 'E')) {
+    const char* q = p + 1;
+    bool eneg = false;
+    int e = 0;
+    int edigits = 0;
+
+    if ((*q == '+') || (*q == '-')) {
+      eneg = (*q == '-');
+      q++;
+    }
+    for (; (*q >= '0') && (*q <= '9') && (edigits < 4); q++, edigits++) {
+      e = e * 10 + (*q - '0');
+    }
+    if (edigits == 0) {
+      goto slow;
+    }
+    exp10 += eneg ? -e : e;
+    p = q;
+  }
+  if (!IsNumberEnd(*p)) {
+    goto slow;
+  }
+
+  if (w == 0) {
+    *value = neg ? -0.0f : 0.0f;
+    return (true);
+  }
+
+  // w and 10^exp10 both exact, one operation rounds correctly
+  if ((w > (1ULL << 53)) || (exp10 < -22) || (exp10 > 22)) {
+    goto slow;
+  }
+
+  {
+    double d = (exp10 < 0) ? ((double)w / pow10[-exp10]) : ((double)w * pow10[exp10]);
+    uint64_t bits;
+
+    // rounds again to float, only the exact halfway doubles can go wrong
+    memcpy(&bits, &d, sizeof(bits));
+    if ((d < FLT_MIN) || (d > FLT_MAX) || ((bits & 0x1fffffffULL) == 0x10000000ULL)) {
+      goto slow;
+    }
+
+    *value = neg ? -(float)d : (float)d;
+    return (true);
+  }
+
+slow:
+  return (sscanf(str, "%f", value) == 1);
+}
+
+
+
+/******************************************************************************
+ * ScanInteger
+ *
+ * Integer counterpart of ScanValue, false leaves the element to sscanf.
+ *****************************************************************************/
+template <typename T>
+static inline bool ScanInteger
+(
+    const char*  str,
+    T*           value
+) {
+  const char* p = str;
+  bool neg = false;
+  int64_t w = 0;
+  int digits = 0;
+
+  if ((*p == '+') || (*p == '-')) {
+    neg = (*p == '-');
+    p++;
+  }
+  // up to 9 digits never overflow the long sscanf converts with
+  for (; (*p >= '0') && (*p <= '9') && (digits < 10); p++, digits++) {
+    w = w * 10 + (*p - '0');
+  }
+  if ((digits == 0) || (digits > 9) || !IsNumberEnd(*p)) {
+    return (false);
+  }
+
+  // stored like sscanf does, truncated to the width of the conversion
+  *value = (T)(neg ? -w : w);
+  return (true);
+}
+
+static inline bool ScanValue(const char* str, uint32_t* value) {
+  return (ScanInteger(str, value) || (sscanf(str, "%u", value) == 1));
+}
+
+static inline bool ScanValue(const char* str, uint16_t* value) {
+  return (ScanInteger(str, value) || (sscanf(str, "%hu", value) == 1));
+}
+
+static inline bool ScanValue(const char* str, int16_t* value) {
+  return (ScanInteger(str, value) || (sscanf(str, "%hd", value) == 1));
+}
+
+static inline bool ScanValue(const char* str, uint8_t* value) {
+  return (ScanInteger(str, value) || (sscanf(str, "%hhu", value) == 1));
+}
+
+static inline bool ScanValue(const char* str, int8_t* value) {
+  return (ScanInteger(str, value) || (sscanf(str, "%hhd", value) == 1));
+}
+
+
+
+/******************************************************************************
+ * ParseNumberArray
+ *
+ * Elements of a "[ ... ]" array, separated by spaces and commas. An element
+ * ends at the next space, comma or ']', a following tab or newline is part
+ * of it. Scanned as @S and stored as @T.
+ *****************************************************************************/
+template <typename T, typename S>
+static inline int ParseNumberArray
+(
+    const char*  c_string,          /**< trimmed c string */
+    T*           values,            /**< pointer to memory */
+    const int   num,                /**< number of expected values */
+    std::ostream& log,
+    const char*  func
+) {
+  const char* str = strchr(c_string, '[');
+  const char* str_last = strchr(c_string, ']');
+
+  if ((str == NULL) || (str_last == NULL)) {
+#ifdef DEBUG_LOG
+    log << func << "start" << (str != NULL) << "end" << (str_last != NULL) << std::endl;
+#endif
+    return -1;
+  }
+
+  /* skipped left parenthesis */
+  str++;
+
+  /* skip spaces */
+  while (*str == 0x20 || *str == 0x09 || (*str == 0x0a) || (*str == 0x0d)) {
+    str++;
+  }
+
+  int cnt = 0;
+  S f;
+
+  /* parse the c-string */
+  while ((str != str_last) && (cnt < num)) {
+    if (!ScanValue(str, &f)) {
+      log << func << "err" << std::endl;
+      memset(values, 0, (sizeof(T) * num));
+      return (0);
+    }
+    values[cnt] = (T)f;
+    cnt++;
+
+    /* remove detected number */
+    while ((*str != 0x20)  && (*str != ',') && (*str != ']')) {
+      str++;
+    }
+
+    /* skip spaces and comma */
+    while ((*str == 0x20) || (*str == ',') || (*str == 0x09) || (*str == 0x0a) || (*str == 0x0d)) {
+      str++;
+    }
+  }
+
+#ifdef DEBUG_LOG
+  for (int i = 0; i < cnt; i++) {
+    log << +values[i] << ", ";
+  }
+  log << std::endl;
+  log << std::endl;
+#endif
+
+  return (cnt);
+}
+
+#endif /* __CALIBDB_SCAN_H__ */
@@ -315,10 +315,7 @@ RESULT HalAwbXtalk2CamerIcXtalk
     LOGV( "%s: (enter)\n", __FUNCTION__);
 
     if ((pAwbXTalkMatrix != NULL) && (pXTalkMatrix != NULL)) {
-        int32_t i;
-        for (i = 0UL; i < 9; i++) {
-            pXTalkMatrix->Coeff[i] = UtlFloatToFix_S0407(pAwbXTalkMatrix->fCoeff[i]);
-        }
+        UtlFloatToFixArray(UTL_FIX_S0407, pAwbXTalkMatrix->fCoeff, pXTalkMatrix->Coeff, 9U);
     } else {
         result = RET_NULL_POINTER;
     }
@@ -32,7 +32,8 @@
 // of the integer and the fractional part of the fixed point format. S0407 for example
 // stands for a signed (two's complement) format with 4 bit integer and 7 bit fractional
 // part.
-// All conversion routines are doing a range check if the DCT_ASSERT macro is defined.
+// All conversion routines saturate to the range of the format, values outside of it
+// are clipped instead of wrapping around in the register.
 //
 // Handling of unsigned formats without fractional part seems to be a bit overkill. But
 // they are included here to keep the concept for all multipliers and offsets in the
@@ -91,14 +92,17 @@
 
 #define UTL_FIX_MAX_U0800        255.499f //exactly this would be < 256 - 0.5
 #define UTL_FIX_MIN_U0800          0.0f
+#define UTL_FIX_PRECISION_U0800    1.0f
 #define UTL_FIX_MASK_U0800       0x0ff
 
 #define UTL_FIX_MAX_U1000       1023.499f //exactly this would be < 1024 - 0.5
 #define UTL_FIX_MIN_U1000          0.0f
+#define UTL_FIX_PRECISION_U1000    1.0f
 #define UTL_FIX_MASK_U1000       0x3ff
 
 #define UTL_FIX_MAX_U1200       4095.499f //exactly this would be < 4096 - 0.5
 #define UTL_FIX_MIN_U1200          0.0f
+#define UTL_FIX_PRECISION_U1200    1.0f
 #define UTL_FIX_MASK_U1200       0xfff
 
 #define UTL_FIX_MAX_U0010       0.9995f //exactly this would be < 1 - 0.5/1024
@@ -132,13 +136,13 @@
 
 #define UTL_FIX_MAX_S0800         127.499f //exactly this would be < 16 - 0.5/16
 #define UTL_FIX_MIN_S0800        -128.0f
-#define UTL_FIX_PRECISION_S0800     0.0f
+#define UTL_FIX_PRECISION_S0800     1.0f
 #define UTL_FIX_MASK_S0800        0x00ff
 #define UTL_FIX_SIGN_S0800        0x0080
 
 #define UTL_FIX_MAX_S0900         255.499f //exactly this would be < 16 - 0.5/16
 #define UTL_FIX_MIN_S0900        -256.0f
-#define UTL_FIX_PRECISION_S0900     0.0f
+#define UTL_FIX_PRECISION_S0900     1.0f
 #define UTL_FIX_MASK_S0900        0x01ff
 #define UTL_FIX_SIGN_S0900        0x0100
 
@@ -150,6 +154,7 @@
 
 #define UTL_FIX_MAX_S1200       2047.499f //exactly this would be < 2048 - 0.5
 #define UTL_FIX_MIN_S1200      -2048.0f
+#define UTL_FIX_PRECISION_S1200    1.0f
 #define UTL_FIX_MASK_S1200       0x0fff
 #define UTL_FIX_SIGN_S1200       0x0800
 
@@ -182,1367 +187,215 @@
 #define UTL_FIX_PRECISION_U0402  4.0f
 #define UTL_FIX_MASK_U0402       0x3f
 
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_U0402 \n
- *  \RETURNVALUE unsigned fixed point value in uint32_t container \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to unsigned fixed point values with \n
- *               4 bit integer and 2 bit fractional part to program the \n
- *               marvin registers. \n
- */
-/*****************************************************************************/
-
-// unsigned fixed point 1 bit integer / 7 bit fractional part
-// 0x03f = 0x3f/4= 15.75
-// 0x004 = 1
-// 0x000 = 0
-
-uint32_t UtlFloatToFix_U0402(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_U0402);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_U0402);
-
-  fFloat *= UTL_FIX_PRECISION_U0402;
-
-  // round
-  // no handling of negative values required
-  ulFix = (uint32_t)(fFloat + 0.5f);
-
-  //no masking of upper bits required
-
-  return ulFix;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_U0107 \n
- *  \RETURNVALUE unsigned fixed point value in uint32_t container \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to unsigned fixed point values with \n
- *               1 bit integer and 7 bit fractional part to program the \n
- *               marvin registers. \n
- */
-/*****************************************************************************/
-
-// unsigned fixed point 1 bit integer / 7 bit fractional part
-// 0x0ff = 0xFF/0x80 = 1.9921875
-// 0x000 = 1
-// 0x000 = 0
-
-uint32_t UtlFloatToFix_U0107(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_U0107);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_U0107);
-
-  fFloat *= UTL_FIX_PRECISION_U0107;
-
-  // round
-  // no handling of negative values required
-  ulFix = (uint32_t)(fFloat + 0.5f);
-
-  //no masking of upper bits required
-
-  return ulFix;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_U0107 \n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  unsigned fixed point value in uint32_t container \n
- *  \DESCRIPTION Converts unsigned fixed point values with 1 bit integer and \n
- *               7 bit fractional part (marvin register) to float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_U0107(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x03ff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_U0107) == 0);
-
-  // precision is not cut away here, so no rounding is necessary
-  // no handling of negative values required
-  fFloat = (float)ulFix;
-
-  fFloat /= UTL_FIX_PRECISION_U0107;
-
-  return fFloat;
-}
-
-
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_U0408 \n
- *  \RETURNVALUE unsigned fixed point value in UINT32 container \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to unsigned fixed point values with \n
- *               4 bit integer and 8 bit fractional part to program the \n
- *               marvin registers. \n
- */
-/*****************************************************************************/
-
-// unsigned fixed point 4 bit integer / 8 bit fractional part
-// 0x3ff = 4095/256 = 15.99609375
-// 0x100 = 1
-// 0x000 = 0
-
-uint32_t UtlFloatToFix_U0408(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_U0408);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_U0408);
-
-  fFloat *= UTL_FIX_PRECISION_U0408;
-
-  // round
-  // no handling of negative values required
-  ulFix = (uint32_t)(fFloat + 0.5f);
-
-  //no masking of upper bits required
-
-  return ulFix;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_U0408 \n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  unsigned fixed point value in uint32_t container \n
- *  \DESCRIPTION Converts unsigned fixed point values with 4 bit integer and \n
- *               8 bit fractional part (marvin register) to float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_U0408(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x0fff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_U0408) == 0);
-
-  // precision is not cut away here, so no rounding is necessary
-  // no handling of negative values required
-  fFloat = (float)ulFix;
-
-  fFloat /= UTL_FIX_PRECISION_U0408;
-
-  return fFloat;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_U0208 \n
- *  \RETURNVALUE unsigned fixed point value in uint32_t container \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to unsigned fixed point values with \n
- *               2 bit integer and 8 bit fractional part to program the \n
- *               marvin registers. \n
- */
-/*****************************************************************************/
-
-// unsigned fixed point 2 bit integer / 8 bit fractional part
-// 0x3ff = 1023/256 = 3.99609375
-// 0x100 = 1
-// 0x000 = 0
-
-uint32_t UtlFloatToFix_U0208(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_U0208);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_U0208);
-
-  fFloat *= UTL_FIX_PRECISION_U0208;
-
-  // round
-  // no handling of negative values required
-  ulFix = (uint32_t)(fFloat + 0.5f);
-
-  //no masking of upper bits required
-
-  return ulFix;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_U0208 \n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  unsigned fixed point value in uint32_t container \n
- *  \DESCRIPTION Converts unsigned fixed point values with 2 bit integer and \n
- *               8 bit fractional part (marvin register) to float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_U0208(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x03ff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_U0208) == 0);
-
-  // precision is not cut away here, so no rounding is necessary
-  // no handling of negative values required
-  fFloat = (float)ulFix;
-
-  fFloat /= UTL_FIX_PRECISION_U0208;
-
-  return fFloat;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_U1000 \n
- *  \RETURNVALUE unsigned integer value in uint32_t container \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to unsigned integer values with \n
- *               10 bit integer and no fractional part to program the \n
- *               marvin registers. \n
- */
-/*****************************************************************************/
-
-// unsigned 10 bit integer, no fractional part
-// 0x3ff = 1023
-// 0x001 = 1
-// 0x000 = 0
-
-uint32_t UtlFloatToFix_U1000(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_U1000);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_U1000);
-
-  // precision is 1, thus no multiplication is required
-
-  // round
-  // no handling of negative values required
-  ulFix = (uint32_t)(fFloat + 0.5f);
-
-  //no masking of upper bits required
-
-  return ulFix;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_U1000 \n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  unsigned integer value in uint32_t container \n
- *  \DESCRIPTION Converts unsigned integer values with 10 bit integer and \n
- *               no fractional part (marvin register) to float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_U1000(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x03ff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_U1000) == 0);
-
-  // precision is not cut away here, so no rounding is necessary
-  // no handling of negative values required
-  fFloat = (float)ulFix;
-
-  // precision is 1, thus no division is required.
-
-  return fFloat;
-}
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_U0800 \n
- *  \RETURNVALUE unsigned integer value in uint32_t container \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to unsigned integer values with \n
- *               8 bit integer and no fractional part to program the \n
- *               marvin registers. \n
- */
-/*****************************************************************************/
-
-// unsigned 8 bit integer, no fractional part
-// 0x0ff = 255
-// 0x001 = 1
-// 0x000 = 0
-
-uint32_t UtlFloatToFix_U0800(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_U0800);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_U0800);
-
-  // precision is 1, thus no multiplication is required
-
-  // round
-  // no handling of negative values required
-  ulFix = (uint32_t)(fFloat + 0.5f);
-
-  //no masking of upper bits required
-
-  return ulFix;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_U0800 \n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  unsigned integer value in uint32_t container \n
- *  \DESCRIPTION Converts unsigned integer values with 10 bit integer and \n
- *               no fractional part (marvin register) to float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_U0800(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x00ff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_U0800) == 0);
-
-  // precision is not cut away here, so no rounding is necessary
-  // no handling of negative values required
-  fFloat = (float)ulFix;
-
-  // precision is 1, thus no division is required.
-
-  return fFloat;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_U1200 \n
- *  \RETURNVALUE unsigned integer value in uint32_t container \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to unsigned integer values with \n
- *               12 bit integer and no fractional part to program the \n
- *               marvin registers. \n
- */
-/*****************************************************************************/
-
-// unsigned 12 bit integer, no fractional part
-// 0xfff = 4095
-// 0x001 = 1
-// 0x000 = 0
-
-uint32_t UtlFloatToFix_U1200(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_U1200);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_U1200);
-
-  // precision is 1, thus no multiplication is required
-
-  // round
-  // no handling of negative values required
-  ulFix = (uint32_t)(fFloat + 0.5f);
-
-  //no masking of upper bits required
-
-  return ulFix;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_U1200 \n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  unsigned integer value in uint32_t container \n
- *  \DESCRIPTION Converts unsigned integer values with 12 bit integer and \n
- *               no fractional part (marvin register) to float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_U1200(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x0fff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_U1200) == 0);
-
-  // precision is not cut away here, so no rounding is necessary
-  // no handling of negative values required
-  fFloat = (float)ulFix;
-
-  // precision is 1, thus no division is required.
-
-  return fFloat;
-}
-
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_U0010 \n
- *  \RETURNVALUE unsigned fixed point value in uint32_t container \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to unsigned fixed point values with \n
- *               0 bit integer and 10 bit fractional part to program the \n
- *               marvin registers. \n
- */
-/*****************************************************************************/
-
-// unsigned fixed point 0 bit integer / 10 bit fractional part
-// 0x3ff = 1023/1024 = 0.9990234375
-// 0x000 = 0
-
-uint32_t UtlFloatToFix_U0010(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_U0010);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_U0010);
-
-  fFloat *= UTL_FIX_PRECISION_U0010;
-
-  // round
-  // no handling of negative values required
-  ulFix = (uint32_t)(fFloat + 0.5f);
-
-  //no masking of upper bits required
-
-  return ulFix;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_U0010 \n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  unsigned fixed point value in uint32_t container \n
- *  \DESCRIPTION Converts unsigned fixed point values with 0 bit integer and \n
- *               10 bit fractional part (marvin register) to float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_U0010(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x03ff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_U0010) == 0);
-
-  // precision is not cut away here, so no rounding is necessary
-  // no handling of negative values required
-  fFloat = (float)ulFix;
-
-  fFloat /= UTL_FIX_PRECISION_U0010;
-
-  return fFloat;
-}
-
 
 /*****************************************************************************/
 /*!
- *  \FUNCTION    UtlFloatToFix_S0207 \n
- *  \RETURNVALUE signed fixed point value in uint32_t container, leading 1's \n
- *               in the upper bits, not used by the format, are suppressed \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to signed fixed point values (two's
- *               complement) with 2 bit integer and 7 bit fractional part to
- *               program the marvin registers. \n
+ *  Formats
  */
 /*****************************************************************************/
 
-// signed (two's complement) fixed point 2 bit integer / 7 bit fractional part
-// 0x0ff = 255/128 = 1.9921875
-// 0x080 = 1
-// 0x000 = 0
-// 0x1ff = -1/128 = -0.0078125
-// 0x100 = -256/128 = -2
-
-uint32_t UtlFloatToFix_S0207(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_S0207);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_S0207);
-
-  fFloat *= UTL_FIX_PRECISION_S0207;
-
-  // round, two's complement if negative
-  if (fFloat > 0.0f) {
-    ulFix = (uint32_t)(fFloat + 0.5f);
-  } else {
-    fFloat = -fFloat;
-    ulFix  = (uint32_t)(fFloat + 0.5f);
-    ulFix  = ~ulFix;
-    ulFix++;
-  }
-
-  // set upper (unused) bits to 0
-  ulFix &= UTL_FIX_MASK_S0207;
+// sign is 0 for unsigned formats, the sign bit of the register value else
+typedef struct UtlFixFormatDesc_s {
+  float     fMin;
+  float     fMax;
+  float     fPrecision;
+  uint32_t  mask;
+  uint32_t  sign;
+} UtlFixFormatDesc_t;
 
-  return ulFix;
-}
+#define UTL_FIX_UNSIGNED(fmt) \
+  [UTL_FIX_##fmt] = { UTL_FIX_MIN_##fmt, UTL_FIX_MAX_##fmt, UTL_FIX_PRECISION_##fmt, UTL_FIX_MASK_##fmt, 0U }
+#define UTL_FIX_SIGNED(fmt) \
+  [UTL_FIX_##fmt] = { UTL_FIX_MIN_##fmt, UTL_FIX_MAX_##fmt, UTL_FIX_PRECISION_##fmt, UTL_FIX_MASK_##fmt, UTL_FIX_SIGN_##fmt }
 
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_S0207 \n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  signed fixed point value in uint32_t container, leading \n
- *               1's in the upper bits, not used by the format, must be 0 \n
- *  \DESCRIPTION Converts signed fixed point values (two's complement) with \n
- *               2 bit integer and 7 bit fractional part (marvin register) to \n
- *               float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_S0207(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x01ff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_S0207) == 0);
-
-  // sign extension and two's complement if negative
-  // (precision is not cut away here, so no rounding is necessary)
-  if ((ulFix & UTL_FIX_SIGN_S0207) == 0) {
-    fFloat = (float)ulFix;
-  } else {
-    ulFix |= ~UTL_FIX_MASK_S0207;
-    ulFix--;
-    ulFix = ~ulFix;
-    fFloat = (float)ulFix;
-    fFloat = -fFloat;
-  }
+static const UtlFixFormatDesc_t UtlFixFormats[UTL_FIX_FORMAT_MAX] = {
+  UTL_FIX_UNSIGNED(U0402),
+  UTL_FIX_UNSIGNED(U0107),
+  UTL_FIX_UNSIGNED(U0208),
+  UTL_FIX_UNSIGNED(U0408),
+  UTL_FIX_UNSIGNED(U0800),
+  UTL_FIX_UNSIGNED(U1000),
+  UTL_FIX_UNSIGNED(U1200),
+  UTL_FIX_UNSIGNED(U0010),
+  UTL_FIX_SIGNED(S0207),
+  UTL_FIX_SIGNED(S0307),
+  UTL_FIX_SIGNED(S0407),
+  UTL_FIX_SIGNED(S0504),
+  UTL_FIX_SIGNED(S0808),
+  UTL_FIX_SIGNED(S0800),
+  UTL_FIX_SIGNED(S0900),
+  UTL_FIX_SIGNED(S1200),
+  UTL_FIX_SIGNED(S0109),
+  UTL_FIX_SIGNED(S0408),
+  UTL_FIX_SIGNED(S0108),
+  UTL_FIX_SIGNED(S0110),
+};
 
-  fFloat /= UTL_FIX_PRECISION_S0207;
 
-  return fFloat;
-}
 
 /*****************************************************************************/
 /*!
- *  \FUNCTION    UtlFloatToFix_S0307 \n
- *  \RETURNVALUE signed fixed point value in uint32_t container, leading 1's \n
- *               in the upper bits, not used by the format, are suppressed \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to signed fixed point values (two's
- *               complement) with 3 bit integer and 7 bit fractional part to
- *               program the marvin registers. \n
+ *  \FUNCTION    UtlFloatToFixFormat \n
+ *  \RETURNVALUE fixed point value in uint32_t container \n
+ *  \PARAMETERS  format, float value \n
+ *  \DESCRIPTION Converts a float value to the fixed point format. \n
+ *               The value is saturated to the range of the format and \n
+ *               rounded half away from zero, negative values are stored \n
+ *               in two's complement with the upper (unused) bits set to 0. \n
+ *               Unsigned values are not masked, the saturation bounds \n
+ *               them already. \n
+ *               No branches, so the compiler can vectorize loops of it. \n
  */
 /*****************************************************************************/
+static inline uint32_t UtlFloatToFixFormat(const UtlFixFormatDesc_t* pFormat, float fFloat) {
+  // saturate, NaN ends up at the lower bound
+  fFloat = (fFloat > pFormat->fMin) ? fFloat : pFormat->fMin;
+  fFloat = (fFloat < pFormat->fMax) ? fFloat : pFormat->fMax;
 
-// signed (two's complement) fixed point 3 bit integer / 7 bit fractional part
-// 0x1ff = 511/128 = 3.9921875
-// 0x080 = 1
-// 0x000 = 0
-// 0x3ff = -1/128 = -0.0078125
-// 0x200 = -512/128 = -4
-
-uint32_t UtlFloatToFix_S0307(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_S0307);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_S0307);
-
-  fFloat *= UTL_FIX_PRECISION_S0307;
-
-  // round, two's complement if negative
-  if (fFloat > 0.0f) {
-    ulFix = (uint32_t)(fFloat + 0.5f);
-  } else {
-    fFloat = -fFloat;
-    ulFix  = (uint32_t)(fFloat + 0.5f);
-    ulFix  = ~ulFix;
-    ulFix++;
-  }
-
-  // set upper (unused) bits to 0
-  ulFix &= UTL_FIX_MASK_S0307;
+  fFloat *= pFormat->fPrecision;
 
-  return ulFix;
+  // round, the cast truncates towards zero for both signs
+  // the conversion to int32_t gives the two's complement of negative values
+  fFloat += (fFloat < 0.0f) ? -0.5f : 0.5f;
+  return ((uint32_t)(int32_t)fFloat & ((pFormat->sign != 0U) ? pFormat->mask : ~0U));
 }
 
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_S0307 \n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  signed fixed point value in uint32_t container, leading \n
- *               1's in the upper bits, not used by the format, must be 0 \n
- *  \DESCRIPTION Converts signed fixed point values (two's complement) with \n
- *               3 bit integer and 7 bit fractional part (marvin register) to \n
- *               float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_S0307(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x03ff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_S0307) == 0);
-
-  // sign extension and two's complement if negative
-  // (precision is not cut away here, so no rounding is necessary)
-  if ((ulFix & UTL_FIX_SIGN_S0307) == 0) {
-    fFloat = (float)ulFix;
-  } else {
-    ulFix |= ~UTL_FIX_MASK_S0307;
-    ulFix--;
-    ulFix = ~ulFix;
-    fFloat = (float)ulFix;
-    fFloat = -fFloat;
-  }
-
-  fFloat /= UTL_FIX_PRECISION_S0307;
-
-  return fFloat;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_S0407 \n
- *  \RETURNVALUE signed fixed point value in uint32_t container, leading 1's \n
- *               in the upper bits, not used by the format, are suppressed \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to signed fixed point values (two's
- *               complement) with 4 bit integer and 7 bit fractional part to
- *               program the marvin registers. \n
- */
-/*****************************************************************************/
-
-// signed (two's complement) fixed point 4 bit integer / 7 bit fractional part
-// 0x3ff = 1023/128 = 7.9921875
-// 0x080 = 1
-// 0x000 = 0
-// 0x7ff = -1/128 = -0.0078125
-// 0x400 = -1024/128 = -8
-
-uint32_t UtlFloatToFix_S0407(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_S0407);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_S0407);
-
-  fFloat *= UTL_FIX_PRECISION_S0407;
-
-  // round, two's complement if negative
-  if (fFloat > 0.0f) {
-    ulFix = (uint32_t)(fFloat + 0.5f);
-  } else {
-    fFloat = -fFloat;
-    ulFix  = (uint32_t)(fFloat + 0.5f);
-    ulFix  = ~ulFix;
-    ulFix++;
-  }
-
-  // set upper (unused) bits to 0
-  ulFix &= UTL_FIX_MASK_S0407;
 
-  return ulFix;
-}
 
 /*****************************************************************************/
 /*!
- *  \FUNCTION    UtlFixToFloat_S0407 \n
+ *  \FUNCTION    UtlFixToFloatFormat \n
  *  \RETURNVALUE float value \n
- *  \PARAMETERS  signed fixed point value in uint32_t container, leading \n
- *               1's in the upper bits, not used by the format, must be 0 \n
- *  \DESCRIPTION Converts signed fixed point values (two's complement) with \n
- *               4 bit integer and 7 bit fractional part (marvin register) to \n
- *               float values. \n
+ *  \PARAMETERS  format, fixed point value in uint32_t container \n
+ *  \DESCRIPTION Converts a fixed point value of the format to float. \n
+ *               Bits above the register width are ignored, the sign bit \n
+ *               is extended by xor and subtract. \n
  */
 /*****************************************************************************/
-float UtlFixToFloat_S0407(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x07ff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_S0407) == 0);
-
-  // sign extension and two's complement if negative
-  // (precision is not cut away here, so no rounding is necessary)
-  if ((ulFix & UTL_FIX_SIGN_S0407) == 0) {
-    fFloat = (float)ulFix;
-  } else {
-    ulFix |= ~UTL_FIX_MASK_S0407;
-    ulFix--;
-    ulFix = ~ulFix;
-    fFloat = (float)ulFix;
-    fFloat = -fFloat;
-  }
-
-  fFloat /= UTL_FIX_PRECISION_S0407;
+static inline float UtlFixToFloatFormat(const UtlFixFormatDesc_t* pFormat, uint32_t ulFix) {
+  int32_t lFix = (int32_t)((ulFix & pFormat->mask) ^ pFormat->sign) - (int32_t)pFormat->sign;
 
-  return fFloat;
+  // all precisions are powers of 2, the reciprocal is exact
+  return ((float)lFix * (1.0f / pFormat->fPrecision));
 }
 
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_S0504\n
- *  \RETURNVALUE signed fixed point value in uint32_t container, leading 1's \n
- *               in the upper bits, not used by the format, are suppressed \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to signed fixed point values (two's
- *               complement) with 4 bit integer and 7 bit fractional part to
- *               program the marvin registers. \n
- */
-/*****************************************************************************/
-
-// signed (two's complement) fixed point 4 bit integer / 7 bit fractional part
-// 0x3ff = 1023/128 = 7.9921875
-// 0x080 = 1
-// 0x000 = 0
-// 0x7ff = -1/128 = -0.0078125
-// 0x400 = -1024/128 = -8
-
-uint32_t UtlFloatToFix_S0504(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_S0504);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_S0504);
-
-  fFloat *= UTL_FIX_PRECISION_S0504;
-
-  // round, two's complement if negative
-  if (fFloat > 0.0f) {
-    ulFix = (uint32_t)(fFloat + 0.5f);
-  } else {
-    fFloat = -fFloat;
-    ulFix  = (uint32_t)(fFloat + 0.5f);
-    ulFix  = ~ulFix;
-    ulFix++;
-  }
 
-  // set upper (unused) bits to 0
-  ulFix &= UTL_FIX_MASK_S0504;
-
-  return ulFix;
-}
 
 /*****************************************************************************/
 /*!
- *  \FUNCTION    UtlFixToFloat_S0504\n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  signed fixed point value in uint32_t container, leading \n
- *               1's in the upper bits, not used by the format, must be 0 \n
- *  \DESCRIPTION Converts signed fixed point values (two's complement) with \n
- *               4 bit integer and 7 bit fractional part (marvin register) to \n
- *               float values. \n
+ *  Single value converters, the format is constant, so each of them
+ *  compiles to the few instructions of its own format.
  */
 /*****************************************************************************/
-float UtlFixToFloat_S0504(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x07ff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_S0504) == 0);
-
-  // sign extension and two's complement if negative
-  // (precision is not cut away here, so no rounding is necessary)
-  if ((ulFix & UTL_FIX_SIGN_S0504) == 0) {
-    fFloat = (float)ulFix;
-  } else {
-    ulFix |= ~UTL_FIX_MASK_S0504;
-    ulFix--;
-    ulFix = ~ulFix;
-    fFloat = (float)ulFix;
-    fFloat = -fFloat;
+#define UTL_FIX_FLOAT_TO_FIX(fmt) \
+  uint32_t UtlFloatToFix_##fmt(float fFloat) { \
+    return (UtlFloatToFixFormat(&UtlFixFormats[UTL_FIX_##fmt], fFloat)); \
   }
-
-  fFloat /= UTL_FIX_PRECISION_S0504;
-
-  return fFloat;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_S0808 \n
- *  \RETURNVALUE signed fixed point value in uint32_t container, leading 1's \n
- *               in the upper bits, not used by the format, are suppressed \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to signed fixed point values (two's
- *               complement) with 8 bit integer and 8 bit fractional part to
- *               program the marvin registers. \n
- */
-/*****************************************************************************/
-
-// signed (two's complement) fixed point 8 bit integer / 8 bit fractional part
-// 0x7fff = 32767/256 = 127.99609375
-// 0x0100 = 1
-// 0x0000 = 0
-// 0xffff = -1/256 = -0.00390625
-// 0x8000 = -32768/256 = -128
-
-uint32_t UtlFloatToFix_S0808(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_S0808);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_S0808);
-
-  fFloat *= UTL_FIX_PRECISION_S0808;
-
-  // round, two's complement if negative
-  if (fFloat > 0.0f) {
-    ulFix = (uint32_t)(fFloat + 0.5f);
-  } else {
-    fFloat = -fFloat;
-    ulFix  = (uint32_t)(fFloat + 0.5f);
-    ulFix  = ~ulFix;
-    ulFix++;
+#define UTL_FIX_FIX_TO_FLOAT(fmt) \
+  float UtlFixToFloat_##fmt(uint32_t ulFix) { \
+    return (UtlFixToFloatFormat(&UtlFixFormats[UTL_FIX_##fmt], ulFix)); \
   }
 
-  // set upper (unused) bits to 0
-  ulFix &= UTL_FIX_MASK_S0808;
+UTL_FIX_FLOAT_TO_FIX(U0402)
 
-  return ulFix;
-}
+UTL_FIX_FLOAT_TO_FIX(U0107)
+UTL_FIX_FIX_TO_FLOAT(U0107)
 
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_S0808 \n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  signed fixed point value in uint32_t container, leading \n
- *               1's in the upper bits, not used by the format, must be 0 \n
- *  \DESCRIPTION Converts signed fixed point values (two's complement) with \n
- *               8 bit integer and 8 bit fractional part (marvin register) to \n
- *               float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_S0808(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0xffff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_S0808) == 0);
-
-  // sign extension and two's complement if negative
-  // (precision is not cut away here, so no rounding is necessary)
-  if ((ulFix & UTL_FIX_SIGN_S0808) == 0) {
-    fFloat = (float)ulFix;
-  } else {
-    ulFix |= ~UTL_FIX_MASK_S0808;
-    ulFix--;
-    ulFix = ~ulFix;
-    fFloat = (float)ulFix;
-    fFloat = -fFloat;
-  }
+UTL_FIX_FLOAT_TO_FIX(U0208)
+UTL_FIX_FIX_TO_FLOAT(U0208)
 
-  fFloat /= UTL_FIX_PRECISION_S0808;
+UTL_FIX_FLOAT_TO_FIX(U0408)
+UTL_FIX_FIX_TO_FLOAT(U0408)
 
-  return fFloat;
-}
+UTL_FIX_FLOAT_TO_FIX(U0800)
+UTL_FIX_FIX_TO_FLOAT(U0800)
 
+UTL_FIX_FLOAT_TO_FIX(U1000)
+UTL_FIX_FIX_TO_FLOAT(U1000)
 
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_S0800\n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  signed integer value in uint32_t container, leading \n
- *               1's in the upper bits, not used by the format, must be 0 \n
- *  \DESCRIPTION Converts signed integer values (two's complement) with \n
- *               12 bit integer and no fractional part (marvin register) to \n
- *               float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_S0800(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x0fff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_S0800) == 0);
-
-  // sign extension and two's complement if negative
-  // (precision is not cut away here, so no rounding is necessary)
-  if ((ulFix & UTL_FIX_SIGN_S0800) == 0) {
-    fFloat = (float)ulFix;
-  } else {
-    ulFix |= ~UTL_FIX_MASK_S0800;
-    ulFix--;
-    ulFix = ~ulFix;
-    fFloat = (float)ulFix;
-    fFloat = -fFloat;
-  }
+UTL_FIX_FLOAT_TO_FIX(U1200)
+UTL_FIX_FIX_TO_FLOAT(U1200)
 
-  // precision is 1, thus no division is required.
+UTL_FIX_FLOAT_TO_FIX(U0010)
+UTL_FIX_FIX_TO_FLOAT(U0010)
 
-  return fFloat;
-}
+UTL_FIX_FLOAT_TO_FIX(S0207)
+UTL_FIX_FIX_TO_FLOAT(S0207)
 
+UTL_FIX_FLOAT_TO_FIX(S0307)
+UTL_FIX_FIX_TO_FLOAT(S0307)
 
+UTL_FIX_FLOAT_TO_FIX(S0407)
+UTL_FIX_FIX_TO_FLOAT(S0407)
 
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_S0800\n
- *  \RETURNVALUE signed integer value in uint32_t container, leading 1's \n
- *               in the upper bits, not used by the format, are suppressed \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to signed integer values (two's
- *               complement) with 12 bit integer and no fractional part to
- *               program the marvin registers. \n
- */
-/*****************************************************************************/
+UTL_FIX_FLOAT_TO_FIX(S0504)
+UTL_FIX_FIX_TO_FLOAT(S0504)
 
-// signed (two's complement) 12 bit integer, no fractional part
-// 0x7ff = 2047
-// 0x001 = 1
-// 0x000 = 0
-// 0xfff = -1
-// 0x800 = -2048
-
-uint32_t UtlFloatToFix_S0800(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_S0800);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_S0800);
-
-  // precision is 1, thus no multiplication is required
-
-  // round, two's complement if negative
-  if (fFloat > 0.0f) {
-    ulFix = (uint32_t)(fFloat + 0.5f);
-  } else {
-    fFloat = -fFloat;
-    ulFix  = (uint32_t)(fFloat + 0.5f);
-    ulFix  = ~ulFix;
-    ulFix++;
-  }
+UTL_FIX_FLOAT_TO_FIX(S0808)
+UTL_FIX_FIX_TO_FLOAT(S0808)
 
-  // set upper (unused) bits to 0
-  ulFix &= UTL_FIX_MASK_S0800;
+UTL_FIX_FLOAT_TO_FIX(S0800)
+UTL_FIX_FIX_TO_FLOAT(S0800)
 
-  return ulFix;
-}
+UTL_FIX_FLOAT_TO_FIX(S0900)
+UTL_FIX_FIX_TO_FLOAT(S0900)
 
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_S0900\n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  signed integer value in uint32_t container, leading \n
- *               1's in the upper bits, not used by the format, must be 0 \n
- *  \DESCRIPTION Converts signed integer values (two's complement) with \n
- *               12 bit integer and no fractional part (marvin register) to \n
- *               float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_S0900(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x0fff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_S0900) == 0);
-
-  // sign extension and two's complement if negative
-  // (precision is not cut away here, so no rounding is necessary)
-  if ((ulFix & UTL_FIX_SIGN_S0900) == 0) {
-    fFloat = (float)ulFix;
-  } else {
-    ulFix |= ~UTL_FIX_MASK_S0900;
-    ulFix--;
-    ulFix = ~ulFix;
-    fFloat = (float)ulFix;
-    fFloat = -fFloat;
-  }
+UTL_FIX_FLOAT_TO_FIX(S1200)
+UTL_FIX_FIX_TO_FLOAT(S1200)
 
-  // precision is 1, thus no division is required.
+UTL_FIX_FLOAT_TO_FIX(S0109)
+UTL_FIX_FIX_TO_FLOAT(S0109)
 
-  return fFloat;
-}
+UTL_FIX_FLOAT_TO_FIX(S0408)
+UTL_FIX_FIX_TO_FLOAT(S0408)
 
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_S0900\n
- *  \RETURNVALUE signed integer value in uint32_t container, leading 1's \n
- *               in the upper bits, not used by the format, are suppressed \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to signed integer values (two's
- *               complement) with 12 bit integer and no fractional part to
- *               program the marvin registers. \n
- */
-/*****************************************************************************/
+UTL_FIX_FLOAT_TO_FIX(S0108)
+UTL_FIX_FIX_TO_FLOAT(S0108)
 
-// signed (two's complement) 12 bit integer, no fractional part
-// 0x7ff = 2047
-// 0x001 = 1
-// 0x000 = 0
-// 0xfff = -1
-// 0x800 = -2048
-
-uint32_t UtlFloatToFix_S0900(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_S0900);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_S0900);
-
-  // precision is 1, thus no multiplication is required
-
-  // round, two's complement if negative
-  if (fFloat > 0.0f) {
-    ulFix = (uint32_t)(fFloat + 0.5f);
-  } else {
-    fFloat = -fFloat;
-    ulFix  = (uint32_t)(fFloat + 0.5f);
-    ulFix  = ~ulFix;
-    ulFix++;
-  }
+UTL_FIX_FLOAT_TO_FIX(S0110)
+UTL_FIX_FIX_TO_FLOAT(S0110)
 
-  // set upper (unused) bits to 0
-  ulFix &= UTL_FIX_MASK_S0900;
 
-  return ulFix;
-}
 
 /*****************************************************************************/
 /*!
- *  \FUNCTION    UtlFloatToFix_S1200 \n
- *  \RETURNVALUE signed integer value in uint32_t container, leading 1's \n
- *               in the upper bits, not used by the format, are suppressed \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to signed integer values (two's
- *               complement) with 12 bit integer and no fractional part to
- *               program the marvin registers. \n
+ *  \FUNCTION    UtlFloatToFixArray \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  format, float values, fixed point values, number of values \n
+ *  \DESCRIPTION Converts an array of float values to fixed point values, \n
+ *               e.g. a matrix or a curve, like the single value converter \n
+ *               of the format does for each of them. \n
  */
 /*****************************************************************************/
+void UtlFloatToFixArray(UtlFixFormat_t format, const float* pFloat, uint32_t* pFix, uint32_t count) {
+  DCT_ASSERT(format < UTL_FIX_FORMAT_MAX);
 
-// signed (two's complement) 12 bit integer, no fractional part
-// 0x7ff = 2047
-// 0x001 = 1
-// 0x000 = 0
-// 0xfff = -1
-// 0x800 = -2048
-
-uint32_t UtlFloatToFix_S1200(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_S1200);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_S1200);
-
-  // precision is 1, thus no multiplication is required
-
-  // round, two's complement if negative
-  if (fFloat > 0.0f) {
-    ulFix = (uint32_t)(fFloat + 0.5f);
-  } else {
-    fFloat = -fFloat;
-    ulFix  = (uint32_t)(fFloat + 0.5f);
-    ulFix  = ~ulFix;
-    ulFix++;
-  }
-
-  // set upper (unused) bits to 0
-  ulFix &= UTL_FIX_MASK_S1200;
+  // a local copy, the stores through pFix can not alias it
+  const UtlFixFormatDesc_t desc = UtlFixFormats[format];
+  uint32_t i;
 
-  return ulFix;
-}
-
-
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_S1200 \n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  signed integer value in uint32_t container, leading \n
- *               1's in the upper bits, not used by the format, must be 0 \n
- *  \DESCRIPTION Converts signed integer values (two's complement) with \n
- *               12 bit integer and no fractional part (marvin register) to \n
- *               float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_S1200(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x0fff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_S1200) == 0);
-
-  // sign extension and two's complement if negative
-  // (precision is not cut away here, so no rounding is necessary)
-  if ((ulFix & UTL_FIX_SIGN_S1200) == 0) {
-    fFloat = (float)ulFix;
-  } else {
-    ulFix |= ~UTL_FIX_MASK_S1200;
-    ulFix--;
-    ulFix = ~ulFix;
-    fFloat = (float)ulFix;
-    fFloat = -fFloat;
+  for (i = 0U; i < count; i++) {
+    pFix[i] = UtlFloatToFixFormat(&desc, pFloat[i]);
   }
-
-  // precision is 1, thus no division is required.
-
-  return fFloat;
 }
 
 
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_S0109\n
- *  \RETURNVALUE signed fixed point value in uint32_t container, leading 1's \n
- *               in the upper bits, not used by the format, are suppressed \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to signed fixed point values (two's
- *               complement) with 1 bit integer and 9 bit fractional part to
- *               program the marvin registers. \n
- */
-/*****************************************************************************/
-
-// signed (two's complement) fixed point 1 bit integer / 9 bit fractional part
-// 0x01ff = 511/512 = 0.998046875
-// 0x0000 = 0
-// 0x03ff = -1/512 = -0.001953125
-// 0x0200 = -1
-
-uint32_t UtlFloatToFix_S0109(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_S0109);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_S0109);
-
-  fFloat *= UTL_FIX_PRECISION_S0109;
-
-  // round, two's complement if negative
-  if (fFloat > 0.0f) {
-    ulFix = (uint32_t)(fFloat + 0.5f);
-  } else {
-    fFloat = -fFloat;
-    ulFix  = (uint32_t)(fFloat + 0.5f);
-    ulFix  = ~ulFix;
-    ulFix++;
-  }
-
-  // set upper (unused) bits to 0
-  ulFix &= UTL_FIX_MASK_S0109;
-
-  return ulFix;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_S0109\n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  signed fixed point value in uint32_t container, leading \n
- *               1's in the upper bits, not used by the format, must be 0 \n
- *  \DESCRIPTION Converts signed fixed point values (two's complement) with \n
- *               1 bit integer and 9 bit fractional part (marvin register) to \n
- *               float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_S0109(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x03ff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_S0109) == 0);
-
-  // sign extension and two's complement if negative
-  // (precision is not cut away here, so no rounding is necessary)
-  if ((ulFix & UTL_FIX_SIGN_S0109) == 0) {
-    fFloat = (float)ulFix;
-  } else {
-    ulFix |= ~UTL_FIX_MASK_S0109;
-    ulFix--;
-    ulFix = ~ulFix;
-    fFloat = (float)ulFix;
-    fFloat = -fFloat;
-  }
-
-  fFloat /= UTL_FIX_PRECISION_S0109;
-
-  return fFloat;
-}
 
 /*****************************************************************************/
 /*!
- *  \FUNCTION    UtlFloatToFix_S0408\n
- *  \RETURNVALUE signed fixed point value in uint32_t container, leading 1's \n
- *               in the upper bits, not used by the format, are suppressed \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to signed fixed point values (two's
- *               complement) with 4 bit integer and 8 bit fractional part to
- *               program the marvin registers. \n
+ *  \FUNCTION    UtlFixToFloatArray \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  format, fixed point values, float values, number of values \n
+ *  \DESCRIPTION Converts an array of fixed point values to float values. \n
  */
 /*****************************************************************************/
+void UtlFixToFloatArray(UtlFixFormat_t format, const uint32_t* pFix, float* pFloat, uint32_t count) {
+  DCT_ASSERT(format < UTL_FIX_FORMAT_MAX);
 
-// signed (two's complement) fixed point 4 bit integer / 8 bit fractional part
-// 0x07ff = 2047/256 = 7.99609375
-// 0x0100 = 1
-// 0x0000 = 0
-// 0x0fff = -1/256 = -0.00390625
-// 0x0800 = -8
-
-uint32_t UtlFloatToFix_S0408(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_S0408);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_S0408);
-
-  fFloat *= UTL_FIX_PRECISION_S0408;
-
-  // round, two's complement if negative
-  if (fFloat > 0.0f) {
-    ulFix = (uint32_t)(fFloat + 0.5f);
-  } else {
-    fFloat = -fFloat;
-    ulFix  = (uint32_t)(fFloat + 0.5f);
-    ulFix  = ~ulFix;
-    ulFix++;
-  }
-
-  // set upper (unused) bits to 0
-  ulFix &= UTL_FIX_MASK_S0408;
-
-  return ulFix;
-}
+  const UtlFixFormatDesc_t desc = UtlFixFormats[format];
+  uint32_t i;
 
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_S0408\n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  signed fixed point value in uint32_t container, leading \n
- *               1's in the upper bits, not used by the format, must be 0 \n
- *  \DESCRIPTION Converts signed fixed point values (two's complement) with \n
- *               4 bit integer and 8 bit fractional part (marvin register) to \n
- *               float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_S0408(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x0fff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_S0408) == 0);
-
-  // sign extension and two's complement if negative
-  // (precision is not cut away here, so no rounding is necessary)
-  if ((ulFix & UTL_FIX_SIGN_S0408) == 0) {
-    fFloat = (float)ulFix;
-  } else {
-    ulFix |= ~UTL_FIX_MASK_S0408;
-    ulFix--;
-    ulFix = ~ulFix;
-    fFloat = (float)ulFix;
-    fFloat = -fFloat;
+  for (i = 0U; i < count; i++) {
+    pFloat[i] = UtlFixToFloatFormat(&desc, pFix[i]);
   }
-
-  fFloat /= UTL_FIX_PRECISION_S0408;
-
-  return fFloat;
 }
-
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_S0108\n
- *  \RETURNVALUE signed fixed point value in uint32_t container, leading 1's \n
- *               in the upper bits, not used by the format, are suppressed \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to signed fixed point values (two's
- *               complement) with 1 bit integer and 8 bit fractional part to
- *               program the marvin registers. \n
- */
-/*****************************************************************************/
-
-// signed (two's complement) fixed point 1 bit integer / 8 bit fractional part
-// 0x00ff = 255/256 = 0.99609375
-// 0x0000 = 0
-// 0x01ff = -1/256 = -0.00390625
-// 0x0100 = -1
-
-uint32_t UtlFloatToFix_S0108(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_S0108);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_S0108);
-
-  fFloat *= UTL_FIX_PRECISION_S0108;
-
-  // round, two's complement if negative
-  if (fFloat > 0.0f) {
-    ulFix = (uint32_t)(fFloat + 0.5f);
-  } else {
-    fFloat = -fFloat;
-    ulFix  = (uint32_t)(fFloat + 0.5f);
-    ulFix  = ~ulFix;
-    ulFix++;
-  }
-
-  // set upper (unused) bits to 0
-  ulFix &= UTL_FIX_MASK_S0108;
-
-  return ulFix;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_S0108\n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  signed fixed point value in uint32_t container, leading \n
- *               1's in the upper bits, not used by the format, must be 0 \n
- *  \DESCRIPTION Converts signed fixed point values (two's complement) with \n
- *               1 bit integer and 8 bit fractional part (marvin register) to \n
- *               float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_S0108(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x0fff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_S0108) == 0);
-
-  // sign extension and two's complement if negative
-  // (precision is not cut away here, so no rounding is necessary)
-  if ((ulFix & UTL_FIX_SIGN_S0108) == 0) {
-    fFloat = (float)ulFix;
-  } else {
-    ulFix |= ~UTL_FIX_MASK_S0108;
-    ulFix--;
-    ulFix = ~ulFix;
-    fFloat = (float)ulFix;
-    fFloat = -fFloat;
-  }
-
-  fFloat /= UTL_FIX_PRECISION_S0108;
-
-  return fFloat;
-}
-
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFloatToFix_S0110\n
- *  \RETURNVALUE signed fixed point value in uint32_t container, leading 1's \n
- *               in the upper bits, not used by the format, are suppressed \n
- *  \PARAMETERS  float value \n
- *  \DESCRIPTION Converts float values to signed fixed point values (two's
- *               complement) with 1 bit integer and 10 bit fractional part to
- *               program the marvin registers. \n
- */
-/*****************************************************************************/
-
-// signed (two's complement) fixed point 1 bit integer / 10 bit fractional part
-// 0x03ff = 1023/1024 = 0.9990234375
-// 0x0000 = 0
-// 0x07ff = -1/1024 = -0.0009765625
-// 0x0400 = -1
-
-
-uint32_t UtlFloatToFix_S0110(float fFloat) {
-  uint32_t ulFix = 0;
-
-  DCT_ASSERT(fFloat <= UTL_FIX_MAX_S0110);
-  DCT_ASSERT(fFloat >= UTL_FIX_MIN_S0110);
-
-  fFloat *= UTL_FIX_PRECISION_S0110;
-
-  // round, two's complement if negative
-  if (fFloat > 0.0f) {
-    ulFix = (uint32_t)(fFloat + 0.5f);
-  } else {
-    fFloat = -fFloat;
-    ulFix  = (uint32_t)(fFloat + 0.5f);
-    ulFix  = ~ulFix;
-    ulFix++;
-  }
-
-  // set upper (unused) bits to 0
-  ulFix &= UTL_FIX_MASK_S0110;
-
-  return ulFix;
-}
-
-/*****************************************************************************/
-/*!
- *  \FUNCTION    UtlFixToFloat_S0110\n
- *  \RETURNVALUE float value \n
- *  \PARAMETERS  signed fixed point value in uint32_t container, leading \n
- *               1's in the upper bits, not used by the format, must be 0 \n
- *  \DESCRIPTION Converts signed fixed point values (two's complement) with \n
- *               1 bit integer and 10 bit fractional part (marvin register) to \n
- *               float values. \n
- */
-/*****************************************************************************/
-float UtlFixToFloat_S0110(uint32_t ulFix) {
-  float fFloat = 0;
-
-  // any value from 0x0000 to 0x0fff will do as input
-  DCT_ASSERT((ulFix & ~UTL_FIX_MASK_S0110) == 0);
-
-  // sign extension and two's complement if negative
-  // (precision is not cut away here, so no rounding is necessary)
-  if ((ulFix & UTL_FIX_SIGN_S0110) == 0) {
-    fFloat = (float)ulFix;
-  } else {
-    ulFix |= ~UTL_FIX_MASK_S0110;
-    ulFix--;
-    ulFix = ~ulFix;
-    fFloat = (float)ulFix;
-    fFloat = -fFloat;
-  }
-
-  fFloat /= UTL_FIX_PRECISION_S0110;
-
-  return fFloat;
-}
-
@@ -28,6 +28,9 @@
 #include <cam_calibdb/cam_calibdb_api.h>
 using namespace tinyxml2;
 
+class CalibDbImage;
+struct CalibDbSource;
+
 struct sensor_calib_info {
   CamCalibDbMetaData_t meta_data;
   CamResolution_t resolution;
@@ -68,6 +71,8 @@ class CalibDb {
   }
 
   bool CreateCalibDb(const XMLElement*);
+  // loads the binary image next to @device if it matches the file,
+  // parses the file and writes the image otherwise
   bool CreateCalibDb(const char* device);
   struct sensor_calib_info* GetCalibDbInfo() {
     return &(m_CalibInfo);
@@ -81,6 +86,11 @@ class CalibDb {
 
   typedef bool (CalibDb::*parseCellContent)(const XMLElement*, void* param);
 
+  // creates the database and parses all sections of a calibration file
+  bool parseCalibDb(const XMLElement*);
+  // second build of the database to write the image of the first one
+  void storeCalibDbImage(const XMLElement*, const char* path, const CalibDbSource*);
+
   // parse helper
   bool parseEntryCell(const XMLElement*, int, parseCellContent, void* param = NULL);
 
@@ -163,6 +173,7 @@ class CalibDb {
  private:
 
   CamCalibDbHandle_t  m_CalibDbHandle;
+  CalibDbImage*       m_CalibDbImage;
   struct sensor_calib_info m_CalibInfo;
 };
 
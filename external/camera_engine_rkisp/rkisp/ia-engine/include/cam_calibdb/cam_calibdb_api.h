@@ -127,6 +127,45 @@ RESULT CamCalibDbClear
 
 
 
+/*****************************************************************************/
+/**
+ * @brief   The function indexes the lists of a completely loaded CamCalibDb
+ *          instance, the getters then look up items without walking the
+ *          lists. Any later Add, Del or Replace drops the index again.
+ *
+ * @param   hCamCalibDb         Handle to the CamCalibDb instance.
+ *
+ * @return  Return the result of the function call.
+ * @retval  RET_SUCCESS         function succeed
+ * @retval  RET_WRONG_HANDLE    invalid instance handle
+ * @retval  RET_OUTOFMEM        not enough memory available
+ *
+ *****************************************************************************/
+RESULT CamCalibDbBuildIndex
+(
+    CamCalibDbHandle_t  hCamCalibDb
+);
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   The function releases the index of a CamCalibDb instance.
+ *
+ * @param   hCamCalibDb         Handle to the CamCalibDb instance.
+ *
+ * @return  Return the result of the function call.
+ * @retval  RET_SUCCESS         function succeed
+ * @retval  RET_WRONG_HANDLE    invalid instance handle
+ *
+ *****************************************************************************/
+RESULT CamCalibDbReleaseIndex
+(
+    CamCalibDbHandle_t  hCamCalibDb
+);
+
+
+
 /*****************************************************************************/
 /**
  * @brief   This function stores a DB meta-data in the CamCalibDb instance.
@@ -0,0 +1,121 @@
+/******************************************************************************
+ *
+ * Copyright 2019, Fuzhou Rockchip Electronics Co.Ltd . All rights reserved.
+ * No part of this work may be reproduced, modified, distributed, transmitted,
+ * transcribed, or translated into any language or computer format, in any form
+ * or by any means without written permission of:
+ * Fuzhou Rockchip Electronics Co.Ltd .
+ *
+ *
+ *****************************************************************************/
+/**
+ * @file cam_calibdb_arena.h
+ *
+ * @brief
+ *   Allocator of the CamCalibDb instance data.
+ *
+ *****************************************************************************/
+/**
+ * @defgroup cam_calibdb_arena CamCalibDb arena
+ * @{
+ *
+ * Every block of a CamCalibDb instance, the context as well as the profiles
+ * and arrays added while parsing the calibration file, is allocated through
+ * CamCalibDbMalloc. With an arena bound to the calling thread the blocks are
+ * carved out of one contiguous region, so the whole database can be stored
+ * and mapped again as a single image.
+ */
+
+#ifndef __CAM_CALIBDB_ARENA_H__
+#define __CAM_CALIBDB_ARENA_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*****************************************************************************/
+/**
+ * @brief   Alignment of the blocks carved out of an arena.
+ *
+ *****************************************************************************/
+#define CAM_CALIBDB_ARENA_ALIGN 16
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   Region the blocks of one CamCalibDb instance are carved out of.
+ *          The region is provided by the caller and must be zeroed.
+ *
+ *****************************************************************************/
+typedef struct CamCalibDbArena_s {
+  uint8_t*  base;         /**< start of the region */
+  size_t    capacity;     /**< size of the region */
+  size_t    used;         /**< bytes carved out so far */
+  int       overflow;     /**< a block did not fit and came from the heap */
+} CamCalibDbArena_t;
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   This function routes the CamCalibDbMalloc calls of the calling
+ *          thread into an arena.
+ *
+ * @param   pArena          arena to bind, NULL to return to the heap
+ *
+ * @return  void
+ *
+ *****************************************************************************/
+void CamCalibDbArenaBind
+(
+    CamCalibDbArena_t*  pArena
+);
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   This function allocates a block of CamCalibDb data, from the bound
+ *          arena if any, from the heap otherwise.
+ *
+ * @param   size            size of the block
+ *
+ * @return  the block, NULL if out of memory
+ *
+ *****************************************************************************/
+void* CamCalibDbMalloc
+(
+    size_t  size
+);
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   This function frees a block of CamCalibDb data. Blocks inside the
+ *          bound arena are only released with the arena itself.
+ *
+ * @param   p               block to free
+ *
+ * @return  void
+ *
+ *****************************************************************************/
+void CamCalibDbFree
+(
+    void*  p
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+/* @} cam_calibdb_arena */
+
+#endif /* __CAM_CALIBDB_ARENA_H__ */
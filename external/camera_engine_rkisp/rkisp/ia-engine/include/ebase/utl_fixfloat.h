@@ -26,6 +26,31 @@ extern "C"
 #define UTL_FIX_MAX_U0208          3.998f //exactly this would be < 4 - 0.5/256
 #define UTL_FIX_MIN_U0208          0.0f
 
+/* fixed point formats, for the array converters */
+typedef enum UtlFixFormat_e {
+  UTL_FIX_U0402 = 0,
+  UTL_FIX_U0107,
+  UTL_FIX_U0208,
+  UTL_FIX_U0408,
+  UTL_FIX_U0800,
+  UTL_FIX_U1000,
+  UTL_FIX_U1200,
+  UTL_FIX_U0010,
+  UTL_FIX_S0207,
+  UTL_FIX_S0307,
+  UTL_FIX_S0407,
+  UTL_FIX_S0504,
+  UTL_FIX_S0808,
+  UTL_FIX_S0800,
+  UTL_FIX_S0900,
+  UTL_FIX_S1200,
+  UTL_FIX_S0109,
+  UTL_FIX_S0408,
+  UTL_FIX_S0108,
+  UTL_FIX_S0110,
+  UTL_FIX_FORMAT_MAX
+} UtlFixFormat_t;
+
 uint32_t UtlFloatToFix_U0402(float fFloat);
 
 uint32_t UtlFloatToFix_U0107(float fFloat);
@@ -84,6 +109,9 @@ float UtlFixToFloat_S0108(uint32_t ulFix);
 
 uint32_t UtlFloatToFix_S0110(float fFloat);
 float UtlFixToFloat_S0110(uint32_t ulFix);
+
+void UtlFloatToFixArray(UtlFixFormat_t format, const float* pFloat, uint32_t* pFix, uint32_t count);
+void UtlFixToFloatArray(UtlFixFormat_t format, const uint32_t* pFix, float* pFloat, uint32_t count);
 #ifdef __cplusplus
 }
 #endif
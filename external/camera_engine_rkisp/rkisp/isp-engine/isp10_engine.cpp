@@ -372,9 +372,16 @@ bool Isp10Engine::applyIspConfig(struct CamIsp10ConfigSet* isp_cfg) {
 bool Isp10Engine::convertIspStats(
     struct cifisp_stat_buffer* isp_stats,
     struct CamIA10_Stats* ia_stats) {
+  return convertIspStats(isp_stats, isp_stats->meas_type, ia_stats);
+}
+
+bool Isp10Engine::convertIspStats(
+    const struct cifisp_stat_buffer* isp_stats,
+    unsigned int meas_type,
+    struct CamIA10_Stats* ia_stats) {
   unsigned int i;
 
-  if (isp_stats->meas_type & CIFISP_STAT_AUTOEXP) {
+  if (meas_type & CIFISP_STAT_AUTOEXP) {
     ia_stats->meas_type |= CAMIA10_AEC_MASK;
     memcpy(ia_stats->aec.exp_mean,
            isp_stats->params.ae.exp_mean,
@@ -392,7 +399,7 @@ bool Isp10Engine::convertIspStats(
     }*/
   }
 
-  if (isp_stats->meas_type & CIFISP_STAT_HIST) {
+  if (meas_type & CIFISP_STAT_HIST) {
     ia_stats->meas_type |= CAMIA10_HST_MASK;
     memcpy(ia_stats->aec.hist_bins,
            isp_stats->params.hist.hist_bins,
@@ -409,9 +416,9 @@ bool Isp10Engine::convertIspStats(
     */
   }
 
-  if (isp_stats->meas_type & CIFISP_STAT_EMB_DATA) {
-    cifisp_preisp_hdr_ae_embeded_type_t *preisp_hdr_ae_stats =
-           (cifisp_preisp_hdr_ae_embeded_type_t *)isp_stats->params.emd.data;
+  if (meas_type & CIFISP_STAT_EMB_DATA) {
+    const cifisp_preisp_hdr_ae_embeded_type_t *preisp_hdr_ae_stats =
+           (const cifisp_preisp_hdr_ae_embeded_type_t *)isp_stats->params.emd.data;
 
     ia_stats->meas_type |= CAMIA10_AEC_MASK | CAMIA10_HST_MASK;
     ia_stats->aec.is_hdr_stats = true;
@@ -431,10 +438,10 @@ bool Isp10Engine::convertIspStats(
             preisp_hdr_ae_stats->result.reg_exp_gain[2];
     for (int i = 0; i < CIFISP_PREISP_HDRAE_MAXFRAMES; i++) {
         memcpy((char*)ia_stats->aec.oneframe[i].hdr_hist_bins,
-               (char*)preisp_hdr_ae_stats->result.oneframe[i].hist_meas.hist_bin,
+               (const char*)preisp_hdr_ae_stats->result.oneframe[i].hist_meas.hist_bin,
                sizeof(ia_stats->aec.oneframe[i].hdr_hist_bins));
         memcpy((char*)ia_stats->aec.oneframe[i].hdr_exp_mean,
-               (char*)preisp_hdr_ae_stats->result.oneframe[i].mean_meas.y_meas,
+               (const char*)preisp_hdr_ae_stats->result.oneframe[i].mean_meas.y_meas,
                sizeof(ia_stats->aec.oneframe[i].hdr_exp_mean));
     }
 
@@ -450,7 +457,7 @@ bool Isp10Engine::convertIspStats(
             preisp_hdr_ae_stats->result.OEMeasRes.SframeMaxLuma;
   }
 
-  if (isp_stats->meas_type & CIFISP_STAT_AWB) {
+  if (meas_type & CIFISP_STAT_AWB) {
     ia_stats->meas_type |= CAMIA10_AWB_MEAS_MASK;
     if (mIspCfg.awb_meas_config.awb_mode == CIFISP_AWB_MODE_YCBCR) {
       ia_stats->awb.NoWhitePixel = isp_stats->params.awb.awb_mean[0].cnt;
@@ -487,7 +494,7 @@ bool Isp10Engine::convertIspStats(
 #endif
   }
 
-  if (isp_stats->meas_type & CIFISP_STAT_AFM_FIN) {
+  if (meas_type & CIFISP_STAT_AFM_FIN) {
     ia_stats->meas_type |= CAMIA10_AFC_MASK;
     ia_stats->af.cameric.SharpnessA = isp_stats->params.af.window[0].sum;
     ia_stats->af.cameric.LuminanceA = isp_stats->params.af.window[0].lum;
@@ -54,6 +54,10 @@ class Isp10Engine: public IspEngine {
   virtual bool applyIspConfig(struct CamIsp10ConfigSet* isp_cfg);
   virtual bool convertIspStats(struct cifisp_stat_buffer* isp_stats,
                                struct CamIA10_Stats* ia_stats);
+  // reads @isp_stats in place, @meas_type overrides its meas_type
+  bool convertIspStats(const struct cifisp_stat_buffer* isp_stats,
+                       unsigned int meas_type,
+                       struct CamIA10_Stats* ia_stats);
   virtual bool convertIAResults(
       struct CamIsp10ConfigSet* isp_cfg,
       struct CamIA10_Results* ia_results);
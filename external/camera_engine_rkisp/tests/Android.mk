@@ -104,3 +104,9 @@ endif
 LOCAL_MODULE:= test_ispcl
 
 #include $(BUILD_EXECUTABLE)
+
+ifeq ($(IS_ANDROID_OS),true)
+include $(call all-subdir-makefiles)
+else
+include $(call allSubdirMakefiles)
+endif
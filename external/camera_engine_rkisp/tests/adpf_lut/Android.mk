@@ -0,0 +1,36 @@
+LOCAL_PATH:= $(call my-dir)
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES +=\
+	adpf_lut_test.cpp
+
+LOCAL_CPPFLAGS += -std=c++11 -Wno-error
+LOCAL_CPPFLAGS += -DLINUX -DHAS_STDINT_H
+LOCAL_CPPFLAGS += $(PRJ_CPPFLAGS)
+
+LOCAL_C_INCLUDES := \
+	$(LOCAL_PATH) \
+	$(LOCAL_PATH)/../../rkisp/ia-engine \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/include \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/aaa/adpf/include \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/aaa/adpf/include_priv
+
+ifeq ($(IS_NEED_COMPILE_TINYXML2), true)
+LOCAL_C_INCLUDES += \
+	$(LOCAL_PATH)/../../ext/tinyxml2
+else
+LOCAL_C_INCLUDES += \
+	external/tinyxml2
+endif
+
+LOCAL_SHARED_LIBRARIES += libdl librkisp
+
+ifeq ($(IS_ANDROID_OS),true)
+LOCAL_32_BIT_ONLY := true
+LOCAL_SHARED_LIBRARIES += libutils libcutils liblog
+endif
+
+LOCAL_MODULE:= adpf_lut_test
+
+include $(BUILD_EXECUTABLE)
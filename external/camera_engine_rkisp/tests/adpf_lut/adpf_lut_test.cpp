@@ -0,0 +1,262 @@
+/*
+ * adpf_lut_test.cpp - ADPF gain tables against the calibration curves
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Configures two ADPF instances from each given iq file. One runs on the
+ * gain tables AdpfApplyConfiguration samples, the other has its tables
+ * dropped and so evaluates the calibration curves at every gain. Both
+ * sweep the gain of every light mode up and down the sampled range, and
+ * at each gain the table outputs must match the curves:
+ *   - the DPF strength to within 1 LSB per channel
+ *   - the denoise, sharpening and demosaic levels and the 3DNR result
+ *     exactly, at the gain or at the nearest sample of the table
+ * The table instance must also raise ADPF_STRENGTH_MASK and
+ * ADPF_DENOISE_SHARP_LEVEL_MASK exactly on the frames which change them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <calib_xml/calibdb.h>
+#include "adpf_ctrl.h"
+
+#define LUT_TEST_STEPS          1000
+#define LUT_TEST_STRENGTH_LSB   1
+
+struct LutTestOutputs {
+    CamerIcDpfInvStrength_t         strength;
+    CamerIcIspFltDeNoiseLevel_t     denoise_level;
+    CamerIcIspFltSharpeningLevel_t  sharp_level;
+    uint8_t                         demosaic_th;
+    bool_t                          flt_enable;
+    Dsp3DnrResult_t                 dsp_3dnr;
+};
+
+struct LutTestStats {
+    uint32_t gains;
+    uint32_t masks;
+    uint32_t failed;
+};
+
+static void
+lut_test_outputs (const AdpfContext_t *ctx, LutTestOutputs &out)
+{
+    out.strength = ctx->DynInvStrength;
+    out.denoise_level = ctx->denoise_level;
+    out.sharp_level = ctx->sharp_level;
+    out.demosaic_th = ctx->demosaic_th;
+    out.flt_enable = ctx->FltEnable;
+    out.dsp_3dnr = ctx->Dsp3DnrResult;
+}
+
+// outputs of the curves at @gain, the gain step hysteresis is defeated
+static bool
+lut_test_curves (AdpfContext_t *ctx, float gain, enum LIGHT_MODE mode, LutTestOutputs &out)
+{
+    ctx->gain = -1.0f;
+    if (AdpfRun ((AdpfHandle_t)ctx, gain, mode) != RET_SUCCESS)
+        return false;
+    lut_test_outputs (ctx, out);
+    return true;
+}
+
+static bool
+lut_test_strength_close (const CamerIcDpfInvStrength_t &a, const CamerIcDpfInvStrength_t &b, int lsb)
+{
+    return abs (a.WeightR - b.WeightR) <= lsb && abs (a.WeightG - b.WeightG) <= lsb &&
+           abs (a.WeightB - b.WeightB) <= lsb;
+}
+
+static bool
+lut_test_levels_equal (const LutTestOutputs &a, const LutTestOutputs &b, bool use_filter, bool use_3dnr)
+{
+    if (use_filter && (a.denoise_level != b.denoise_level || a.sharp_level != b.sharp_level ||
+                       a.demosaic_th != b.demosaic_th))
+        return false;
+    if (use_3dnr && memcmp (&a.dsp_3dnr, &b.dsp_3dnr, sizeof (a.dsp_3dnr)))
+        return false;
+    return true;
+}
+
+static bool
+lut_test_gain (AdpfContext_t *table, AdpfContext_t *curves, float gain, enum LIGHT_MODE mode, LutTestStats &stats)
+{
+    const AdpfLut_t &lut = table->Lut[mode];
+    bool use_strength = table->ADPFEnable && table->Config.mode == ADPF_MODE_CONTROL_BY_GAIN;
+    bool use_filter = table->FilterProfile[mode].FilterEnable >= 1.0;
+    bool use_3dnr = table->Dsp3DnrResult.Enable == 1;
+    LutTestOutputs prev, got, at_gain, at_sample;
+    bool ok = true;
+
+    lut_test_outputs (table, prev);
+    table->actives = 0;
+    if (AdpfRun ((AdpfHandle_t)table, gain, mode) != RET_SUCCESS) {
+        printf ("gain %.3f: table run failed\n", gain);
+        return false;
+    }
+    lut_test_outputs (table, got);
+
+    float sample = 1.0f + (int)((gain - 1.0f) * lut.fScale + 0.5f) / lut.fScale;
+    if (!lut_test_curves (curves, gain, mode, at_gain) ||
+            !lut_test_curves (curves, sample, mode, at_sample)) {
+        printf ("gain %.3f: curve run failed\n", gain);
+        return false;
+    }
+
+    if (use_strength && !lut_test_strength_close (got.strength, at_gain.strength, LUT_TEST_STRENGTH_LSB) &&
+            !lut_test_strength_close (got.strength, at_sample.strength, 0)) {
+        printf ("mode %d gain %.3f: strength %d/%d/%d, curves %d/%d/%d\n", mode, gain,
+                got.strength.WeightR, got.strength.WeightG, got.strength.WeightB,
+                at_gain.strength.WeightR, at_gain.strength.WeightG, at_gain.strength.WeightB);
+        ok = false;
+    }
+    if (!lut_test_levels_equal (got, at_gain, use_filter, use_3dnr) &&
+            !lut_test_levels_equal (got, at_sample, use_filter, use_3dnr)) {
+        printf ("mode %d gain %.3f: denoise %d sharp %d demosaic %d, curves %d %d %d\n", mode, gain,
+                got.denoise_level, got.sharp_level, got.demosaic_th,
+                at_gain.denoise_level, at_gain.sharp_level, at_gain.demosaic_th);
+        ok = false;
+    }
+
+    // a mask is raised exactly when its outputs change
+    bool strength_changed = memcmp (&got.strength, &prev.strength, sizeof (got.strength)) != 0;
+    bool level_changed = got.denoise_level != prev.denoise_level ||
+                         got.sharp_level != prev.sharp_level || got.flt_enable != prev.flt_enable;
+    if (!!(table->actives & ADPF_STRENGTH_MASK) != strength_changed ||
+            !!(table->actives & ADPF_DENOISE_SHARP_LEVEL_MASK) != level_changed) {
+        printf ("mode %d gain %.3f: actives 0x%x, strength changed %d, levels changed %d\n",
+                mode, gain, table->actives, strength_changed, level_changed);
+        ok = false;
+    }
+    stats.masks += !!(table->actives & ADPF_STRENGTH_MASK) + !!(table->actives & ADPF_DENOISE_SHARP_LEVEL_MASK);
+
+    ++stats.gains;
+    if (!ok)
+        ++stats.failed;
+    return ok;
+}
+
+static bool
+lut_test_resolution (const XMLElement *element, uint16_t &width, uint16_t &height)
+{
+    for (; element; element = element->NextSiblingElement ()) {
+        if (!strcmp (element->Name (), "resolution")) {
+            const XMLElement *cell = element->FirstChildElement ("cell");
+            const XMLElement *w = cell ? cell->FirstChildElement ("width") : NULL;
+            const XMLElement *h = cell ? cell->FirstChildElement ("height") : NULL;
+            const char *wt = w ? w->GetText () : NULL;
+            const char *ht = h ? h->GetText () : NULL;
+            if (!wt || !ht || !strchr (wt, '[') || !strchr (ht, '['))
+                return false;
+            width = atoi (strchr (wt, '[') + 1);
+            height = atoi (strchr (ht, '[') + 1);
+            return true;
+        }
+        if (lut_test_resolution (element->FirstChildElement (), width, height))
+            return true;
+    }
+    return false;
+}
+
+static AdpfContext_t *
+lut_test_create (CamCalibDbHandle_t db, uint16_t width, uint16_t height)
+{
+    AdpfHandle_t handle = NULL;
+    AdpfConfig_t config;
+
+    memset (&config, 0, sizeof (config));
+    config.data.db.width = width;
+    config.data.db.height = height;
+    config.data.db.hCamCalibDb = db;
+    if (AdpfInit (&handle, &config) != RET_SUCCESS || !handle)
+        return NULL;
+    if (((AdpfContext_t *)handle)->hCamCalibDb != db) {
+        AdpfRelease (handle);
+        return NULL;
+    }
+    return (AdpfContext_t *)handle;
+}
+
+static bool
+lut_test_file (const char *path)
+{
+    XMLDocument doc;
+    CalibDb db;
+    uint16_t width = 0, height = 0;
+    LutTestStats stats = {0, 0, 0};
+    uint32_t tables = 0;
+
+    if (doc.LoadFile (path) != XML_SUCCESS || !lut_test_resolution (doc.RootElement (), width, height)) {
+        printf ("%s: no resolution\n", path);
+        return false;
+    }
+    if (!db.CreateCalibDb (path)) {
+        printf ("%s: parse failed\n", path);
+        return false;
+    }
+
+    AdpfContext_t *table = lut_test_create (db.GetCalibDbHandle (), width, height);
+    AdpfContext_t *curves = lut_test_create (db.GetCalibDbHandle (), width, height);
+    if (!table || !curves) {
+        printf ("%s: adpf configure failed\n", path);
+        if (table)
+            AdpfRelease ((AdpfHandle_t)table);
+        if (curves)
+            AdpfRelease ((AdpfHandle_t)curves);
+        return false;
+    }
+    for (int32_t i = LIGHT_MODE_DAY; i < LIGHT_MODE_MAX; i++)
+        curves->Lut[i].valid = BOOL_FALSE;
+
+    for (int32_t i = LIGHT_MODE_DAY; i < LIGHT_MODE_MAX; i++) {
+        enum LIGHT_MODE mode = (enum LIGHT_MODE)i;
+        const AdpfLut_t &lut = table->Lut[mode];
+
+        if (lut.valid != BOOL_TRUE)
+            continue;
+        ++tables;
+        // up, down, then a repeated gain which must not raise anything
+        for (int32_t step = 0; step <= 2 * LUT_TEST_STEPS; step++) {
+            int32_t pos = step <= LUT_TEST_STEPS ? step : 2 * LUT_TEST_STEPS - step;
+            float gain = 1.0f + (lut.fGainMax - 1.0f) * pos / LUT_TEST_STEPS;
+            lut_test_gain (table, curves, gain, mode, stats);
+        }
+        lut_test_gain (table, curves, 1.0f, mode, stats);
+    }
+
+    printf ("%-40s %u tables %6u gains %6u masks raised %u failures\n",
+            path, tables, stats.gains, stats.masks, stats.failed);
+    AdpfRelease ((AdpfHandle_t)table);
+    AdpfRelease ((AdpfHandle_t)curves);
+    return stats.failed == 0;
+}
+
+int main (int argc, char *argv[])
+{
+    bool ok = argc > 1;
+
+    if (argc < 2)
+        printf ("Usage: %s iq.xml...\n", argv[0]);
+    for (int i = 1; i < argc; i++)
+        ok &= lut_test_file (argv[i]);
+
+    printf ("adpf lut test %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : -1;
+}
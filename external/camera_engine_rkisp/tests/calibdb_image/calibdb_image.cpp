@@ -0,0 +1,193 @@
+/*
+ * calibdb_image.cpp - write and benchmark calibration database images
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Writes the <iq>.xml.bin image next to every given iq file, the way the
+ * first start does, so the images can be generated at install time for a
+ * read-only iq directory. An image which already matches its file is kept.
+ * Every image is loaded back once to check it.
+ *
+ * With -b it then compares the startup cost of each file: parsing the xml
+ * into a database on the heap as before the images, against
+ * CalibDb::CreateCalibDb loading the image.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include <string>
+
+#include <calib_xml/calibdb.h>
+#include "calibdb_cache.h"
+
+#define BENCH_RUNS      10
+
+static int64_t
+image_now_ns ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// true if the image of @path matches the file and this build
+static bool
+image_loads (const char *path, const std::string &image_path)
+{
+    CalibDbSource source;
+    CamCalibDbHandle_t handle = NULL;
+    CalibDbImage image;
+
+    if (!CalibDbImage::ReadSource (path, &source))
+        return false;
+    bool loaded = image.Load (image_path.c_str (), &source, &handle);
+    CalibDbImage::ReleaseSource (&source);
+    return loaded && handle;
+}
+
+static bool
+image_generate (const char *path)
+{
+    std::string image_path = std::string (path) + CALIBDB_CACHE_SUFFIX;
+    struct stat st;
+
+    if (image_loads (path, image_path)) {
+        printf ("%s: up to date\n", image_path.c_str ());
+        return true;
+    }
+
+    // a stale image is replaced by the parse
+    CalibDb db;
+    if (!db.CreateCalibDb (path)) {
+        printf ("%s: parse failed\n", path);
+        return false;
+    }
+    if (!image_loads (path, image_path) || stat (image_path.c_str (), &st) != 0) {
+        printf ("%s: image not written\n", image_path.c_str ());
+        return false;
+    }
+
+    printf ("%s: written, %ld bytes\n", image_path.c_str (), (long)st.st_size);
+    return true;
+}
+
+static bool
+image_bench (const char *path, uint32_t runs, double &xml_ms, double &image_ms)
+{
+    int64_t xml_ns = 0, image_ns = 0;
+
+    for (uint32_t i = 0; i < runs; i++) {
+        XMLDocument *doc = new XMLDocument;
+        CalibDb *db = new CalibDb;
+
+        int64_t start = image_now_ns ();
+        bool res = (doc->LoadFile (path) == XML_SUCCESS)
+                   && db->CreateCalibDb (doc->RootElement ());
+        xml_ns += image_now_ns () - start;
+
+        delete db;
+        delete doc;
+        if (!res) {
+            printf ("%s: parse failed\n", path);
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < runs; i++) {
+        CalibDb *db = new CalibDb;
+
+        int64_t start = image_now_ns ();
+        bool res = db->CreateCalibDb (path);
+        image_ns += image_now_ns () - start;
+
+        delete db;
+        if (!res) {
+            printf ("%s: load failed\n", path);
+            return false;
+        }
+    }
+
+    xml_ms = xml_ns / 1e6 / runs;
+    image_ms = image_ns / 1e6 / runs;
+    return true;
+}
+
+static void
+print_help (const char *bin_name)
+{
+    printf ("Usage: %s [-b] [-n runs] iq.xml...\n"
+            "\t -b           also compare the startup from xml and from image\n"
+            "\t -n runs      startups per file and way, default %d\n"
+            "\t -h           help\n",
+            bin_name, BENCH_RUNS);
+}
+
+int main (int argc, char *argv[])
+{
+    uint32_t runs = BENCH_RUNS;
+    bool bench = false;
+    bool ok = true;
+    int opt;
+
+    while ((opt = getopt (argc, argv, "bn:h")) != -1) {
+        switch (opt) {
+        case 'b':
+            bench = true;
+            break;
+        case 'n':
+            runs = strtoul (optarg, NULL, 0);
+            break;
+        default:
+            print_help (argv[0]);
+            return opt == 'h' ? 0 : -1;
+        }
+    }
+    if (optind >= argc || !runs) {
+        print_help (argv[0]);
+        return -1;
+    }
+
+    for (int i = optind; i < argc; i++)
+        ok &= image_generate (argv[i]);
+
+    if (bench && ok) {
+        double xml_total = 0.0, image_total = 0.0;
+
+        printf ("%-40s %10s %10s\n", "startup per file", "xml", "image");
+        for (int i = optind; i < argc; i++) {
+            double xml_ms = 0.0, image_ms = 0.0;
+            if (!image_bench (argv[i], runs, xml_ms, image_ms)) {
+                ok = false;
+                continue;
+            }
+            printf ("%-40s %8.2fms %8.2fms %6.1fx\n", argv[i], xml_ms, image_ms, xml_ms / image_ms);
+            xml_total += xml_ms;
+            image_total += image_ms;
+        }
+        printf ("%-40s %8.2fms %8.2fms %6.1fx\n", "all", xml_total, image_total,
+                image_total > 0.0 ? xml_total / image_total : 0.0);
+    }
+
+    printf ("calibdb image %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,626 @@
+/*
+ * calibdb_index_test.cpp - indexed calibration database getters against the list walks
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Loads each given iq file and checks every ByName, ByResolution,
+ * ByWidthHeight, ByIdx and NoOf getter of the CamCalibDb lists against the
+ * list walk the getters did before the index: ListSearch comparing the
+ * field like strncmp over its size, ListGetItemByIdx and ListNoItems.
+ *
+ * The keys are the name and resolution of every item, each of them with
+ * its last character changed, the empty name and one no item has, all
+ * with junk after the terminator. The indexes are every item, the one
+ * after the last and UINT32_MAX.
+ *
+ * The getters of each file run with the index CalibDb built, after
+ * CamCalibDbReleaseIndex when the getters walk the lists, and after
+ * CamCalibDbBuildIndex indexed them again. Then a BLS and a CAC profile
+ * are added with the resolution of one already there, which drops the
+ * index, and the getters run without it and on the index built again.
+ * Every result must be the item the list walk finds.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <functional>
+
+#include <calib_xml/calibdb.h>
+#include "cam_calibdb.h"
+
+#define INDEX_TEST_UNKNOWN      "calibdb-index-test-unknown"
+#define INDEX_TEST_KEY_SIZE     256
+#define INDEX_TEST_FILL         0xa5
+
+typedef std::function<void * (const char *key)> IndexTestByKey;
+typedef std::function<void * (uint32_t idx)> IndexTestByIdx;
+typedef std::function<int32_t ()> IndexTestNoOf;
+
+struct IndexTestStats {
+    uint32_t lists;
+    uint32_t lookups;
+    uint32_t failed;
+};
+
+static bool
+index_test_report (IndexTestStats &stats, const char *what, const char *lookup, const void *got, const void *expected)
+{
+    if (stats.failed++ < 20)
+        printf ("%s %s: %p, expected %p\n", what, lookup, got, expected);
+    return false;
+}
+
+// the list walk of the getters before the index
+static void *
+index_test_walk (List *l, size_t offset, size_t size, const char *key)
+{
+    for (List *item = ListHead (l); item != NULL; item = item->p_next) {
+        if (!strncmp ((const char *)item + offset, key, size))
+            return item;
+    }
+    return NULL;
+}
+
+// @key is passed with junk after its terminator, the bytes of a field after it never count
+static bool
+index_test_key (IndexTestStats &stats, const char *what, List *l, size_t offset, size_t size,
+                const IndexTestByKey &by_key, const char *name)
+{
+    char key[INDEX_TEST_KEY_SIZE];
+    size_t len = strnlen (name, size);
+
+    memset (key, INDEX_TEST_FILL, sizeof (key));
+    memcpy (key, name, len);
+    if (len < size)
+        key[len] = '\0';
+
+    void *expected = index_test_walk (l, offset, size, key);
+    void *got = by_key (key);
+
+    ++stats.lookups;
+    if (got != expected) {
+        char lookup[128];
+        snprintf (lookup, sizeof (lookup), "by \"%.*s\"", (int)size, key);
+        return index_test_report (stats, what, lookup, got, expected);
+    }
+    return true;
+}
+
+/*
+ * Looks up the char array at @offset of every item of @l with @by_key, and
+ * every item with @by_idx and @no_of if given.
+ */
+static bool
+index_test_list (IndexTestStats &stats, const char *what, List *l, size_t offset, size_t size,
+                 const IndexTestByKey &by_key, const IndexTestByIdx &by_idx, const IndexTestNoOf &no_of)
+{
+    int32_t count = ListNoItems (l);
+    char key[INDEX_TEST_KEY_SIZE];
+    bool ok = true;
+
+    ++stats.lists;
+    if (size >= sizeof (key)) {
+        printf ("%s: key of %u bytes\n", what, (uint32_t)size);
+        return false;
+    }
+
+    if (by_key) {
+        for (List *item = ListHead (l); item != NULL; item = item->p_next) {
+            memcpy (key, (const char *)item + offset, size);
+            key[size] = '\0';
+            ok &= index_test_key (stats, what, l, offset, size, by_key, key);
+
+            size_t len = strlen (key);
+            if (len) {
+                key[len - 1] ^= 0x01;
+                ok &= index_test_key (stats, what, l, offset, size, by_key, key);
+            }
+        }
+        ok &= index_test_key (stats, what, l, offset, size, by_key, "");
+        ok &= index_test_key (stats, what, l, offset, size, by_key, INDEX_TEST_UNKNOWN);
+    }
+
+    if (no_of) {
+        int32_t no = no_of ();
+        ++stats.lookups;
+        if (no != count) {
+            if (stats.failed++ < 20)
+                printf ("%s count: %d, expected %d\n", what, no, count);
+            ok = false;
+        }
+    }
+
+    if (by_idx) {
+        for (int64_t idx = 0; idx <= count + 1; idx++) {
+            uint32_t i = (idx == count + 1) ? UINT32_MAX : (uint32_t)idx;
+            void *expected = ListGetItemByIdx (l, (int)i);
+            void *got = by_idx (i);
+            ++stats.lookups;
+            if (got != expected) {
+                char lookup[32];
+                snprintf (lookup, sizeof (lookup), "by index %u", i);
+                ok = index_test_report (stats, what, lookup, got, expected);
+            }
+        }
+    }
+    return ok;
+}
+
+#define INDEX_TEST_FIELD(type, field) offsetof (type, field), sizeof (((type *)0)->field)
+
+static bool
+index_test_resolutions (IndexTestStats &stats, CamCalibDbHandle_t handle, CamCalibDbContext_t *ctx)
+{
+    List *l = &ctx->resolution;
+    bool ok = true;
+
+    ++stats.lists;
+    for (List *item = ListHead (l); item != NULL; item = item->p_next) {
+        const CamResolution_t *res = (const CamResolution_t *)item;
+        const uint16_t sizes[][2] = {
+            { res->width, res->height }, { (uint16_t)(res->width + 1), res->height },
+            { res->width, (uint16_t)(res->height - 1) },
+        };
+
+        for (uint32_t i = 0; i < sizeof (sizes) / sizeof (sizes[0]); i++) {
+            CamResolution_t *got = NULL;
+            void *expected = NULL;
+
+            for (List *walk = ListHead (l); walk != NULL && !expected; walk = walk->p_next) {
+                const CamResolution_t *r = (const CamResolution_t *)walk;
+                if (r->width == sizes[i][0] && r->height == sizes[i][1])
+                    expected = walk;
+            }
+            if (CamCalibDbGetResolutionByWidthHeight (handle, sizes[i][0], sizes[i][1], &got) != RET_SUCCESS)
+                got = NULL;
+            ++stats.lookups;
+            if ((void *)got != expected) {
+                char lookup[32];
+                snprintf (lookup, sizeof (lookup), "by %ux%u", sizes[i][0], sizes[i][1]);
+                ok = index_test_report (stats, "resolution", lookup, got, expected);
+            }
+        }
+    }
+
+    int32_t no = 0;
+    CamCalibDbGetNoOfResolutions (handle, &no);
+    ++stats.lookups;
+    if (no != ListNoItems (l)) {
+        if (stats.failed++ < 20)
+            printf ("resolution count: %d, expected %d\n", no, ListNoItems (l));
+        ok = false;
+    }
+    return ok;
+}
+
+static bool
+index_test_getters (IndexTestStats &stats, CamCalibDbHandle_t handle)
+{
+    CamCalibDbContext_t *ctx = (CamCalibDbContext_t *)handle;
+    bool ok = index_test_resolutions (stats, handle, ctx);
+
+    if (ctx->pAwbProfile) {
+        CamCalibAwbPara_t *awb = ctx->pAwbProfile;
+
+        ok &= index_test_list (
+                  stats, "awb v11 global", &awb->Para_V11.awb_global,
+                  INDEX_TEST_FIELD (CamCalibAwb_V11_Global_t, resolution),
+        [&] (const char * key) {
+            CamCalibAwb_V11_Global_t *p = NULL;
+            CamCalibDbGetAwb_V11_GlobalByResolution (handle, key, &p);
+            return (void *)p;
+        }, NULL, NULL);
+        ok &= index_test_list (
+                  stats, "awb v10 global", &awb->Para_V10.awb_global,
+                  INDEX_TEST_FIELD (CamCalibAwb_V10_Global_t, resolution),
+        [&] (const char * key) {
+            CamCalibAwb_V10_Global_t *p = NULL;
+            CamCalibDbGetAwb_V10_GlobalByResolution (handle, key, &p);
+            return (void *)p;
+        }, NULL, NULL);
+        ok &= index_test_list (
+                  stats, "awb v11 illumination", &awb->Para_V11.illumination,
+                  INDEX_TEST_FIELD (CamAwb_V11_IlluProfile_t, name),
+        [&] (const char * key) {
+            CamAwb_V11_IlluProfile_t *p = NULL;
+            CamCalibDbGetAwb_V11_IlluminationByName (handle, (char *)key, &p);
+            return (void *)p;
+        },
+        [&] (uint32_t idx) {
+            CamAwb_V11_IlluProfile_t *p = NULL;
+            CamCalibDbGetAwb_V11_IlluminationByIdx (handle, idx, &p);
+            return (void *)p;
+        },
+        [&] () {
+            int32_t no = -1;
+            CamCalibDbGetNoOfAwb_V11_Illuminations (handle, &no);
+            return no;
+        });
+        ok &= index_test_list (
+                  stats, "awb v10 illumination", &awb->Para_V10.illumination,
+                  INDEX_TEST_FIELD (CamAwb_V10_IlluProfile_t, name),
+        [&] (const char * key) {
+            CamAwb_V10_IlluProfile_t *p = NULL;
+            CamCalibDbGetAwb_V10_IlluminationByName (handle, (char *)key, &p);
+            return (void *)p;
+        },
+        [&] (uint32_t idx) {
+            CamAwb_V10_IlluProfile_t *p = NULL;
+            CamCalibDbGetAwb_V10_IlluminationByIdx (handle, idx, &p);
+            return (void *)p;
+        },
+        [&] () {
+            int32_t no = -1;
+            CamCalibDbGetNoOfAwb_V10_Illuminations (handle, &no);
+            return no;
+        });
+    }
+
+    ok &= index_test_list (
+              stats, "ecm profile", &ctx->ecm_profile, INDEX_TEST_FIELD (CamEcmProfile_t, name),
+    [&] (const char * key) {
+        CamEcmProfile_t *p = NULL;
+        CamCalibDbGetEcmProfileByName (handle, (char *)key, &p);
+        return (void *)p;
+    },
+    [&] (uint32_t idx) {
+        CamEcmProfile_t *p = NULL;
+        CamCalibDbGetEcmProfileByIdx (handle, idx, &p);
+        return (void *)p;
+    },
+    [&] () {
+        int32_t no = -1;
+        CamCalibDbGetNoOfEcmProfiles (handle, &no);
+        return no;
+    });
+    for (List *item = ListHead (&ctx->ecm_profile); item != NULL; item = item->p_next) {
+        CamEcmProfile_t *ecm = (CamEcmProfile_t *)item;
+        ok &= index_test_list (
+                  stats, "ecm scheme", &ecm->ecm_scheme, INDEX_TEST_FIELD (CamEcmScheme_t, name),
+        [&] (const char * key) {
+            CamEcmScheme_t *p = NULL;
+            CamCalibDbGetEcmSchemeByName (handle, ecm, (char *)key, &p);
+            return (void *)p;
+        },
+        [&] (uint32_t idx) {
+            CamEcmScheme_t *p = NULL;
+            CamCalibDbGetEcmSchemeByIdx (handle, ecm, idx, &p);
+            return (void *)p;
+        },
+        [&] () {
+            int32_t no = -1;
+            CamCalibDbGetNoOfEcmSchemes (handle, ecm, &no);
+            return no;
+        });
+    }
+
+    if (ctx->pAecGlobal) {
+        CamCalibAecGlobal_t *aec = ctx->pAecGlobal;
+
+        ok &= index_test_list (
+                  stats, "aec dynamic setpoint", &aec->DySetpointList,
+                  INDEX_TEST_FIELD (CamCalibAecDynamicSetpoint_t, name),
+        [&] (const char * key) {
+            CamCalibAecDynamicSetpoint_t *p = NULL;
+            CamCalibDbGetDySetpointByName (handle, aec, (char *)key, &p);
+            return (void *)p;
+        },
+        [&] (uint32_t idx) {
+            CamCalibAecDynamicSetpoint_t *p = NULL;
+            CamCalibDbGetDySetpointByIdx (handle, aec, idx, &p);
+            return (void *)p;
+        },
+        [&] () {
+            int32_t no = -1;
+            CamCalibDbGetNoOfDySetpoint (handle, aec, &no);
+            return no;
+        });
+        ok &= index_test_list (
+                  stats, "aec exposure separate", &aec->ExpSeparateList,
+                  INDEX_TEST_FIELD (CamCalibAecExpSeparate_t, name),
+        [&] (const char * key) {
+            CamCalibAecExpSeparate_t *p = NULL;
+            CamCalibDbGetExpSeparateByName (handle, aec, (char *)key, &p);
+            return (void *)p;
+        },
+        [&] (uint32_t idx) {
+            CamCalibAecExpSeparate_t *p = NULL;
+            CamCalibDbGetExpSeparateByIdx (handle, aec, idx, &p);
+            return (void *)p;
+        },
+        [&] () {
+            int32_t no = -1;
+            CamCalibDbGetNoOfExpSeparate (handle, aec, &no);
+            return no;
+        });
+    }
+
+    ok &= index_test_list (
+              stats, "goc profile", &ctx->gocProfile, INDEX_TEST_FIELD (CamCalibGocProfile_t, name),
+    [&] (const char * key) {
+        CamCalibGocProfile_t *p = NULL;
+        CamCalibDbGetGocProfileByName (handle, (char *)key, &p);
+        return (void *)p;
+    },
+    [&] (uint32_t idx) {
+        CamCalibGocProfile_t *p = NULL;
+        CamCalibDbGetGocProfileByIdx (handle, idx, &p);
+        return (void *)p;
+    },
+    [&] () {
+        int32_t no = -1;
+        CamCalibDbGetNoOfGocProfile (handle, &no);
+        return no;
+    });
+
+    ok &= index_test_list (
+              stats, "lsc profile", &ctx->lsc_profile, INDEX_TEST_FIELD (CamLscProfile_t, name),
+    [&] (const char * key) {
+        CamLscProfile_t *p = NULL;
+        CamCalibDbGetLscProfileByName (handle, (char *)key, &p);
+        return (void *)p;
+    },
+    [&] (uint32_t idx) {
+        CamLscProfile_t *p = NULL;
+        CamCalibDbGetLscProfileByIdx (handle, idx, &p);
+        return (void *)p;
+    }, NULL);
+
+    ok &= index_test_list (
+              stats, "cc profile", &ctx->cc_profile, INDEX_TEST_FIELD (CamCcProfile_t, name),
+    [&] (const char * key) {
+        CamCcProfile_t *p = NULL;
+        CamCalibDbGetCcProfileByName (handle, (char *)key, &p);
+        return (void *)p;
+    }, NULL, NULL);
+
+    ok &= index_test_list (
+              stats, "bls profile", &ctx->bls_profile, INDEX_TEST_FIELD (CamBlsProfile_t, name),
+    [&] (const char * key) {
+        CamBlsProfile_t *p = NULL;
+        CamCalibDbGetBlsProfileByName (handle, (char *)key, &p);
+        return (void *)p;
+    }, NULL, NULL);
+    ok &= index_test_list (
+              stats, "bls resolution", &ctx->bls_profile, INDEX_TEST_FIELD (CamBlsProfile_t, resolution),
+    [&] (const char * key) {
+        CamBlsProfile_t *p = NULL;
+        CamCalibDbGetBlsProfileByResolution (handle, key, &p);
+        return (void *)p;
+    }, NULL, NULL);
+
+    ok &= index_test_list (
+              stats, "cac profile", &ctx->cac_profile, INDEX_TEST_FIELD (CamCacProfile_t, name),
+    [&] (const char * key) {
+        CamCacProfile_t *p = NULL;
+        CamCalibDbGetCacProfileByName (handle, (char *)key, &p);
+        return (void *)p;
+    }, NULL, NULL);
+    ok &= index_test_list (
+              stats, "cac resolution", &ctx->cac_profile, INDEX_TEST_FIELD (CamCacProfile_t, resolution),
+    [&] (const char * key) {
+        CamCacProfile_t *p = NULL;
+        CamCalibDbGetCacProfileByResolution (handle, key, &p);
+        return (void *)p;
+    }, NULL, NULL);
+
+    ok &= index_test_list (
+              stats, "dpf profile", &ctx->dpf_profile, INDEX_TEST_FIELD (CamDpfProfile_t, name),
+    [&] (const char * key) {
+        CamDpfProfile_t *p = NULL;
+        CamCalibDbGetDpfProfileByName (handle, (char *)key, &p);
+        return (void *)p;
+    }, NULL, NULL);
+    ok &= index_test_list (
+              stats, "dpf resolution", &ctx->dpf_profile, INDEX_TEST_FIELD (CamDpfProfile_t, resolution),
+    [&] (const char * key) {
+        CamDpfProfile_t *p = NULL;
+        CamCalibDbGetDpfProfileByResolution (handle, key, &p);
+        return (void *)p;
+    }, NULL, NULL);
+    for (List *item = ListHead (&ctx->dpf_profile); item != NULL; item = item->p_next) {
+        CamDpfProfile_t *dpf = (CamDpfProfile_t *)item;
+
+        ok &= index_test_list (
+                  stats, "dpf filter", &dpf->FilterList, INDEX_TEST_FIELD (CamFilterProfile_t, name),
+        [&] (const char * key) {
+            CamFilterProfile_t *p = NULL;
+            CamCalibDbGetFilterProfileByName (handle, dpf, (char *)key, &p);
+            return (void *)p;
+        },
+        [&] (uint32_t idx) {
+            CamFilterProfile_t *p = NULL;
+            CamCalibDbGetFilterProfileByIdx (handle, dpf, idx, &p);
+            return (void *)p;
+        },
+        [&] () {
+            int32_t no = -1;
+            CamCalibDbGetNoOfFilterProfile (handle, dpf, &no);
+            return no;
+        });
+        ok &= index_test_list (
+                  stats, "dpf 3dnr", &dpf->Dsp3DNRSettingProfileList,
+                  INDEX_TEST_FIELD (CamDsp3DNRSettingProfile_t, name),
+        [&] (const char * key) {
+            CamDsp3DNRSettingProfile_t *p = NULL;
+            CamCalibDbGetDsp3DNRSettingByName (handle, dpf, (char *)key, &p);
+            return (void *)p;
+        },
+        [&] (uint32_t idx) {
+            CamDsp3DNRSettingProfile_t *p = NULL;
+            CamCalibDbGetDsp3DNRByIdx (handle, dpf, idx, &p);
+            return (void *)p;
+        },
+        [&] () {
+            int32_t no = -1;
+            CamCalibDbGetNoOfDsp3DNRSetting (handle, dpf, &no);
+            return no;
+        });
+        ok &= index_test_list (
+                  stats, "dpf new 3dnr", &dpf->newDsp3DNRProfileList,
+                  INDEX_TEST_FIELD (CamNewDsp3DNRProfile_t, name),
+        [&] (const char * key) {
+            CamNewDsp3DNRProfile_t *p = NULL;
+            CamCalibDbGetNewDsp3DNRSettingByName (handle, dpf, (char *)key, &p);
+            return (void *)p;
+        },
+        [&] (uint32_t idx) {
+            CamNewDsp3DNRProfile_t *p = NULL;
+            CamCalibDbGetNewDsp3DNRByIdx (handle, dpf, idx, &p);
+            return (void *)p;
+        },
+        [&] () {
+            int32_t no = -1;
+            CamCalibDbGetNoOfNewDsp3DNRSetting (handle, dpf, &no);
+            return no;
+        });
+    }
+
+    // the by name getter is declared as CamCalibDbGetDpccProfileByName but
+    // defined as CamCalibDbGetDpccfProfileByName, no caller can link it
+    ok &= index_test_list (
+              stats, "dpcc resolution", &ctx->dpcc_profile, INDEX_TEST_FIELD (CamDpccProfile_t, resolution),
+    [&] (const char * key) {
+        CamDpccProfile_t *p = NULL;
+        CamCalibDbGetDpccProfileByResolution (handle, key, &p);
+        return (void *)p;
+    }, NULL, NULL);
+
+    ok &= index_test_list (
+              stats, "iesharpen profile", &ctx->iesharpen_profile, INDEX_TEST_FIELD (CamIesharpenProfile_t, name),
+    [&] (const char * key) {
+        CamIesharpenProfile_t *p = NULL;
+        CamCalibDbGetRKsharpenProfileByName (handle, (char *)key, &p);
+        return (void *)p;
+    }, NULL, NULL);
+    ok &= index_test_list (
+              stats, "iesharpen resolution", &ctx->iesharpen_profile,
+              INDEX_TEST_FIELD (CamIesharpenProfile_t, resolution),
+    [&] (const char * key) {
+        CamIesharpenProfile_t *p = NULL;
+        CamCalibDbGetRKsharpenProfileByResolution (handle, key, &p);
+        return (void *)p;
+    }, NULL, NULL);
+
+    return ok;
+}
+
+static bool
+index_test_pass (CamCalibDbHandle_t handle, const char *path, const char *mode, bool indexed)
+{
+    CamCalibDbContext_t *ctx = (CamCalibDbContext_t *)handle;
+    IndexTestStats stats = {0, 0, 0};
+
+    if ((ctx->pIndex != NULL) != indexed) {
+        printf ("%s %s: index %s\n", path, mode, indexed ? "missing" : "not released");
+        return false;
+    }
+
+    bool ok = index_test_getters (stats, handle);
+    printf ("%-40s %-8s %4u lists %6u lookups %u failures\n", path, mode,
+            stats.lists, stats.lookups, stats.failed);
+    return ok && stats.lookups > 0;
+}
+
+/*
+ * Adds a copy of the first BLS and CAC profile under another name, the
+ * resolution key of each is then in its list twice and the first one
+ * must be found. Adding drops the index.
+ */
+static bool
+index_test_duplicates (CamCalibDbHandle_t handle, const char *path, uint32_t &added)
+{
+    CamCalibDbContext_t *ctx = (CamCalibDbContext_t *)handle;
+    bool ok = true;
+
+    added = 0;
+    if (ListHead (&ctx->bls_profile)) {
+        CamBlsProfile_t bls = *(CamBlsProfile_t *)ListHead (&ctx->bls_profile);
+        bls.name[0] ^= 0x01;
+        ok &= CamCalibDbAddBlsProfile (handle, &bls) == RET_SUCCESS;
+        ++added;
+    }
+    if (ListHead (&ctx->cac_profile)) {
+        CamCacProfile_t cac = *(CamCacProfile_t *)ListHead (&ctx->cac_profile);
+        cac.name[0] ^= 0x01;
+        ok &= CamCalibDbAddCacProfile (handle, &cac) == RET_SUCCESS;
+        ++added;
+    }
+
+    if (!ok || (added && ctx->pIndex != NULL)) {
+        printf ("%s: adding duplicates %s\n", path, ok ? "kept the index" : "failed");
+        return false;
+    }
+    return true;
+}
+
+static bool
+index_test_file (const char *path)
+{
+    CalibDb db;
+    bool ok = true;
+
+    if (!db.CreateCalibDb (path)) {
+        printf ("%s: load failed\n", path);
+        return false;
+    }
+
+    CamCalibDbHandle_t handle = db.GetCalibDbHandle ();
+    ok &= index_test_pass (handle, path, "index", true);
+
+    CamCalibDbReleaseIndex (handle);
+    ok &= index_test_pass (handle, path, "walk", false);
+
+    if (CamCalibDbBuildIndex (handle) != RET_SUCCESS) {
+        printf ("%s: index rebuild failed\n", path);
+        return false;
+    }
+    ok &= index_test_pass (handle, path, "rebuilt", true);
+
+    uint32_t added = 0;
+    if (!index_test_duplicates (handle, path, added))
+        return false;
+    if (added) {
+        ok &= index_test_pass (handle, path, "added", false);
+        if (CamCalibDbBuildIndex (handle) != RET_SUCCESS) {
+            printf ("%s: index rebuild failed\n", path);
+            return false;
+        }
+        ok &= index_test_pass (handle, path, "dups", true);
+    }
+    return ok;
+}
+
+int main (int argc, char *argv[])
+{
+    bool ok = true;
+
+    if (argc < 2) {
+        printf ("Usage: %s iq.xml...\n", argv[0]);
+        return -1;
+    }
+
+    for (int i = 1; i < argc; i++)
+        ok &= index_test_file (argv[i]);
+
+    printf ("calibdb index test %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : -1;
+}
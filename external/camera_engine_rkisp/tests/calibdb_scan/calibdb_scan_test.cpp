@@ -0,0 +1,349 @@
+/*
+ * calibdb_scan_test.cpp - calibration number scanners against the sscanf parsers
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Golden test of ParseNumberArray in calibdb_scan.h. The array parsers it
+ * replaced are kept below as LegacyParseArray, one sscanf call per element.
+ * Both run on the same strings for all seven element types of the parser
+ * (float, uint32, uint8, int8, uint16, int16 and the bytes scanned as
+ * uint16), with an element count large enough for the whole array and one
+ * which cuts it short. The return value and every byte of the output,
+ * starting from the same filled buffer, must be identical.
+ *
+ * The strings are
+ *   - the text of every element of each given iq xml which holds an array
+ *   - hand picked edge cases: float halfway values, values around FLT_MIN
+ *     and FLT_MAX, 10 digit integers, hex, inf/nan and broken numbers
+ *   - generated decimals with 1 to 20 digits over the whole float range,
+ *     integers which are exactly halfway between two floats and integers
+ *     of 1 to 12 digits
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <float.h>
+
+#include <fstream>
+#include <string>
+
+#include <tinyxml2.h>
+#include "calibdb_scan.h"
+
+#define SCAN_TEST_MAX_VALUES    8192
+#define SCAN_TEST_SHORT_COUNT   3
+// enough for every generated array
+#define SCAN_TEST_VALUE_COUNT   256
+#define SCAN_TEST_GENERATED     200000
+#define SCAN_TEST_FILL          0xa5
+
+static std::ofstream scan_test_log ("/dev/null");
+
+/*
+ * ParseFloatArray, ParseUintArray, ParseUcharArray, ParseCharArray,
+ * ParseUshortArray, ParseShortArray and ParseByteArray of calibdb.cpp before
+ * the scanners, which only differed in the element type and the sscanf
+ * conversion. Kept as they were apart from the disabled code.
+ */
+template <typename T, typename S>
+static int
+LegacyParseArray (const char *c_string, T *values, const int num, const char *format)
+{
+    T* value = values;
+    char* str = (char*)c_string;
+    int last = strlen(str);
+    char* str_last = str + (last - 1);
+
+    std::string s_string(str);
+    size_t find_start = s_string.find("[", 0);
+    size_t find_end = s_string.find("]", 0);
+
+    if ((find_start == std::string::npos) || (find_end == std::string::npos)) {
+        return -1;
+    }
+
+    str = (char*)c_string + find_start;
+    str_last = (char*)c_string + find_end;
+
+    /* skipped left parenthesis */
+    str++;
+
+    /* skip spaces */
+    while (*str == 0x20 || *str == 0x09 || (*str == 0x0a) || (*str == 0x0d)) {
+        str++;
+    }
+
+    int cnt = 0;
+    int scanned;
+    S f;
+
+    /* parse the c-string */
+    while ((str != str_last) && (cnt < num)) {
+        scanned = sscanf(str, format, &f);
+        if (scanned != 1) {
+            goto err1;
+        } else {
+            value[cnt] = (T)f;
+            cnt++;
+        }
+
+        /* remove detected float */
+        while ((*str != 0x20)  && (*str != ',') && (*str != ']')) {
+            str++;
+        }
+
+        /* skip spaces and comma */
+        while ((*str == 0x20) || (*str == ',') || (*str == 0x09) || (*str == 0x0a) || (*str == 0x0d)) {
+            str++;
+        }
+    }
+
+    return (cnt);
+
+err1:
+    memset(values, 0, (sizeof(T) * num));
+
+    return (0);
+}
+
+struct ScanTestStats {
+    uint32_t strings;
+    uint32_t values;
+    uint32_t failed;
+};
+
+template <typename T, typename S>
+static bool
+scan_test_compare (const char *text, int num, const char *format, const char *type, ScanTestStats &stats)
+{
+    static uint8_t expected[SCAN_TEST_MAX_VALUES * sizeof (uint32_t)];
+    static uint8_t actual[SCAN_TEST_MAX_VALUES * sizeof (uint32_t)];
+    size_t size = num * sizeof (T);
+
+    memset (expected, SCAN_TEST_FILL, size);
+    memset (actual, SCAN_TEST_FILL, size);
+    int want = LegacyParseArray<T, S> (text, (T *)expected, num, format);
+    int got = ParseNumberArray<T, S> (text, (T *)actual, num, scan_test_log, __func__);
+
+    if (got > 0)
+        stats.values += got;
+    if (want == got && !memcmp (expected, actual, size))
+        return true;
+
+    if (stats.failed++ < 20) {
+        printf ("%s[%d] of \"%.80s\": returned %d, expected %d\n", type, num, text, got, want);
+        for (int i = 0; i < num; i++) {
+            if (memcmp (expected + i * sizeof (T), actual + i * sizeof (T), sizeof (T))) {
+                printf ("    first difference at element %d\n", i);
+                break;
+            }
+        }
+    }
+    return false;
+}
+
+static bool
+scan_test_string (const char *text, int num, ScanTestStats &stats)
+{
+    bool ok = true;
+
+    ok &= scan_test_compare<float, float> (text, num, "%f", "float", stats);
+    ok &= scan_test_compare<uint32_t, uint32_t> (text, num, "%u", "uint32", stats);
+    ok &= scan_test_compare<uint8_t, uint8_t> (text, num, "%hhu", "uint8", stats);
+    ok &= scan_test_compare<int8_t, int8_t> (text, num, "%hhd", "int8", stats);
+    ok &= scan_test_compare<uint16_t, uint16_t> (text, num, "%hu", "uint16", stats);
+    ok &= scan_test_compare<int16_t, int16_t> (text, num, "%hd", "int16", stats);
+    ok &= scan_test_compare<uint8_t, uint16_t> (text, num, "%hu", "byte", stats);
+    return ok;
+}
+
+static bool
+scan_test_array (const char *text, int num, ScanTestStats &stats)
+{
+    bool ok = true;
+
+    ++stats.strings;
+    ok &= scan_test_string (text, num, stats);
+    ok &= scan_test_string (text, SCAN_TEST_SHORT_COUNT, stats);
+    return ok;
+}
+
+static bool
+scan_test_value (const std::string &value, ScanTestStats &stats)
+{
+    std::string text = "[" + value + "]";
+    bool ok = scan_test_array (text.c_str (), SCAN_TEST_VALUE_COUNT, stats);
+
+    text = "[ 1 " + value + ", " + value + "\t2 ]";
+    ok &= scan_test_array (text.c_str (), SCAN_TEST_VALUE_COUNT, stats);
+    return ok;
+}
+
+static bool
+scan_test_element (const tinyxml2::XMLElement *element, ScanTestStats &stats)
+{
+    bool ok = true;
+
+    for (; element; element = element->NextSiblingElement ()) {
+        const char *text = element->GetText ();
+        if (text && strchr (text, '['))
+            ok &= scan_test_array (text, SCAN_TEST_MAX_VALUES, stats);
+        ok &= scan_test_element (element->FirstChildElement (), stats);
+    }
+    return ok;
+}
+
+static bool
+scan_test_file (const char *path)
+{
+    tinyxml2::XMLDocument doc;
+    ScanTestStats stats = {0, 0, 0};
+
+    if (doc.LoadFile (path) != tinyxml2::XML_SUCCESS) {
+        printf ("%s: load failed\n", path);
+        return false;
+    }
+    bool ok = scan_test_element (doc.RootElement (), stats);
+    printf ("%-40s %6u arrays %8u values %u failures\n", path, stats.strings, stats.values, stats.failed);
+    return ok && stats.strings > 0;
+}
+
+static const char *scan_test_edge_cases[] = {
+    // float halfway between two floats, and their neighbours
+    "16777217", "16777216", "16777218", "16777219", "33554434", "33554438",
+    "1.000000059604644775390625", "1.0000000596046447753906", "1.0000000596046447753907",
+    "1.00000005960464477539", "1.0000000596046448", "0.50000002980232238769531250",
+    "9007199254740993", "9007199254740992", "18014398509481985", "8589934593",
+    // around FLT_MIN, FLT_MAX and the double range
+    "1.17549435e-38", "1.1754942e-38", "1.17549435082228750797e-38", "1.1754943e-38",
+    "1.1754944e-38", "1.17549421e-38", "1.401298464324817e-45", "7e-46", "1e-39",
+    "3.40282347e38", "3.4028235e38", "3.40282357e38", "3.4028236e38", "1e39", "1e-22",
+    "1e22", "1e23", "1e-23", "123456789e-30", "-1.17549435e-38", "1e-400", "1e400",
+    // 10 digit integers and more
+    "4294967295", "4294967296", "2147483647", "-2147483648", "2147483648", "-2147483649",
+    "9999999999", "1000000000", "999999999", "-999999999", "0999999999", "18446744073709551615",
+    "18446744073709551616", "36893488147419103232", "1.8446744073709551616e-10",
+    "65535", "65536", "-32768", "-32769", "255", "256", "-128", "-129",
+    // other forms sscanf takes or refuses
+    "0x10", "0X1f", "0x1p3", "inf", "-inf", "INF", "nan", "NaN", "infinity", "1e", "1e+",
+    "1e-", "1ex", "1.5e3x", "1.5f", "12ab", ".5", "5.", ".", "-.5", "-0", "+0", "-0.0",
+    "+3", "-", "+", "--1", "+-1", "1-2", "1+2", "1.2.3", "1e5.5", "1e0005", "1e00001",
+    "000000000000000000000001", "0.00000000000000000000000000000001", "1_0", "1/2",
+    "00", "007", "-007", "1.e2", "1E2", "1e-0", "0e10", "abc", "\"1\"", "1;2",
+};
+
+#define SCAN_TEST_EDGE_COUNT (sizeof (scan_test_edge_cases) / sizeof (scan_test_edge_cases[0]))
+
+static uint64_t scan_test_seed = 0x2545f4914f6cdd1dULL;
+
+static uint64_t
+scan_test_random ()
+{
+    scan_test_seed ^= scan_test_seed << 13;
+    scan_test_seed ^= scan_test_seed >> 7;
+    scan_test_seed ^= scan_test_seed << 17;
+    return scan_test_seed;
+}
+
+static std::string
+scan_test_digits (uint32_t count)
+{
+    std::string digits;
+    for (uint32_t i = 0; i < count; i++)
+        digits += (char)('0' + scan_test_random () % 10);
+    return digits;
+}
+
+// a decimal of 1 to 20 digits with the point anywhere and an optional exponent
+static std::string
+scan_test_decimal ()
+{
+    std::string value = scan_test_digits (1 + scan_test_random () % 20);
+    char exponent[16];
+
+    if (scan_test_random () % 2)
+        value.insert (scan_test_random () % (value.size () + 1), ".");
+    if (scan_test_random () % 4)
+        value = (scan_test_random () % 2 ? "-" : "") + value;
+    if (scan_test_random () % 4) {
+        snprintf (exponent, sizeof (exponent), "e%d", (int)(scan_test_random () % 100) - 55);
+        value += exponent;
+    }
+    return value;
+}
+
+// an odd multiple of a power of two whose 25th bit is the lowest set one
+static std::string
+scan_test_halfway ()
+{
+    uint64_t mantissa = (1ULL << 24) | (scan_test_random () & 0xffffff) | 1;
+    uint32_t shift = scan_test_random () % 30;
+    char value[32];
+
+    snprintf (value, sizeof (value), "%llu", (unsigned long long)((mantissa << shift)
+              + (scan_test_random () % 4 == 0 ? 1 : 0)));
+    return value;
+}
+
+static std::string
+scan_test_integer ()
+{
+    std::string value = scan_test_digits (1 + scan_test_random () % 12);
+    if (scan_test_random () % 3 == 0)
+        value = (scan_test_random () % 2 ? "-" : "+") + value;
+    return value;
+}
+
+static bool
+scan_test_values ()
+{
+    ScanTestStats stats = {0, 0, 0};
+    std::string all = "[";
+    bool ok = true;
+
+    for (uint32_t i = 0; i < SCAN_TEST_EDGE_COUNT; i++) {
+        ok &= scan_test_value (scan_test_edge_cases[i], stats);
+        all += std::string (" ") + scan_test_edge_cases[i];
+    }
+    ok &= scan_test_array ((all + " ]").c_str (), SCAN_TEST_VALUE_COUNT, stats);
+
+    for (uint32_t i = 0; i < SCAN_TEST_GENERATED; i++) {
+        ok &= scan_test_value (scan_test_decimal (), stats);
+        if (i % 4 == 0) {
+            ok &= scan_test_value (scan_test_halfway (), stats);
+            ok &= scan_test_value (scan_test_integer (), stats);
+        }
+    }
+
+    printf ("%-40s %6u arrays %8u values %u failures\n", "edge cases and generated",
+            stats.strings, stats.values, stats.failed);
+    return ok;
+}
+
+int main (int argc, char *argv[])
+{
+    bool ok = scan_test_values ();
+
+    for (int i = 1; i < argc; i++)
+        ok &= scan_test_file (argv[i]);
+
+    printf ("calibdb scan test %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : -1;
+}
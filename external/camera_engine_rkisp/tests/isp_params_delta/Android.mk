@@ -0,0 +1,49 @@
+LOCAL_PATH:= $(call my-dir)
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES +=\
+	isp_params_delta_test.cpp
+
+LOCAL_CPPFLAGS += -std=c++11 -Wno-error
+LOCAL_CPPFLAGS += -DLINUX
+LOCAL_CPPFLAGS += $(PRJ_CPPFLAGS)
+
+LOCAL_C_INCLUDES := \
+	$(LOCAL_PATH) \
+	$(LOCAL_PATH)/../../interface \
+	$(LOCAL_PATH)/../../ \
+	$(LOCAL_PATH)/../../xcore \
+	$(LOCAL_PATH)/../../xcore/ia \
+	$(LOCAL_PATH)/../../xcore/base \
+	$(LOCAL_PATH)/../../ext/rkisp \
+	$(LOCAL_PATH)/../../plugins/3a/rkiq \
+	$(LOCAL_PATH)/../../modules/isp \
+	$(LOCAL_PATH)/../../rkisp/ia-engine \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/include \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/include/linux \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/include/linux/media \
+	$(LOCAL_PATH)/../../rkisp/isp-engine
+
+LOCAL_SHARED_LIBRARIES += libdl librkisp
+
+ifeq ($(IS_ANDROID_OS),true)
+LOCAL_32_BIT_ONLY := true
+LOCAL_SHARED_LIBRARIES += libutils libcutils liblog
+LOCAL_SHARED_LIBRARIES += \
+	libcamera_metadata
+LOCAL_C_INCLUDES += \
+    system/media/camera/include \
+    frameworks/av/include
+else
+LOCAL_C_INCLUDES += \
+	$(LOCAL_PATH)/../../metadata/libcamera_client/include \
+	$(LOCAL_PATH)/../../metadata/libcamera_metadata/include \
+	$(LOCAL_PATH)/../../metadata/header_files/include/system/core/include
+LOCAL_STATIC_LIBRARIES += \
+	librkisp_metadata
+endif
+
+LOCAL_MODULE:= isp_params_delta_test
+
+include $(BUILD_EXECUTABLE)
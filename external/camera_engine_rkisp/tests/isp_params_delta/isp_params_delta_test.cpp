@@ -0,0 +1,308 @@
+/*
+ * isp_params_delta_test.cpp - replay rkisp_parameters through the params delta
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Feeds a sequence of rkisp_parameters through rkisp1_convert_results and
+ * IspController::gen_full_isp_params the way set_3a_config does, including
+ * frames deferred because no params buffer was free. For every queued
+ * buffer it checks
+ *   - the cfg/en update masks are exactly the modules whose config (and
+ *     enable bit) changed in any frame since the previous queued buffer,
+ *     worked out by comparing the rkisp_parameters themselves
+ *   - a simulated driver which only applies the flagged modules ends up
+ *     with the config and enable bit of the latest frame for every module
+ *
+ * The sequence is either the params results of a 3a replay output
+ * (x3a_replay_bench -o) or a generated one.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include "isp_controller.h"
+#include "rkiq_params.h"
+#include "x3a_replay.h"
+
+using namespace XCam;
+
+#define DELTA_TEST_FRAMES          2000
+// one of that many frames finds every params buffer in flight
+#define DELTA_TEST_DEFER_PERIOD    3
+
+struct ParamsModule {
+    int         id;
+    const char *name;
+    size_t      aiq_offset;
+    size_t      isp_offset;
+    size_t      size;
+};
+
+#define PARAMS_MODULE(id, aiq, isp) \
+    { id, #aiq, offsetof (struct rkisp_parameters, aiq), \
+      offsetof (struct rkisp1_isp_params_cfg, isp), \
+      sizeof (((struct rkisp_parameters *)0)->aiq) }
+
+// the modules rkisp1_convert_results translates
+static const ParamsModule params_modules[] = {
+    PARAMS_MODULE (CIFISP_DPCC_ID, dpcc_config, others.dpcc_config),
+    PARAMS_MODULE (CIFISP_BLS_ID, bls_config, others.bls_config),
+    PARAMS_MODULE (CIFISP_HST_ID, hst_config, meas.hst_config),
+    PARAMS_MODULE (CIFISP_LSC_ID, lsc_config, others.lsc_config),
+    PARAMS_MODULE (CIFISP_AWB_GAIN_ID, awb_gain_config, others.awb_gain_config),
+    PARAMS_MODULE (CIFISP_FLT_ID, flt_config, others.flt_config),
+    PARAMS_MODULE (CIFISP_BDM_ID, bdm_config, others.bdm_config),
+    PARAMS_MODULE (CIFISP_CTK_ID, ctk_config, others.ctk_config),
+    PARAMS_MODULE (CIFISP_GOC_ID, goc_config, others.goc_config),
+    PARAMS_MODULE (CIFISP_CPROC_ID, cproc_config, others.cproc_config),
+    PARAMS_MODULE (CIFISP_AFC_ID, afc_config, meas.afc_config),
+    PARAMS_MODULE (CIFISP_AWB_ID, awb_meas_config, meas.awb_meas_config),
+    PARAMS_MODULE (CIFISP_IE_ID, ie_config, others.ie_config),
+    PARAMS_MODULE (CIFISP_AEC_ID, aec_config, meas.aec_config),
+    PARAMS_MODULE (CIFISP_DPF_ID, dpf_config, others.dpf_config),
+    PARAMS_MODULE (CIFISP_DPF_STRENGTH_ID, dpf_strength_config, others.dpf_strength_config),
+};
+
+#define PARAMS_MODULE_COUNT (sizeof (params_modules) / sizeof (params_modules[0]))
+
+class ParamsSource {
+public:
+    virtual ~ParamsSource () {}
+    virtual bool next (struct rkisp_parameters &params) = 0;
+};
+
+class ReplayParamsSource
+    : public ParamsSource
+{
+public:
+    explicit ReplayParamsSource ()
+        : _fp (NULL)
+    {}
+    ~ReplayParamsSource () {
+        if (_fp)
+            fclose (_fp);
+    }
+
+    bool open (const char *path) {
+        X3aReplayOutputHeader header;
+
+        _fp = fopen (path, "rb");
+        if (!_fp || fread (&header, sizeof (header), 1, _fp) != 1) {
+            printf ("read replay output %s failed\n", path);
+            return false;
+        }
+        if (header.magic != X3A_REPLAY_MAGIC || header.version != X3A_REPLAY_VERSION ||
+                header.params_size != sizeof (struct rkisp_parameters)) {
+            printf ("%s is no replay output of this build\n", path);
+            return false;
+        }
+        return true;
+    }
+
+    virtual bool next (struct rkisp_parameters &params) {
+        X3aReplayResult result;
+
+        while (fread (&result, sizeof (result), 1, _fp) == 1) {
+            if (result.type == X3aIspConfig::IspAllParameters &&
+                    result.size == sizeof (params))
+                return fread (&params, sizeof (params), 1, _fp) == 1;
+            if (fseek (_fp, result.size, SEEK_CUR) != 0)
+                return false;
+        }
+        return false;
+    }
+
+private:
+    FILE *_fp;
+};
+
+/*
+ * Every frame each module changes one byte with a probability of 1/4, its
+ * enable bit only flips together with a config change. One of 8 frames
+ * repeats the previous one.
+ */
+class GeneratedParamsSource
+    : public ParamsSource
+{
+public:
+    explicit GeneratedParamsSource (uint32_t frames)
+        : _frames (frames)
+        , _seed (0x13572468)
+    {
+        memset (&_params, 0, sizeof (_params));
+        _params.active_configs = HAL_ISP_ALL_MASK;
+    }
+
+    virtual bool next (struct rkisp_parameters &params) {
+        if (!_frames)
+            return false;
+        --_frames;
+
+        if (random () % 8) {
+            for (uint32_t i = 0; i < PARAMS_MODULE_COUNT; i++) {
+                const ParamsModule &module = params_modules[i];
+                if (random () % 4)
+                    continue;
+                uint8_t *cfg = (uint8_t *)&_params + module.aiq_offset;
+                cfg[random () % module.size] += 1 + random () % 255;
+                if (random () % 4 == 0)
+                    _params.enabled[module.id] = !_params.enabled[module.id];
+            }
+        }
+        params = _params;
+        return true;
+    }
+
+private:
+    uint32_t random () {
+        _seed = _seed * 1103515245 + 12345;
+        return _seed >> 8;
+    }
+
+private:
+    uint32_t                _frames;
+    uint32_t                _seed;
+    struct rkisp_parameters _params;
+};
+
+static const char *
+delta_test_mask_name (uint32_t mask, char *buf, size_t size)
+{
+    buf[0] = '\0';
+    for (uint32_t i = 0; i < PARAMS_MODULE_COUNT; i++) {
+        if (mask & (1 << params_modules[i].id)) {
+            strncat (buf, params_modules[i].name, size - strlen (buf) - 1);
+            strncat (buf, " ", size - strlen (buf) - 1);
+        }
+    }
+    return buf;
+}
+
+static bool
+delta_test_run (ParamsSource &source)
+{
+    struct rkisp_parameters params, last_converted, prev;
+    struct rkisp1_isp_params_cfg full, driver;
+    uint32_t pending_cfg = 0, pending_en = 0;
+    uint32_t expected_cfg = 0, expected_en = 0;
+    uint32_t configured = 0, enabled_set = 0;
+    uint32_t frames = 0, queued = 0, flagged = 0, failed = 0;
+    char name[512];
+
+    memset (&last_converted, 0, sizeof (last_converted));
+    memset (&prev, 0, sizeof (prev));
+    memset (&full, 0, sizeof (full));
+    memset (&driver, 0, sizeof (driver));
+
+    while (source.next (params)) {
+        struct rkisp1_isp_params_cfg update;
+        unsigned int cfg_changed, en_changed;
+
+        memset (&update, 0, sizeof (update));
+        rkisp1_convert_results (&update, &params, last_converted);
+        IspController::gen_full_isp_params (&update, &full, &cfg_changed, &en_changed);
+        pending_cfg |= cfg_changed;
+        pending_en |= en_changed;
+
+        // the convert pass may have changed @params, compare what it kept
+        for (uint32_t i = 0; i < PARAMS_MODULE_COUNT; i++) {
+            const ParamsModule &module = params_modules[i];
+            uint32_t mask = 1 << module.id;
+
+            if (!(params.active_configs & mask) ||
+                    !memcmp ((uint8_t *)&params + module.aiq_offset,
+                             (uint8_t *)&prev + module.aiq_offset, module.size))
+                continue;
+            expected_cfg |= mask;
+            if (params.enabled[module.id] != prev.enabled[module.id])
+                expected_en |= mask;
+        }
+        prev = params;
+        ++frames;
+
+        if (frames % DELTA_TEST_DEFER_PERIOD == 0)
+            continue;
+
+        if (pending_cfg != expected_cfg || pending_en != expected_en) {
+            printf ("frame %u: cfg update 0x%05x expected 0x%05x, en update 0x%05x expected 0x%05x\n",
+                    frames, pending_cfg, expected_cfg, pending_en, expected_en);
+            printf ("    unexpected: %s\n",
+                    delta_test_mask_name (pending_cfg & ~expected_cfg, name, sizeof (name)));
+            printf ("    missing: %s\n",
+                    delta_test_mask_name (expected_cfg & ~pending_cfg, name, sizeof (name)));
+            ++failed;
+        }
+
+        // the driver only applies the flagged modules of the queued buffer
+        for (uint32_t i = 0; i < PARAMS_MODULE_COUNT; i++) {
+            const ParamsModule &module = params_modules[i];
+            uint32_t mask = 1 << module.id;
+
+            if (pending_cfg & mask) {
+                memcpy ((uint8_t *)&driver + module.isp_offset,
+                        (uint8_t *)&full + module.isp_offset, module.size);
+                configured |= mask;
+            }
+            if (pending_en & mask) {
+                driver.module_ens = (driver.module_ens & ~mask) | (full.module_ens & mask);
+                enabled_set |= mask;
+            }
+
+            if ((configured & mask) &&
+                    memcmp ((uint8_t *)&driver + module.isp_offset,
+                            (uint8_t *)&params + module.aiq_offset, module.size)) {
+                printf ("frame %u: driver %s differs from the latest params\n", frames, module.name);
+                ++failed;
+            }
+            if ((enabled_set & mask) &&
+                    !!(driver.module_ens & mask) != params.enabled[module.id]) {
+                printf ("frame %u: driver %s enable %d, latest params %d\n", frames, module.name,
+                        !!(driver.module_ens & mask), params.enabled[module.id]);
+                ++failed;
+            }
+        }
+
+        flagged += __builtin_popcount (pending_cfg);
+        ++queued;
+        pending_cfg = pending_en = 0;
+        expected_cfg = expected_en = 0;
+    }
+
+    printf ("%u frames, %u buffers queued, %.2f of %u modules flagged per buffer, %u failures\n",
+            frames, queued, queued ? (double)flagged / queued : 0.0,
+            (uint32_t)PARAMS_MODULE_COUNT, failed);
+    return frames > 0 && failed == 0;
+}
+
+int main (int argc, char *argv[])
+{
+    bool ok = false;
+
+    if (argc > 1) {
+        ReplayParamsSource source;
+        ok = source.open (argv[1]) && delta_test_run (source);
+    } else {
+        GeneratedParamsSource source (DELTA_TEST_FRAMES);
+        ok = delta_test_run (source);
+    }
+
+    printf ("isp params delta test %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,382 @@
+/*
+ * isp_params_ring_test.cpp - IspController params ring on a fake params device
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Runs IspController::handle_sof and set_3a_config frame by frame against a
+ * fake meta output params device. The fake takes QBUF/DQBUF, and the ISP
+ * latches at most one params buffer per frame, once it has been queued for
+ * the consumption latency. Done buffers are reported by POLLOUT on an
+ * eventfd standing in for the video node.
+ *
+ * Every frame changes the awb gains, cproc is only configured once. Each
+ * case checks
+ *   - a buffer is never queued twice, nor changed while the kernel owns it
+ *   - every queued buffer carries the latest awb gains, and the cproc config
+ *     only on the first buffer and on the first one after a restart
+ *   - a frame which finds all buffers in flight is deferred, not blocked,
+ *     and the next free buffer carries its update
+ *   - done buffers are reclaimed on the next SOF, the stats match the device
+ *   - after the params device restarted (exit (false)) the next buffer
+ *     resends every module configured so far
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <deque>
+#include <vector>
+
+#include <v4l2_device.h>
+
+#include "isp_controller.h"
+#include "x3a_isp_config.h"
+
+using namespace XCam;
+
+#define RING_TEST_FRAMES          300
+// the params device is restarted before this frame
+#define RING_TEST_RESTART_FRAME   150
+#define RING_TEST_FRAME_NS        33333333LL
+#define RING_TEST_CPROC_CONTRAST  0x80
+
+struct FakeParamsEntry {
+    uint32_t index;
+    int      queue_frame;
+    uint32_t cfg_update;
+    uint32_t en_update;
+    uint16_t gain_red;
+};
+
+/*
+ * Meta output params device without a kernel behind it, the buffers are
+ * plain memory handed out through the buffer pool like USERPTR ones.
+ */
+class FakeParamsDevice
+    : public V4l2Device
+{
+public:
+    explicit FakeParamsDevice (uint32_t buf_count, uint32_t latency)
+        : V4l2Device ("/dev/fake-isp-params")
+        , _latency (latency)
+        , _frame (0)
+        , _queued (0)
+        , _dequeued (0)
+        , _errors (0)
+    {
+        _buf_type = V4L2_BUF_TYPE_META_OUTPUT;
+        _buf_count = buf_count;
+        _fd = eventfd (0, EFD_NONBLOCK);
+        _params.resize (buf_count);
+        _snapshots.resize (buf_count);
+        _owned.resize (buf_count, false);
+        memset (&_hw, 0, sizeof (_hw));
+
+        for (uint32_t i = 0; i < buf_count; i++) {
+            struct v4l2_buffer buf;
+            xcam_mem_clear (buf);
+            buf.index = i;
+            buf.type = _buf_type;
+            buf.memory = V4L2_MEMORY_USERPTR;
+            buf.m.userptr = (unsigned long)&_params[i];
+            buf.length = sizeof (struct rkisp1_isp_params_cfg);
+            _buf_pool.push_back (new V4l2Buffer (buf, _format));
+        }
+        update_pollout ();
+    }
+
+    virtual XCamReturn start (bool need_queue_bufs = true) {
+        XCAM_UNUSED (need_queue_bufs);
+        _active = true;
+        return XCAM_RETURN_NO_ERROR;
+    }
+    virtual XCamReturn stop () {
+        _active = false;
+        return XCAM_RETURN_NO_ERROR;
+    }
+
+    // stream off and on, the kernel drops every buffer it owns
+    void restart () {
+        _pending.clear ();
+        _done.clear ();
+        _owned.assign (_owned.size (), false);
+        update_pollout ();
+    }
+
+    // SOF of @frame, the ISP latches the oldest buffer which is due
+    void frame_start (int frame) {
+        _frame = frame;
+        if (_pending.empty () || _pending.front ().queue_frame + (int)_latency > frame)
+            return;
+
+        FakeParamsEntry entry = _pending.front ();
+        const struct rkisp1_isp_params_cfg &params = _params[entry.index];
+        _pending.pop_front ();
+        if (memcmp (&params, &_snapshots[entry.index], sizeof (params))) {
+            printf ("frame %d: params buf(%u) changed while queued\n", frame, entry.index);
+            ++_errors;
+        }
+        if (params.module_cfg_update & CIFISP_MODULE_AWB_GAIN)
+            _hw.others.awb_gain_config = params.others.awb_gain_config;
+        if (params.module_cfg_update & CIFISP_MODULE_CPROC)
+            _hw.others.cproc_config = params.others.cproc_config;
+        _hw.module_ens = (_hw.module_ens & ~params.module_en_update) |
+                         (params.module_ens & params.module_en_update);
+        _done.push_back (entry);
+        update_pollout ();
+    }
+
+    virtual int io_control (int cmd, void *arg) {
+        struct v4l2_buffer *buf = (struct v4l2_buffer *)arg;
+
+        switch (cmd) {
+        case VIDIOC_QBUF:
+            if (buf->type != _buf_type || buf->index >= _buf_count || _owned[buf->index]) {
+                printf ("frame %d: bad QBUF of params buf(%u)\n", _frame, buf->index);
+                ++_errors;
+                errno = EINVAL;
+                return -1;
+            } else {
+                const struct rkisp1_isp_params_cfg &params = _params[buf->index];
+                FakeParamsEntry entry;
+                entry.index = buf->index;
+                entry.queue_frame = _frame;
+                entry.cfg_update = params.module_cfg_update;
+                entry.en_update = params.module_en_update;
+                entry.gain_red = params.others.awb_gain_config.gain_red;
+                _snapshots[buf->index] = params;
+                _owned[buf->index] = true;
+                _pending.push_back (entry);
+                _log.push_back (entry);
+                ++_queued;
+            }
+            return 0;
+        case VIDIOC_DQBUF:
+            if (_done.empty ()) {
+                errno = EAGAIN;
+                return -1;
+            }
+            buf->index = _done.front ().index;
+            _owned[buf->index] = false;
+            _done.pop_front ();
+            ++_dequeued;
+            update_pollout ();
+            return 0;
+        default:
+            break;
+        }
+        return 0;
+    }
+
+    uint32_t get_owned () const {
+        return _pending.size () + _done.size ();
+    }
+    bool has_done () const {
+        return !_done.empty ();
+    }
+
+private:
+    // POLLOUT is up while the eventfd counter is below its maximum
+    void update_pollout () {
+        uint64_t value = 0;
+        if (read (_fd, &value, sizeof (value)) < 0 && errno != EAGAIN)
+            ++_errors;
+        if (_done.empty ()) {
+            value = 0xfffffffffffffffeULL;
+            if (write (_fd, &value, sizeof (value)) != sizeof (value))
+                ++_errors;
+        }
+    }
+
+    XCAM_DEAD_COPY (FakeParamsDevice);
+
+public:
+    uint32_t                                  _latency;
+    int                                       _frame;
+    uint64_t                                  _queued;
+    uint64_t                                  _dequeued;
+    uint32_t                                  _errors;
+    // what the ISP runs with, only flagged modules are applied
+    struct rkisp1_isp_params_cfg              _hw;
+    std::vector<FakeParamsEntry>              _log;
+
+private:
+    std::vector<struct rkisp1_isp_params_cfg> _params;
+    std::vector<struct rkisp1_isp_params_cfg> _snapshots;
+    std::vector<bool>                         _owned;
+    std::deque<FakeParamsEntry>               _pending;
+    std::deque<FakeParamsEntry>               _done;
+};
+
+struct RingTestCase {
+    const char *name;
+    uint32_t    buf_count;
+    uint32_t    latency;
+    bool        expect_defer;
+};
+
+static const RingTestCase ring_test_cases[] = {
+    { "queue and reclaim", ISP_PARAMS_BUF_COUNT, 2, false },
+    { "all in flight", ISP_PARAMS_BUF_COUNT, ISP_PARAMS_BUF_COUNT + 2, true },
+    { "buffer count capped", ISP_PARAMS_MAX_BUF_COUNT + 2, ISP_PARAMS_MAX_BUF_COUNT + 1, true },
+};
+
+static void
+ring_test_set_params (struct rkisp_parameters &params, int frame)
+{
+    params.active_configs = HAL_ISP_AWB_GAIN_MASK | HAL_ISP_CPROC_MASK;
+    params.enabled[HAL_ISP_AWB_GAIN_ID] = true;
+    params.enabled[HAL_ISP_CPROC_ID] = true;
+    params.awb_gain_config.gain_red = 0x100 + frame % 0x200;
+    params.awb_gain_config.gain_green_r = 0x100;
+    params.awb_gain_config.gain_green_b = 0x100;
+    params.awb_gain_config.gain_blue = 0x180;
+    params.cproc_config.contrast = RING_TEST_CPROC_CONTRAST;
+    params.cproc_config.sat = RING_TEST_CPROC_CONTRAST;
+}
+
+static bool
+ring_test_run (const RingTestCase &test)
+{
+    SmartPtr<FakeParamsDevice> fake = new FakeParamsDevice (test.buf_count, test.latency);
+    SmartPtr<V4l2Device> device = fake;
+    IspController isp;
+    X3aIspConfig config;
+    uint32_t buf_count = XCAM_MIN (test.buf_count, (uint32_t)ISP_PARAMS_MAX_BUF_COUNT);
+    uint64_t deferred = 0;
+    uint16_t gain = 0;
+    size_t expect_full = 0;
+    uint32_t failed = 0;
+
+    isp.set_isp_params_device (device);
+    isp.set_isp_ver (0);
+    fake->start ();
+    isp.exit (false);
+
+    for (int frame = 1; frame <= RING_TEST_FRAMES; frame++) {
+        fake->frame_start (frame);
+        isp.handle_sof (frame * RING_TEST_FRAME_NS, frame);
+
+        IspParamsStats stats = isp.get_params_stats ();
+        if (fake->has_done () || stats.in_flight != fake->get_owned ()) {
+            printf ("frame %d: %u in flight, device owns %u, done left %d\n", frame,
+                    stats.in_flight, fake->get_owned (), fake->has_done ());
+            ++failed;
+        }
+
+        if (frame == RING_TEST_RESTART_FRAME) {
+            fake->restart ();
+            isp.exit (false);
+            expect_full = fake->_log.size ();
+        }
+
+        struct rkisp_parameters &params = config.get_isp_configs ();
+        ring_test_set_params (params, frame);
+        gain = params.awb_gain_config.gain_red;
+        size_t logged = fake->_log.size ();
+        XCamReturn ret = isp.set_3a_config (&config);
+        stats = isp.get_params_stats ();
+
+        if (ret != XCAM_RETURN_NO_ERROR) {
+            printf ("frame %d: set_3a_config failed (%d)\n", frame, (int)ret);
+            ++failed;
+            continue;
+        }
+        if (fake->_log.size () == logged) {
+            if (stats.deferred != ++deferred || fake->get_owned () != buf_count) {
+                printf ("frame %d: not queued with %u of %u buffers in flight, %llu deferred\n",
+                        frame, fake->get_owned (), buf_count, (unsigned long long)stats.deferred);
+                ++failed;
+            }
+            continue;
+        }
+
+        const FakeParamsEntry &entry = fake->_log.back ();
+        // cproc only changed once, it is resent in full after the restart
+        bool full = logged == 0 || logged == expect_full;
+        bool cproc = !!(entry.cfg_update & CIFISP_MODULE_CPROC);
+        if (entry.index >= buf_count || entry.gain_red != gain ||
+                !(entry.cfg_update & CIFISP_MODULE_AWB_GAIN) || cproc != full ||
+                (full && !(entry.en_update & CIFISP_MODULE_CPROC))) {
+            printf ("frame %d: buf(%u) gain 0x%x expected 0x%x, cfg update 0x%x en update 0x%x%s\n",
+                    frame, entry.index, entry.gain_red, gain, entry.cfg_update, entry.en_update,
+                    full ? ", full resend expected" : "");
+            ++failed;
+        }
+    }
+
+    // let the ISP latch whatever is still queued
+    for (int frame = RING_TEST_FRAMES + 1; fake->get_owned (); frame++) {
+        fake->frame_start (frame);
+        isp.handle_sof (frame * RING_TEST_FRAME_NS, frame);
+        if (frame > RING_TEST_FRAMES + (int)(buf_count * (test.latency + 1))) {
+            printf ("%u buffers never done\n", fake->get_owned ());
+            ++failed;
+            break;
+        }
+    }
+
+    IspParamsStats stats = isp.get_params_stats ();
+    const FakeParamsEntry &last = fake->_log.back ();
+    if (stats.queued != fake->_queued || stats.reclaimed != fake->_dequeued ||
+            stats.max_in_flight > buf_count || stats.in_flight) {
+        printf ("stats: %llu queued, %llu reclaimed, %u in flight, %u max, device %llu queued %llu dequeued\n",
+                (unsigned long long)stats.queued, (unsigned long long)stats.reclaimed,
+                stats.in_flight, stats.max_in_flight,
+                (unsigned long long)fake->_queued, (unsigned long long)fake->_dequeued);
+        ++failed;
+    }
+    if (fake->_hw.others.awb_gain_config.gain_red != last.gain_red ||
+            fake->_hw.others.cproc_config.contrast != RING_TEST_CPROC_CONTRAST ||
+            !(fake->_hw.module_ens & CIFISP_MODULE_CPROC)) {
+        printf ("isp runs with gain 0x%x, last queued 0x%x, cproc contrast 0x%x\n",
+                fake->_hw.others.awb_gain_config.gain_red, last.gain_red,
+                fake->_hw.others.cproc_config.contrast);
+        ++failed;
+    }
+    if ((stats.deferred != 0) != test.expect_defer) {
+        printf ("%llu frames deferred, expected %s\n",
+                (unsigned long long)stats.deferred, test.expect_defer ? "some" : "none");
+        ++failed;
+    }
+    failed += fake->_errors;
+
+    printf ("%s: %u buffers, latency %u frames, %llu queued, %llu reclaimed, %llu deferred, "
+            "%u max in flight, %u failures\n",
+            test.name, buf_count, test.latency,
+            (unsigned long long)stats.queued, (unsigned long long)stats.reclaimed,
+            (unsigned long long)stats.deferred, stats.max_in_flight, failed);
+    return failed == 0;
+}
+
+int main (int argc, char *argv[])
+{
+    bool ok = true;
+
+    XCAM_UNUSED (argc);
+    XCAM_UNUSED (argv);
+
+    for (size_t i = 0; i < sizeof (ring_test_cases) / sizeof (ring_test_cases[0]); i++)
+        ok &= ring_test_run (ring_test_cases[i]);
+
+    printf ("isp params ring test %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,160 @@
+/*
+ * safe_ring_bench.cpp - SafeRing vs SafeList contention benchmark
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * N producers push preallocated objects, M consumers pop them until every
+ * object went through the queue once. The ring runs with back-pressure
+ * (push with timeout -1), the list is unbounded, so both see the same
+ * amount of work. Every consumed object is checked against its sequence
+ * so a lost or duplicated object fails the run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <safe_list.h>
+#include <safe_ring.h>
+
+using namespace XCam;
+
+#define BENCH_ITEMS_PER_PRODUCER  200000
+#define BENCH_POP_TIMEOUT         (10 * 1000)
+
+struct BenchItem {
+    uint32_t producer;
+    uint32_t seq;
+};
+
+static int64_t
+bench_now_ns ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+template<class Queue>
+static bool
+bench_push (Queue &queue, const SmartPtr<BenchItem> &item);
+
+template<>
+bool
+bench_push (SafeRing<BenchItem> &queue, const SmartPtr<BenchItem> &item)
+{
+    return queue.push (item, -1);
+}
+
+template<>
+bool
+bench_push (SafeList<BenchItem> &queue, const SmartPtr<BenchItem> &item)
+{
+    return queue.push (item);
+}
+
+template<class Queue>
+static bool
+bench_run (const char *name, Queue &queue, uint32_t producers, uint32_t consumers, double &ops_per_sec)
+{
+    const uint32_t total = producers * BENCH_ITEMS_PER_PRODUCER;
+    std::vector<std::vector<SmartPtr<BenchItem> > > items (producers);
+    std::vector<std::atomic<uint32_t> > seen (producers);
+    std::atomic<uint32_t> consumed (0);
+    std::atomic<uint32_t> errors (0);
+    std::vector<std::thread> threads;
+
+    for (uint32_t p = 0; p < producers; p++) {
+        seen[p].store (0);
+        items[p].reserve (BENCH_ITEMS_PER_PRODUCER);
+        for (uint32_t i = 0; i < BENCH_ITEMS_PER_PRODUCER; i++) {
+            SmartPtr<BenchItem> item = new BenchItem;
+            item->producer = p;
+            item->seq = i;
+            items[p].push_back (item);
+        }
+    }
+
+    int64_t start = bench_now_ns ();
+    for (uint32_t c = 0; c < consumers; c++) {
+        threads.push_back (std::thread ([&] () {
+            while (consumed.load (std::memory_order_relaxed) < total) {
+                SmartPtr<BenchItem> item = queue.pop (BENCH_POP_TIMEOUT);
+                if (!item.ptr ())
+                    continue;
+                if (item->producer >= producers || item->seq >= BENCH_ITEMS_PER_PRODUCER)
+                    errors.fetch_add (1);
+                else
+                    seen[item->producer].fetch_add (1, std::memory_order_relaxed);
+                consumed.fetch_add (1, std::memory_order_relaxed);
+            }
+        }));
+    }
+    for (uint32_t p = 0; p < producers; p++) {
+        threads.push_back (std::thread ([&, p] () {
+            for (uint32_t i = 0; i < BENCH_ITEMS_PER_PRODUCER; i++) {
+                if (!bench_push (queue, items[p][i]))
+                    errors.fetch_add (1);
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size (); i++)
+        threads[i].join ();
+    int64_t elapsed = bench_now_ns () - start;
+
+    for (uint32_t p = 0; p < producers; p++) {
+        if (seen[p].load () != BENCH_ITEMS_PER_PRODUCER)
+            errors.fetch_add (1);
+    }
+
+    ops_per_sec = (double)total * 1e9 / (double)elapsed;
+    printf ("%-10s %2u producer(s) %2u consumer(s): %8.3f ms, %12.0f ops/s%s\n",
+            name, producers, consumers, elapsed / 1e6, ops_per_sec,
+            errors.load () ? " (FAILED)" : "");
+    return errors.load () == 0;
+}
+
+int main (int argc, char *argv[])
+{
+    static const uint32_t configs[][2] = {
+        {1, 1}, {1, 4}, {4, 1}, {2, 2}, {4, 4}, {8, 8},
+    };
+    uint32_t capacity = XCAM_SAFE_RING_DEFAULT_CAPACITY;
+    bool ok = true;
+
+    if (argc > 1)
+        capacity = strtoul (argv[1], NULL, 0);
+
+    printf ("safe ring capacity %u, %u items per producer, %ld cpus\n",
+            capacity, BENCH_ITEMS_PER_PRODUCER, sysconf (_SC_NPROCESSORS_ONLN));
+    for (size_t i = 0; i < sizeof (configs) / sizeof (configs[0]); i++) {
+        SafeRing<BenchItem> ring (capacity);
+        SafeList<BenchItem> list;
+        double ring_ops = 0.0, list_ops = 0.0;
+
+        ok &= bench_run ("SafeRing", ring, configs[i][0], configs[i][1], ring_ops);
+        ok &= bench_run ("SafeList", list, configs[i][0], configs[i][1], list_ops);
+        printf ("%-10s ring/list %.2fx\n", "", ring_ops / list_ops);
+    }
+
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,43 @@
+LOCAL_PATH:= $(call my-dir)
+
+include $(CLEAR_VARS)
+
+# modules/soft is not part of librkisp, build the soft stitcher in
+LOCAL_SRC_FILES +=\
+	soft_stitch_bench.cpp \
+	../../modules/soft/soft_handler.cpp \
+	../../modules/soft/soft_video_buf_allocator.cpp \
+	../../modules/soft/soft_worker.cpp \
+	../../modules/soft/soft_executor.cpp \
+	../../modules/soft/soft_blender_tasks_priv.cpp \
+	../../modules/soft/soft_blender.cpp \
+	../../modules/soft/soft_geo_mapper.cpp \
+	../../modules/soft/soft_geo_tasks_priv.cpp \
+	../../modules/soft/soft_copy_task.cpp \
+	../../modules/soft/soft_stitcher.cpp \
+	../../xcore/interface/blender.cpp \
+	../../xcore/interface/feature_match.cpp \
+	../../xcore/interface/geo_mapper.cpp \
+	../../xcore/interface/stitcher.cpp
+
+LOCAL_CPPFLAGS += -std=c++11 -Wno-error
+LOCAL_CPPFLAGS += -DLINUX
+LOCAL_CPPFLAGS += $(PRJ_CPPFLAGS)
+
+LOCAL_C_INCLUDES := \
+	$(LOCAL_PATH) \
+	$(LOCAL_PATH)/../../ \
+	$(LOCAL_PATH)/../../xcore \
+	$(LOCAL_PATH)/../../xcore/base \
+	$(LOCAL_PATH)/../../modules
+
+LOCAL_SHARED_LIBRARIES += libdl librkisp
+
+ifeq ($(IS_ANDROID_OS),true)
+LOCAL_32_BIT_ONLY := true
+LOCAL_SHARED_LIBRARIES += libutils libcutils liblog
+endif
+
+LOCAL_MODULE:= soft_stitch_bench
+
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,309 @@
+/*
+ * soft_stitch_bench.cpp - soft stitcher latency per executor thread count
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Stitches four synthetic NV12 fisheye frames into one surround view with
+ * the soft stitcher, once per executor thread count (1, 2, 4 and 6 by
+ * default). Every count runs in its own process, because the shared
+ * SoftExecutor keeps the thread count it was started with. The first
+ * frames configure the stitcher and are not timed, the others report the
+ * mean, median and worst stitch latency.
+ *
+ * Before that, a private executor is stopped with jobs still queued: each
+ * dropped job must complete exactly once with XCAM_RETURN_ERROR_THREAD,
+ * so a SoftWorker::stop () waiting for them returns.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include <interface/stitcher.h>
+#include <soft/soft_executor.h>
+#include <soft/soft_video_buf_allocator.h>
+
+using namespace XCam;
+
+#define STITCH_BENCH_CAMERAS      4
+#define STITCH_BENCH_IN_WIDTH     1280
+#define STITCH_BENCH_IN_HEIGHT    800
+#define STITCH_BENCH_OUT_WIDTH    1920
+#define STITCH_BENCH_OUT_HEIGHT   640
+#define STITCH_BENCH_WARMUP       2
+#define STITCH_BENCH_FRAMES       10
+
+#define STOP_TEST_JOBS            8
+#define STOP_TEST_ITEMS           64
+
+static int64_t
+bench_now_ns ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+class StopTestJob
+    : public SoftExecutor::Job
+{
+public:
+    StopTestJob ()
+        : SoftExecutor::Job (STOP_TEST_ITEMS, 1)
+        , _runs (0)
+        , _dones (0)
+        , _error (XCAM_RETURN_NO_ERROR)
+    {}
+    virtual XCamReturn run (uint32_t item) {
+        XCAM_UNUSED (item);
+        ++_runs;
+        usleep (1000);
+        return XCAM_RETURN_NO_ERROR;
+    }
+    virtual void done (XCamReturn err) {
+        _error = err;
+        ++_dones;
+    }
+
+    std::atomic<uint32_t>   _runs;
+    std::atomic<uint32_t>   _dones;
+    XCamReturn              _error;
+};
+
+// stop with most items still queued, every job must still be done once
+static bool
+stop_test ()
+{
+    SmartPtr<SoftExecutor> executor = new SoftExecutor (2);
+    std::vector<SmartPtr<StopTestJob> > jobs;
+    uint32_t dropped = 0;
+    bool ok = true;
+
+    if (!xcam_ret_is_ok (executor->start ())) {
+        printf ("stop test: executor start failed\n");
+        return false;
+    }
+    for (uint32_t i = 0; i < STOP_TEST_JOBS; i++) {
+        SmartPtr<StopTestJob> job = new StopTestJob;
+        jobs.push_back (job);
+        if (!xcam_ret_is_ok (executor->submit (job)))
+            ok = false;
+    }
+    usleep (5000);
+    executor->stop ();
+
+    for (uint32_t i = 0; i < STOP_TEST_JOBS; i++) {
+        const StopTestJob *job = jobs[i].ptr ();
+        uint32_t runs = job->_runs.load ();
+        if (job->_dones.load () != 1 ||
+                (runs < STOP_TEST_ITEMS) != (job->_error == XCAM_RETURN_ERROR_THREAD)) {
+            printf ("stop test: job %u ran %u of %u items, done %u times, error %d\n",
+                    i, runs, STOP_TEST_ITEMS, job->_dones.load (), (int)job->_error);
+            ok = false;
+        }
+        dropped += STOP_TEST_ITEMS - runs;
+    }
+    if (!dropped) {
+        printf ("stop test: no items were queued at stop\n");
+        ok = false;
+    }
+
+    // a stopped executor refuses new jobs
+    SmartPtr<StopTestJob> late = new StopTestJob;
+    if (executor->submit (late) != XCAM_RETURN_ERROR_THREAD)
+        ok = false;
+
+    printf ("stop test: %u jobs, %u items dropped at stop, %s\n",
+            STOP_TEST_JOBS, dropped, ok ? "all done once" : "FAILED");
+    return ok;
+}
+
+static bool
+stitch_bench_fill (const SmartPtr<VideoBuffer> &buf, uint32_t cam)
+{
+    const VideoBufferInfo &info = buf->get_video_info ();
+    uint8_t *mem = buf->map ();
+    if (!mem)
+        return false;
+
+    uint8_t *y = mem + info.offsets[0];
+    uint8_t *uv = mem + info.offsets[1];
+    for (uint32_t row = 0; row < info.height; row++)
+        for (uint32_t col = 0; col < info.width; col++)
+            y[row * info.strides[0] + col] = (uint8_t)((row ^ col) + cam * 50);
+    for (uint32_t row = 0; row < info.height / 2; row++)
+        for (uint32_t col = 0; col < info.width; col++)
+            uv[row * info.strides[1] + col] = (uint8_t)(128 + ((col >> 4) & 1) * 16 * (int)cam);
+    buf->unmap ();
+    return true;
+}
+
+static SmartPtr<Stitcher>
+stitch_bench_create ()
+{
+    SmartPtr<Stitcher> stitcher = Stitcher::create_soft_stitcher ();
+    if (!stitcher.ptr ())
+        return NULL;
+
+    stitcher->set_camera_num (STITCH_BENCH_CAMERAS);
+    stitcher->set_output_size (STITCH_BENCH_OUT_WIDTH, STITCH_BENCH_OUT_HEIGHT);
+
+    // front, left, rear and right fisheye, 120 degrees each around the car
+    for (uint32_t i = 0; i < STITCH_BENCH_CAMERAS; i++) {
+        CameraInfo info;
+        IntrinsicParameter &intrinsic = info.calibration.intrinsic;
+        ExtrinsicParameter &extrinsic = info.calibration.extrinsic;
+
+        intrinsic.xc = STITCH_BENCH_IN_HEIGHT / 2.0f;
+        intrinsic.yc = STITCH_BENCH_IN_WIDTH / 2.0f;
+        intrinsic.c = 1.0f;
+        intrinsic.d = 0.0f;
+        intrinsic.e = 0.0f;
+        intrinsic.poly_length = 2;
+        intrinsic.poly_coeff[0] = 360.0f;
+        intrinsic.poly_coeff[1] = 230.0f;
+
+        float yaw = 90.0f * i;
+        extrinsic.trans_x = (i == 0) ? 2000.0f : (i == 2) ? -2000.0f : 0.0f;
+        extrinsic.trans_y = (i == 1) ? 1000.0f : (i == 3) ? -1000.0f : 0.0f;
+        extrinsic.trans_z = 800.0f;
+        extrinsic.pitch = -25.0f;
+        extrinsic.yaw = yaw;
+
+        info.angle_range = 120.0f;
+        info.round_angle_start = yaw - info.angle_range / 2.0f;
+        if (!stitcher->set_camera_info (i, info))
+            return NULL;
+    }
+    return stitcher;
+}
+
+static bool
+stitch_bench_run (uint32_t threads)
+{
+    if (!SoftExecutor::set_default_threads (threads))
+        return false;
+
+    SmartPtr<Stitcher> stitcher = stitch_bench_create ();
+    if (!stitcher.ptr ()) {
+        printf ("%u threads: create stitcher failed\n", threads);
+        return false;
+    }
+
+    VideoBufferInfo in_info;
+    in_info.init (V4L2_PIX_FMT_NV12, STITCH_BENCH_IN_WIDTH, STITCH_BENCH_IN_HEIGHT);
+    SmartPtr<BufferPool> pool = new SoftVideoBufAllocator (in_info);
+    if (!pool->reserve (STITCH_BENCH_CAMERAS)) {
+        printf ("%u threads: reserve input buffers failed\n", threads);
+        return false;
+    }
+
+    VideoBufferList in_bufs;
+    for (uint32_t i = 0; i < STITCH_BENCH_CAMERAS; i++) {
+        SmartPtr<VideoBuffer> buf = pool->get_buffer ();
+        if (!buf.ptr () || !stitch_bench_fill (buf, i)) {
+            printf ("%u threads: input buffer %u failed\n", threads, i);
+            return false;
+        }
+        in_bufs.push_back (buf);
+    }
+
+    std::vector<double> latency;
+    for (uint32_t frame = 0; frame < STITCH_BENCH_WARMUP + STITCH_BENCH_FRAMES; frame++) {
+        SmartPtr<VideoBuffer> out_buf;
+        int64_t start = bench_now_ns ();
+        XCamReturn ret = stitcher->stitch_buffers (in_bufs, out_buf);
+        int64_t elapsed = bench_now_ns () - start;
+        if (!xcam_ret_is_ok (ret) || !out_buf.ptr ()) {
+            printf ("%u threads: stitch frame %u failed (%d)\n", threads, frame, (int)ret);
+            return false;
+        }
+        if (frame >= STITCH_BENCH_WARMUP)
+            latency.push_back (elapsed / 1e6);
+    }
+
+    double sum = 0.0;
+    for (size_t i = 0; i < latency.size (); i++)
+        sum += latency[i];
+    std::sort (latency.begin (), latency.end ());
+    printf ("%u thread(s): %u frames, mean %8.2f ms, median %8.2f ms, max %8.2f ms\n",
+            SoftExecutor::instance ()->get_threads (), (uint32_t)latency.size (),
+            sum / latency.size (), latency[latency.size () / 2], latency.back ());
+    return true;
+}
+
+static void
+print_help (const char *bin_name)
+{
+    printf ("Usage: %s [threads...]\n"
+            "\t threads      executor thread counts to run, default 1 2 4 6\n",
+            bin_name);
+}
+
+int main (int argc, char *argv[])
+{
+    std::vector<uint32_t> counts;
+    bool ok = true;
+
+    for (int i = 1; i < argc; i++) {
+        uint32_t threads = strtoul (argv[i], NULL, 0);
+        if (!threads || threads > XCAM_SOFT_EXECUTOR_MAX_THREADS) {
+            print_help (argv[0]);
+            return -1;
+        }
+        counts.push_back (threads);
+    }
+    if (counts.empty ()) {
+        counts.push_back (1);
+        counts.push_back (2);
+        counts.push_back (4);
+        counts.push_back (6);
+    }
+
+    ok &= stop_test ();
+
+    printf ("soft stitch %u cameras %ux%u -> %ux%u, %ld cpus\n",
+            STITCH_BENCH_CAMERAS, STITCH_BENCH_IN_WIDTH, STITCH_BENCH_IN_HEIGHT,
+            STITCH_BENCH_OUT_WIDTH, STITCH_BENCH_OUT_HEIGHT, sysconf (_SC_NPROCESSORS_ONLN));
+    for (size_t i = 0; i < counts.size (); i++) {
+        fflush (stdout);
+        pid_t pid = fork ();
+        if (pid < 0) {
+            ok = false;
+            break;
+        }
+        if (pid == 0) {
+            bool done = stitch_bench_run (counts[i]);
+            fflush (stdout);
+            _exit (done ? 0 : 1);
+        }
+
+        int status = 0;
+        if (waitpid (pid, &status, 0) != pid || !WIFEXITED (status) || WEXITSTATUS (status))
+            ok = false;
+    }
+
+    printf ("soft stitch bench %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,49 @@
+/*
+ * utl_fixfloat_legacy.h - fixed point converters before the format table
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __UTL_FIXFLOAT_LEGACY_H__
+#define __UTL_FIXFLOAT_LEGACY_H__
+
+#include <ebase/types.h>
+#include <ebase/utl_fixfloat.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct LegacyFixFormat_s {
+  const char*     name;
+  UtlFixFormat_t  format;
+  float           fMin;
+  float           fMax;
+  float           fPrecision;
+  uint32_t        mask;
+  uint32_t        (*FloatToFix)(float fFloat);
+  float           (*FixToFloat)(uint32_t ulFix);  /**< NULL if the format has none */
+} LegacyFixFormat_t;
+
+extern const LegacyFixFormat_t LegacyFixFormats[];
+extern const uint32_t LegacyFixFormatCount;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UTL_FIXFLOAT_LEGACY_H__ */
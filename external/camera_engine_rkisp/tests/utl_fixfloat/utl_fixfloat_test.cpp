@@ -0,0 +1,318 @@
+/*
+ * utl_fixfloat_test.cpp - fixed point converters against the old implementations
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Checks the table driven UtlFloatToFix_* / UtlFixToFloat_* converters and
+ * the array converters of every format against the per format functions
+ * they replaced, kept in utl_fixfloat_legacy.c.
+ *
+ * Within the range of a format the results must be bit identical:
+ *   - every register value through UtlFixToFloat
+ *   - floats through UtlFloatToFix, every 1021st float of the range and
+ *     all floats within 32 ulps of each rounding boundary. With -e every
+ *     float of the range, which takes some twenty minutes.
+ *
+ * Outside of the range the old converters stopped the process in
+ * DCT_ASSERT, the new ones saturate:
+ *   - a float above the range gives the value of the upper bound, one
+ *     below the range or NaN the value of the lower bound
+ *   - register bits above the width of the format are ignored
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <float.h>
+
+#include "utl_fixfloat_legacy.h"
+
+#define FIX_TEST_STRIDE         1021
+#define FIX_TEST_BOUNDARY_ULPS  32
+#define FIX_TEST_BATCH          4096
+
+struct FixTestFormat {
+    uint32_t (*FloatToFix) (float fFloat);
+    float    (*FixToFloat) (uint32_t ulFix);
+};
+
+#define FIX_TEST_FORMAT(fmt) { UtlFloatToFix_##fmt, UtlFixToFloat_##fmt }
+
+// indexed by UtlFixFormat_t
+static const FixTestFormat fix_test_formats[UTL_FIX_FORMAT_MAX] = {
+    { UtlFloatToFix_U0402, NULL },
+    FIX_TEST_FORMAT (U0107),
+    FIX_TEST_FORMAT (U0208),
+    FIX_TEST_FORMAT (U0408),
+    FIX_TEST_FORMAT (U0800),
+    FIX_TEST_FORMAT (U1000),
+    FIX_TEST_FORMAT (U1200),
+    FIX_TEST_FORMAT (U0010),
+    FIX_TEST_FORMAT (S0207),
+    FIX_TEST_FORMAT (S0307),
+    FIX_TEST_FORMAT (S0407),
+    FIX_TEST_FORMAT (S0504),
+    FIX_TEST_FORMAT (S0808),
+    FIX_TEST_FORMAT (S0800),
+    FIX_TEST_FORMAT (S0900),
+    FIX_TEST_FORMAT (S1200),
+    FIX_TEST_FORMAT (S0109),
+    FIX_TEST_FORMAT (S0408),
+    FIX_TEST_FORMAT (S0108),
+    FIX_TEST_FORMAT (S0110),
+};
+
+struct FixTestStats {
+    uint64_t floats;
+    uint64_t fixes;
+    uint32_t clamps;
+    uint32_t failed;
+};
+
+static float
+fix_test_float (uint32_t bits)
+{
+    float f;
+    memcpy (&f, &bits, sizeof (f));
+    return f;
+}
+
+static uint32_t
+fix_test_bits (float f)
+{
+    uint32_t bits;
+    memcpy (&bits, &f, sizeof (bits));
+    return bits;
+}
+
+static bool
+fix_test_report (FixTestStats &stats, const char *fmt, const char *what, float f, uint32_t got, uint32_t expected)
+{
+    if (stats.failed++ < 20)
+        printf ("%s %s of %.9g (0x%08x): 0x%x, expected 0x%x\n", fmt, what, f, fix_test_bits (f), got, expected);
+    return false;
+}
+
+/*
+ * Collects in range floats and converts them with the single value and
+ * the array converter, both must give what the old converter gives.
+ */
+class FixTestBatch
+{
+public:
+    explicit FixTestBatch (const LegacyFixFormat_t &legacy, FixTestStats &stats)
+        : _legacy (legacy)
+        , _format (fix_test_formats[legacy.format])
+        , _stats (stats)
+        , _count (0)
+        , _ok (true)
+    {}
+
+    void add (float f) {
+        _floats[_count++] = f;
+        if (_count == FIX_TEST_BATCH)
+            flush ();
+    }
+
+    bool flush () {
+        UtlFloatToFixArray (_legacy.format, _floats, _fixes, _count);
+        for (uint32_t i = 0; i < _count; i++) {
+            uint32_t expected = _legacy.FloatToFix (_floats[i]);
+            uint32_t single = _format.FloatToFix (_floats[i]);
+            if (single != expected)
+                _ok = fix_test_report (_stats, _legacy.name, "UtlFloatToFix", _floats[i], single, expected);
+            else if (_fixes[i] != expected)
+                _ok = fix_test_report (_stats, _legacy.name, "UtlFloatToFixArray", _floats[i], _fixes[i], expected);
+        }
+        _stats.floats += _count;
+        _count = 0;
+        return _ok;
+    }
+
+private:
+    const LegacyFixFormat_t &_legacy;
+    const FixTestFormat     &_format;
+    FixTestStats            &_stats;
+    float                    _floats[FIX_TEST_BATCH];
+    uint32_t                 _fixes[FIX_TEST_BATCH];
+    uint32_t                 _count;
+    bool                     _ok;
+};
+
+// floats of [@first, @last] in bit order, both of one sign
+static void
+fix_test_sweep (FixTestBatch &batch, uint32_t first, uint32_t last, uint32_t stride)
+{
+    for (uint64_t bits = first; bits <= last; bits += stride)
+        batch.add (fix_test_float ((uint32_t)bits));
+    batch.add (fix_test_float (last));
+}
+
+static bool
+fix_test_float_to_fix (const LegacyFixFormat_t &legacy, uint32_t stride, FixTestStats &stats)
+{
+    FixTestBatch batch (legacy, stats);
+
+    fix_test_sweep (batch, 0, fix_test_bits (legacy.fMax), stride);
+    if (legacy.fMin < 0.0f)
+        fix_test_sweep (batch, fix_test_bits (-0.0f), fix_test_bits (legacy.fMin), stride);
+
+    // around every point where the rounding steps to the next value
+    if (stride > 1) {
+        int32_t lo = (int32_t)floorf (legacy.fMin * legacy.fPrecision);
+        int32_t hi = (int32_t)ceilf (legacy.fMax * legacy.fPrecision);
+        for (int32_t k = lo; k <= hi; k++) {
+            float boundary = ((float)k + 0.5f) / legacy.fPrecision;
+            float f = boundary;
+            for (int32_t i = 0; i < FIX_TEST_BOUNDARY_ULPS; i++)
+                f = nextafterf (f, -INFINITY);
+            for (int32_t i = 0; i <= 2 * FIX_TEST_BOUNDARY_ULPS; i++) {
+                if (f >= legacy.fMin && f <= legacy.fMax)
+                    batch.add (f);
+                f = nextafterf (f, INFINITY);
+            }
+        }
+    }
+
+    return batch.flush ();
+}
+
+static bool
+fix_test_fix_to_float (const LegacyFixFormat_t &legacy, FixTestStats &stats)
+{
+    const FixTestFormat &format = fix_test_formats[legacy.format];
+    uint32_t count = legacy.mask + 1;
+    uint32_t *fixes = (uint32_t *)malloc (count * sizeof (uint32_t));
+    float *floats = (float *)malloc (count * sizeof (float));
+    bool ok = true;
+
+    if (!legacy.FixToFloat) {
+        free (fixes);
+        free (floats);
+        return true;
+    }
+
+    for (uint32_t v = 0; v < count; v++)
+        fixes[v] = v;
+    UtlFixToFloatArray (legacy.format, fixes, floats, count);
+
+    for (uint32_t v = 0; v < count; v++) {
+        float expected = legacy.FixToFloat (v);
+        float single = format.FixToFloat (v);
+        if (memcmp (&single, &expected, sizeof (float)) || memcmp (&floats[v], &expected, sizeof (float))) {
+            if (stats.failed++ < 20)
+                printf ("%s UtlFixToFloat of 0x%x: %.9g / %.9g, expected %.9g\n",
+                        legacy.name, v, single, floats[v], expected);
+            ok = false;
+        }
+
+        // bits above the format are ignored instead of asserted
+        float upper = format.FixToFloat (v | ~legacy.mask);
+        float above = format.FixToFloat (v | (legacy.mask + 1));
+        if (memcmp (&upper, &expected, sizeof (float)) || memcmp (&above, &expected, sizeof (float))) {
+            if (stats.failed++ < 20)
+                printf ("%s UtlFixToFloat of 0x%x with upper bits: %.9g / %.9g, expected %.9g\n",
+                        legacy.name, v, upper, above, expected);
+            ok = false;
+        }
+        stats.fixes += 3;
+    }
+
+    free (fixes);
+    free (floats);
+    return ok;
+}
+
+static bool
+fix_test_clamp (const LegacyFixFormat_t &legacy, FixTestStats &stats)
+{
+    const FixTestFormat &format = fix_test_formats[legacy.format];
+    uint32_t at_max = legacy.FloatToFix (legacy.fMax);
+    uint32_t at_min = legacy.FloatToFix (legacy.fMin);
+    const float above[] = {
+        nextafterf (legacy.fMax, INFINITY), legacy.fMax + 1.0f, legacy.fMax * 4.0f,
+        2147483648.0f, 1e30f, FLT_MAX, INFINITY
+    };
+    const float below[] = {
+        nextafterf (legacy.fMin, -INFINITY), legacy.fMin - 1.0f, legacy.fMin - 1000.0f,
+        -2147483648.0f, -1e30f, -FLT_MAX, -INFINITY, NAN, -NAN
+    };
+    const uint32_t above_count = sizeof (above) / sizeof (above[0]);
+    const uint32_t below_count = sizeof (below) / sizeof (below[0]);
+    float values[above_count + below_count];
+    uint32_t fixes[above_count + below_count];
+    bool ok = true;
+
+    memcpy (values, above, sizeof (above));
+    memcpy (values + above_count, below, sizeof (below));
+    UtlFloatToFixArray (legacy.format, values, fixes, above_count + below_count);
+
+    for (uint32_t i = 0; i < above_count + below_count; i++) {
+        uint32_t expected = i < above_count ? at_max : at_min;
+        uint32_t single = format.FloatToFix (values[i]);
+        if (single != expected)
+            ok = fix_test_report (stats, legacy.name, "clamp", values[i], single, expected);
+        else if (fixes[i] != expected)
+            ok = fix_test_report (stats, legacy.name, "array clamp", values[i], fixes[i], expected);
+        ++stats.clamps;
+    }
+    return ok;
+}
+
+static void
+print_help (const char *bin_name)
+{
+    printf ("Usage: %s [-e]\n"
+            "\t -e           every float of each range, not every %dth\n"
+            "\t -h           help\n",
+            bin_name, FIX_TEST_STRIDE);
+}
+
+int main (int argc, char *argv[])
+{
+    uint32_t stride = FIX_TEST_STRIDE;
+    bool ok = true;
+    int opt;
+
+    while ((opt = getopt (argc, argv, "eh")) != -1) {
+        switch (opt) {
+        case 'e':
+            stride = 1;
+            break;
+        default:
+            print_help (argv[0]);
+            return opt == 'h' ? 0 : -1;
+        }
+    }
+
+    for (uint32_t i = 0; i < LegacyFixFormatCount; i++) {
+        const LegacyFixFormat_t &legacy = LegacyFixFormats[i];
+        FixTestStats stats = {0, 0, 0, 0};
+
+        ok &= fix_test_fix_to_float (legacy, stats);
+        ok &= fix_test_float_to_fix (legacy, stride, stats);
+        ok &= fix_test_clamp (legacy, stats);
+        printf ("%s: %10llu floats %6llu register values %2u clamps %u failures\n", legacy.name,
+                (unsigned long long)stats.floats, (unsigned long long)stats.fixes, stats.clamps, stats.failed);
+    }
+
+    printf ("utl fixfloat test %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : -1;
+}
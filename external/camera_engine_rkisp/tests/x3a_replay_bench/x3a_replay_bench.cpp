@@ -0,0 +1,697 @@
+/*
+ * x3a_replay_bench.cpp - record a synthetic scene and replay it through 3a
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Without -r the bench first records: X3aAnalyzerRKiq runs with a record
+ * path on a fake IspController, the statistics come from a synthetic scene
+ * whose brightness steps twice and which follows the exposure results with
+ * the sensor delay. The results of that run are kept.
+ *
+ * The recording is then replayed with X3aReplayer, serial and with the
+ * handlers in parallel, reporting frames/sec and the cost of every handler.
+ * A replay of a recording made here has to give the same params and
+ * exposure results as the recording run, byte for byte, else the bench
+ * fails. A recording given with -r, e.g. one taken on the device with
+ * X3aAnalyzerRKiq::set_record_path, is only replayed.
+ *
+ * The ae, awb and af algorithms are the libraries found in XCAM_AE_LIB,
+ * XCAM_AWB_LIB and XCAM_AF_LIB (default /usr/lib/rkisp/{ae,awb,af}), the
+ * bench reports which of them were loaded. Without them only the handlers
+ * and the ia engine run, e.g. on a build host.
+ *
+ * The replay output (-o) can be checked by isp_params_delta_test.
+ *
+ * With -l the synthetic recording is also replayed in realtime, once per
+ * analyzer stats policy and CPU load, the load being busy threads on every
+ * cpu. Each row reports how long after its stats arrived a frame got its
+ * results, and the AE convergence time: from the arrival of the first
+ * frame after a light step until the first exposure within 5% of the one
+ * the serial replay settles on before the next step. As the algorithms cost
+ * next to nothing without their libraries, -c adds a cpu bound cost to
+ * every analyzed frame, by default only when the ae library is missing.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dynamic_algorithms_libs_loader.h"
+#include "isp_controller.h"
+#include "x3a_analyzer_rkiq.h"
+#include "x3a_statistics_queue.h"
+#include "x3a_isp_config.h"
+#include "x3a_replay.h"
+
+using namespace XCam;
+
+#define BENCH_DEFAULT_FRAMES        300
+#define BENCH_DEFAULT_RECORD        "/tmp/x3a_replay_bench.rec"
+#define BENCH_SENSOR_ENTITY_NAME    "m00_b_ov5695 1-0036"
+#define BENCH_WIDTH                 2592
+#define BENCH_HEIGHT                1944
+#define BENCH_FRAMERATE             30.0
+#define BENCH_VTS                   2000
+#define BENCH_HTS                   1500
+#define BENCH_PCLK                  90000000
+// frames until an exposure written after the stats of frame N is seen in the stats
+#define BENCH_EXPOSURE_DELAY        3
+#define BENCH_FRAME_USEC            ((int64_t)(1000000 / BENCH_FRAMERATE))
+// emulated algorithm cost per analyzed frame when the ae library is missing
+#define BENCH_EMULATED_COST_USEC    8000
+// exposure within that share of the settled one counts as converged
+#define BENCH_CONVERGED_RATIO       0.05
+
+struct BenchResult {
+    uint32_t             type;
+    // replay output only
+    uint32_t             stats_frame;
+    int64_t              done_usec;
+    std::vector<uint8_t> data;
+};
+
+typedef std::vector<BenchResult> BenchResultList;
+
+struct BenchExposure {
+    uint32_t target_frame;
+    uint32_t exp_time;
+    uint32_t gain;
+};
+
+/*
+ * The sensor and ISP of the recording run: fixed 2592x1944@30 sensor mode, the
+ * exposure of a frame is the last one scheduled for it.
+ */
+class BenchIspController
+    : public IspController
+{
+public:
+    explicit BenchIspController ()
+        : _frame (0)
+    {
+        BenchExposure initial = {0, BENCH_VTS / 2, 32};
+        _exposures.push_back (initial);
+    }
+
+    void set_frame (uint32_t frame) {
+        _frame = frame;
+    }
+    // an exposure without integration time, e.g. no ae library, keeps the last one
+    void schedule_exposure (const struct rkisp_exposure &exposure) {
+        BenchExposure entry;
+        if (!exposure.coarse_integration_time)
+            return;
+        entry.target_frame = _frame + BENCH_EXPOSURE_DELAY;
+        entry.exp_time = exposure.coarse_integration_time;
+        entry.gain = exposure.analog_gain;
+        while (!_exposures.empty () && _exposures.back ().target_frame >= entry.target_frame)
+            _exposures.pop_back ();
+        _exposures.push_back (entry);
+    }
+    const BenchExposure &get_exposure (uint32_t frame) const {
+        for (size_t i = _exposures.size (); i > 1; --i) {
+            if (_exposures[i - 1].target_frame <= frame)
+                return _exposures[i - 1];
+        }
+        return _exposures[0];
+    }
+
+    virtual XCamReturn get_sensor_mode_data (
+        struct isp_supplemental_sensor_mode_data &sensor_mode_data, int stats_frame) {
+        const BenchExposure &exposure = get_exposure (stats_frame < 0 ? _frame : (uint32_t)stats_frame);
+
+        xcam_mem_clear (sensor_mode_data);
+        sensor_mode_data.coarse_integration_time_min = 1;
+        sensor_mode_data.coarse_integration_time_max_margin = 4;
+        sensor_mode_data.frame_length_lines = BENCH_VTS;
+        sensor_mode_data.line_length_pck = BENCH_HTS;
+        sensor_mode_data.vt_pix_clk_freq_hz = BENCH_PCLK;
+        sensor_mode_data.crop_horizontal_end = BENCH_WIDTH - 1;
+        sensor_mode_data.crop_vertical_end = BENCH_HEIGHT - 1;
+        sensor_mode_data.sensor_output_width = BENCH_WIDTH;
+        sensor_mode_data.sensor_output_height = BENCH_HEIGHT;
+        sensor_mode_data.isp_input_width = BENCH_WIDTH;
+        sensor_mode_data.isp_input_height = BENCH_HEIGHT;
+        sensor_mode_data.isp_output_width = BENCH_WIDTH;
+        sensor_mode_data.isp_output_height = BENCH_HEIGHT;
+        sensor_mode_data.binning_factor_x = 1;
+        sensor_mode_data.binning_factor_y = 1;
+        sensor_mode_data.exposure_valid_frame[0] = BENCH_EXPOSURE_DELAY;
+        sensor_mode_data.exp_time = exposure.exp_time;
+        sensor_mode_data.gain = exposure.gain;
+        return XCAM_RETURN_NO_ERROR;
+    }
+    virtual XCamReturn get_frame_softime (int64_t &sof_tim) {
+        sof_tim = (int64_t)_frame * (int64_t)(1000000000LL / BENCH_FRAMERATE);
+        return XCAM_RETURN_NO_ERROR;
+    }
+    virtual XCamReturn get_vcm_time (struct rk_cam_vcm_tim *vcm_tim) {
+        memset (vcm_tim, 0, sizeof (*vcm_tim));
+        return XCAM_RETURN_NO_ERROR;
+    }
+
+private:
+    XCAM_DEAD_COPY (BenchIspController);
+
+private:
+    uint32_t                   _frame;
+    std::vector<BenchExposure> _exposures;
+};
+
+#define BENCH_LIGHT_STEPS 2
+
+// first frame of light step @step (1 based), @frames after the last one
+static uint32_t
+bench_light_step (uint32_t frames, uint32_t step)
+{
+    return step > BENCH_LIGHT_STEPS ? frames : frames * step / (BENCH_LIGHT_STEPS + 1);
+}
+
+/*
+ * Grey-ish scene lit by a light which gets 8 times brighter after the
+ * first third and half as bright again after the second one. The statistics
+ * scale with exposure time * gain and clip like the sensor does.
+ */
+static void
+bench_scene_stats (
+    uint32_t frame, uint32_t frames, const BenchExposure &exposure,
+    struct cifisp_stat_buffer &stats)
+{
+    double light = frame < bench_light_step (frames, 1) ? 1.0 :
+                   (frame < bench_light_step (frames, 2) ? 8.0 : 4.0);
+    double level = light * exposure.exp_time * exposure.gain / 1024.0;
+    uint32_t bin_count = 16;
+
+    memset (&stats, 0, sizeof (stats));
+    stats.meas_type = CIFISP_STAT_AWB | CIFISP_STAT_AUTOEXP | CIFISP_STAT_AFM_FIN | CIFISP_STAT_HIST;
+    stats.frame_id = frame;
+
+    for (uint32_t i = 0; i < CIFISP_AE_MEAN_MAX; i++) {
+        // a brighter center and a darker bottom row
+        double weight = 0.6 + 0.1 * ((i * 7) % 9) / 2.0;
+        double mean = level * weight;
+        uint8_t value = mean > 255.0 ? 255 : (uint8_t)mean;
+
+        stats.params.ae.exp_mean[i] = value;
+        stats.params.hist.hist_bins[value * bin_count / 256] += 1000;
+    }
+
+    uint8_t y = level > 255.0 ? 255 : (uint8_t)level;
+    stats.params.awb.awb_mean[0].cnt = BENCH_WIDTH * BENCH_HEIGHT / 4;
+    // YCbCr measuring, slightly warm white
+    stats.params.awb.awb_mean[0].mean_y_or_g = y;
+    stats.params.awb.awb_mean[0].mean_cb_or_b = 120;
+    stats.params.awb.awb_mean[0].mean_cr_or_r = 136;
+
+    for (uint32_t i = 0; i < CIFISP_AFM_MAX_WINDOWS; i++) {
+        stats.params.af.window[i].sum = 4000 + 1000 * i;
+        stats.params.af.window[i].lum = y;
+    }
+}
+
+static void
+bench_keep_results (X3aResultList &results, BenchResultList *kept, BenchIspController *isp)
+{
+    for (X3aResultList::iterator iter = results.begin (); iter != results.end (); ++iter) {
+        SmartPtr<X3aResult> &result = *iter;
+        BenchResult entry;
+        const uint8_t *data = NULL;
+        size_t size = 0;
+
+        entry.type = result->get_type ();
+        entry.stats_frame = 0;
+        entry.done_usec = 0;
+        if (entry.type == X3aIspConfig::IspAllParameters) {
+            SmartPtr<X3aAtomIspParametersResult> params =
+                result.dynamic_cast_ptr<X3aAtomIspParametersResult> ();
+            data = (const uint8_t *)&params->get_isp_config ();
+            size = sizeof (struct rkisp_parameters);
+        } else if (entry.type == X3aIspConfig::IspExposureParameters) {
+            SmartPtr<X3aIspExposureResult> exposure =
+                result.dynamic_cast_ptr<X3aIspExposureResult> ();
+            if (isp)
+                isp->schedule_exposure (exposure->get_isp_config ());
+            data = (const uint8_t *)&exposure->get_isp_config ();
+            size = sizeof (struct rkisp_exposure);
+        } else {
+            continue;
+        }
+        if (kept) {
+            entry.data.assign (data, data + size);
+            kept->push_back (entry);
+        }
+    }
+}
+
+class BenchRecorder
+    : public AnalyzerCallback
+{
+public:
+    explicit BenchRecorder (BenchIspController *isp, BenchResultList &results)
+        : _isp (isp)
+        , _results (results)
+        , _failed (0)
+    {}
+    uint32_t get_failed () const {
+        return _failed;
+    }
+
+    virtual void x3a_calculation_done (XAnalyzer *analyzer, X3aResultList &results) {
+        XCAM_UNUSED (analyzer);
+        bench_keep_results (results, &_results, _isp);
+    }
+    virtual void x3a_calculation_failed (XAnalyzer *analyzer, int64_t timestamp, const char *msg) {
+        XCAM_UNUSED (analyzer);
+        XCAM_UNUSED (timestamp);
+        printf ("record: 3a failed: %s\n", XCAM_STR (msg));
+        ++_failed;
+    }
+
+private:
+    XCAM_DEAD_COPY (BenchRecorder);
+
+private:
+    BenchIspController *_isp;
+    BenchResultList    &_results;
+    uint32_t            _failed;
+};
+
+static bool
+bench_record (const char *iq_path, const char *record_path, uint32_t frames, BenchResultList &results)
+{
+    SmartPtr<BenchIspController> bench_isp = new BenchIspController ();
+    SmartPtr<IspController> isp = bench_isp;
+    BenchRecorder recorder (bench_isp.ptr (), results);
+
+    SmartPtr<X3aStatisticsQueue> stats_pool = new X3aStatisticsQueue;
+    if (!stats_pool->reserve (2)) {
+        printf ("record: reserve stats buffers failed\n");
+        return false;
+    }
+
+    SmartPtr<X3aAnalyzerRKiq> analyzer = new X3aAnalyzerRKiq (isp, iq_path);
+    analyzer->set_sensor_entity_name (BENCH_SENSOR_ENTITY_NAME);
+    analyzer->set_record_path (record_path);
+    analyzer->set_results_callback (&recorder);
+    analyzer->set_sync_mode (true);
+
+    if (analyzer->prepare_handlers () != XCAM_RETURN_NO_ERROR ||
+            analyzer->init (BENCH_WIDTH, BENCH_HEIGHT, BENCH_FRAMERATE) != XCAM_RETURN_NO_ERROR ||
+            analyzer->start () != XCAM_RETURN_NO_ERROR) {
+        printf ("record: start analyzer with %s failed\n", iq_path);
+        analyzer->deinit ();
+        return false;
+    }
+
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        SmartPtr<X3aIspStatistics> stats =
+            stats_pool->get_buffer (stats_pool).dynamic_cast_ptr<X3aIspStatistics> ();
+        XCAM_ASSERT (stats.ptr ());
+
+        bench_isp->set_frame (frame);
+        bench_scene_stats (frame, frames, bench_isp->get_exposure (frame),
+                           *(struct cifisp_stat_buffer *)stats->get_isp_stats ());
+        stats->set_sequence (frame);
+        stats->set_timestamp ((int64_t)frame * (int64_t)(1000000 / BENCH_FRAMERATE));
+
+        SmartPtr<X3aStats> x3a_stats = stats;
+        analyzer->push_3a_stats (x3a_stats);
+    }
+
+    analyzer->stop ();
+    analyzer->deinit ();
+
+    const BenchExposure &last = bench_isp->get_exposure (frames);
+    printf ("record: %u frames to %s, %u results, %u failed, last exposure %u lines gain %u\n",
+            frames, record_path, (uint32_t)results.size (), recorder.get_failed (),
+            last.exp_time, last.gain);
+    return recorder.get_failed () == 0;
+}
+
+static bool
+bench_read_output (const char *path, BenchResultList &results)
+{
+    X3aReplayOutputHeader header;
+    X3aReplayResult result;
+    bool ok = true;
+
+    FILE *fp = fopen (path, "rb");
+    if (!fp || fread (&header, sizeof (header), 1, fp) != 1 ||
+            header.magic != X3A_REPLAY_MAGIC || header.version != X3A_REPLAY_VERSION) {
+        printf ("read replay output %s failed\n", path);
+        if (fp)
+            fclose (fp);
+        return false;
+    }
+    while (fread (&result, sizeof (result), 1, fp) == 1) {
+        BenchResult entry;
+        entry.type = result.type;
+        entry.stats_frame = result.stats_frame;
+        entry.done_usec = result.done_usec;
+        entry.data.resize (result.size);
+        if (result.size && fread (&entry.data[0], result.size, 1, fp) != 1) {
+            printf ("replay output %s truncated\n", path);
+            ok = false;
+            break;
+        }
+        results.push_back (entry);
+    }
+    fclose (fp);
+    return ok;
+}
+
+static bool
+bench_compare (const BenchResultList &recorded, const BenchResultList &replayed)
+{
+    if (recorded.size () != replayed.size ()) {
+        printf ("replay gave %u results, the recording run %u\n",
+                (uint32_t)replayed.size (), (uint32_t)recorded.size ());
+        return false;
+    }
+    for (size_t i = 0; i < recorded.size (); i++) {
+        if (recorded[i].type != replayed[i].type || recorded[i].data != replayed[i].data) {
+            printf ("replay result %u (type %u) differs from the recording run\n",
+                    (uint32_t)i, replayed[i].type);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool
+bench_replay (
+    const char *iq_path, const char *record_path, const char *output_path,
+    uint32_t frames, bool parallel)
+{
+    static const char *names[XCAM_3A_HANDLER_COUNT] = {"ae", "awb", "af", "common"};
+    X3aReplayer replayer (iq_path);
+
+    replayer.set_parallel_analyze (parallel);
+    if (replayer.run (record_path, output_path, frames) != XCAM_RETURN_NO_ERROR) {
+        printf ("replay %s failed\n", record_path);
+        return false;
+    }
+
+    const X3aReplayReport &report = replayer.get_report ();
+    printf ("replay %-8s: %u frames, %u failed, %u params, %u exposures, %.1f frames/s, max %" PRId64 "us\n",
+            parallel ? "parallel" : "serial", report.frames, report.failed,
+            report.params_results, report.exposure_results,
+            report.total_usec ? report.frames * 1000000.0 / report.total_usec : 0.0,
+            report.max_usec);
+    for (int i = XCAM_3A_HANDLER_AE; i < XCAM_3A_HANDLER_COUNT; ++i) {
+        const X3aLatencyHistogram &h = report.handlers[i];
+        if (!h.count)
+            continue;
+        printf ("    %-6s %6" PRIu64 " runs, avg %6" PRId64 "us, max %6" PRId64 "us\n",
+                names[i], h.count, h.total_usec / (int64_t)h.count, h.max_usec);
+    }
+    return report.frames > 0 && report.failed == 0;
+}
+
+static int64_t
+bench_now_usec ()
+{
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000LL + now.tv_nsec / 1000;
+}
+
+// spends @cost_usec of cpu on the analyzer thread before the results go out
+class BenchCostReplayer
+    : public X3aReplayer
+{
+public:
+    explicit BenchCostReplayer (const char *iq_path, int64_t cost_usec)
+        : X3aReplayer (iq_path)
+        , _cost_usec (cost_usec)
+    {}
+
+    virtual void x3a_calculation_done (XAnalyzer *analyzer, X3aResultList &results) {
+        int64_t due = bench_now_usec () + _cost_usec;
+        while (bench_now_usec () < due);
+        X3aReplayer::x3a_calculation_done (analyzer, results);
+    }
+
+private:
+    XCAM_DEAD_COPY (BenchCostReplayer);
+
+private:
+    int64_t _cost_usec;
+};
+
+class BenchLoad
+{
+public:
+    explicit BenchLoad (uint32_t threads)
+        : _stop (false)
+    {
+        for (uint32_t i = 0; i < threads; i++) {
+            _threads.push_back (std::thread ([this] () {
+                volatile uint64_t spin = 0;
+                while (!_stop.load (std::memory_order_relaxed))
+                    ++spin;
+            }));
+        }
+    }
+    ~BenchLoad () {
+        _stop.store (true);
+        for (size_t i = 0; i < _threads.size (); i++)
+            _threads[i].join ();
+    }
+
+private:
+    XCAM_DEAD_COPY (BenchLoad);
+
+private:
+    std::atomic<bool>        _stop;
+    std::vector<std::thread> _threads;
+};
+
+static double
+bench_exposure_value (const BenchResult &result)
+{
+    const struct rkisp_exposure *exposure = (const struct rkisp_exposure *)&result.data[0];
+    return (double)exposure->coarse_integration_time * exposure->analog_gain;
+}
+
+// last exposure of the stats frames [@begin, @end)
+static double
+bench_settled_exposure (const BenchResultList &results, uint32_t begin, uint32_t end)
+{
+    double settled = 0.0;
+    for (size_t i = 0; i < results.size (); i++) {
+        if (results[i].type == X3aIspConfig::IspExposureParameters &&
+                results[i].stats_frame >= begin && results[i].stats_frame < end)
+            settled = bench_exposure_value (results[i]);
+    }
+    return settled;
+}
+
+// from the arrival of frame @begin to the first exposure close to @settled, -1 if none
+static int64_t
+bench_converge_usec (const BenchResultList &results, uint32_t begin, uint32_t end, double settled)
+{
+    for (size_t i = 0; i < results.size (); i++) {
+        if (results[i].type != X3aIspConfig::IspExposureParameters ||
+                results[i].stats_frame < begin || results[i].stats_frame >= end)
+            continue;
+        if (fabs (bench_exposure_value (results[i]) - settled) <= settled * BENCH_CONVERGED_RATIO)
+            return results[i].done_usec - begin * BENCH_FRAME_USEC;
+    }
+    return -1;
+}
+
+static bool
+bench_sweep (
+    const char *iq_path, const char *record_path, uint32_t frames,
+    const BenchResultList &serial, int64_t cost_usec)
+{
+    static const struct {
+        const char          *name;
+        XAnalyzerStatsPolicy policy;
+        uint32_t             interval;
+    } policies[] = {
+        {"all", XCAM_ANALYZER_STATS_ALL, 1},
+        {"latest", XCAM_ANALYZER_STATS_LATEST, 1},
+        {"every-2", XCAM_ANALYZER_STATS_EVERY_NTH, 2},
+    };
+    static const uint32_t loads[] = {0, 2, 4, 8, 16};
+    uint32_t cpus = (uint32_t)sysconf (_SC_NPROCESSORS_ONLN);
+    std::string output = std::string (record_path) + ".realtime.out";
+    double settled[BENCH_LIGHT_STEPS];
+    bool ok = true;
+
+    for (uint32_t step = 0; step < BENCH_LIGHT_STEPS; step++)
+        settled[step] = bench_settled_exposure (
+                            serial, bench_light_step (frames, step + 1), bench_light_step (frames, step + 2));
+
+    printf ("realtime replay at %.0f fps, %u cpus, %" PRId64 "us added per analyzed frame\n",
+            BENCH_FRAMERATE, cpus, cost_usec);
+    printf ("%-8s %5s %8s %9s %7s %7s %9s %9s", "policy", "load", "analyzed", "coalesced",
+            "skipped", "dropped", "age avg", "age max");
+    for (uint32_t step = 0; step < BENCH_LIGHT_STEPS; step++)
+        printf ("  step%u ae", step + 1);
+    printf ("\n");
+
+    for (size_t l = 0; l < sizeof (loads) / sizeof (loads[0]); l++) {
+        BenchLoad load (loads[l] * cpus);
+
+        for (size_t p = 0; p < sizeof (policies) / sizeof (policies[0]); p++) {
+            BenchCostReplayer replayer (iq_path, cost_usec);
+            BenchResultList results;
+
+            replayer.set_realtime (true, policies[p].policy, policies[p].interval);
+            if (replayer.run (record_path, output.c_str (), frames) != XCAM_RETURN_NO_ERROR ||
+                    !bench_read_output (output.c_str (), results)) {
+                printf ("realtime replay %s failed\n", policies[p].name);
+                ok = false;
+                continue;
+            }
+
+            const X3aReplayReport &report = replayer.get_report ();
+            printf ("%-8s %4ux %8" PRIu64 " %9" PRIu64 " %7" PRIu64 " %7u %7.1fms %7.1fms",
+                    policies[p].name, loads[l], report.analyzer.analyzed,
+                    report.analyzer.coalesced, report.analyzer.dropped, report.stats_dropped,
+                    report.aged_frames ? report.total_age_usec / 1000.0 / report.aged_frames : 0.0,
+                    report.max_age_usec / 1000.0);
+            for (uint32_t step = 0; step < BENCH_LIGHT_STEPS; step++) {
+                int64_t usec = bench_converge_usec (
+                                   results, bench_light_step (frames, step + 1),
+                                   bench_light_step (frames, step + 2), settled[step]);
+                if (usec < 0)
+                    printf ("  %8s", "-");
+                else
+                    printf ("  %6.1fms", usec / 1000.0);
+            }
+            printf ("\n");
+            ok = ok && report.failed == 0;
+        }
+    }
+    return ok;
+}
+
+static void
+print_help (const char *bin_name)
+{
+    printf ("Usage: %s -i iq.xml [options]\n"
+            "\t -i iq        iq file of the sensor\n"
+            "\t -r record    replay this recording instead of recording a synthetic scene\n"
+            "\t -w record    where the synthetic scene is recorded, default %s\n"
+            "\t -n frames    frames to record or replay, default %d, 0 replays all\n"
+            "\t -o output    write the results of the serial replay to output\n"
+            "\t -l           also replay in realtime per stats policy and cpu load\n"
+            "\t -c usec      cpu cost added per analyzed frame in realtime replays\n"
+            "\t -h           help\n",
+            bin_name, BENCH_DEFAULT_RECORD, BENCH_DEFAULT_FRAMES);
+}
+
+int main (int argc, char *argv[])
+{
+    const char *iq_path = NULL;
+    const char *record_path = NULL;
+    const char *write_path = BENCH_DEFAULT_RECORD;
+    const char *output_path = NULL;
+    uint32_t frames = BENCH_DEFAULT_FRAMES;
+    bool sweep = false;
+    int64_t cost_usec = -1;
+    BenchResultList recorded, replayed;
+    bool ok = true;
+    int opt;
+
+    while ((opt = getopt (argc, argv, "i:r:w:n:o:lc:h")) != -1) {
+        switch (opt) {
+        case 'i':
+            iq_path = optarg;
+            break;
+        case 'r':
+            record_path = optarg;
+            break;
+        case 'w':
+            write_path = optarg;
+            break;
+        case 'n':
+            frames = strtoul (optarg, NULL, 0);
+            break;
+        case 'o':
+            output_path = optarg;
+            break;
+        case 'l':
+            sweep = true;
+            break;
+        case 'c':
+            cost_usec = strtoll (optarg, NULL, 0);
+            break;
+        default:
+            print_help (argv[0]);
+            return opt == 'h' ? 0 : -1;
+        }
+    }
+    if (!iq_path) {
+        print_help (argv[0]);
+        return -1;
+    }
+    if (sweep && record_path) {
+        printf ("-l needs the light steps of the synthetic scene, it can't be used with -r\n");
+        return -1;
+    }
+
+    SmartPtr<X3aHandlerManager> handlers = X3aHandlerManager::instance ();
+    printf ("algorithms: ae %s, awb %s, af %s\n",
+            handlers->get_ae_handler_desc () ? "loaded" : "missing",
+            handlers->get_awb_handler_desc () ? "loaded" : "missing",
+            handlers->get_af_handler_desc () ? "loaded" : "missing");
+    if (cost_usec < 0)
+        cost_usec = handlers->get_ae_handler_desc () ? 0 : BENCH_EMULATED_COST_USEC;
+
+    if (!record_path) {
+        if (!frames) {
+            printf ("recording needs a frame count\n");
+            return -1;
+        }
+        record_path = write_path;
+        ok = bench_record (iq_path, record_path, frames, recorded);
+    }
+
+    // the serial run always writes an output, the comparison needs it
+    std::string serial_output = output_path ? output_path : std::string (record_path) + ".out";
+    std::string parallel_output = std::string (record_path) + ".parallel.out";
+
+    ok = ok && bench_replay (iq_path, record_path, serial_output.c_str (), frames, false);
+    ok = ok && bench_replay (iq_path, record_path, parallel_output.c_str (), frames, true);
+
+    if (ok && !recorded.empty ()) {
+        BenchResultList parallel;
+        ok = bench_read_output (serial_output.c_str (), replayed) &&
+             bench_read_output (parallel_output.c_str (), parallel) &&
+             bench_compare (recorded, replayed) &&
+             bench_compare (recorded, parallel);
+    }
+
+    if (ok && sweep)
+        ok = bench_sweep (iq_path, record_path, frames, replayed, cost_usec);
+
+    printf ("x3a replay bench %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,201 @@
+/*
+ * xcam_log_bench.cpp - cost of disabled, recorded and dropped log calls
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Times XCAM_LOG_* calls in three states of the log backend:
+ *   - disabled, the level of the call is above the cached log level
+ *   - enabled, the call is recorded into the per-thread ring and written by
+ *     the log thread; bursts stay below the ring size and the ring is
+ *     flushed between them. Errors, written synchronously, for comparison.
+ *   - overflow, one burst of many times the ring size without flushing, the
+ *     records which do not fit are dropped
+ * and checks the recorded/dropped counters against the log file: every
+ * recorded line is written once and in order, and the dropped ones are
+ * reported by the log thread.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include <base/xcam_common.h>
+
+#define LOG_BENCH_DISABLED_CALLS   10000000
+#define LOG_BENCH_BURST            64
+#define LOG_BENCH_BURSTS           2000
+#define LOG_BENCH_SYNC_CALLS       20000
+// many times the XCAM_LOG_RING_SLOTS of a thread ring
+#define LOG_BENCH_OVERFLOW_CALLS   4096
+
+static int64_t
+bench_now_ns ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static bool
+bench_disabled ()
+{
+    setenv ("persist_camera_engine_log", "0", 1);
+    if (xcam_reload_log_level () != ERROR_LEVEL) {
+        printf ("disabled: log level not reset\n");
+        return false;
+    }
+
+    uint64_t recorded, dropped, recorded_end, dropped_end;
+    xcam_log_get_stats (&recorded, &dropped);
+
+    int64_t start = bench_now_ns ();
+    for (uint32_t i = 0; i < LOG_BENCH_DISABLED_CALLS; i++)
+        XCAM_LOG_INFO ("log bench disabled %u %s %f", i, "string", i * 0.5);
+    int64_t elapsed = bench_now_ns () - start;
+
+    xcam_log_get_stats (&recorded_end, &dropped_end);
+    printf ("disabled: %u calls, %6.2f ns per call\n",
+            LOG_BENCH_DISABLED_CALLS, (double)elapsed / LOG_BENCH_DISABLED_CALLS);
+    if (recorded_end != recorded || dropped_end != dropped) {
+        printf ("disabled: %llu calls recorded\n", (unsigned long long)(recorded_end - recorded));
+        return false;
+    }
+    return true;
+}
+
+static bool
+bench_enabled ()
+{
+    uint64_t recorded, dropped, recorded_end, dropped_end;
+    int64_t elapsed = 0;
+
+    xcam_log_get_stats (&recorded, &dropped);
+    for (uint32_t burst = 0; burst < LOG_BENCH_BURSTS; burst++) {
+        int64_t start = bench_now_ns ();
+        for (uint32_t i = 0; i < LOG_BENCH_BURST; i++)
+            XCAM_LOG_INFO ("log bench enabled %u %s %f", i, "string", i * 0.5);
+        elapsed += bench_now_ns () - start;
+        xcam_log_flush ();
+    }
+    xcam_log_get_stats (&recorded_end, &dropped_end);
+
+    printf ("enabled:  %u calls, %6.2f ns per call, recorded into the ring\n",
+            LOG_BENCH_BURST * LOG_BENCH_BURSTS, (double)elapsed / (LOG_BENCH_BURST * LOG_BENCH_BURSTS));
+    if (recorded_end - recorded != LOG_BENCH_BURST * LOG_BENCH_BURSTS || dropped_end != dropped) {
+        printf ("enabled: %llu recorded, %llu dropped\n",
+                (unsigned long long)(recorded_end - recorded),
+                (unsigned long long)(dropped_end - dropped));
+        return false;
+    }
+
+    int64_t start = bench_now_ns ();
+    for (uint32_t i = 0; i < LOG_BENCH_SYNC_CALLS; i++)
+        XCAM_LOG_ERROR ("log bench error %u %s %f", i, "string", i * 0.5);
+    elapsed = bench_now_ns () - start;
+    printf ("error:    %u calls, %6.2f ns per call, written synchronously\n",
+            LOG_BENCH_SYNC_CALLS, (double)elapsed / LOG_BENCH_SYNC_CALLS);
+    return true;
+}
+
+// a full ring drops records, the rest is written in order
+static bool
+bench_overflow (const char *path)
+{
+    uint64_t recorded, dropped, recorded_end, dropped_end;
+    bool ok = true;
+
+    xcam_log_get_stats (&recorded, &dropped);
+    int64_t start = bench_now_ns ();
+    for (uint32_t i = 0; i < LOG_BENCH_OVERFLOW_CALLS; i++)
+        XCAM_LOG_INFO ("log bench overflow %u %s %f", i, "string", i * 0.5);
+    int64_t elapsed = bench_now_ns () - start;
+    xcam_log_flush ();
+    xcam_log_get_stats (&recorded_end, &dropped_end);
+    recorded = recorded_end - recorded;
+    dropped = dropped_end - dropped;
+
+    printf ("overflow: %u calls, %6.2f ns per call, %llu recorded, %llu dropped\n",
+            LOG_BENCH_OVERFLOW_CALLS, (double)elapsed / LOG_BENCH_OVERFLOW_CALLS,
+            (unsigned long long)recorded, (unsigned long long)dropped);
+    if (recorded + dropped != LOG_BENCH_OVERFLOW_CALLS || !dropped) {
+        printf ("overflow: recorded and dropped do not add up, or nothing dropped\n");
+        ok = false;
+    }
+
+    FILE *fp = fopen (path, "r");
+    if (!fp) {
+        printf ("overflow: open %s failed\n", path);
+        return false;
+    }
+
+    char line[XCAM_MAX_STR_SIZE];
+    uint64_t written = 0, reported = 0;
+    int64_t last = -1;
+    while (fgets (line, sizeof (line), fp)) {
+        const char *text = strstr (line, "log bench overflow ");
+        unsigned int count;
+        if (text) {
+            int64_t seq = strtol (text + strlen ("log bench overflow "), NULL, 10);
+            if (seq <= last) {
+                printf ("overflow: record %lld written after %lld\n", (long long)seq, (long long)last);
+                ok = false;
+            }
+            last = seq;
+            ++written;
+        } else if (sscanf (line, "XCAM WARNING: %u log records dropped", &count) == 1) {
+            reported += count;
+        }
+    }
+    fclose (fp);
+
+    if (written != recorded || reported != dropped) {
+        printf ("overflow: %llu lines written, %llu drops reported\n",
+                (unsigned long long)written, (unsigned long long)reported);
+        ok = false;
+    }
+    return ok;
+}
+
+int main (int argc, char *argv[])
+{
+    char path[] = "/tmp/xcam_log_bench_XXXXXX";
+    bool ok = true;
+
+    XCAM_UNUSED (argc);
+    XCAM_UNUSED (argv);
+
+    int fd = mkstemp (path);
+    if (fd < 0) {
+        printf ("create log file failed\n");
+        return -1;
+    }
+    close (fd);
+
+    ok &= bench_disabled ();
+
+    // a log file enables every level
+    xcam_set_log (path);
+    ok &= bench_enabled ();
+    ok &= bench_overflow (path);
+    unlink (path);
+
+    printf ("xcam log bench %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,279 @@
+/*
+ * xmeta_result_bench.cpp - result metadata template vs CameraMetadata update
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Writes the per frame result metadata of the 3a handlers and state
+ * machines into
+ *   - a CameraMetadata emptied in place every frame and filled through
+ *     CameraMetadata::update, the way XmetaResult did before the template
+ *   - an XmetaResult, which starts every frame from XmetaTemplate and
+ *     overwrites the entries by index
+ * and compares the time per frame. After every frame both buffers must
+ * hold the same entries with the same data, including a tag outside of
+ * the template and the AF tags which are only written every other frame.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "x3a_meta_result.h"
+
+using namespace XCam;
+
+#define BENCH_FRAMES            20000
+#define BENCH_MAX_COUNT         68
+
+struct BenchWrite {
+    uint32_t tag;
+    uint32_t count;
+    // only written on even frames
+    bool     every_other;
+};
+
+// roughly in the order AiqAeHandler, AiqAwbHandler, AiqAfHandler,
+// AiqCommonHandler and the state machines write them
+static const BenchWrite bench_writes[] = {
+    {ANDROID_STATISTICS_SCENE_FLICKER, 1, false},
+    {ANDROID_SENSOR_EXPOSURE_TIME, 1, false},
+    {ANDROID_SENSOR_SENSITIVITY, 1, false},
+    {ANDROID_SENSOR_FRAME_DURATION, 1, false},
+    {ANDROID_SENSOR_INFO_EXPOSURE_TIME_RANGE, 2, false},
+    {ANDROID_SENSOR_INFO_SENSITIVITY_RANGE, 2, false},
+    {ANDROID_CONTROL_AE_REGIONS, 5, false},
+    {ANDROID_CONTROL_AE_EXPOSURE_COMPENSATION, 1, false},
+    {ANDROID_CONTROL_AE_TARGET_FPS_RANGE, 2, false},
+    {ANDROID_CONTROL_AE_MODE, 1, false},
+    {ANDROID_CONTROL_AE_LOCK, 1, false},
+    {ANDROID_CONTROL_AE_ANTIBANDING_MODE, 1, false},
+    {ANDROID_CONTROL_AE_PRECAPTURE_TRIGGER, 1, false},
+    {ANDROID_SENSOR_TEST_PATTERN_MODE, 1, false},
+    {ANDROID_CONTROL_AWB_REGIONS, 5, false},
+    {ANDROID_COLOR_CORRECTION_GAINS, 4, false},
+    {ANDROID_COLOR_CORRECTION_TRANSFORM, 9, false},
+    {ANDROID_COLOR_CORRECTION_MODE, 1, false},
+    {ANDROID_COLOR_CORRECTION_ABERRATION_MODE, 1, false},
+    {ANDROID_CONTROL_AWB_MODE, 1, false},
+    {ANDROID_CONTROL_AWB_LOCK, 1, false},
+    {ANDROID_CONTROL_AF_REGIONS, 5, true},
+    {ANDROID_LENS_FOCUS_DISTANCE, 1, true},
+    {ANDROID_CONTROL_AF_MODE, 1, true},
+    {ANDROID_CONTROL_AF_TRIGGER, 1, true},
+    {ANDROID_TONEMAP_MODE, 1, false},
+    {ANDROID_TONEMAP_CURVE_RED, BENCH_MAX_COUNT, false},
+    {ANDROID_TONEMAP_CURVE_GREEN, BENCH_MAX_COUNT, false},
+    {ANDROID_TONEMAP_CURVE_BLUE, BENCH_MAX_COUNT, false},
+    // state machines, the state tags are written twice per frame
+    {ANDROID_CONTROL_AE_STATE, 1, false},
+    {ANDROID_CONTROL_AE_STATE, 1, false},
+    {ANDROID_CONTROL_AWB_STATE, 1, false},
+    {ANDROID_CONTROL_AWB_STATE, 1, false},
+    {ANDROID_CONTROL_AF_STATE, 1, true},
+    {ANDROID_LENS_STATE, 1, true},
+    // not part of the template, goes through CameraMetadata in both
+    {ANDROID_SENSOR_ROLLING_SHUTTER_SKEW, 1, false},
+};
+
+#define BENCH_WRITE_COUNT (sizeof (bench_writes) / sizeof (bench_writes[0]))
+
+union BenchData {
+    uint8_t                    u8[BENCH_MAX_COUNT];
+    int32_t                    i32[BENCH_MAX_COUNT];
+    float                      f[BENCH_MAX_COUNT];
+    int64_t                    i64[BENCH_MAX_COUNT];
+    camera_metadata_rational_t r[BENCH_MAX_COUNT];
+};
+
+static int64_t
+bench_now_ns ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// new values for every write of @frame
+static void
+bench_fill (BenchData *data, uint32_t frame)
+{
+    for (uint32_t w = 0; w < BENCH_WRITE_COUNT; w++) {
+        for (uint32_t i = 0; i < BENCH_MAX_COUNT; i++) {
+            uint32_t v = frame * 31 + w * 7 + i;
+            data[w].u8[i] = v;
+            data[w].i32[i] = v;
+            data[w].f[i] = v * 0.25f;
+            data[w].i64[i] = (int64_t)v * 1000000;
+            data[w].r[i].numerator = v;
+            data[w].r[i].denominator = 128;
+        }
+    }
+}
+
+// @Sink is CameraMetadata or XmetaResult, both have the same update overloads
+template<class Sink>
+static bool
+bench_write_frame (Sink &sink, const int *types, const BenchData *data, uint32_t frame)
+{
+    bool ok = true;
+
+    for (uint32_t i = 0; i < BENCH_WRITE_COUNT; i++) {
+        const BenchWrite &write = bench_writes[i];
+        if (write.every_other && (frame & 1))
+            continue;
+        switch (types[i]) {
+        case TYPE_BYTE:
+            ok &= sink.update (write.tag, data[i].u8, write.count) == 0;
+            break;
+        case TYPE_INT32:
+            ok &= sink.update (write.tag, data[i].i32, write.count) == 0;
+            break;
+        case TYPE_FLOAT:
+            ok &= sink.update (write.tag, data[i].f, write.count) == 0;
+            break;
+        case TYPE_INT64:
+            ok &= sink.update (write.tag, data[i].i64, write.count) == 0;
+            break;
+        case TYPE_RATIONAL:
+            ok &= sink.update (write.tag, data[i].r, write.count) == 0;
+            break;
+        default:
+            ok = false;
+            break;
+        }
+    }
+    return ok;
+}
+
+// XmetaResult as it was before the template
+class BenchLegacyResult
+{
+public:
+    explicit BenchLegacyResult ()
+        : _metadata (allocate_camera_metadata (DEFAULT_ENTRY_CAP, DEFAULT_DATA_CAP))
+    {}
+
+    void reset () {
+        camera_metadata_t *buffer = _metadata.release ();
+        camera_metadata_t *placed = NULL;
+        if (buffer)
+            placed = place_camera_metadata (
+                         buffer, get_camera_metadata_size (buffer),
+                         get_camera_metadata_entry_capacity (buffer),
+                         get_camera_metadata_data_capacity (buffer));
+        if (!placed) {
+            if (buffer)
+                free_camera_metadata (buffer);
+            placed = allocate_camera_metadata (DEFAULT_ENTRY_CAP, DEFAULT_DATA_CAP);
+        }
+        _metadata.acquire (placed);
+    }
+
+    CameraMetadata &get_metadata () {
+        return _metadata;
+    }
+
+private:
+    CameraMetadata _metadata;
+};
+
+class BenchTemplateResult
+    : public XmetaResult
+{
+public:
+    void reset () {
+        XmetaResult::reset (XCAM_IMAGE_PROCESS_ALWAYS);
+    }
+};
+
+static bool
+bench_compare (CameraMetadata &legacy, CameraMetadata &result, uint32_t frame)
+{
+    const camera_metadata_t *expected = legacy.getAndLock ();
+    const camera_metadata_t *actual = result.getAndLock ();
+    size_t count = get_camera_metadata_entry_count (expected);
+    bool ok = true;
+
+    if (get_camera_metadata_entry_count (actual) != count) {
+        printf ("frame %u: %zu entries, expected %zu\n",
+                frame, get_camera_metadata_entry_count (actual), count);
+        ok = false;
+    }
+    for (size_t i = 0; ok && i < count; i++) {
+        camera_metadata_ro_entry_t want, got;
+        get_camera_metadata_ro_entry (expected, i, &want);
+        if (find_camera_metadata_ro_entry (actual, want.tag, &got) != 0 ||
+                got.type != want.type || got.count != want.count ||
+                memcmp (got.data.u8, want.data.u8, want.count * camera_metadata_type_size[want.type])) {
+            printf ("frame %u: tag 0x%x differs\n", frame, want.tag);
+            ok = false;
+        }
+    }
+
+    result.unlock (actual);
+    legacy.unlock (expected);
+    return ok;
+}
+
+int main (int argc, char *argv[])
+{
+    uint32_t frames = BENCH_FRAMES;
+    int types[BENCH_WRITE_COUNT];
+    BenchData data[BENCH_WRITE_COUNT];
+    BenchLegacyResult legacy;
+    BenchTemplateResult result;
+    int64_t legacy_ns = 0, template_ns = 0;
+    bool ok = true;
+
+    if (argc > 1)
+        frames = strtoul (argv[1], NULL, 0);
+
+    if (!XmetaTemplate::instance ()->get_size ()) {
+        printf ("no result metadata template\n");
+        return -1;
+    }
+    for (uint32_t i = 0; i < BENCH_WRITE_COUNT; i++)
+        types[i] = get_camera_metadata_tag_type (bench_writes[i].tag);
+
+    for (uint32_t frame = 0; frame < frames && ok; frame++) {
+        bench_fill (data, frame);
+
+        int64_t start = bench_now_ns ();
+        legacy.reset ();
+        ok &= bench_write_frame (legacy.get_metadata (), types, data, frame);
+        int64_t middle = bench_now_ns ();
+        result.reset ();
+        ok &= bench_write_frame (result, types, data, frame);
+        result.finish ();
+        int64_t end = bench_now_ns ();
+
+        legacy_ns += middle - start;
+        template_ns += end - middle;
+        ok = ok && bench_compare (legacy.get_metadata (), *result.get_metadata_result (), frame);
+    }
+
+    if (frames) {
+        printf ("%u frames, %u writes per frame\n", frames, (uint32_t)BENCH_WRITE_COUNT);
+        printf ("CameraMetadata update: %8.0f ns/frame\n", (double)legacy_ns / frames);
+        printf ("XmetaTemplate:         %8.0f ns/frame, %.2fx\n",
+                (double)template_ns / frames, (double)legacy_ns / template_ns);
+    }
+    printf ("xmeta result bench %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : -1;
+}
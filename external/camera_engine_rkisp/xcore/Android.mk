@@ -5,6 +5,7 @@ include $(CLEAR_VARS)
 
 LOCAL_SRC_FILES +=\
 	xcam_common.cpp \
+	xcam_log.cpp \
 
 LOCAL_CFLAGS += -Wno-error=unused-function -Wno-array-bounds
 LOCAL_CFLAGS += -DLINUX  -D_FILE_OFFSET_BITS=64 -DHAS_STDINT_H -DENABLE_ASSERTa
@@ -45,6 +46,7 @@ LOCAL_SRC_FILES +=\
 	analyzer_loader.cpp \
 	buffer_pool.cpp \
 	calibration_parser.cpp \
+	copy_counter.cpp \
 	device_manager.cpp \
 	dynamic_analyzer.cpp \
 	dynamic_analyzer_loader.cpp \
@@ -75,11 +77,14 @@ LOCAL_SRC_FILES +=\
 	x3a_analyzer_simple.cpp \
 	x3a_image_process_center.cpp \
 	x3a_result.cpp \
+	x3a_result_arena.cpp \
 	x3a_result_factory.cpp \
+	x3a_stats_grid.cpp \
 	x3a_stats_pool.cpp \
 	xcam_analyzer.cpp \
 	xcam_buffer.cpp \
 	xcam_thread.cpp \
+	xcam_trace.cpp \
 	xcam_utils.cpp \
 	dynamic_algorithms_libs_loader.cpp
 
@@ -79,6 +79,27 @@ const char *xcam_fourcc_to_string (uint32_t fourcc);
 void xcam_set_log (const char* file_name);
 void xcam_print_log (int level, const char* format, ...);
 
+/*
+  * log level is cached, it is (re)loaded from the setting
+  * (persist.vendor.rkisp.log on android, persist_camera_engine_log on linux)
+  * on first use, by xcam_reload_log_level, and periodically by the log thread.
+  */
+#define XCAM_LOG_LEVEL_UNSET (-1)
+extern int xcam_log_level_cache;
+
+int xcam_reload_log_level ();
+// wait until all recorded logs are written out
+void xcam_log_flush ();
+void xcam_log_get_stats (uint64_t *recorded, uint64_t *dropped);
+
+static inline int
+xcam_log_level_enabled (int level) {
+    int cached = __atomic_load_n (&xcam_log_level_cache, __ATOMIC_RELAXED);
+    if (cached == XCAM_LOG_LEVEL_UNSET)
+        cached = xcam_reload_log_level ();
+    return level <= cached;
+}
+
 static inline uint32_t
 xcam_ceil (uint32_t value, const uint32_t align) {
     return (value + align - 1) / align * align;
@@ -31,15 +31,22 @@ enum LOG_LEVEL {
     DEBUG_LEVEL
 };
 
+/* checked against the cached level before any argument is evaluated */
+#define XCAM_LOG_PRINT(level, format, ...)                          \
+    do {                                                            \
+        if (xcam_log_level_enabled (level))                         \
+            xcam_print_log (level, format, ## __VA_ARGS__);         \
+    } while (0)
+
 #ifndef XCAM_LOG_ERROR
 #define XCAM_LOG_ERROR(format, ...)    \
-    xcam_print_log (ERROR_LEVEL, "XCAM ERROR %s:%d: " format "\n", basename((char*)__FILE__), __LINE__, ## __VA_ARGS__)
+    XCAM_LOG_PRINT (ERROR_LEVEL, "XCAM ERROR %s:%d: " format "\n", basename((char*)__FILE__), __LINE__, ## __VA_ARGS__)
 #endif
 
 #ifdef WARNING
 #ifndef XCAM_LOG_WARNING
 #define XCAM_LOG_WARNING(format, ...)   \
-    xcam_print_log (WARNING_LEVEL, "XCAM WARNING %s:%d: " format "\n", basename((char*)__FILE__), __LINE__, ## __VA_ARGS__)
+    XCAM_LOG_PRINT (WARNING_LEVEL, "XCAM WARNING %s:%d: " format "\n", basename((char*)__FILE__), __LINE__, ## __VA_ARGS__)
 #endif
 #else
 #define XCAM_LOG_WARNING(...)
@@ -47,14 +54,14 @@ enum LOG_LEVEL {
 
 #ifndef XCAM_LOG_INFO
 #define XCAM_LOG_INFO(format, ...)   \
-    xcam_print_log (INFO_LEVEL, "XCAM INFO (%d) %s:%d: " format "\n", getpid(), basename((char*)__FILE__), __LINE__, ## __VA_ARGS__)
+    XCAM_LOG_PRINT (INFO_LEVEL, "XCAM INFO (%d) %s:%d: " format "\n", getpid(), basename((char*)__FILE__), __LINE__, ## __VA_ARGS__)
 #endif
 
 #define VERBOSE
 #ifdef VERBOSE
 #ifndef XCAM_LOG_VERBOSE
 #define XCAM_LOG_VERBOSE(format, ...)   \
-    xcam_print_log (VERBOSE_LEVEL, "XCAM VERBOSE (%d) %s:%d: " format "\n", getpid(), basename((char*)__FILE__), __LINE__, ## __VA_ARGS__)
+    XCAM_LOG_PRINT (VERBOSE_LEVEL, "XCAM VERBOSE (%d) %s:%d: " format "\n", getpid(), basename((char*)__FILE__), __LINE__, ## __VA_ARGS__)
 #endif
 #else
 #define XCAM_LOG_VERBOSE(...)
@@ -64,7 +71,7 @@ enum LOG_LEVEL {
 #ifdef DEBUG
 #ifndef XCAM_LOG_DEBUG
 #define XCAM_LOG_DEBUG(format, ...)   \
-      xcam_print_log (DEBUG_LEVEL, "XCAM DEBUG %s:%d: " format "\n", basename((char*)__FILE__), __LINE__, ## __VA_ARGS__)
+    XCAM_LOG_PRINT (DEBUG_LEVEL, "XCAM DEBUG %s:%d: " format "\n", basename((char*)__FILE__), __LINE__, ## __VA_ARGS__)
 #endif
 #else
 #define XCAM_LOG_DEBUG(...)
@@ -25,12 +25,16 @@ namespace XCam {
 BufferProxy::BufferProxy (const VideoBufferInfo &info, const SmartPtr<BufferData> &data)
     : VideoBuffer (info)
     , _data (data)
+    , _recycle_pool (NULL)
+    , _free_next (NULL)
 {
     XCAM_ASSERT (data.ptr ());
 }
 
 BufferProxy::BufferProxy (const SmartPtr<BufferData> &data)
     : _data (data)
+    , _recycle_pool (NULL)
+    , _free_next (NULL)
 {
     XCAM_ASSERT (data.ptr ());
 }
@@ -64,15 +68,43 @@ BufferProxy::get_fd ()
     return _data->get_fd ();
 }
 
+bool
+BufferProxy::recycle ()
+{
+    if (!_recycle_pool)
+        return false;
+
+    // keep the pool alive until this proxy is back in its free list
+    SmartPtr<BufferPool> pool = _pool;
+    _pool.release ();
+
+    set_parent (NULL);
+    clear_attached_buffers ();
+    clear_all_metadata ();
+    set_timestamp (InvalidTimestamp);
+    set_sequence (0);
+
+    _recycle_pool->recycle (this);
+    return true;
+}
+
 BufferPool::BufferPool ()
     : _allocated_num (0)
     , _max_count (0)
     , _started (false)
+    , _recycle_proxy (false)
+    , _free_proxies (NULL)
+    , _free_proxy_num (0)
 {
 }
 
 BufferPool::~BufferPool ()
 {
+    while (_free_proxies) {
+        BufferProxy *proxy = _free_proxies;
+        _free_proxies = proxy->_free_next;
+        delete proxy;
+    }
 }
 
 bool
@@ -109,7 +141,23 @@ BufferPool::reserve (uint32_t max_count)
         SmartPtr<BufferData> new_data = allocate_data (_buffer_info);
         if (!new_data.ptr ())
             break;
-        _buf_list.push (new_data);
+        if (!_recycle_proxy) {
+            _buf_list.push (new_data);
+            continue;
+        }
+
+        SmartPtr<BufferProxy> proxy = create_buffer_from_data (new_data);
+        if (!proxy.ptr ())
+            break;
+        // free proxies are owned by the pool without any reference
+        BufferProxy *free_proxy = proxy.ptr ();
+        free_proxy->ref ();
+        proxy.release ();
+        free_proxy->unref ();
+        free_proxy->_recycle_pool = this;
+        free_proxy->_free_next = _free_proxies;
+        _free_proxies = free_proxy;
+        ++_free_proxy_num;
     }
 
     XCAM_FAIL_RETURN (
@@ -143,6 +191,18 @@ BufferPool::add_data_unsafe (const SmartPtr<BufferData> &data)
 
 SmartPtr<VideoBuffer>
 BufferPool::get_buffer (const SmartPtr<BufferPool> &self)
+{
+    return get_buffer (self, true);
+}
+
+SmartPtr<VideoBuffer>
+BufferPool::try_get_buffer (const SmartPtr<BufferPool> &self)
+{
+    return get_buffer (self, false);
+}
+
+SmartPtr<VideoBuffer>
+BufferPool::get_buffer (const SmartPtr<BufferPool> &self, bool wait)
 {
     SmartPtr<BufferProxy> ret_buf;
     SmartPtr<BufferData> data;
@@ -160,7 +220,15 @@ BufferPool::get_buffer (const SmartPtr<BufferPool> &self)
         NULL,
         "BufferPool get_buffer failed since parameter<self> not this");
 
-    data = _buf_list.pop ();
+    if (_recycle_proxy)
+        return get_recycled_buffer (self, wait);
+
+    bool waited = false;
+    data = _buf_list.pop (0);
+    if (!data.ptr () && wait) {
+        waited = true;
+        data = _buf_list.pop ();
+    }
     if (!data.ptr ()) {
         XCAM_LOG_DEBUG ("BufferPool failed to get buffer");
         return NULL;
@@ -168,9 +236,49 @@ BufferPool::get_buffer (const SmartPtr<BufferPool> &self)
     ret_buf = create_buffer_from_data (data);
     ret_buf->set_buf_pool (self);
 
+    SmartLock lock (_mutex);
+    update_stats_unsafe (waited);
     return ret_buf;
 }
 
+SmartPtr<VideoBuffer>
+BufferPool::get_recycled_buffer (const SmartPtr<BufferPool> &self, bool wait)
+{
+    BufferProxy *proxy = NULL;
+
+    {
+        SmartLock lock (_mutex);
+        bool waited = !_free_proxies;
+        while (wait && _started && !_free_proxies)
+            _free_proxy_cond.wait (_mutex);
+
+        if (!_free_proxies) {
+            XCAM_LOG_DEBUG ("BufferPool failed to get buffer");
+            return NULL;
+        }
+        proxy = _free_proxies;
+        _free_proxies = proxy->_free_next;
+        proxy->_free_next = NULL;
+        --_free_proxy_num;
+        update_stats_unsafe (waited);
+    }
+
+    proxy->set_buf_pool (self);
+    return proxy;
+}
+
+void
+BufferPool::update_stats_unsafe (bool waited)
+{
+    if (waited)
+        ++_stats.waits;
+    else
+        ++_stats.hits;
+    ++_stats.in_use;
+    if (_stats.in_use > _stats.high_water)
+        _stats.high_water = _stats.in_use;
+}
+
 SmartPtr<VideoBuffer>
 BufferPool::get_buffer ()
 {
@@ -183,6 +291,7 @@ BufferPool::stop ()
     {
         SmartLock lock (_mutex);
         _started = false;
+        _free_proxy_cond.broadcast ();
     }
     _buf_list.pause_pop ();
 }
@@ -194,10 +303,24 @@ BufferPool::release (SmartPtr<BufferData> &data)
         SmartLock lock (_mutex);
         if (!_started)
             return;
+        if (_stats.in_use)
+            --_stats.in_use;
     }
     _buf_list.push (data);
 }
 
+void
+BufferPool::recycle (BufferProxy *proxy)
+{
+    SmartLock lock (_mutex);
+    proxy->_free_next = _free_proxies;
+    _free_proxies = proxy;
+    ++_free_proxy_num;
+    if (_stats.in_use)
+        --_stats.in_use;
+    _free_proxy_cond.signal ();
+}
+
 bool
 BufferPool::fixate_video_info (VideoBufferInfo &info)
 {
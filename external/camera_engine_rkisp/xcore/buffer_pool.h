@@ -46,9 +46,17 @@ private:
     XCAM_DEAD_COPY (BufferData);
 };
 
+/*
+ * BufferProxy is ref counted by itself (RefObj), SmartPtr does not need
+ * to allocate a RefCount for it. Proxies of a recycling pool are returned
+ * to the pool when the last reference is gone instead of being deleted.
+ */
 class BufferProxy
     : public VideoBuffer
+    , public RefObj
 {
+    friend class BufferPool;
+
 public:
     explicit BufferProxy (const VideoBufferInfo &info, const SmartPtr<BufferData> &data);
     explicit BufferProxy (const SmartPtr<BufferData> &data);
@@ -63,6 +71,9 @@ public:
     virtual bool unmap ();
     virtual int get_fd();
 
+    // derived from RefObj
+    virtual bool recycle ();
+
 protected:
     SmartPtr<BufferData> &get_buffer_data () {
         return _data;
@@ -74,6 +85,22 @@ private:
 private:
     SmartPtr<BufferData>       _data;
     SmartPtr<BufferPool>       _pool;
+    BufferPool                *_recycle_pool;
+    BufferProxy               *_free_next;
+};
+
+struct BufferPoolStats {
+    uint64_t    hits;       // get_buffer served without waiting
+    uint64_t    waits;      // get_buffer had to wait for a release
+    uint32_t    in_use;
+    uint32_t    high_water; // max buffers in use at the same time
+
+    BufferPoolStats ()
+        : hits (0)
+        , waits (0)
+        , in_use (0)
+        , high_water (0)
+    {}
 };
 
 class BufferPool
@@ -86,9 +113,17 @@ public:
     virtual ~BufferPool ();
 
     bool set_video_info (const VideoBufferInfo &info);
+    // **** MUST be set before reserve ****
+    // proxies are created once in reserve and recycled, get_buffer and
+    // release don't allocate any more
+    void set_proxy_recycle (bool enable) {
+        _recycle_proxy = enable;
+    }
     bool reserve (uint32_t max_count = 4);
     SmartPtr<VideoBuffer> get_buffer (const SmartPtr<BufferPool> &self);
     SmartPtr<VideoBuffer> get_buffer ();
+    // like get_buffer, but returns NULL instead of waiting for a release
+    SmartPtr<VideoBuffer> try_get_buffer (const SmartPtr<BufferPool> &self);
 
     void stop ();
 
@@ -97,13 +132,22 @@ public:
     }
 
     bool has_free_buffers () {
-        return !_buf_list.is_empty ();
+        return get_free_buffer_size () > 0;
     }
 
     uint32_t get_free_buffer_size () {
+        if (_recycle_proxy) {
+            SmartLock lock (_mutex);
+            return _free_proxy_num;
+        }
         return _buf_list.size ();
     }
 
+    BufferPoolStats get_stats () {
+        SmartLock lock (_mutex);
+        return _stats;
+    }
+
 protected:
     virtual bool fixate_video_info (VideoBufferInfo &info);
     virtual SmartPtr<BufferData> allocate_data (const VideoBufferInfo &buffer_info) = 0;
@@ -114,7 +158,11 @@ protected:
     void update_video_info_unsafe (const VideoBufferInfo &info);
 
 private:
+    SmartPtr<VideoBuffer> get_buffer (const SmartPtr<BufferPool> &self, bool wait);
+    SmartPtr<VideoBuffer> get_recycled_buffer (const SmartPtr<BufferPool> &self, bool wait);
+    void update_stats_unsafe (bool waited);
     void release (SmartPtr<BufferData> &data);
+    void recycle (BufferProxy *proxy);
     XCAM_DEAD_COPY (BufferPool);
 
 private:
@@ -124,6 +172,12 @@ private:
     uint32_t                 _allocated_num;
     uint32_t                 _max_count;
     bool                     _started;
+
+    bool                     _recycle_proxy;
+    BufferProxy             *_free_proxies;
+    uint32_t                 _free_proxy_num;
+    Cond                     _free_proxy_cond;
+    BufferPoolStats          _stats;
 };
 
 };
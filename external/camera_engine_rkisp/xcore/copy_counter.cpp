@@ -0,0 +1,76 @@
+/*
+ * copy_counter.cpp - bytes copied per frame by pipeline stages
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "copy_counter.h"
+
+namespace XCam {
+
+std::atomic<CopyCounter *> CopyCounter::_head (NULL);
+
+CopyCounter::CopyCounter (const char *stage)
+    : _stage (stage)
+    , _frames (0)
+    , _bytes (0)
+    , _next (NULL)
+{
+    // counters are never unregistered, they live as long as the process
+    _next = _head.load ();
+    while (!_head.compare_exchange_weak (_next, this))
+        ;
+}
+
+void
+CopyCounter::record (uint64_t bytes)
+{
+    _bytes.fetch_add (bytes, std::memory_order_relaxed);
+    uint64_t frames = _frames.fetch_add (1, std::memory_order_relaxed) + 1;
+
+    if (frames % XCAM_COPY_COUNTER_LOG_FRAMES == 0)
+        XCAM_LOG_DEBUG (
+            "copy counter(%s) %llu bytes/frame over %llu frames",
+            XCAM_STR (_stage), (unsigned long long)get_bytes_per_frame (),
+            (unsigned long long)frames);
+}
+
+void
+CopyCounter::reset ()
+{
+    _frames.store (0);
+    _bytes.store (0);
+}
+
+uint64_t
+CopyCounter::get_bytes_per_frame () const
+{
+    uint64_t frames = get_frames ();
+    return frames ? get_bytes () / frames : 0;
+}
+
+void
+CopyCounter::dump_all ()
+{
+    for (CopyCounter *counter = _head.load (); counter; counter = counter->_next) {
+        XCAM_LOG_INFO (
+            "copy counter(%s) %llu bytes/frame, frames:%llu bytes:%llu",
+            XCAM_STR (counter->_stage), (unsigned long long)counter->get_bytes_per_frame (),
+            (unsigned long long)counter->get_frames (), (unsigned long long)counter->get_bytes ());
+    }
+}
+
+};
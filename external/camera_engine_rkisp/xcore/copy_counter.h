@@ -0,0 +1,70 @@
+/*
+ * copy_counter.h - bytes copied per frame by pipeline stages
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_COPY_COUNTER_H
+#define XCAM_COPY_COUNTER_H
+
+#include <xcam_std.h>
+
+// counters log their bytes per frame every XCAM_COPY_COUNTER_LOG_FRAMES frames
+#define XCAM_COPY_COUNTER_LOG_FRAMES 300
+
+namespace XCam {
+
+/*
+ * One counter per pipeline stage, usually a static object next to the copy.
+ * A stage records every frame it handles, with the bytes the CPU copied for
+ * it, so zero-copy paths show up as 0 bytes/frame.
+ */
+class CopyCounter {
+public:
+    explicit CopyCounter (const char *stage);
+
+    void record (uint64_t bytes);
+    void reset ();
+
+    const char *get_stage () const {
+        return _stage;
+    }
+    uint64_t get_frames () const {
+        return _frames.load (std::memory_order_relaxed);
+    }
+    uint64_t get_bytes () const {
+        return _bytes.load (std::memory_order_relaxed);
+    }
+    uint64_t get_bytes_per_frame () const;
+
+    // log all registered counters
+    static void dump_all ();
+
+private:
+    XCAM_DEAD_COPY (CopyCounter);
+
+private:
+    const char                  *_stage;
+    std::atomic<uint64_t>        _frames;
+    std::atomic<uint64_t>        _bytes;
+    CopyCounter                 *_next;
+
+    static std::atomic<CopyCounter *> _head;
+};
+
+};
+
+#endif //XCAM_COPY_COUNTER_H
@@ -23,6 +23,7 @@
 #include "xcam_thread.h"
 #include "x3a_image_process_center.h"
 #include "x3a_analyzer_manager.h"
+#include "copy_counter.h"
 
 #define XCAM_FAILED_STOP(exp, msg, ...)                 \
     if ((exp) != XCAM_RETURN_NO_ERROR) {                \
@@ -395,6 +396,7 @@ DeviceManager::stop ()
     if (_device.ptr ())
         _device->stop ();
 
+    CopyCounter::dump_all ();
     XCAM_LOG_DEBUG ("Device manager stopped");
     return XCAM_RETURN_NO_ERROR;
 }
@@ -19,6 +19,8 @@
  */
 
 #include "fake_poll_thread.h"
+#include <sys/eventfd.h>
+#include <unistd.h>
 #if HAVE_LIBDRM
 #include "drm_bo_buffer.h"
 #endif
@@ -30,6 +32,7 @@ namespace XCam {
 FakePollThread::FakePollThread (const char *raw_path)
     : _raw_path (NULL)
     , _raw (NULL)
+    , _ready_fd (-1)
 {
     XCAM_ASSERT (raw_path);
 
@@ -44,6 +47,9 @@ FakePollThread::~FakePollThread ()
 
     if (_raw)
         fclose (_raw);
+
+    if (_ready_fd >= 0)
+        ::close (_ready_fd);
 }
 
 XCamReturn
@@ -62,6 +68,15 @@ FakePollThread::start()
         XCAM_RETURN_ERROR_FILE,
         "FakePollThread failed to open file:%s", XCAM_STR (_raw_path));
 
+    // never read, so the reactor always finds the raw file ready
+    if (_ready_fd < 0)
+        _ready_fd = eventfd (1, EFD_CLOEXEC);
+    XCAM_FAIL_RETURN(
+        ERROR,
+        _ready_fd >= 0,
+        XCAM_RETURN_ERROR_THREAD,
+        "FakePollThread failed to create ready fd");
+
     return PollThread::start ();
 }
 
@@ -74,6 +89,12 @@ FakePollThread::stop ()
     return PollThread::stop ();;
 }
 
+int
+FakePollThread::get_capture_poll_fd ()
+{
+    return _ready_fd;
+}
+
 XCamReturn
 FakePollThread::read_buf (SmartPtr<VideoBuffer> &buf)
 {
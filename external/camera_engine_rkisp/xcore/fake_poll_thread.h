@@ -38,6 +38,7 @@ public:
 
 protected:
     virtual XCamReturn poll_buffer_loop ();
+    virtual int get_capture_poll_fd ();
 
 private:
     XCAM_DEAD_COPY (FakePollThread);
@@ -51,6 +52,7 @@ private:
 private:
     char                        *_raw_path;
     FILE                        *_raw;
+    int                          _ready_fd;
     SmartPtr<BufferPool>         _buf_pool;
 };
 
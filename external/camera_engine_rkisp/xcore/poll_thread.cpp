@@ -21,30 +21,30 @@
 #include "poll_thread.h"
 #include "xcam_thread.h"
 #include <linux/rkisp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <time.h>
 #include <unistd.h>
 
 namespace XCam {
 
 class PollThread;
 
-class ISP3AStatsPollThread
+class PollReactorThread
     : public Thread
 {
 public:
-    ISP3AStatsPollThread (PollThread *poll)
-        : Thread ("stats_poll")
+    PollReactorThread (PollThread *poll)
+        : Thread ("poll_reactor")
         , _poll (poll)
     {}
 
 protected:
     virtual bool started () {
-        XCamReturn ret = _poll->init_3a_stats_pool ();
-        if (ret != XCAM_RETURN_NO_ERROR)
-            return false;
-        return true;
+        return _poll->reactor_started ();
     }
     virtual bool loop () {
-        XCamReturn ret = _poll->poll_isp_stats_loop ();
+        XCamReturn ret = _poll->reactor_loop ();
 
         if (ret == XCAM_RETURN_NO_ERROR || ret == XCAM_RETURN_ERROR_TIMEOUT)
             return true;
@@ -55,77 +55,35 @@ private:
     PollThread   *_poll;
 };
 
-class EventPollThread
-    : public Thread
-{
-public:
-    EventPollThread (PollThread *poll)
-        : Thread ("event_poll")
-        , _poll (poll)
-    {}
-
-protected:
-    virtual bool started () {
-        XCamReturn ret = _poll->init_3a_stats_pool ();
-        if (ret != XCAM_RETURN_NO_ERROR)
-            return false;
-        return true;
-    }
-    virtual bool loop () {
-        XCamReturn ret = _poll->poll_subdev_event_loop ();
-
-        if (ret == XCAM_RETURN_NO_ERROR || ret == XCAM_RETURN_ERROR_TIMEOUT)
-            return true;
-        return false;
-    }
-
-private:
-    PollThread   *_poll;
-};
-
-class CapturePollThread
-    : public Thread
-{
-public:
-    CapturePollThread (PollThread *poll)
-        : Thread ("capture_poll")
-        , _poll (poll)
-    {}
-
-protected:
-    virtual bool loop () {
-        XCamReturn ret = _poll->poll_buffer_loop ();
-
-        if (ret == XCAM_RETURN_NO_ERROR || ret == XCAM_RETURN_ERROR_TIMEOUT)
-            return true;
-        return false;
-    }
-
-private:
-    PollThread   *_poll;
-};
-
-const int PollThread::default_subdev_event_timeout = 100; // ms
-const int PollThread::default_capture_event_timeout = 100; // ms
-const int PollThread::default_isp_event_timeout = 1000; // ms
-
+const int PollThread::default_reactor_timeout = 1000; // ms
 
 PollThread::PollThread ()
-    : _poll_callback (NULL)
+    : _epoll_fd (-1)
+    , _wakeup_fd (-1)
+    , _ready_time (0)
+    , _poll_callback (NULL)
     , _stats_callback (NULL)
     , frameid (0)
 {
-    SmartPtr<EventPollThread> event_loop = new EventPollThread(this);
-    XCAM_ASSERT (event_loop.ptr ());
-    _event_loop = event_loop;
-
-    SmartPtr<ISP3AStatsPollThread> isp_loop = new ISP3AStatsPollThread(this);
-    XCAM_ASSERT (isp_loop.ptr ());
-    _isp_loop = isp_loop;
-
-    SmartPtr<CapturePollThread> capture_loop = new CapturePollThread (this);
-    XCAM_ASSERT (capture_loop.ptr ());
-    _capture_loop = capture_loop;
+    SmartPtr<PollReactorThread> reactor = new PollReactorThread (this);
+    XCAM_ASSERT (reactor.ptr ());
+    _reactor = reactor;
+
+    for (int i = 0; i < PollSourceCount; ++i)
+        _source_fds[i] = -1;
+
+    _epoll_fd = epoll_create1 (EPOLL_CLOEXEC);
+    _wakeup_fd = eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_epoll_fd < 0 || _wakeup_fd < 0) {
+        XCAM_LOG_ERROR ("PollThread create epoll/eventfd failed, %s", strerror (errno));
+    } else {
+        struct epoll_event ev;
+        xcam_mem_clear (ev);
+        ev.events = EPOLLIN;
+        ev.data.u32 = PollSourceCount;
+        if (epoll_ctl (_epoll_fd, EPOLL_CTL_ADD, _wakeup_fd, &ev) < 0)
+            XCAM_LOG_ERROR ("PollThread add wakeup fd failed, %s", strerror (errno));
+    }
 
     XCAM_LOG_DEBUG ("PollThread constructed");
 }
@@ -134,6 +92,11 @@ PollThread::~PollThread ()
 {
     stop();
 
+    if (_wakeup_fd >= 0)
+        ::close (_wakeup_fd);
+    if (_epoll_fd >= 0)
+        ::close (_epoll_fd);
+
     XCAM_LOG_DEBUG ("~PollThread destructed");
 }
 
@@ -179,13 +142,14 @@ PollThread::set_stats_callback (StatsCallback *callback)
 
 XCamReturn PollThread::start ()
 {
-    if (_event_dev.ptr () && !_event_loop->start ()) {
-        return XCAM_RETURN_ERROR_THREAD;
-    }
-    if (_isp_stats_dev.ptr () && !_isp_loop->start ()) {
-        return XCAM_RETURN_ERROR_THREAD;
-    }
-    if (_capture_dev.ptr() && !_capture_loop->start ()) {
+    XCAM_FAIL_RETURN (
+        ERROR, _epoll_fd >= 0 && _wakeup_fd >= 0, XCAM_RETURN_ERROR_THREAD,
+        "PollThread start failed, epoll is not created");
+
+    if (!_event_dev.ptr () && !_isp_stats_dev.ptr () && !_capture_dev.ptr ())
+        return XCAM_RETURN_NO_ERROR;
+
+    if (!_reactor->start ()) {
         return XCAM_RETURN_ERROR_THREAD;
     }
 
@@ -196,18 +160,148 @@ XCamReturn PollThread::stop ()
 {
     XCAM_LOG_DEBUG ("PollThread stop");
 
-    if (_event_dev.ptr ())
-        _event_loop->stop ();
+    uint64_t value = 1;
+    _reactor->emit_stop ();
+    if (_wakeup_fd >= 0 && ::write (_wakeup_fd, &value, sizeof (value)) != sizeof (value))
+        XCAM_LOG_WARNING ("PollThread wakeup reactor failed, %s", strerror (errno));
+    _reactor->stop ();
 
-    if (_isp_stats_dev.ptr ())
-        _isp_loop->stop ();
+    for (int i = 0; i < PollSourceCount; ++i)
+        remove_poll_source ((PollSource)i);
+    _deferred_stats.release ();
+    if (_wakeup_fd >= 0 && ::read (_wakeup_fd, &value, sizeof (value)) < 0 && errno != EAGAIN)
+        XCAM_LOG_WARNING ("PollThread clear wakeup fd failed, %s", strerror (errno));
 
-    if (_capture_dev.ptr())
-        _capture_loop->stop ();
+    return XCAM_RETURN_NO_ERROR;
+}
+
+bool
+PollThread::add_poll_source (PollSource source, int fd)
+{
+    struct epoll_event ev;
+
+    XCAM_FAIL_RETURN (
+        ERROR, fd >= 0, false,
+        "PollThread add poll source(%d) failed, invalid fd", source);
+
+    xcam_mem_clear (ev);
+    ev.events = EPOLLIN | EPOLLPRI;
+    ev.data.u32 = source;
+    if (epoll_ctl (_epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        XCAM_LOG_ERROR ("PollThread add poll source(%d) fd:%d failed, %s", source, fd, strerror (errno));
+        return false;
+    }
+    _source_fds[source] = fd;
+    return true;
+}
+
+void
+PollThread::remove_poll_source (PollSource source)
+{
+    if (_source_fds[source] < 0)
+        return;
+
+    // the fd may be closed already, that removed it from epoll as well
+    epoll_ctl (_epoll_fd, EPOLL_CTL_DEL, _source_fds[source], NULL);
+    _source_fds[source] = -1;
+}
+
+bool
+PollThread::reactor_started ()
+{
+    if (_event_dev.ptr () || _isp_stats_dev.ptr ()) {
+        if (init_3a_stats_pool () != XCAM_RETURN_NO_ERROR) {
+            XCAM_LOG_WARNING ("init 3a stats pool failed, events and stats are not polled");
+        } else {
+            if (_event_dev.ptr ())
+                add_poll_source (PollSourceEvent, _event_dev->get_fd ());
+            if (_isp_stats_dev.ptr ())
+                add_poll_source (PollSourceIspStats, _isp_stats_dev->get_fd ());
+        }
+    }
+    if (_capture_dev.ptr ())
+        add_poll_source (PollSourceCapture, get_capture_poll_fd ());
+
+    return true;
+}
+
+XCamReturn
+PollThread::reactor_loop ()
+{
+    struct epoll_event events[PollSourceCount + 1];
+    bool ready[PollSourceCount];
+    bool has_source = false;
+    struct timespec now;
+    int count = 0;
+
+    count = epoll_wait (_epoll_fd, events, PollSourceCount + 1, PollThread::default_reactor_timeout);
+    if (count < 0) {
+        if (errno == EINTR)
+            return XCAM_RETURN_NO_ERROR;
+        XCAM_LOG_WARNING ("poll reactor wait failed but continue, %s", strerror (errno));
+        ::usleep (1000); // 1ms
+        return XCAM_RETURN_ERROR_TIMEOUT;
+    }
+
+    /* timeout */
+    if (count == 0) {
+        XCAM_LOG_DEBUG ("poll reactor timeout and continue");
+        return XCAM_RETURN_ERROR_TIMEOUT;
+    }
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    _ready_time = XCAM_TIMESPEC_2_USEC (now);
+
+    xcam_mem_clear (ready);
+    for (int i = 0; i < count; ++i) {
+        // woken up by stop
+        if (events[i].data.u32 == PollSourceCount)
+            return XCAM_RETURN_NO_ERROR;
+        ready[events[i].data.u32] = true;
+    }
+
+    for (int i = 0; i < PollSourceCount; ++i) {
+        if (!ready[i] || _source_fds[i] < 0)
+            continue;
+
+        XCamReturn ret = dispatch_source ((PollSource)i);
+        if (ret != XCAM_RETURN_NO_ERROR && ret != XCAM_RETURN_ERROR_TIMEOUT) {
+            XCAM_LOG_WARNING ("poll source(%d) stopped, ret:%d", i, ret);
+            remove_poll_source ((PollSource)i);
+        }
+    }
+
+    for (int i = 0; i < PollSourceCount; ++i)
+        has_source |= (_source_fds[i] >= 0);
+    XCAM_FAIL_RETURN (
+        WARNING, has_source, XCAM_RETURN_ERROR_UNKNOWN,
+        "poll reactor stopped, no source left");
 
     return XCAM_RETURN_NO_ERROR;
 }
 
+XCamReturn
+PollThread::dispatch_source (PollSource source)
+{
+    switch (source) {
+    case PollSourceEvent:
+        return poll_subdev_event_loop ();
+    case PollSourceIspStats:
+        return poll_isp_stats_loop ();
+    case PollSourceCapture:
+        return poll_buffer_loop ();
+    default:
+        break;
+    }
+    return XCAM_RETURN_ERROR_PARAM;
+}
+
+int
+PollThread::get_capture_poll_fd ()
+{
+    return _capture_dev->get_fd ();
+}
+
 XCamReturn
 PollThread::init_3a_stats_pool ()
 {
@@ -248,6 +342,29 @@ PollThread::handle_frame_sync_event (struct v4l2_event &event)
 
     notify_sof(tv_sec * 1000 * 1000 * 1000 + tv_nsec, exp_id);
 
+    if (_deferred_stats.ptr () && stats_sof_arrived (_deferred_stats)) {
+        SmartPtr<X3aStats> stats = _deferred_stats;
+        _deferred_stats.release ();
+        return deliver_3a_stats (stats);
+    }
+
+    return XCAM_RETURN_NO_ERROR;
+}
+
+bool
+PollThread::stats_sof_arrived (const SmartPtr<X3aStats> &stats)
+{
+    XCAM_UNUSED (stats);
+
+    return true;
+}
+
+XCamReturn
+PollThread::deliver_3a_stats (const SmartPtr<X3aStats> &stats)
+{
+    if (_stats_callback)
+        return _stats_callback->x3a_stats_ready (stats);
+
     return XCAM_RETURN_NO_ERROR;
 }
 
@@ -264,38 +381,35 @@ PollThread::handle_3a_stats_event (struct v4l2_event &event)
     }
     stats->set_timestamp (XCAM_TIMESPEC_2_USEC (event.timestamp));
 
-    if (_stats_callback)
-        return _stats_callback->x3a_stats_ready (stats);
+    if (!stats_sof_arrived (stats)) {
+        // the SOF is still queued on the event fd, it's dispatched in the
+        // next wakeup and takes the stats along
+        if (_deferred_stats.ptr ()) {
+            XCAM_LOG_WARNING ("SOF of stats(seq:%d) never came, deliver them anyway",
+                              _deferred_stats->get_sequence ());
+            deliver_3a_stats (_deferred_stats);
+        }
+        XCAM_LOG_DEBUG ("stats(seq:%d) ahead of SOF, deferred - statsync",
+                        stats->get_sequence ());
+        _deferred_stats = stats;
+        return XCAM_RETURN_NO_ERROR;
+    }
 
-    return ret;
+    return deliver_3a_stats (stats);
 }
 
 XCamReturn
 PollThread::poll_isp_stats_loop ()
 {
-    XCamReturn ret = XCAM_RETURN_NO_ERROR;
-    int poll_ret = 0;
     struct v4l2_event event;
 
-    poll_ret = _isp_stats_dev->poll_event (PollThread::default_isp_event_timeout);
-
-    if (poll_ret < 0) {
-        XCAM_LOG_WARNING("poll buffer event got error but continue");
-        ::usleep (1000); // 1ms
-        return XCAM_RETURN_ERROR_TIMEOUT;
-    }
-
-    /* timeout */
-    if (poll_ret == 0) {
-        XCAM_LOG_WARNING ("poll buffer timeout and continue");
-        return XCAM_RETURN_ERROR_TIMEOUT;
-    }
-
+    // stats readiness has no v4l2 event, stamp it with the readiness time
+    xcam_mem_clear (event);
     event.type = V4L2_EVENT_RKISP_3A_STATS_READY;
-    ret = handle_events (event);
-
-    return ret;
+    event.timestamp.tv_sec = _ready_time / (1000 * 1000);
+    event.timestamp.tv_nsec = (_ready_time % (1000 * 1000)) * 1000;
 
+    return handle_events (event);
 }
 
 XCamReturn
@@ -303,21 +417,6 @@ PollThread::poll_subdev_event_loop ()
 {
     XCamReturn ret = XCAM_RETURN_NO_ERROR;
     struct v4l2_event event;
-    int poll_ret = 0;
-
-    poll_ret = _event_dev->poll_event (PollThread::default_subdev_event_timeout);
-
-    if (poll_ret < 0) {
-        XCAM_LOG_WARNING ("poll event failed but continue");
-        ::usleep (1000); // 1ms
-        return XCAM_RETURN_ERROR_TIMEOUT;
-    }
-
-    /* timeout */
-    if (poll_ret == 0) {
-        XCAM_LOG_DEBUG ("poll event timeout and continue");
-        return XCAM_RETURN_ERROR_TIMEOUT;
-    }
 
     xcam_mem_clear (event);
     ret = _event_dev->dequeue_event (event);
@@ -334,24 +433,8 @@ XCamReturn
 PollThread::poll_buffer_loop ()
 {
     XCamReturn ret = XCAM_RETURN_NO_ERROR;
-    int poll_ret = 0;
     SmartPtr<V4l2Buffer> buf;
 
-    poll_ret = _capture_dev->poll_event (PollThread::default_capture_event_timeout);
-
-    if (poll_ret < 0) {
-        XCAM_LOG_DEBUG ("poll buffer event got error but continue");
-        ::usleep (100000); // 100ms
-        return XCAM_RETURN_ERROR_TIMEOUT;
-    }
-
-    /* timeout */
-    if (poll_ret == 0) {
-        XCAM_LOG_DEBUG ("poll buffer timeout and continue");
-        XCAM_LOG_DEBUG ("dont return;");
-        //return XCAM_RETURN_ERROR_TIMEOUT;
-    }
-
     ret = _capture_dev->dequeue_buffer (buf);
     if (ret != XCAM_RETURN_NO_ERROR) {
         XCAM_LOG_WARNING ("capture buffer failed");
@@ -46,15 +46,18 @@ private:
 
 class V4l2Device;
 class V4l2SubDevice;
-class ISP3AStatsPollThread;
-class EventPollThread;
-class CapturePollThread;
+class PollReactorThread;
 
+/*
+ * One reactor thread multiplexes the subdev event, isp stats and capture
+ * fds with epoll, an eventfd wakes it up on stop. Sources ready in the same
+ * wakeup are dispatched in that order, so SOF is handled before the stats
+ * of the frame. Stats whose SOF is still queued are deferred until the SOF
+ * is dispatched, the reactor never waits on one fd for another.
+ */
 class PollThread
 {
-    friend class ISP3AStatsPollThread;
-    friend class EventPollThread;
-    friend class CapturePollThread;
+    friend class PollReactorThread;
     friend class FakePollThread;
 public:
     explicit PollThread ();
@@ -70,9 +73,16 @@ public:
     virtual XCamReturn stop ();
 
 protected:
+    // called by the reactor once the source fd is ready, must not poll again
     XCamReturn poll_isp_stats_loop ();
     XCamReturn poll_subdev_event_loop ();
     virtual XCamReturn poll_buffer_loop ();
+    // fd the reactor waits on before calling poll_buffer_loop
+    virtual int get_capture_poll_fd ();
+    // CLOCK_MONOTONIC time(usec) the source being dispatched became ready
+    int64_t get_ready_time () const {
+        return _ready_time;
+    }
 
     virtual XCamReturn handle_events (struct v4l2_event &event);
     XCamReturn handle_3a_stats_event (struct v4l2_event &event);
@@ -82,18 +92,34 @@ private:
     virtual XCamReturn init_3a_stats_pool ();
     virtual XCamReturn capture_3a_stats (SmartPtr<X3aStats> &stats);
     virtual XCamReturn notify_sof (int64_t time, int frameid);
+    // false while the SOF of the frame @stats belongs to is not dispatched yet
+    virtual bool stats_sof_arrived (const SmartPtr<X3aStats> &stats);
+    XCamReturn deliver_3a_stats (const SmartPtr<X3aStats> &stats);
+
+    enum PollSource {
+        PollSourceEvent = 0,
+        PollSourceIspStats,
+        PollSourceCapture,
+        PollSourceCount,
+    };
+
+    bool add_poll_source (PollSource source, int fd);
+    void remove_poll_source (PollSource source);
+    XCamReturn dispatch_source (PollSource source);
+    bool reactor_started ();
+    XCamReturn reactor_loop ();
 
 private:
     XCAM_DEAD_COPY (PollThread);
 
 private:
-    static const int default_subdev_event_timeout;
-    static const int default_capture_event_timeout;
-    static const int default_isp_event_timeout;
+    static const int default_reactor_timeout;
 
-    SmartPtr<ISP3AStatsPollThread>   _isp_loop;
-    SmartPtr<EventPollThread>        _event_loop;
-    SmartPtr<CapturePollThread>      _capture_loop;
+    SmartPtr<PollReactorThread>      _reactor;
+    int                              _epoll_fd;
+    int                              _wakeup_fd;
+    int                              _source_fds[PollSourceCount];
+    int64_t                          _ready_time;
 
     SmartPtr<V4l2SubDevice>          _event_dev;
     SmartPtr<V4l2Device>             _capture_dev;
@@ -101,6 +127,8 @@ private:
 
     PollCallback                    *_poll_callback;
     StatsCallback                   *_stats_callback;
+    // only touched by the reactor thread
+    SmartPtr<X3aStats>               _deferred_stats;
 
     //frame syncronization
     int frameid;
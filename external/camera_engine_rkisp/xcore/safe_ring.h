@@ -0,0 +1,337 @@
+/*
+ * safe_ring.h - bounded lock-free safe ring
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_SAFE_RING_H
+#define XCAM_SAFE_RING_H
+
+#include <base/xcam_defs.h>
+#include <base/xcam_common.h>
+#include <errno.h>
+#include <atomic>
+#include <xcam_mutex.h>
+#include <smartptr.h>
+
+#define XCAM_SAFE_RING_DEFAULT_CAPACITY 64
+
+namespace XCam {
+
+/*
+ * SafeRing, bounded alternative to SafeList with the same interface.
+ * Slots are allocated once, push/pop are lock-free (multi-producer,
+ * multi-consumer, sequence numbered slots) and never allocate. The mutex
+ * and cond are only taken when a consumer has to block, producers signal
+ * only if somebody is waiting. push fails when the ring is full.
+ * The per-frame queues stay on SafeList until tests/safe_ring_bench shows
+ * the ring ahead of it on the target.
+ */
+template<class OBj>
+class SafeRing {
+public:
+    typedef SmartPtr<OBj> ObjPtr;
+
+    explicit SafeRing (uint32_t capacity = XCAM_SAFE_RING_DEFAULT_CAPACITY)
+        : _slots (NULL)
+        , _mask (0)
+        , _enqueue_pos (0)
+        , _dequeue_pos (0)
+        , _waiters (0)
+        , _push_waiters (0)
+        , _pop_paused (false)
+    {
+        alloc_slots (capacity);
+    }
+    ~SafeRing () {
+        delete [] _slots;
+    }
+
+    // only valid while the ring is empty and not used by other threads
+    bool set_capacity (uint32_t capacity);
+    uint32_t get_capacity () const {
+        return _mask + 1;
+    }
+
+    /*
+     * timeout, -1,  wait until wakeup
+     *          0,  return immediately
+     *         > 0,  wait for @timeout microsseconds
+    */
+    inline ObjPtr pop (int32_t timeout = -1);
+    inline bool push (const ObjPtr &obj);
+    /*
+     * back-pressure push, waits for a free slot while the ring is full
+     * timeout, -1,  wait until a slot is free
+     *         > 0,  wait for @timeout microsseconds
+     */
+    inline bool push (const ObjPtr &obj, int32_t timeout);
+    uint32_t size () {
+        return _enqueue_pos.load (std::memory_order_relaxed) -
+               _dequeue_pos.load (std::memory_order_relaxed);
+    }
+    bool is_empty () {
+        return size () == 0;
+    }
+    void wakeup () {
+        SmartLock lock(_mutex);
+        _new_obj_cond.broadcast ();
+        _free_slot_cond.broadcast ();
+    }
+    void pause_pop () {
+        _pop_paused.store (true);
+        wakeup ();
+    }
+    void resume_pop () {
+        _pop_paused.store (false);
+    }
+    inline void clear ();
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        ObjPtr                obj;
+    };
+
+    void alloc_slots (uint32_t capacity);
+    inline bool try_push (const ObjPtr &obj);
+    inline bool try_pop (ObjPtr &obj);
+    inline void signal_free_slot ();
+
+private:
+    XCAM_DEAD_COPY (SafeRing);
+
+private:
+    Slot                     *_slots;
+    uint32_t                  _mask;
+    std::atomic<uint32_t>     _enqueue_pos;
+    std::atomic<uint32_t>     _dequeue_pos;
+    std::atomic<uint32_t>     _waiters;
+    std::atomic<uint32_t>     _push_waiters;
+    std::atomic<bool>         _pop_paused;
+    Mutex                     _mutex;
+    XCam::Cond                _new_obj_cond;
+    XCam::Cond                _free_slot_cond;
+};
+
+template<class OBj>
+void
+SafeRing<OBj>::alloc_slots (uint32_t capacity)
+{
+    uint32_t size = 1;
+    while (size < capacity)
+        size <<= 1;
+
+    delete [] _slots;
+    _slots = new Slot[size];
+    for (uint32_t i = 0; i < size; ++i)
+        _slots[i].sequence.store (i, std::memory_order_relaxed);
+    _mask = size - 1;
+    _enqueue_pos.store (0, std::memory_order_relaxed);
+    _dequeue_pos.store (0, std::memory_order_relaxed);
+}
+
+template<class OBj>
+bool
+SafeRing<OBj>::set_capacity (uint32_t capacity)
+{
+    XCAM_FAIL_RETURN (
+        ERROR, is_empty (), false,
+        "safe ring set capacity failed, ring is not empty");
+
+    if (capacity > get_capacity ())
+        alloc_slots (capacity);
+    return true;
+}
+
+template<class OBj>
+bool
+SafeRing<OBj>::try_push (const SafeRing<OBj>::ObjPtr &obj)
+{
+    uint32_t pos = _enqueue_pos.load (std::memory_order_relaxed);
+    Slot *slot = NULL;
+
+    while (true) {
+        slot = &_slots[pos & _mask];
+        uint32_t seq = slot->sequence.load (std::memory_order_acquire);
+        int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            if (_enqueue_pos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = _enqueue_pos.load (std::memory_order_relaxed);
+        }
+    }
+
+    slot->obj = obj;
+    slot->sequence.store (pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<class OBj>
+bool
+SafeRing<OBj>::try_pop (SafeRing<OBj>::ObjPtr &obj)
+{
+    uint32_t pos = _dequeue_pos.load (std::memory_order_relaxed);
+    Slot *slot = NULL;
+
+    while (true) {
+        slot = &_slots[pos & _mask];
+        uint32_t seq = slot->sequence.load (std::memory_order_acquire);
+        int32_t diff = (int32_t)(seq - (pos + 1));
+        if (diff == 0) {
+            if (_dequeue_pos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = _dequeue_pos.load (std::memory_order_relaxed);
+        }
+    }
+
+    obj = slot->obj;
+    slot->obj.release ();
+    slot->sequence.store (pos + _mask + 1, std::memory_order_release);
+    return true;
+}
+
+template<class OBj>
+void
+SafeRing<OBj>::signal_free_slot ()
+{
+    // pairs with the fence in the blocking push, either the pusher sees
+    // the free slot or we see the pusher
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    if (_push_waiters.load (std::memory_order_relaxed)) {
+        SmartLock lock (_mutex);
+        _free_slot_cond.signal ();
+    }
+}
+
+template<class OBj>
+typename SafeRing<OBj>::ObjPtr
+SafeRing<OBj>::pop (int32_t timeout)
+{
+    SafeRing<OBj>::ObjPtr obj;
+    int code = 0;
+
+    if (_pop_paused.load ())
+        return NULL;
+    if (try_pop (obj)) {
+        signal_free_slot ();
+        return obj;
+    }
+    if (timeout == 0)
+        return obj;
+
+    SmartLock lock (_mutex);
+    _waiters.fetch_add (1);
+    // pairs with the fence in push, either we see the new obj or the pusher sees us
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    while (!_pop_paused.load () && !try_pop (obj) && code == 0) {
+        if (timeout < 0)
+            code = _new_obj_cond.wait(_mutex);
+        else
+            code = _new_obj_cond.timedwait(_mutex, timeout);
+    }
+    _waiters.fetch_sub (1);
+
+    if (obj.ptr ()) {
+        // a pusher registers under the mutex held here, no fence needed
+        if (_push_waiters.load (std::memory_order_relaxed))
+            _free_slot_cond.signal ();
+        return obj;
+    }
+    if (_pop_paused.load ())
+        return NULL;
+
+    if (code == ETIMEDOUT) {
+        XCAM_LOG_DEBUG ("safe ring pop timeout");
+    } else {
+        XCAM_LOG_ERROR ("safe ring pop failed, code:%d", code);
+    }
+    return NULL;
+}
+
+template<class OBj>
+bool
+SafeRing<OBj>::push (const SafeRing<OBj>::ObjPtr &obj)
+{
+    if (!try_push (obj)) {
+        XCAM_LOG_WARNING ("safe ring push failed, ring(capacity:%d) is full", get_capacity ());
+        return false;
+    }
+
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    if (_waiters.load (std::memory_order_relaxed)) {
+        SmartLock lock (_mutex);
+        _new_obj_cond.signal ();
+    }
+    return true;
+}
+
+template<class OBj>
+bool
+SafeRing<OBj>::push (const SafeRing<OBj>::ObjPtr &obj, int32_t timeout)
+{
+    int code = 0;
+
+    if (!try_push (obj)) {
+        SmartLock lock (_mutex);
+        _push_waiters.fetch_add (1);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        bool pushed = false;
+        while (!(pushed = try_push (obj)) && code == 0) {
+            if (timeout < 0)
+                code = _free_slot_cond.wait (_mutex);
+            else
+                code = _free_slot_cond.timedwait (_mutex, timeout);
+        }
+        _push_waiters.fetch_sub (1);
+
+        if (!pushed) {
+            XCAM_LOG_WARNING (
+                "safe ring push failed, ring(capacity:%d) stayed full, code:%d",
+                get_capacity (), code);
+            return false;
+        }
+    }
+
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    if (_waiters.load (std::memory_order_relaxed)) {
+        SmartLock lock (_mutex);
+        _new_obj_cond.signal ();
+    }
+    return true;
+}
+
+template<class OBj>
+void SafeRing<OBj>::clear ()
+{
+    SafeRing<OBj>::ObjPtr obj;
+    bool popped = false;
+    while (try_pop (obj)) {
+        obj.release ();
+        popped = true;
+    }
+    if (popped)
+        signal_free_slot ();
+}
+
+};
+#endif //XCAM_SAFE_RING_H
@@ -44,6 +44,11 @@ public:
     virtual bool is_a_object () const {
         return true;
     }
+    // called when the last reference is gone, return true if the object
+    // was taken back by its owner (e.g. a buffer pool) instead of deleted
+    virtual bool recycle () {
+        return false;
+    }
 
 private:
     explicit RefObj (uint32_t i) : _ref_count (i) {}
@@ -165,10 +170,12 @@ public:
             if (!_ref->is_a_object ()) {
                 XCAM_ASSERT (dynamic_cast<RefCount*>(_ref));
                 delete _ref;
+                delete _ptr;
             } else {
                 XCAM_ASSERT (dynamic_cast<Obj*>(_ref) == _ptr);
+                if (!_ref->recycle ())
+                    delete _ptr;
             }
-            delete _ptr;
         }
         _ptr = NULL;
         _ref = NULL;
@@ -23,6 +23,8 @@
 
 namespace XCam {
 V4l2Buffer::V4l2Buffer (const struct v4l2_buffer &buf, const struct v4l2_format &format)
+    : _length (0)
+    , _dma_fd (-1)
 {
     _buf = buf;
     _format = format;
@@ -50,7 +52,7 @@ int
 V4l2Buffer::get_fd ()
 {
     if (_buf.memory == V4L2_MEMORY_MMAP)
-        return -1;
+        return _dma_fd;
     return _buf.m.fd;
 }
 
@@ -70,6 +70,14 @@ public:
         return _format;
     }
 
+    // dma-buf exported from a MMAP buffer, owned and closed by the device
+    void set_dma_fd (int fd) {
+        _dma_fd = fd;
+    }
+    int get_dma_fd () const {
+        return _dma_fd;
+    }
+
     // derived from BufferData
     virtual uint8_t *map ();
     virtual bool unmap ();
@@ -82,6 +90,7 @@ private:
     struct v4l2_buffer  _buf;
     struct v4l2_format  _format;
     int _length;
+    int _dma_fd;
 };
 
 class V4l2BufferProxy
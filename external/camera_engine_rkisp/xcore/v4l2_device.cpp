@@ -41,6 +41,7 @@ V4l2Device::V4l2Device (const char *name)
     , _capture_mode (0)
     , _buf_type (V4L2_BUF_TYPE_VIDEO_CAPTURE)
     , _memory_type (V4L2_MEMORY_MMAP)
+    , _dma_export (false)
     , _planes (NULL)
     , _fps_n (0)
     , _fps_d (0)
@@ -129,6 +130,16 @@ V4l2Device::set_mem_type (enum v4l2_memory type) {
     return true;
 }
 
+bool
+V4l2Device::set_dma_export (bool enable) {
+    if (is_activated ()) {
+        XCAM_LOG_WARNING ("device(%s) set dma export failed", XCAM_STR (_name));
+        return false;
+    }
+    _dma_export = enable;
+    return true;
+}
+
 bool
 V4l2Device::set_buf_type (enum v4l2_buf_type type) {
     if (is_activated ()) {
@@ -585,22 +596,14 @@ V4l2Device::allocate_buffer (
     switch (_memory_type) {
     case V4L2_MEMORY_DMABUF:
     {
-        struct v4l2_exportbuffer expbuf;
-        xcam_mem_clear (expbuf);
-        expbuf.type = _buf_type;
-        expbuf.index = index;
-        expbuf.flags = O_CLOEXEC;
-        if (io_control (VIDIOC_EXPBUF, &expbuf) < 0) {
-            XCAM_LOG_ERROR ("device(%s) get dma buf(%d) failed", XCAM_STR (_name), index);
+        int dma_fd = export_dma_buf (index);
+        if (dma_fd < 0)
             return XCAM_RETURN_ERROR_MEM;
-        } else {
-            XCAM_LOG_INFO ("device(%s) get dma buf(%d)-fd: %d", XCAM_STR (_name), index, expbuf.fd);
-        }
-        v4l2_buf.m.fd = expbuf.fd;
+        v4l2_buf.m.fd = dma_fd;
         v4l2_buf.length = format.fmt.pix.sizeimage;
         if (V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE == _buf_type) {
             v4l2_buf.length = FMT_NUM_PLANES;
-            v4l2_buf.m.planes[0].m.fd = expbuf.fd;
+            v4l2_buf.m.planes[0].m.fd = dma_fd;
             v4l2_buf.m.planes[0].length = format.fmt.pix.sizeimage;
             v4l2_buf.m.planes[0].bytesused = format.fmt.pix.sizeimage;
         }
@@ -644,9 +647,33 @@ V4l2Device::allocate_buffer (
 
     buf = new V4l2Buffer (v4l2_buf, _format);
 
+    if (_memory_type == V4L2_MEMORY_MMAP && _dma_export) {
+        buf->set_dma_fd (export_dma_buf (index));
+        if (buf->get_dma_fd () < 0)
+            XCAM_LOG_WARNING ("device(%s) buf(%d) fallback to mmap only", XCAM_STR (_name), index);
+    }
+
     return XCAM_RETURN_NO_ERROR;
 }
 
+int
+V4l2Device::export_dma_buf (uint32_t index)
+{
+    struct v4l2_exportbuffer expbuf;
+
+    xcam_mem_clear (expbuf);
+    expbuf.type = _buf_type;
+    expbuf.index = index;
+    expbuf.flags = O_CLOEXEC;
+    if (io_control (VIDIOC_EXPBUF, &expbuf) < 0) {
+        XCAM_LOG_ERROR ("device(%s) get dma buf(%d) failed", XCAM_STR (_name), index);
+        return -1;
+    }
+
+    XCAM_LOG_INFO ("device(%s) get dma buf(%d)-fd: %d", XCAM_STR (_name), index, expbuf.fd);
+    return expbuf.fd;
+}
+
 XCamReturn
 V4l2Device::release_buffer (SmartPtr<V4l2Buffer> &buf) 
 {
@@ -658,6 +685,10 @@ V4l2Device::release_buffer (SmartPtr<V4l2Buffer> &buf)
     break;
     case V4L2_MEMORY_MMAP:
     {
+        if (buf->get_dma_fd () >= 0) {
+            ::close (buf->get_dma_fd ());
+            buf->set_dma_fd (-1);
+        }
         if (V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE == _buf_type) {
             XCAM_LOG_DEBUG("release multi planar buffer length: %d", buf->get_length());
             ret = munmap((void*)buf->get_buf().m.userptr, buf->get_length());
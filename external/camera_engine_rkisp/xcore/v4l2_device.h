@@ -69,6 +69,12 @@ public:
     enum v4l2_memory get_mem_type () const {
         return _memory_type;
     }
+    // MMAP buffers are also exported once as dma-buf, get_fd of the
+    // buffers returns the exported fd while map keeps working
+    bool set_dma_export (bool enable);
+    bool get_dma_export () const {
+        return _dma_export;
+    }
     bool set_buf_type (enum v4l2_buf_type type);
     enum v4l2_buf_type get_buf_type () const {
         return _buf_type;
@@ -82,6 +88,9 @@ public:
     }
 
     bool set_buffer_count (uint32_t buf_count);
+    uint32_t get_buffer_count () const {
+        return _buf_count;
+    }
 
     // set_framerate must before set_format
     bool set_framerate (uint32_t n, uint32_t d);
@@ -125,6 +134,7 @@ protected:
 
 private:
     XCamReturn request_buffer ();
+    int export_dma_buf (uint32_t index);
     XCamReturn init_buffer_pool ();
     XCamReturn fini_buffer_pool ();
 
@@ -137,6 +147,7 @@ protected:
     uint32_t            _capture_mode;
     enum v4l2_buf_type  _buf_type;
     enum v4l2_memory    _memory_type;
+    bool                _dma_export;
     struct v4l2_plane  *_planes;
 
     struct v4l2_format  _format;
@@ -21,9 +21,95 @@
 #include "xcam_analyzer.h"
 #include "x3a_analyzer.h"
 #include "x3a_stats_pool.h"
+#include "x3a_result_arena.h"
+#include "xcam_trace.h"
+#include <time.h>
 
 namespace XCam {
 
+static int64_t
+analyze_time_now ()
+{
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000LL + now.tv_nsec / 1000;
+}
+
+void
+X3aLatencyHistogram::add (int64_t usec)
+{
+    uint32_t bucket = 0;
+    while (bucket < XCAM_3A_LATENCY_BUCKETS - 1 && (usec >> (bucket + 1)) > 0)
+        ++bucket;
+
+    ++buckets[bucket];
+    ++count;
+    total_usec += usec;
+    if (usec > max_usec)
+        max_usec = usec;
+}
+
+/*
+ * one handler analyze queued to the handler pool, owns its results until
+ * the analyzer thread joins it
+ */
+class X3aHandlerJob
+    : public ThreadPool::UserData
+{
+public:
+    X3aHandlerJob (X3aHandlerType type, AnalyzerHandler *handler, int32_t frame_id)
+        : _type (type)
+        , _handler (handler)
+        , _frame_id (frame_id)
+        , _ret (XCAM_RETURN_NO_ERROR)
+        , _usec (0)
+        , _done (false)
+    {}
+
+    virtual XCamReturn run () {
+        TraceScope trace ((XCamTraceStage)(XCAM_TRACE_AE + _type), _frame_id);
+        int64_t start = analyze_time_now ();
+        XCamReturn ret = _handler->analyze (_results);
+        _usec = analyze_time_now () - start;
+        return ret;
+    }
+    virtual void done (XCamReturn err) {
+        SmartLock locker (_mutex);
+        _ret = err;
+        _done = true;
+        _done_cond.broadcast ();
+    }
+
+    // wait for the handler and move its results to the end of @results
+    XCamReturn join (X3aResultList &results) {
+        SmartLock locker (_mutex);
+        while (!_done)
+            _done_cond.wait (_mutex);
+        results.splice (results.end (), _results);
+        return _ret;
+    }
+    AnalyzerHandler *get_handler () const {
+        return _handler;
+    }
+    int64_t get_usec () const {
+        return _usec;
+    }
+
+private:
+    XCAM_DEAD_COPY (X3aHandlerJob);
+
+private:
+    X3aHandlerType           _type;
+    AnalyzerHandler         *_handler;
+    int32_t                  _frame_id;
+    X3aResultList            _results;
+    XCamReturn               _ret;
+    int64_t                  _usec;
+    bool                     _done;
+    Mutex                    _mutex;
+    XCam::Cond               _done_cond;
+};
+
 X3aAnalyzer::X3aAnalyzer (const char *name)
     : XAnalyzer (name)
     , _brightness_level_param (0.0)
@@ -31,11 +117,14 @@ X3aAnalyzer::X3aAnalyzer (const char *name)
     , _awb_handler (NULL)
     , _af_handler (NULL)
     , _common_handler (NULL)
+    , _parallel_analyze (false)
 {
 }
 
 X3aAnalyzer::~X3aAnalyzer()
 {
+    if (_handler_pool.ptr ())
+        _handler_pool->stop ();
 }
 
 XCamReturn
@@ -71,6 +160,13 @@ X3aAnalyzer::create_handlers ()
 XCamReturn
 X3aAnalyzer::release_handlers ()
 {
+    // no handler job is pending, the analyzer thread joins each one
+    if (_handler_pool.ptr ()) {
+        _handler_pool->stop ();
+        _handler_pool.release ();
+    }
+    dump_latency ();
+
     _ae_handler.release ();
     _awb_handler.release ();
     _af_handler.release ();
@@ -99,48 +195,152 @@ X3aAnalyzer::push_3a_stats (const SmartPtr<X3aStats> &stats)
     return XAnalyzer::push_buffer (stats);
 }
 
+XCamReturn
+X3aAnalyzer::run_handler (
+    X3aHandlerType type, AnalyzerHandler *handler, int32_t frame_id, X3aResultList &results)
+{
+    TraceScope trace ((XCamTraceStage)(XCAM_TRACE_AE + type), frame_id);
+    int64_t start = analyze_time_now ();
+    XCamReturn ret = handler->analyze (results);
+    record_latency (type, analyze_time_now () - start);
+    return ret;
+}
+
+SmartPtr<X3aHandlerJob>
+X3aAnalyzer::queue_handler_job (X3aHandlerType type, AnalyzerHandler *handler, int32_t frame_id)
+{
+    if (!_handler_pool.ptr ()) {
+        SmartPtr<ThreadPool> pool = new ThreadPool ("3a-handler-pool");
+        pool->set_threads (1, 1);
+        XCAM_FAIL_RETURN (
+            WARNING, xcam_ret_is_ok (pool->start ()), NULL,
+            "analyzer(%s) start handler pool failed, analyze sequentially", XCAM_STR (get_name ()));
+        _handler_pool = pool;
+    }
+
+    SmartPtr<X3aHandlerJob> job = new X3aHandlerJob (type, handler, frame_id);
+    XCAM_FAIL_RETURN (
+        WARNING, xcam_ret_is_ok (_handler_pool->queue (job)), NULL,
+        "analyzer(%s) queue handler job failed, analyze sequentially", XCAM_STR (get_name ()));
+    return job;
+}
+
+void
+X3aAnalyzer::record_latency (X3aHandlerType type, int64_t usec)
+{
+    SmartLock locker (_latency_mutex);
+    _latency[type].add (usec);
+}
+
+bool
+X3aAnalyzer::get_handler_latency (X3aHandlerType type, X3aLatencyHistogram &histogram)
+{
+    XCAM_FAIL_RETURN (
+        ERROR, type >= XCAM_3A_HANDLER_AE && type < XCAM_3A_HANDLER_COUNT, false,
+        "analyzer(%s) get latency of unknown handler type(%d)", XCAM_STR (get_name ()), type);
+
+    SmartLock locker (_latency_mutex);
+    histogram = _latency[type];
+    return true;
+}
+
+void
+X3aAnalyzer::dump_latency ()
+{
+    static const char *names[XCAM_3A_HANDLER_COUNT] = {"ae", "awb", "af", "common"};
+    SmartLock locker (_latency_mutex);
+
+    for (int i = 0; i < XCAM_3A_HANDLER_COUNT; ++i) {
+        const X3aLatencyHistogram &h = _latency[i];
+        if (!h.count)
+            continue;
+
+        char buckets[XCAM_3A_LATENCY_BUCKETS * 12] = {0};
+        int pos = 0;
+        for (int b = 0; b < XCAM_3A_LATENCY_BUCKETS && pos < (int)sizeof (buckets); ++b) {
+            if (h.buckets[b])
+                pos += snprintf (buckets + pos, sizeof (buckets) - pos, " %d:%d", 1 << b, h.buckets[b]);
+        }
+        XCAM_LOG_INFO (
+            "analyzer(%s) %s latency count:%" PRIu64 " avg:%" PRId64 "us max:%" PRId64 "us, us:runs%s",
+            XCAM_STR (get_name ()), names[i], h.count, h.total_usec / (int64_t)h.count,
+            h.max_usec, buckets);
+    }
+}
+
 XCamReturn
 X3aAnalyzer::analyze_3a_statistics (SmartPtr<X3aStats> &stats)
 {
     XCamReturn ret = XCAM_RETURN_NO_ERROR;
     X3aResultList results;
-
-    ret = pre_3a_analyze (stats);
+    X3aResultList common_results;
+    SmartPtr<X3aHandlerJob> af_job;
+    AnalyzerHandler *failed_handler = NULL;
+    const char *failed_msg = NULL;
+    int32_t frame_id = (int32_t)stats->get_sequence ();
+
+    X3aResultArena::instance ()->begin_frame ();
+    {
+        TraceScope trace (XCAM_TRACE_PRE_3A, frame_id);
+        ret = pre_3a_analyze (stats);
+    }
     if (ret != XCAM_RETURN_NO_ERROR) {
         notify_calculation_failed(
             NULL, stats->get_timestamp (), "pre 3a analyze failed");
         return ret;
     }
 
-    ret = _ae_handler->analyze (results);
-    if (ret != XCAM_RETURN_NO_ERROR) {
-        notify_calculation_failed(
-            _ae_handler.ptr(), stats->get_timestamp (), "ae calculation failed");
-        return ret;
+    // AF only reads the AF statistics and its own state
+    if (_parallel_analyze.load ())
+        af_job = queue_handler_job (XCAM_3A_HANDLER_AF, _af_handler.ptr (), frame_id);
+
+    const struct {
+        X3aHandlerType       type;
+        AnalyzerHandler     *handler;
+        const char          *failed_msg;
+    } chain[XCAM_3A_HANDLER_COUNT] = {
+        {XCAM_3A_HANDLER_AE, _ae_handler.ptr (), "ae calculation failed"},
+        {XCAM_3A_HANDLER_AWB, _awb_handler.ptr (), "awb calculation failed"},
+        {XCAM_3A_HANDLER_AF, _af_handler.ptr (), "af calculation failed"},
+        {XCAM_3A_HANDLER_COMMON, _common_handler.ptr (), "3a other calculation failed"},
+    };
+
+    for (int i = 0; i < XCAM_3A_HANDLER_COUNT; ++i) {
+        if (chain[i].type == XCAM_3A_HANDLER_AF && af_job.ptr ())
+            continue;
+
+        // results after AF are held back until AF joined
+        X3aResultList &output =
+            (chain[i].type == XCAM_3A_HANDLER_COMMON && af_job.ptr ()) ? common_results : results;
+        ret = run_handler (chain[i].type, chain[i].handler, frame_id, output);
+        if (ret != XCAM_RETURN_NO_ERROR) {
+            failed_handler = chain[i].handler;
+            failed_msg = chain[i].failed_msg;
+            break;
+        }
     }
 
-    ret = _awb_handler->analyze (results);
-    if (ret != XCAM_RETURN_NO_ERROR) {
-        notify_calculation_failed(
-            _awb_handler.ptr(), stats->get_timestamp (), "awb calculation failed");
-        return ret;
+    if (af_job.ptr ()) {
+        XCamReturn af_ret = af_job->join (results);
+        record_latency (XCAM_3A_HANDLER_AF, af_job->get_usec ());
+        if (!failed_handler && af_ret != XCAM_RETURN_NO_ERROR) {
+            ret = af_ret;
+            failed_handler = af_job->get_handler ();
+            failed_msg = "af calculation failed";
+        }
+        results.splice (results.end (), common_results);
     }
 
-    ret = _af_handler->analyze (results);
-    if (ret != XCAM_RETURN_NO_ERROR) {
+    if (failed_handler) {
         notify_calculation_failed(
-            _af_handler.ptr(), stats->get_timestamp (), "af calculation failed");
+            failed_handler, stats->get_timestamp (), failed_msg);
         return ret;
     }
 
-    ret = _common_handler->analyze (results);
-    if (ret != XCAM_RETURN_NO_ERROR) {
-        notify_calculation_failed(
-            _common_handler.ptr(), stats->get_timestamp (), "3a other calculation failed");
-        return ret;
+    {
+        TraceScope trace (XCAM_TRACE_INTEGRATE, frame_id);
+        ret = post_3a_analyze (results);
     }
-
-    ret = post_3a_analyze (results);
     if (ret != XCAM_RETURN_NO_ERROR) {
         notify_calculation_failed(
             NULL, stats->get_timestamp (), "3a collect results failed");
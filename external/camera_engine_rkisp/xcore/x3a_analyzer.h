@@ -25,12 +25,43 @@
 #include <xcam_analyzer.h>
 #include <handler_interface.h>
 #include <v4l2_device.h>
+#include <thread_pool.h>
+
+#define XCAM_3A_LATENCY_BUCKETS 16
 
 namespace XCam {
 
 class X3aStats;
 class AnalyzerThread;
 class VideoBuffer;
+class X3aHandlerJob;
+
+// same order as the handler stages in XCamTraceStage
+enum X3aHandlerType {
+    XCAM_3A_HANDLER_AE = 0,
+    XCAM_3A_HANDLER_AWB,
+    XCAM_3A_HANDLER_AF,
+    XCAM_3A_HANDLER_COMMON,
+    XCAM_3A_HANDLER_COUNT,
+};
+
+/*
+ * analyze latency of one handler, buckets[i] counts the runs which took
+ * [2^i, 2^(i+1)) usec, the last bucket also counts all longer runs
+ */
+struct X3aLatencyHistogram {
+    uint64_t count;
+    int64_t  total_usec;
+    int64_t  max_usec;
+    uint32_t buckets[XCAM_3A_LATENCY_BUCKETS];
+
+    X3aLatencyHistogram ()
+        : count (0), total_usec (0), max_usec (0)
+    {
+        xcam_mem_clear (buckets);
+    }
+    void add (int64_t usec);
+};
 
 class X3aAnalyzer
     : public XAnalyzer
@@ -105,6 +136,20 @@ public:
         return _common_handler;
     }
 
+    /*
+     * parallel analyze, AF runs on a worker pool while AE -> AWB -> common
+     * run in order on the analyzer thread, AWB reads the AE result and common
+     * the AWB gains. Joined before post_3a_analyze, results keep the
+     * sequential order. Takes effect from the next statistics.
+     */
+    void set_parallel_analyze (bool enable) {
+        _parallel_analyze.store (enable);
+    }
+    bool get_parallel_analyze () const {
+        return _parallel_analyze.load ();
+    }
+    bool get_handler_latency (X3aHandlerType type, X3aLatencyHistogram &histogram);
+
     virtual XCamReturn configure ();
 protected:
     /* virtual function list */
@@ -129,6 +174,12 @@ protected:
 
 private:
     XCamReturn analyze_3a_statistics (SmartPtr<X3aStats> &stats);
+    XCamReturn run_handler (
+        X3aHandlerType type, AnalyzerHandler *handler, int32_t frame_id, X3aResultList &results);
+    SmartPtr<X3aHandlerJob> queue_handler_job (
+        X3aHandlerType type, AnalyzerHandler *handler, int32_t frame_id);
+    void record_latency (X3aHandlerType type, int64_t usec);
+    void dump_latency ();
 
     XCAM_DEAD_COPY (X3aAnalyzer);
 
@@ -140,6 +191,11 @@ private:
     SmartPtr<AwbHandler>     _awb_handler;
     SmartPtr<AfHandler>      _af_handler;
     SmartPtr<CommonHandler>  _common_handler;
+
+    std::atomic<bool>        _parallel_analyze;
+    SmartPtr<ThreadPool>     _handler_pool;
+    Mutex                    _latency_mutex;
+    X3aLatencyHistogram      _latency[XCAM_3A_HANDLER_COUNT];
 };
 
 }
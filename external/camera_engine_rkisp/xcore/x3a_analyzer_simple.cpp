@@ -146,6 +146,13 @@ XCamReturn
 X3aAnalyzerSimple::pre_3a_analyze (SmartPtr<X3aStats> &stats)
 {
     _current_stats = stats;
+
+    const XCam3AStats *standard_stats = stats->get_stats ();
+    XCAM_FAIL_RETURN (
+        WARNING,
+        standard_stats && _current_grid.fill (standard_stats),
+        XCAM_RETURN_ERROR_UNKNOWN,
+        "X3aAnalyzerSimple failed to get XCam3AStats");
     return XCAM_RETURN_NO_ERROR;
 }
 
@@ -171,28 +178,21 @@ X3aAnalyzerSimple::post_3a_analyze (X3aResultList &results)
 XCamReturn
 X3aAnalyzerSimple::analyze_awb (X3aResultList &output)
 {
-    const XCam3AStats *stats = _current_stats->get_stats ();
-    double sum_r = 0.0, sum_gr = 0.0, sum_gb = 0.0, sum_b = 0.0;
+    uint64_t sum_r = 0, sum_g = 0, sum_b = 0;
     double avg_r = 0.0, avg_gr = 0.0, avg_gb = 0.0, avg_b = 0.0;
     double target_avg = 0.0;
+    uint32_t cells = _current_grid.get_cell_count ();
     XCam3aResultWhiteBalance wb;
 
     xcam_mem_clear (wb);
-    XCAM_ASSERT (stats);
 
     // calculate avg r, gr, gb, b
-    for (uint32_t i = 0; i < stats->info.height; ++i)
-        for (uint32_t j = 0; j < stats->info.width; ++j) {
-            sum_r += (double)(stats->stats[i * stats->info.aligned_width + j].mean_cr_or_r);
-            sum_gr += (double)(stats->stats[i * stats->info.aligned_width + j].mean_y_or_g);
-            sum_gb += (double)(stats->stats[i * stats->info.aligned_width + j].mean_y_or_g);
-            sum_b += (double)(stats->stats[i * stats->info.aligned_width + j].mean_cb_or_b);
-        }
+    _current_grid.sum_means (sum_r, sum_g, sum_b);
 
-    avg_r = sum_r / (stats->info.width * stats->info.height);
-    avg_gr = sum_gr / (stats->info.width * stats->info.height);
-    avg_gb = sum_gb / (stats->info.width * stats->info.height);
-    avg_b = sum_b / (stats->info.width * stats->info.height);
+    avg_r = (double)sum_r / cells;
+    avg_gr = (double)sum_g / cells;
+    avg_gb = (double)sum_g / cells;
+    avg_b = (double)sum_b / cells;
 
     target_avg =  (avg_gr + avg_gb) / 2;
     wb.r_gain = target_avg / avg_r;
@@ -215,13 +215,6 @@ X3aAnalyzerSimple::analyze_ae (X3aResultList &output)
 {
     static const uint32_t expect_y_mean = 110;
 
-    const XCam3AStats *stats = _current_stats->get_stats ();
-    XCAM_FAIL_RETURN(
-        WARNING,
-        stats,
-        XCAM_RETURN_ERROR_UNKNOWN,
-        "failed to get XCam3AStats");
-
     double sum_y = 0.0;
     double target_exposure = 1.0;
     SmartPtr<X3aExposureResult> result = new X3aExposureResult (XCAM_3A_RESULT_EXPOSURE);
@@ -242,11 +235,8 @@ X3aAnalyzerSimple::analyze_ae (X3aResultList &output)
     }
 
     if (_ae_calculation_interval % 10 == 0) {
-        for (uint32_t i = 0; i < stats->info.height; ++i)
-            for (uint32_t j = 0; j < stats->info.width; ++j) {
-                sum_y += (double)(stats->stats[i * stats->info.aligned_width + j].avg_y);
-            }
-        sum_y /= (stats->info.width * stats->info.height);
+        sum_y = (double)_current_grid.sum_avg_y ();
+        sum_y /= _current_grid.get_cell_count ();
         target_exposure = (expect_y_mean / sum_y) * _last_target_exposure;
         target_exposure = XCAM_MAX (target_exposure, SIMPLE_MIN_TARGET_EXPOSURE_TIME);
 
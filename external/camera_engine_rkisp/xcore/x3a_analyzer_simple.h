@@ -24,6 +24,7 @@
 #include <xcam_std.h>
 #include <x3a_analyzer.h>
 #include <x3a_stats_pool.h>
+#include <x3a_stats_grid.h>
 
 namespace XCam {
 
@@ -66,6 +67,7 @@ public:
 
 private:
     SmartPtr<X3aStats>                _current_stats;
+    X3aStatsGrid                      _current_grid;
     double                            _last_target_exposure;
     bool                              _is_ae_started;
     uint32_t                          _ae_calculation_interval;
@@ -19,9 +19,16 @@
  */
 
 #include "x3a_result.h"
+#include "x3a_result_arena.h"
 
 namespace XCam {
 
+bool
+X3aResult::recycle ()
+{
+    return _arena && _arena->give_back (this);
+}
+
 void
 x3a_list_remove_result (X3aResultList &list, uint32_t type)
 {
@@ -28,8 +28,12 @@
 
 namespace XCam {
 
+class X3aResultArena;
+
 class X3aResult
+    : public RefObj
 {
+    friend class X3aResultArena;
 protected:
     explicit X3aResult (
         uint32_t type,
@@ -41,6 +45,7 @@ protected:
         , _timestamp (timestamp)
         , _ptr (NULL)
         , _processed (false)
+        , _arena (NULL)
     {}
 
 public:
@@ -72,10 +77,19 @@ public:
         return _process_type;
     }
 
+    // derived from RefObj, a result taken from an arena goes back to it
+    virtual bool recycle ();
+
 protected:
     void set_ptr (void *ptr) {
         _ptr = ptr;
     }
+    // back to the state of a new result before it is handed out again
+    virtual void reset (XCamImageProcessType process_type) {
+        _process_type = process_type;
+        _timestamp = XCam::InvalidTimestamp;
+        _processed = false;
+    }
 
     //virtual bool to_isp_config (SmartPtr<X3aIspConfig>  &config) = 0;
 
@@ -89,6 +103,9 @@ protected:
     int64_t               _timestamp;
     void                 *_ptr;
     bool                  _processed;
+
+private:
+    X3aResultArena       *_arena;
 };
 
 typedef std::list<SmartPtr<X3aResult>>  X3aResultList;
@@ -140,6 +157,15 @@ public:
         return _result;
     }
 
+protected:
+    virtual void reset (XCamImageProcessType process_type) {
+        uint32_t offset = sizeof (XCam3aResultHead);
+
+        X3aResult::reset (process_type);
+        memset ((uint8_t*)(_result) + offset, 0, sizeof (StandardResult) + _extra_size - offset);
+        _result->head.process_type = process_type;
+    }
+
 private:
     StandardResult *_result;
     uint32_t        _extra_size;
@@ -0,0 +1,122 @@
+/*
+ * x3a_result_arena.cpp - reusable 3a results
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "x3a_result_arena.h"
+
+namespace XCam {
+
+X3aResultArena *
+X3aResultArena::instance ()
+{
+    // never freed, released results find their arena at any time
+    static X3aResultArena *arena = new X3aResultArena;
+    return arena;
+}
+
+X3aResultArena::X3aResultArena ()
+    : _slot_count (0)
+    , _check (false)
+    , _frame_allocated (0)
+{
+    xcam_mem_clear (_slots);
+    xcam_mem_clear (_stats);
+}
+
+X3aResultArena::Slot *
+X3aResultArena::find_slot (uint32_t type)
+{
+    for (uint32_t i = 0; i < _slot_count; ++i) {
+        if (_slots[i].type == type)
+            return &_slots[i];
+    }
+    if (_slot_count >= XCAM_3A_RESULT_ARENA_SLOTS)
+        return NULL;
+
+    Slot *slot = &_slots[_slot_count++];
+    slot->type = type;
+    slot->count = 0;
+    return slot;
+}
+
+void
+X3aResultArena::begin_frame ()
+{
+    SmartLock locker (_mutex);
+    if (_check && _frame_allocated && _stats.frames > XCAM_3A_RESULT_ARENA_WARMUP) {
+        XCAM_LOG_ERROR ("3a result arena allocated %d results in frame(%" PRIu64 ")",
+                        _frame_allocated, _stats.frames);
+        XCAM_ASSERT (false);
+    }
+    _frame_allocated = 0;
+    ++_stats.frames;
+}
+
+X3aResultArenaStats
+X3aResultArena::get_stats ()
+{
+    SmartLock locker (_mutex);
+    return _stats;
+}
+
+X3aResult *
+X3aResultArena::take (uint32_t type, XCamImageProcessType process_type)
+{
+    X3aResult *result = NULL;
+    {
+        SmartLock locker (_mutex);
+        Slot *slot = find_slot (type);
+        if (!slot || !slot->count)
+            return NULL;
+
+        result = slot->results[--slot->count];
+        ++_stats.reused;
+    }
+
+    result->reset (process_type);
+    return result;
+}
+
+void
+X3aResultArena::adopt (X3aResult *result)
+{
+    XCAM_ASSERT (result && !result->_arena);
+    result->_arena = this;
+
+    SmartLock locker (_mutex);
+    ++_frame_allocated;
+    ++_stats.allocated;
+}
+
+bool
+X3aResultArena::give_back (X3aResult *result)
+{
+    XCAM_ASSERT (result && result->_arena == this);
+
+    SmartLock locker (_mutex);
+    Slot *slot = find_slot (result->get_type ());
+    if (!slot || slot->count >= XCAM_3A_RESULT_ARENA_DEPTH) {
+        ++_stats.dropped;
+        return false;
+    }
+
+    slot->results[slot->count++] = result;
+    return true;
+}
+
+};
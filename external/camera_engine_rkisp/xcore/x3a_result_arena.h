@@ -0,0 +1,104 @@
+/*
+ * x3a_result_arena.h - reusable 3a results
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_3A_RESULT_ARENA_H
+#define XCAM_3A_RESULT_ARENA_H
+
+#include <xcam_std.h>
+#include <xcam_mutex.h>
+#include <x3a_result.h>
+
+// result types with a slot, further types are always allocated
+#define XCAM_3A_RESULT_ARENA_SLOTS   48
+// released results kept per type, covers results still held by consumers
+#define XCAM_3A_RESULT_ARENA_DEPTH   4
+// frames allowed to allocate while the slots fill up
+#define XCAM_3A_RESULT_ARENA_WARMUP  8
+
+namespace XCam {
+
+struct X3aResultArenaStats {
+    uint64_t    frames;
+    uint64_t    reused;
+    uint64_t    allocated;
+    // released while the slot was full
+    uint64_t    dropped;
+};
+
+/*
+ * Keeps a fixed slot of released results per result type. A producer takes
+ * a result from the slot of its type, only an empty slot costs an
+ * allocation; the result returns to the slot once its last SmartPtr is
+ * gone, see X3aResult::recycle. The arena lives as long as the process,
+ * results may outlive any analyzer.
+ */
+class X3aResultArena {
+public:
+    static X3aResultArena *instance ();
+
+    // start of a 3a analysis, with checking on, asserts the previous one did not allocate
+    void begin_frame ();
+    void set_check_allocations (bool check) {
+        _check = check;
+    }
+    X3aResultArenaStats get_stats ();
+
+    template <typename ResultT, typename... Args>
+    ResultT *create (uint32_t type, XCamImageProcessType process_type, Args... args) {
+        X3aResult *taken = take (type, process_type);
+        ResultT *result = dynamic_cast<ResultT *> (taken);
+        if (taken && !result)
+            delete taken;
+        if (!result) {
+            result = new ResultT (args...);
+            adopt (result);
+        }
+        return result;
+    }
+
+    // called by X3aResult::recycle, false if the slot is full
+    bool give_back (X3aResult *result);
+
+private:
+    explicit X3aResultArena ();
+
+    struct Slot {
+        uint32_t     type;
+        uint32_t     count;
+        X3aResult   *results[XCAM_3A_RESULT_ARENA_DEPTH];
+    };
+
+    Slot *find_slot (uint32_t type);
+    X3aResult *take (uint32_t type, XCamImageProcessType process_type);
+    void adopt (X3aResult *result);
+
+    XCAM_DEAD_COPY (X3aResultArena);
+
+private:
+    Mutex                  _mutex;
+    Slot                   _slots[XCAM_3A_RESULT_ARENA_SLOTS];
+    uint32_t               _slot_count;
+    bool                   _check;
+    uint32_t               _frame_allocated;
+    X3aResultArenaStats    _stats;
+};
+
+};
+
+#endif //XCAM_3A_RESULT_ARENA_H
@@ -19,12 +19,13 @@
  */
 
 #include "x3a_result_factory.h"
+#include "x3a_result_arena.h"
 
 namespace XCam {
 
 #define XCAM_3A_RESULT_FACTORY(DataType, res_type, from)            \
-    DataType *ret =                                                 \
-        new DataType (res_type);                                    \
+    DataType *ret = X3aResultArena::instance ()->create<DataType> ( \
+        res_type, XCAM_IMAGE_PROCESS_ALWAYS, res_type);             \
     if (from) {                                                     \
         uint32_t type = xcam_3a_result_type (from);                 \
         if (type != XCAM_3A_RESULT_NULL && type != res_type) {      \
@@ -0,0 +1,141 @@
+/*
+ * x3a_stats_grid.cpp - structure of arrays view of 3a grid stats
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "x3a_stats_grid.h"
+
+// keeps every array on a SIMD register boundary
+#define XCAM_STATS_GRID_ALIGN 16
+
+namespace XCam {
+
+X3aStatsGrid::X3aStatsGrid ()
+    : _block (NULL)
+    , _capacity (0)
+    , _count (0)
+    , _avg_y (NULL)
+    , _valid_wb_count (NULL)
+    , _f_value1 (NULL)
+    , _f_value2 (NULL)
+    , _mean_r (NULL)
+    , _mean_g (NULL)
+    , _mean_b (NULL)
+{
+}
+
+X3aStatsGrid::~X3aStatsGrid ()
+{
+    xcam_free (_block);
+}
+
+bool
+X3aStatsGrid::reserve (uint32_t count)
+{
+    if (count <= _capacity)
+        return true;
+
+    uint32_t aligned = XCAM_ALIGN_UP (count, XCAM_STATS_GRID_ALIGN);
+    // 4 uint32_t and 3 uint8_t arrays, plus room to align the block
+    uint8_t *block = (uint8_t *) xcam_malloc (
+                         aligned * (sizeof (uint32_t) * 4 + 3) + XCAM_STATS_GRID_ALIGN);
+    XCAM_FAIL_RETURN (
+        ERROR, block, false,
+        "X3aStatsGrid allocate %d cells failed", count);
+
+    xcam_free (_block);
+    _block = block;
+    _capacity = aligned;
+
+    uint8_t *ptr = (uint8_t *) XCAM_ALIGN_UP ((uintptr_t) block, XCAM_STATS_GRID_ALIGN);
+    _avg_y = (uint32_t *) ptr;
+    _valid_wb_count = _avg_y + aligned;
+    _f_value1 = _valid_wb_count + aligned;
+    _f_value2 = _f_value1 + aligned;
+    _mean_r = (uint8_t *) (_f_value2 + aligned);
+    _mean_g = _mean_r + aligned;
+    _mean_b = _mean_g + aligned;
+    return true;
+}
+
+bool
+X3aStatsGrid::fill (const XCam3AStats *stats)
+{
+    XCAM_ASSERT (stats);
+
+    uint32_t width = stats->info.width;
+    uint32_t height = stats->info.height;
+    uint32_t stride = stats->info.aligned_width;
+
+    if (!reserve (width * height)) {
+        _count = 0;
+        return false;
+    }
+
+    uint32_t index = 0;
+    for (uint32_t i = 0; i < height; ++i) {
+        const XCamGridStat *row = stats->stats + i * stride;
+        for (uint32_t j = 0; j < width; ++j, ++index) {
+            _avg_y[index] = row[j].avg_y;
+            _mean_r[index] = row[j].mean_cr_or_r;
+            _mean_g[index] = row[j].mean_y_or_g;
+            _mean_b[index] = row[j].mean_cb_or_b;
+            _valid_wb_count[index] = row[j].valid_wb_count;
+            _f_value1[index] = row[j].f_value1;
+            _f_value2[index] = row[j].f_value2;
+        }
+    }
+    _count = index;
+    return true;
+}
+
+uint64_t
+X3aStatsGrid::sum_avg_y () const
+{
+    // independent lanes, no loop carried dependency on a single accumulator
+    uint64_t sum[4] = {0, 0, 0, 0};
+    uint32_t i = 0;
+
+    for (; i + 4 <= _count; i += 4) {
+        sum[0] += _avg_y[i];
+        sum[1] += _avg_y[i + 1];
+        sum[2] += _avg_y[i + 2];
+        sum[3] += _avg_y[i + 3];
+    }
+    for (; i < _count; ++i)
+        sum[0] += _avg_y[i];
+
+    return sum[0] + sum[1] + sum[2] + sum[3];
+}
+
+void
+X3aStatsGrid::sum_means (uint64_t &sum_r, uint64_t &sum_g, uint64_t &sum_b) const
+{
+    // 8 bit means, a 32 bit lane holds 2^24 cells
+    uint32_t r = 0, g = 0, b = 0;
+
+    for (uint32_t i = 0; i < _count; ++i) {
+        r += _mean_r[i];
+        g += _mean_g[i];
+        b += _mean_b[i];
+    }
+    sum_r = r;
+    sum_g = g;
+    sum_b = b;
+}
+
+};
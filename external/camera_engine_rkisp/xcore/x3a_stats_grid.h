@@ -0,0 +1,90 @@
+/*
+ * x3a_stats_grid.h - structure of arrays view of 3a grid stats
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_3A_STATS_GRID_H
+#define XCAM_3A_STATS_GRID_H
+
+#include <xcam_std.h>
+#include <base/xcam_3a_stats.h>
+
+namespace XCam {
+
+/*
+ * The grid cells of an XCam3AStats split into one contiguous array per
+ * field, row after row without the aligned_width padding. Sums over a field
+ * then walk a dense array instead of striding over XCamGridStat records, so
+ * the compiler can keep them in SIMD registers. The arrays are kept across
+ * fills and only grow with the grid.
+ */
+class X3aStatsGrid {
+public:
+    explicit X3aStatsGrid ();
+    ~X3aStatsGrid ();
+
+    // one pass over the width x height cells of @stats
+    bool fill (const XCam3AStats *stats);
+
+    uint32_t get_cell_count () const {
+        return _count;
+    }
+    const uint32_t *get_avg_y () const {
+        return _avg_y;
+    }
+    const uint8_t *get_mean_r () const {
+        return _mean_r;
+    }
+    const uint8_t *get_mean_g () const {
+        return _mean_g;
+    }
+    const uint8_t *get_mean_b () const {
+        return _mean_b;
+    }
+    const uint32_t *get_valid_wb_count () const {
+        return _valid_wb_count;
+    }
+    const uint32_t *get_f_value1 () const {
+        return _f_value1;
+    }
+    const uint32_t *get_f_value2 () const {
+        return _f_value2;
+    }
+
+    uint64_t sum_avg_y () const;
+    void sum_means (uint64_t &sum_r, uint64_t &sum_g, uint64_t &sum_b) const;
+
+private:
+    bool reserve (uint32_t count);
+    XCAM_DEAD_COPY (X3aStatsGrid);
+
+private:
+    uint8_t       *_block;
+    uint32_t       _capacity;
+    uint32_t       _count;
+    uint32_t      *_avg_y;
+    uint32_t      *_valid_wb_count;
+    uint32_t      *_f_value1;
+    uint32_t      *_f_value2;
+    uint8_t       *_mean_r;
+    uint8_t       *_mean_g;
+    uint8_t       *_mean_b;
+};
+
+};
+
+#endif //XCAM_3A_STATS_GRID_H
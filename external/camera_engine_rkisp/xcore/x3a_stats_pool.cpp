@@ -71,6 +71,8 @@ X3aStats::get_stats ()
 X3aStatsPool::X3aStatsPool ()
     : _bit_depth (XCAM_3A_STATS_DEFAULT_BIT_DEPTH)
 {
+    // stats are requested every frame, recycle them without allocation
+    set_proxy_recycle (true);
 }
 
 void
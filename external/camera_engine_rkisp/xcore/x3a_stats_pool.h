@@ -33,7 +33,8 @@ class X3aStatsData
 public:
     explicit X3aStatsData (XCam3AStats *data);
     ~X3aStatsData ();
-    XCam3AStats *get_stats () {
+    // derived data may fill the standard stats on first use
+    virtual XCam3AStats *get_stats () {
         return _data;
     }
 
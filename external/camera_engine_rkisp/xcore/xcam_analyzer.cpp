@@ -28,6 +28,12 @@ namespace XCam {
 AnalyzerThread::AnalyzerThread (XAnalyzer *analyzer)
     : Thread ("AnalyzerThread")
     , _analyzer (analyzer)
+    , _policy (XCAM_ANALYZER_STATS_ALL)
+    , _interval (1)
+    , _stats_index (0)
+    , _analyzed (0)
+    , _coalesced (0)
+    , _dropped (0)
 {}
 
 AnalyzerThread::~AnalyzerThread ()
@@ -42,6 +48,32 @@ AnalyzerThread::push_stats (const SmartPtr<VideoBuffer> &buffer)
     return true;
 }
 
+bool
+AnalyzerThread::set_stats_policy (XAnalyzerStatsPolicy policy, uint32_t interval)
+{
+    XCAM_FAIL_RETURN (
+        ERROR, policy >= XCAM_ANALYZER_STATS_ALL && policy <= XCAM_ANALYZER_STATS_EVERY_NTH, false,
+        "analyzer thread set unknown stats policy(%d)", policy);
+    XCAM_FAIL_RETURN (
+        ERROR, policy != XCAM_ANALYZER_STATS_EVERY_NTH || interval > 0, false,
+        "analyzer thread set stats policy failed, interval must be > 0");
+
+    _interval.store (interval ? interval : 1);
+    _policy.store (policy);
+    XCAM_LOG_INFO ("analyzer thread stats policy:%d, interval:%d", policy, interval);
+    return true;
+}
+
+XAnalyzerStatsCounters
+AnalyzerThread::get_stats_counters () const
+{
+    XAnalyzerStatsCounters counters;
+    counters.analyzed = _analyzed.load ();
+    counters.coalesced = _coalesced.load ();
+    counters.dropped = _dropped.load ();
+    return counters;
+}
+
 bool
 AnalyzerThread::started ()
 {
@@ -68,10 +100,30 @@ AnalyzerThread::loop ()
         XCAM_LOG_DEBUG ("analyzer thread got empty stats, stop thread");
         return false;
     }
-    //while ((latest_stats = _stats_queue.pop (0)).ptr ()) {
-    //    stats = latest_stats;
-    //    XCAM_LOG_WARNING ("lost 3a stats since 3a analyzer too slow");
-    //}
+
+    switch (_policy.load ()) {
+    case XCAM_ANALYZER_STATS_LATEST: {
+        uint32_t coalesced = 0;
+        while (!_stats_queue.is_empty () && (latest_stats = _stats_queue.pop (0)).ptr ()) {
+            stats = latest_stats;
+            ++coalesced;
+        }
+        if (coalesced) {
+            _coalesced.fetch_add (coalesced);
+            XCAM_LOG_DEBUG ("analyzer thread coalesced %d stale 3a stats", coalesced);
+        }
+        break;
+    }
+    case XCAM_ANALYZER_STATS_EVERY_NTH:
+        if (_stats_index++ % _interval.load ()) {
+            _dropped.fetch_add (1);
+            return true;
+        }
+        break;
+    default:
+        break;
+    }
+    _analyzed.fetch_add (1);
 
     XCamReturn ret = _analyzer->analyze (stats);
     if (ret == XCAM_RETURN_NO_ERROR || ret == XCAM_RETURN_BYPASS)
@@ -107,7 +159,10 @@ AnalyzerCallback::x3a_calculation_failed (XAnalyzer *analyzer, int64_t timestamp
 }
 
 XAnalyzer::XAnalyzer (const char *name)
-    : _name (NULL)
+    : _device (NULL)
+    , _isp_stats_device (NULL)
+    , _isp_params_device (NULL)
+    , _name (NULL)
     , _sync (false)
     , _started (false)
     , _width (0)
@@ -192,6 +247,18 @@ XAnalyzer::set_sync_mode (bool sync)
     return XCAM_RETURN_NO_ERROR;
 }
 
+bool
+XAnalyzer::set_stats_policy (XAnalyzerStatsPolicy policy, uint32_t interval)
+{
+    return _analyzer_thread->set_stats_policy (policy, interval);
+}
+
+XAnalyzerStatsCounters
+XAnalyzer::get_stats_counters () const
+{
+    return _analyzer_thread->get_stats_counters ();
+}
+
 XCamReturn
 XAnalyzer::start ()
 {
@@ -222,6 +289,11 @@ XAnalyzer::stop ()
     if (!_sync) {
         _analyzer_thread->triger_stop ();
         _analyzer_thread->stop ();
+
+        XAnalyzerStatsCounters counters = _analyzer_thread->get_stats_counters ();
+        XCAM_LOG_INFO (
+            "Analyzer(%s) stats analyzed:%" PRIu64 " coalesced:%" PRIu64 " dropped:%" PRIu64,
+            XCAM_STR(get_name()), counters.analyzed, counters.coalesced, counters.dropped);
     }
 
     _started = false;
@@ -33,6 +33,27 @@ namespace XCam {
 
 class XAnalyzer;
 
+// which queued statistics the analyzer thread runs on when 3a falls behind
+enum XAnalyzerStatsPolicy {
+    XCAM_ANALYZER_STATS_ALL = 0,
+    // drop the stale statistics, only analyze the latest queued one
+    XCAM_ANALYZER_STATS_LATEST,
+    // analyze one of every N statistics
+    XCAM_ANALYZER_STATS_EVERY_NTH,
+};
+
+struct XAnalyzerStatsCounters {
+    uint64_t analyzed;
+    // skipped because newer statistics were queued, STATS_LATEST
+    uint64_t coalesced;
+    // skipped by the interval, STATS_EVERY_NTH
+    uint64_t dropped;
+
+    XAnalyzerStatsCounters ()
+        : analyzed (0), coalesced (0), dropped (0)
+    {}
+};
+
 class AnalyzerThread
     : public Thread
 {
@@ -45,6 +66,10 @@ public:
     }
     bool push_stats (const SmartPtr<VideoBuffer> &buffer);
 
+    // @interval only used by STATS_EVERY_NTH, must be > 0
+    bool set_stats_policy (XAnalyzerStatsPolicy policy, uint32_t interval = 1);
+    XAnalyzerStatsCounters get_stats_counters () const;
+
 protected:
     virtual bool started ();
     virtual void stopped () {
@@ -55,6 +80,13 @@ protected:
 private:
     XAnalyzer              *_analyzer;
     SafeList<VideoBuffer>   _stats_queue;
+
+    std::atomic<int>        _policy;
+    std::atomic<uint32_t>   _interval;
+    uint32_t                _stats_index;
+    std::atomic<uint64_t>   _analyzed;
+    std::atomic<uint64_t>   _coalesced;
+    std::atomic<uint64_t>   _dropped;
 };
 
 class AnalyzerCallback {
@@ -87,6 +119,9 @@ public:
     bool get_sync_mode () const {
         return _sync;
     };
+    // only applies to the analyzer thread, every statistics is analyzed in sync mode
+    bool set_stats_policy (XAnalyzerStatsPolicy policy, uint32_t interval = 1);
+    XAnalyzerStatsCounters get_stats_counters () const;
     XCamReturn start ();
     XCamReturn stop ();
     XCamReturn push_buffer (const SmartPtr<VideoBuffer> &buffer);
@@ -21,16 +21,9 @@
 #include "config.h"
 
 #include <base/xcam_common.h>
-#include <base/log.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <sys/ioctl.h>
-#include <stdarg.h>
-#ifdef ANDROID_OS
-#include <cutils/properties.h>
-#endif
-
-static char log_file_name[XCAM_MAX_STR_SIZE] = {0};
 
 uint32_t xcam_version ()
 {
@@ -91,80 +84,3 @@ xcam_fourcc_to_string (uint32_t fourcc)
     memcpy (str, &fourcc, 4);
     return str;
 }
-
-bool xcam_get_enviroment_value(const char* variable, int* value)
-{
-    if (!variable || !value) {
-         return false;
-
-    }
-
-    char* valueStr = getenv(variable);
-    if (valueStr) {
-        *value = strtoul(valueStr, nullptr, 0);
-        return true;
-    }
-    return false;
-}
-
-void xcam_print_log (int level, const char* format, ...) {
-    char buffer[XCAM_MAX_STR_SIZE] = {0};
-
-    va_list va_list;
-    va_start (va_list, format);
-    vsnprintf (buffer, XCAM_MAX_STR_SIZE, format, va_list);
-    va_end (va_list);
-
-    if (strlen (log_file_name) > 0) {
-        FILE* p_file = fopen (log_file_name, "ab+");
-        if (NULL != p_file) {
-            fwrite (buffer, sizeof (buffer[0]), strlen (buffer), p_file);
-            fclose (p_file);
-        } else {
-            printf("error! can't open log file !\n");
-        }
-        return ;
-    }
-#ifdef ANDROID_OS
-    char property_value[PROPERTY_VALUE_MAX] = {0};
-
-    property_get("persist.vendor.rkisp.log", property_value, "0");
-    int cam_engine_log_level = atoi(property_value);
-
-    if (level <= cam_engine_log_level) {
-        switch(level) {
-        case ERROR_LEVEL:
-            ALOGE("%s", buffer);
-            break;
-        case WARNING_LEVEL:
-            ALOGW("%s", buffer);
-            break;
-        case INFO_LEVEL:
-            ALOGI("%s", buffer);
-            break;
-        case VERBOSE_LEVEL:
-            ALOGV("%s", buffer);
-            break;
-        case DEBUG_LEVEL:
-            ALOGD("%s", buffer);
-            break;
-        default:
-            ALOGE("debug level not support");
-            break;
-        }
-    }
-#else
-    int cam_engine_log_level = 0;
-    xcam_get_enviroment_value("persist_camera_engine_log", &cam_engine_log_level);
-    if (level <= cam_engine_log_level)
-        printf ("%s", buffer);
-#endif
-}
-
-void xcam_set_log (const char* file_name) {
-    if (NULL != file_name) {
-        memset (log_file_name, 0, XCAM_MAX_STR_SIZE);
-        strncpy (log_file_name, file_name, XCAM_MAX_STR_SIZE);
-    }
-}
-
@@ -0,0 +1,736 @@
+/*
+ * xcam_log.cpp - asynchronous log backend
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Log calls only record the format pointer and the raw arguments into a
+ * per-thread single-producer ring; a background thread formats and writes
+ * them out. Strings are copied into the record because their storage
+ * (e.g. basename() buffers) may not outlive the call. A record which does
+ * not fit is formatted in place, a full ring drops the record. Errors are
+ * written synchronously after draining everything recorded before them.
+ * The log thread runs as SCHED_BATCH so waking it does not preempt the caller.
+ */
+
+#include "config.h"
+
+#include <base/xcam_common.h>
+#include <base/log.h>
+#include <stdarg.h>
+#include <semaphore.h>
+#include <sched.h>
+#include <time.h>
+#include <atomic>
+#include <new>
+#ifdef ANDROID_OS
+#include <cutils/properties.h>
+#endif
+
+#define XCAM_LOG_RING_SLOTS      128
+#define XCAM_LOG_RECORD_ARGS     232
+#define XCAM_LOG_SPEC_MAX        32
+#define XCAM_LOG_RELOAD_SEC      1
+
+int xcam_log_level_cache = XCAM_LOG_LEVEL_UNSET;
+
+namespace {
+
+enum LogArgType {
+    LOG_ARG_NONE = 0,
+    LOG_ARG_PERCENT,
+    LOG_ARG_INT,
+    LOG_ARG_LONG,
+    LOG_ARG_LLONG,
+    LOG_ARG_SIZE,
+    LOG_ARG_INTMAX,
+    LOG_ARG_PTRDIFF,
+    LOG_ARG_DOUBLE,
+    LOG_ARG_LDOUBLE,
+    LOG_ARG_STRING,
+    LOG_ARG_POINTER,
+};
+
+struct LogSpec {
+    const char   *end;
+    bool          star_width;
+    bool          star_precision;
+    LogArgType    type;
+};
+
+struct LogRecord {
+    int32_t       level;
+    uint16_t      arg_size;
+    uint16_t      preformatted;
+    const char   *format;
+    uint8_t       args[XCAM_LOG_RECORD_ARGS];
+};
+
+struct LogRing {
+    std::atomic<uint32_t>  head;      // written by the owner thread
+    std::atomic<uint32_t>  tail;      // written by the log thread
+    std::atomic<bool>      orphaned;
+    std::atomic<uint32_t>  recorded;  // written by the owner thread
+    std::atomic<uint32_t>  dropped;   // written by the owner thread
+    uint32_t               reported_dropped;
+    LogRing               *next;
+    LogRecord              records[XCAM_LOG_RING_SLOTS];
+};
+
+pthread_once_t         log_once = PTHREAD_ONCE_INIT;
+pthread_key_t          log_ring_key;
+pthread_mutex_t        log_mutex = PTHREAD_MUTEX_INITIALIZER;
+sem_t                  log_wakeup;
+std::atomic<bool>      log_thread_sleeping (false);
+bool                   log_async = false;
+
+// protected by log_mutex
+LogRing               *log_rings = NULL;
+uint64_t               log_retired_recorded = 0;
+uint64_t               log_retired_dropped = 0;
+char                   log_file_name[XCAM_MAX_STR_SIZE] = {0};
+FILE                  *log_file = NULL;
+char                   log_line[XCAM_MAX_STR_SIZE];
+
+const char *
+parse_spec (const char *p, LogSpec &spec)
+{
+    // p points to '%'
+    const char *q = p + 1;
+    bool is_long_double = false;
+    int long_num = 0;
+    LogArgType int_type = LOG_ARG_INT;
+
+    spec.star_width = false;
+    spec.star_precision = false;
+    spec.type = LOG_ARG_NONE;
+
+    if (*q == '%') {
+        spec.type = LOG_ARG_PERCENT;
+        spec.end = q + 1;
+        return spec.end;
+    }
+
+    while (*q && strchr ("-+ #0'", *q))
+        ++q;
+    if (*q == '*') {
+        spec.star_width = true;
+        ++q;
+    } else {
+        while (*q >= '0' && *q <= '9')
+            ++q;
+    }
+    if (*q == '.') {
+        ++q;
+        if (*q == '*') {
+            spec.star_precision = true;
+            ++q;
+        } else {
+            while (*q >= '0' && *q <= '9')
+                ++q;
+        }
+    }
+
+    for (;; ++q) {
+        if (*q == 'h') {
+            continue;
+        } else if (*q == 'l') {
+            ++long_num;
+        } else if (*q == 'q') {
+            long_num = 2;
+        } else if (*q == 'j') {
+            int_type = LOG_ARG_INTMAX;
+        } else if (*q == 'z') {
+            int_type = LOG_ARG_SIZE;
+        } else if (*q == 't') {
+            int_type = LOG_ARG_PTRDIFF;
+        } else if (*q == 'L') {
+            is_long_double = true;
+        } else {
+            break;
+        }
+    }
+    if (int_type == LOG_ARG_INT && long_num)
+        int_type = (long_num == 1) ? LOG_ARG_LONG : LOG_ARG_LLONG;
+
+    switch (*q) {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        spec.type = int_type;
+        break;
+    case 'c':
+        spec.type = LOG_ARG_INT;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        spec.type = is_long_double ? LOG_ARG_LDOUBLE : LOG_ARG_DOUBLE;
+        break;
+    case 's':
+        spec.type = LOG_ARG_STRING;
+        break;
+    case 'p':
+        spec.type = LOG_ARG_POINTER;
+        break;
+    default:
+        // unsupported or truncated conversion, printed as literal text
+        spec.type = LOG_ARG_NONE;
+        spec.end = *q ? q + 1 : q;
+        return spec.end;
+    }
+
+    spec.end = q + 1;
+    return spec.end;
+}
+
+#define LOG_PUT_ARG(TYPE, ptr, end, args)                   \
+    do {                                                    \
+        TYPE value = va_arg (args, TYPE);                   \
+        if ((ptr) + sizeof (TYPE) > (end))                  \
+            return false;                                   \
+        memcpy ((ptr), &value, sizeof (TYPE));              \
+        (ptr) += sizeof (TYPE);                             \
+    } while (0)
+
+bool
+encode_args (LogRecord &record, const char *format, va_list args)
+{
+    uint8_t *ptr = record.args;
+    uint8_t *end = record.args + sizeof (record.args);
+    LogSpec spec;
+
+    for (const char *p = strchr (format, '%'); p; p = strchr (spec.end, '%')) {
+        parse_spec (p, spec);
+        if (spec.star_width)
+            LOG_PUT_ARG (int, ptr, end, args);
+        if (spec.star_precision)
+            LOG_PUT_ARG (int, ptr, end, args);
+
+        switch (spec.type) {
+        case LOG_ARG_INT:
+            LOG_PUT_ARG (int, ptr, end, args);
+            break;
+        case LOG_ARG_LONG:
+            LOG_PUT_ARG (long, ptr, end, args);
+            break;
+        case LOG_ARG_LLONG:
+            LOG_PUT_ARG (long long, ptr, end, args);
+            break;
+        case LOG_ARG_SIZE:
+            LOG_PUT_ARG (size_t, ptr, end, args);
+            break;
+        case LOG_ARG_INTMAX:
+            LOG_PUT_ARG (intmax_t, ptr, end, args);
+            break;
+        case LOG_ARG_PTRDIFF:
+            LOG_PUT_ARG (ptrdiff_t, ptr, end, args);
+            break;
+        case LOG_ARG_DOUBLE:
+            LOG_PUT_ARG (double, ptr, end, args);
+            break;
+        case LOG_ARG_LDOUBLE:
+            LOG_PUT_ARG (long double, ptr, end, args);
+            break;
+        case LOG_ARG_POINTER:
+            LOG_PUT_ARG (void *, ptr, end, args);
+            break;
+        case LOG_ARG_STRING: {
+            const char *str = va_arg (args, const char *);
+            if (!str)
+                str = "(null)";
+            if (ptr >= end)
+                return false;
+            size_t len = strnlen (str, end - ptr - 1);
+            memcpy (ptr, str, len);
+            ptr[len] = '\0';
+            ptr += len + 1;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    record.arg_size = ptr - record.args;
+    return true;
+}
+
+#define LOG_GET_ARG(TYPE, value, ptr)                       \
+    do {                                                    \
+        memcpy (&(value), (ptr), sizeof (TYPE));            \
+        (ptr) += sizeof (TYPE);                             \
+    } while (0)
+
+template <typename T>
+int
+print_arg (char *out, size_t size, const char *spec, const int *stars, int star_num, T value)
+{
+    switch (star_num) {
+    case 0:
+        return snprintf (out, size, spec, value);
+    case 1:
+        return snprintf (out, size, spec, stars[0], value);
+    default:
+        return snprintf (out, size, spec, stars[0], stars[1], value);
+    }
+}
+
+void
+format_record (const LogRecord &record, char *out, size_t size)
+{
+    const uint8_t *ptr = record.args;
+    const char *text = record.format;
+    char spec_str[XCAM_LOG_SPEC_MAX];
+    size_t pos = 0;
+    LogSpec spec;
+
+    if (record.preformatted) {
+        snprintf (out, size, "%s", (const char *)record.args);
+        return;
+    }
+
+    for (const char *p = strchr (text, '%'); p && pos < size - 1; p = strchr (text, '%')) {
+        size_t literal = XCAM_MIN ((size_t)(p - text), size - 1 - pos);
+        memcpy (out + pos, text, literal);
+        pos += literal;
+
+        parse_spec (p, spec);
+        text = spec.end;
+        size_t spec_len = spec.end - p;
+        if (spec.type == LOG_ARG_PERCENT) {
+            if (pos < size - 1)
+                out[pos++] = '%';
+            continue;
+        }
+
+        int stars[2];
+        int star_num = 0;
+        if (spec.star_width)
+            LOG_GET_ARG (int, stars[star_num++], ptr);
+        if (spec.star_precision)
+            LOG_GET_ARG (int, stars[star_num++], ptr);
+
+        if (spec.type == LOG_ARG_NONE || spec_len >= sizeof (spec_str)) {
+            // keep the spec as text, its argument is still consumed below
+            literal = XCAM_MIN (spec_len, size - 1 - pos);
+            memcpy (out + pos, p, literal);
+            pos += literal;
+            spec_str[0] = '\0';
+        } else {
+            memcpy (spec_str, p, spec_len);
+            spec_str[spec_len] = '\0';
+        }
+
+        char *dst = out + pos;
+        size_t left = size - pos;
+        int ret = 0;
+        switch (spec.type) {
+        case LOG_ARG_INT: {
+            int value;
+            LOG_GET_ARG (int, value, ptr);
+            ret = print_arg (dst, left, spec_str, stars, star_num, value);
+            break;
+        }
+        case LOG_ARG_LONG: {
+            long value;
+            LOG_GET_ARG (long, value, ptr);
+            ret = print_arg (dst, left, spec_str, stars, star_num, value);
+            break;
+        }
+        case LOG_ARG_LLONG: {
+            long long value;
+            LOG_GET_ARG (long long, value, ptr);
+            ret = print_arg (dst, left, spec_str, stars, star_num, value);
+            break;
+        }
+        case LOG_ARG_SIZE: {
+            size_t value;
+            LOG_GET_ARG (size_t, value, ptr);
+            ret = print_arg (dst, left, spec_str, stars, star_num, value);
+            break;
+        }
+        case LOG_ARG_INTMAX: {
+            intmax_t value;
+            LOG_GET_ARG (intmax_t, value, ptr);
+            ret = print_arg (dst, left, spec_str, stars, star_num, value);
+            break;
+        }
+        case LOG_ARG_PTRDIFF: {
+            ptrdiff_t value;
+            LOG_GET_ARG (ptrdiff_t, value, ptr);
+            ret = print_arg (dst, left, spec_str, stars, star_num, value);
+            break;
+        }
+        case LOG_ARG_DOUBLE: {
+            double value;
+            LOG_GET_ARG (double, value, ptr);
+            ret = print_arg (dst, left, spec_str, stars, star_num, value);
+            break;
+        }
+        case LOG_ARG_LDOUBLE: {
+            long double value;
+            LOG_GET_ARG (long double, value, ptr);
+            ret = print_arg (dst, left, spec_str, stars, star_num, value);
+            break;
+        }
+        case LOG_ARG_POINTER: {
+            void *value;
+            LOG_GET_ARG (void *, value, ptr);
+            ret = print_arg (dst, left, spec_str, stars, star_num, value);
+            break;
+        }
+        case LOG_ARG_STRING: {
+            const char *value = (const char *)ptr;
+            ptr += strlen (value) + 1;
+            ret = print_arg (dst, left, spec_str, stars, star_num, value);
+            break;
+        }
+        default:
+            break;
+        }
+        if (ret > 0)
+            pos += XCAM_MIN ((size_t)ret, left - 1);
+    }
+
+    if (pos < size - 1) {
+        size_t literal = XCAM_MIN (strlen (text), size - 1 - pos);
+        memcpy (out + pos, text, literal);
+        pos += literal;
+    }
+    out[pos] = '\0';
+}
+
+int
+read_log_setting ()
+{
+#ifdef ANDROID_OS
+    char property_value[PROPERTY_VALUE_MAX] = {0};
+
+    property_get("persist.vendor.rkisp.log", property_value, "0");
+    return atoi(property_value);
+#else
+    char* value_str = getenv("persist_camera_engine_log");
+    if (value_str)
+        return strtoul(value_str, nullptr, 0);
+    return 0;
+#endif
+}
+
+// log_mutex must be held
+void
+output_log (int level, const char *buffer)
+{
+    if (log_file_name[0]) {
+        if (!log_file)
+            log_file = fopen (log_file_name, "ab+");
+        if (NULL != log_file) {
+            fwrite (buffer, sizeof (buffer[0]), strlen (buffer), log_file);
+        } else {
+            printf("error! can't open log file !\n");
+        }
+        return ;
+    }
+#ifdef ANDROID_OS
+    switch(level) {
+    case ERROR_LEVEL:
+        ALOGE("%s", buffer);
+        break;
+    case WARNING_LEVEL:
+        ALOGW("%s", buffer);
+        break;
+    case INFO_LEVEL:
+        ALOGI("%s", buffer);
+        break;
+    case VERBOSE_LEVEL:
+        ALOGV("%s", buffer);
+        break;
+    case DEBUG_LEVEL:
+        ALOGD("%s", buffer);
+        break;
+    default:
+        ALOGE("debug level not support");
+        break;
+    }
+#else
+    XCAM_UNUSED (level);
+    printf ("%s", buffer);
+#endif
+}
+
+// log_mutex must be held, returns number of written records
+uint32_t
+drain_rings ()
+{
+    uint32_t count = 0;
+    LogRing **link = &log_rings;
+
+    while (*link) {
+        LogRing *ring = *link;
+        bool orphaned = ring->orphaned.load (std::memory_order_acquire);
+        uint32_t tail = ring->tail.load (std::memory_order_relaxed);
+        uint32_t head = ring->head.load (std::memory_order_acquire);
+
+        for (; tail != head; ++tail, ++count) {
+            const LogRecord &record = ring->records[tail % XCAM_LOG_RING_SLOTS];
+            format_record (record, log_line, sizeof (log_line));
+            output_log (record.level, log_line);
+            ring->tail.store (tail + 1, std::memory_order_release);
+        }
+
+        uint32_t dropped = ring->dropped.load (std::memory_order_relaxed);
+        if (dropped != ring->reported_dropped) {
+            snprintf (log_line, sizeof (log_line), "XCAM WARNING: %u log records dropped\n",
+                      dropped - ring->reported_dropped);
+            output_log (WARNING_LEVEL, log_line);
+            ring->reported_dropped = dropped;
+        }
+
+        if (orphaned) {
+            *link = ring->next;
+            log_retired_recorded += ring->recorded.load (std::memory_order_relaxed);
+            log_retired_dropped += dropped;
+            xcam_free (ring);
+        } else {
+            link = &ring->next;
+        }
+    }
+
+    if (count && log_file)
+        fflush (log_file);
+    return count;
+}
+
+int64_t
+monotonic_seconds ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec;
+}
+
+void *
+log_thread_func (void *)
+{
+    int64_t last_reload = monotonic_seconds ();
+    struct sched_param param;
+
+    // no wakeup preemption of the threads which log
+    xcam_mem_clear (param);
+    pthread_setschedparam (pthread_self (), SCHED_BATCH, &param);
+
+    while (true) {
+        pthread_mutex_lock (&log_mutex);
+        uint32_t count = drain_rings ();
+        pthread_mutex_unlock (&log_mutex);
+
+        int64_t now = monotonic_seconds ();
+        if (now - last_reload >= XCAM_LOG_RELOAD_SEC) {
+            xcam_reload_log_level ();
+            last_reload = now;
+        }
+        if (count)
+            continue;
+
+        log_thread_sleeping.store (true);
+        // recheck, a producer may have missed the sleeping flag
+        pthread_mutex_lock (&log_mutex);
+        count = drain_rings ();
+        pthread_mutex_unlock (&log_mutex);
+        if (count) {
+            log_thread_sleeping.store (false);
+            continue;
+        }
+
+        struct timespec abstime;
+        clock_gettime (CLOCK_REALTIME, &abstime);
+        abstime.tv_sec += XCAM_LOG_RELOAD_SEC;
+        while (sem_timedwait (&log_wakeup, &abstime) < 0 && errno == EINTR);
+        log_thread_sleeping.store (false);
+    }
+
+    return NULL;
+}
+
+void
+release_thread_ring (void *data)
+{
+    LogRing *ring = (LogRing *)data;
+    ring->orphaned.store (true, std::memory_order_release);
+}
+
+void
+log_init ()
+{
+    pthread_t thread_id;
+    pthread_attr_t attr;
+
+    if (pthread_key_create (&log_ring_key, release_thread_ring) != 0)
+        return;
+    if (sem_init (&log_wakeup, 0, 0) != 0)
+        return;
+
+    pthread_attr_init (&attr);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+    if (pthread_create (&thread_id, &attr, log_thread_func, NULL) == 0) {
+        pthread_setname_np (thread_id, "xcam_log");
+        log_async = true;
+        atexit (xcam_log_flush);
+    }
+    pthread_attr_destroy (&attr);
+}
+
+LogRing *
+get_thread_ring ()
+{
+    pthread_once (&log_once, log_init);
+    if (!log_async)
+        return NULL;
+
+    LogRing *ring = (LogRing *)pthread_getspecific (log_ring_key);
+    if (ring)
+        return ring;
+
+    ring = xcam_malloc0_type (LogRing);
+    if (!ring)
+        return NULL;
+    new (&ring->head) std::atomic<uint32_t> (0);
+    new (&ring->tail) std::atomic<uint32_t> (0);
+    new (&ring->orphaned) std::atomic<bool> (false);
+    new (&ring->recorded) std::atomic<uint32_t> (0);
+    new (&ring->dropped) std::atomic<uint32_t> (0);
+
+    pthread_mutex_lock (&log_mutex);
+    ring->next = log_rings;
+    log_rings = ring;
+    pthread_mutex_unlock (&log_mutex);
+
+    pthread_setspecific (log_ring_key, ring);
+    return ring;
+}
+
+void
+record_log (LogRing *ring, int level, const char *format, va_list args)
+{
+    uint32_t head = ring->head.load (std::memory_order_relaxed);
+    uint32_t tail = ring->tail.load (std::memory_order_acquire);
+
+    if (head - tail >= XCAM_LOG_RING_SLOTS) {
+        ring->dropped.store (ring->dropped.load (std::memory_order_relaxed) + 1,
+                             std::memory_order_relaxed);
+        return;
+    }
+
+    LogRecord &record = ring->records[head % XCAM_LOG_RING_SLOTS];
+    va_list encode_args_list;
+
+    record.level = level;
+    record.format = format;
+    record.preformatted = 0;
+    va_copy (encode_args_list, args);
+    if (!encode_args (record, format, encode_args_list)) {
+        vsnprintf ((char *)record.args, sizeof (record.args), format, args);
+        record.preformatted = 1;
+    }
+    va_end (encode_args_list);
+
+    ring->recorded.store (ring->recorded.load (std::memory_order_relaxed) + 1,
+                          std::memory_order_relaxed);
+    ring->head.store (head + 1, std::memory_order_release);
+
+    if (log_thread_sleeping.load () && log_thread_sleeping.exchange (false))
+        sem_post (&log_wakeup);
+}
+
+};
+
+int xcam_reload_log_level ()
+{
+    int level = log_file_name[0] ? DEBUG_LEVEL : read_log_setting ();
+    __atomic_store_n (&xcam_log_level_cache, level, __ATOMIC_RELAXED);
+    return level;
+}
+
+void xcam_print_log (int level, const char* format, ...) {
+    if (!xcam_log_level_enabled (level))
+        return;
+
+    LogRing *ring = (level == ERROR_LEVEL) ? NULL : get_thread_ring ();
+    va_list va_list;
+    va_start (va_list, format);
+    if (ring) {
+        record_log (ring, level, format, va_list);
+    } else {
+        char buffer[XCAM_MAX_STR_SIZE] = {0};
+        vsnprintf (buffer, XCAM_MAX_STR_SIZE, format, va_list);
+
+        pthread_mutex_lock (&log_mutex);
+        drain_rings ();
+        output_log (level, buffer);
+        if (log_file)
+            fflush (log_file);
+        pthread_mutex_unlock (&log_mutex);
+    }
+    va_end (va_list);
+}
+
+void xcam_log_flush () {
+    pthread_mutex_lock (&log_mutex);
+    drain_rings ();
+    pthread_mutex_unlock (&log_mutex);
+}
+
+void xcam_log_get_stats (uint64_t *recorded, uint64_t *dropped) {
+    uint64_t recorded_sum, dropped_sum;
+
+    pthread_mutex_lock (&log_mutex);
+    recorded_sum = log_retired_recorded;
+    dropped_sum = log_retired_dropped;
+    for (LogRing *ring = log_rings; ring; ring = ring->next) {
+        recorded_sum += ring->recorded.load (std::memory_order_relaxed);
+        dropped_sum += ring->dropped.load (std::memory_order_relaxed);
+    }
+    pthread_mutex_unlock (&log_mutex);
+
+    if (recorded)
+        *recorded = recorded_sum;
+    if (dropped)
+        *dropped = dropped_sum;
+}
+
+void xcam_set_log (const char* file_name) {
+    if (NULL != file_name) {
+        pthread_mutex_lock (&log_mutex);
+        drain_rings ();
+        if (log_file) {
+            fclose (log_file);
+            log_file = NULL;
+        }
+        memset (log_file_name, 0, XCAM_MAX_STR_SIZE);
+        strncpy (log_file_name, file_name, XCAM_MAX_STR_SIZE - 1);
+        pthread_mutex_unlock (&log_mutex);
+        xcam_reload_log_level ();
+    }
+}
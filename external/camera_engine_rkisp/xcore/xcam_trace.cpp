@@ -0,0 +1,294 @@
+/*
+ * xcam_trace.cpp - per-frame 3a pipeline tracing
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "xcam_trace.h"
+#include "xcam_thread.h"
+#include <semaphore.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define XCAM_TRACE_NAME_SIZE 16
+
+namespace XCam {
+
+static const struct {
+    const char  *name;
+    bool         instant;
+} trace_stages[XCAM_TRACE_STAGE_COUNT] = {
+    {"sof", true},
+    {"stats_dequeue", false},
+    {"pre_3a_analyze", false},
+    {"ae", false},
+    {"awb", false},
+    {"af", false},
+    {"common", false},
+    {"integrate", false},
+    {"set_3a_config", false},
+    {"set_3a_exposure", false},
+};
+
+/*
+ * Events are published seqlock style, the writer clears the slot sequence
+ * before touching it and sets it to index + 1 after, the exporter drops
+ * slots whose sequence changed while it was copying them.
+ */
+struct TraceEvent {
+    std::atomic<uint64_t>   seq;
+    int32_t                 stage;
+    int32_t                 frame_id;
+    int64_t                 begin_usec;
+    int64_t                 dur_usec;
+};
+
+class TraceRing {
+public:
+    TraceRing ()
+        : tid (0)
+        , written (0)
+        , owned (false)
+        , next (NULL)
+    {
+        xcam_mem_clear (name);
+        for (uint32_t i = 0; i < XCAM_TRACE_RING_SIZE; ++i)
+            events[i].seq.store (0, std::memory_order_relaxed);
+    }
+
+    pid_t                   tid;
+    char                    name[XCAM_TRACE_NAME_SIZE];
+    std::atomic<uint64_t>   written;
+    std::atomic<bool>       owned;
+    TraceRing              *next;
+    TraceEvent              events[XCAM_TRACE_RING_SIZE];
+};
+
+// rings are never freed, a ring left by an exited thread is claimed by the next new thread
+static std::atomic<TraceRing *> trace_rings (NULL);
+static Mutex trace_export_mutex;
+
+class TraceRingOwner {
+public:
+    TraceRingOwner () : ring (NULL) {}
+    ~TraceRingOwner () {
+        if (ring)
+            ring->owned.store (false);
+    }
+    TraceRing *ring;
+};
+
+static thread_local TraceRingOwner trace_ring_owner;
+
+std::atomic<bool> FrameTracer::_enabled (false);
+
+int64_t
+FrameTracer::now_usec ()
+{
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000LL + now.tv_nsec / 1000;
+}
+
+TraceRing *
+FrameTracer::get_thread_ring ()
+{
+    if (trace_ring_owner.ring)
+        return trace_ring_owner.ring;
+
+    TraceRing *ring = NULL;
+    for (ring = trace_rings.load (); ring; ring = ring->next) {
+        bool owned = false;
+        if (ring->owned.compare_exchange_strong (owned, true))
+            break;
+    }
+    if (!ring) {
+        ring = new TraceRing;
+        ring->owned.store (true);
+        ring->next = trace_rings.load ();
+        while (!trace_rings.compare_exchange_weak (ring->next, ring))
+            ;
+    }
+
+    {
+        // events of the previous owner would be exported with the new tid
+        SmartLock locker (trace_export_mutex);
+        ring->written.store (0);
+        ring->tid = (pid_t)syscall (SYS_gettid);
+        if (pthread_getname_np (pthread_self (), ring->name, sizeof (ring->name)) != 0)
+            snprintf (ring->name, sizeof (ring->name), "thread-%d", ring->tid);
+    }
+    trace_ring_owner.ring = ring;
+    return ring;
+}
+
+void
+FrameTracer::record (XCamTraceStage stage, int32_t frame_id, int64_t begin_usec, int64_t end_usec)
+{
+    TraceRing *ring = get_thread_ring ();
+    uint64_t index = ring->written.load (std::memory_order_relaxed);
+    TraceEvent &event = ring->events[index % XCAM_TRACE_RING_SIZE];
+
+    event.seq.store (0, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+    event.stage = stage;
+    event.frame_id = frame_id;
+    event.begin_usec = begin_usec;
+    event.dur_usec = end_usec - begin_usec;
+    event.seq.store (index + 1, std::memory_order_release);
+    ring->written.store (index + 1, std::memory_order_release);
+}
+
+XCamReturn
+FrameTracer::export_json (const char *path)
+{
+    XCAM_FAIL_RETURN (
+        ERROR, path, XCAM_RETURN_ERROR_PARAM,
+        "trace export failed, path is NULL");
+
+    SmartLock locker (trace_export_mutex);
+    FILE *fp = fopen (path, "w");
+    XCAM_FAIL_RETURN (
+        ERROR, fp, XCAM_RETURN_ERROR_FILE,
+        "trace export failed, open %s error:%s", path, strerror (errno));
+
+    pid_t pid = getpid ();
+    uint32_t exported = 0;
+    const char *sep = "";
+
+    fprintf (fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (TraceRing *ring = trace_rings.load (); ring; ring = ring->next) {
+        uint64_t written = ring->written.load (std::memory_order_acquire);
+        if (!written)
+            continue;
+
+        fprintf (fp, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                 "\"args\":{\"name\":\"%s\"}}", sep, pid, ring->tid, ring->name);
+        sep = ",";
+
+        uint64_t first = written > XCAM_TRACE_RING_SIZE ? written - XCAM_TRACE_RING_SIZE : 0;
+        for (uint64_t i = first; i < written; ++i) {
+            TraceEvent &slot = ring->events[i % XCAM_TRACE_RING_SIZE];
+            uint64_t seq = slot.seq.load (std::memory_order_acquire);
+            int32_t stage = slot.stage;
+            int32_t frame_id = slot.frame_id;
+            int64_t begin_usec = slot.begin_usec;
+            int64_t dur_usec = slot.dur_usec;
+            std::atomic_thread_fence (std::memory_order_acquire);
+            if (seq != i + 1 || slot.seq.load (std::memory_order_relaxed) != seq)
+                continue;
+            if (stage < 0 || stage >= XCAM_TRACE_STAGE_COUNT)
+                continue;
+
+            if (trace_stages[stage].instant)
+                fprintf (fp, ",\n{\"name\":\"%s\",\"cat\":\"3a\",\"ph\":\"i\",\"s\":\"p\","
+                         "\"ts\":%" PRId64 ",\"pid\":%d,\"tid\":%d,\"args\":{\"frame\":%d}}",
+                         trace_stages[stage].name, begin_usec, pid, ring->tid, frame_id);
+            else
+                fprintf (fp, ",\n{\"name\":\"%s\",\"cat\":\"3a\",\"ph\":\"X\","
+                         "\"ts\":%" PRId64 ",\"dur\":%" PRId64 ",\"pid\":%d,\"tid\":%d,\"args\":{\"frame\":%d}}",
+                         trace_stages[stage].name, begin_usec, dur_usec, pid, ring->tid, frame_id);
+            ++exported;
+        }
+    }
+    fprintf (fp, "\n]}\n");
+    fclose (fp);
+
+    XCAM_LOG_INFO ("trace exported %d events to %s", exported, path);
+    return XCAM_RETURN_NO_ERROR;
+}
+
+/*
+ * file IO is not async-signal-safe, the signal handler only posts a
+ * semaphore and this thread writes the file
+ */
+class TraceDumpThread
+    : public Thread
+{
+public:
+    explicit TraceDumpThread (const char *path)
+        : Thread ("trace_dump")
+        , _path (strndup (path, XCAM_MAX_STR_SIZE))
+    {
+        sem_init (&_request, 0, 0);
+    }
+
+    void request_dump () {
+        sem_post (&_request);
+    }
+
+protected:
+    virtual bool loop () {
+        while (sem_wait (&_request) != 0) {
+            if (errno != EINTR)
+                return false;
+        }
+        FrameTracer::export_json (_path);
+        return true;
+    }
+
+private:
+    char        *_path;
+    sem_t        _request;
+};
+
+static TraceDumpThread *trace_dump_thread = NULL;
+
+static void
+trace_dump_signal_handler (int signo)
+{
+    XCAM_UNUSED (signo);
+    if (trace_dump_thread)
+        trace_dump_thread->request_dump ();
+}
+
+bool
+FrameTracer::install_dump_signal (int signo, const char *path)
+{
+    XCAM_FAIL_RETURN (
+        ERROR, path, false,
+        "trace install dump signal failed, path is NULL");
+
+    SmartLock locker (trace_export_mutex);
+    XCAM_FAIL_RETURN (
+        WARNING, !trace_dump_thread, false,
+        "trace dump signal was already installed");
+
+    // lives as long as the process, the signal may come at any time
+    TraceDumpThread *thread = new TraceDumpThread (path);
+    if (!thread->start ()) {
+        XCAM_LOG_ERROR ("trace start dump thread failed");
+        delete thread;
+        return false;
+    }
+    trace_dump_thread = thread;
+
+    struct sigaction action;
+    xcam_mem_clear (action);
+    action.sa_handler = trace_dump_signal_handler;
+    sigemptyset (&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    XCAM_FAIL_RETURN (
+        ERROR, sigaction (signo, &action, NULL) == 0, false,
+        "trace install handler of signal(%d) failed, error:%s", signo, strerror (errno));
+
+    XCAM_LOG_INFO ("trace exports to %s on signal(%d)", path, signo);
+    return true;
+}
+
+};
@@ -0,0 +1,112 @@
+/*
+ * xcam_trace.h - per-frame 3a pipeline tracing
+ *
+ *  Copyright (c) 2019 Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_TRACE_H
+#define XCAM_TRACE_H
+
+#include <xcam_std.h>
+#include <atomic>
+
+// events kept per thread, older events are overwritten
+#define XCAM_TRACE_RING_SIZE 1024
+
+namespace XCam {
+
+enum XCamTraceStage {
+    XCAM_TRACE_SOF = 0,
+    XCAM_TRACE_STATS_DEQUEUE,
+    XCAM_TRACE_PRE_3A,
+    // same order as X3aHandlerType
+    XCAM_TRACE_AE,
+    XCAM_TRACE_AWB,
+    XCAM_TRACE_AF,
+    XCAM_TRACE_COMMON,
+    XCAM_TRACE_INTEGRATE,
+    XCAM_TRACE_SET_3A_CONFIG,
+    XCAM_TRACE_SET_3A_EXPOSURE,
+    XCAM_TRACE_STAGE_COUNT,
+};
+
+class TraceRing;
+
+/*
+ * Trace points stamp a stage with the frame id and CLOCK_MONOTONIC usec
+ * into a ring owned by the calling thread, no lock is taken on the record
+ * path. Disabled tracing costs one relaxed load per trace point.
+ * export_json writes all rings as Chrome trace JSON, which Perfetto and
+ * chrome://tracing open directly.
+ */
+class FrameTracer {
+public:
+    static void set_enabled (bool enable) {
+        _enabled.store (enable);
+    }
+    static bool is_enabled () {
+        return _enabled.load (std::memory_order_relaxed);
+    }
+    static int64_t now_usec ();
+
+    // @end_usec equal to @begin_usec for instant stages
+    static void record (XCamTraceStage stage, int32_t frame_id, int64_t begin_usec, int64_t end_usec);
+    static void instant (XCamTraceStage stage, int32_t frame_id) {
+        if (is_enabled ()) {
+            int64_t now = now_usec ();
+            record (stage, frame_id, now, now);
+        }
+    }
+
+    static XCamReturn export_json (const char *path);
+    // export to @path each time @signo is received, the file is written by a helper thread
+    static bool install_dump_signal (int signo, const char *path);
+
+private:
+    static TraceRing *get_thread_ring ();
+
+private:
+    static std::atomic<bool>          _enabled;
+};
+
+class TraceScope {
+public:
+    TraceScope (XCamTraceStage stage, int32_t frame_id)
+        : _stage (stage)
+        , _frame_id (frame_id)
+        , _begin (FrameTracer::is_enabled () ? FrameTracer::now_usec () : -1)
+    {}
+    ~TraceScope () {
+        if (_begin >= 0)
+            FrameTracer::record (_stage, _frame_id, _begin, FrameTracer::now_usec ());
+    }
+    // for stages which learn the frame id on the way
+    void set_frame_id (int32_t frame_id) {
+        _frame_id = frame_id;
+    }
+
+private:
+    XCAM_DEAD_COPY (TraceScope);
+
+private:
+    XCamTraceStage     _stage;
+    int32_t            _frame_id;
+    int64_t            _begin;
+};
+
+};
+
+#endif //XCAM_TRACE_H